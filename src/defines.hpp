@@ -75,6 +75,7 @@
 #include <QDir>
 #include <QList>
 #include <QIcon>
+#include <QHash>
 #include <QQueue>
 #include <QString>
 #include <QVector>
@@ -177,11 +178,20 @@ namespace GekkoFyre {
 #define GK_XMPP_CREATE_CONN_PROG_BAR_MAX_PERCT (100)
 #define GK_XMPP_CREATE_CONN_PROG_BAR_TOT_PERCT (4)
 
-#define GK_XMPP_MAM_BACKLOG_BULK_FETCH_COUNT (125)
-#define GK_XMPP_MAM_BACKLOG_FINE_FETCH_COUNT (1)
 #define GK_XMPP_MAM_MIN_DATETIME_YEARS (-15)
 #define GK_XMPP_MAN_SLEEP_DATETIME_MILLISECS (1000)
-#define GK_XMPP_MAM_THREAD_SLEEP_MILLISECS (3000)
+#define GK_XMPP_MAM_SYNC_PAGE_SIZE (250)                // The amount of archived messages (XEP-0313) requested within each page.
+#define GK_XMPP_MAM_SYNC_MAX_CONCURRENT (4)             // The most bareJids whose message archives are queried at once.
+#define GK_XMPP_MAM_SYNC_INITIAL_MAX_PAGES (4)          // The most pages of history fetched for a bareJid that has never been synchronized before.
+#define GK_XMPP_MAM_SYNC_TIMEOUT_MS (30000)             // How long a page of archived messages may go unanswered before the bareJid's place is given up towards another.
+#define GK_XMPP_OUTBOX_MAX_QUEUE (256)                  // The most outgoing messages held within the outbox that the server has yet to acknowledge.
+#define GK_XMPP_OUTBOX_MAX_AWAITING (1024)              // The most acknowledged messages kept whilst awaiting their receipt, the oldest of which are let go first.
+#define GK_XMPP_OUTBOX_AWAITING_EXPIRY_MS (604800000)   // How long an acknowledged message awaits its receipt for before being let go, being a week.
+#define GK_XMPP_OUTBOX_FLUSH_MS (25)                    // How long outgoing messages are gathered up for, so that a burst of them is sent all at once.
+#define GK_XMPP_OUTBOX_MAX_ATTEMPTS (5)                 // How many times a message is sent without a delivery receipt before being given up on.
+#define GK_XMPP_OUTBOX_RECEIPT_TIMEOUT_MS (15000)       // How long a message unacknowledged by the server awaits its receipt before being sent again, doubling thereafter.
+#define GK_XMPP_OUTBOX_RETRY_MAX_MS (300000)            // The longest that is ever waited between sending a message again.
+#define GK_XMPP_STANZA_TIMING_INTERVAL (1000)          // After how many archived stanzas the time spent upon them by the GUI thread is logged.
 
 #define GK_DEFAULT_XMPP_SERVER_PORT (5222)
 #define GK_XMPP_AVAIL_COMBO_AVAILABLE_IDX (0)
@@ -197,7 +207,8 @@ namespace GekkoFyre {
 #define GK_XMPP_URI_LOOKUP_DNS_SRV_METHOD (0)
 #define GK_XMPP_URI_LOOKUP_MANUAL_METHOD (1)
 
-#define GK_XMPP_VCARD_ROSTER_UPDATE_SECS (20)
+#define GK_XMPP_VCARD_FETCH_MAX_CONCURRENT (4)          // The most vCards requested from the XMPP server at once.
+#define GK_XMPP_VCARD_FETCH_TIMEOUT_MS (20000)          // How long a vCard request may go unanswered before its place is given up towards another.
 #define GK_XMPP_NETWORK_STATE_UPDATE_SECS (1)
 #define GK_XMPP_HANDLE_DISCONNECTION_SINGLE_SHOT_TIMER_SECS (5)
 
@@ -230,6 +241,12 @@ namespace GekkoFyre {
 #define AUDIO_VU_METER_UPDATE_MILLISECS (125)                   // How often the volume meter should update, in milliseconds.
 #define AUDIO_VU_METER_PEAK_DECAY_RATE (0.001)                  // Unknown
 #define AUDIO_VU_METER_PEAK_HOLD_LEVEL_DURATION (2000)          // Measured in milliseconds
+#define AUDIO_METER_TRUE_PEAK_OVERSAMPLE (4)                    // The amount of oversampling used in the measurement of true peak levels, as per ITU-R BS.1770-4.
+#define AUDIO_METER_TRUE_PEAK_TAPS_PER_PHASE (12)               // The number of FIR taps for each phase of the true peak interpolator (48 taps in total).
+#define AUDIO_METER_CHUNK_FRAMES (256)                          // Captured samples are metered in chunks of this many frames, so that the scratch buffers need never grow.
+#define AUDIO_METER_MAX_CHANNELS (8)                            // The maximum number of interleaved channels that may be metered.
+#define AUDIO_METER_CLIP_THRESHOLD (32767.0 / 32768.0)          // Any sample at or beyond this magnitude (i.e. full-scale) is counted as having clipped.
+#define AUDIO_METER_CAPTURE_IDLE_MILLISECS (5)                  // How long the capture thread sleeps for whenever there are no new samples waiting, rather than spinning.
 #define GK_AUDIO_VOL_INIT_PERCENTAGE (100.0)
 #define GK_AUDIO_VOL_PLAYBACK_REFRESH_INTERVAL (10)             // The time, measured in milliseconds, for how often to refresh for any new and updated status changes whilst playing back or recording audio.
 #define GK_AUDIO_VOL_REFRESH_INTERV_DURATION (250)              // How often should OpenAL and the volume widget check for new changes when the QSlider is actioned. A higher value, measured in milliseconds, means less impact on system resources.
@@ -291,6 +308,28 @@ namespace GekkoFyre {
 #define SPECTRO_X_MAX_AXIS_SIZE (2500)                  // The default, upper-limit of the x-axis on the spectrograph / waterfall, in hertz.
 #define SPECTRO_Y_AXIS_SIZE (60000)                     // The maximum size of the y-axis, in milliseconds, given that it is based on a timescale.
 
+#define SPECTRO_OFFLINE_FFT_SIZE (4096)                 // The default FFT size used when generating a spectrograph / waterfall from a recorded audio file.
+#define SPECTRO_OFFLINE_HOP_SIZE (2048)                 // The default number of frames to advance by between each row, when generating a spectrograph / waterfall from a recorded audio file.
+#define SPECTRO_OFFLINE_DB_FLOOR (-120.0)               // The lower-limit, in dBFS, of rows which are quantised down towards 8-bits.
+#define SPECTRO_OFFLINE_DB_CEILING (0.0)                // The upper-limit, in dBFS, of rows which are quantised down towards 8-bits.
+#define SPECTRO_OFFLINE_VIEW_MAX_ROWS (1024)            // The maximum number of rows that are shown at once when viewing a spectrograph / waterfall from a recorded audio file, with anything more being decimated.
+#define SPECTRO_OFFLINE_VIEW_MAX_BINS (2048)            // The maximum number of frequency bins that are shown at once when viewing a spectrograph / waterfall from a recorded audio file.
+#define SPECTRO_OFFLINE_VIEW_MIN_ROWS (16)              // The minimum number of rows that may be zoomed into when viewing a spectrograph / waterfall from a recorded audio file.
+#define SPECTRO_OFFLINE_VIEW_DEBOUNCE_MILLISECS (50)    // How long to wait after the last step of zooming or panning through a recorded spectrograph / waterfall before rescanning it.
+#define SPECTRO_OFFLINE_PRODUCT_MAGIC (0x474B5350)      // The magic number ("GKSP") found at the very start of every saved spectrograph / waterfall product.
+#define SPECTRO_OFFLINE_PRODUCT_VERS (1)                // The version of the file format for saved spectrograph / waterfall products.
+#define SPECTRO_OFFLINE_PRODUCT_EXT ("gkspectro")      // The file extension given to saved spectrograph / waterfall products.
+
+#define SPECTRO_WIDEBAND_FFT_MIN_SIZE (256)             // The smallest FFT size permitted for the wideband (i.e. IQ) spectrograph / waterfall.
+#define SPECTRO_WIDEBAND_FFT_MAX_SIZE (65536)           // The largest FFT size permitted for the wideband (i.e. IQ) spectrograph / waterfall.
+#define SPECTRO_WIDEBAND_FFT_DEFAULT_SIZE (8192)        // The default FFT size for the wideband (i.e. IQ) spectrograph / waterfall.
+#define SPECTRO_WIDEBAND_DEFAULT_WIDTH (1024)           // The default display width, in pixels, that wideband rows are decimated down towards if the widget is yet to be shown.
+#define SPECTRO_WIDEBAND_HISTORY_ROWS (256)             // The number of rows kept by the wideband spectrograph / waterfall.
+#define SPECTRO_WIDEBAND_ROW_MILLISECS (50)             // How often a new row is handed towards the wideband spectrograph / waterfall, in milliseconds.
+#define SPECTRO_WIDEBAND_MAX_FRAMES_PER_SEC (200)       // The most FFT frames computed per second, with any samples in-between being skipped over.
+#define SPECTRO_WIDEBAND_DEFAULT_AVG_ALPHA (0.3f)       // The default weight given to each new frame when averaging in log-power.
+#define SPECTRO_WIDEBAND_DB_MIN (-160.0f)               // The floor, in dBFS, below which wideband power is clamped so that empty bins do not produce infinities.
+
 #define GRAPH_DISPLAY_500_MILLISECS_IDX (0)             // Display '500 milliseconds' within the QComboBox!
 #define GRAPH_DISPLAY_1_SECONDS_IDX (1)                 // Display '1 seconds' within the QComboBox!
 #define GRAPH_DISPLAY_2_SECONDS_IDX (2)                 // Display '2 seconds' within the QComboBox!
@@ -304,6 +343,104 @@ namespace GekkoFyre {
 #define GK_AUDIO_STREAM_NUM_BUFS (1)                    // The number of buffers to employ, by default.
 #define GK_AUDIO_STREAM_BUF_SIZE (65536)                // 32 kB of data in each buffer, by default.
 
+//
+// Playback mixer
+//
+#define GK_AUDIO_MIXER_MAX_VOICES (32)                  // The maximum number of sounds (i.e. voices) that may be mixed together at any one time.
+#define GK_AUDIO_MIXER_NUM_BUFS (4)                     // The number of OpenAL buffers kept queued upon the mixer's one and only source.
+#define GK_AUDIO_MIXER_BLOCK_FRAMES (1024)              // The number of frames mixed into each OpenAL buffer.
+#define GK_AUDIO_MIXER_OUTPUT_CHANNELS (2)              // The mixer always outputs in stereo.
+#define GK_AUDIO_MIXER_MAX_SRC_CHANNELS (8)             // The maximum number of channels that a memory-mapped audio file may have, for playback through the mixer.
+#define GK_AUDIO_MIXER_MMAP_WINDOW_FRAMES (262144)      // How many frames of a memory-mapped audio file are kept resident ahead of playback, with those behind being released.
+#define GK_AUDIO_MIXER_CMD_QUEUE_SIZE (256)             // The capacity of the lock-free command queue towards the mixer thread. Must be a power of two!
+#define GK_AUDIO_MIXER_LIMITER_THRESHOLD (0.98)         // The level above which the master limiter begins to reduce the gain.
+#define GK_AUDIO_MIXER_LIMITER_RELEASE_MILLISECS (50)   // How long it takes the master limiter to recover once the peaks have passed.
+#define GK_AUDIO_MIXER_CLIP_CACHE_MAX_SECS (30)         // Clips no longer than this, measured in seconds, are kept decoded in memory for when they're next played.
+#define GK_AUDIO_MIXER_RETIRE_INTERVAL_MILLISECS (50)   // How often finished voices are collected from the mixer thread, so that their memory is never freed upon the mixer thread itself.
+#define GK_AUDIO_MIXER_STREAM_FRAMES (8192)             // The capacity of each live audio stream (i.e. a demodulated SDR channel) towards the mixer, in frames. Must be a power of two!
+
+//
+// Memory-mapped audio files (i.e. WAV, RF64 and raw PCM)
+//
+#define GK_AUDIO_MMAP_RIFF_HEADER_SIZE (12)             // The size, in bytes, of the 'RIFF'/'RF64' header along with its 'WAVE' form type.
+#define GK_AUDIO_MMAP_CHUNK_HEADER_SIZE (8)             // The size, in bytes, of each chunk header (i.e. the FourCC identifier plus a 32-bit size field).
+#define GK_AUDIO_MMAP_RF64_SIZE_PLACEHOLDER (0xFFFFFFFF) // The value placed in 32-bit size fields of a RF64 file, indicating that the real size is to be found within the 'ds64' chunk.
+#define GK_AUDIO_MMAP_WAVE_FORMAT_PCM (0x0001)          // WAVE_FORMAT_PCM, as defined by Microsoft.
+#define GK_AUDIO_MMAP_WAVE_FORMAT_IEEE_FLOAT (0x0003)   // WAVE_FORMAT_IEEE_FLOAT, as defined by Microsoft.
+#define GK_AUDIO_MMAP_WAVE_FORMAT_EXTENSIBLE (0xFFFE)   // WAVE_FORMAT_EXTENSIBLE, whereby the real format tag is the first two bytes of the sub-format GUID.
+
+//
+// Signal and test-tone generator
+//
+#define GK_SIGNAL_GEN_TABLE_BITS (12)                   // The size of the NCO's sine lookup table, as a power of two. Along with linear interpolation, this keeps spurs below -130 dBc.
+#define GK_SIGNAL_GEN_SIMD_LANES (4)                    // The number of independent lanes run by the recursive oscillator, so that the compiler may vectorize its inner loop.
+#define GK_SIGNAL_GEN_IMD_DEFAULT_F1_HZ (700)           // The lower tone of the standard two-tone IMD test, as used by the ARRL.
+#define GK_SIGNAL_GEN_IMD_DEFAULT_F2_HZ (1900)          // The upper tone of the standard two-tone IMD test, as used by the ARRL.
+#define GK_SIGNAL_GEN_DEFAULT_SWEEP_MILLISECS (5000)    // The default amount of time, in milliseconds, for a frequency sweep to go from start to finish.
+
+//
+// SoapySDR streaming
+//
+#define GK_SDR_STREAM_POOL_BLOCKS (64)                  // The number of IQ blocks allocated up-front for each stream. Must be a power of two!
+#define GK_SDR_STREAM_BLOCK_SAMPLES (16384)             // The minimum capacity of each IQ block, in complex samples. Raised to the stream's MTU where that is larger.
+#define GK_SDR_STREAM_MAX_SINKS (4)                     // The maximum number of consumers (i.e. waterfall, demodulator, recorder, etc.) that may share a single stream.
+#define GK_SDR_STREAM_READ_TIMEOUT_MICROSECS (100000)   // How long the reader thread waits upon the device for samples before trying again.
+#define GK_SDR_STREAM_MAX_CONSEC_ERRORS (16)            // The stream is torn down after this many consecutive, unrecoverable errors from the device.
+#define GK_SDR_STREAM_CONSUMER_IDLE_MICROSECS (500)     // How long a consumer thread should sleep for whenever it finds its queue empty.
+#define GK_SDR_FILE_REPLAY_DEFAULT_RATE (2048000)       // The sample rate assumed for raw IQ recordings, if none is otherwise given.
+#define GK_SDR_DDC_MAX_CHANNELS (16)                    // The most narrowband channels that may be extracted from a single SDR stream at once.
+#define GK_SDR_DDC_PFB_MAX_BINS (1024)                  // The most bins that the polyphase filter bank may split the stream into.
+#define GK_SDR_DDC_PFB_TAPS_PER_PHASE (12)              // The number of taps per branch of the polyphase filter bank's prototype filter.
+#define GK_SDR_DDC_PFB_MIN_RATE (240000)                // The lowest sample rate each bin of the polyphase filter bank may have, which must leave room for WFM.
+#define GK_SDR_DDC_PFB_PASSBAND (0.5)                   // The flat part of the prototype's passband, either side of a bin's centre, as a fraction of the spacing between bins.
+#define GK_SDR_DDC_FIR_TAPS_PER_PHASE (16)              // The number of taps per phase of each channel's decimating filter.
+#define GK_SDR_DDC_CHUNK_SAMPLES (4096)                 // The size of each chunk of samples handed from the filter bank towards a channel's own thread.
+#define GK_SDR_DDC_CHUNK_POOL (32)                      // The number of chunks allocated for each channel, which must be a power of two.
+#define GK_SDR_DDC_AUDIO_RATE (48000)                   // The sample rate of the audio produced by each channel.
+#define GK_SDR_DDC_CW_BFO_HZ (700)                      // The pitch at which CW signals are heard.
+#define GK_SDR_DDC_SSB_LOW_CUT_HZ (300)                 // The lower edge of an SSB channel's audio passband.
+#define GK_SIGMF_WRITE_BUFFER_BYTES (4194304)           // The size of each buffer handed towards the write-behind thread whilst recording IQ, which is a multiple of GK_SIGMF_WRITE_ALIGN.
+#define GK_SIGMF_WRITE_BUFFERS (16)                     // The number of write-behind buffers for each recording. Must be a power of two!
+#define GK_SIGMF_WRITE_ALIGN (4096)                     // The alignment, in bytes, of each write-behind buffer (i.e. a page).
+#define GK_SIGMF_WRITER_IDLE_MICROSECS (2000)           // How long the write-behind thread sleeps for whenever it finds nothing to write.
+#define GK_SIGMF_MAX_ANNOTATIONS (4096)                 // The most annotations (i.e. overflows and dropped samples) noted within the metadata of a single recording.
+#define GK_SDR_DISCOVERY_POLL_MILLISECS (250)          // How long the discovery thread waits upon hotplug events before checking whether a rescan has been asked for.
+#define GK_SDR_DISCOVERY_SETTLE_MILLISECS (1500)        // How long to wait after a USB device comes or goes before rescanning, so that its driver may settle first.
+
+//
+// Demodulators
+//
+#define GK_DEMOD_BLOCK_SAMPLES (1024)                   // The size of each demodulator's scratch arena, in samples. Longer spans are worked through in blocks of this size.
+#define GK_DEMOD_SIMD_LANES (8)                         // The number of independent lanes run by the inner loops, so that the compiler may vectorize them without -ffast-math.
+#define GK_DEMOD_AM_CARRIER_SECS (0.1)                  // The time constant, in seconds, with which the AM demodulator tracks the strength of the carrier.
+#define GK_DEMOD_WFM_DEEMPH_MICROSECS (50)              // The de-emphasis applied to broadcast FM, being 50 µs for most of the world and 75 µs for the Americas.
+#define GK_DEMOD_WFM_DEVIATION_HZ (75000)               // The peak deviation of broadcast FM.
+#define GK_DEMOD_NFM_DEVIATION_RATIO (2.5)              // The width of a NFM channel, divided by its peak deviation (i.e. 5 kHz within 12.5 kHz).
+#define GK_DEMOD_BENCH_SAMPLES (4194304)                // The number of samples worked through by each demodulator whilst benchmarking.
+
+//
+// WSJT-style modes (i.e. FT8 & FT4)
+//
+#define GK_FTX_SAMPLE_RATE (12000)                      // The sample rate that captured audio is resampled towards before decoding, as with WSJT-X.
+#define GK_FTX_LDPC_N (174)                             // The length of each LDPC codeword, in bits.
+#define GK_FTX_LDPC_K (91)                              // The message (77 bits) and CRC (14 bits) carried within each LDPC codeword.
+#define GK_FTX_LDPC_M (83)                              // The number of parity checks of the LDPC code.
+#define GK_FTX_LDPC_COLUMN_WEIGHT (3)                   // The number of parity checks that each bit of the codeword takes part in.
+#define GK_FTX_LDPC_MAX_ROW_WEIGHT (7)                  // The most bits that any single parity check covers.
+#define GK_FTX_LDPC_ITERATIONS (30)                     // The most iterations of belief propagation made for each candidate.
+#define GK_FTX_FREQ_OSR (2)                             // The waterfall's bins are this many times narrower than the tone spacing.
+#define GK_FTX_TIME_OSR (2)                             // The waterfall's steps are this many times shorter than a symbol.
+#define GK_FTX_MIN_FREQ_HZ (200)                        // The lowest audio frequency searched for signals.
+#define GK_FTX_MAX_FREQ_HZ (3000)                       // The highest audio frequency searched for signals.
+#define GK_FTX_MIN_DT_SECS (-1.0)                       // The earliest that a signal may begin relative to where it should have, in seconds.
+#define GK_FTX_MAX_DT_SECS (2.0)                        // The latest that a signal may begin relative to where it should have, in seconds.
+#define GK_FTX_MAX_CANDIDATES (200)                     // The most candidates that are attempted to be decoded within each slot.
+#define GK_FTX_MIN_SYNC_SCORE (6.0)                     // The least sync score, in dB above the neighbouring bins, for a candidate to be attempted.
+#define GK_FTX_SNR_BANDWIDTH_HZ (2500.0)                // The bandwidth within which the SNR of each decode is given, as with WSJT-X.
+#define GK_FTX_SLOT_BUFFERS (4)                         // The number of slots of audio that may be waiting upon the decoder at once. Must be a power of two!
+#define GK_FTX_DECODER_IDLE_MILLISECS (50)              // How long the decoder thread sleeps for whenever it finds no slot waiting upon it.
+#define GK_FTX_BENCH_SIGNALS (60)                       // The number of signals within the synthetic slot decoded whilst benchmarking.
+
 //
 // RS232 & USB Connections
 //
@@ -349,6 +486,7 @@ namespace GekkoFyre {
 #define GK_ACTIVE_MSGS_TABLEVIEW_MODEL_SNR_IDX (3)
 #define GK_ACTIVE_MSGS_TABLEVIEW_MODEL_MSG_IDX (4)
 #define GK_ACTIVE_MSGS_TABLEVIEW_MODEL_TOTAL_IDX (5)    // The total amount of indexes (i.e. columns) for the QTableView model, `GkActiveMsgsTableViewModel`. Be sure to keep this up-to-date!
+#define GK_ACTIVE_MSGS_TABLEVIEW_MODEL_MAX_ROWS (1000)  // The most decoded messages kept within `GkActiveMsgsTableViewModel`, with the oldest being removed first.
 
 #define GK_CSIGN_MSGS_TABLEVIEW_MODEL_CALLSIGN_IDX (0)
 #define GK_CSIGN_MSGS_TABLEVIEW_MODEL_DATETIME_IDX (1)
@@ -382,6 +520,25 @@ namespace GekkoFyre {
 #define GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_NICKNAME_IDX (1)
 #define GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_MSG_IDX (2)
 #define GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_TOTAL_IDX (3)
+#define GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_PAGE_SIZE (200)        // The amount of messages read from the chat transcript at a time, whether upon opening a chat or scrolling through it.
+#define GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_MAX_ROWS (1000)        // The most messages kept within a chat's QTableView model at once; any more are evicted from the end furthest from view.
+#define GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_PREFETCH_ROWS (50)     // Older messages are read in once scrolled within this many rows of the top.
+
+#define GK_XMPP_MUC_ROSTER_TREEVIEW_MODEL_NICKNAME_IDX (0)
+#define GK_XMPP_MUC_ROSTER_TREEVIEW_MODEL_ROLE_IDX (1)
+#define GK_XMPP_MUC_ROSTER_TREEVIEW_MODEL_TOTAL_IDX (2)
+#define GK_XMPP_MUC_ROSTER_TREEVIEW_MODEL_RESET_ROWS (64)        // Should a single batch change more occupants than this, the view is reset rather than updated row by row.
+#define GK_XMPP_MUC_ROSTER_TREEVIEW_MODEL_AVATAR_SIZE (24)       // The width and height, in pixels, that occupant avatars are scaled towards.
+#define GK_XMPP_MUC_OCCUPANT_FLUSH_MS (100)                      // Occupant presences are gathered up for this many milliseconds before being applied as one batch.
+#define GK_XMPP_MUC_OCCUPANT_FLUSH_MAX (500)                     // Nor are any more than this many occupant presences gathered up before being applied.
+
+#define GK_XMPP_SEARCH_MAX_RESULTS (50)                          // The most hits returned for a single search of the chat transcripts.
+#define GK_XMPP_SEARCH_MAX_CANDIDATES (500)                      // The most documents examined for a single search, so as to bound how long any search may take.
+#define GK_XMPP_SEARCH_MAX_PREFIX_TERMS (64)                     // The most distinct words that a single prefix may expand out towards.
+#define GK_XMPP_SEARCH_MAX_TERM_LENGTH (64)                      // Any longer words are truncated towards this many characters before being indexed.
+#define GK_XMPP_SEARCH_DEBOUNCE_MS (150)                         // Searching as-you-type waits for this many milliseconds of no typing first.
+
+#define GK_XMPP_ROSTER_TABLEVIEW_MODEL_BATCH_MS (16)     // Changes towards the roster QTableView models are gathered for this many milliseconds (i.e. about one frame), then applied all at once.
 
 //
 // QTreeWidget for enumerated SDR devices under QSettingsDialog!
@@ -405,7 +562,46 @@ namespace GekkoFyre {
 //
 // CODEC2 Modem related
 //
-#define GK_CODEC2_FRAME_SIZE (320)                      // The size of a single frame, in bytes, for the Codec2 modem.
+#define GK_CODEC2_RX_RING_SECS (2)                      // Seconds of captured audio, at the modem's own sample rate, that may wait upon the FreeDV demodulator.
+#define GK_CODEC2_RX_IDLE_MILLISECS (20)                // How long the FreeDV receive thread sleeps for whenever too few samples are waiting upon it.
+#define GK_CODEC2_TX_PADDING_FRAMES (2)                 // Empty modem frames sent either side of each burst, so that the far end's demodulator may sync before the first block and flush out the last.
+#define GK_CODEC2_ARQ_TURN_MILLISECS (4000)             // How long the far end is given to reply after each of our bursts upon the data link, before we take our next turn.
+#define GK_CODEC2_ARQ_BUSY_MILLISECS (500)              // How long our turn is put off for whilst the far end is still being heard.
+
+//
+// Data link (i.e. the framing of data sent over the Codec2 modem)
+//
+#define GK_DATA_LINK_RS_DATA_BYTES (64)                 // The bytes of data within each Reed-Solomon codeword.
+#define GK_DATA_LINK_RS_PARITY_BYTES (16)               // The bytes of parity within each Reed-Solomon codeword, which corrects up to half as many bytes in error.
+#define GK_DATA_LINK_INTERLEAVE_DEPTH (4)               // The number of Reed-Solomon codewords interleaved across the modem frames of each block.
+#define GK_DATA_LINK_ASM (0x1ACFFC1D)                   // The marker that precedes each block, as with CCSDS.
+#define GK_DATA_LINK_ASM_MAX_BIT_ERRORS (4)             // The most bits of the marker that may be in error for a block to still be found.
+#define GK_DATA_LINK_ARQ_WINDOW (8)                     // The most blocks of data that may be awaiting acknowledgement at once. May be no more than 32!
+#define GK_DATA_LINK_BENCH_BYTES (1024)                 // The size of the message sent at each SNR whilst benchmarking.
+#define GK_DATA_LINK_BENCH_MIN_SNR_DB (-4)              // The lowest SNR, within 3 kHz, at which the data link is benchmarked.
+#define GK_DATA_LINK_BENCH_MAX_SNR_DB (12)              // The highest SNR, within 3 kHz, at which the data link is benchmarked.
+#define GK_DATA_LINK_BENCH_STEP_SNR_DB (2)              // The step between each SNR at which the data link is benchmarked.
+#define GK_DATA_LINK_BENCH_MAX_ROUNDS (32)              // The most bursts that may be sent before a message is given up upon whilst benchmarking.
+#define GK_DATA_LINK_BENCH_FADING_HZ (1.0)              // The Doppler spread of the faded channel whilst benchmarking, as with the CCIR 'poor' channel.
+
+//
+// Channel simulator
+//
+#define GK_CHANNEL_SIM_NOISE_BW_HZ (3000.0)             // The bandwidth within which the SNR of the simulated channel is given, as is the convention for HF modems.
+#define GK_CHANNEL_SIM_HILBERT_TAPS (127)               // The length of the Hilbert transformer that turns the real audio into its analytic signal. Must be odd!
+#define GK_CHANNEL_SIM_FADING_PATHS (16)                // The number of sinusoids, of Gaussian distributed Doppler, that make up each faded path.
+
+//
+// Modem benchmark (i.e. the decoders and modems driven through the channel simulator)
+//
+#define GK_MODEM_BENCH_FTX_MIN_SNR_DB (-26)             // The lowest SNR, within 2500 Hz, at which FT8 & FT4 are benchmarked.
+#define GK_MODEM_BENCH_FTX_MAX_SNR_DB (-10)             // The highest SNR, within 2500 Hz, at which FT8 & FT4 are benchmarked.
+#define GK_MODEM_BENCH_FREEDV_MIN_SNR_DB (-4)           // The lowest SNR, within 3 kHz, at which FreeDV is benchmarked.
+#define GK_MODEM_BENCH_FREEDV_MAX_SNR_DB (12)           // The highest SNR, within 3 kHz, at which FreeDV is benchmarked.
+#define GK_MODEM_BENCH_STEP_SNR_DB (2)                  // The step between each SNR at which the modems are benchmarked.
+#define GK_MODEM_BENCH_FTX_SLOTS (8)                    // The slots, each with a single signal, decoded at each SNR upon each channel.
+#define GK_MODEM_BENCH_FREEDV_FRAMES (100)              // The modem frames of random data sent at each SNR upon each channel.
+#define GK_MODEM_BENCH_FTX_AMPLITUDE (8000.0)           // The peak amplitude of each synthetic signal of FT8 & FT4, as a 16-bit integer.
 
 //
 // JT65 Modem related
@@ -454,6 +650,14 @@ namespace General {
             constexpr char keyToConvAvatarImg[] = "GkAvatarImg";
             constexpr char keyToConvMsgHistory[] = "msg";
             constexpr char keyToConvTimestampHistory[] = "timestamp";
+            constexpr char keyToConvMamLastId[] = "mam_last_id";
+            constexpr char keyToConvTranscript[] = "transcript";
+            constexpr char keyToConvOutbox[] = "outbox";
+            constexpr char keyToConvOutboxAcked[] = "outbox_acked";
+            constexpr char keyToReceiptCapable[] = "receipt_capable";
+            constexpr char keyToConvSearchIndex[] = "GkSearchIdx";
+            constexpr char searchCollectionChats[] = "chats";
+            constexpr char searchCollectionRoster[] = "roster";
         }
 
         namespace Avatar {
@@ -480,6 +684,9 @@ namespace Filesystem {
     constexpr char tarExtension[] = ".tar";                             // The file extension given to (mostly uncompressed) TAR archive
     constexpr char tmpExtension[] = ".tmp";                             // The file extension give to temporary files
     constexpr char xmlExtension[] = ".xml";
+    constexpr char sigmfDataExtension[] = ".sigmf-data";                // The samples of a SigMF recording.
+    constexpr char sigmfMetaExtension[] = ".sigmf-meta";                // The JSON metadata of a SigMF recording.
+    constexpr char ftxLdpcTableFile[] = ":/resources/contrib/ft8_lib/ldpc_174_91.txt"; // The parity checks of the LDPC code used by FT8 & FT4, as 174 lines of three (1-based) check indices each.
 
     //
     // Nuspell & Spelling dictionaries
@@ -627,7 +834,6 @@ namespace Network {
             QXmppVCardIq vCard;
             QList<GkXmppArchiveMsg> archive_messages;
             QList<GkXmppMamMsg> messages;
-            QQueue<GkXmppMamMsg> msg_queue;
             qint32 msg_window_idx;
             std::shared_ptr<QXmppPresence> presence;
             QXmppRosterIq::Item::SubscriptionType subStatus;
@@ -640,10 +846,20 @@ namespace Network {
             QString addr;                                   // The network address of the given MUC.
         };
 
+        struct GkXmppMucOccupant {
+            QString jid;                                    // The occupant JID, being the bareJid of the MUC with the nickname as its resource.
+            QString nickName;                               // The nickname of the occupant within the MUC.
+            QString realJid;                                // The bareJid of the occupant themselves, should the MUC not be anonymous.
+            QXmppMucItem::Role role;                        // The role of the occupant, by which they are first sorted.
+            QXmppMucItem::Affiliation affiliation;
+            QXmppPresence::AvailableStatusType status;
+            QByteArray photoHash;                           // The SHA-1 of their avatar, as advertised within their presence (XEP-0153).
+        };
+
         struct GkXmppMsgTabRoster {
             bool isMuc;                                     // Are we dealing with an MUC-style chat?
             GkXmppMuc mucCtx;                               // To be used within an MUC situation.
-            QList<GkXmppCallsign> roster;                   // A roster of the end-users involved within this specific chat, whether it be a one-on-one or a MUC!
+            QStringList bareJids;                           // The end-users involved within this specific chat, whether it be a one-on-one or a MUC, as found within the roster!
         };
 
         struct GkXmppBlocklist {
@@ -692,6 +908,20 @@ namespace Network {
             QString bareJid;        // The bareJid this data belongs towards.
             QString nickName;       // The nickname of the given bareJid.
             QString message;        // The message the user wishes to send.
+            QString transcriptKey;  // Where this message is kept within the chat transcript of the Google LevelDB database, if anywhere.
+        };
+
+        struct GkXmppSearchHit {
+            QString docId;          // The document that was matched, such as the transcript key of a message or a bareJid.
+            QDateTime timestamp;    // When the document is from, by which the hits are ranked.
+            QString text;           // The text of the document, as it was indexed.
+        };
+
+        struct GkXmppMamBatch {                             // A page of archived messages (XEP-0313), as processed by GkXmppStanzaWorker.
+            QString queryId;                                // The query that the page was received for.
+            qint32 stanzas;                                 // The amount of stanzas within the page, including those without a body.
+            QHash<QString, QList<GkXmppMamMsg>> messages;   // The messages of each bareJid within the roster, keyed by said bareJid.
+            QHash<QString, QList<GkRecvMsgsTableViewModel>> transcripts; // The messages already written towards each chat transcript, keyed by chat bareJid.
         };
 
         struct GkClientMsgRecved {
@@ -732,16 +962,93 @@ namespace System {
     };
 
     namespace GkSdr {
+        enum GkIqFormat {
+            IqCf32,                                                             // Interleaved 32-bit floats (i.e. SOAPY_SDR_CF32, GNU Radio's `.cfile`).
+            IqCs16,                                                             // Interleaved signed 16-bit integers (i.e. SOAPY_SDR_CS16).
+            IqCu8                                                               // Interleaved unsigned 8-bit integers, as recorded by `rtl_sdr`.
+        };
+
+        enum GkSdrModulation {
+            SdrModNfm,
+            SdrModAm,
+            SdrModUsb,
+            SdrModLsb,
+            SdrModWfm,
+            SdrModDsb,
+            SdrModCw,
+            SdrModRaw
+        };
+
+        struct GkDdcChannelConfig {
+            double offset_hz = 0.0;                                             // The carrier of the channel, relative to the frequency the SDR device is tuned towards.
+            double bandwidth_hz = 0.0;                                          // The width of the channel, or zero for the default of the given modulation.
+            GkSdrModulation modulation = SdrModNfm;
+            double audio_rate = GK_SDR_DDC_AUDIO_RATE;                          // The sample rate of the audio handed towards the callback.
+        };
+
+        struct GkDemodBenchResult {
+            GkSdrModulation modulation = SdrModNfm;
+            QString name;
+            double msamples_per_sec = 0.0;                                      // Millions of complex samples demodulated each second, upon a single core.
+        };
+
+        struct GkSdrStreamStats {
+            quint64 blocks = 0;                                                 // Blocks handed downstream.
+            quint64 samples = 0;                                                // Complex samples handed downstream.
+            quint64 overflows = 0;                                              // Overflows reported by the device itself (i.e. SOAPY_SDR_OVERFLOW).
+            quint64 dropped = 0;                                                // Blocks discarded because a consumer fell behind.
+            quint64 source_dropped = 0;                                         // Samples discarded by the source itself, as they did not fit within a block.
+            quint64 timeouts = 0;
+            quint64 errors = 0;
+        };
+
+        struct GkSigmfCapture {
+            quint64 sample_start = 0;
+            double frequency = 0.0;                                             // The frequency the SDR device was tuned towards, in hertz.
+            QString datetime;                                                   // ISO 8601, in UTC.
+        };
+
+        struct GkSigmfAnnotation {
+            quint64 sample_start = 0;
+            quint64 sample_count = 0;
+            QString comment;
+        };
+
+        struct GkSigmfMeta {
+            QString datatype;                                                   // i.e. 'cf32_le', 'ci16_le' or 'cu8'.
+            GkIqFormat format = IqCf32;
+            double sample_rate = 0.0;
+            QString description;
+            QString hardware;
+            QString recorder;
+            std::vector<GkSigmfCapture> captures;
+            std::vector<GkSigmfAnnotation> annotations;
+        };
+
+        struct GkSigmfRecordStats {
+            quint64 samples = 0;                                                // Samples written towards disk, so far.
+            quint64 bytes = 0;
+            quint64 dropped = 0;                                                // Samples lost because the disk could not keep up.
+        };
+
+        struct GkSoapySdrChannelCaps {
+            std::vector<qreal> sample_rates;
+            std::vector<qreal> bandwidths;
+            QStringList gains;                                                  // The names of the gain elements, such as 'LNA' or 'TUNER'.
+        };
+
         struct GkSoapySdrTableView {
             qint32 event_no;
             bool running;
             bool initialized;
             std::shared_ptr<SoapySDR::Device> dev_ptr;
+            QString dev_key;                                                    // Uniquely identifies the device across rescans, such as by its serial.
             QString dev_name;
             QString dev_hw_key;
             qint32 curr_rx_channel;
             std::vector<qreal> avail_sample_rates;
             std::vector<qreal> avail_bwidth_views;
+            std::vector<GkSoapySdrChannelCaps> rx_channels;                     // What each RX channel is capable of, as probed once upon discovery.
         };
     }
 
@@ -771,7 +1078,8 @@ namespace System {
             CommandLineOk,
             CommandLineError,
             CommandLineVersionRequested,
-            CommandLineHelpRequested
+            CommandLineHelpRequested,
+            CommandLineBenchmarkRequested
         };
     }
 
@@ -1190,6 +1498,50 @@ namespace AmateurRadio {
         GkIARURegion
     };
 
+    struct GkFtxDecode {
+        DigitalModes mode = FT8;
+        QDateTime slot_start;                                // The UTC time at which the slot began.
+        double freq_hz = 0.0;                               // The audio frequency of the lowest tone.
+        double time_offset = 0.0;                           // How late the signal began, in seconds, relative to where it should have (i.e. 'DT').
+        qint32 snr_db = 0;                                  // Within a 2500 Hz bandwidth, as with WSJT-X.
+        qint32 ldpc_iterations = 0;
+        QString message;
+    };
+
+    struct GkDataLinkBenchResult {
+        double snr_db = 0.0;                                // Within 3 kHz.
+        double fading_hz = 0.0;                             // The Doppler spread of the channel, or zero for AWGN alone.
+        bool delivered = false;                             // Whether the whole of the message arrived intact.
+        quint32 bursts = 0;                                 // The number of bursts of data that were sent, not counting any acknowledgements.
+        quint32 blocks_sent = 0;
+        quint32 blocks_failed = 0;                          // Blocks that were sent yet never made it through the FEC and CRC.
+        double airtime_secs = 0.0;                          // The time spent transmitting in both directions.
+        double goodput_bps = 0.0;                           // The bits of the message delivered for each second of airtime.
+    };
+
+    struct GkModemBenchResult {
+        QString mode;
+        QString channel;                                    // The name of the channel's profile, such as "CCIR Poor".
+        double snr_db = 0.0;                                // Within 2500 Hz for FT8 & FT4, otherwise within 3 kHz.
+        double freq_offset_hz = 0.0;
+        double clock_drift_ppm = 0.0;
+        quint32 frames_sent = 0;
+        quint32 frames_ok = 0;                              // Frames (or slots, for FT8 & FT4) that arrived free of any errors.
+        quint32 frames_lost = 0;                            // Frames (or slots) that were never received at all, and so are not counted within the BER.
+        double ber = -1.0;                                  // Over the frames that were received, or less than zero where not applicable.
+        double per = 0.0;
+        double goodput_bps = 0.0;                           // The bits of payload within error-free frames, for each second of airtime.
+        double cpu_ms_per_frame = 0.0;                      // The CPU time taken by the receiver for each frame (or slot) of audio given to it.
+    };
+
+    struct GkFtxBenchResult {
+        quint32 threads = 0;
+        quint32 num_signals = 0;                            // The number of signals within the synthetic slot.
+        quint32 candidates = 0;
+        quint32 decoded = 0;                                // The number of those signals that were decoded correctly.
+        double millisecs = 0.0;                             // How long the slot took to decode, from its audio through towards the messages.
+    };
+
     struct GkFreqs {
         quint64 frequency;                                   // The exact frequency itself
         GkFreqBands closest_freq_band;                      // The closest matching frequency band grouping
@@ -1266,6 +1618,38 @@ namespace Spectrograph {
         qint64 relative_stop_time;                                              // The 'relative stopping time' for when the spectrograph was deinitialized.
         qint64 curr_time;                                                       // The more up-to-date time, as a UNIX epoch.
     };
+
+    enum GkSpectroQuant {
+        SpectroFloat32,                                                         // Each frequency bin is stored as a 32-bit float, measured in dBFS.
+        SpectroUint8                                                            // Each frequency bin is quantised down towards 8-bits, between the floor and the ceiling.
+    };
+
+    enum GkWidebandAverage {
+        WidebandAvgNone,                                                        // Each row is simply the latest FFT frame.
+        WidebandAvgLogPower,                                                    // An exponential moving average, taken in dB.
+        WidebandAvgPeakHold                                                     // The maximum seen in each bin, until reset.
+    };
+
+    enum GkWidebandDecimate {
+        WidebandDecimateMax,                                                    // Each pixel shows the strongest bin it covers, so narrow carriers are never lost.
+        WidebandDecimateMean                                                    // Each pixel shows the mean power of the bins it covers, for a smoother noise floor.
+    };
+
+    struct GkSpectroProduct {
+        GkSpectroQuant quant;                                                   // How each of the rows have been stored.
+        quint32 sample_rate;                                                    // The sample rate of the audio file that was analysed.
+        quint32 fft_size;                                                       // The size of the FFT used for each row.
+        quint32 hop_size;                                                       // The number of frames advanced by between each row.
+        quint32 num_bins;                                                       // The number of frequency bins within each row.
+        quint64 num_rows;                                                       // The total number of rows.
+        double freq_min;                                                        // The frequency of the very first bin, in hertz.
+        double freq_max;                                                        // The frequency of the very last bin, in hertz.
+        float db_floor;                                                         // The dBFS value represented by a quantised value of zero.
+        float db_ceiling;                                                       // The dBFS value represented by a quantised value of 255.
+        std::vector<float> rows_f32;                                            // The rows themselves, if `SpectroFloat32`.
+        std::vector<quint8> rows_u8;                                            // The rows themselves, if `SpectroUint8`.
+        std::vector<qint64> timestamps;                                         // The time of each row, as a UNIX epoch in milliseconds.
+    };
 }
 
 namespace GkAudioFramework {
@@ -1359,5 +1743,55 @@ namespace GkAudioFramework {
         std::vector<char> samples;
         size_t pos;
     };
+
+    enum GkPcmSampleFormat {
+        PcmInt16,
+        PcmInt24,
+        PcmInt32,
+        PcmFloat32,
+        PcmFloat64,
+        PcmUnknown
+    };
+
+    struct GkPcmFormat {
+        GkPcmSampleFormat sample_fmt;                                           // The encoding of each individual sample, which is always little-endian.
+        quint16 channels;                                                       // The number of interleaved channels within each frame.
+        quint32 sample_rate;                                                    // The sample rate, measured in hertz.
+        quint16 bytes_per_sample;                                               // The storage size of a single sample (i.e. one channel), in bytes.
+    };
+
+    struct GkAudioLevels {
+        float rms = 0.0f;                                                       // Range 0.0 - 1.0.
+        float peak = 0.0f;                                                      // The highest sample peak. Range 0.0 - 1.0.
+        float true_peak = 0.0f;                                                 // The highest inter-sample peak, which may well exceed 1.0!
+        quint64 clip_count = 0;                                                 // The total number of clipped samples since metering began.
+        qint32 num_samples = 0;                                                 // The number of frames that these levels were measured over.
+        quint64 sequence = 0;                                                   // Incremented with each new measurement, so that stale levels may be recognized.
+    };
+
+    enum GkSignalGenMode {
+        SigGenSingleTone,
+        SigGenMultiTone,
+        SigGenTwoToneImd,
+        SigGenWhiteNoise,
+        SigGenPinkNoise,
+        SigGenLinearSweep,
+        SigGenLogSweep
+    };
+
+    struct GkSignalTone {
+        double frequency;                                                       // Measured in hertz.
+        float amplitude;                                                        // Relative to the other tones, where 1.0 is unity.
+    };
+
+    struct GkSignalGenConfig {
+        GkSignalGenMode mode = SigGenSingleTone;
+        std::vector<GkSignalTone> tones;                                        // The first tone for SigGenSingleTone, the first two for SigGenTwoToneImd, otherwise all of them.
+        float amplitude = 1.0f;                                                 // The overall peak amplitude, where 1.0 is full-scale.
+        double sweep_start_hz = 0.0;
+        double sweep_stop_hz = 0.0;
+        quint32 sweep_duration_ms = GK_SIGNAL_GEN_DEFAULT_SWEEP_MILLISECS;      // The sweep starts over again once this much time has passed.
+        quint64 noise_seed = 0x9E3779B97F4A7C15ULL;                             // Seeding the noise generator identically gives identical noise, which is useful for testing decoders.
+    };
 }
 };
@@ -47,6 +47,7 @@
 #include <leveldb/slice.h>
 #include <leveldb/table.h>
 #include <leveldb/write_batch.h>
+#include <qxmpp/QXmppUtils.h>
 #include <boost/filesystem.hpp>
 #include <boost/exception/all.hpp>
 #include <QGuiApplication>
@@ -56,6 +57,7 @@
 #include <QTextCodec>
 #include <QVariant>
 #include <QSysInfo>
+#include <QDataStream>
 #include <QDebug>
 #include <tuple>
 #include <algorithm>
@@ -98,6 +100,7 @@ GkLevelDb::GkLevelDb(leveldb::DB *db_ptr, QPointer<FileIo> filePtr, QPointer<Gek
     fileIo = std::move(filePtr);
     gkStringFuncs = std::move(stringFuncs);
     gkMainWinGeometry = main_win_geometry;
+    gkSearchIndex = new GkXmppSearchIndex(db, this);
 }
 
 GkLevelDb::~GkLevelDb()
@@ -1841,6 +1844,215 @@ void GkLevelDb::write_xmpp_alpha_notice(const bool &value)
     return;
 }
 
+/**
+ * @brief GkLevelDb::write_xmpp_mam_last_id records the archive ID (XEP-0313) of the newest message synchronized for the
+ * given bareJid, so that the next synchronization may resume from there rather than from the very beginning.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The username associated with the message archive in question.
+ * @param archiveId The archive ID of the newest message synchronized thus far.
+ */
+void GkLevelDb::write_xmpp_mam_last_id(const QString &bareJid, const QString &archiveId)
+{
+    try {
+        if (!bareJid.isEmpty() && !archiveId.isEmpty()) {
+            leveldb::WriteBatch batch;
+            leveldb::Status status;
+
+            const std::string key = QString("%1_%2").arg(bareJid).arg(General::Xmpp::GoogleLevelDb::keyToConvMamLastId).toStdString();
+            batch.Put(key, archiveId.toStdString());
+
+            leveldb::WriteOptions write_options;
+            write_options.sync = true;
+
+            status = db->Write(write_options, &batch);
+
+            if (!status.ok()) { // Abort because of error!
+                throw std::runtime_error(tr("Issues have been encountered while trying to write towards the user profile! Error:\n\n%1").arg(QString::fromStdString(status.ToString())).toStdString());
+            }
+        }
+    } catch (const std::exception &e) {
+        QMessageBox::critical(nullptr, tr("Error!"), QString::fromStdString(e.what()), QMessageBox::Ok);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkLevelDb::write_xmpp_transcript writes the given messages towards the chat transcript of the given chat, in
+ * one batch, and indexes them for GkLevelDb::search_xmpp_transcript(). Unlike the chat log, each message is kept under a
+ * key that sorts by its timestamp, so that the transcript may be read back a window at a time via
+ * GkLevelDb::read_xmpp_transcript().
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param chatJid The bareJid of the chat that the transcript belongs towards.
+ * @param messages The messages to be written, in any order.
+ * @note Any error is thrown rather than shown, as this is called upon GkXmppStanzaWorker's thread as well.
+ */
+void GkLevelDb::write_xmpp_transcript(const QString &chatJid, const QList<GkRecvMsgsTableViewModel> &messages)
+{
+    try {
+        if (!chatJid.isEmpty() && !messages.isEmpty()) {
+            leveldb::WriteBatch batch;
+            leveldb::Status status;
+
+            for (const auto &message: messages) {
+                QByteArray value;
+                QDataStream stream(&value, QIODevice::WriteOnly);
+                stream << static_cast<qint64>(message.timestamp.toMSecsSinceEpoch()) << message.bareJid << message.message;
+
+                const QString key = message.transcriptKey.isEmpty() ? convXmppTranscriptKey(chatJid, message) : message.transcriptKey;
+                batch.Put(key.toStdString(), value.toStdString());
+
+                //
+                // Indexed within the very same batch, so that the search index never misses any of the transcript
+                gkSearchIndex->indexDocument(batch, General::Xmpp::GoogleLevelDb::searchCollectionChats, key, message.timestamp, message.message);
+            }
+
+            leveldb::WriteOptions write_options;
+            write_options.sync = true;
+
+            status = db->Write(write_options, &batch);
+
+            if (!status.ok()) { // Abort because of error!
+                throw std::runtime_error(tr("Issues have been encountered while trying to write towards the user profile! Error:\n\n%1").arg(QString::fromStdString(status.ToString())).toStdString());
+            }
+        }
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkLevelDb::write_xmpp_outbox spools an outgoing message, so that it survives both a loss of connection and a
+ * restart of Small World Deluxe until such a time as it has been delivered. The messages are kept under keys that sort
+ * by when they were queued, so that GkLevelDb::read_xmpp_outbox() returns them in the order they were written.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param clientJid The bareJid of the client that is sending the message.
+ * @param msgId The stanza ID of the message.
+ * @param queuedAt When the message was queued, in milliseconds since the epoch.
+ * @param stanza The message itself, as serialized XML.
+ * @return The key that the message has been written under, for GkLevelDb::remove_xmpp_outbox().
+ * @note Any error is thrown rather than shown, so that the message may still be sent regardless.
+ */
+QString GkLevelDb::write_xmpp_outbox(const QString &clientJid, const QString &msgId, const qint64 &queuedAt, const QByteArray &stanza)
+{
+    try {
+        if (!clientJid.isEmpty() && !msgId.isEmpty() && !stanza.isEmpty()) {
+            leveldb::WriteOptions write_options;
+            leveldb::Status status;
+            write_options.sync = true;
+
+            const QString key = QString("%1_%2!%3!%4").arg(clientJid).arg(General::Xmpp::GoogleLevelDb::keyToConvOutbox)
+                    .arg(std::max<qint64>(0, queuedAt), 20, 10, QChar('0')).arg(msgId);
+            status = db->Put(write_options, key.toStdString(), stanza.toStdString());
+
+            if (!status.ok()) { // Abort because of error!
+                throw std::runtime_error(tr("Issues have been encountered while trying to write towards the user profile! Error:\n\n%1").arg(QString::fromStdString(status.ToString())).toStdString());
+            }
+
+            return key;
+        }
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return QString();
+}
+
+/**
+ * @brief GkLevelDb::remove_xmpp_outbox removes an outgoing message from the spool, once it has either been delivered or
+ * given up on.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param key The key that the message was written under, as returned by GkLevelDb::write_xmpp_outbox().
+ */
+void GkLevelDb::remove_xmpp_outbox(const QString &key)
+{
+    try {
+        if (!key.isEmpty()) {
+            leveldb::WriteOptions write_options;
+            leveldb::Status status;
+            write_options.sync = true;
+
+            status = db->Delete(write_options, key.toStdString());
+
+            if (!status.ok()) { // Abort because of error!
+                throw std::runtime_error(tr("Issues have been encountered while trying to write towards the user profile! Error:\n\n%1").arg(QString::fromStdString(status.ToString())).toStdString());
+            }
+        }
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkLevelDb::write_xmpp_outbox_acked records whether the XMPP server has acknowledged (XEP-0198) a spooled
+ * message, as it will then have stored it for the recipient and the message must never be sent again, not even after a
+ * restart of Small World Deluxe.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param clientJid The bareJid of the client that is sending the message.
+ * @param msgId The stanza ID of the message.
+ * @param acked Whether the message has been acknowledged, or otherwise, is done with altogether.
+ */
+void GkLevelDb::write_xmpp_outbox_acked(const QString &clientJid, const QString &msgId, const bool &acked)
+{
+    try {
+        if (!clientJid.isEmpty() && !msgId.isEmpty()) {
+            leveldb::WriteOptions write_options;
+            leveldb::Status status;
+            write_options.sync = true;
+
+            const std::string key = QString("%1_%2!%3").arg(clientJid).arg(General::Xmpp::GoogleLevelDb::keyToConvOutboxAcked)
+                    .arg(msgId).toStdString();
+            if (acked) {
+                status = db->Put(write_options, key, std::string());
+            } else {
+                status = db->Delete(write_options, key);
+            }
+
+            if (!status.ok()) { // Abort because of error!
+                throw std::runtime_error(tr("Issues have been encountered while trying to write towards the user profile! Error:\n\n%1").arg(QString::fromStdString(status.ToString())).toStdString());
+            }
+        }
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkLevelDb::write_xmpp_receipt_capable records that the given recipient has sent a delivery receipt (XEP-0184),
+ * so that messages towards them are still sent again without one after a restart of Small World Deluxe.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param clientJid The bareJid of the client that received the receipt.
+ * @param bareJid The recipient that sent the receipt.
+ */
+void GkLevelDb::write_xmpp_receipt_capable(const QString &clientJid, const QString &bareJid)
+{
+    try {
+        if (!clientJid.isEmpty() && !bareJid.isEmpty()) {
+            leveldb::WriteOptions write_options;
+            leveldb::Status status;
+            write_options.sync = true;
+
+            const std::string key = QString("%1_%2!%3").arg(clientJid).arg(General::Xmpp::GoogleLevelDb::keyToReceiptCapable)
+                    .arg(bareJid).toStdString();
+            status = db->Put(write_options, key, std::string());
+
+            if (!status.ok()) { // Abort because of error!
+                throw std::runtime_error(tr("Issues have been encountered while trying to write towards the user profile! Error:\n\n%1").arg(QString::fromStdString(status.ToString())).toStdString());
+            }
+        }
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return;
+}
+
 /**
  * @brief GkLevelDb::read_xmpp_chat_log
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
@@ -1985,6 +2197,270 @@ QString GkLevelDb::read_xmpp_recall(const Settings::GkXmppRecall &key)
     return QString::fromStdString(value);
 }
 
+/**
+ * @brief GkLevelDb::read_xmpp_mam_last_id
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The username associated with the message archive in question.
+ * @return The archive ID of the newest message synchronized for the given bareJid, or an empty string should there
+ * not have been any synchronization beforehand.
+ */
+QString GkLevelDb::read_xmpp_mam_last_id(const QString &bareJid) const
+{
+    leveldb::Status status;
+    leveldb::ReadOptions read_options;
+    std::string value = "";
+
+    read_options.verify_checksums = true;
+
+    const std::string key = QString("%1_%2").arg(bareJid).arg(General::Xmpp::GoogleLevelDb::keyToConvMamLastId).toStdString();
+    status = db->Get(read_options, key, &value);
+    return QString::fromStdString(value);
+}
+
+/**
+ * @brief GkLevelDb::read_xmpp_outbox
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param clientJid The bareJid of the client that was sending the messages.
+ * @return The key and serialized XML of each message still spooled, from the oldest to the newest.
+ * @see GkLevelDb::write_xmpp_outbox().
+ */
+QList<std::pair<QString, QByteArray>> GkLevelDb::read_xmpp_outbox(const QString &clientJid) const
+{
+    QList<std::pair<QString, QByteArray>> stanzas;
+    try {
+        if (clientJid.isEmpty()) {
+            return stanzas;
+        }
+
+        const std::string base_key_idx = QString("%1_%2!").arg(clientJid).arg(General::Xmpp::GoogleLevelDb::keyToConvOutbox).toStdString();
+
+        leveldb::ReadOptions read_options;
+        read_options.verify_checksums = true;
+        std::unique_ptr<leveldb::Iterator> it(db->NewIterator(read_options));
+        for (it->Seek(base_key_idx); it->Valid() && it->key().starts_with(base_key_idx); it->Next()) {
+            stanzas.push_back(std::make_pair(QString::fromStdString(it->key().ToString()), QByteArray::fromStdString(it->value().ToString())));
+        }
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return stanzas;
+}
+
+/**
+ * @brief GkLevelDb::read_xmpp_outbox_acked
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param clientJid The bareJid of the client that was sending the messages.
+ * @return The stanza IDs of those spooled messages that the XMPP server has already acknowledged.
+ * @see GkLevelDb::write_xmpp_outbox_acked().
+ */
+QSet<QString> GkLevelDb::read_xmpp_outbox_acked(const QString &clientJid) const
+{
+    QSet<QString> msgIds;
+    try {
+        if (clientJid.isEmpty()) {
+            return msgIds;
+        }
+
+        const std::string base_key_idx = QString("%1_%2!").arg(clientJid).arg(General::Xmpp::GoogleLevelDb::keyToConvOutboxAcked).toStdString();
+
+        leveldb::ReadOptions read_options;
+        read_options.verify_checksums = true;
+        std::unique_ptr<leveldb::Iterator> it(db->NewIterator(read_options));
+        for (it->Seek(base_key_idx); it->Valid() && it->key().starts_with(base_key_idx); it->Next()) {
+            msgIds.insert(QString::fromStdString(it->key().ToString().substr(base_key_idx.size())));
+        }
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return msgIds;
+}
+
+/**
+ * @brief GkLevelDb::read_xmpp_receipt_capable
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param clientJid The bareJid of the client that received the receipts.
+ * @return The bareJids of every recipient that has sent a delivery receipt before.
+ * @see GkLevelDb::write_xmpp_receipt_capable().
+ */
+QSet<QString> GkLevelDb::read_xmpp_receipt_capable(const QString &clientJid) const
+{
+    QSet<QString> bareJids;
+    try {
+        if (clientJid.isEmpty()) {
+            return bareJids;
+        }
+
+        const std::string base_key_idx = QString("%1_%2!").arg(clientJid).arg(General::Xmpp::GoogleLevelDb::keyToReceiptCapable).toStdString();
+
+        leveldb::ReadOptions read_options;
+        read_options.verify_checksums = true;
+        std::unique_ptr<leveldb::Iterator> it(db->NewIterator(read_options));
+        for (it->Seek(base_key_idx); it->Valid() && it->key().starts_with(base_key_idx); it->Next()) {
+            bareJids.insert(QString::fromStdString(it->key().ToString().substr(base_key_idx.size())));
+        }
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return bareJids;
+}
+
+/**
+ * @brief GkLevelDb::read_xmpp_transcript reads a window of messages from the chat transcript of the given chat, which
+ * is kept in order of timestamp so that only the messages in question are read, no matter how long the chat may be.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param chatJid The bareJid of the chat that the transcript belongs towards.
+ * @param cursor The transcript key of the message to read from, exclusive, or an empty string to read from either the
+ * newest (should reading older messages) or oldest (otherwise) message of all.
+ * @param older Whether to read the messages older than the cursor, rather than those newer.
+ * @param count The most messages to be read.
+ * @return The messages that were read, from the oldest to the newest.
+ * @see GkLevelDb::write_xmpp_transcript().
+ */
+QList<GkRecvMsgsTableViewModel> GkLevelDb::read_xmpp_transcript(const QString &chatJid, const QString &cursor,
+                                                                const bool &older, const qint32 &count) const
+{
+    QList<GkRecvMsgsTableViewModel> messages;
+    try {
+        if (chatJid.isEmpty() || count <= 0) {
+            return messages;
+        }
+
+        const std::string base_key_idx = QString("%1_%2!").arg(chatJid).arg(General::Xmpp::GoogleLevelDb::keyToConvTranscript).toStdString();
+        const std::string base_key_rnd = std::string(base_key_idx + "~");
+
+        leveldb::ReadOptions read_options;
+        read_options.verify_checksums = true;
+        std::unique_ptr<leveldb::Iterator> it(db->NewIterator(read_options));
+
+        const auto readMessage = [this, &it]() {
+            return convXmppTranscriptValue(it->key().ToString(), it->value().ToString());
+        };
+
+        if (older) {
+            //
+            // Seek towards the first key at or beyond the cursor, and then step back from there
+            it->Seek(cursor.isEmpty() ? base_key_rnd : cursor.toStdString());
+            if (it->Valid()) {
+                it->Prev();
+            } else {
+                it->SeekToLast();
+            }
+
+            for (; it->Valid() && messages.count() < count; it->Prev()) {
+                if (it->key().ToString() < base_key_idx) {
+                    break;
+                }
+
+                messages.prepend(readMessage());
+            }
+        } else {
+            const std::string start_key = cursor.isEmpty() ? base_key_idx : cursor.toStdString();
+            it->Seek(start_key);
+            if (it->Valid() && !cursor.isEmpty() && it->key().ToString() == start_key) {
+                it->Next();
+            }
+
+            for (; it->Valid() && messages.count() < count; it->Next()) {
+                if (it->key().ToString() >= base_key_rnd) {
+                    break;
+                }
+
+                messages.append(readMessage());
+            }
+        }
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return messages;
+}
+
+/**
+ * @brief GkLevelDb::search_xmpp_transcript finds the most recent messages matching the given query, from amongst the
+ * chat transcripts.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param chatJid The bareJid of the chat whose transcript is to be searched, or an empty string to search every chat.
+ * @param query Words, each matched as the prefix of a word, and/or "quoted phrases", matched word-for-word.
+ * @param limit The most messages to be returned.
+ * @return The messages that were matched, from the newest to the oldest.
+ * @see GkXmppSearchIndex::search().
+ */
+QList<GkRecvMsgsTableViewModel> GkLevelDb::search_xmpp_transcript(const QString &chatJid, const QString &query, const qint32 &limit) const
+{
+    QList<GkRecvMsgsTableViewModel> messages;
+    try {
+        const QString scope = chatJid.isEmpty() ? QString() : QString("%1_%2!").arg(chatJid).arg(General::Xmpp::GoogleLevelDb::keyToConvTranscript);
+        const auto hits = gkSearchIndex->search(General::Xmpp::GoogleLevelDb::searchCollectionChats, query, limit, scope);
+
+        leveldb::ReadOptions read_options;
+        read_options.verify_checksums = true;
+        for (const auto &hit: hits) {
+            std::string value;
+            const std::string key = hit.docId.toStdString();
+            const leveldb::Status status = db->Get(read_options, key, &value);
+            if (status.ok()) {
+                messages.push_back(convXmppTranscriptValue(key, value));
+            }
+        }
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return messages;
+}
+
+/**
+ * @brief GkLevelDb::convXmppTranscriptKey works out where the given message is kept within the chat transcript of the
+ * given chat. The timestamp is zero-padded so that the keys sort in order of time, followed by a hash of the sender and
+ * message body so that the same message being written more than once, such as upon being re-synchronized from the XMPP
+ * server, is only kept the once, whilst two people sending the very same text at the very same time are both kept. Only
+ * the bareJid of the sender is hashed, as they may be given either with or without their resource.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param chatJid The bareJid of the chat that the transcript belongs towards.
+ * @param message The message in question.
+ * @return The transcript key of the message.
+ */
+QString GkLevelDb::convXmppTranscriptKey(const QString &chatJid, const GkRecvMsgsTableViewModel &message) const
+{
+    const qint64 timestamp = std::max<qint64>(0, message.timestamp.toMSecsSinceEpoch());
+    const QString sender = QXmppUtils::jidToBareJid(message.bareJid).toLower();
+    return QString("%1_%2!%3!%4").arg(chatJid).arg(General::Xmpp::GoogleLevelDb::keyToConvTranscript)
+            .arg(timestamp, 20, 10, QChar('0')).arg(qHash(sender + QChar('\n') + message.message), 8, 16, QChar('0'));
+}
+
+/**
+ * @brief GkLevelDb::getSearchIndex
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The full-text search index, which is kept within this very Google LevelDB database.
+ */
+QPointer<GkXmppSearchIndex> GkLevelDb::getSearchIndex() const
+{
+    return gkSearchIndex;
+}
+
+/**
+ * @brief GkLevelDb::convXmppTranscriptValue
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param key The transcript key of the message.
+ * @param value The message as it is kept within the chat transcript.
+ * @return The message itself.
+ * @see GkLevelDb::write_xmpp_transcript().
+ */
+GkRecvMsgsTableViewModel GkLevelDb::convXmppTranscriptValue(const std::string &key, const std::string &value) const
+{
+    GkRecvMsgsTableViewModel message;
+    qint64 timestamp = 0;
+    QDataStream stream(QByteArray::fromStdString(value));
+    stream >> timestamp >> message.bareJid >> message.message;
+    message.timestamp = QDateTime::fromMSecsSinceEpoch(timestamp, Qt::UTC);
+    message.transcriptKey = QString::fromStdString(key);
+
+    return message;
+}
+
 /**
  * @brief GkLevelDb::read_xmpp_alpha_notice
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
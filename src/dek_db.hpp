@@ -44,6 +44,7 @@
 #include "src/defines.hpp"
 #include "src/gk_string_funcs.hpp"
 #include "src/file_io.hpp"
+#include "src/models/xmpp/gk_xmpp_search_index.hpp"
 #include <leveldb/db.h>
 #include <leveldb/status.h>
 #include <qxmpp/QXmppMessage.h>
@@ -51,6 +52,7 @@
 #include <memory>
 #include <string>
 #include <QRect>
+#include <QSet>
 #include <QObject>
 #include <QVector>
 #include <QString>
@@ -121,11 +123,27 @@ public:
     void write_xmpp_recall(const QString &value, const GekkoFyre::Database::Settings::GkXmppRecall &key);
     void write_xmpp_vcard_data(const QMap<QString, std::pair<QByteArray, QByteArray>> &vcard_roster);
     void write_xmpp_alpha_notice(const bool &value);
+    void write_xmpp_mam_last_id(const QString &bareJid, const QString &archiveId);
+    void write_xmpp_transcript(const QString &chatJid, const QList<Network::GkXmpp::GkRecvMsgsTableViewModel> &messages);
+    [[nodiscard]] QString write_xmpp_outbox(const QString &clientJid, const QString &msgId, const qint64 &queuedAt, const QByteArray &stanza);
+    void remove_xmpp_outbox(const QString &key);
+    void write_xmpp_outbox_acked(const QString &clientJid, const QString &msgId, const bool &acked);
+    void write_xmpp_receipt_capable(const QString &clientJid, const QString &bareJid);
     void remove_xmpp_vcard_data(const QMap<QString, std::pair<QByteArray, QByteArray>> &vcard_roster);
     [[nodiscard]] QList<QXmppMessage> read_xmpp_chat_log(const QString &bareJid) const;
     QString read_xmpp_settings(const GekkoFyre::Database::Settings::GkXmppCfg &key);
     QString read_xmpp_recall(const GekkoFyre::Database::Settings::GkXmppRecall &key);
     bool read_xmpp_alpha_notice();
+    [[nodiscard]] QString read_xmpp_mam_last_id(const QString &bareJid) const;
+    [[nodiscard]] QList<std::pair<QString, QByteArray>> read_xmpp_outbox(const QString &clientJid) const;
+    [[nodiscard]] QSet<QString> read_xmpp_outbox_acked(const QString &clientJid) const;
+    [[nodiscard]] QSet<QString> read_xmpp_receipt_capable(const QString &clientJid) const;
+    [[nodiscard]] QList<Network::GkXmpp::GkRecvMsgsTableViewModel> read_xmpp_transcript(const QString &chatJid, const QString &cursor,
+                                                                                       const bool &older, const qint32 &count) const;
+    [[nodiscard]] QList<Network::GkXmpp::GkRecvMsgsTableViewModel> search_xmpp_transcript(const QString &chatJid, const QString &query,
+                                                                                         const qint32 &limit = GK_XMPP_SEARCH_MAX_RESULTS) const;
+    [[nodiscard]] QString convXmppTranscriptKey(const QString &chatJid, const Network::GkXmpp::GkRecvMsgsTableViewModel &message) const;
+    [[nodiscard]] QPointer<GekkoFyre::GkXmppSearchIndex> getSearchIndex() const;
 
     GekkoFyre::Network::GkXmpp::GkServerType convXmppServerTypeFromInt(const qint32 &idx);
     QString convNetworkProtocolEnumToStr(const Network::GkNetworkProtocol &network_protocol);
@@ -171,6 +189,7 @@ private:
     QPointer<GekkoFyre::FileIo> fileIo;
     leveldb::DB *db;
     QRect gkMainWinGeometry;
+    QPointer<GekkoFyre::GkXmppSearchIndex> gkSearchIndex;
 
     std::string processCsvToDB(const std::string &csv_title, const std::string &comma_sep_values, const std::string &data_to_append);
     std::string deleteCsvValForDb(const std::string &comma_sep_values, const std::string &data_to_remove);
@@ -185,6 +204,7 @@ private:
                          const bool &allow_empty_values = false);
 
     QString convXmppVcardKey(const QString &keyToConv, const Network::GkXmpp::GkVcardKeyConv &method);
+    [[nodiscard]] Network::GkXmpp::GkRecvMsgsTableViewModel convXmppTranscriptValue(const std::string &key, const std::string &value) const;
 
     void detect_operating_system(QString &build_cpu_arch, QString &curr_cpu_arch, QString &kernel_type, QString &kernel_vers,
                                  QString &machine_host_name, QString &machine_unique_id, QString &pretty_prod_name,
@@ -0,0 +1,300 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/gk_audio_meter.hpp"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+using namespace GekkoFyre;
+using namespace GkAudioFramework;
+
+namespace {
+//
+// The polyphase FIR interpolator for 4x oversampling, exactly as given within ITU-R BS.1770-4 (Annex 2).
+//
+constexpr float truePeakCoeffs[AUDIO_METER_TRUE_PEAK_OVERSAMPLE][AUDIO_METER_TRUE_PEAK_TAPS_PER_PHASE] = {
+    { 0.0017089843750f, 0.0109863281250f, -0.0196533203125f, 0.0332031250000f, -0.0594482421875f, 0.1373291015625f,
+      0.9721679687500f, -0.1022949218750f, 0.0476074218750f, -0.0266113281250f, 0.0148925781250f, -0.0083007812500f },
+    { -0.0291748046875f, 0.0292968750000f, -0.0517578125000f, 0.0891113281250f, -0.1665039062500f, 0.4650878906250f,
+      0.7797851562500f, -0.2003173828125f, 0.1015625000000f, -0.0582275390625f, 0.0330810546875f, -0.0189208984375f },
+    { -0.0189208984375f, 0.0330810546875f, -0.0582275390625f, 0.1015625000000f, -0.2003173828125f, 0.7797851562500f,
+      0.4650878906250f, -0.1665039062500f, 0.0891113281250f, -0.0517578125000f, 0.0292968750000f, -0.0291748046875f },
+    { -0.0083007812500f, 0.0148925781250f, -0.0266113281250f, 0.0476074218750f, -0.1022949218750f, 0.9721679687500f,
+      0.1373291015625f, -0.0594482421875f, 0.0332031250000f, -0.0196533203125f, 0.0109863281250f, 0.0017089843750f }
+};
+
+//
+// Independent accumulators for the block statistics, so that the compiler may vectorize the loops without needing to
+// re-associate any floating-point arithmetic.
+//
+constexpr size_t meterLanes = 8;
+}
+
+/**
+ * @brief GkAudioMeter::GkAudioMeter
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sample_rate The sample rate of the audio to be metered, measured in hertz.
+ * @param channels The number of interleaved channels within the audio to be metered.
+ * @param window_ms How much audio, measured in milliseconds, each published measurement should span.
+ */
+GkAudioMeter::GkAudioMeter(const quint32 &sample_rate, const quint16 &channels, const quint32 &window_ms)
+    : m_channels(std::clamp<quint16>(channels, 1, AUDIO_METER_MAX_CHANNELS)), m_sumSquares(0.0), m_peak(0.0f),
+      m_truePeak(0.0f), m_clipCount(0), m_framesInWindow(0), m_sequence(0), m_snapRms(0.0f), m_snapPeak(0.0f),
+      m_snapTruePeak(0.0f), m_snapClipCount(0), m_snapNumSamples(0)
+{
+    m_windowFrames = std::max<qint32>(static_cast<qint32>((static_cast<quint64>(sample_rate) * window_ms) / 1000), 1);
+    m_scratch.resize(static_cast<size_t>(AUDIO_METER_CHUNK_FRAMES) * m_channels);
+    m_tpBuf.resize(AUDIO_METER_CHUNK_FRAMES + AUDIO_METER_TRUE_PEAK_TAPS_PER_PHASE - 1);
+    for (auto &history: m_tpHistory) {
+        history.fill(0.0f);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkAudioMeter::process meters a block of signed 16-bit PCM, as captured via OpenAL.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param samples The interleaved samples.
+ * @param frames The number of frames (i.e. samples per channel) given.
+ */
+void GkAudioMeter::process(const qint16 *samples, const size_t &frames)
+{
+    constexpr float scale = 1.0f / 32768.0f;
+    size_t done = 0;
+    while (done < frames) {
+        const size_t chunk = std::min<size_t>(frames - done, AUDIO_METER_CHUNK_FRAMES);
+        const qint16 *src = samples + (done * m_channels);
+        for (size_t i = 0; i < (chunk * m_channels); ++i) {
+            m_scratch[i] = static_cast<float>(src[i]) * scale;
+        }
+
+        processChunk(chunk);
+        done += chunk;
+    }
+
+    return;
+}
+
+/**
+ * @brief GkAudioMeter::process meters a block of normalized, floating-point samples.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param samples The interleaved samples.
+ * @param frames The number of frames (i.e. samples per channel) given.
+ */
+void GkAudioMeter::process(const float *samples, const size_t &frames)
+{
+    size_t done = 0;
+    while (done < frames) {
+        const size_t chunk = std::min<size_t>(frames - done, AUDIO_METER_CHUNK_FRAMES);
+        std::copy(samples + (done * m_channels), samples + ((done + chunk) * m_channels), m_scratch.begin());
+        processChunk(chunk);
+        done += chunk;
+    }
+
+    return;
+}
+
+/**
+ * @brief GkAudioMeter::readLevels reads the latest measurement, without ever blocking the capture thread. This is to be
+ * called from the GUI thread, upon a timer.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param levels The latest measurement.
+ * @return False if nothing has been measured as of yet.
+ */
+bool GkAudioMeter::readLevels(GkAudioLevels &levels) const
+{
+    quint64 seq_begin;
+    quint64 seq_end;
+    do {
+        seq_begin = m_sequence.load(std::memory_order_acquire);
+        if (seq_begin == 0) {
+            return false;
+        }
+
+        if (seq_begin & 1) {
+            continue; // The capture thread is part-way through publishing!
+        }
+
+        levels.rms = m_snapRms.load(std::memory_order_relaxed);
+        levels.peak = m_snapPeak.load(std::memory_order_relaxed);
+        levels.true_peak = m_snapTruePeak.load(std::memory_order_relaxed);
+        levels.clip_count = m_snapClipCount.load(std::memory_order_relaxed);
+        levels.num_samples = m_snapNumSamples.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        seq_end = m_sequence.load(std::memory_order_relaxed);
+    } while ((seq_begin & 1) || seq_begin != seq_end);
+
+    levels.sequence = seq_begin / 2;
+    return true;
+}
+
+/**
+ * @brief GkAudioMeter::getChannels
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The number of interleaved channels being metered.
+ */
+quint16 GkAudioMeter::getChannels() const
+{
+    return m_channels;
+}
+
+/**
+ * @brief GkAudioMeter::processChunk accumulates the statistics for the chunk held within the scratch buffer, and then
+ * publishes them once a whole window's worth has been gathered.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param frames The number of frames within the scratch buffer.
+ */
+void GkAudioMeter::processChunk(const size_t &frames)
+{
+    const size_t count = frames * m_channels;
+    const float clip_threshold = static_cast<float>(AUDIO_METER_CLIP_THRESHOLD);
+
+    std::array<float, meterLanes> sum_squares = {};
+    std::array<float, meterLanes> peak = {};
+    std::array<quint32, meterLanes> clips = {};
+
+    size_t i = 0;
+    for (; (i + meterLanes) <= count; i += meterLanes) {
+        for (size_t j = 0; j < meterLanes; ++j) {
+            const float sample = m_scratch[i + j];
+            const float magnitude = std::fabs(sample);
+            sum_squares[j] += sample * sample;
+            peak[j] = std::max(peak[j], magnitude);
+            clips[j] += (magnitude >= clip_threshold) ? 1 : 0;
+        }
+    }
+
+    for (; i < count; ++i) {
+        const float magnitude = std::fabs(m_scratch[i]);
+        sum_squares[0] += magnitude * magnitude;
+        peak[0] = std::max(peak[0], magnitude);
+        clips[0] += (magnitude >= clip_threshold) ? 1 : 0;
+    }
+
+    for (size_t j = 0; j < meterLanes; ++j) {
+        m_sumSquares += sum_squares[j];
+        m_peak = std::max(m_peak, peak[j]);
+        m_clipCount += clips[j];
+    }
+
+    for (size_t ch = 0; ch < m_channels; ++ch) {
+        m_truePeak = std::max(m_truePeak, measureTruePeak(ch, frames));
+    }
+
+    m_framesInWindow += static_cast<qint32>(frames);
+    if (m_framesInWindow >= m_windowFrames) {
+        publish();
+    }
+
+    return;
+}
+
+/**
+ * @brief GkAudioMeter::measureTruePeak oversamples a single channel of the current chunk by four, and returns the highest
+ * magnitude found in between the samples.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param channel The channel to be measured.
+ * @param frames The number of frames within the scratch buffer.
+ * @return The true peak of the given channel, for this chunk.
+ * @note ITU-R BS.1770-4 <https://www.itu.int/rec/R-REC-BS.1770>.
+ */
+float GkAudioMeter::measureTruePeak(const size_t &channel, const size_t &frames)
+{
+    constexpr size_t history_len = AUDIO_METER_TRUE_PEAK_TAPS_PER_PHASE - 1;
+    auto &history = m_tpHistory[channel];
+
+    std::copy(history.begin(), history.end(), m_tpBuf.begin());
+    for (size_t i = 0; i < frames; ++i) {
+        m_tpBuf[history_len + i] = m_scratch[(i * m_channels) + channel];
+    }
+
+    float true_peak = 0.0f;
+    for (size_t i = 0; i < frames; ++i) {
+        const float *x = m_tpBuf.data() + i;
+        for (size_t phase = 0; phase < AUDIO_METER_TRUE_PEAK_OVERSAMPLE; ++phase) {
+            float y = 0.0f;
+            for (size_t tap = 0; tap < AUDIO_METER_TRUE_PEAK_TAPS_PER_PHASE; ++tap) {
+                y += truePeakCoeffs[phase][tap] * x[tap];
+            }
+
+            true_peak = std::max(true_peak, std::fabs(y));
+        }
+    }
+
+    //
+    // Keep the last few samples of this chunk, for the interpolation of the next!
+    std::copy(m_tpBuf.begin() + frames, m_tpBuf.begin() + frames + history_len, history.begin());
+
+    return true_peak;
+}
+
+/**
+ * @brief GkAudioMeter::publish makes the window that has just been measured available towards the GUI thread, and then
+ * begins a new window.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkAudioMeter::publish()
+{
+    const auto num_samples = static_cast<double>(m_framesInWindow) * m_channels;
+    const auto rms = static_cast<float>(std::sqrt(m_sumSquares / num_samples));
+
+    const quint64 seq = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_snapRms.store(std::min(rms, 1.0f), std::memory_order_relaxed);
+    m_snapPeak.store(std::min(m_peak, 1.0f), std::memory_order_relaxed);
+    m_snapTruePeak.store(std::max(m_truePeak, m_peak), std::memory_order_relaxed);
+    m_snapClipCount.store(m_clipCount, std::memory_order_relaxed);
+    m_snapNumSamples.store(m_framesInWindow, std::memory_order_relaxed);
+
+    m_sequence.store(seq + 2, std::memory_order_release);
+
+    m_sumSquares = 0.0;
+    m_peak = 0.0f;
+    m_truePeak = 0.0f;
+    m_framesInWindow = 0;
+
+    return;
+}
@@ -0,0 +1,103 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include <QtGlobal>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkAudioMeter measures the RMS, sample peak, true peak and clipping of captured audio upon the capture thread
+ * itself. Only the latest measurement is ever kept, within a lock-free snapshot (i.e. a seqlock), which the volume meter
+ * then pulls from upon its own redraw timer. Thusly, the GUI thread never receives a signal per block of audio.
+ */
+class GkAudioMeter {
+
+public:
+    explicit GkAudioMeter(const quint32 &sample_rate, const quint16 &channels,
+                          const quint32 &window_ms = AUDIO_VU_METER_UPDATE_MILLISECS);
+    ~GkAudioMeter() = default;
+
+    GkAudioMeter(const GkAudioMeter &) = delete;
+    GkAudioMeter &operator=(const GkAudioMeter &) = delete;
+
+    void process(const qint16 *samples, const size_t &frames);
+    void process(const float *samples, const size_t &frames);
+
+    [[nodiscard]] bool readLevels(GekkoFyre::GkAudioFramework::GkAudioLevels &levels) const;
+    [[nodiscard]] quint16 getChannels() const;
+
+private:
+    quint16 m_channels;
+    qint32 m_windowFrames;
+
+    //
+    // The following are only ever touched by the capture (i.e. writer) thread
+    std::vector<float> m_scratch;                                               // Normalized, interleaved samples of the current chunk.
+    std::vector<float> m_tpBuf;                                                 // A single channel of the current chunk, preceded by its history.
+    std::array<std::array<float, AUDIO_METER_TRUE_PEAK_TAPS_PER_PHASE - 1>, AUDIO_METER_MAX_CHANNELS> m_tpHistory;
+    double m_sumSquares;
+    float m_peak;
+    float m_truePeak;
+    quint64 m_clipCount;
+    qint32 m_framesInWindow;
+
+    //
+    // The published snapshot, which is written by the capture thread and read by the GUI thread
+    std::atomic<quint64> m_sequence;
+    std::atomic<float> m_snapRms;
+    std::atomic<float> m_snapPeak;
+    std::atomic<float> m_snapTruePeak;
+    std::atomic<quint64> m_snapClipCount;
+    std::atomic<qint32> m_snapNumSamples;
+
+    void processChunk(const size_t &frames);
+    [[nodiscard]] float measureTruePeak(const size_t &channel, const size_t &frames);
+    void publish();
+
+};
+};
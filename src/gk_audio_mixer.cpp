@@ -0,0 +1,915 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/gk_audio_mixer.hpp"
+#include <cmath>
+#include <chrono>
+#include <climits>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <exception>
+#include <QMutexLocker>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <sndfile.h>
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+using namespace GekkoFyre;
+using namespace GkAudioFramework;
+using namespace Database;
+using namespace Settings;
+using namespace Audio;
+using namespace System;
+using namespace Events;
+using namespace Logging;
+
+/**
+ * @brief GkAudioStream::GkAudioStream
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sample_rate The sample rate of the audio, which must match that of the mixer.
+ * @param capacity How many frames may be held at once, which is rounded up towards a power of two.
+ */
+GkAudioStream::GkAudioStream(const quint32 &sample_rate, const size_t &capacity)
+    : m_mask(0), m_sampleRate(sample_rate), m_head(0), m_tail(0), m_dropped(0), m_closed(false)
+{
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    m_buffer.resize(size, 0.0f);
+    m_mask = size - 1;
+
+    return;
+}
+
+/**
+ * @brief GkAudioStream::write hands audio towards the mixer, which must only ever be done from the one thread.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param samples The mono samples to be played.
+ * @param count The number of samples.
+ * @return The number of samples that fit, with the remainder having been dropped.
+ */
+size_t GkAudioStream::write(const float *samples, const size_t &count)
+{
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    const size_t tail = m_tail.load(std::memory_order_acquire);
+    const size_t len = std::min(count, m_buffer.size() - (head - tail));
+    for (size_t i = 0; i < len; ++i) {
+        m_buffer[(head + i) & m_mask] = samples[i];
+    }
+
+    m_head.store(head + len, std::memory_order_release);
+    if (len < count) {
+        m_dropped += (count - len);
+    }
+
+    return len;
+}
+
+/**
+ * @brief GkAudioStream::read takes audio from the stream, which must only ever be done by the mixer thread.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param out Where the samples are to be written.
+ * @param count The most samples wanted.
+ * @return The number of samples that were read.
+ */
+size_t GkAudioStream::read(float *out, const size_t &count)
+{
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    const size_t head = m_head.load(std::memory_order_acquire);
+    const size_t len = std::min(count, head - tail);
+    for (size_t i = 0; i < len; ++i) {
+        out[i] = m_buffer[(tail + i) & m_mask];
+    }
+
+    m_tail.store(tail + len, std::memory_order_release);
+    return len;
+}
+
+/**
+ * @brief GkAudioStream::close lets the mixer know that no more audio is to come, whereupon the voice finishes once it
+ * has played whatever is left.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkAudioStream::close()
+{
+    m_closed = true;
+    return;
+}
+
+bool GkAudioStream::isClosed() const
+{
+    return m_closed;
+}
+
+quint32 GkAudioStream::getSampleRate() const
+{
+    return m_sampleRate;
+}
+
+quint64 GkAudioStream::getDroppedCount() const
+{
+    return m_dropped;
+}
+
+/**
+ * @brief GkAudioMixer::GkAudioMixer is the one and only owner of the output audio device's context, whereby all sounds
+ * (i.e. file playback, alerts, sidetone, etc.) are mixed together upon a single, real-time thread and then streamed out
+ * through a single OpenAL source. Voices are added and removed via lock-free queues, so the mixer thread never waits
+ * upon a lock, nor allocates or frees any memory.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param outputDevice The output audio device, which must already have an OpenAL context.
+ * @param eventLogger The event logging class.
+ * @param parent The parent object to this class.
+ */
+GkAudioMixer::GkAudioMixer(const GkDevice &outputDevice, QPointer<GkEventLogger> eventLogger, QObject *parent)
+    : QObject(parent), m_running(false), m_nextVoiceId(1), m_underruns(0), m_cmdQueue(GK_AUDIO_MIXER_CMD_QUEUE_SIZE),
+      m_retireQueue(GK_AUDIO_MIXER_CMD_QUEUE_SIZE), m_masterGain(1.0f), m_limiterGain(1.0f), m_limiterRelease(0.0f),
+      m_sampleRate(GK_AUDIO_FFMPEG_DEFAULT_SAMPLE_RATE)
+{
+    gkEventLogger = std::move(eventLogger);
+    gkOutputDevice = outputDevice;
+
+    if (gkOutputDevice.alDevice) {
+        ALCint freq = 0;
+        alcGetIntegerv(gkOutputDevice.alDevice, ALC_FREQUENCY, 1, &freq);
+        if (freq > 0) {
+            m_sampleRate = static_cast<quint32>(freq);
+        }
+    }
+
+    //
+    // One-pole release coefficient for the master limiter!
+    m_limiterRelease = static_cast<float>(1.0 - std::exp(-1.0 / ((GK_AUDIO_MIXER_LIMITER_RELEASE_MILLISECS / 1000.0) * m_sampleRate)));
+
+    m_mixBuf.resize(GK_AUDIO_MIXER_BLOCK_FRAMES * GK_AUDIO_MIXER_OUTPUT_CHANNELS);
+    m_srcBuf.resize(GK_AUDIO_MIXER_BLOCK_FRAMES * GK_AUDIO_MIXER_MAX_SRC_CHANNELS);
+    m_outBuf.resize(GK_AUDIO_MIXER_BLOCK_FRAMES * GK_AUDIO_MIXER_OUTPUT_CHANNELS);
+
+    m_retireTimer = new QTimer(this);
+    QObject::connect(m_retireTimer, SIGNAL(timeout()), this, SLOT(collectFinishedVoices()));
+
+    return;
+}
+
+GkAudioMixer::~GkAudioMixer()
+{
+    stop();
+}
+
+/**
+ * @brief GkAudioMixer::start launches the mixer thread.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkAudioMixer::start()
+{
+    try {
+        if (m_running) {
+            return;
+        }
+
+        if (!gkOutputDevice.alDevice || !gkOutputDevice.alDeviceCtx) {
+            throw std::invalid_argument(tr("An issue was detected with your choice of output audio device. Please check your configuration and try again.").toStdString());
+        }
+
+        m_running = true;
+        mixerThread = std::thread(&GkAudioMixer::run, this);
+        m_retireTimer->start(GK_AUDIO_MIXER_RETIRE_INTERVAL_MILLISECS);
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkAudioMixer::stop halts the mixer thread, along with all of the voices that were playing.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkAudioMixer::stop()
+{
+    m_running = false;
+    if (mixerThread.joinable()) {
+        mixerThread.join();
+    }
+
+    if (m_retireTimer) {
+        m_retireTimer->stop();
+    }
+
+    //
+    // The mixer thread is no more, so it is now safe to release everything from here!
+    for (auto &voice: m_voices) {
+        voice = GkMixerVoice();
+    }
+
+    GkMixerCmd cmd;
+    while (m_cmdQueue.pop(cmd)) {}
+    collectFinishedVoices();
+
+    return;
+}
+
+/**
+ * @brief GkAudioMixer::isRunning
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return Whether the mixer thread is running.
+ */
+bool GkAudioMixer::isRunning() const
+{
+    return m_running;
+}
+
+/**
+ * @brief GkAudioMixer::getSampleRate
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The sample rate of the output audio device, which all voices are mixed at.
+ */
+quint32 GkAudioMixer::getSampleRate() const
+{
+    return m_sampleRate;
+}
+
+/**
+ * @brief GkAudioMixer::getUnderrunCount
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The number of times the OpenAL source ran dry before the mixer thread could refill it.
+ */
+quint64 GkAudioMixer::getUnderrunCount() const
+{
+    return m_underruns;
+}
+
+/**
+ * @brief GkAudioMixer::loadClip decodes a short sound (i.e. an alert or notification) into memory at the mixer's sample
+ * rate, and keeps it cached for whenever it is next played.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param file_path The audio file to be decoded, which may be of any format supported by libsndfile.
+ * @return The decoded clip.
+ */
+std::shared_ptr<const GkAudioClip> GkAudioMixer::loadClip(const QFileInfo &file_path)
+{
+    try {
+        const QString key = file_path.canonicalFilePath();
+        {
+            std::lock_guard<std::mutex> lock_guard(m_clipCacheMtx);
+            const auto it = m_clipCache.constFind(key);
+            if (it != m_clipCache.constEnd()) {
+                return it.value();
+            }
+        }
+
+        std::shared_ptr<const GkAudioClip> clip = decodeClip(file_path);
+        if ((clip->frames / static_cast<double>(clip->sample_rate)) <= GK_AUDIO_MIXER_CLIP_CACHE_MAX_SECS) {
+            std::lock_guard<std::mutex> lock_guard(m_clipCacheMtx);
+            m_clipCache.insert(key, clip);
+        }
+
+        return clip;
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief GkAudioMixer::playClip begins playing an already decoded clip, such as one created by the signal generator.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param clip The clip to be played, which must already be at the mixer's sample rate.
+ * @param gain The gain of this voice, where 1.0 is unity.
+ * @param loop Whether to keep on playing the clip until it is stopped.
+ * @return The identifier of the newly created voice, or zero upon failure.
+ */
+quint64 GkAudioMixer::playClip(std::shared_ptr<const GkAudioClip> clip, const float &gain, const bool &loop)
+{
+    if (!clip || clip->frames <= 0 || clip->channels == 0) {
+        return 0;
+    }
+
+    GkMixerVoice voice;
+    voice.clip = std::move(clip);
+    voice.gain = gain;
+    voice.loop = loop;
+
+    return submitVoice(std::move(voice));
+}
+
+/**
+ * @brief GkAudioMixer::playClip decodes (or fetches from the cache) a short sound, and then begins playing it.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param file_path The audio file to be played.
+ * @param gain The gain of this voice, where 1.0 is unity.
+ * @param loop Whether to keep on playing the clip until it is stopped.
+ * @return The identifier of the newly created voice, or zero upon failure.
+ */
+quint64 GkAudioMixer::playClip(const QFileInfo &file_path, const float &gain, const bool &loop)
+{
+    try {
+        return playClip(loadClip(file_path), gain, loop);
+    } catch (const std::exception &e) {
+        gkEventLogger->publishEvent(QString::fromStdString(e.what()), GkSeverity::Error, "", false, true, false, true, false);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief GkAudioMixer::playFile plays an audio file of any length. WAV/RF64 files that are already at the mixer's sample
+ * rate are streamed straight from a memory-map, so that even multi-gigabyte recordings begin playing instantly, while
+ * anything else is decoded in full beforehand.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param file_path The audio file to be played.
+ * @param gain The gain of this voice, where 1.0 is unity.
+ * @return The identifier of the newly created voice, or zero upon failure.
+ */
+quint64 GkAudioMixer::playFile(const QFileInfo &file_path, const float &gain)
+{
+    try {
+        if (GkMmapAudioFile::isMappable(file_path)) {
+            try {
+                auto mapped = std::make_shared<GkMmapAudioFile>(file_path);
+                const auto pcm_fmt = mapped->getFormat();
+                if (pcm_fmt.sample_rate == m_sampleRate && pcm_fmt.channels <= GK_AUDIO_MIXER_MAX_SRC_CHANNELS) {
+                    GkMixerVoice voice;
+                    voice.mapped = std::move(mapped);
+                    voice.gain = gain;
+
+                    return submitVoice(std::move(voice));
+                }
+            } catch (const std::exception &) {
+                //
+                // Not a WAV/RF64 file that we can map, so fall back onto libsndfile instead!
+            }
+        }
+
+        GkMixerVoice voice;
+        voice.clip = decodeClip(file_path);
+        voice.gain = gain;
+
+        return submitVoice(std::move(voice));
+    } catch (const std::exception &e) {
+        gkEventLogger->publishEvent(QString::fromStdString(e.what()), GkSeverity::Error, "", false, true, false, true, false);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief GkAudioMixer::playStream begins playing live audio, for as long as the stream remains open.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param stream The stream to be played, which must already be at the mixer's sample rate.
+ * @param gain The gain of this voice, where 1.0 is unity.
+ * @return The identifier of the newly created voice, or zero upon failure.
+ */
+quint64 GkAudioMixer::playStream(std::shared_ptr<GkAudioStream> stream, const float &gain)
+{
+    if (!stream || stream->isClosed()) {
+        return 0;
+    }
+
+    if (stream->getSampleRate() != m_sampleRate) {
+        gkEventLogger->publishEvent(tr("Live audio at %1 Hz cannot be played by the mixer, which runs at %2 Hz!")
+                                            .arg(QString::number(stream->getSampleRate()), QString::number(m_sampleRate)),
+                                    GkSeverity::Warning, "", false, true, false, false, false);
+        return 0;
+    }
+
+    GkMixerVoice voice;
+    voice.stream = std::move(stream);
+    voice.gain = gain;
+
+    return submitVoice(std::move(voice));
+}
+
+/**
+ * @brief GkAudioMixer::stopVoice stops playing the given voice.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param voice_id The identifier of the voice to be stopped.
+ */
+void GkAudioMixer::stopVoice(const quint64 &voice_id)
+{
+    GkMixerCmd cmd;
+    cmd.type = RemoveVoice;
+    cmd.voice_id = voice_id;
+    submitCmd(std::move(cmd));
+
+    return;
+}
+
+/**
+ * @brief GkAudioMixer::setVoiceGain changes the gain of the given voice while it is playing.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param voice_id The identifier of the voice in question.
+ * @param gain The new gain, where 1.0 is unity.
+ */
+void GkAudioMixer::setVoiceGain(const quint64 &voice_id, const float &gain)
+{
+    GkMixerCmd cmd;
+    cmd.type = SetVoiceGain;
+    cmd.voice_id = voice_id;
+    cmd.gain = std::max(gain, 0.0f);
+    submitCmd(std::move(cmd));
+
+    return;
+}
+
+/**
+ * @brief GkAudioMixer::setMasterGain changes the gain that is applied to the mix as a whole, before the limiter.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param gain The new gain, where 1.0 is unity.
+ */
+void GkAudioMixer::setMasterGain(const float &gain)
+{
+    GkMixerCmd cmd;
+    cmd.type = SetMasterGain;
+    cmd.gain = std::max(gain, 0.0f);
+    submitCmd(std::move(cmd));
+
+    return;
+}
+
+/**
+ * @brief GkAudioMixer::stopAll stops playing each and every voice.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkAudioMixer::stopAll()
+{
+    GkMixerCmd cmd;
+    cmd.type = RemoveAllVoices;
+    submitCmd(std::move(cmd));
+
+    return;
+}
+
+/**
+ * @brief GkAudioMixer::collectFinishedVoices releases the voices that the mixer thread has finished with, upon the control
+ * thread rather than the mixer thread, and announces that they have finished.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkAudioMixer::collectFinishedVoices()
+{
+    GkMixerVoice voice;
+    while (m_retireQueue.pop(voice)) {
+        const quint64 voice_id = voice.id;
+        voice = GkMixerVoice();
+        emit voiceFinished(voice_id);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkAudioMixer::run is the mixer thread itself. It keeps a handful of buffers queued upon a single OpenAL source,
+ * refilling each one as it is played out, and otherwise sleeps for around half a block at a time rather than polling.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @note OpenAL Streaming Example <https://github.com/kcat/openal-soft/blob/master/examples/alstream.c>.
+ */
+void GkAudioMixer::run()
+{
+    //
+    // The context is made current for the mixer thread alone (ALC_EXT_thread_local_context), so that the process-wide
+    // context relied upon by the other users of OpenAL is left well alone
+    PFNALCSETTHREADCONTEXTPROC setThreadContext = nullptr;
+    if (alcIsExtensionPresent(gkOutputDevice.alDevice, "ALC_EXT_thread_local_context")) {
+        setThreadContext = reinterpret_cast<PFNALCSETTHREADCONTEXTPROC>(alcGetProcAddress(gkOutputDevice.alDevice, "alcSetThreadContext"));
+    }
+
+    //
+    // Otherwise, we fall back upon the process-wide context, holding onto `m_alContextMtx` whilst making any OpenAL calls
+    // and making the context current once more should it have been changed in the meantime
+    const auto lockSharedContext = [this](std::unique_lock<std::mutex> &lock) {
+        lock = std::unique_lock<std::mutex>(m_alContextMtx);
+        if (alcGetCurrentContext() != gkOutputDevice.alDeviceCtx && alcMakeContextCurrent(gkOutputDevice.alDeviceCtx) != ALC_TRUE) {
+            throw std::runtime_error(tr("ERROR: Attempt at making the audio context current has failed for output device!").toStdString());
+        }
+    };
+
+    try {
+        std::unique_lock<std::mutex> ctx_lock;
+        if (setThreadContext) {
+            if (setThreadContext(gkOutputDevice.alDeviceCtx) != ALC_TRUE) {
+                throw std::runtime_error(tr("ERROR: Attempt at making the audio context current has failed for output device!").toStdString());
+            }
+        } else {
+            gkEventLogger->publishEvent(tr("OpenAL does not support \"ALC_EXT_thread_local_context\", so the audio mixer shall share the process-wide audio context instead."),
+                                        GkSeverity::Warning, "", false, true, false, false, false);
+            lockSharedContext(ctx_lock);
+        }
+
+        ALuint source;
+        std::array<ALuint, GK_AUDIO_MIXER_NUM_BUFS> buffers;
+        alCall(alGenSources, 1, &source);
+        alCall(alGenBuffers, GK_AUDIO_MIXER_NUM_BUFS, buffers.data());
+        alCall(alSourcef, source, AL_GAIN, 1.0f);
+
+        const auto block_bytes = static_cast<ALsizei>(m_outBuf.size() * sizeof(ALshort));
+        for (const auto &buffer: buffers) {
+            mixBlock();
+            alBufferData(buffer, AL_FORMAT_STEREO16, m_outBuf.data(), block_bytes, static_cast<ALsizei>(m_sampleRate));
+        }
+
+        alSourceQueueBuffers(source, GK_AUDIO_MIXER_NUM_BUFS, buffers.data());
+        alSourcePlay(source);
+        if (ctx_lock.owns_lock()) {
+            ctx_lock.unlock();
+        }
+
+        const auto sleep_time = std::chrono::microseconds((GK_AUDIO_MIXER_BLOCK_FRAMES * 1000000LL) / (2 * m_sampleRate));
+        while (m_running) {
+            processCommands();
+            if (!setThreadContext) {
+                lockSharedContext(ctx_lock);
+            }
+
+            ALint processed = 0;
+            alGetSourcei(source, AL_BUFFERS_PROCESSED, &processed);
+            while (processed-- > 0) {
+                ALuint buffer;
+                alSourceUnqueueBuffers(source, 1, &buffer);
+                mixBlock();
+                alBufferData(buffer, AL_FORMAT_STEREO16, m_outBuf.data(), block_bytes, static_cast<ALsizei>(m_sampleRate));
+                alSourceQueueBuffers(source, 1, &buffer);
+            }
+
+            ALint state = AL_PLAYING;
+            alGetSourcei(source, AL_SOURCE_STATE, &state);
+            if (state != AL_PLAYING && state != AL_PAUSED) {
+                //
+                // We were too slow in refilling the buffers, so the source ran dry and must be restarted!
+                ++m_underruns;
+                alSourcePlay(source);
+            }
+
+            if (ctx_lock.owns_lock()) {
+                ctx_lock.unlock();
+            }
+
+            std::this_thread::sleep_for(sleep_time);
+        }
+
+        if (!setThreadContext) {
+            lockSharedContext(ctx_lock);
+        }
+
+        alSourceStop(source);
+        alSourcei(source, AL_BUFFER, 0);
+        alCall(alDeleteSources, 1, &source);
+        alCall(alDeleteBuffers, GK_AUDIO_MIXER_NUM_BUFS, buffers.data());
+    } catch (const std::exception &e) {
+        m_running = false;
+        gkEventLogger->publishEvent(QString::fromStdString(e.what()), GkSeverity::Fatal, "", false, true, false, true, false);
+    }
+
+    if (setThreadContext) {
+        setThreadContext(nullptr);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkAudioMixer::processCommands applies any pending commands from the control thread(s) to the voices.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkAudioMixer::processCommands()
+{
+    GkMixerCmd cmd;
+    while (m_cmdQueue.pop(cmd)) {
+        switch (cmd.type) {
+            case AddVoice:
+            {
+                auto free_slot = std::find_if(m_voices.begin(), m_voices.end(), [](const GkMixerVoice &voice) {
+                    return !voice.active && !voice.clip && !voice.mapped && !voice.stream;
+                });
+
+                if (free_slot != m_voices.end()) {
+                    *free_slot = std::move(cmd.voice);
+                    free_slot->active = true;
+                } else {
+                    //
+                    // No room left, so hand it straight back as having finished!
+                    m_retireQueue.push(std::move(cmd.voice));
+                }
+
+                break;
+            }
+            case RemoveVoice:
+                for (auto &voice: m_voices) {
+                    if (voice.active && voice.id == cmd.voice_id) {
+                        voice.active = false;
+                    }
+                }
+
+                break;
+            case SetVoiceGain:
+                for (auto &voice: m_voices) {
+                    if (voice.active && voice.id == cmd.voice_id) {
+                        voice.gain = cmd.gain;
+                    }
+                }
+
+                break;
+            case SetMasterGain:
+                m_masterGain = cmd.gain;
+                break;
+            case RemoveAllVoices:
+                for (auto &voice: m_voices) {
+                    voice.active = false;
+                }
+
+                break;
+            default:
+                break;
+        }
+    }
+
+    //
+    // Hand back any voices that have finished, whether they came to an end or were stopped!
+    for (auto &voice: m_voices) {
+        if (!voice.active && (voice.clip || voice.mapped || voice.stream)) {
+            retireVoice(voice);
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief GkAudioMixer::mixBlock mixes a single block of all the active voices, applies the master gain and limiter, and
+ * then converts the result towards 16-bit PCM ready for OpenAL.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkAudioMixer::mixBlock()
+{
+    std::fill(m_mixBuf.begin(), m_mixBuf.end(), 0.0f);
+    for (auto &voice: m_voices) {
+        if (voice.active) {
+            mixVoice(voice, GK_AUDIO_MIXER_BLOCK_FRAMES);
+        }
+    }
+
+    //
+    // Peak limiter with an instantaneous attack and a one-pole release, linked across both channels!
+    const auto threshold = static_cast<float>(GK_AUDIO_MIXER_LIMITER_THRESHOLD);
+    float limiter_gain = m_limiterGain;
+    for (size_t i = 0; i < GK_AUDIO_MIXER_BLOCK_FRAMES; ++i) {
+        float &left = m_mixBuf[(i * GK_AUDIO_MIXER_OUTPUT_CHANNELS)];
+        float &right = m_mixBuf[(i * GK_AUDIO_MIXER_OUTPUT_CHANNELS) + 1];
+        left *= m_masterGain;
+        right *= m_masterGain;
+
+        const float peak = std::max(std::fabs(left), std::fabs(right));
+        const float target = (peak > threshold) ? (threshold / peak) : 1.0f;
+        if (target < limiter_gain) {
+            limiter_gain = target;
+        } else {
+            limiter_gain += (target - limiter_gain) * m_limiterRelease;
+        }
+
+        left *= limiter_gain;
+        right *= limiter_gain;
+    }
+
+    m_limiterGain = limiter_gain;
+    for (size_t i = 0; i < m_mixBuf.size(); ++i) {
+        m_outBuf[i] = static_cast<ALshort>(std::lrint(std::clamp(m_mixBuf[i], -1.0f, 1.0f) * SHRT_MAX));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkAudioMixer::mixVoice adds the next frames of the given voice into the mix. Mono voices are sent to both output
+ * channels, while anything with more than two channels has only its first two mixed in.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param voice The voice to be mixed.
+ * @param frames The number of frames to be mixed.
+ */
+void GkAudioMixer::mixVoice(GkMixerVoice &voice, const qint64 &frames)
+{
+    qint64 done = 0;
+    while (done < frames && voice.active) {
+        const float *src;
+        quint16 channels;
+        qint64 avail;
+        if (voice.stream) {
+            //
+            // A live stream that has run dry is merely silent for now, unless it has been closed by its producer
+            channels = 1;
+            avail = static_cast<qint64>(voice.stream->read(m_srcBuf.data(), static_cast<size_t>(frames - done)));
+            src = m_srcBuf.data();
+            if (avail <= 0) {
+                voice.active = !voice.stream->isClosed();
+                break;
+            }
+        } else if (voice.clip) {
+            channels = voice.clip->channels;
+            avail = std::min(frames - done, voice.clip->frames - voice.pos);
+            src = voice.clip->samples.data() + (voice.pos * channels);
+        } else {
+            if (voice.pos >= voice.adviseEnd) {
+                //
+                // Only ever a window of the file is kept resident, which slides along with playback, rather than every page
+                // touched thus far being left for the kernel to reclaim whenever it so pleases
+                voice.mapped->adviseWindow(voice.pos, GK_AUDIO_MIXER_MMAP_WINDOW_FRAMES);
+                voice.adviseEnd = voice.pos + (GK_AUDIO_MIXER_MMAP_WINDOW_FRAMES / 2);
+            }
+
+            channels = voice.mapped->getFormat().channels;
+            avail = voice.mapped->readFloat(voice.pos, frames - done, m_srcBuf.data());
+            src = m_srcBuf.data();
+        }
+
+        if (avail <= 0) {
+            if (voice.loop && voice.pos > 0) {
+                voice.pos = 0;
+                voice.adviseEnd = 0;
+                continue;
+            }
+
+            voice.active = false;
+            break;
+        }
+
+        float *dst = m_mixBuf.data() + (done * GK_AUDIO_MIXER_OUTPUT_CHANNELS);
+        const float gain = voice.gain;
+        if (channels == 1) {
+            for (qint64 i = 0; i < avail; ++i) {
+                const float sample = src[i] * gain;
+                dst[(i * 2)] += sample;
+                dst[(i * 2) + 1] += sample;
+            }
+        } else {
+            for (qint64 i = 0; i < avail; ++i) {
+                dst[(i * 2)] += src[(i * channels)] * gain;
+                dst[(i * 2) + 1] += src[(i * channels) + 1] * gain;
+            }
+        }
+
+        voice.pos += avail;
+        done += avail;
+    }
+
+    return;
+}
+
+/**
+ * @brief GkAudioMixer::retireVoice hands a finished voice back towards the control thread. Should the queue be full, then
+ * the voice is simply kept until the next attempt, so that its memory is never freed upon the mixer thread.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param voice The voice that has finished.
+ */
+void GkAudioMixer::retireVoice(GkMixerVoice &voice)
+{
+    GkMixerVoice retired = std::move(voice);
+    if (!m_retireQueue.push(std::move(retired))) {
+        voice = std::move(retired);
+        return;
+    }
+
+    voice = GkMixerVoice();
+    return;
+}
+
+/**
+ * @brief GkAudioMixer::submitVoice assigns an identifier to a new voice and passes it along to the mixer thread.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param voice The voice to be played.
+ * @return The identifier of the voice, or zero upon failure.
+ */
+quint64 GkAudioMixer::submitVoice(GkMixerVoice &&voice)
+{
+    if (!m_running) {
+        return 0;
+    }
+
+    voice.id = m_nextVoiceId++;
+    const quint64 voice_id = voice.id;
+
+    GkMixerCmd cmd;
+    cmd.type = AddVoice;
+    cmd.voice = std::move(voice);
+    if (!m_cmdQueue.push(std::move(cmd))) {
+        gkEventLogger->publishEvent(tr("The audio mixer is too busy to play any more sounds at the moment!"),
+                                    GkSeverity::Warning, "", false, true, false, false, false);
+        return 0;
+    }
+
+    return voice_id;
+}
+
+/**
+ * @brief GkAudioMixer::submitCmd passes along a command to the mixer thread.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param cmd The command in question.
+ */
+void GkAudioMixer::submitCmd(GkMixerCmd &&cmd)
+{
+    if (!m_cmdQueue.push(std::move(cmd))) {
+        gkEventLogger->publishEvent(tr("The audio mixer is too busy to accept any further commands at the moment!"),
+                                    GkSeverity::Warning, "", false, true, false, false, false);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkAudioMixer::decodeClip decodes an audio file in full via libsndfile, resampling it (linearly) to the mixer's
+ * own sample rate where needed, so that the mixer thread itself never has to.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param file_path The audio file to be decoded.
+ * @return The decoded clip.
+ */
+std::shared_ptr<GkAudioClip> GkAudioMixer::decodeClip(const QFileInfo &file_path) const
+{
+    SF_INFO sfinfo = {};
+    SNDFILE *sndfile = sf_open(file_path.absoluteFilePath().toStdString().c_str(), SFM_READ, &sfinfo);
+    if (!sndfile) {
+        throw std::runtime_error(tr("Unable to open audio file and thusly initialize libsndfile, \"%1\"!")
+                                         .arg(file_path.fileName()).toStdString());
+    }
+
+    if (sfinfo.frames < 1 || sfinfo.channels < 1 || sfinfo.samplerate < 1) {
+        sf_close(sndfile);
+        throw std::runtime_error(tr("Bad sample count in, \"%1\" (%2 frames)!")
+                                         .arg(file_path.fileName(), QString::number(sfinfo.frames)).toStdString());
+    }
+
+    std::vector<float> decoded(static_cast<size_t>(sfinfo.frames) * sfinfo.channels);
+    const sf_count_t num_frames = sf_readf_float(sndfile, decoded.data(), sfinfo.frames);
+    sf_close(sndfile);
+
+    if (num_frames < 1) {
+        throw std::runtime_error(tr("Failed to read samples in %1 (%2 frames)!")
+                                         .arg(file_path.fileName(), QString::number(num_frames)).toStdString());
+    }
+
+    auto clip = std::make_shared<GkAudioClip>();
+    clip->channels = static_cast<quint16>(std::min(sfinfo.channels, 2));
+    clip->sample_rate = m_sampleRate;
+
+    const double step = static_cast<double>(sfinfo.samplerate) / m_sampleRate;
+    clip->frames = static_cast<qint64>(std::floor((num_frames - 1) / step)) + 1;
+    clip->samples.resize(static_cast<size_t>(clip->frames) * clip->channels);
+    for (qint64 i = 0; i < clip->frames; ++i) {
+        const double pos = i * step;
+        const auto idx = static_cast<qint64>(pos);
+        const auto frac = static_cast<float>(pos - idx);
+        const qint64 next = std::min(idx + 1, static_cast<qint64>(num_frames - 1));
+        for (quint16 j = 0; j < clip->channels; ++j) {
+            const float a = decoded[(idx * sfinfo.channels) + j];
+            const float b = decoded[(next * sfinfo.channels) + j];
+            clip->samples[(i * clip->channels) + j] = a + ((b - a) * frac);
+        }
+    }
+
+    return clip;
+}
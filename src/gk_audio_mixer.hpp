@@ -0,0 +1,215 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include "src/gk_logger.hpp"
+#include "src/audio_devices.hpp"
+#include "src/gk_mmap_audio.hpp"
+#include "src/gk_lockfree_queue.hpp"
+#include <AL/al.h>
+#include <AL/alc.h>
+#include <AL/alext.h>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <QHash>
+#include <QTimer>
+#include <QObject>
+#include <QString>
+#include <QPointer>
+#include <QFileInfo>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkAudioClip is a short sound that has been decoded in full, already at the sample rate of the mixer.
+ */
+struct GkAudioClip {
+    std::vector<float> samples;                                                 // Normalized, interleaved samples.
+    quint16 channels = 0;
+    quint32 sample_rate = 0;
+    qint64 frames = 0;
+};
+
+/**
+ * @brief GkAudioStream is a live source of mono audio for the mixer, such as a demodulated SDR channel. It is written to
+ * by a single producer thread and read from by the mixer thread alone, without any locks. Whatever cannot fit is dropped,
+ * and the mixer simply plays silence should the stream run dry.
+ */
+class GkAudioStream {
+
+public:
+    explicit GkAudioStream(const quint32 &sample_rate, const size_t &capacity = GK_AUDIO_MIXER_STREAM_FRAMES);
+
+    GkAudioStream(const GkAudioStream &) = delete;
+    GkAudioStream &operator=(const GkAudioStream &) = delete;
+
+    size_t write(const float *samples, const size_t &count);
+    size_t read(float *out, const size_t &count);
+    void close();
+
+    [[nodiscard]] bool isClosed() const;
+    [[nodiscard]] quint32 getSampleRate() const;
+    [[nodiscard]] quint64 getDroppedCount() const;
+
+private:
+    std::vector<float> m_buffer;
+    size_t m_mask;
+    quint32 m_sampleRate;
+    std::atomic<size_t> m_head;                                                 // Only ever advanced by the producer.
+    std::atomic<size_t> m_tail;                                                 // Only ever advanced by the mixer thread.
+    std::atomic<quint64> m_dropped;
+    std::atomic<bool> m_closed;
+
+};
+
+class GkAudioMixer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GkAudioMixer(const GekkoFyre::Database::Settings::Audio::GkDevice &outputDevice,
+                          QPointer<GekkoFyre::GkEventLogger> eventLogger, QObject *parent = nullptr);
+    ~GkAudioMixer() override;
+
+    void start();
+    void stop();
+    [[nodiscard]] bool isRunning() const;
+    [[nodiscard]] quint32 getSampleRate() const;
+    [[nodiscard]] quint64 getUnderrunCount() const;
+
+    [[nodiscard]] std::shared_ptr<const GekkoFyre::GkAudioClip> loadClip(const QFileInfo &file_path);
+
+    quint64 playClip(std::shared_ptr<const GekkoFyre::GkAudioClip> clip, const float &gain = 1.0f, const bool &loop = false);
+    quint64 playClip(const QFileInfo &file_path, const float &gain = 1.0f, const bool &loop = false);
+    quint64 playFile(const QFileInfo &file_path, const float &gain = 1.0f);
+    quint64 playStream(std::shared_ptr<GekkoFyre::GkAudioStream> stream, const float &gain = 1.0f);
+
+public slots:
+    void stopVoice(const quint64 &voice_id);
+    void setVoiceGain(const quint64 &voice_id, const float &gain);
+    void setMasterGain(const float &gain);
+    void stopAll();
+
+signals:
+    void voiceFinished(const quint64 &voice_id);
+
+private slots:
+    void collectFinishedVoices();
+
+private:
+    QPointer<GekkoFyre::GkEventLogger> gkEventLogger;
+    GekkoFyre::Database::Settings::Audio::GkDevice gkOutputDevice;
+
+    struct GkMixerVoice {
+        quint64 id = 0;
+        std::shared_ptr<const GekkoFyre::GkAudioClip> clip;                     // Set if playing back a decoded clip.
+        std::shared_ptr<GekkoFyre::GkMmapAudioFile> mapped;                     // Set if streaming straight from a memory-mapped file.
+        std::shared_ptr<GekkoFyre::GkAudioStream> stream;                       // Set if playing live audio, such as from the SDR.
+        qint64 pos = 0;                                                         // The next frame to be mixed.
+        qint64 adviseEnd = 0;                                                   // Once reached, the next window of a memory-mapped file is advised.
+        float gain = 1.0f;
+        bool loop = false;
+        bool active = false;
+    };
+
+    enum GkMixerCmdType {
+        AddVoice,
+        RemoveVoice,
+        SetVoiceGain,
+        SetMasterGain,
+        RemoveAllVoices
+    };
+
+    struct GkMixerCmd {
+        GkMixerCmdType type = RemoveAllVoices;
+        GkMixerVoice voice;
+        quint64 voice_id = 0;
+        float gain = 1.0f;
+    };
+
+    //
+    // Multithreading
+    std::thread mixerThread;
+    std::atomic<bool> m_running;
+    std::atomic<quint64> m_nextVoiceId;
+    std::atomic<quint64> m_underruns;
+    GkLockFreeQueue<GkMixerCmd> m_cmdQueue;                                      // Control thread(s) --> mixer thread
+    GkLockFreeQueue<GkMixerVoice> m_retireQueue;                                 // Mixer thread --> control thread
+    QPointer<QTimer> m_retireTimer;
+
+    //
+    // The following are only ever touched by the mixer thread, once started
+    std::array<GkMixerVoice, GK_AUDIO_MIXER_MAX_VOICES> m_voices;
+    std::vector<float> m_mixBuf;
+    std::vector<float> m_srcBuf;
+    std::vector<ALshort> m_outBuf;
+    float m_masterGain;
+    float m_limiterGain;
+    float m_limiterRelease;
+    quint32 m_sampleRate;
+
+    //
+    // Guards the process-wide OpenAL context, should the mixer have to fall back upon it for want of
+    // ALC_EXT_thread_local_context
+    std::mutex m_alContextMtx;
+
+    //
+    // Decoded clips, which are only ever touched by the control thread(s)
+    std::mutex m_clipCacheMtx;
+    QHash<QString, std::shared_ptr<const GekkoFyre::GkAudioClip>> m_clipCache;
+
+    void run();
+    void processCommands();
+    void mixBlock();
+    void mixVoice(GkMixerVoice &voice, const qint64 &frames);
+    void retireVoice(GkMixerVoice &voice);
+    quint64 submitVoice(GkMixerVoice &&voice);
+    void submitCmd(GkMixerCmd &&cmd);
+
+    [[nodiscard]] std::shared_ptr<GekkoFyre::GkAudioClip> decodeClip(const QFileInfo &file_path) const;
+
+};
+};
@@ -0,0 +1,331 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/gk_channel_sim.hpp"
+#include <cmath>
+#include <algorithm>
+#include <QObject>
+
+using namespace GekkoFyre;
+
+/**
+ * @brief GkChannelSimulator::GkChannelSimulator
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sample_rate The sample rate of the modem audio.
+ * @param seed The seed of the noise and fading, so that any run may be repeated exactly.
+ */
+GkChannelSimulator::GkChannelSimulator(const quint32 &sample_rate, const quint32 &seed)
+    : m_sampleRate(sample_rate), m_rng(seed), m_gauss(0.0f, 1.0f), m_noiseStd(0.0f), m_pos(0), m_analytic(false), m_delaySamples(0),
+      m_delayPos(0), m_sinceRenorm(0), m_offsetPhasor(1.0, 0.0), m_offsetRotation(1.0, 0.0), m_driftStep(1.0), m_driftPos(0.0),
+      m_driftHist()
+{
+    //
+    // A windowed ideal Hilbert transformer, whose taps are zero for every even distance from the centre
+    const qint32 num_taps = GK_CHANNEL_SIM_HILBERT_TAPS;
+    const qint32 centre = num_taps / 2;
+    m_hilbert.assign(num_taps, 0.0f);
+    for (qint32 i = 0; i < num_taps; ++i) {
+        const qint32 m = i - centre;
+        if ((m & 1) != 0) {
+            const double window = 0.42 - 0.5 * std::cos((2.0 * M_PI * i) / (num_taps - 1)) + 0.08 * std::cos((4.0 * M_PI * i) / (num_taps - 1));
+            m_hilbert[num_taps - 1 - i] = static_cast<float>((2.0 / (M_PI * m)) * window);
+        }
+    }
+
+    m_hist.assign(2 * static_cast<size_t>(num_taps), 0.0f);
+    m_driftHist.fill(0.0f);
+    setProfile({ QString(), 0.0, 0.0 });
+
+    return;
+}
+
+/**
+ * @brief GkChannelSimulator::setNoise
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param snr_db The SNR within `noise_bw_hz`, in dB.
+ * @param signal_rms The RMS of the modem audio whilst it is transmitting, as found with GkChannelSimulator::measureRms().
+ * @param noise_bw_hz The bandwidth within which the SNR is given, such as 3 kHz for most modems or 2500 Hz for FT8.
+ */
+void GkChannelSimulator::setNoise(const double &snr_db, const double &signal_rms, const double &noise_bw_hz)
+{
+    //
+    // The noise is spread across the whole of the audio's bandwidth (i.e. half the sample rate), only some of which
+    // falls within the bandwidth that the SNR is given for
+    const double noise_power = (signal_rms * signal_rms) * ((m_sampleRate / 2.0) / noise_bw_hz) / std::pow(10.0, snr_db / 10.0);
+    m_noiseStd = static_cast<float>(std::sqrt(noise_power));
+
+    return;
+}
+
+/**
+ * @brief GkChannelSimulator::setFading fades a single path.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param doppler_spread_hz The Doppler spread (i.e. twice the standard deviation of the Doppler), or zero for no fading.
+ */
+void GkChannelSimulator::setFading(const double &doppler_spread_hz)
+{
+    setProfile({ QString(), doppler_spread_hz, 0.0 });
+
+    return;
+}
+
+/**
+ * @brief GkChannelSimulator::setProfile readies the paths of the channel, being two of equal strength (as with the CCIR
+ * channels) should there be any delay between them.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param profile The Doppler spread and delay of the channel.
+ */
+void GkChannelSimulator::setProfile(const GkChannelProfile &profile)
+{
+    const bool faded = (profile.doppler_spread_hz > 0.0);
+    const size_t num_paths = (profile.delay_ms > 0.0) ? 2 : 1;
+    const size_t num_phasors = faded ? GK_CHANNEL_SIM_FADING_PATHS : 1;
+    std::normal_distribution<double> doppler(0.0, profile.doppler_spread_hz / 2.0);
+    std::uniform_real_distribution<double> phase(0.0, 2.0 * M_PI);
+
+    m_paths.assign(num_paths, GkFadingPath());
+    for (auto &path: m_paths) {
+        path.amplitude = 1.0 / std::sqrt(static_cast<double>(num_phasors * num_paths));
+        path.phasors.assign(num_phasors, std::complex<double>(path.amplitude, 0.0));
+        path.rotations.assign(num_phasors, std::complex<double>(1.0, 0.0));
+        if (faded) {
+            for (size_t i = 0; i < num_phasors; ++i) {
+                path.phasors[i] = std::polar(path.amplitude, phase(m_rng));
+                path.rotations[i] = std::polar(1.0, (2.0 * M_PI * doppler(m_rng)) / m_sampleRate);
+            }
+        }
+    }
+
+    m_delaySamples = static_cast<size_t>(std::lround((profile.delay_ms / 1000.0) * m_sampleRate));
+    m_delayLine.assign(m_delaySamples + 1, std::complex<float>(0.0f, 0.0f));
+    m_delayPos = 0;
+    m_sinceRenorm = 0;
+    m_analytic = faded || (num_paths > 1) || (m_offsetRotation != std::complex<double>(1.0, 0.0));
+
+    return;
+}
+
+/**
+ * @brief GkChannelSimulator::setFrequencyOffset
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param offset_hz How far the audio is shifted in frequency, as with a mistuned receiver.
+ */
+void GkChannelSimulator::setFrequencyOffset(const double &offset_hz)
+{
+    m_offsetPhasor = std::complex<double>(1.0, 0.0);
+    m_offsetRotation = std::polar(1.0, (2.0 * M_PI * offset_hz) / m_sampleRate);
+    m_analytic = m_analytic || (offset_hz != 0.0);
+
+    return;
+}
+
+/**
+ * @brief GkChannelSimulator::setClockDrift
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param drift_ppm How much faster (or, if negative, slower) the receiving sound-card's clock runs than that of the
+ * transmitting one, in parts per million.
+ */
+void GkChannelSimulator::setClockDrift(const double &drift_ppm)
+{
+    m_driftStep = 1.0 / (1.0 + (drift_ppm * 1e-6));
+    m_driftPos = 0.0;
+    m_driftHist.fill(0.0f);
+
+    return;
+}
+
+/**
+ * @brief GkChannelSimulator::process
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param in The modem audio, as transmitted.
+ * @param count The number of samples within `in`.
+ * @param out Where the modem audio is written, as received, which must have room for GkChannelSimulator::maxOutput().
+ * @return The number of samples written towards `out`, which only differs from `count` with clock drift.
+ */
+size_t GkChannelSimulator::process(const qint16 *in, const size_t &count, qint16 *out)
+{
+    const auto toSample = [](const float &value) {
+        return static_cast<qint16>(std::lrint(std::max(-32768.0f, std::min(32767.0f, value))));
+    };
+
+    if (m_driftStep == 1.0) {
+        for (size_t n = 0; n < count; ++n) {
+            out[n] = toSample(channelSample(static_cast<float>(in[n])));
+        }
+
+        return count;
+    }
+
+    //
+    // Catmull-Rom interpolation between the middle two of the last four samples
+    size_t written = 0;
+    for (size_t n = 0; n < count; ++n) {
+        m_driftHist[0] = m_driftHist[1];
+        m_driftHist[1] = m_driftHist[2];
+        m_driftHist[2] = m_driftHist[3];
+        m_driftHist[3] = static_cast<float>(in[n]);
+        while (m_driftPos < 1.0) {
+            const auto mu = static_cast<float>(m_driftPos);
+            const float p0 = m_driftHist[0];
+            const float p1 = m_driftHist[1];
+            const float p2 = m_driftHist[2];
+            const float p3 = m_driftHist[3];
+            const float value = p1 + 0.5f * mu * ((p2 - p0) + mu * ((2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) + mu * (3.0f * (p1 - p2) + p3 - p0)));
+            out[written++] = toSample(channelSample(value));
+            m_driftPos += m_driftStep;
+        }
+
+        m_driftPos -= 1.0;
+    }
+
+    return written;
+}
+
+/**
+ * @brief GkChannelSimulator::maxOutput
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param count A number of samples of input.
+ * @return The most samples that GkChannelSimulator::process() may write for that many samples of input.
+ */
+size_t GkChannelSimulator::maxOutput(const size_t &count) const
+{
+    return static_cast<size_t>(std::ceil(count / std::min(1.0, m_driftStep))) + 2;
+}
+
+/**
+ * @brief GkChannelSimulator::measureRms
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param samples Some audio.
+ * @param count The number of samples.
+ * @return The RMS of the audio.
+ */
+double GkChannelSimulator::measureRms(const qint16 *samples, const size_t &count)
+{
+    if (count == 0) {
+        return 0.0;
+    }
+
+    double sum = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += static_cast<double>(samples[i]) * samples[i];
+    }
+
+    return std::sqrt(sum / count);
+}
+
+/**
+ * @brief GkChannelSimulator::profiles
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return A channel of white noise alone, followed by the 'good', 'moderate' and 'poor' channels of CCIR Rec. 520.
+ */
+const std::vector<GkChannelSimulator::GkChannelProfile> &GkChannelSimulator::profiles()
+{
+    static const std::vector<GkChannelProfile> profiles = {
+        { QObject::tr("AWGN"), 0.0, 0.0 },
+        { QObject::tr("CCIR Good"), 0.1, 0.5 },
+        { QObject::tr("CCIR Moderate"), 0.5, 1.0 },
+        { QObject::tr("CCIR Poor"), 1.0, 2.0 }
+    };
+
+    return profiles;
+}
+
+/**
+ * @brief GkChannelSimulator::channelSample passes a single sample through the paths, the frequency offset and the noise.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param x A sample of the modem audio, as transmitted (and resampled, should there be any clock drift).
+ * @return The sample, as received.
+ */
+float GkChannelSimulator::channelSample(const float &x)
+{
+    if (!m_analytic) {
+        //
+        // White noise alone has no need of the Hilbert transformer, nor of its delay
+        return x + (m_noiseStd * m_gauss(m_rng));
+    }
+
+    const size_t num_taps = m_hilbert.size();
+    m_pos = (m_pos + 1) % num_taps;
+    m_hist[m_pos] = x;
+    m_hist[m_pos + num_taps] = x;
+
+    //
+    // The oldest sample lies just after the newest, with the real part being delayed by as much as the transformer
+    const float *window = &m_hist[m_pos + 1];
+    float imag = 0.0f;
+    for (size_t k = 0; k < num_taps; ++k) {
+        imag += m_hilbert[k] * window[k];
+    }
+
+    const std::complex<float> analytic(window[num_taps / 2], imag);
+    m_delayPos = (m_delayPos + 1) % m_delayLine.size();
+    m_delayLine[m_delayPos] = analytic;
+
+    std::complex<double> received(0.0, 0.0);
+    for (size_t p = 0; p < m_paths.size(); ++p) {
+        std::complex<double> gain(0.0, 0.0);
+        for (size_t i = 0; i < m_paths[p].phasors.size(); ++i) {
+            gain += m_paths[p].phasors[i];
+            m_paths[p].phasors[i] *= m_paths[p].rotations[i];
+        }
+
+        const std::complex<float> &input = (p == 0) ? analytic : m_delayLine[(m_delayPos + 1) % m_delayLine.size()];
+        received += std::complex<double>(input.real(), input.imag()) * gain;
+    }
+
+    received *= m_offsetPhasor;
+    m_offsetPhasor *= m_offsetRotation;
+
+    if (++m_sinceRenorm >= m_sampleRate) {
+        //
+        // Keeps the rounding errors of the rotations from slowly growing or shrinking the fades
+        for (auto &path: m_paths) {
+            for (auto &phasor: path.phasors) {
+                phasor *= path.amplitude / std::abs(phasor);
+            }
+        }
+
+        m_offsetPhasor /= std::abs(m_offsetPhasor);
+        m_sinceRenorm = 0;
+    }
+
+    return static_cast<float>(received.real()) + (m_noiseStd * m_gauss(m_rng));
+}
@@ -0,0 +1,117 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include <array>
+#include <random>
+#include <vector>
+#include <complex>
+#include <QString>
+#include <QtGlobal>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkChannelSimulator passes modem audio through a simulated HF channel, so that modems may be measured offline
+ * without a radio. The audio is made analytic with a Hilbert transformer and then follows the Watterson model: one or
+ * two paths, each faded by a sum of sinusoids whose Doppler is Gaussian distributed. The result may be shifted in
+ * frequency, resampled as though the far end's sound-card clock were off by some parts per million, and then has white
+ * Gaussian noise added towards the given SNR.
+ */
+class GkChannelSimulator {
+
+public:
+    struct GkChannelProfile {
+        QString name;
+        double doppler_spread_hz;                                               // Zero for no fading.
+        double delay_ms;                                                        // The delay of the second path, or zero for a single path.
+    };
+
+    explicit GkChannelSimulator(const quint32 &sample_rate, const quint32 &seed = 1);
+
+    void setNoise(const double &snr_db, const double &signal_rms, const double &noise_bw_hz = GK_CHANNEL_SIM_NOISE_BW_HZ);
+    void setFading(const double &doppler_spread_hz);
+    void setProfile(const GkChannelProfile &profile);
+    void setFrequencyOffset(const double &offset_hz);
+    void setClockDrift(const double &drift_ppm);
+
+    size_t process(const qint16 *in, const size_t &count, qint16 *out);
+    [[nodiscard]] size_t maxOutput(const size_t &count) const;
+
+    [[nodiscard]] static double measureRms(const qint16 *samples, const size_t &count);
+    [[nodiscard]] static const std::vector<GkChannelProfile> &profiles();
+
+private:
+    struct GkFadingPath {
+        std::vector<std::complex<double>> phasors;
+        std::vector<std::complex<double>> rotations;
+        double amplitude;                                                       // Of each phasor, which the rounding errors of the rotations are kept to.
+    };
+
+    quint32 m_sampleRate;
+    std::mt19937 m_rng;
+    std::normal_distribution<float> m_gauss;
+    float m_noiseStd;
+
+    std::vector<float> m_hilbert;                                               // Stored in reverse, so as to line up with the history.
+    std::vector<float> m_hist;                                                  // Held twice over, so that the taps always see it contiguously.
+    size_t m_pos;
+
+    bool m_analytic;                                                            // Whether anything is done that needs the analytic signal.
+    std::vector<GkFadingPath> m_paths;
+    std::vector<std::complex<float>> m_delayLine;                               // The analytic signal, for the second path.
+    size_t m_delaySamples;
+    size_t m_delayPos;
+    quint32 m_sinceRenorm;
+
+    std::complex<double> m_offsetPhasor;
+    std::complex<double> m_offsetRotation;
+
+    double m_driftStep;                                                         // Input samples for each output sample.
+    double m_driftPos;
+    std::array<float, 4> m_driftHist;
+
+    [[nodiscard]] float channelSample(const float &x);
+
+};
+};
@@ -40,8 +40,13 @@
  ****************************************************************************************************/
 
 #include "src/gk_cli.hpp"
+#include "src/gk_demodulators.hpp"
+#include "src/gk_ftx_decoder.hpp"
+#include "src/gk_data_link.hpp"
+#include "src/gk_modem_bench.hpp"
 #include <boost/exception/all.hpp>
 #include <vector>
+#include <iomanip>
 #include <iostream>
 #include <ostream>
 #include <QMessageBox>
@@ -83,6 +88,38 @@ CommandLineParseResult GkCli::parseCommandLine(QString *error_msg)
 
         const QCommandLineOption helpOption = gkCliParser->addHelpOption();
         const QCommandLineOption versionOption = gkCliParser->addVersionOption();
+        const QCommandLineOption benchDemodsOption(QStringList() << "benchmark-demods",
+                                                   tr("Measure the throughput of each SDR demodulator upon a single core, and then exit."));
+        gkCliParser->addOption(benchDemodsOption);
+        const QCommandLineOption benchFtxOption(QStringList() << "benchmark-ftx",
+                                                tr("Measure how long a slot of FT8 crowded with signals takes to decode, upon one core and upon all of them, and then exit."));
+        gkCliParser->addOption(benchFtxOption);
+        #ifdef CODEC2_LIBS_ENBLD
+        const QCommandLineOption benchDataLinkOption(QStringList() << "benchmark-data-link",
+                                                     tr("Measure the goodput of the data link over FreeDV 700D against SNR, through a simulated channel both with and without fading, and then exit."));
+        gkCliParser->addOption(benchDataLinkOption);
+        #endif
+        const QCommandLineOption benchModemsOption(QStringList() << "benchmark-modems",
+                                                   tr("Measure the BER, PER, goodput and CPU time of each modem against SNR, through each of the simulated HF channels, write them towards a CSV file and then exit."), tr("file"));
+        gkCliParser->addOption(benchModemsOption);
+        const QCommandLineOption channelFreqOffsetOption(QStringList() << "channel-freq-offset",
+                                                         tr("The frequency offset of the simulated HF channel, in Hz, whilst benchmarking the modems."), tr("hz"), QStringLiteral("0"));
+        gkCliParser->addOption(channelFreqOffsetOption);
+        const QCommandLineOption channelClockDriftOption(QStringList() << "channel-clock-drift",
+                                                         tr("The drift between the sound-card clocks of the simulated HF channel, in parts per million, whilst benchmarking the modems."), tr("ppm"), QStringLiteral("0"));
+        gkCliParser->addOption(channelClockDriftOption);
+        const QCommandLineOption ftxLdpcOption(QStringList() << "ftx-ldpc-table",
+                                               tr("A table of parity checks to use for the LDPC code of FT8 & FT4, in place of the one bundled with the application."), tr("file"));
+        gkCliParser->addOption(ftxLdpcOption);
+        const QCommandLineOption sigmfReplayOption(QStringList() << "sigmf-replay",
+                                                   tr("Replay a SigMF recording of IQ in place of an SDR device."), tr("file"));
+        gkCliParser->addOption(sigmfReplayOption);
+        const QCommandLineOption sigmfReplayFastOption(QStringList() << "sigmf-replay-fast",
+                                                       tr("Replay the SigMF recording as fast as it can be processed, rather than in real-time."));
+        gkCliParser->addOption(sigmfReplayFastOption);
+        const QCommandLineOption sigmfRecordOption(QStringList() << "sigmf-record",
+                                                   tr("Record the IQ of the SDR stream towards a SigMF recording, once streaming begins."), tr("file"));
+        gkCliParser->addOption(sigmfRecordOption);
 
         gkCliParser->setApplicationDescription(tr("%1 is a 'new age' weak-signal digital communicator "
                                                   "powered by low bit rate, digital voice codecs originally meant for "
@@ -102,6 +139,67 @@ CommandLineParseResult GkCli::parseCommandLine(QString *error_msg)
             return CommandLineHelpRequested;
         }
 
+        if (gkCliParser->isSet(benchDemodsOption)) {
+            //
+            // Every demodulator is given the same synthetic IQ to work through, upon this one thread...
+            std::cout << tr("Benchmarking the SDR demodulators with %1 samples each...").arg(QString::number(GK_DEMOD_BENCH_SAMPLES)).toStdString() << std::endl;
+            for (const auto &result: GkDemodBenchmark::run()) {
+                std::cout << std::left << std::setw(6) << result.name.toStdString() << std::right << std::fixed << std::setprecision(1)
+                          << std::setw(10) << result.msamples_per_sec << " " << tr("Msamples/s per core").toStdString() << std::endl;
+            }
+
+            return CommandLineBenchmarkRequested;
+        }
+
+        if (gkCliParser->isSet(benchFtxOption)) {
+            std::cout << tr("Benchmarking the decoding of a slot of FT8 with %1 signals...").arg(QString::number(GK_FTX_BENCH_SIGNALS)).toStdString() << std::endl;
+            for (const auto &result: GkFtxBenchmark::run()) {
+                std::cout << std::right << std::setw(3) << result.threads << " " << tr("thread(s):").toStdString() << std::fixed << std::setprecision(1)
+                          << std::setw(9) << result.millisecs << " ms, " << result.decoded << "/" << result.num_signals << " "
+                          << tr("decoded from %1 candidates").arg(QString::number(result.candidates)).toStdString() << std::endl;
+            }
+
+            return CommandLineBenchmarkRequested;
+        }
+
+        #ifdef CODEC2_LIBS_ENBLD
+        if (gkCliParser->isSet(benchDataLinkOption)) {
+            std::cout << tr("Benchmarking the data link over FreeDV 700D with a message of %1 bytes...").arg(QString::number(GK_DATA_LINK_BENCH_BYTES)).toStdString() << std::endl;
+            for (const auto &result: GkDataLinkBenchmark::run(Codec2Mode::freeDvMode700D)) {
+                std::cout << std::right << std::fixed << std::setprecision(1) << std::setw(6) << result.snr_db << " dB, " << tr("fading").toStdString()
+                          << std::setw(4) << result.fading_hz << " Hz:" << std::setw(8) << result.goodput_bps << " " << tr("bit/s").toStdString() << ", "
+                          << result.bursts << " " << tr("burst(s)").toStdString() << ", " << result.blocks_failed << "/" << result.blocks_sent << " "
+                          << tr("block(s) lost").toStdString() << (result.delivered ? "" : tr(", undelivered").toStdString()) << std::endl;
+            }
+
+            return CommandLineBenchmarkRequested;
+        }
+        #endif
+
+        if (gkCliParser->isSet(benchModemsOption)) {
+            bool freq_offset_ok = false;
+            bool clock_drift_ok = false;
+            const double freq_offset_hz = gkCliParser->value(channelFreqOffsetOption).toDouble(&freq_offset_ok);
+            const double clock_drift_ppm = gkCliParser->value(channelClockDriftOption).toDouble(&clock_drift_ok);
+            if (!freq_offset_ok || !clock_drift_ok) {
+                *error_msg = tr("The frequency offset and clock drift of the simulated HF channel must both be numbers.");
+                return CommandLineError;
+            }
+
+            std::cout << tr("Benchmarking the modems through the simulated HF channels, with a frequency offset of %1 Hz and a clock drift of %2 ppm...")
+                         .arg(QString::number(freq_offset_hz), QString::number(clock_drift_ppm)).toStdString() << std::endl;
+            const auto results = GkModemBenchmark::run(freq_offset_hz, clock_drift_ppm);
+            for (const auto &result: results) {
+                std::cout << std::left << std::setw(12) << result.mode.toStdString() << std::setw(14) << result.channel.toStdString() << std::right
+                          << std::fixed << std::setprecision(1) << std::setw(6) << result.snr_db << " dB: " << std::setprecision(3) << "PER "
+                          << result.per << ", " << std::setprecision(1) << std::setw(7) << result.goodput_bps << " " << tr("bit/s").toStdString()
+                          << ", " << std::setprecision(3) << result.cpu_ms_per_frame << " " << tr("ms/frame").toStdString() << std::endl;
+            }
+
+            GkModemBenchmark::writeCsv(gkCliParser->value(benchModemsOption), results);
+            return CommandLineBenchmarkRequested;
+        }
+
         const QStringList pos_args = gkCliParser->positionalArguments();
         if (pos_args.isEmpty()) {
             *error_msg = tr("Argument 'name' missing.");
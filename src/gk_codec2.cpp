@@ -42,11 +42,10 @@
 #include "src/gk_codec2.hpp"
 #include <codec2/freedv_api.h>
 #include <snappy.h>
-#include <QDataStream>
 #include <algorithm>
 #include <utility>
-#include <sstream>
-#include <cstring>
+#include <chrono>
+#include <cmath>
 
 using namespace GekkoFyre;
 using namespace Database;
@@ -59,12 +58,28 @@ using namespace System;
 using namespace Events;
 using namespace Logging;
 
+/**
+ * @brief GkCodec2::GkCodec2 opens the FreeDV modem once for transmission and once for reception, both of which are kept
+ * open for as long as this class lives.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param freedv_mode The mode of FreeDV to be used.
+ * @param custom_mode Any processing of the data prior to transmission that is specific to Small World Deluxe.
+ * @param freedv_clip Whether to clip the modulated signal, for a lower peak-to-average power ratio.
+ * @param freedv_txbpf Whether to filter the modulated signal (OFDM modes only).
+ * @param levelDb The database class.
+ * @param eventLogger The event logging class.
+ * @param stringFuncs The string functions class.
+ * @param parent The parent object to this class.
+ */
 GkCodec2::GkCodec2(const Codec2Mode &freedv_mode, const Codec2ModeCustom &custom_mode, const int &freedv_clip,
                    const int &freedv_txbpf, QPointer<GkLevelDb> levelDb, QPointer<GkEventLogger> eventLogger,
                    QPointer<GekkoFyre::StringFuncs> stringFuncs, QObject *parent)
+    : QObject(parent), m_freedvTx(nullptr, freedv_close), m_freedvRx(nullptr, freedv_close), m_modemRate(0), m_packedBytes(0),
+      m_bytesPerFrame(0), m_samplesPerFrame(0), m_maxRxSamples(0), m_txPaddingBytes(0), m_rxChannels(1), m_rxMaxFrames(0), m_rxConfigured(false),
+      m_rxRingMask(0), m_rxWritten(0), m_rxRead(0), m_rxOverruns(0), m_rxPending(0), m_rxSync(false), m_rxSnr(0.0f),
+      m_running(false)
 {
     try {
-        setParent(parent);
         gkDb = std::move(levelDb);
         gkEventLogger = std::move(eventLogger);
         gkStringFuncs = std::move(stringFuncs);
@@ -74,10 +89,71 @@ GkCodec2::GkCodec2(const Codec2Mode &freedv_mode, const Codec2ModeCustom &custom
         gkFreeDvClip = freedv_clip;
         gkFreeDvTXBpf = freedv_txbpf;
 
-        return;
-    }  catch (const std::exception &e) {
-        std::throw_with_nested(tr("Error with initializing Codec2 library! Error:\n\n%1")
-                               .arg(QString::fromStdString(e.what())).toStdString());
+        const int mode = convertFreeDvModeToInt(gkFreeDvMode);
+        if (mode < 0) {
+            throw std::invalid_argument(tr("The chosen mode of FreeDV is not supported!").toStdString());
+        }
+
+        m_freedvTx.reset(freedv_open(mode));
+        m_freedvRx.reset(freedv_open(mode));
+        if (!m_freedvTx || !m_freedvRx) {
+            throw std::runtime_error(tr("Issue encountered with opening Codec2 modem! Are you out of memory?").toStdString());
+        }
+
+        freedv_set_clip(m_freedvTx.get(), gkFreeDvClip);
+        freedv_set_tx_bpf(m_freedvTx.get(), gkFreeDvTXBpf);
+        freedv_set_ext_vco(m_freedvTx.get(), 0);
+
+        #ifdef GFYRE_SWORLD_DBG_VERBOSITY
+        freedv_set_verbose(m_freedvTx.get(), 1);
+        freedv_set_verbose(m_freedvRx.get(), 1);
+        #else
+        freedv_set_verbose(m_freedvTx.get(), 0);
+        freedv_set_verbose(m_freedvRx.get(), 0);
+        #endif
+
+        //
+        // For streaming bytes it is much easier to use modes that have a multiple of 8 payload bits/frame, but any
+        // bits left over beyond the last whole byte are merely left as zero...
+        const int bits_per_modem_frame = freedv_get_bits_per_modem_frame(m_freedvTx.get());
+        m_packedBytes = static_cast<size_t>((bits_per_modem_frame + 7) / 8);
+        m_bytesPerFrame = static_cast<size_t>(bits_per_modem_frame / 8);
+        m_samplesPerFrame = static_cast<size_t>(freedv_get_n_nom_modem_samples(m_freedvTx.get()));
+        m_maxRxSamples = static_cast<size_t>(freedv_get_n_max_modem_samples(m_freedvRx.get()));
+        m_modemRate = static_cast<quint32>(freedv_get_modem_sample_rate(m_freedvRx.get()));
+        if (m_bytesPerFrame == 0 || m_samplesPerFrame == 0 || m_maxRxSamples == 0 || m_modemRate == 0) {
+            throw std::runtime_error(tr("The chosen mode of FreeDV does not carry any raw data!").toStdString());
+        }
+
+        m_txPacked.assign(m_packedBytes, 0);
+        m_txPaddingBytes = GK_CODEC2_TX_PADDING_FRAMES * m_bytesPerFrame;
+        m_txBurst.assign((GK_DATA_LINK_ARQ_WINDOW * GkDataLink::getBlockBytes()) + (2 * m_txPaddingBytes), 0);
+        m_rxPacked.assign(m_packedBytes, 0);
+        m_rxDemodIn.assign(m_maxRxSamples, 0);
+        m_rxScratch.assign(m_maxRxSamples, 0);
+
+        size_t ring_size = 1;
+        while (ring_size < static_cast<size_t>(GK_CODEC2_RX_RING_SECS) * m_modemRate) {
+            ring_size <<= 1;
+        }
+
+        m_rxRing.assign(ring_size, 0);
+        m_rxRingMask = ring_size - 1;
+
+        //
+        // Each modem frame that is received goes towards the data link, and each message that arrives in whole goes
+        // towards whomever is listening
+        m_rxCallback = [this](const quint8 *payload, const size_t &bytes) { m_dataLink.receive(payload, bytes); };
+        m_dataLink.setMessageCallback([this](const QByteArray &message) { messageReceived(message); });
+
+        if (gkEventLogger) {
+            gkEventLogger->publishEvent(tr("Bits per modem frame: %1. Samples per modem frame: %2.")
+                                        .arg(QString::number(bits_per_modem_frame), QString::number(m_samplesPerFrame)),
+                                        GkSeverity::Debug, "", false, true, false, false, false);
+        }
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(tr("Error with initializing Codec2 library! Error:\n\n%1")
+                                                  .arg(QString::fromStdString(e.what())).toStdString()));
     }
 
     return;
@@ -85,133 +161,458 @@ GkCodec2::GkCodec2(const Codec2Mode &freedv_mode, const Codec2ModeCustom &custom
 
 GkCodec2::~GkCodec2()
 {
-    return;
+    stop();
 }
 
 /**
- * @brief GkCodec2::transmitData prepares a waveform that is readily transmissible over-the-air with another function that can do
- * just that.
+ * @brief GkCodec2::modulateFrame modulates a single frame of payload.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param byte_array The data that is to be prepped for transmission.
- * @param play_output_sound Whether to play the modulating signal over the user's output audio device or not.
- * @return The prepped data for transmission.
+ * @param payload Exactly GkCodec2::getBytesPerFrame() bytes of data.
+ * @param mod_out Where the modem audio is written, which must have room for GkCodec2::getSamplesPerFrame() samples.
+ * @return The number of samples written towards `mod_out`.
+ */
+size_t GkCodec2::modulateFrame(const quint8 *payload, qint16 *mod_out)
+{
+    return modulate(payload, m_bytesPerFrame, mod_out, m_samplesPerFrame);
+}
+
+/**
+ * @brief GkCodec2::modulate streams the given data through the modem, one frame at a time, with the final frame being
+ * padded out with zeroes. Nothing is allocated, as the modem audio is written straight towards the caller's buffer.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param data The data to be modulated.
+ * @param count The number of bytes within `data`.
+ * @param mod_out Where the modem audio is written, which ought to have room for GkCodec2::getSamplesForBytes() samples.
+ * @param max_samples The room within `mod_out`, with any frames that would not fit being left out.
+ * @return The number of samples written towards `mod_out`.
  * @note <https://github.com/drowe67/codec2/blob/master/README_data.md>
  * <https://github.com/drowe67/codec2/blob/master/unittest/tfreedv_2400B_rawdata.c>
- * <https://cpp.hotexamples.com/examples/-/-/codec2_encode/cpp-codec2_encode-function-examples.html>
  */
-int GkCodec2::transmitData(const QByteArray &byte_array, const bool &play_output_sound, const bool &squelch_enable, const float &squelch_thresh)
+size_t GkCodec2::modulate(const quint8 *data, const size_t &count, qint16 *mod_out, const size_t &max_samples)
+{
+    size_t written = 0;
+    for (size_t offset = 0; offset < count; offset += m_bytesPerFrame) {
+        if ((written + m_samplesPerFrame) > max_samples) {
+            break;
+        }
+
+        const size_t take = std::min(m_bytesPerFrame, count - offset);
+        std::fill(m_txPacked.begin(), m_txPacked.end(), 0);
+        std::copy(data + offset, data + offset + take, m_txPacked.begin());
+        freedv_rawdatatx(m_freedvTx.get(), mod_out + written, m_txPacked.data());
+        written += m_samplesPerFrame;
+    }
+
+    return written;
+}
+
+/**
+ * @brief GkCodec2::transmitData prepares a waveform that is readily transmissible over-the-air with another function that can do
+ * just that. The data goes out over as many bursts as it takes for the far end to acknowledge all of it, with only the
+ * first being prepared here and each thereafter by GkCodec2::transmitBurst().
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param byte_array The data that is to be prepped for transmission.
+ * @return The number of samples of modem audio, as available from GkCodec2::getTxAudio().
+ */
+int GkCodec2::transmitData(const QByteArray &byte_array)
 {
     try {
-        auto txData = createPayloadForTx(byte_array);
-        if (!txData.isEmpty()) {
-            struct CODEC2 *c2;
-            struct freedv *freedv;
-            c2 = codec2_create(convertFreeDvModeToInt(gkFreeDvMode));
-            freedv = freedv_open(convertFreeDvModeToInt(gkFreeDvMode));
-
-            if (c2 == nullptr || freedv == nullptr) {
-                throw std::runtime_error(tr("Issue encountered with opening Codec2 modem for transmission! Are you out of memory?").toStdString());
+        if (!m_dataLink.queueMessage(createPayloadForTx(byte_array))) {
+            throw std::runtime_error(tr("The previous transmission has yet to be acknowledged in whole, or there is nothing to send!").toStdString());
+        }
+
+        return transmitBurst();
+    }  catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(tr("An issue has occurred with transmitting data via the Codec2 modem! Error:\n\n%1")
+                                                  .arg(QString::fromStdString(e.what())).toStdString()));
+    }
+
+    return -1;
+}
+
+/**
+ * @brief GkCodec2::transmitBurst prepares the next burst of the data link, being an acknowledgement of whatever has been
+ * received along with any blocks of data that are yet to be acknowledged. This is to be called each time the far end has
+ * had its turn to transmit. The burst is padded either side with empty modem frames, and kept within a buffer that is
+ * reused from one burst towards the next.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The number of samples of modem audio, as available from GkCodec2::getTxAudio(), or zero should there be nothing
+ * to send.
+ */
+int GkCodec2::transmitBurst()
+{
+    const size_t num_blocks = m_dataLink.nextBurst(m_txBurst.data() + m_txPaddingBytes, GK_DATA_LINK_ARQ_WINDOW);
+    if (num_blocks == 0) {
+        m_txAudio.clear();
+        return 0;
+    }
+
+    const size_t blocks_end = m_txPaddingBytes + (num_blocks * GkDataLink::getBlockBytes());
+    const size_t burst_bytes = blocks_end + m_txPaddingBytes;
+    std::fill(m_txBurst.begin(), m_txBurst.begin() + static_cast<std::ptrdiff_t>(m_txPaddingBytes), 0);
+    std::fill(m_txBurst.begin() + static_cast<std::ptrdiff_t>(blocks_end), m_txBurst.begin() + static_cast<std::ptrdiff_t>(burst_bytes), 0);
+
+    m_txAudio.resize(getSamplesForBytes(burst_bytes));
+    const size_t written = modulate(m_txBurst.data(), burst_bytes, m_txAudio.data(), m_txAudio.size());
+
+    return static_cast<int>(written);
+}
+
+/**
+ * @brief GkCodec2::getTxAudio
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The modem audio of the last call towards GkCodec2::transmitData(), at GkCodec2::getModemSampleRate().
+ */
+const std::vector<qint16> &GkCodec2::getTxAudio() const
+{
+    return m_txAudio;
+}
+
+/**
+ * @brief GkCodec2::isSending
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return Whether there is data yet to be acknowledged in whole by the far end.
+ */
+bool GkCodec2::isSending() const
+{
+    return m_dataLink.isSending();
+}
+
+/**
+ * @brief GkCodec2::getDataLinkStats
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The counts of blocks sent and received by the data link thus far.
+ */
+GkDataLink::GkDataLinkStats GkCodec2::getDataLinkStats() const
+{
+    return m_dataLink.getStats();
+}
+
+/**
+ * @brief GkCodec2::configureRx readies the modem for the captured audio, which must be done before the capture thread
+ * begins calling GkCodec2::process() and before GkCodec2::start().
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param input_rate The sample rate of the captured audio.
+ * @param channels The number of interleaved channels within the captured audio.
+ * @param max_frames The most frames that will ever be given at once.
+ */
+void GkCodec2::configureRx(const quint32 &input_rate, const quint16 &channels, const size_t &max_frames)
+{
+    m_rxConfigured = false;
+    m_rxChannels = std::max<quint16>(1, channels);
+    m_rxMaxFrames = std::max<size_t>(1, max_frames);
+    m_rxResampler.configure(input_rate, m_modemRate);
+    m_rxMono.assign(m_rxMaxFrames, 0.0f);
+    m_rxResampled.assign(m_rxResampler.maxOutput(m_rxMaxFrames), 0.0f);
+    m_rxWritten = 0;
+    m_rxRead = 0;
+    m_rxPending = 0;
+    m_rxConfigured = true;
+
+    return;
+}
+
+/**
+ * @brief GkCodec2::setRxCallback sets what is to be done with each frame that is received, in place of handing it towards
+ * the data link, which must be done before GkCodec2::start().
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param callback Called upon the receive thread with the payload of each frame.
+ */
+void GkCodec2::setRxCallback(GkCodec2RxCallback callback)
+{
+    m_rxCallback = std::move(callback);
+
+    return;
+}
+
+/**
+ * @brief GkCodec2::setSquelch
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param squelch_enable Whether frames received below the threshold are to be ignored.
+ * @param squelch_thresh The threshold, as an SNR in dB.
+ */
+void GkCodec2::setSquelch(const bool &squelch_enable, const float &squelch_thresh)
+{
+    freedv_set_snr_squelch_thresh(m_freedvRx.get(), squelch_thresh);
+    freedv_set_squelch_en(m_freedvRx.get(), squelch_enable);
+
+    return;
+}
+
+/**
+ * @brief GkCodec2::process is fed with the captured audio, upon the capture thread, and never allocates. The audio is
+ * mixed down, resampled towards the modem's sample rate and written towards the ring, with whatever does not fit (i.e.
+ * should the receive thread fall behind) being dropped.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param samples The captured audio, as interleaved 16-bit integers.
+ * @param frames The number of frames (i.e. samples per channel) that were captured.
+ */
+void GkCodec2::process(const qint16 *samples, const size_t &frames)
+{
+    if (!m_rxConfigured) {
+        return;
+    }
+
+    size_t offset = 0;
+    const float scale = 1.0f / static_cast<float>(m_rxChannels);
+    while (offset < frames) {
+        const size_t count = std::min(frames - offset, m_rxMaxFrames);
+        const qint16 *in = samples + (offset * m_rxChannels);
+        for (size_t i = 0; i < count; ++i) {
+            qint32 sum = 0;
+            for (quint16 ch = 0; ch < m_rxChannels; ++ch) {
+                sum += in[i * m_rxChannels + ch];
             }
 
-            quint8 header[6] = { 0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc };
-            freedv_set_data_header(freedv, header);
+            m_rxMono[i] = static_cast<float>(sum) * scale;
+        }
 
-            freedv_set_snr_squelch_thresh(freedv, squelch_thresh);
-            freedv_set_squelch_en(freedv, gkDb->boolInt(squelch_enable));
-            freedv_set_clip(freedv, gkFreeDvClip);
-            freedv_set_tx_bpf(freedv, gkFreeDvTXBpf);
-            // freedv_set_dpsk(freedv, gkDb->boolInt(true));
-            freedv_set_ext_vco(freedv, gkDb->boolInt(false));
+        const size_t num_out = m_rxResampler.process(m_rxMono.data(), count, m_rxResampled.data());
+        const quint64 written = m_rxWritten.load(std::memory_order_relaxed);
+        const quint64 read = m_rxRead.load(std::memory_order_acquire);
+        const size_t room = m_rxRing.size() - static_cast<size_t>(written - read);
+        const size_t num_kept = std::min(num_out, room);
+        for (size_t i = 0; i < num_kept; ++i) {
+            const float sample = std::max(-32768.0f, std::min(32767.0f, m_rxResampled[i]));
+            m_rxRing[(written + i) & m_rxRingMask] = static_cast<qint16>(std::lrint(sample));
+        }
 
-            #ifdef GFYRE_SWORLD_DBG_VERBOSITY
-            freedv_set_verbose(freedv, gkDb->boolInt(true));
-            #else
-            freedv_set_verbose(freedv, gkDb->boolInt(false));
-            #endif
+        m_rxWritten.store(written + num_kept, std::memory_order_release);
+        if (num_kept < num_out) {
+            m_rxOverruns += (num_out - num_kept);
+        }
 
-            // For streaming bytes it is much easier to use modes that have a multiple of 8 payload bits/frame...
-            int bytes_per_modem_frame = (freedv_get_bits_per_modem_frame(freedv) / 8);
-            int n_mod_out = freedv_get_n_nom_modem_samples(freedv);
-            short mod_out[n_mod_out];
+        offset += count;
+    }
 
-            gkEventLogger->publishEvent(tr("Bits per modem frame: %1. Samples per modem frame: %2.")
-                                        .arg(QString::number(freedv_get_bits_per_modem_frame(freedv)))
-                                        .arg(QString::number(bytes_per_modem_frame)), GkSeverity::Debug);
-
-            for (const auto &to_tx: txData) {
-                imemstream in(to_tx.data(), (size_t)to_tx.size());
-                for (;;) {
-                    std::string buffer;
-                    if (!std::getline(in, buffer)) { break; }
-                    quint8 *audio_in = reinterpret_cast<quint8 *>(const_cast<char *>(buffer.c_str()));
-
-                    // Stream the data until finish!
-                    freedv_rawdatatx(freedv, mod_out, audio_in);
-
-                    if (play_output_sound) {
-                        std::vector<float> audio_conv(buffer.size());
-                        size_t out_len = std::strlen((char *)mod_out);
-                        std::copy(mod_out, mod_out + out_len, audio_conv.begin());
-                        // outputAudioBuf->append(audio_conv);
-                    }
-                }
+    return;
+}
+
+/**
+ * @brief GkCodec2::demodulate gathers the given modem audio into frames of however many samples FreeDV asks for next
+ * (i.e. `freedv_nin()`), demodulating each in turn. This is what the receive thread does with the captured audio, but it
+ * may just as well be called directly (such as with audio from a file), so long as the receive thread is not running.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param demod_in Modem audio, at GkCodec2::getModemSampleRate().
+ * @param count The number of samples within `demod_in`.
+ * @return The number of frames that were received.
+ */
+size_t GkCodec2::demodulate(const qint16 *demod_in, const size_t &count)
+{
+    size_t frames = 0;
+    size_t offset = 0;
+    while (offset < count) {
+        const auto nin = static_cast<size_t>(freedv_nin(m_freedvRx.get()));
+        const size_t take = std::min(count - offset, nin - std::min(nin, m_rxPending));
+        std::copy(demod_in + offset, demod_in + offset + take, m_rxDemodIn.begin() + static_cast<std::ptrdiff_t>(m_rxPending));
+        m_rxPending += take;
+        offset += take;
+        if (m_rxPending < nin) {
+            break;
+        }
+
+        m_rxPending = 0;
+        const int bytes = freedv_rawdatarx(m_freedvRx.get(), m_rxPacked.data(), m_rxDemodIn.data());
+
+        int sync = 0;
+        float snr_est = 0.0f;
+        freedv_get_modem_stats(m_freedvRx.get(), &sync, &snr_est);
+        m_rxSync = (sync != 0);
+        m_rxSnr = snr_est;
+
+        if (bytes > 0) {
+            ++frames;
+            if (m_rxCallback) {
+                m_rxCallback(m_rxPacked.data(), m_bytesPerFrame);
+            }
+        }
+    }
+
+    return frames;
+}
+
+/**
+ * @brief GkCodec2::getBytesPerFrame
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The whole bytes of payload carried by each modem frame.
+ */
+size_t GkCodec2::getBytesPerFrame() const
+{
+    return m_bytesPerFrame;
+}
+
+/**
+ * @brief GkCodec2::getSamplesPerFrame
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The samples of modem audio produced for each modem frame.
+ */
+size_t GkCodec2::getSamplesPerFrame() const
+{
+    return m_samplesPerFrame;
+}
+
+/**
+ * @brief GkCodec2::getSamplesForBytes
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param count A number of bytes of data.
+ * @return The samples of modem audio that GkCodec2::modulate() produces for that many bytes.
+ */
+size_t GkCodec2::getSamplesForBytes(const size_t &count) const
+{
+    return ((count + m_bytesPerFrame - 1) / m_bytesPerFrame) * m_samplesPerFrame;
+}
+
+/**
+ * @brief GkCodec2::getModemSampleRate
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The sample rate of the modem audio, in both directions.
+ */
+quint32 GkCodec2::getModemSampleRate() const
+{
+    return m_modemRate;
+}
+
+/**
+ * @brief GkCodec2::isSynced
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return Whether the demodulator was in sync as of the last frame.
+ */
+bool GkCodec2::isSynced() const
+{
+    return m_rxSync;
+}
+
+/**
+ * @brief GkCodec2::getSnrEstimate
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The demodulator's estimate of the SNR as of the last frame, in dB.
+ */
+float GkCodec2::getSnrEstimate() const
+{
+    return m_rxSnr;
+}
+
+/**
+ * @brief GkCodec2::start begins demodulating the captured audio as it is written towards the ring.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkCodec2::start()
+{
+    if (m_running) {
+        return;
+    }
+
+    m_running = true;
+    rxThread = std::thread(&GkCodec2::run, this);
+
+    return;
+}
+
+/**
+ * @brief GkCodec2::stop
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkCodec2::stop()
+{
+    m_running = false;
+    if (rxThread.joinable()) {
+        rxThread.join();
+    }
+
+    return;
+}
+
+/**
+ * @brief GkCodec2::run is the receive thread, which drains the ring towards the demodulator.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkCodec2::run()
+{
+    while (m_running) {
+        const quint64 overruns = m_rxOverruns.exchange(0);
+        if (overruns > 0) {
+            if (gkEventLogger) {
+                gkEventLogger->publishEvent(tr("%1 sample(s) of captured audio were dropped, as the FreeDV modem could not keep up!").arg(QString::number(overruns)),
+                                            GkSeverity::Warning, "", false, true, false, false, false);
             }
+        }
 
-            freedv_close(freedv);
+        //
+        // Only wake the demodulator once there is enough for it to make a frame of
+        const quint64 read = m_rxRead.load(std::memory_order_relaxed);
+        const quint64 written = m_rxWritten.load(std::memory_order_acquire);
+        const auto nin = static_cast<size_t>(freedv_nin(m_freedvRx.get()));
+        const size_t wanted = nin - std::min(nin, m_rxPending);
+        const auto avail = static_cast<size_t>(written - read);
+        if (avail < wanted || avail == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(GK_CODEC2_RX_IDLE_MILLISECS));
+            continue;
+        }
+
+        const size_t count = std::min(avail, m_rxScratch.size());
+        for (size_t i = 0; i < count; ++i) {
+            m_rxScratch[i] = m_rxRing[(read + i) & m_rxRingMask];
+        }
+
+        m_rxRead.store(read + count, std::memory_order_release);
+
+        try {
+            demodulate(m_rxScratch.data(), count);
+        } catch (const std::exception &e) {
+            if (gkEventLogger) {
+                gkEventLogger->publishEvent(tr("Unable to demodulate a frame of FreeDV: %1").arg(QString::fromStdString(e.what())),
+                                            GkSeverity::Error, "", false, true, false, false, false);
+            }
         }
-    }  catch (const std::exception &e) {
-        std::throw_with_nested(tr("An issue has occurred with transmitting data via the Codec2 modem! Error:\n\n%1")
-                               .arg(QString::fromStdString(e.what())).toStdString());
     }
 
-    return -1;
+    return;
 }
 
 /**
  * @brief GkCodec2::createPayloadForTx creates a payload out of a QByteArray of data that's more suitable for transmission of
- * said data over radio waves. It will convert the data to be transmitted towards Base64 encoding while padding out said data
- * to a length that's more easily divisible by a value of eight.
+ * said data over radio waves, being compressed should Small World Deluxe be at either end. The data link carries binary
+ * data as it is, so there is no need for any further encoding.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
  * @param byte_array The QByteArray to be processed.
  * @return The data to be transmitted over the radio waves.
- * @note <https://stackoverflow.com/questions/9811235/best-way-to-split-a-vector-into-two-smaller-arrays>
  */
-QList<QByteArray> GkCodec2::createPayloadForTx(const QByteArray &byte_array)
+QByteArray GkCodec2::createPayloadForTx(const QByteArray &byte_array)
 {
-    try {
-        QByteArray base64_conv_data;
-        if (gkCustomMode == Codec2ModeCustom::GekkoFyreV1) {
-            std::string compressed_string;
-            snappy::Compress(byte_array.data(), byte_array.size(), &compressed_string);
-            QByteArray comprData(compressed_string.c_str(), compressed_string.length());
-            base64_conv_data = comprData.toBase64(QByteArray::KeepTrailingEquals); // Convert to Base64 for easier transmission!
-        } else {
-            // Keeps the trailing padding equal signs at the end of the encoded data, so the data
-            // is always a size multiple of four.
-            base64_conv_data = byte_array.toBase64(QByteArray::KeepTrailingEquals); // Convert to Base64 for easier transmission!
-        }
-
-        std::vector<unsigned char> base64_data_vec(base64_conv_data.begin(), base64_conv_data.end());
-        auto payload_data_tmp = gkStringFuncs->chunker(base64_data_vec, GK_CODEC2_FRAME_SIZE);
-
-        QList<QByteArray> payload_data;
-        for (const auto &vec: payload_data_tmp) {
-            if (!vec.empty()) {
-                QByteArray byte_tmp;
-                payload_data.reserve(vec.size());
-                std::copy(vec.begin(), vec.end(), std::back_inserter(byte_tmp));
-
-                payload_data.push_back(byte_tmp);
+    if (gkCustomMode == Codec2ModeCustom::GekkoFyreV1) {
+        std::string compressed_string;
+        snappy::Compress(byte_array.data(), byte_array.size(), &compressed_string);
+        return QByteArray(compressed_string.c_str(), static_cast<int>(compressed_string.length()));
+    }
+
+    return byte_array;
+}
+
+/**
+ * @brief GkCodec2::messageReceived undoes whatever GkCodec2::createPayloadForTx() did to a message that has arrived in
+ * whole, upon the receive thread.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param message The message, as it came over the data link.
+ */
+void GkCodec2::messageReceived(const QByteArray &message)
+{
+    if (gkCustomMode == Codec2ModeCustom::GekkoFyreV1) {
+        std::string uncompressed_string;
+        if (!snappy::Uncompress(message.constData(), static_cast<size_t>(message.size()), &uncompressed_string)) {
+            if (gkEventLogger) {
+                gkEventLogger->publishEvent(tr("Data was received via the Codec2 modem, but could not be decompressed!"),
+                                            GkSeverity::Warning, "", false, true, false, false, false);
             }
+            return;
         }
 
-        return payload_data;
-    }  catch (const std::exception &e) {
-        std::throw_with_nested(tr("An issue has occurred with transmitting audio via the Codec2 modem! Error:\n\n%1")
-                               .arg(QString::fromStdString(e.what())).toStdString());
+        emit dataReceived(QByteArray(uncompressed_string.c_str(), static_cast<int>(uncompressed_string.length())));
+        return;
     }
 
-    return QList<QByteArray>();
+    emit dataReceived(message);
+
+    return;
 }
 
 /**
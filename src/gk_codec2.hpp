@@ -43,23 +43,36 @@
 
 #include "src/defines.hpp"
 #include "src/gk_logger.hpp"
+#include "src/gk_sdr_ddc.hpp"
+#include "src/gk_data_link.hpp"
 #include "src/gk_string_funcs.hpp"
-#include <iterator>
+#include <atomic>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
+#include <functional>
 #include <QList>
 #include <QString>
 #include <QObject>
 #include <QPointer>
 #include <QByteArray>
 
-#ifdef CODEC2_LIBS_ENBLD
-#include <codec2/codec2.h>
-#endif
+struct freedv;
 
 namespace GekkoFyre {
 
+//
+// Called upon the receive thread with the payload of each modem frame that was demodulated
+using GkCodec2RxCallback = std::function<void(const quint8 *payload, const size_t &bytes)>;
+
+/**
+ * @brief GkCodec2 is a long-lived FreeDV modem for raw data. The modem is opened but once, with one instance for each
+ * direction, and every buffer is allocated up-front so that neither modulating nor demodulating a frame ever allocates.
+ * Captured audio is fed in from the capture thread, resampled towards the modem's own sample rate and kept within a
+ * ring, which a thread of the modem's own drains at whatever granularity FreeDV asks for (i.e. `freedv_nin()`). Data is
+ * carried over the modem by GkDataLink, in bursts of blocks that the far end acknowledges.
+ */
 class GkCodec2 : public QObject {
     Q_OBJECT
 
@@ -70,8 +83,37 @@ public:
                       QObject *parent = nullptr);
     ~GkCodec2() override;
 
-    int transmitData(const QByteArray &byte_array, const bool &play_output_sound = false, const bool &squelch_enable = false,
-                     const float &squelch_thresh = -100.0f);
+    //
+    // Transmission
+    size_t modulateFrame(const quint8 *payload, qint16 *mod_out);
+    size_t modulate(const quint8 *data, const size_t &count, qint16 *mod_out, const size_t &max_samples);
+    int transmitData(const QByteArray &byte_array);
+    int transmitBurst();
+    [[nodiscard]] const std::vector<qint16> &getTxAudio() const;
+    [[nodiscard]] bool isSending() const;
+    [[nodiscard]] GkDataLink::GkDataLinkStats getDataLinkStats() const;
+
+    //
+    // Reception
+    void configureRx(const quint32 &input_rate, const quint16 &channels, const size_t &max_frames);
+    void setRxCallback(GkCodec2RxCallback callback);
+    void setSquelch(const bool &squelch_enable, const float &squelch_thresh);
+    void process(const qint16 *samples, const size_t &frames);
+    size_t demodulate(const qint16 *demod_in, const size_t &count);
+
+    [[nodiscard]] size_t getBytesPerFrame() const;
+    [[nodiscard]] size_t getSamplesPerFrame() const;
+    [[nodiscard]] size_t getSamplesForBytes(const size_t &count) const;
+    [[nodiscard]] quint32 getModemSampleRate() const;
+    [[nodiscard]] bool isSynced() const;
+    [[nodiscard]] float getSnrEstimate() const;
+
+public slots:
+    void start();
+    void stop();
+
+signals:
+    void dataReceived(const QByteArray &data);
 
 private:
     QPointer<GekkoFyre::GkLevelDb> gkDb;
@@ -83,7 +125,53 @@ private:
     int gkFreeDvClip;
     int gkFreeDvTXBpf;                      // OFDM TX Filter (off by default)
 
-    QList<QByteArray> createPayloadForTx(const QByteArray &byte_array);
+    std::unique_ptr<struct freedv, void (*)(struct freedv *)> m_freedvTx;
+    std::unique_ptr<struct freedv, void (*)(struct freedv *)> m_freedvRx;
+    quint32 m_modemRate;
+    size_t m_packedBytes;                                                       // The bytes that FreeDV packs each frame's bits into.
+    size_t m_bytesPerFrame;                                                     // Whole bytes of payload within each frame.
+    size_t m_samplesPerFrame;                                                   // Samples of modem audio produced for each frame.
+    size_t m_maxRxSamples;
+
+    GekkoFyre::GkDataLink m_dataLink;
+    std::vector<quint8> m_txPacked;
+    std::vector<quint8> m_txBurst;                                              // Room for a whole window of blocks, with the padding either side.
+    size_t m_txPaddingBytes;
+    std::vector<qint16> m_txAudio;
+
+    //
+    // Only ever touched by the capture thread, once configured
+    GekkoFyre::GkAudioResampler m_rxResampler;
+    quint16 m_rxChannels;
+    size_t m_rxMaxFrames;
+    std::vector<float> m_rxMono;
+    std::vector<float> m_rxResampled;
+    std::atomic<bool> m_rxConfigured;
+
+    //
+    // The ring between the capture thread (which writes) and the receive thread (which reads)
+    std::vector<qint16> m_rxRing;
+    size_t m_rxRingMask;
+    std::atomic<quint64> m_rxWritten;
+    std::atomic<quint64> m_rxRead;
+    std::atomic<quint64> m_rxOverruns;
+
+    //
+    // Only ever touched by whichever thread demodulates
+    std::vector<qint16> m_rxDemodIn;
+    std::vector<qint16> m_rxScratch;
+    std::vector<quint8> m_rxPacked;
+    size_t m_rxPending;
+    GkCodec2RxCallback m_rxCallback;
+    std::atomic<bool> m_rxSync;
+    std::atomic<float> m_rxSnr;
+
+    std::thread rxThread;
+    std::atomic<bool> m_running;
+
+    void run();
+    QByteArray createPayloadForTx(const QByteArray &byte_array);
+    void messageReceived(const QByteArray &message);
 
     int convertFreeDvModeToInt(const Database::Settings::Codec2Mode &freedv_mode);
 
@@ -0,0 +1,806 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/gk_data_link.hpp"
+#include "src/gk_channel_sim.hpp"
+#include <zlib.h>
+#include <random>
+#include <bitset>
+#include <utility>
+#include <algorithm>
+
+#ifdef CODEC2_LIBS_ENBLD
+#include "src/gk_codec2.hpp"
+#endif
+
+using namespace GekkoFyre;
+using namespace Database;
+using namespace Settings;
+using namespace AmateurRadio;
+
+namespace {
+//
+// The frame within each block is laid out as: type, message ID, segment (16-bit), segments (16-bit), length, the
+// payload and then a CRC-32 of all that came before it
+constexpr size_t frameHeaderBytes = 7;
+constexpr size_t frameCrcBytes = 4;
+constexpr size_t asmBytes = 4;
+constexpr size_t ackBitmapBits = 32;
+
+struct GkGaloisField {
+    std::array<quint8, 512> exp;
+    std::array<qint32, 256> log;
+
+    GkGaloisField() : exp(), log()
+    {
+        quint32 x = 1;
+        for (qint32 i = 0; i < 255; ++i) {
+            exp[i] = static_cast<quint8>(x);
+            log[x] = i;
+            x <<= 1;
+            if (x & 0x100) {
+                x ^= 0x11d;
+            }
+        }
+
+        for (qint32 i = 255; i < 512; ++i) {
+            exp[i] = exp[i - 255];
+        }
+    }
+};
+
+const GkGaloisField &galoisField()
+{
+    static const GkGaloisField field;
+    return field;
+}
+
+void writeBigEndian(quint8 *out, const quint32 &value, const size_t &bytes)
+{
+    for (size_t i = 0; i < bytes; ++i) {
+        out[i] = static_cast<quint8>(value >> (8 * (bytes - 1 - i)));
+    }
+
+    return;
+}
+
+quint32 readBigEndian(const quint8 *in, const size_t &bytes)
+{
+    quint32 value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value = (value << 8) | in[i];
+    }
+
+    return value;
+}
+}
+
+/**
+ * @brief GkReedSolomon::GkReedSolomon
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param data_bytes The bytes of data within each codeword.
+ * @param parity_bytes The bytes of parity within each codeword, which together with the data may be no more than 255.
+ */
+GkReedSolomon::GkReedSolomon(const size_t &data_bytes, const size_t &parity_bytes) : m_dataBytes(data_bytes), m_parityBytes(parity_bytes)
+{
+    if (m_dataBytes == 0 || m_parityBytes == 0 || (m_dataBytes + m_parityBytes) > 255) {
+        throw std::invalid_argument(QObject::tr("A Reed-Solomon code over GF(256) may have no more than 255 bytes within each codeword!").toStdString());
+    }
+
+    //
+    // The generator has the roots α^0 through α^(parity - 1)
+    m_generator.assign(1, 1);
+    for (size_t j = 0; j < m_parityBytes; ++j) {
+        std::vector<quint8> next(m_generator.size() + 1, 0);
+        for (size_t i = 0; i < next.size(); ++i) {
+            if (i < m_generator.size()) {
+                next[i] ^= m_generator[i];
+            }
+
+            if (i > 0) {
+                next[i] ^= mul(m_generator[i - 1], pow(static_cast<qint32>(j)));
+            }
+        }
+
+        m_generator = std::move(next);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkReedSolomon::encode
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param data GkReedSolomon::getDataBytes() bytes of data.
+ * @param parity Where the parity is written, which follows the data within the codeword.
+ */
+void GkReedSolomon::encode(const quint8 *data, quint8 *parity) const
+{
+    std::fill(parity, parity + m_parityBytes, 0);
+    for (size_t i = 0; i < m_dataBytes; ++i) {
+        const quint8 feedback = data[i] ^ parity[0];
+        for (size_t j = 0; (j + 1) < m_parityBytes; ++j) {
+            parity[j] = parity[j + 1] ^ mul(feedback, m_generator[j + 1]);
+        }
+
+        parity[m_parityBytes - 1] = mul(feedback, m_generator[m_parityBytes]);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkReedSolomon::decode corrects a codeword in place, by way of Berlekamp-Massey, a Chien search and Forney.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param codeword GkReedSolomon::getCodewordBytes() bytes, being the data followed by the parity.
+ * @return The number of bytes that were corrected, or -1 should there have been too many for the code.
+ */
+qint32 GkReedSolomon::decode(quint8 *codeword) const
+{
+    const size_t n = getCodewordBytes();
+    const size_t num_roots = m_parityBytes;
+
+    std::array<quint8, 256> syndromes {};
+    bool clean = true;
+    for (size_t j = 0; j < num_roots; ++j) {
+        quint8 s = 0;
+        const quint8 root = pow(static_cast<qint32>(j));
+        for (size_t i = 0; i < n; ++i) {
+            s = mul(s, root) ^ codeword[i];
+        }
+
+        syndromes[j] = s;
+        clean = clean && (s == 0);
+    }
+
+    if (clean) {
+        return 0;
+    }
+
+    //
+    // Berlekamp-Massey, giving the error locator with the lowest power first
+    std::array<quint8, 257> lambda {};
+    std::array<quint8, 257> prev {};
+    std::array<quint8, 257> temp {};
+    lambda[0] = 1;
+    prev[0] = 1;
+    size_t num_errors = 0;
+    size_t shift = 1;
+    quint8 prev_discrepancy = 1;
+    for (size_t r = 0; r < num_roots; ++r) {
+        quint8 discrepancy = syndromes[r];
+        for (size_t i = 1; i <= num_errors; ++i) {
+            discrepancy ^= mul(lambda[i], syndromes[r - i]);
+        }
+
+        if (discrepancy == 0) {
+            ++shift;
+            continue;
+        }
+
+        const quint8 scale = div(discrepancy, prev_discrepancy);
+        if ((2 * num_errors) <= r) {
+            temp = lambda;
+            for (size_t i = 0; (i + shift) <= num_roots; ++i) {
+                lambda[i + shift] ^= mul(scale, prev[i]);
+            }
+
+            num_errors = r + 1 - num_errors;
+            prev = temp;
+            prev_discrepancy = discrepancy;
+            shift = 1;
+        } else {
+            for (size_t i = 0; (i + shift) <= num_roots; ++i) {
+                lambda[i + shift] ^= mul(scale, prev[i]);
+            }
+
+            ++shift;
+        }
+    }
+
+    if ((2 * num_errors) > num_roots) {
+        return -1;
+    }
+
+    //
+    // The error evaluator, being the syndromes multiplied by the locator, modulo x^(parity)
+    std::array<quint8, 256> omega {};
+    for (size_t k = 0; k < num_roots; ++k) {
+        for (size_t i = 0; i <= std::min(k, num_errors); ++i) {
+            omega[k] ^= mul(syndromes[k - i], lambda[i]);
+        }
+    }
+
+    size_t num_found = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const auto power = static_cast<qint32>(n - 1 - i);
+        const quint8 x_inv = pow(255 - power);
+        quint8 value = 0;
+        quint8 x_pow = 1;
+        for (size_t k = 0; k <= num_errors; ++k) {
+            value ^= mul(lambda[k], x_pow);
+            x_pow = mul(x_pow, x_inv);
+        }
+
+        if (value != 0) {
+            continue;
+        }
+
+        quint8 numerator = 0;
+        x_pow = 1;
+        for (size_t k = 0; k < num_roots; ++k) {
+            numerator ^= mul(omega[k], x_pow);
+            x_pow = mul(x_pow, x_inv);
+        }
+
+        //
+        // The formal derivative keeps only the odd powers of the locator
+        quint8 denominator = 0;
+        const quint8 x_inv_sq = mul(x_inv, x_inv);
+        x_pow = 1;
+        for (size_t k = 1; k <= num_errors; k += 2) {
+            denominator ^= mul(lambda[k], x_pow);
+            x_pow = mul(x_pow, x_inv_sq);
+        }
+
+        if (denominator == 0) {
+            return -1;
+        }
+
+        codeword[i] ^= mul(pow(power), div(numerator, denominator));
+        ++num_found;
+    }
+
+    if (num_found != num_errors) {
+        return -1;
+    }
+
+    return static_cast<qint32>(num_found);
+}
+
+/**
+ * @brief GkReedSolomon::getDataBytes
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The bytes of data within each codeword.
+ */
+size_t GkReedSolomon::getDataBytes() const
+{
+    return m_dataBytes;
+}
+
+/**
+ * @brief GkReedSolomon::getCodewordBytes
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The bytes of data and parity within each codeword.
+ */
+size_t GkReedSolomon::getCodewordBytes() const
+{
+    return m_dataBytes + m_parityBytes;
+}
+
+quint8 GkReedSolomon::mul(const quint8 &a, const quint8 &b)
+{
+    if (a == 0 || b == 0) {
+        return 0;
+    }
+
+    const auto &gf = galoisField();
+    return gf.exp[gf.log[a] + gf.log[b]];
+}
+
+quint8 GkReedSolomon::div(const quint8 &a, const quint8 &b)
+{
+    if (a == 0) {
+        return 0;
+    }
+
+    const auto &gf = galoisField();
+    return gf.exp[gf.log[a] + 255 - gf.log[b]];
+}
+
+quint8 GkReedSolomon::pow(const qint32 &exponent)
+{
+    return galoisField().exp[((exponent % 255) + 255) % 255];
+}
+
+/**
+ * @brief GkDataLink::GkDataLink
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param window The most blocks of data that may be awaiting acknowledgement at once, up to 32.
+ */
+GkDataLink::GkDataLink(const quint32 &window)
+    : m_rs(GK_DATA_LINK_RS_DATA_BYTES, GK_DATA_LINK_RS_PARITY_BYTES), m_window(std::max(1U, std::min(window, static_cast<quint32>(ackBitmapBits)))),
+      m_txMsgId(0), m_txCount(0), m_txBase(0), m_txNext(0), m_rxActive(false), m_rxDelivered(false), m_rxAckPending(false),
+      m_rxMsgId(0), m_rxCount(0), m_rxLastLen(0), m_rxFill(0), m_rxShift(0), m_rxShiftFill(0), m_rxHunting(true)
+{
+    const size_t frame_bytes = GK_DATA_LINK_INTERLEAVE_DEPTH * m_rs.getDataBytes();
+    m_txFrame.assign(frame_bytes, 0);
+    m_rxFrame.assign(frame_bytes, 0);
+    m_rxBlock.assign(GK_DATA_LINK_INTERLEAVE_DEPTH * m_rs.getCodewordBytes(), 0);
+    m_rxCodeword.assign(m_rs.getCodewordBytes(), 0);
+
+    return;
+}
+
+/**
+ * @brief GkDataLink::setMessageCallback
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param callback Called with each message that arrives in whole, upon whichever thread feeds GkDataLink::receive().
+ */
+void GkDataLink::setMessageCallback(GkDataLinkCallback callback)
+{
+    std::lock_guard<std::mutex> lock_guard(mtx_arq);
+    m_rxCallback = std::move(callback);
+
+    return;
+}
+
+/**
+ * @brief GkDataLink::queueMessage readies a message for sending, which then goes out over however many calls towards
+ * GkDataLink::nextBurst() it takes for every segment to be acknowledged.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param message The data to be sent.
+ * @return False should the previous message still be in the midst of being sent, or the message be empty or too large.
+ */
+bool GkDataLink::queueMessage(const QByteArray &message)
+{
+    std::lock_guard<std::mutex> lock_guard(mtx_arq);
+    const size_t num_segments = (static_cast<size_t>(message.size()) + getSegmentBytes() - 1) / getSegmentBytes();
+    if ((m_txBase < m_txCount) || num_segments == 0 || num_segments > 0xFFFF) {
+        return false;
+    }
+
+    m_txMessage = message;
+    ++m_txMsgId;
+    m_txCount = static_cast<quint16>(num_segments);
+    m_txBase = 0;
+    m_txNext = 0;
+    m_txAcked.assign(num_segments, false);
+
+    return true;
+}
+
+/**
+ * @brief GkDataLink::isSending
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return Whether there is a message yet to be acknowledged in whole.
+ */
+bool GkDataLink::isSending() const
+{
+    std::lock_guard<std::mutex> lock_guard(mtx_arq);
+    return m_txBase < m_txCount;
+}
+
+/**
+ * @brief GkDataLink::nextBurst gathers the blocks to be sent next: an acknowledgement of whatever has been received, should
+ * anything have been, followed by every block within the window that has not yet been acknowledged.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param out Where the blocks are written, one after another, which must have room for `max_blocks` of them.
+ * @param max_blocks The most blocks to be sent within this burst.
+ * @return The number of blocks written, each being GkDataLink::getBlockBytes() long.
+ */
+size_t GkDataLink::nextBurst(quint8 *out, const size_t &max_blocks)
+{
+    std::lock_guard<std::mutex> lock_guard(mtx_arq);
+    size_t num_blocks = 0;
+    if (m_rxAckPending && num_blocks < max_blocks) {
+        const quint32 base = rxBase();
+        quint32 bitmap = 0;
+        for (quint32 i = 0; i < ackBitmapBits; ++i) {
+            const quint32 seq = base + 1 + i;
+            if (seq < m_rxCount && m_rxHave[seq]) {
+                bitmap |= (1U << i);
+            }
+        }
+
+        std::array<quint8, 4> payload {};
+        writeBigEndian(payload.data(), bitmap, payload.size());
+        buildFrame(FrameAck, m_rxMsgId, static_cast<quint16>(base), m_rxCount, payload.data(), payload.size(), m_txFrame.data());
+        buildBlock(m_txFrame.data(), out + (num_blocks++ * getBlockBytes()));
+        m_rxAckPending = false;
+    }
+
+    const auto send = [&](const quint32 &seq) {
+        const size_t offset = seq * getSegmentBytes();
+        const size_t len = std::min(getSegmentBytes(), static_cast<size_t>(m_txMessage.size()) - offset);
+        buildFrame(FrameData, m_txMsgId, static_cast<quint16>(seq), m_txCount, reinterpret_cast<const quint8 *>(m_txMessage.constData()) + offset,
+                   len, m_txFrame.data());
+        buildBlock(m_txFrame.data(), out + (num_blocks++ * getBlockBytes()));
+        ++m_stats.blocks_sent;
+    };
+
+    //
+    // Whatever went missing from the last burst goes first, with the rest of the window then being filled with new blocks
+    for (quint32 seq = m_txBase; seq < m_txNext && num_blocks < max_blocks; ++seq) {
+        if (!m_txAcked[seq]) {
+            send(seq);
+            ++m_stats.blocks_resent;
+        }
+    }
+
+    const quint32 window_end = std::min<quint32>(m_txBase + m_window, m_txCount);
+    while (m_txNext < window_end && num_blocks < max_blocks) {
+        send(m_txNext++);
+    }
+
+    return num_blocks;
+}
+
+/**
+ * @brief GkDataLink::receive is fed with the payload of each modem frame as it is demodulated. The bytes are searched for
+ * the marker of a block, after which the block is gathered, deinterleaved and corrected.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bytes The payload of a modem frame.
+ * @param count The number of bytes within `bytes`.
+ */
+void GkDataLink::receive(const quint8 *bytes, const size_t &count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        if (m_rxHunting) {
+            m_rxShift = (m_rxShift << 8) | bytes[i];
+            m_rxShiftFill = std::min<quint32>(m_rxShiftFill + 1, asmBytes);
+            if (m_rxShiftFill == asmBytes && std::bitset<32>(m_rxShift ^ static_cast<quint32>(GK_DATA_LINK_ASM)).count() <= GK_DATA_LINK_ASM_MAX_BIT_ERRORS) {
+                m_rxHunting = false;
+                m_rxFill = 0;
+            }
+
+            continue;
+        }
+
+        m_rxBlock[m_rxFill++] = bytes[i];
+        if (m_rxFill == m_rxBlock.size()) {
+            decodeBlock();
+            m_rxHunting = true;
+            m_rxShiftFill = 0;
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief GkDataLink::getStats
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The counts of blocks sent and received thus far.
+ */
+GkDataLink::GkDataLinkStats GkDataLink::getStats() const
+{
+    std::lock_guard<std::mutex> lock_guard(mtx_arq);
+    return m_stats;
+}
+
+/**
+ * @brief GkDataLink::getBlockBytes
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The bytes that each block takes up upon the air, including its marker.
+ */
+size_t GkDataLink::getBlockBytes()
+{
+    return asmBytes + (GK_DATA_LINK_INTERLEAVE_DEPTH * (GK_DATA_LINK_RS_DATA_BYTES + GK_DATA_LINK_RS_PARITY_BYTES));
+}
+
+/**
+ * @brief GkDataLink::getSegmentBytes
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The most bytes of a message that each block carries.
+ */
+size_t GkDataLink::getSegmentBytes()
+{
+    return (GK_DATA_LINK_INTERLEAVE_DEPTH * GK_DATA_LINK_RS_DATA_BYTES) - frameHeaderBytes - frameCrcBytes;
+}
+
+/**
+ * @brief GkDataLink::buildBlock encodes a frame into Reed-Solomon codewords and interleaves them, byte by byte, behind
+ * the marker.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param frame The frame, as built by GkDataLink::buildFrame().
+ * @param block Where the block is written, being GkDataLink::getBlockBytes() long.
+ */
+void GkDataLink::buildBlock(const quint8 *frame, quint8 *block) const
+{
+    writeBigEndian(block, GK_DATA_LINK_ASM, asmBytes);
+    const size_t data_bytes = m_rs.getDataBytes();
+    const size_t codeword_bytes = m_rs.getCodewordBytes();
+    std::array<quint8, GK_DATA_LINK_RS_PARITY_BYTES> parity {};
+    for (size_t c = 0; c < GK_DATA_LINK_INTERLEAVE_DEPTH; ++c) {
+        const quint8 *data = frame + (c * data_bytes);
+        m_rs.encode(data, parity.data());
+        for (size_t j = 0; j < codeword_bytes; ++j) {
+            block[asmBytes + (j * GK_DATA_LINK_INTERLEAVE_DEPTH) + c] = (j < data_bytes) ? data[j] : parity[j - data_bytes];
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief GkDataLink::buildFrame
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param type Whether the frame carries data or an acknowledgement.
+ * @param msg_id The message that the frame belongs to.
+ * @param seq The segment of the message (for data) or the lowest segment still missing (for acknowledgements).
+ * @param count The number of segments within the message.
+ * @param payload The payload of the frame.
+ * @param len The number of bytes within `payload`, which may be no more than GkDataLink::getSegmentBytes().
+ * @param frame Where the frame is written, being as long as the data of every codeword within a block.
+ * @return The bytes of the frame that were used, with the remainder being zero.
+ */
+size_t GkDataLink::buildFrame(const GkFrameType &type, const quint8 &msg_id, const quint16 &seq, const quint16 &count,
+                              const quint8 *payload, const size_t &len, quint8 *frame) const
+{
+    std::fill(frame, frame + m_txFrame.size(), 0);
+    frame[0] = type;
+    frame[1] = msg_id;
+    writeBigEndian(frame + 2, seq, 2);
+    writeBigEndian(frame + 4, count, 2);
+    frame[6] = static_cast<quint8>(len);
+    std::copy(payload, payload + len, frame + frameHeaderBytes);
+
+    const size_t used = frameHeaderBytes + len;
+    const auto crc = static_cast<quint32>(crc32(0L, frame, static_cast<uInt>(used)));
+    writeBigEndian(frame + used, crc, frameCrcBytes);
+
+    return used + frameCrcBytes;
+}
+
+/**
+ * @brief GkDataLink::decodeBlock deinterleaves and corrects the block that has just been gathered, and then checks the
+ * frame within it.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkDataLink::decodeBlock()
+{
+    const size_t data_bytes = m_rs.getDataBytes();
+    const size_t codeword_bytes = m_rs.getCodewordBytes();
+    quint64 corrected = 0;
+    bool failed = false;
+    for (size_t c = 0; c < GK_DATA_LINK_INTERLEAVE_DEPTH && !failed; ++c) {
+        for (size_t j = 0; j < codeword_bytes; ++j) {
+            m_rxCodeword[j] = m_rxBlock[(j * GK_DATA_LINK_INTERLEAVE_DEPTH) + c];
+        }
+
+        const qint32 num_corrected = m_rs.decode(m_rxCodeword.data());
+        failed = (num_corrected < 0);
+        corrected += static_cast<quint64>(std::max(0, num_corrected));
+        std::copy(m_rxCodeword.begin(), m_rxCodeword.begin() + static_cast<std::ptrdiff_t>(data_bytes), m_rxFrame.begin() + static_cast<std::ptrdiff_t>(c * data_bytes));
+    }
+
+    if (!failed) {
+        const size_t len = m_rxFrame[6];
+        const size_t used = frameHeaderBytes + len;
+        failed = (len > getSegmentBytes()) ||
+                 (readBigEndian(m_rxFrame.data() + used, frameCrcBytes) != static_cast<quint32>(crc32(0L, m_rxFrame.data(), static_cast<uInt>(used))));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock_guard(mtx_arq);
+        m_stats.bytes_corrected += corrected;
+        if (failed) {
+            ++m_stats.blocks_failed;
+            return;
+        }
+    }
+
+    handleFrame(m_rxFrame.data());
+
+    return;
+}
+
+/**
+ * @brief GkDataLink::handleFrame acts upon a frame that has passed its CRC, whether by storing the segment of data that
+ * it carries or by marking whatever it acknowledges.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param frame The frame.
+ */
+void GkDataLink::handleFrame(const quint8 *frame)
+{
+    const quint8 type = frame[0];
+    const quint8 msg_id = frame[1];
+    const quint32 seq = readBigEndian(frame + 2, 2);
+    const auto count = static_cast<quint16>(readBigEndian(frame + 4, 2));
+    const size_t len = frame[6];
+    const quint8 *payload = frame + frameHeaderBytes;
+
+    QByteArray message;
+    GkDataLinkCallback callback;
+    {
+        std::lock_guard<std::mutex> lock_guard(mtx_arq);
+        if (type == FrameAck) {
+            if (msg_id != m_txMsgId || count != m_txCount || len != sizeof(quint32)) {
+                return;
+            }
+
+            const quint32 bitmap = readBigEndian(payload, sizeof(quint32));
+            for (quint32 i = 0; i < std::min<quint32>(seq, m_txCount); ++i) {
+                m_txAcked[i] = true;
+            }
+
+            for (quint32 i = 0; i < ackBitmapBits; ++i) {
+                const quint32 acked = seq + 1 + i;
+                if ((bitmap & (1U << i)) && acked < m_txCount) {
+                    m_txAcked[acked] = true;
+                }
+            }
+
+            while (m_txBase < m_txCount && m_txAcked[m_txBase]) {
+                ++m_txBase;
+            }
+
+            m_txNext = std::max(m_txNext, m_txBase);
+
+            return;
+        }
+
+        if (type != FrameData || count == 0 || seq >= count) {
+            return;
+        }
+
+        if (!m_rxActive || msg_id != m_rxMsgId || count != m_rxCount) {
+            m_rxActive = true;
+            m_rxDelivered = false;
+            m_rxMsgId = msg_id;
+            m_rxCount = count;
+            m_rxLastLen = 0;
+            m_rxHave.assign(count, false);
+            m_rxMessage.assign(count * getSegmentBytes(), 0);
+        }
+
+        ++m_stats.blocks_received;
+        m_rxAckPending = true;
+        if (!m_rxHave[seq]) {
+            std::copy(payload, payload + len, m_rxMessage.begin() + static_cast<std::ptrdiff_t>(seq * getSegmentBytes()));
+            m_rxHave[seq] = true;
+            if (seq == (count - 1U)) {
+                m_rxLastLen = len;
+            }
+        }
+
+        if (!m_rxDelivered && rxBase() == m_rxCount) {
+            m_rxDelivered = true;
+            ++m_stats.messages_delivered;
+            message = QByteArray(reinterpret_cast<const char *>(m_rxMessage.data()),
+                                 static_cast<int>(((m_rxCount - 1U) * getSegmentBytes()) + m_rxLastLen));
+            callback = m_rxCallback;
+        }
+    }
+
+    if (callback) {
+        callback(message);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkDataLink::rxBase
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The lowest segment of the message being received that has yet to arrive.
+ */
+quint32 GkDataLink::rxBase() const
+{
+    quint32 base = 0;
+    while (base < m_rxCount && m_rxHave[base]) {
+        ++base;
+    }
+
+    return base;
+}
+
+#ifdef CODEC2_LIBS_ENBLD
+/**
+ * @brief GkDataLinkBenchmark::run sends the same message at each SNR, with every burst of data and of acknowledgements
+ * passing through a channel of its own direction, until either the message has been acknowledged in whole or too many
+ * bursts have been sent.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param mode The mode of FreeDV that carries the data link.
+ * @return The goodput at each SNR, first without fading and then with.
+ */
+std::vector<GkDataLinkBenchResult> GkDataLinkBenchmark::run(const Codec2Mode &mode)
+{
+    std::vector<GkDataLinkBenchResult> results;
+    std::mt19937 rng(0x5eed);
+    QByteArray message(GK_DATA_LINK_BENCH_BYTES, 0);
+    for (qint32 i = 0; i < message.size(); ++i) {
+        message[i] = static_cast<char>(rng() & 0xFF);
+    }
+
+    for (const double fading_hz: { 0.0, GK_DATA_LINK_BENCH_FADING_HZ }) {
+        for (qint32 snr_db = GK_DATA_LINK_BENCH_MIN_SNR_DB; snr_db <= GK_DATA_LINK_BENCH_MAX_SNR_DB; snr_db += GK_DATA_LINK_BENCH_STEP_SNR_DB) {
+            GkCodec2 sender(mode, Codec2ModeCustom::Disabled, 0, 0, nullptr, nullptr, nullptr);
+            GkCodec2 receiver(mode, Codec2ModeCustom::Disabled, 0, 0, nullptr, nullptr, nullptr);
+            QByteArray delivered;
+            QObject::connect(&receiver, &GkCodec2::dataReceived, [&delivered](const QByteArray &data) { delivered = data; });
+
+            const quint32 sample_rate = sender.getModemSampleRate();
+            GkChannelSimulator forward(sample_rate, static_cast<quint32>(snr_db + 100));
+            GkChannelSimulator reverse(sample_rate, static_cast<quint32>(snr_db + 200));
+            forward.setFading(fading_hz);
+            reverse.setFading(fading_hz);
+
+            GkDataLinkBenchResult result;
+            result.snr_db = snr_db;
+            result.fading_hz = fading_hz;
+            quint64 airtime_samples = 0;
+            std::vector<qint16> audio;
+            std::vector<qint16> received_audio;
+            qint32 num_samples = sender.transmitData(message);
+            for (bool noise_set = false; num_samples > 0 && result.bursts < GK_DATA_LINK_BENCH_MAX_ROUNDS; num_samples = sender.transmitBurst()) {
+                audio = sender.getTxAudio();
+                if (!noise_set) {
+                    const double rms = GkChannelSimulator::measureRms(audio.data(), audio.size());
+                    forward.setNoise(snr_db, rms);
+                    reverse.setNoise(snr_db, rms);
+                    noise_set = true;
+                }
+
+                received_audio.resize(forward.maxOutput(audio.size()));
+                const size_t forward_count = forward.process(audio.data(), audio.size(), received_audio.data());
+                receiver.demodulate(received_audio.data(), forward_count);
+                airtime_samples += audio.size();
+                ++result.bursts;
+
+                if (receiver.transmitBurst() > 0) {
+                    audio = receiver.getTxAudio();
+                    received_audio.resize(reverse.maxOutput(audio.size()));
+                    const size_t reverse_count = reverse.process(audio.data(), audio.size(), received_audio.data());
+                    sender.demodulate(received_audio.data(), reverse_count);
+                    airtime_samples += audio.size();
+                }
+
+                if (!sender.isSending()) {
+                    break;
+                }
+            }
+
+            const auto sent = sender.getDataLinkStats();
+            const auto received = receiver.getDataLinkStats();
+            result.delivered = (delivered == message);
+            result.blocks_sent = static_cast<quint32>(sent.blocks_sent);
+            result.blocks_failed = static_cast<quint32>(sent.blocks_sent - std::min(sent.blocks_sent, received.blocks_received));
+            result.airtime_secs = static_cast<double>(airtime_samples) / sample_rate;
+            result.goodput_bps = (result.delivered && result.airtime_secs > 0.0) ? ((message.size() * 8.0) / result.airtime_secs) : 0.0;
+            results.push_back(result);
+        }
+    }
+
+    return results;
+}
+#endif
@@ -0,0 +1,182 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <functional>
+#include <QtGlobal>
+#include <QByteArray>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkReedSolomon is a systematic Reed-Solomon code over GF(256), shortened towards however many bytes of data are
+ * wanted, which corrects up to half as many bytes in error as it has bytes of parity.
+ */
+class GkReedSolomon {
+
+public:
+    GkReedSolomon(const size_t &data_bytes, const size_t &parity_bytes);
+
+    void encode(const quint8 *data, quint8 *parity) const;
+    qint32 decode(quint8 *codeword) const;
+
+    [[nodiscard]] size_t getDataBytes() const;
+    [[nodiscard]] size_t getCodewordBytes() const;
+
+private:
+    size_t m_dataBytes;
+    size_t m_parityBytes;
+    std::vector<quint8> m_generator;                                            // Highest power first, being monic.
+
+    [[nodiscard]] static quint8 mul(const quint8 &a, const quint8 &b);
+    [[nodiscard]] static quint8 div(const quint8 &a, const quint8 &b);
+    [[nodiscard]] static quint8 pow(const qint32 &exponent);
+
+};
+
+//
+// Called with each message that has arrived in whole
+using GkDataLinkCallback = std::function<void(const QByteArray &message)>;
+
+/**
+ * @brief GkDataLink frames binary data for the Codec2 modem. Each message is split into segments, each of which is sent
+ * as a block of its own: a marker to find the block by, followed by Reed-Solomon codewords that are interleaved with one
+ * another so that a lost or damaged modem frame only costs each codeword a byte or two. Within the codewords lies a
+ * length-prefixed frame with a CRC-32. Blocks are sent in bursts of up to a window's worth, with the far end answering
+ * each burst with a bitmap of what it has, so that only those blocks that went missing are ever sent again (i.e.
+ * selective-repeat ARQ).
+ */
+class GkDataLink {
+
+public:
+    struct GkDataLinkStats {
+        quint64 blocks_sent = 0;
+        quint64 blocks_resent = 0;
+        quint64 blocks_received = 0;
+        quint64 blocks_failed = 0;                                              // Blocks that were found yet failed their FEC or CRC.
+        quint64 bytes_corrected = 0;
+        quint64 messages_delivered = 0;
+    };
+
+    explicit GkDataLink(const quint32 &window = GK_DATA_LINK_ARQ_WINDOW);
+
+    void setMessageCallback(GkDataLinkCallback callback);
+    bool queueMessage(const QByteArray &message);
+    [[nodiscard]] bool isSending() const;
+
+    size_t nextBurst(quint8 *out, const size_t &max_blocks);
+    void receive(const quint8 *bytes, const size_t &count);
+
+    [[nodiscard]] GkDataLinkStats getStats() const;
+    [[nodiscard]] static size_t getBlockBytes();
+    [[nodiscard]] static size_t getSegmentBytes();
+
+private:
+    enum GkFrameType : quint8 {
+        FrameData = 0x01,
+        FrameAck = 0x02
+    };
+
+    GkReedSolomon m_rs;
+    quint32 m_window;
+    mutable std::mutex mtx_arq;                                                 // Guards all of the ARQ state, which is touched by both directions.
+    GkDataLinkStats m_stats;
+
+    //
+    // Sending
+    QByteArray m_txMessage;
+    quint8 m_txMsgId;
+    quint16 m_txCount;                                                          // The number of segments within the message.
+    quint32 m_txBase;                                                           // The lowest segment yet to be acknowledged.
+    quint32 m_txNext;                                                           // The lowest segment never yet sent.
+    std::vector<bool> m_txAcked;
+    std::vector<quint8> m_txFrame;
+
+    //
+    // Receiving
+    std::vector<quint8> m_rxMessage;
+    std::vector<bool> m_rxHave;
+    bool m_rxActive;
+    bool m_rxDelivered;
+    bool m_rxAckPending;
+    quint8 m_rxMsgId;
+    quint16 m_rxCount;
+    size_t m_rxLastLen;
+    GkDataLinkCallback m_rxCallback;
+
+    //
+    // Only ever touched by whichever thread feeds the received bytes in
+    std::vector<quint8> m_rxBlock;
+    std::vector<quint8> m_rxFrame;
+    std::vector<quint8> m_rxCodeword;
+    size_t m_rxFill;
+    quint32 m_rxShift;
+    quint32 m_rxShiftFill;
+    bool m_rxHunting;
+
+    void buildBlock(const quint8 *frame, quint8 *block) const;
+    size_t buildFrame(const GkFrameType &type, const quint8 &msg_id, const quint16 &seq, const quint16 &count,
+                      const quint8 *payload, const size_t &len, quint8 *frame) const;
+    void decodeBlock();
+    void handleFrame(const quint8 *frame);
+    [[nodiscard]] quint32 rxBase() const;
+
+};
+
+#ifdef CODEC2_LIBS_ENBLD
+/**
+ * @brief GkDataLinkBenchmark sends a message back and forth through the FreeDV modem and GkChannelSimulator, at a range
+ * of SNRs both with and without fading, so that the goodput of the data link may be measured offline.
+ */
+class GkDataLinkBenchmark {
+
+public:
+    [[nodiscard]] static std::vector<GekkoFyre::AmateurRadio::GkDataLinkBenchResult> run(const Database::Settings::Codec2Mode &mode);
+
+};
+#endif
+};
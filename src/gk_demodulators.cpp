@@ -0,0 +1,552 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/gk_demodulators.hpp"
+#include <chrono>
+#include <random>
+#include <utility>
+#include <exception>
+
+using namespace GekkoFyre;
+using namespace System;
+using namespace GkSdr;
+
+/**
+ * @brief GkSdrDemod::create
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param modulation The modulation in question.
+ * @param sample_rate The sample rate of the channel, as it is handed towards the demodulator.
+ * @param bandwidth The width of the channel, in hertz.
+ * @return A demodulator for the given modulation.
+ */
+std::unique_ptr<GkSdrDemod> GkSdrDemod::create(const GkSdrModulation &modulation, const double &sample_rate, const double &bandwidth)
+{
+    switch (modulation) {
+        case SdrModNfm:
+            return std::make_unique<GkDemodFm>(sample_rate, bandwidth / GK_DEMOD_NFM_DEVIATION_RATIO);
+        case SdrModWfm:
+            return std::make_unique<GkDemodFm>(sample_rate, GK_DEMOD_WFM_DEVIATION_HZ, GK_DEMOD_WFM_DEEMPH_MICROSECS / 1e6);
+        case SdrModAm:
+            return std::make_unique<GkDemodAm>(sample_rate);
+        case SdrModUsb:
+        case SdrModLsb:
+            return std::make_unique<GkDemodSsb>(sample_rate, passbandShift(modulation, bandwidth));
+        case SdrModCw:
+            return std::make_unique<GkDemodCw>(sample_rate, bandwidth, GK_SDR_DDC_CW_BFO_HZ);
+        case SdrModDsb:
+        case SdrModRaw:
+        default:
+            break;
+    }
+
+    return std::make_unique<GkDemodReal>();
+}
+
+/**
+ * @brief GkSdrDemod::defaultBandwidth
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param modulation The modulation in question.
+ * @return The usual width of a channel with the given modulation, in hertz.
+ */
+double GkSdrDemod::defaultBandwidth(const GkSdrModulation &modulation)
+{
+    switch (modulation) {
+        case SdrModNfm:
+            return 12500.0;
+        case SdrModAm:
+            return 10000.0;
+        case SdrModUsb:
+        case SdrModLsb:
+            return 2700.0;
+        case SdrModWfm:
+            return 180000.0;
+        case SdrModDsb:
+            return 6000.0;
+        case SdrModCw:
+            return 500.0;
+        case SdrModRaw:
+            return GK_SDR_DDC_AUDIO_RATE * 0.9;
+        default:
+            break;
+    }
+
+    return 12500.0;
+}
+
+/**
+ * @brief GkSdrDemod::passbandShift
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param modulation The modulation in question.
+ * @param bandwidth The width of the channel, in hertz.
+ * @return How far the middle of the channel lies from its carrier, in hertz, which is only ever non-zero for SSB.
+ */
+double GkSdrDemod::passbandShift(const GkSdrModulation &modulation, const double &bandwidth)
+{
+    switch (modulation) {
+        case SdrModUsb:
+            return GK_SDR_DDC_SSB_LOW_CUT_HZ + (bandwidth / 2.0);
+        case SdrModLsb:
+            return -(GK_SDR_DDC_SSB_LOW_CUT_HZ + (bandwidth / 2.0));
+        default:
+            break;
+    }
+
+    return 0.0;
+}
+
+GkDemodBlock::GkDemodBlock()
+{
+    m_i.fill(0.0f);
+    m_q.fill(0.0f);
+    m_scratch.fill(0.0f);
+
+    return;
+}
+
+/**
+ * @brief GkDemodBlock::process demodulates a span of samples, one block at a time.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param in The complex samples of the channel.
+ * @param count The number of samples within the span.
+ * @param out Where the audio is to be written, being one sample of audio per complex sample.
+ */
+void GkDemodBlock::process(const std::complex<float> *in, const size_t &count, float *out)
+{
+    //
+    // std::complex<float> is guaranteed to be laid out as two floats, real and then imaginary!
+    const auto *src = reinterpret_cast<const float *>(in);
+    size_t done = 0;
+    while (done < count) {
+        const size_t len = std::min<size_t>(GK_DEMOD_BLOCK_SAMPLES, count - done);
+        const float *blk = src + (done * 2);
+        float *dst_i = m_i.data() + 1;
+        float *dst_q = m_q.data() + 1;
+        for (size_t n = 0; n < len; ++n) {
+            dst_i[n] = blk[(n * 2)];
+            dst_q[n] = blk[(n * 2) + 1];
+        }
+
+        processBlock(len, out + done);
+
+        m_i[0] = m_i[len];
+        m_q[0] = m_q[len];
+        done += len;
+    }
+
+    return;
+}
+
+/**
+ * @brief GkDemodBlock::reset forgets about any samples that came before.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkDemodBlock::reset()
+{
+    m_i[0] = 0.0f;
+    m_q[0] = 0.0f;
+    resetBlock();
+
+    return;
+}
+
+GkDemodOscillator::GkDemodOscillator() : m_phase(0.0), m_phaseInc(0.0)
+{
+    return;
+}
+
+/**
+ * @brief GkDemodOscillator::setFrequency
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param freq_hz How far the samples are to be shifted, in hertz, which may be negative.
+ * @param sample_rate The sample rate of the samples.
+ */
+void GkDemodOscillator::setFrequency(const double &freq_hz, const double &sample_rate)
+{
+    m_phaseInc = (sample_rate > 0.0) ? ((2.0 * M_PI * freq_hz) / sample_rate) : 0.0;
+    m_phase = 0.0;
+
+    return;
+}
+
+void GkDemodOscillator::reset()
+{
+    m_phase = 0.0;
+    return;
+}
+
+/**
+ * @brief GkDemodOscillator::mixReal works out Re{(I + jQ) * e^(jwn)} for a block of samples.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param in_i The in-phase part of the block.
+ * @param in_q The quadrature part of the block.
+ * @param len The number of samples within the block.
+ * @param out Where the result is to be written.
+ */
+void GkDemodOscillator::mixReal(const float *in_i, const float *in_q, const size_t &len, float *out)
+{
+    if (m_phaseInc == 0.0) {
+        std::copy(in_i, in_i + len, out);
+        return;
+    }
+
+    std::array<float, GK_DEMOD_SIMD_LANES> lane_cos;
+    std::array<float, GK_DEMOD_SIMD_LANES> lane_sin;
+    for (size_t k = 0; k < GK_DEMOD_SIMD_LANES; ++k) {
+        lane_cos[k] = static_cast<float>(std::cos(m_phase + (m_phaseInc * k)));
+        lane_sin[k] = static_cast<float>(std::sin(m_phase + (m_phaseInc * k)));
+    }
+
+    const auto rot_cos = static_cast<float>(std::cos(m_phaseInc * GK_DEMOD_SIMD_LANES));
+    const auto rot_sin = static_cast<float>(std::sin(m_phaseInc * GK_DEMOD_SIMD_LANES));
+
+    size_t n = 0;
+    for (; (n + GK_DEMOD_SIMD_LANES) <= len; n += GK_DEMOD_SIMD_LANES) {
+        for (size_t k = 0; k < GK_DEMOD_SIMD_LANES; ++k) {
+            out[n + k] = (in_i[n + k] * lane_cos[k]) - (in_q[n + k] * lane_sin[k]);
+        }
+
+        for (size_t k = 0; k < GK_DEMOD_SIMD_LANES; ++k) {
+            const float c = (lane_cos[k] * rot_cos) - (lane_sin[k] * rot_sin);
+            const float s = (lane_cos[k] * rot_sin) + (lane_sin[k] * rot_cos);
+            lane_cos[k] = c;
+            lane_sin[k] = s;
+        }
+    }
+
+    for (size_t k = 0; n < len; ++n, ++k) {
+        out[n] = (in_i[n] * lane_cos[k]) - (in_q[n] * lane_sin[k]);
+    }
+
+    m_phase = std::fmod(m_phase + (m_phaseInc * static_cast<double>(len)), 2.0 * M_PI);
+    return;
+}
+
+bool GkDemodOscillator::isShifting() const
+{
+    return m_phaseInc != 0.0;
+}
+
+/**
+ * @brief GkDemodAm::GkDemodAm
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sample_rate The sample rate of the channel.
+ */
+GkDemodAm::GkDemodAm(const double &sample_rate) : m_sampleRate(sample_rate), m_carrier(0.0f), m_primed(false)
+{
+    return;
+}
+
+void GkDemodAm::processBlock(const size_t &len, float *out)
+{
+    const float *in_i = m_i.data() + 1;
+    const float *in_q = m_q.data() + 1;
+    float *env = m_scratch.data();
+    for (size_t n = 0; n < len; ++n) {
+        env[n] = fastSqrt((in_i[n] * in_i[n]) + (in_q[n] * in_q[n]));
+    }
+
+    //
+    // Sum the envelope across several lanes, as a single running sum would have to be worked out in order!
+    std::array<float, GK_DEMOD_SIMD_LANES> acc = {};
+    size_t n = 0;
+    for (; (n + GK_DEMOD_SIMD_LANES) <= len; n += GK_DEMOD_SIMD_LANES) {
+        for (size_t k = 0; k < GK_DEMOD_SIMD_LANES; ++k) {
+            acc[k] += env[n + k];
+        }
+    }
+
+    float sum = 0.0f;
+    for (; n < len; ++n) {
+        sum += env[n];
+    }
+
+    for (const auto &lane: acc) {
+        sum += lane;
+    }
+
+    const float mean = sum / static_cast<float>(len);
+    if (!m_primed) {
+        m_carrier = mean;
+        m_primed = true;
+    }
+
+    const auto alpha = static_cast<float>(1.0 - std::exp(-static_cast<double>(len) / (GK_DEMOD_AM_CARRIER_SECS * m_sampleRate)));
+    const float target = m_carrier + (alpha * (mean - m_carrier));
+    const float start = std::max(m_carrier, 1e-9f);
+    const float step = (std::max(target, 1e-9f) - start) / static_cast<float>(len);
+    for (size_t i = 0; i < len; ++i) {
+        const float carrier = start + (step * static_cast<float>(static_cast<qint32>(i) + 1));
+        out[i] = (env[i] - carrier) / carrier;
+    }
+
+    m_carrier = target;
+    return;
+}
+
+void GkDemodAm::resetBlock()
+{
+    m_carrier = 0.0f;
+    m_primed = false;
+
+    return;
+}
+
+/**
+ * @brief GkDemodFm::GkDemodFm
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sample_rate The sample rate of the channel.
+ * @param deviation The peak deviation, in hertz, which comes out at full scale.
+ * @param deemph_secs The time constant of the de-emphasis, in seconds, or zero for none at all.
+ */
+GkDemodFm::GkDemodFm(const double &sample_rate, const double &deviation, const double &deemph_secs)
+    : m_gain(static_cast<float>(sample_rate / (2.0 * M_PI * deviation))), m_deemphAlpha(0.0f), m_deemph(0.0f)
+{
+    if (deemph_secs > 0.0) {
+        m_deemphAlpha = static_cast<float>(1.0 - std::exp(-1.0 / (deemph_secs * sample_rate)));
+    }
+
+    return;
+}
+
+void GkDemodFm::processBlock(const size_t &len, float *out)
+{
+    //
+    // Index zero holds the last sample of the block before, so that `n` is always the previous sample to `n + 1`!
+    const float *in_i = m_i.data();
+    const float *in_q = m_q.data();
+    const float gain = m_gain;
+    for (size_t n = 0; n < len; ++n) {
+        const float re = (in_i[n + 1] * in_i[n]) + (in_q[n + 1] * in_q[n]);
+        const float im = (in_q[n + 1] * in_i[n]) - (in_i[n + 1] * in_q[n]);
+        out[n] = fastAtan2(im, re) * gain;
+    }
+
+    if (m_deemphAlpha > 0.0f) {
+        float state = m_deemph;
+        for (size_t n = 0; n < len; ++n) {
+            state += m_deemphAlpha * (out[n] - state);
+            out[n] = state;
+        }
+
+        m_deemph = state;
+    }
+
+    return;
+}
+
+void GkDemodFm::resetBlock()
+{
+    m_deemph = 0.0f;
+    return;
+}
+
+/**
+ * @brief GkDemodSsb::GkDemodSsb
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sample_rate The sample rate of the channel.
+ * @param shift_hz How far the middle of the sideband lies from the carrier, which is negative for LSB.
+ */
+GkDemodSsb::GkDemodSsb(const double &sample_rate, const double &shift_hz)
+{
+    m_bfo.setFrequency(shift_hz, sample_rate);
+    return;
+}
+
+void GkDemodSsb::processBlock(const size_t &len, float *out)
+{
+    m_bfo.mixReal(m_i.data() + 1, m_q.data() + 1, len, out);
+    return;
+}
+
+void GkDemodSsb::resetBlock()
+{
+    m_bfo.reset();
+    return;
+}
+
+/**
+ * @brief GkDemodCw::GkDemodCw
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sample_rate The sample rate of the channel.
+ * @param bandwidth The width of the filter about the carrier, in hertz.
+ * @param bfo_hz The pitch at which the carrier is to be heard.
+ */
+GkDemodCw::GkDemodCw(const double &sample_rate, const double &bandwidth, const double &bfo_hz)
+{
+    //
+    // A pair of second-order sections with these Q factors make up a fourth-order Butterworth response
+    const double cutoff = std::min(bandwidth / 2.0, sample_rate * 0.45);
+    m_stages[0] = designLowpass(cutoff, sample_rate, 0.54119610);
+    m_stages[1] = designLowpass(cutoff, sample_rate, 1.30656296);
+    m_bfo.setFrequency(bfo_hz, sample_rate);
+
+    return;
+}
+
+void GkDemodCw::processBlock(const size_t &len, float *out)
+{
+    //
+    // The block is filtered in-place, as the sample held before it is of no use to CW
+    float *io_i = m_i.data() + 1;
+    float *io_q = m_q.data() + 1;
+    for (auto &stage: m_stages) {
+        GkBiquad f = stage;
+        for (size_t n = 0; n < len; ++n) {
+            const float yi = (f.b0 * io_i[n]) + f.zi1;
+            f.zi1 = (f.b1 * io_i[n]) - (f.a1 * yi) + f.zi2;
+            f.zi2 = (f.b2 * io_i[n]) - (f.a2 * yi);
+            io_i[n] = yi;
+
+            const float yq = (f.b0 * io_q[n]) + f.zq1;
+            f.zq1 = (f.b1 * io_q[n]) - (f.a1 * yq) + f.zq2;
+            f.zq2 = (f.b2 * io_q[n]) - (f.a2 * yq);
+            io_q[n] = yq;
+        }
+
+        stage = f;
+    }
+
+    m_bfo.mixReal(io_i, io_q, len, out);
+    return;
+}
+
+void GkDemodCw::resetBlock()
+{
+    for (auto &stage: m_stages) {
+        stage.zi1 = stage.zi2 = 0.0f;
+        stage.zq1 = stage.zq2 = 0.0f;
+    }
+
+    m_bfo.reset();
+    return;
+}
+
+/**
+ * @brief GkDemodCw::designLowpass
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param cutoff_hz The cutoff frequency, in hertz.
+ * @param sample_rate The sample rate of the channel.
+ * @param q The Q factor of the section.
+ * @return A second-order low-pass section, as per Robert Bristow-Johnson's 'Audio EQ Cookbook'.
+ */
+GkDemodCw::GkBiquad GkDemodCw::designLowpass(const double &cutoff_hz, const double &sample_rate, const double &q)
+{
+    const double w0 = (2.0 * M_PI * cutoff_hz) / sample_rate;
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double cos_w0 = std::cos(w0);
+    const double a0 = 1.0 + alpha;
+
+    GkBiquad biquad;
+    biquad.b0 = static_cast<float>(((1.0 - cos_w0) / 2.0) / a0);
+    biquad.b1 = static_cast<float>((1.0 - cos_w0) / a0);
+    biquad.b2 = biquad.b0;
+    biquad.a1 = static_cast<float>((-2.0 * cos_w0) / a0);
+    biquad.a2 = static_cast<float>((1.0 - alpha) / a0);
+
+    return biquad;
+}
+
+void GkDemodReal::processBlock(const size_t &len, float *out)
+{
+    std::copy(m_i.data() + 1, m_i.data() + 1 + len, out);
+    return;
+}
+
+void GkDemodReal::resetBlock()
+{
+    return;
+}
+
+/**
+ * @brief GkDemodBenchmark::run times each of the demodulators against the same synthetic IQ, being a modulated carrier
+ * amongst white noise, upon the calling thread alone.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param num_samples The number of complex samples to be demodulated by each.
+ * @return The throughput of each demodulator, in millions of samples per second, per core.
+ */
+std::vector<GkDemodBenchResult> GkDemodBenchmark::run(const size_t &num_samples)
+{
+    try {
+        static const std::array<std::pair<GkSdrModulation, const char *>, 7> demods = {{
+            { SdrModNfm, "NFM" }, { SdrModWfm, "WFM" }, { SdrModAm, "AM" }, { SdrModUsb, "USB" }, { SdrModLsb, "LSB" },
+            { SdrModCw, "CW" }, { SdrModDsb, "DSB" }
+        }};
+
+        std::vector<std::complex<float>> input(GK_SDR_DDC_CHUNK_SAMPLES);
+        std::vector<float> output(GK_SDR_DDC_CHUNK_SAMPLES);
+        std::mt19937 rng(0x5eed);
+        std::normal_distribution<float> noise(0.0f, 0.05f);
+        for (size_t i = 0; i < input.size(); ++i) {
+            const double phase = 2.0 * M_PI * 0.01 * static_cast<double>(i);
+            input[i] = std::polar(0.5f, static_cast<float>(phase)) + std::complex<float>(noise(rng), noise(rng));
+        }
+
+        std::vector<GkDemodBenchResult> results;
+        volatile float sink = 0.0f;
+        for (const auto &entry: demods) {
+            const double sample_rate = (entry.first == SdrModWfm) ? GK_SDR_DDC_PFB_MIN_RATE : GK_SDR_DDC_AUDIO_RATE;
+            auto demod = GkSdrDemod::create(entry.first, sample_rate, GkSdrDemod::defaultBandwidth(entry.first));
+            demod->process(input.data(), input.size(), output.data()); // Warm up the caches...
+
+            size_t done = 0;
+            const auto start = std::chrono::steady_clock::now();
+            while (done < num_samples) {
+                demod->process(input.data(), input.size(), output.data());
+                done += input.size();
+            }
+
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            sink = sink + output.back();
+
+            GkDemodBenchResult result;
+            result.modulation = entry.first;
+            result.name = QString::fromLatin1(entry.second);
+            result.msamples_per_sec = (static_cast<double>(done) / std::max(elapsed.count(), 1e-9)) / 1e6;
+            results.push_back(result);
+        }
+
+        return results;
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return std::vector<GkDemodBenchResult>();
+}
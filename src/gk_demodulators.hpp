@@ -0,0 +1,275 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include <array>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkSdrDemod turns a channel's complex baseband samples into audio.
+ */
+class GkSdrDemod {
+
+public:
+    virtual ~GkSdrDemod() = default;
+
+    virtual void process(const std::complex<float> *in, const size_t &count, float *out) = 0;
+    virtual void reset() = 0;
+
+    [[nodiscard]] static std::unique_ptr<GekkoFyre::GkSdrDemod> create(const GekkoFyre::System::GkSdr::GkSdrModulation &modulation,
+                                                                       const double &sample_rate, const double &bandwidth);
+    [[nodiscard]] static double defaultBandwidth(const GekkoFyre::System::GkSdr::GkSdrModulation &modulation);
+    [[nodiscard]] static double passbandShift(const GekkoFyre::System::GkSdr::GkSdrModulation &modulation, const double &bandwidth);
+
+};
+
+/**
+ * @brief GkDemodBlock is the common ground of the demodulators below. Spans of any length are worked through in blocks no
+ * longer than GK_DEMOD_BLOCK_SAMPLES, each of which is first split into separate I and Q arrays within a scratch arena that
+ * is allocated along with the demodulator itself, so that nothing is ever allocated per block and the inner loops may be
+ * vectorized by the compiler.
+ */
+class GkDemodBlock : public GkSdrDemod {
+
+public:
+    GkDemodBlock();
+    ~GkDemodBlock() override = default;
+
+    void process(const std::complex<float> *in, const size_t &count, float *out) override;
+    void reset() override;
+
+    //
+    // Comparisons below are turned into arithmetic rather than branches, as GCC will otherwise refuse to vectorize the
+    // loops that call upon these without -ffast-math (or at least -fno-math-errno and -fno-trapping-math)...
+
+    /**
+     * @brief fastAtan2 is a polynomial approximation of atan2(), which is good to within 1e-5 radians.
+     */
+    [[nodiscard]] static inline float fastAtan2(const float &y, const float &x)
+    {
+        const float ax = std::fabs(x);
+        const float ay = std::fabs(y);
+        const auto swap = static_cast<float>(ay > ax);
+        const float mx = ax + (swap * (ay - ax));
+        const float mn = ay + (swap * (ax - ay));
+        const float a = mn / (mx + 1e-30f);
+        const float s = a * a;
+        float r = ((((-0.0464964749f * s) + 0.15931422f) * s - 0.327622764f) * s * a) + a;
+        r += swap * (1.57079637f - (2.0f * r));
+        r += static_cast<float>(x < 0.0f) * (3.14159274f - (2.0f * r));
+        return std::copysign(r, y);
+    }
+
+    /**
+     * @brief fastSqrt is the square root of a non-negative number, by way of an estimate of its reciprocal that is then
+     * refined thrice with Newton's method, which is good to within 2e-7 of the true value.
+     */
+    [[nodiscard]] static inline float fastSqrt(const float &x)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        bits = 0x5f375a86U - (bits >> 1);
+        float y;
+        std::memcpy(&y, &bits, sizeof(y));
+
+        const float half = 0.5f * x;
+        y *= 1.5f - (half * y * y);
+        y *= 1.5f - (half * y * y);
+        y *= 1.5f - (half * y * y);
+        return x * y;
+    }
+
+protected:
+    //
+    // The I and Q of the current block begin at index 1, whilst index 0 holds the last sample of the block before
+    alignas(32) std::array<float, GK_DEMOD_BLOCK_SAMPLES + 1> m_i;
+    alignas(32) std::array<float, GK_DEMOD_BLOCK_SAMPLES + 1> m_q;
+    alignas(32) std::array<float, GK_DEMOD_BLOCK_SAMPLES> m_scratch;
+
+    virtual void processBlock(const size_t &len, float *out) = 0;
+    virtual void resetBlock() = 0;
+
+};
+
+/**
+ * @brief GkDemodOscillator shifts a block of I and Q in frequency and keeps only the real part, as the second half of a
+ * Weaver modulator would. Each of its lanes is a phasor which is rotated GK_DEMOD_SIMD_LANES samples at a time, and which
+ * is worked out afresh from the exact phase at the start of every block so that no error may accumulate.
+ */
+class GkDemodOscillator {
+
+public:
+    GkDemodOscillator();
+
+    void setFrequency(const double &freq_hz, const double &sample_rate);
+    void reset();
+    void mixReal(const float *in_i, const float *in_q, const size_t &len, float *out);
+
+    [[nodiscard]] bool isShifting() const;
+
+private:
+    double m_phase;
+    double m_phaseInc;
+
+};
+
+/**
+ * @brief GkDemodAm is an envelope detector, whose output is normalized against the carrier so that the depth of the
+ * modulation sets the volume, rather than the strength of the signal. The carrier is measured once per block and then
+ * ramped across the next, which leaves the inner loop free of any feedback.
+ */
+class GkDemodAm : public GkDemodBlock {
+
+public:
+    explicit GkDemodAm(const double &sample_rate);
+
+protected:
+    void processBlock(const size_t &len, float *out) override;
+    void resetBlock() override;
+
+private:
+    double m_sampleRate;
+    float m_carrier;
+    bool m_primed;
+
+};
+
+/**
+ * @brief GkDemodFm is a quadrature FM demodulator, which measures the change in phase between successive samples with a
+ * branchless approximation of atan2(), followed by an optional de-emphasis.
+ */
+class GkDemodFm : public GkDemodBlock {
+
+public:
+    explicit GkDemodFm(const double &sample_rate, const double &deviation, const double &deemph_secs = 0.0);
+
+protected:
+    void processBlock(const size_t &len, float *out) override;
+    void resetBlock() override;
+
+private:
+    float m_gain;
+    float m_deemphAlpha;                                                        // Zero if there is no de-emphasis.
+    float m_deemph;
+
+};
+
+/**
+ * @brief GkDemodSsb finishes the Weaver method of SSB demodulation. The down-converter has already shifted the middle of
+ * the wanted sideband down to DC and low-pass filtered it, which rejects the opposite sideband, so all that's left is to
+ * shift it back up towards its place within the audio passband and take the real part.
+ */
+class GkDemodSsb : public GkDemodBlock {
+
+public:
+    explicit GkDemodSsb(const double &sample_rate, const double &shift_hz);
+
+protected:
+    void processBlock(const size_t &len, float *out) override;
+    void resetBlock() override;
+
+private:
+    GkDemodOscillator m_bfo;
+
+};
+
+/**
+ * @brief GkDemodCw narrows the channel down about the carrier with a fourth-order Butterworth low-pass upon both I and Q,
+ * which is a band-pass once seen from either side of DC, before beating it against the BFO so that it may be heard.
+ */
+class GkDemodCw : public GkDemodBlock {
+
+public:
+    explicit GkDemodCw(const double &sample_rate, const double &bandwidth, const double &bfo_hz);
+
+protected:
+    void processBlock(const size_t &len, float *out) override;
+    void resetBlock() override;
+
+private:
+    struct GkBiquad {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;
+        float a1 = 0.0f, a2 = 0.0f;
+        float zi1 = 0.0f, zi2 = 0.0f;                                           // Transposed direct form II state, for I...
+        float zq1 = 0.0f, zq2 = 0.0f;                                           // ... and for Q.
+    };
+
+    std::array<GkBiquad, 2> m_stages;
+    GkDemodOscillator m_bfo;
+
+    static GkBiquad designLowpass(const double &cutoff_hz, const double &sample_rate, const double &q);
+
+};
+
+/**
+ * @brief GkDemodReal simply keeps the real part, which serves for DSB and for raw IQ.
+ */
+class GkDemodReal : public GkDemodBlock {
+
+public:
+    GkDemodReal() = default;
+
+protected:
+    void processBlock(const size_t &len, float *out) override;
+    void resetBlock() override;
+
+};
+
+/**
+ * @brief GkDemodBenchmark measures how quickly each of the demodulators works through synthetic IQ upon a single core.
+ */
+class GkDemodBenchmark {
+
+public:
+    [[nodiscard]] static std::vector<GekkoFyre::System::GkSdr::GkDemodBenchResult> run(const size_t &num_samples = GK_DEMOD_BENCH_SAMPLES);
+
+};
+};
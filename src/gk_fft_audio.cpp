@@ -67,7 +67,7 @@ using namespace Logging;
 GkFFTAudio::GkFFTAudio(std::shared_ptr<std::vector<ALshort>> audioDevBuf, const GkDevice &audioDevDetails,
                        QPointer<GekkoFyre::GkAudioDevices> audioDevices, QPointer<GekkoFyre::GkSpectroWaterfall> spectroWaterfall,
                        QPointer<GekkoFyre::StringFuncs> stringFuncs, QPointer<GekkoFyre::GkEventLogger> eventLogger,
-                       QObject *parent) : QObject(parent)
+                       QObject *parent) : QObject(parent), m_useChannelAudio(false)
 {
     setParent(parent);
 
@@ -116,22 +116,76 @@ void GkFFTAudio::recordAudioStream()
     return;
 }
 
+/**
+ * @brief GkFFTAudio::recordChannelStream draws the waterfall from the audio of a channel of the digital down-converter,
+ * as handed over through GkFFTAudio::pushChannelAudio(), rather than from the audio device.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sample_rate The sample rate of the channel's audio.
+ */
+void GkFFTAudio::recordChannelStream(const qint32 &sample_rate)
+{
+    {
+        std::lock_guard<std::mutex> lck_guard(mtx_channel_audio);
+        m_channelRate = sample_rate;
+        m_channelAudio.clear();
+        m_channelAudio.reserve(static_cast<size_t>(sample_rate));
+    }
+
+    m_useChannelAudio = true;
+    emit startRecording();
+
+    return;
+}
+
 /**
  * @brief GkFFTAudio::stopRecordStream
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
  */
 void GkFFTAudio::stopRecordStream()
 {
+    m_useChannelAudio = false;
     emit stopRecording();
     return;
 }
 
+/**
+ * @brief GkFFTAudio::pushChannelAudio is fed with the audio of a channel of the digital down-converter, upon that
+ * channel's own thread. No more than a second's worth is ever held between refreshes of the waterfall, with the
+ * remainder being dropped.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param samples The channel's audio, as mono floating-point samples.
+ * @param count The number of samples.
+ */
+void GkFFTAudio::pushChannelAudio(const float *samples, const size_t &count)
+{
+    if (!m_useChannelAudio) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lck_guard(mtx_channel_audio);
+    const size_t room = m_channelAudio.capacity() - m_channelAudio.size();
+    m_channelAudio.insert(m_channelAudio.end(), samples, samples + std::min(count, room));
+
+    return;
+}
+
 /**
  * @brief GkFFTAudio::processAudioIn
  * @author Joel Svensson <http://svenssonjoel.github.io/pages/qt-audio-fft/index.html>
  */
 void GkFFTAudio::processAudioInFft()
 {
+    if (m_useChannelAudio) {
+        {
+            std::lock_guard<std::mutex> lck_guard(mtx_channel_audio);
+            std::copy(m_channelAudio.begin(), m_channelAudio.end(), std::back_inserter(audioSamples));
+            m_channelAudio.clear();
+        }
+
+        samplesUpdated();
+        return;
+    }
+
     if (mAudioDevBuf) {
         if (!mAudioDevBuf->empty()) {
             qint32 ba_num_samples = mAudioDevBuf->size() / 2;
@@ -172,11 +226,18 @@ void GkFFTAudio::refreshGraphTrue()
 void GkFFTAudio::samplesUpdated()
 {
     try {
+        if (gkSpectroWaterfall->hasSpectroProduct()) {
+            //
+            // A recorded audio file is currently being viewed, so do not overwrite it with the live audio stream!
+            audioSamples.clear();
+            return;
+        }
+
         std::vector<double> remainder;
         const auto splitAudioSamples = gkStringFuncs->chunker(audioSamples, (AUDIO_FRAMES_PER_BUFFER * 2));
         for (const auto &samples_vec: splitAudioSamples) {
             if (!samples_vec.empty()) {
-                Gist<double> fft(samples_vec.size(), gkAudioInSampleRate, WindowType::RectangularWindow);
+                Gist<double> fft(samples_vec.size(), m_useChannelAudio ? m_channelRate : gkAudioInSampleRate, WindowType::RectangularWindow);
                 fft.processAudioFrame(samples_vec);
                 magSpec = fft.getMagnitudeSpectrum();
 
@@ -49,6 +49,8 @@
 #include <boost/filesystem.hpp>
 #include <boost/exception/all.hpp>
 #include <kiss_fft.h>
+#include <mutex>
+#include <atomic>
 #include <string>
 #include <vector>
 #include <QTimer>
@@ -70,12 +72,15 @@ public:
                         QObject *parent = nullptr);
     ~GkFFTAudio() override;
 
+    void pushChannelAudio(const float *samples, const size_t &count);
+
 private slots:
     void refreshGraphTrue();
     void processAudioInFft();
 
 public slots:
     void recordAudioStream();
+    void recordChannelStream(const qint32 &sample_rate);
     void stopRecordStream();
 
 signals:
@@ -99,6 +104,13 @@ private:
     qint32 gkAudioInSampleRate = 0;
     std::vector<double> audioSamples;
 
+    //
+    // Audio handed over from a channel of the digital down-converter, in place of the audio device
+    std::mutex mtx_channel_audio;
+    std::vector<float> m_channelAudio;
+    std::atomic<bool> m_useChannelAudio;
+    qint32 m_channelRate = 0;
+
     //
     // Spectrograph
     //
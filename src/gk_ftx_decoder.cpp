@@ -0,0 +1,1597 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/gk_ftx_decoder.hpp"
+#include <set>
+#include <cmath>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <QFile>
+#include <QTextStream>
+#include <QRegularExpression>
+#include <QStringList>
+
+using namespace GekkoFyre;
+using namespace AmateurRadio;
+using namespace System;
+using namespace Events;
+using namespace Logging;
+
+namespace {
+constexpr quint32 GK_FTX_NTOKENS = 2063592;                                     // The special tokens (i.e. DE, QRZ, CQ) of a 28-bit callsign.
+constexpr quint32 GK_FTX_MAX22 = 4194304;                                       // The hashes of non-standard callsigns.
+constexpr quint32 GK_FTX_MAXGRID4 = 32400;                                      // Anything beyond a four-character locator is a report.
+constexpr quint16 GK_FTX_CRC_POLYNOMIAL = 0x2757;
+constexpr float GK_FTX_LDPC_NORM = 0.8f;                                        // The scaling of each check's message, for normalized min-sum.
+constexpr double GK_FTX_HANN_ENBW = 1.5;                                        // The equivalent noise bandwidth of a Hann window, in bins.
+
+const char gk_ftx_a1[] = " 0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+const char gk_ftx_a2[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+const char gk_ftx_a3[] = "0123456789";
+const char gk_ftx_a4[] = " ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+const char gk_ftx_text[] = " 0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ+-./?";
+
+//
+// The payload of FT4 is XOR'd with this sequence, so that a message of all zeroes still gives a varied signal
+const std::array<quint8, 10> gk_ft4_scramble = { 0x4A, 0x5E, 0x89, 0xB4, 0xB0, 0x8A, 0x79, 0x55, 0xBE, 0x28 };
+
+quint32 readBits(const quint8 *data, const size_t &offset, const size_t &num_bits)
+{
+    quint32 value = 0;
+    for (size_t i = 0; i < num_bits; ++i) {
+        const size_t pos = offset + i;
+        value = (value << 1) | ((data[pos / 8] >> (7 - (pos % 8))) & 1U);
+    }
+
+    return value;
+}
+
+void writeBits(quint8 *data, const size_t &offset, const quint32 &value, const size_t &num_bits)
+{
+    for (size_t i = 0; i < num_bits; ++i) {
+        const size_t pos = offset + i;
+        const auto mask = static_cast<quint8>(0x80U >> (pos % 8));
+        if ((value >> (num_bits - 1 - i)) & 1U) {
+            data[pos / 8] |= mask;
+        } else {
+            data[pos / 8] &= static_cast<quint8>(~mask);
+        }
+    }
+
+    return;
+}
+
+qint32 indexOf(const char *alphabet, const QChar &c)
+{
+    const char *found = std::strchr(alphabet, c.toLatin1());
+    return (c.unicode() > 0 && c.unicode() < 128 && found) ? static_cast<qint32>(found - alphabet) : -1;
+}
+}
+
+/**
+ * @brief GkFtxProtocol::toneSpacing
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The spacing between tones, in Hz, which is also the symbol rate.
+ */
+double GkFtxProtocol::toneSpacing() const
+{
+    return static_cast<double>(GK_FTX_SAMPLE_RATE) / static_cast<double>(symbol_samples);
+}
+
+/**
+ * @brief GkFtxProtocol::get
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param mode Either FT8 or FT4.
+ * @return The framing of the given mode.
+ */
+const GkFtxProtocol &GkFtxProtocol::get(const DigitalModes &mode)
+{
+    static const GkFtxProtocol ft8 = []() {
+        GkFtxProtocol protocol;
+        protocol.mode = FT8;
+        protocol.symbol_samples = 1920;
+        protocol.num_tones = 8;
+        protocol.bits_per_symbol = 3;
+        protocol.num_symbols = 79;
+        protocol.sync_positions = { 0, 36, 72 };
+        protocol.costas = { { 3, 1, 4, 0, 6, 5, 2 }, { 3, 1, 4, 0, 6, 5, 2 }, { 3, 1, 4, 0, 6, 5, 2 } };
+        for (quint32 i = 7; i < 36; ++i) { protocol.data_positions.push_back(i); }
+        for (quint32 i = 43; i < 72; ++i) { protocol.data_positions.push_back(i); }
+        protocol.gray_map = { 0, 1, 3, 2, 5, 6, 4, 7 };
+        protocol.slot_secs = 15.0;
+        protocol.start_secs = 0.5;
+        protocol.decode_secs = 13.8;
+        protocol.scrambled = false;
+        return protocol;
+    }();
+
+    static const GkFtxProtocol ft4 = []() {
+        GkFtxProtocol protocol;
+        protocol.mode = FT4;
+        protocol.symbol_samples = 576;
+        protocol.num_tones = 4;
+        protocol.bits_per_symbol = 2;
+        protocol.num_symbols = 105;                                             // A ramp symbol either side of the 103 that carry anything.
+        protocol.sync_positions = { 1, 34, 67, 100 };
+        protocol.costas = { { 0, 1, 3, 2 }, { 1, 0, 2, 3 }, { 2, 3, 1, 0 }, { 3, 2, 0, 1 } };
+        for (quint32 i = 5; i < 34; ++i) { protocol.data_positions.push_back(i); }
+        for (quint32 i = 38; i < 67; ++i) { protocol.data_positions.push_back(i); }
+        for (quint32 i = 71; i < 100; ++i) { protocol.data_positions.push_back(i); }
+        protocol.gray_map = { 0, 1, 3, 2 };
+        protocol.slot_secs = 7.5;
+        protocol.start_secs = 0.5;
+        protocol.decode_secs = 6.2;
+        protocol.scrambled = true;
+        return protocol;
+    }();
+
+    switch (mode) {
+        case FT8:
+            return ft8;
+        case FT4:
+            return ft4;
+        default:
+            break;
+    }
+
+    throw std::invalid_argument(QObject::tr("Only FT8 and FT4 may be decoded by the WSJT-style decoder!").toStdString());
+}
+
+/**
+ * @brief GkFtxLdpc::GkFtxLdpc
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+GkFtxLdpc::GkFtxLdpc() : m_mn(), m_nm(), m_nmSlot(), m_nrw()
+{
+    return;
+}
+
+/**
+ * @brief GkFtxLdpc::fromFile reads the parity checks of the code, as found within WSJT-X (where they are known as 'Mn'),
+ * being one line for each of the 174 bits with the three (1-based) checks that it takes part in.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param file_path The table of parity checks.
+ * @return The code, ready for decoding.
+ */
+std::shared_ptr<GkFtxLdpc> GkFtxLdpc::fromFile(const QFileInfo &file_path)
+{
+    try {
+        QFile file(file_path.absoluteFilePath());
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            throw std::runtime_error(QObject::tr("Unable to open the LDPC table, \"%1\": %2").arg(file_path.absoluteFilePath(), file.errorString()).toStdString());
+        }
+
+        auto ldpc = std::make_shared<GkFtxLdpc>();
+        QTextStream stream(&file);
+        quint32 bit = 0;
+        while (!stream.atEnd()) {
+            const QString line = stream.readLine().trimmed();
+            if (line.isEmpty() || line.startsWith('#')) {
+                continue;
+            }
+
+            #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+            const QStringList fields = line.split(QRegularExpression("[\\s,]+"), Qt::SkipEmptyParts);
+            #else
+            const QStringList fields = line.split(QRegularExpression("[\\s,]+"), QString::SkipEmptyParts);
+            #endif
+
+            if (bit >= GK_FTX_LDPC_N || fields.size() != GK_FTX_LDPC_COLUMN_WEIGHT) {
+                throw std::invalid_argument(QObject::tr("The LDPC table, \"%1\", must have %2 lines of %3 checks each!")
+                                                    .arg(file_path.absoluteFilePath(), QString::number(GK_FTX_LDPC_N), QString::number(GK_FTX_LDPC_COLUMN_WEIGHT)).toStdString());
+            }
+
+            for (qint32 i = 0; i < fields.size(); ++i) {
+                bool ok = false;
+                const auto check = fields.at(i).toUInt(&ok);
+                if (!ok || check < 1 || check > GK_FTX_LDPC_M) {
+                    throw std::invalid_argument(QObject::tr("The LDPC table, \"%1\", refers towards a parity check that does not exist upon line %2!")
+                                                        .arg(file_path.absoluteFilePath(), QString::number(bit + 1)).toStdString());
+                }
+
+                ldpc->m_mn[bit][i] = static_cast<quint8>(check - 1);
+            }
+
+            ++bit;
+        }
+
+        if (bit != GK_FTX_LDPC_N) {
+            throw std::invalid_argument(QObject::tr("The LDPC table, \"%1\", must have %2 lines of %3 checks each!")
+                                                .arg(file_path.absoluteFilePath(), QString::number(GK_FTX_LDPC_N), QString::number(GK_FTX_LDPC_COLUMN_WEIGHT)).toStdString());
+        }
+
+        if (!ldpc->build()) {
+            throw std::invalid_argument(QObject::tr("The LDPC table, \"%1\", does not describe a (174, 91) code whose last 83 bits are parity!")
+                                                .arg(file_path.absoluteFilePath()).toStdString());
+        }
+
+        return ldpc;
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief GkFtxLdpc::bundled
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The code of FT8 & FT4, as bundled within the application's resources.
+ */
+std::shared_ptr<GkFtxLdpc> GkFtxLdpc::bundled()
+{
+    return fromFile(QFileInfo(QString::fromUtf8(Filesystem::ftxLdpcTableFile)));
+}
+
+/**
+ * @brief GkFtxLdpc::decode runs belief propagation until every parity check is satisfied, or the iterations run out.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param llr The log-likelihood of each of the 174 bits, whereby a positive value favours a one.
+ * @param plain Where the 174 decoded bits are written, one per byte.
+ * @return The number of iterations that were needed, or -1 should decoding have failed.
+ */
+qint32 GkFtxLdpc::decode(const float *llr, quint8 *plain) const
+{
+    std::array<std::array<float, GK_FTX_LDPC_COLUMN_WEIGHT>, GK_FTX_LDPC_N> tov = {};
+    std::array<float, GK_FTX_LDPC_MAX_ROW_WEIGHT> toc = {};
+    for (qint32 iter = 0; iter <= GK_FTX_LDPC_ITERATIONS; ++iter) {
+        for (quint32 n = 0; n < GK_FTX_LDPC_N; ++n) {
+            float sum = llr[n];
+            for (const auto &msg: tov[n]) {
+                sum += msg;
+            }
+
+            plain[n] = (sum > 0.0f) ? 1 : 0;
+        }
+
+        quint32 errors = 0;
+        for (quint32 m = 0; m < GK_FTX_LDPC_M; ++m) {
+            quint8 parity = 0;
+            for (quint32 j = 0; j < m_nrw[m]; ++j) {
+                parity ^= plain[m_nm[m][j]];
+            }
+
+            errors += parity;
+        }
+
+        if (errors == 0) {
+            return iter;
+        }
+
+        if (iter == GK_FTX_LDPC_ITERATIONS) {
+            break;
+        }
+
+        //
+        // Each check is updated in turn from the latest messages of its bits (i.e. a layered schedule), which converges in
+        // around half the iterations that flooding would need
+        for (quint32 m = 0; m < GK_FTX_LDPC_M; ++m) {
+            float min1 = std::numeric_limits<float>::max();
+            float min2 = min1;
+            quint32 min_idx = 0;
+            bool negative = false;
+            for (quint32 j = 0; j < m_nrw[m]; ++j) {
+                const quint32 n = m_nm[m][j];
+                float sum = llr[n];
+                for (quint32 k = 0; k < GK_FTX_LDPC_COLUMN_WEIGHT; ++k) {
+                    if (k != m_nmSlot[m][j]) {
+                        sum += tov[n][k];
+                    }
+                }
+
+                toc[j] = sum;
+                negative ^= (sum < 0.0f);
+                const float mag = std::fabs(sum);
+                if (mag < min1) {
+                    min2 = min1;
+                    min1 = mag;
+                    min_idx = j;
+                } else if (mag < min2) {
+                    min2 = mag;
+                }
+            }
+
+            //
+            // As a positive likelihood favours a one, the sign is flipped whenever the number of other bits is even
+            const bool odd = (m_nrw[m] & 1U) != 0;
+            for (quint32 j = 0; j < m_nrw[m]; ++j) {
+                const float mag = GK_FTX_LDPC_NORM * ((j == min_idx) ? min2 : min1);
+                const bool sign = negative ^ (toc[j] < 0.0f) ^ odd;
+                tov[m_nm[m][j]][m_nmSlot[m][j]] = sign ? -mag : mag;
+            }
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief GkFtxLdpc::encode
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param message The 91 bits of the message and its CRC, one per byte.
+ * @param codeword Where the 174 bits of the codeword are written, one per byte, being the message followed by its parity.
+ */
+void GkFtxLdpc::encode(const quint8 *message, quint8 *codeword) const
+{
+    std::bitset<GK_FTX_LDPC_K> bits;
+    for (quint32 k = 0; k < GK_FTX_LDPC_K; ++k) {
+        bits[k] = (message[k] != 0);
+        codeword[k] = message[k] ? 1 : 0;
+    }
+
+    for (quint32 m = 0; m < GK_FTX_LDPC_M; ++m) {
+        codeword[GK_FTX_LDPC_K + m] = static_cast<quint8>((m_generator[m] & bits).count() & 1U);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkFtxLdpc::build derives everything else that is needed from the checks of each bit, including the generator,
+ * which is found by way of Gaussian elimination over the parity half of the checks.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return Whether the checks describe a valid code, whose last 83 bits may be used as parity.
+ */
+bool GkFtxLdpc::build()
+{
+    m_nrw.fill(0);
+    for (quint32 n = 0; n < GK_FTX_LDPC_N; ++n) {
+        for (quint32 k = 0; k < GK_FTX_LDPC_COLUMN_WEIGHT; ++k) {
+            const quint8 m = m_mn[n][k];
+            for (quint32 j = 0; j < k; ++j) {
+                if (m_mn[n][j] == m) {
+                    return false;
+                }
+            }
+
+            if (m_nrw[m] >= GK_FTX_LDPC_MAX_ROW_WEIGHT) {
+                return false;
+            }
+
+            m_nm[m][m_nrw[m]] = static_cast<quint8>(n);
+            m_nmSlot[m][m_nrw[m]] = static_cast<quint8>(k);
+            ++m_nrw[m];
+        }
+    }
+
+    //
+    // Each row holds the parity bits within its first 83 columns and the message bits thereafter, so that once the parity
+    // half is reduced towards the identity, each row gives a parity bit as a sum of message bits
+    std::vector<std::bitset<GK_FTX_LDPC_N>> rows(GK_FTX_LDPC_M);
+    for (quint32 n = 0; n < GK_FTX_LDPC_N; ++n) {
+        const quint32 col = (n >= GK_FTX_LDPC_K) ? (n - GK_FTX_LDPC_K) : (n + GK_FTX_LDPC_M);
+        for (const auto &m: m_mn[n]) {
+            rows[m][col] = true;
+        }
+    }
+
+    for (quint32 col = 0; col < GK_FTX_LDPC_M; ++col) {
+        quint32 pivot = col;
+        while (pivot < GK_FTX_LDPC_M && !rows[pivot][col]) {
+            ++pivot;
+        }
+
+        if (pivot == GK_FTX_LDPC_M) {
+            return false;
+        }
+
+        std::swap(rows[col], rows[pivot]);
+        for (quint32 m = 0; m < GK_FTX_LDPC_M; ++m) {
+            if (m != col && rows[m][col]) {
+                rows[m] ^= rows[col];
+            }
+        }
+    }
+
+    for (quint32 m = 0; m < GK_FTX_LDPC_M; ++m) {
+        m_generator[m].reset();
+        for (quint32 k = 0; k < GK_FTX_LDPC_K; ++k) {
+            m_generator[m][k] = rows[m][GK_FTX_LDPC_M + k];
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief GkFtxMessage::unpack
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param payload The 77 bits of the message, packed into ten bytes.
+ * @return The message as text, or an empty string should it not be valid.
+ */
+QString GkFtxMessage::unpack(const quint8 *payload)
+{
+    const quint32 i3 = readBits(payload, 74, 3);
+    if (i3 == 1 || i3 == 2) {
+        //
+        // A standard message, being two callsigns (either of which may instead be CQ, QRZ or DE) and then a grid locator,
+        // report or acknowledgement
+        const quint32 n29a = readBits(payload, 0, 29);
+        const quint32 n29b = readBits(payload, 29, 29);
+        const bool ir = readBits(payload, 58, 1);
+        const quint32 igrid4 = readBits(payload, 59, 15);
+
+        QString call_1 = unpackCall(n29a >> 1);
+        QString call_2 = unpackCall(n29b >> 1);
+        if (call_1.isEmpty() || call_2.isEmpty()) {
+            return QString();
+        }
+
+        const QString suffix = (i3 == 1) ? QStringLiteral("/R") : QStringLiteral("/P");
+        if ((n29a & 1U) && !call_1.startsWith('<')) {
+            call_1 += suffix;
+        }
+
+        if ((n29b & 1U) && !call_2.startsWith('<')) {
+            call_2 += suffix;
+        }
+
+        QString extra;
+        if (igrid4 <= GK_FTX_MAXGRID4) {
+            quint32 n = igrid4;
+            QString grid(4, ' ');
+            grid[3] = QChar('0' + static_cast<char>(n % 10));
+            n /= 10;
+            grid[2] = QChar('0' + static_cast<char>(n % 10));
+            n /= 10;
+            grid[1] = QChar('A' + static_cast<char>(n % 18));
+            n /= 18;
+            grid[0] = QChar('A' + static_cast<char>(n % 18));
+            extra = ir ? QStringLiteral("R ") + grid : grid;
+        } else {
+            const qint32 irpt = static_cast<qint32>(igrid4 - GK_FTX_MAXGRID4);
+            switch (irpt) {
+                case 1:
+                    break;
+                case 2:
+                    extra = QStringLiteral("RRR");
+                    break;
+                case 3:
+                    extra = QStringLiteral("RR73");
+                    break;
+                case 4:
+                    extra = QStringLiteral("73");
+                    break;
+                default:
+                {
+                    const qint32 report = irpt - 35;
+                    extra = QString("%1%2%3").arg(ir ? QStringLiteral("R") : QString(), (report < 0) ? QStringLiteral("-") : QStringLiteral("+"))
+                            .arg(std::abs(report), 2, 10, QChar('0'));
+                    break;
+                }
+            }
+        }
+
+        return QString("%1 %2 %3").arg(call_1, call_2, extra).trimmed();
+    }
+
+    const quint32 n3 = readBits(payload, 71, 3);
+    if (i3 == 0 && n3 == 0) {
+        return unpackText(payload);
+    }
+
+    //
+    // Such messages as those for DXpeditions, contests and non-standard callsigns are not (yet) unpacked
+    if (i3 == 0) {
+        return QObject::tr("[Message of type %1.%2]").arg(QString::number(i3), QString::number(n3));
+    }
+
+    return QObject::tr("[Message of type %1]").arg(QString::number(i3));
+}
+
+/**
+ * @brief GkFtxMessage::pack packs a standard message, such as those that make up the bulk of any QSO.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param message The message, such as "CQ K1ABC FN42" or "K1ABC W9XYZ R-09".
+ * @param payload Where the 77 bits of the message are written, packed into ten bytes.
+ * @return Whether the message could be packed.
+ */
+bool GkFtxMessage::pack(const QString &message, quint8 *payload)
+{
+    #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    const QStringList fields = message.toUpper().split(' ', Qt::SkipEmptyParts);
+    #else
+    const QStringList fields = message.toUpper().split(' ', QString::SkipEmptyParts);
+    #endif
+
+    if (fields.size() < 2 || fields.size() > 3) {
+        return false;
+    }
+
+    quint32 n28a = 0;
+    quint32 n28b = 0;
+    if (!packCall(fields.at(0), n28a) || !packCall(fields.at(1), n28b) || n28b < GK_FTX_NTOKENS) {
+        return false;
+    }
+
+    bool ir = false;
+    quint32 igrid4 = GK_FTX_MAXGRID4 + 1;
+    if (fields.size() == 3) {
+        QString extra = fields.at(2);
+        if (extra == QStringLiteral("RRR")) {
+            igrid4 = GK_FTX_MAXGRID4 + 2;
+        } else if (extra == QStringLiteral("RR73")) {
+            igrid4 = GK_FTX_MAXGRID4 + 3;
+        } else if (extra == QStringLiteral("73")) {
+            igrid4 = GK_FTX_MAXGRID4 + 4;
+        } else if (extra.size() == 4 && extra.at(0) >= 'A' && extra.at(0) <= 'R' && extra.at(1) >= 'A' && extra.at(1) <= 'R' &&
+                   extra.at(2).isDigit() && extra.at(3).isDigit()) {
+            igrid4 = (((static_cast<quint32>(extra.at(0).unicode() - 'A') * 18 + static_cast<quint32>(extra.at(1).unicode() - 'A')) * 10 +
+                    static_cast<quint32>(extra.at(2).digitValue())) * 10) + static_cast<quint32>(extra.at(3).digitValue());
+        } else {
+            if (extra.startsWith('R')) {
+                ir = true;
+                extra.remove(0, 1);
+            }
+
+            bool ok = false;
+            const qint32 report = extra.toInt(&ok);
+            if (!ok || (extra.at(0) != '+' && extra.at(0) != '-') || report < -30 || report > 49) {
+                return false;
+            }
+
+            igrid4 = GK_FTX_MAXGRID4 + static_cast<quint32>(report + 35);
+        }
+    }
+
+    std::memset(payload, 0, 10);
+    writeBits(payload, 0, n28a << 1, 29);
+    writeBits(payload, 29, n28b << 1, 29);
+    writeBits(payload, 58, ir ? 1 : 0, 1);
+    writeBits(payload, 59, igrid4, 15);
+    writeBits(payload, 74, 1, 3);
+
+    return true;
+}
+
+/**
+ * @brief GkFtxMessage::toTones gives the tone of every symbol for the given message, from which it may be transmitted.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param protocol Whether FT8 or FT4.
+ * @param ldpc The code by which the message is to be protected.
+ * @param message A standard message.
+ * @param tones Where the tones are written.
+ * @return Whether the message could be packed.
+ */
+bool GkFtxMessage::toTones(const GkFtxProtocol &protocol, const GkFtxLdpc &ldpc, const QString &message, std::vector<quint8> &tones)
+{
+    std::array<quint8, 10> payload = {};
+    if (!pack(message, payload.data())) {
+        return false;
+    }
+
+    if (protocol.scrambled) {
+        for (size_t i = 0; i < payload.size(); ++i) {
+            payload[i] ^= gk_ft4_scramble[i];
+        }
+    }
+
+    std::array<quint8, 12> a91 = {};
+    addCrc(payload.data(), a91.data());
+
+    std::array<quint8, GK_FTX_LDPC_K> bits = {};
+    for (quint32 k = 0; k < GK_FTX_LDPC_K; ++k) {
+        bits[k] = static_cast<quint8>(readBits(a91.data(), k, 1));
+    }
+
+    std::array<quint8, GK_FTX_LDPC_N> codeword = {};
+    ldpc.encode(bits.data(), codeword.data());
+
+    tones.assign(protocol.num_symbols, 0);
+    for (size_t i = 0; i < protocol.sync_positions.size(); ++i) {
+        for (size_t k = 0; k < protocol.costas[i].size(); ++k) {
+            tones[protocol.sync_positions[i] + k] = protocol.costas[i][k];
+        }
+    }
+
+    size_t idx = 0;
+    for (const auto &pos: protocol.data_positions) {
+        quint32 value = 0;
+        for (quint32 b = 0; b < protocol.bits_per_symbol; ++b) {
+            value = (value << 1) | codeword[idx++];
+        }
+
+        tones[pos] = protocol.gray_map[value];
+    }
+
+    return true;
+}
+
+/**
+ * @brief GkFtxMessage::crc14
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param data The bits to be checked, most significant first.
+ * @param num_bits The number of bits to be checked.
+ * @return The 14-bit CRC of the given bits.
+ */
+quint16 GkFtxMessage::crc14(const quint8 *data, const size_t &num_bits)
+{
+    constexpr quint16 top_bit = (1U << 13);
+    quint16 remainder = 0;
+    for (size_t i = 0; i < num_bits; ++i) {
+        if ((i % 8) == 0) {
+            remainder ^= static_cast<quint16>(data[i / 8] << 6);
+        }
+
+        remainder = (remainder & top_bit) ? static_cast<quint16>((remainder << 1) ^ GK_FTX_CRC_POLYNOMIAL) : static_cast<quint16>(remainder << 1);
+    }
+
+    return remainder & static_cast<quint16>((top_bit << 1) - 1);
+}
+
+/**
+ * @brief GkFtxMessage::addCrc
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param payload The 77 bits of the message, packed into ten bytes.
+ * @param a91 Where the message and its CRC are written, packed into twelve bytes.
+ */
+void GkFtxMessage::addCrc(const quint8 *payload, quint8 *a91)
+{
+    //
+    // The CRC is taken over the message as padded out towards 82 bits
+    std::memcpy(a91, payload, 10);
+    a91[9] &= 0xF8;
+    a91[10] = 0;
+    a91[11] = 0;
+
+    const quint16 crc = crc14(a91, 82);
+    a91[9] |= static_cast<quint8>(crc >> 11);
+    a91[10] = static_cast<quint8>(crc >> 3);
+    a91[11] = static_cast<quint8>(crc << 5);
+
+    return;
+}
+
+/**
+ * @brief GkFtxMessage::checkCrc
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param a91 The message and its CRC, packed into twelve bytes.
+ * @return Whether the CRC matches the message.
+ */
+bool GkFtxMessage::checkCrc(const quint8 *a91)
+{
+    const auto received = static_cast<quint16>(((a91[9] & 0x07) << 11) | (a91[10] << 3) | (a91[11] >> 5));
+    std::array<quint8, 12> padded = {};
+    std::memcpy(padded.data(), a91, 10);
+    padded[9] &= 0xF8;
+
+    return crc14(padded.data(), 82) == received;
+}
+
+/**
+ * @brief GkFtxMessage::unpackCall
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param n28 A callsign, as packed into 28 bits.
+ * @return The callsign, or an empty string should it not be valid.
+ */
+QString GkFtxMessage::unpackCall(const quint32 &n28)
+{
+    if (n28 < GK_FTX_NTOKENS) {
+        if (n28 == 0) {
+            return QStringLiteral("DE");
+        } else if (n28 == 1) {
+            return QStringLiteral("QRZ");
+        } else if (n28 == 2) {
+            return QStringLiteral("CQ");
+        } else if (n28 <= 1002) {
+            return QString("CQ %1").arg(n28 - 3, 3, 10, QChar('0'));
+        } else if (n28 <= 532443) {
+            quint32 n = n28 - 1003;
+            QString directed(4, ' ');
+            for (qint32 i = 3; i >= 0; --i) {
+                directed[i] = QChar(gk_ftx_a4[n % 27]);
+                n /= 27;
+            }
+
+            return QString("CQ %1").arg(directed.trimmed());
+        }
+
+        return QString();
+    }
+
+    if ((n28 - GK_FTX_NTOKENS) < GK_FTX_MAX22) {
+        //
+        // A hash of a callsign that was sent in full within an earlier message, which is not (yet) remembered
+        return QStringLiteral("<...>");
+    }
+
+    quint32 n = n28 - GK_FTX_NTOKENS - GK_FTX_MAX22;
+    QString call(6, ' ');
+    call[5] = QChar(gk_ftx_a4[n % 27]);
+    n /= 27;
+    call[4] = QChar(gk_ftx_a4[n % 27]);
+    n /= 27;
+    call[3] = QChar(gk_ftx_a4[n % 27]);
+    n /= 27;
+    call[2] = QChar(gk_ftx_a3[n % 10]);
+    n /= 10;
+    call[1] = QChar(gk_ftx_a2[n % 36]);
+    n /= 36;
+    if (n >= 37) {
+        return QString();
+    }
+
+    call[0] = QChar(gk_ftx_a1[n]);
+    return call.trimmed();
+}
+
+/**
+ * @brief GkFtxMessage::packCall
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param call A standard callsign, or either of CQ, QRZ or DE.
+ * @param n28 Where the callsign, as packed into 28 bits, is written.
+ * @return Whether the callsign could be packed.
+ */
+bool GkFtxMessage::packCall(const QString &call, quint32 &n28)
+{
+    if (call == QStringLiteral("DE")) {
+        n28 = 0;
+        return true;
+    } else if (call == QStringLiteral("QRZ")) {
+        n28 = 1;
+        return true;
+    } else if (call == QStringLiteral("CQ")) {
+        n28 = 2;
+        return true;
+    }
+
+    //
+    // The digit of a standard callsign always lies third, so those with but a single character before it are padded
+    QString padded = call;
+    if (padded.size() >= 3 && padded.at(2).isDigit()) {
+        // Nothing to be done...
+    } else if (padded.size() >= 2 && padded.at(1).isDigit()) {
+        padded.prepend(' ');
+    } else {
+        return false;
+    }
+
+    if (padded.size() > 6) {
+        return false;
+    }
+
+    padded = padded.leftJustified(6, ' ');
+    const qint32 i1 = indexOf(gk_ftx_a1, padded.at(0));
+    const qint32 i2 = indexOf(gk_ftx_a2, padded.at(1));
+    const qint32 i3 = indexOf(gk_ftx_a3, padded.at(2));
+    const qint32 i4 = indexOf(gk_ftx_a4, padded.at(3));
+    const qint32 i5 = indexOf(gk_ftx_a4, padded.at(4));
+    const qint32 i6 = indexOf(gk_ftx_a4, padded.at(5));
+    if (i1 < 0 || i2 < 0 || i3 < 0 || i4 < 0 || i5 < 0 || i6 < 0) {
+        return false;
+    }
+
+    quint32 n = static_cast<quint32>(i1);
+    n = n * 36 + static_cast<quint32>(i2);
+    n = n * 10 + static_cast<quint32>(i3);
+    n = n * 27 + static_cast<quint32>(i4);
+    n = n * 27 + static_cast<quint32>(i5);
+    n = n * 27 + static_cast<quint32>(i6);
+    n28 = n + GK_FTX_NTOKENS + GK_FTX_MAX22;
+
+    return true;
+}
+
+/**
+ * @brief GkFtxMessage::unpackText
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param payload The 77 bits of the message, packed into ten bytes.
+ * @return The up to 13 characters of free text.
+ */
+QString GkFtxMessage::unpackText(const quint8 *payload)
+{
+    //
+    // The text is a single 71-bit number in base 42, so it is shifted down into nine bytes and then divided out
+    std::array<quint8, 9> number = {};
+    for (size_t i = 0; i < number.size(); ++i) {
+        number[i] = static_cast<quint8>((payload[i] >> 1) | ((i > 0) ? ((payload[i - 1] & 1U) << 7) : 0));
+    }
+
+    QString text(13, ' ');
+    for (qint32 idx = 12; idx >= 0; --idx) {
+        quint32 remainder = 0;
+        for (auto &byte: number) {
+            const quint32 current = (remainder << 8) | byte;
+            byte = static_cast<quint8>(current / 42);
+            remainder = current % 42;
+        }
+
+        text[idx] = QChar(gk_ftx_text[remainder]);
+    }
+
+    return text.trimmed();
+}
+
+/**
+ * @brief GkFtxDecoder::GkFtxDecoder
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param mode Either FT8 or FT4.
+ * @param ldpc The LDPC code of FT8 & FT4.
+ * @param eventLogger The event logging class.
+ * @param num_threads The number of threads that each slot is decoded upon, including the decoder's own, or zero for as
+ * many as there are cores.
+ * @param parent The parent object to this class.
+ */
+GkFtxDecoder::GkFtxDecoder(const DigitalModes &mode, std::shared_ptr<GkFtxLdpc> ldpc, QPointer<GkEventLogger> eventLogger,
+                           const quint32 &num_threads, QObject *parent)
+    : QObject(parent), m_protocol(GkFtxProtocol::get(mode)), m_fftCfg(nullptr, [](void *cfg) { kiss_fft_free(cfg); }),
+      m_channels(1), m_maxFrames(0), m_ringMask(0), m_written(0), m_slotStartMs(-1), m_configured(false),
+      m_freeSlots(GK_FTX_SLOT_BUFFERS), m_filledSlots(GK_FTX_SLOT_BUFFERS), m_droppedSlots(0), m_running(false)
+{
+    m_ldpc = std::move(ldpc);
+    gkEventLogger = std::move(eventLogger);
+
+    //
+    // The calling thread lends a hand whilst waiting upon the pool, so the pool itself needs one thread fewer
+    const quint32 threads = (num_threads > 0) ? num_threads : std::max(1U, std::thread::hardware_concurrency());
+    if (threads > 1) {
+        m_pool = std::make_unique<GkWorkStealingPool>(threads - 1);
+    }
+
+    m_nfft = m_protocol.symbol_samples * GK_FTX_FREQ_OSR;
+    m_step = m_protocol.symbol_samples / GK_FTX_TIME_OSR;
+    m_window.resize(m_nfft);
+    for (quint32 i = 0; i < m_nfft; ++i) {
+        m_window[i] = static_cast<float>((0.5 - 0.5 * std::cos((2.0 * M_PI * i) / m_nfft)) / m_nfft);
+    }
+
+    m_fftCfg.reset(kiss_fft_alloc(static_cast<int>(m_nfft), 0, nullptr, nullptr));
+
+    return;
+}
+
+GkFtxDecoder::~GkFtxDecoder()
+{
+    stop();
+}
+
+/**
+ * @brief GkFtxDecoder::configure readies the decoder for the captured audio, which must be done before the capture
+ * thread begins calling GkFtxDecoder::process().
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param input_rate The sample rate of the captured audio.
+ * @param channels The number of interleaved channels within the captured audio.
+ * @param max_frames The most frames that will ever be given at once.
+ */
+void GkFtxDecoder::configure(const quint32 &input_rate, const quint16 &channels, const size_t &max_frames)
+{
+    m_configured = false;
+    m_channels = std::max<quint16>(1, channels);
+    m_maxFrames = std::max<size_t>(1, max_frames);
+    m_resampler.configure(input_rate, GK_FTX_SAMPLE_RATE);
+    m_mono.assign(m_maxFrames, 0.0f);
+    m_resampled.assign(m_resampler.maxOutput(m_maxFrames), 0.0f);
+
+    //
+    // The ring holds at least two slots, so that the whole of a slot is still there however late it is handed over
+    size_t ring_size = 1;
+    while (ring_size < static_cast<size_t>(2.0 * m_protocol.slot_secs * GK_FTX_SAMPLE_RATE)) {
+        ring_size <<= 1;
+    }
+
+    m_ring.assign(ring_size, 0.0f);
+    m_ringMask = ring_size - 1;
+    m_written = 0;
+    m_slotStartMs = -1;
+
+    GkFtxSlot *slot = nullptr;
+    while (m_freeSlots.pop(slot)) {}
+    while (m_filledSlots.pop(slot)) {}
+    m_slots.clear();
+
+    const auto slot_samples = static_cast<size_t>(std::ceil(m_protocol.decode_secs * GK_FTX_SAMPLE_RATE));
+    for (quint32 i = 0; i < GK_FTX_SLOT_BUFFERS; ++i) {
+        auto pooled = std::make_unique<GkFtxSlot>();
+        pooled->audio.assign(slot_samples, 0.0f);
+        pooled->count = 0;
+        pooled->start_ms = 0;
+        m_freeSlots.push(pooled.get());
+        m_slots.push_back(std::move(pooled));
+    }
+
+    m_configured = true;
+
+    return;
+}
+
+/**
+ * @brief GkFtxDecoder::process is fed with the captured audio, upon the capture thread, and never allocates. Once the
+ * decoding point of a slot has been reached, the slot is copied out of the ring and handed over towards the decoder.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param samples The captured audio, as interleaved 16-bit integers.
+ * @param frames The number of frames (i.e. samples per channel) that were captured.
+ */
+void GkFtxDecoder::process(const qint16 *samples, const size_t &frames)
+{
+    if (!m_configured) {
+        return;
+    }
+
+    size_t offset = 0;
+    const float scale = 1.0f / (32768.0f * static_cast<float>(m_channels));
+    while (offset < frames) {
+        const size_t count = std::min(frames - offset, m_maxFrames);
+        const qint16 *in = samples + (offset * m_channels);
+        for (size_t i = 0; i < count; ++i) {
+            qint32 sum = 0;
+            for (quint16 ch = 0; ch < m_channels; ++ch) {
+                sum += in[i * m_channels + ch];
+            }
+
+            m_mono[i] = static_cast<float>(sum) * scale;
+        }
+
+        const size_t num_out = m_resampler.process(m_mono.data(), count, m_resampled.data());
+        for (size_t i = 0; i < num_out; ++i) {
+            m_ring[(m_written + i) & m_ringMask] = m_resampled[i];
+        }
+
+        m_written += num_out;
+        offset += count;
+    }
+
+    const qint64 now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    const auto slot_ms = static_cast<qint64>(std::llround(m_protocol.slot_secs * 1000.0));
+    if (m_slotStartMs < 0) {
+        m_slotStartMs = (now_ms / slot_ms) * slot_ms;
+    }
+
+    if (now_ms < (m_slotStartMs + static_cast<qint64>(std::llround(m_protocol.decode_secs * 1000.0)))) {
+        return;
+    }
+
+    GkFtxSlot *slot = nullptr;
+    if (m_freeSlots.pop(slot)) {
+        //
+        // Whatever was not captured (such as before the capture began) is left silent
+        const auto since_start = ((now_ms - m_slotStartMs) * GK_FTX_SAMPLE_RATE) / 1000;
+        const auto first = static_cast<qint64>(m_written) - since_start;
+        const auto oldest = static_cast<qint64>(m_written) - static_cast<qint64>(m_ring.size());
+        for (size_t i = 0; i < slot->audio.size(); ++i) {
+            const qint64 pos = first + static_cast<qint64>(i);
+            slot->audio[i] = (pos >= 0 && pos >= oldest && pos < static_cast<qint64>(m_written)) ? m_ring[static_cast<size_t>(pos) & m_ringMask] : 0.0f;
+        }
+
+        slot->count = slot->audio.size();
+        slot->start_ms = m_slotStartMs;
+        m_filledSlots.push(std::move(slot));
+    } else {
+        ++m_droppedSlots;
+    }
+
+    m_slotStartMs = ((now_ms / slot_ms) + 1) * slot_ms;
+
+    return;
+}
+
+/**
+ * @brief GkFtxDecoder::decodeSlot decodes every signal that can be found within a slot of audio, upon the calling thread
+ * along with the pool.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param audio The audio of the slot, at GK_FTX_SAMPLE_RATE and beginning at the very start of the slot.
+ * @param count The number of samples within `audio`.
+ * @param slot_start The UTC time at which the slot began.
+ * @param num_candidates Where the number of candidates that were attempted is written, if wanted.
+ * @return Each message that was decoded, in order of frequency.
+ */
+QList<GkFtxDecode> GkFtxDecoder::decodeSlot(const float *audio, const size_t &count, const QDateTime &slot_start,
+                                            quint32 *num_candidates)
+{
+    GkFtxWaterfall waterfall;
+    computeWaterfall(audio, count, waterfall);
+    const auto candidates = findCandidates(waterfall);
+    if (num_candidates) {
+        *num_candidates = static_cast<quint32>(candidates.size());
+    }
+
+    std::vector<GkFtxDecode> results(candidates.size());
+    std::vector<quint8> decoded(candidates.size(), 0);
+    forEach(candidates.size(), [&](const size_t &i) {
+        decoded[i] = decodeCandidate(waterfall, candidates[i], results[i]) ? 1 : 0;
+    });
+
+    //
+    // The same signal may well be found more than once (i.e. a tone or step either way), so only the candidate with the
+    // strongest sync is kept for each message
+    std::set<QString> seen;
+    QList<GkFtxDecode> decodes;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (decoded[i] && seen.insert(results[i].message).second) {
+            results[i].slot_start = slot_start;
+            decodes.push_back(results[i]);
+        }
+    }
+
+    std::sort(decodes.begin(), decodes.end(), [](const GkFtxDecode &a, const GkFtxDecode &b) { return a.freq_hz < b.freq_hz; });
+
+    return decodes;
+}
+
+/**
+ * @brief GkFtxDecoder::getProtocol
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The framing of whichever mode is being decoded.
+ */
+const GkFtxProtocol &GkFtxDecoder::getProtocol() const
+{
+    return m_protocol;
+}
+
+/**
+ * @brief GkFtxDecoder::start begins decoding each slot as it is handed over from the capture thread.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkFtxDecoder::start()
+{
+    if (m_running) {
+        return;
+    }
+
+    m_running = true;
+    decoderThread = std::thread(&GkFtxDecoder::run, this);
+
+    return;
+}
+
+/**
+ * @brief GkFtxDecoder::stop
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkFtxDecoder::stop()
+{
+    m_running = false;
+    if (decoderThread.joinable()) {
+        decoderThread.join();
+    }
+
+    return;
+}
+
+/**
+ * @brief GkFtxDecoder::run is the decoder's thread, which decodes each slot that has been handed over.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkFtxDecoder::run()
+{
+    const QString mode_name = (m_protocol.mode == FT4) ? QStringLiteral("FT4") : QStringLiteral("FT8");
+    while (m_running) {
+        const quint64 dropped = m_droppedSlots.exchange(0);
+        if (dropped > 0) {
+            if (gkEventLogger) {
+                gkEventLogger->publishEvent(tr("%1 slot(s) of %2 were skipped, as the decoder could not keep up!").arg(QString::number(dropped), mode_name),
+                                            GkSeverity::Warning, "", false, true, false, false, false);
+            }
+        }
+
+        GkFtxSlot *slot = nullptr;
+        if (!m_filledSlots.pop(slot)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(GK_FTX_DECODER_IDLE_MILLISECS));
+            continue;
+        }
+
+        try {
+            const auto decodes = decodeSlot(slot->audio.data(), slot->count, QDateTime::fromMSecsSinceEpoch(slot->start_ms, Qt::UTC));
+            if (!decodes.isEmpty()) {
+                emit slotDecoded(decodes);
+            }
+        } catch (const std::exception &e) {
+            if (gkEventLogger) {
+                gkEventLogger->publishEvent(tr("Unable to decode a slot of %1: %2").arg(mode_name, QString::fromStdString(e.what())),
+                                            GkSeverity::Error, "", false, true, false, false, false);
+            }
+        }
+
+        m_freeSlots.push(std::move(slot));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkFtxDecoder::forEach runs the given task for every index, spread across the pool.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param count The number of indices.
+ * @param task What is to be done for each index.
+ */
+void GkFtxDecoder::forEach(const size_t &count, const std::function<void(const size_t &)> &task)
+{
+    if (!m_pool) {
+        for (size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        m_pool->submit([&task, i]() { task(i); });
+    }
+
+    m_pool->wait();
+
+    return;
+}
+
+/**
+ * @brief GkFtxDecoder::computeWaterfall takes the power spectrum of the slot at every half symbol, with bins at half the
+ * tone spacing, covering only those frequencies that are searched.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param audio The audio of the slot.
+ * @param count The number of samples within `audio`.
+ * @param waterfall Where the waterfall is written.
+ */
+void GkFtxDecoder::computeWaterfall(const float *audio, const size_t &count, GkFtxWaterfall &waterfall)
+{
+    const double bin_hz = m_protocol.toneSpacing() / GK_FTX_FREQ_OSR;
+    const auto max_bin = static_cast<qint32>(std::ceil(GK_FTX_MAX_FREQ_HZ / bin_hz)) + static_cast<qint32>(GK_FTX_FREQ_OSR * m_protocol.num_tones) + 1;
+    waterfall.num_bins = std::min(max_bin, static_cast<qint32>(m_nfft / 2));
+    waterfall.num_steps = (count >= m_nfft) ? static_cast<qint32>(((count - m_nfft) / m_step) + 1) : 0;
+    waterfall.mag.assign(static_cast<size_t>(waterfall.num_steps) * static_cast<size_t>(waterfall.num_bins), 0.0f);
+
+    constexpr qint32 steps_per_task = 8;
+    const auto num_tasks = static_cast<size_t>((waterfall.num_steps + steps_per_task - 1) / steps_per_task);
+    forEach(num_tasks, [&](const size_t &task) {
+        std::vector<kiss_fft_cpx> fft_in(m_nfft);
+        std::vector<kiss_fft_cpx> fft_out(m_nfft);
+        const auto first = static_cast<qint32>(task) * steps_per_task;
+        const auto last = std::min(first + steps_per_task, waterfall.num_steps);
+        for (qint32 step = first; step < last; ++step) {
+            const float *frame = audio + static_cast<size_t>(step) * m_step;
+            for (quint32 i = 0; i < m_nfft; ++i) {
+                fft_in[i].r = frame[i] * m_window[i];
+                fft_in[i].i = 0.0f;
+            }
+
+            kiss_fft(m_fftCfg.get(), fft_in.data(), fft_out.data());
+            float *row = &waterfall.mag[static_cast<size_t>(step) * static_cast<size_t>(waterfall.num_bins)];
+            for (qint32 bin = 0; bin < waterfall.num_bins; ++bin) {
+                const float power = (fft_out[bin].r * fft_out[bin].r) + (fft_out[bin].i * fft_out[bin].i);
+                row[bin] = 10.0f * std::log10(power + 1e-20f);
+            }
+        }
+    });
+
+    //
+    // The median of the whole waterfall is nigh on all noise however crowded the slot, and the mean of the noise's power
+    // lies ln(2) above its median
+    if (!waterfall.mag.empty()) {
+        std::vector<float> sorted(waterfall.mag);
+        auto middle = sorted.begin() + static_cast<std::ptrdiff_t>(sorted.size() / 2);
+        std::nth_element(sorted.begin(), middle, sorted.end());
+        waterfall.noise_db = *middle + static_cast<float>(10.0 * std::log10(1.0 / M_LN2));
+    } else {
+        waterfall.noise_db = 0.0f;
+    }
+
+    return;
+}
+
+/**
+ * @brief GkFtxDecoder::findCandidates scores the sync of every time step and frequency bin across the search range, and
+ * keeps the best of those that are local maxima.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param waterfall The waterfall of the slot.
+ * @return The candidates, strongest first.
+ */
+std::vector<GkFtxDecoder::GkFtxCandidate> GkFtxDecoder::findCandidates(const GkFtxWaterfall &waterfall)
+{
+    const double bin_hz = m_protocol.toneSpacing() / GK_FTX_FREQ_OSR;
+    const double half_symbol = m_protocol.symbol_samples / 2.0;
+    const auto min_step = static_cast<qint32>(std::floor((((m_protocol.start_secs + GK_FTX_MIN_DT_SECS) * GK_FTX_SAMPLE_RATE) - half_symbol) / m_step));
+    const auto max_step = static_cast<qint32>(std::ceil((((m_protocol.start_secs + GK_FTX_MAX_DT_SECS) * GK_FTX_SAMPLE_RATE) - half_symbol) / m_step));
+    const auto min_bin = std::max(1, static_cast<qint32>(GK_FTX_MIN_FREQ_HZ / bin_hz));
+    const auto max_bin = std::min(static_cast<qint32>(GK_FTX_MAX_FREQ_HZ / bin_hz),
+                                  waterfall.num_bins - 1 - static_cast<qint32>(GK_FTX_FREQ_OSR * (m_protocol.num_tones - 1)));
+    if (max_bin < min_bin || waterfall.num_steps == 0) {
+        return std::vector<GkFtxCandidate>();
+    }
+
+    const qint32 num_t = max_step - min_step + 1;
+    const qint32 num_k = max_bin - min_bin + 1;
+    std::vector<float> scores(static_cast<size_t>(num_t) * static_cast<size_t>(num_k), 0.0f);
+
+    constexpr qint32 bins_per_task = 64;
+    forEach(static_cast<size_t>((num_k + bins_per_task - 1) / bins_per_task), [&](const size_t &task) {
+        const auto first = static_cast<qint32>(task) * bins_per_task;
+        const auto last = std::min(first + bins_per_task, num_k);
+        for (qint32 t = 0; t < num_t; ++t) {
+            for (qint32 k = first; k < last; ++k) {
+                scores[static_cast<size_t>(t) * num_k + k] = syncScore(waterfall, min_step + t, min_bin + k);
+            }
+        }
+    });
+
+    std::vector<GkFtxCandidate> candidates;
+    for (qint32 t = 0; t < num_t; ++t) {
+        for (qint32 k = 0; k < num_k; ++k) {
+            const float score = scores[static_cast<size_t>(t) * num_k + k];
+            if (score < GK_FTX_MIN_SYNC_SCORE) {
+                continue;
+            }
+
+            bool peak = true;
+            for (qint32 dt = -1; dt <= 1 && peak; ++dt) {
+                for (qint32 dk = -1; dk <= 1 && peak; ++dk) {
+                    const qint32 tt = t + dt;
+                    const qint32 kk = k + dk;
+                    if ((dt != 0 || dk != 0) && tt >= 0 && tt < num_t && kk >= 0 && kk < num_k) {
+                        peak = (score >= scores[static_cast<size_t>(tt) * num_k + kk]);
+                    }
+                }
+            }
+
+            if (peak) {
+                candidates.push_back({ score, min_step + t, min_bin + k });
+            }
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const GkFtxCandidate &a, const GkFtxCandidate &b) { return a.score > b.score; });
+    if (candidates.size() > GK_FTX_MAX_CANDIDATES) {
+        candidates.resize(GK_FTX_MAX_CANDIDATES);
+    }
+
+    return candidates;
+}
+
+/**
+ * @brief GkFtxDecoder::syncScore compares each tone of the Costas arrays against its neighbours in frequency and time.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param waterfall The waterfall of the slot.
+ * @param time_step The step upon which the first symbol would be centred.
+ * @param freq_bin The bin of the lowest tone.
+ * @return How far the tones of the Costas arrays stand above their neighbours, on average, in dB.
+ */
+float GkFtxDecoder::syncScore(const GkFtxWaterfall &waterfall, const qint32 &time_step, const qint32 &freq_bin) const
+{
+    float score = 0.0f;
+    qint32 num = 0;
+    const auto at = [&waterfall](const qint32 &t, const qint32 &k) {
+        return waterfall.mag[static_cast<size_t>(t) * static_cast<size_t>(waterfall.num_bins) + static_cast<size_t>(k)];
+    };
+
+    for (size_t i = 0; i < m_protocol.sync_positions.size(); ++i) {
+        const auto &costas = m_protocol.costas[i];
+        for (size_t j = 0; j < costas.size(); ++j) {
+            const qint32 t = time_step + static_cast<qint32>(GK_FTX_TIME_OSR * (m_protocol.sync_positions[i] + j));
+            if (t < 0 || t >= waterfall.num_steps) {
+                continue;
+            }
+
+            const qint32 tone = costas[j];
+            const qint32 k = freq_bin + GK_FTX_FREQ_OSR * tone;
+            const float s = at(t, k);
+            if (tone > 0) {
+                score += s - at(t, k - GK_FTX_FREQ_OSR);
+                ++num;
+            }
+
+            if (tone < static_cast<qint32>(m_protocol.num_tones) - 1) {
+                score += s - at(t, k + GK_FTX_FREQ_OSR);
+                ++num;
+            }
+
+            if (j > 0 && t >= GK_FTX_TIME_OSR) {
+                score += s - at(t - GK_FTX_TIME_OSR, k);
+                ++num;
+            }
+
+            if (j + 1 < costas.size() && t + GK_FTX_TIME_OSR < waterfall.num_steps) {
+                score += s - at(t + GK_FTX_TIME_OSR, k);
+                ++num;
+            }
+        }
+    }
+
+    return (num > 0) ? (score / static_cast<float>(num)) : 0.0f;
+}
+
+/**
+ * @brief GkFtxDecoder::decodeCandidate demodulates a candidate into the likelihood of each bit, decodes it with the LDPC
+ * code and, should the CRC then match, unpacks the message. The SNR is estimated from the tones of the decoded codeword.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param waterfall The waterfall of the slot.
+ * @param candidate Where the signal is thought to be.
+ * @param decode Where the decoded message is written.
+ * @return Whether a message was decoded.
+ */
+bool GkFtxDecoder::decodeCandidate(const GkFtxWaterfall &waterfall, const GkFtxCandidate &candidate, GkFtxDecode &decode) const
+{
+    const auto row_at = [&waterfall](const qint32 &t) {
+        return &waterfall.mag[static_cast<size_t>(t) * static_cast<size_t>(waterfall.num_bins)];
+    };
+
+    std::array<float, GK_FTX_LDPC_N> llr = {};
+    std::array<float, 8> tones = {};
+    size_t idx = 0;
+    for (const auto &pos: m_protocol.data_positions) {
+        const qint32 t = candidate.time_step + static_cast<qint32>(GK_FTX_TIME_OSR * pos);
+        if (t < 0 || t >= waterfall.num_steps) {
+            idx += m_protocol.bits_per_symbol;                                  // Lost beyond the end of the slot, so left as erasures.
+            continue;
+        }
+
+        const float *row = row_at(t) + candidate.freq_bin;
+        for (quint32 j = 0; j < m_protocol.num_tones; ++j) {
+            tones[j] = row[GK_FTX_FREQ_OSR * m_protocol.gray_map[j]];
+        }
+
+        for (quint32 b = 0; b < m_protocol.bits_per_symbol; ++b) {
+            const quint32 mask = 1U << (m_protocol.bits_per_symbol - 1 - b);
+            float max_one = -std::numeric_limits<float>::max();
+            float max_zero = -std::numeric_limits<float>::max();
+            for (quint32 j = 0; j < m_protocol.num_tones; ++j) {
+                if (j & mask) {
+                    max_one = std::max(max_one, tones[j]);
+                } else {
+                    max_zero = std::max(max_zero, tones[j]);
+                }
+            }
+
+            llr[idx++] = max_one - max_zero;
+        }
+    }
+
+    //
+    // The likelihoods are scaled so that their variance is always the same, whatever the strength of the signal
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    for (const auto &value: llr) {
+        sum += value;
+        sum_sq += static_cast<double>(value) * value;
+    }
+
+    const double variance = (sum_sq - (sum * sum) / GK_FTX_LDPC_N) / GK_FTX_LDPC_N;
+    if (variance <= 0.0) {
+        return false;
+    }
+
+    const auto norm = static_cast<float>(std::sqrt(24.0 / variance));
+    for (auto &value: llr) {
+        value *= norm;
+    }
+
+    std::array<quint8, GK_FTX_LDPC_N> plain = {};
+    const qint32 iterations = m_ldpc->decode(llr.data(), plain.data());
+    if (iterations < 0 || std::all_of(plain.begin(), plain.end(), [](const quint8 &bit) { return bit == 0; })) {
+        return false;
+    }
+
+    std::array<quint8, 12> a91 = {};
+    for (quint32 k = 0; k < GK_FTX_LDPC_K; ++k) {
+        writeBits(a91.data(), k, plain[k], 1);
+    }
+
+    if (!GkFtxMessage::checkCrc(a91.data())) {
+        return false;
+    }
+
+    std::array<quint8, 10> payload = {};
+    std::memcpy(payload.data(), a91.data(), payload.size());
+    payload[9] &= 0xF8;
+    if (m_protocol.scrambled) {
+        for (size_t i = 0; i < payload.size(); ++i) {
+            payload[i] ^= gk_ft4_scramble[i];
+        }
+    }
+
+    decode.message = GkFtxMessage::unpack(payload.data());
+    if (decode.message.isEmpty()) {
+        return false;
+    }
+
+    //
+    // The power within the tone of each symbol is that of the signal plus the noise within a single bin
+    double power = 0.0;
+    quint32 num_symbols = 0;
+    idx = 0;
+    for (const auto &pos: m_protocol.data_positions) {
+        quint32 value = 0;
+        for (quint32 b = 0; b < m_protocol.bits_per_symbol; ++b) {
+            value = (value << 1) | plain[idx++];
+        }
+
+        const qint32 t = candidate.time_step + static_cast<qint32>(GK_FTX_TIME_OSR * pos);
+        if (t >= 0 && t < waterfall.num_steps) {
+            power += std::pow(10.0, row_at(t)[candidate.freq_bin + GK_FTX_FREQ_OSR * m_protocol.gray_map[value]] / 10.0);
+            ++num_symbols;
+        }
+    }
+
+    const double noise = std::pow(10.0, waterfall.noise_db / 10.0);
+    const double signal = std::max((power / std::max(num_symbols, 1U)) - noise, noise * 1e-3);
+    const double bin_hz = m_protocol.toneSpacing() / GK_FTX_FREQ_OSR;
+    const double snr = 10.0 * std::log10(signal / noise) - 10.0 * std::log10(GK_FTX_SNR_BANDWIDTH_HZ / (GK_FTX_HANN_ENBW * bin_hz));
+
+    decode.mode = m_protocol.mode;
+    decode.freq_hz = candidate.freq_bin * bin_hz;
+    decode.time_offset = (((candidate.time_step * static_cast<double>(m_step)) + (m_protocol.symbol_samples / 2.0)) / GK_FTX_SAMPLE_RATE) - m_protocol.start_secs;
+    decode.snr_db = static_cast<qint32>(std::lround(std::max(snr, -30.0)));
+    decode.ldpc_iterations = iterations;
+
+    return true;
+}
+
+/**
+ * @brief GkFtxBenchmark::run fills a slot of FT8 with signals (at random frequencies, timings and strengths) amongst white
+ * noise, and then decodes it upon a single thread and again upon every core, with the very same LDPC code as is used on
+ * the air.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param num_signals The number of signals within the slot.
+ * @return The time taken by each run, along with how many of the signals were decoded.
+ */
+std::vector<GkFtxBenchResult> GkFtxBenchmark::run(const quint32 &num_signals)
+{
+    try {
+        const auto &protocol = GkFtxProtocol::get(FT8);
+        const auto ldpc = GkFtxLdpc::bundled();
+        std::mt19937 rng(0x5eed);
+
+        const auto count = static_cast<size_t>(std::ceil(protocol.decode_secs * GK_FTX_SAMPLE_RATE));
+        std::vector<float> audio(count);
+        std::normal_distribution<float> noise(0.0f, 1.0f);
+        for (auto &sample: audio) {
+            sample = noise(rng);
+        }
+
+        //
+        // The noise within 2500 Hz is the fraction of white noise (of unit power) that falls therein
+        const double noise_2500 = GK_FTX_SNR_BANDWIDTH_HZ / (GK_FTX_SAMPLE_RATE / 2.0);
+        const double bandwidth = protocol.num_tones * protocol.toneSpacing();
+        const double spacing = ((GK_FTX_MAX_FREQ_HZ - GK_FTX_MIN_FREQ_HZ) - bandwidth) / std::max(num_signals, 1U);
+        std::uniform_real_distribution<double> jitter(0.0, std::max(spacing - bandwidth, 0.0));
+        std::uniform_real_distribution<double> dt(-0.2, 0.8);
+        std::uniform_real_distribution<double> snr(-16.0, 0.0);
+        std::uniform_int_distribution<qint32> kind(0, 2);
+        std::uniform_int_distribution<qint32> report(-24, 10);
+        std::bernoulli_distribution roger(0.5);
+        std::uniform_int_distribution<qint32> letter(0, 17);
+        std::uniform_int_distribution<qint32> digit(0, 9);
+
+        std::set<QString> sent;
+        std::vector<quint8> tones;
+        for (quint32 i = 0; i < num_signals; ++i) {
+            QString message;
+            switch (kind(rng)) {
+                case 0:
+                    message = QString("CQ %1 %2%3%4%5").arg(randomCall(rng), QChar('A' + letter(rng)), QChar('A' + letter(rng)),
+                                                            QString::number(digit(rng)), QString::number(digit(rng)));
+                    break;
+                case 1:
+                {
+                    const qint32 value = report(rng);
+                    message = QString("%1 %2 %3%4%5").arg(randomCall(rng), randomCall(rng), roger(rng) ? QStringLiteral("R") : QString(),
+                                                          (value < 0) ? QStringLiteral("-") : QStringLiteral("+"))
+                            .arg(std::abs(value), 2, 10, QChar('0'));
+                    break;
+                }
+                default:
+                    message = QString("%1 %2 RR73").arg(randomCall(rng), randomCall(rng));
+                    break;
+            }
+
+            if (!GkFtxMessage::toTones(protocol, *ldpc, message, tones)) {
+                continue;
+            }
+
+            const double freq = GK_FTX_MIN_FREQ_HZ + (i * spacing) + jitter(rng);
+            const double amplitude = std::sqrt(2.0 * noise_2500 * std::pow(10.0, snr(rng) / 10.0));
+            const auto offset = static_cast<qint64>(std::llround((protocol.start_secs + dt(rng)) * GK_FTX_SAMPLE_RATE));
+            double phase = 0.0;
+            for (size_t sym = 0; sym < tones.size(); ++sym) {
+                const double step = (2.0 * M_PI * (freq + tones[sym] * protocol.toneSpacing())) / GK_FTX_SAMPLE_RATE;
+                for (quint32 j = 0; j < protocol.symbol_samples; ++j) {
+                    const qint64 pos = offset + static_cast<qint64>(sym * protocol.symbol_samples + j);
+                    if (pos >= 0 && pos < static_cast<qint64>(count)) {
+                        audio[static_cast<size_t>(pos)] += static_cast<float>(amplitude * std::sin(phase));
+                    }
+
+                    phase += step;
+                }
+            }
+
+            sent.insert(message);
+        }
+
+        std::vector<GkFtxBenchResult> results;
+        const quint32 cores = std::max(1U, std::thread::hardware_concurrency());
+        for (const auto &threads: { 1U, cores }) {
+            GkFtxDecoder decoder(FT8, ldpc, QPointer<GkEventLogger>(), threads);
+            quint32 num_candidates = 0;
+            const auto start = std::chrono::steady_clock::now();
+            const auto decodes = decoder.decodeSlot(audio.data(), audio.size(), QDateTime::currentDateTimeUtc(), &num_candidates);
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+            GkFtxBenchResult result;
+            result.threads = threads;
+            result.num_signals = static_cast<quint32>(sent.size());
+            result.candidates = num_candidates;
+            result.decoded = static_cast<quint32>(std::count_if(decodes.begin(), decodes.end(), [&sent](const GkFtxDecode &decode) {
+                return sent.count(decode.message) > 0;
+            }));
+            result.millisecs = elapsed.count();
+            results.push_back(result);
+
+            if (cores == 1) {
+                break;
+            }
+        }
+
+        return results;
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return std::vector<GkFtxBenchResult>();
+}
+
+/**
+ * @brief GkFtxBenchmark::randomCall
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param rng The source of randomness.
+ * @return A standard callsign, such as "K1ABC" or "VK3XYZ".
+ */
+QString GkFtxBenchmark::randomCall(std::mt19937 &rng)
+{
+    std::uniform_int_distribution<qint32> letter(0, 25);
+    std::uniform_int_distribution<qint32> digit(0, 9);
+    std::uniform_int_distribution<qint32> length(1, 3);
+
+    QString call;
+    call += QChar('A' + letter(rng));
+    if (length(rng) > 1) {
+        call += QChar('A' + letter(rng));
+    }
+
+    call += QString::number(digit(rng));
+    const qint32 suffix = length(rng);
+    for (qint32 i = 0; i < suffix; ++i) {
+        call += QChar('A' + letter(rng));
+    }
+
+    return call;
+}
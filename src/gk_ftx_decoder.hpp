@@ -0,0 +1,241 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include "src/gk_logger.hpp"
+#include "src/gk_sdr_ddc.hpp"
+#include "src/gk_thread_pool.hpp"
+#include "src/gk_lockfree_queue.hpp"
+#include <kiss_fft.h>
+#include <array>
+#include <bitset>
+#include <random>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QPointer>
+#include <QDateTime>
+#include <QFileInfo>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkFtxProtocol describes the framing of either FT8 or FT4, being everything that differs between the two as
+ * far as the decoder is concerned.
+ */
+struct GkFtxProtocol {
+    GekkoFyre::AmateurRadio::DigitalModes mode;
+    quint32 symbol_samples;                                                     // At GK_FTX_SAMPLE_RATE.
+    quint32 num_tones;
+    quint32 bits_per_symbol;
+    quint32 num_symbols;                                                        // Including those of sync and (for FT4) the ramps.
+    std::vector<quint32> sync_positions;                                        // The first symbol of each Costas array.
+    std::vector<std::vector<quint8>> costas;                                    // The tones of each Costas array.
+    std::vector<quint32> data_positions;                                        // The symbols that carry the codeword, in order.
+    std::vector<quint8> gray_map;
+    double slot_secs;
+    double start_secs;                                                          // Where within the slot a transmission ought to begin.
+    double decode_secs;                                                         // How far into the slot the audio is handed over for decoding.
+    bool scrambled;                                                             // Whether the payload is XOR'd prior to the CRC being added, as with FT4.
+
+    [[nodiscard]] double toneSpacing() const;
+    [[nodiscard]] static const GkFtxProtocol &get(const GekkoFyre::AmateurRadio::DigitalModes &mode);
+};
+
+/**
+ * @brief GkFtxLdpc is the (174, 91) LDPC code shared by FT8 and FT4, decoded via normalized min-sum belief propagation.
+ * The code is built from its parity checks alone, with the generator for encoding being derived from them, and those
+ * of FT8 & FT4 are bundled within the application's resources.
+ */
+class GkFtxLdpc {
+
+public:
+    GkFtxLdpc();
+
+    [[nodiscard]] static std::shared_ptr<GkFtxLdpc> fromFile(const QFileInfo &file_path);
+    [[nodiscard]] static std::shared_ptr<GkFtxLdpc> bundled();
+
+    qint32 decode(const float *llr, quint8 *plain) const;
+    void encode(const quint8 *message, quint8 *codeword) const;
+
+private:
+    std::array<std::array<quint8, GK_FTX_LDPC_COLUMN_WEIGHT>, GK_FTX_LDPC_N> m_mn;      // The checks that each bit takes part in.
+    std::array<std::array<quint8, GK_FTX_LDPC_MAX_ROW_WEIGHT>, GK_FTX_LDPC_M> m_nm;     // The bits that each check covers.
+    std::array<std::array<quint8, GK_FTX_LDPC_MAX_ROW_WEIGHT>, GK_FTX_LDPC_M> m_nmSlot; // Where each check lies within `m_mn` of its bits.
+    std::array<quint8, GK_FTX_LDPC_M> m_nrw;                                            // The weight of each check.
+    std::array<std::bitset<GK_FTX_LDPC_K>, GK_FTX_LDPC_M> m_generator;                  // Each parity bit, as a sum of message bits.
+
+    bool build();
+
+};
+
+/**
+ * @brief GkFtxMessage packs and unpacks the 77-bit messages of FT8 and FT4, along with their 14-bit CRC. Standard
+ * messages (i.e. two callsigns followed by a grid locator or report) and free text are understood, whilst any other
+ * type of message is shown by its type alone.
+ */
+class GkFtxMessage {
+
+public:
+    [[nodiscard]] static QString unpack(const quint8 *payload);
+    static bool pack(const QString &message, quint8 *payload);
+    static bool toTones(const GkFtxProtocol &protocol, const GkFtxLdpc &ldpc, const QString &message, std::vector<quint8> &tones);
+
+    [[nodiscard]] static quint16 crc14(const quint8 *data, const size_t &num_bits);
+    static void addCrc(const quint8 *payload, quint8 *a91);
+    [[nodiscard]] static bool checkCrc(const quint8 *a91);
+
+private:
+    [[nodiscard]] static QString unpackCall(const quint32 &n28);
+    [[nodiscard]] static bool packCall(const QString &call, quint32 &n28);
+    [[nodiscard]] static QString unpackText(const quint8 *payload);
+
+};
+
+/**
+ * @brief GkFtxDecoder decodes FT8 or FT4 from captured audio. The audio is fed in from the capture thread, resampled
+ * towards 12 kHz and kept within a ring, from which each slot is handed over (without any allocations) towards a thread
+ * of the decoder's own at the end of every slot. There, a waterfall of the slot is built and searched for the Costas
+ * arrays of each candidate signal, after which every candidate is demodulated and LDPC decoded upon a work-stealing
+ * pool of threads.
+ */
+class GkFtxDecoder : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GkFtxDecoder(const GekkoFyre::AmateurRadio::DigitalModes &mode, std::shared_ptr<GekkoFyre::GkFtxLdpc> ldpc,
+                          QPointer<GekkoFyre::GkEventLogger> eventLogger, const quint32 &num_threads = 0,
+                          QObject *parent = nullptr);
+    ~GkFtxDecoder() override;
+
+    void configure(const quint32 &input_rate, const quint16 &channels, const size_t &max_frames);
+    void process(const qint16 *samples, const size_t &frames);
+
+    QList<GekkoFyre::AmateurRadio::GkFtxDecode> decodeSlot(const float *audio, const size_t &count, const QDateTime &slot_start,
+                                                           quint32 *num_candidates = nullptr);
+    [[nodiscard]] const GkFtxProtocol &getProtocol() const;
+
+public slots:
+    void start();
+    void stop();
+
+signals:
+    void slotDecoded(const QList<GekkoFyre::AmateurRadio::GkFtxDecode> &decodes);
+
+private:
+    struct GkFtxSlot {
+        std::vector<float> audio;
+        size_t count;
+        qint64 start_ms;                                                        // Milliseconds since the epoch, UTC.
+    };
+
+    struct GkFtxWaterfall {
+        qint32 num_steps;
+        qint32 num_bins;
+        float noise_db;                                                         // The noise within a single bin.
+        std::vector<float> mag;                                                 // In dB, as [step * num_bins + bin].
+    };
+
+    struct GkFtxCandidate {
+        float score;
+        qint32 time_step;                                                       // The step upon which the first symbol is centred.
+        qint32 freq_bin;                                                        // The bin of the lowest tone.
+    };
+
+    const GkFtxProtocol &m_protocol;
+    std::shared_ptr<GekkoFyre::GkFtxLdpc> m_ldpc;
+    QPointer<GekkoFyre::GkEventLogger> gkEventLogger;
+    std::unique_ptr<GekkoFyre::GkWorkStealingPool> m_pool;
+    quint32 m_nfft;
+    quint32 m_step;
+    std::vector<float> m_window;
+    std::unique_ptr<std::remove_pointer<kiss_fft_cfg>::type, void (*)(void *)> m_fftCfg;
+
+    //
+    // Only ever touched by the capture thread, once configured
+    GekkoFyre::GkAudioResampler m_resampler;
+    quint16 m_channels;
+    size_t m_maxFrames;
+    std::vector<float> m_mono;
+    std::vector<float> m_resampled;
+    std::vector<float> m_ring;
+    size_t m_ringMask;
+    quint64 m_written;                                                          // Samples written towards the ring, ever.
+    qint64 m_slotStartMs;                                                       // The slot currently being captured.
+    std::atomic<bool> m_configured;
+
+    std::vector<std::unique_ptr<GkFtxSlot>> m_slots;
+    GkLockFreeQueue<GkFtxSlot *> m_freeSlots;
+    GkLockFreeQueue<GkFtxSlot *> m_filledSlots;
+    std::atomic<quint64> m_droppedSlots;
+
+    std::thread decoderThread;
+    std::atomic<bool> m_running;
+
+    void run();
+    void forEach(const size_t &count, const std::function<void(const size_t &)> &task);
+    void computeWaterfall(const float *audio, const size_t &count, GkFtxWaterfall &waterfall);
+    std::vector<GkFtxCandidate> findCandidates(const GkFtxWaterfall &waterfall);
+    [[nodiscard]] float syncScore(const GkFtxWaterfall &waterfall, const qint32 &time_step, const qint32 &freq_bin) const;
+    bool decodeCandidate(const GkFtxWaterfall &waterfall, const GkFtxCandidate &candidate,
+                         GekkoFyre::AmateurRadio::GkFtxDecode &decode) const;
+
+};
+
+/**
+ * @brief GkFtxBenchmark decodes a synthetic FT8 slot crowded with signals, both upon the pool and upon a single thread,
+ * so that the time taken may be compared against the idle window of the slot.
+ */
+class GkFtxBenchmark {
+
+public:
+    [[nodiscard]] static std::vector<GekkoFyre::AmateurRadio::GkFtxBenchResult> run(const quint32 &num_signals = GK_FTX_BENCH_SIGNALS);
+    [[nodiscard]] static QString randomCall(std::mt19937 &rng);
+
+};
+};
@@ -0,0 +1,173 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <stdexcept>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkLockFreeQueue is a bounded, multi-producer and multi-consumer queue that never takes a lock nor allocates
+ * once constructed, thereby making it safe to push to and pop from within real-time audio and SDR threads.
+ * @tparam T The element type, which should be cheap to move.
+ * @note Dmitry Vyukov's bounded MPMC queue <https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue>.
+ */
+template <typename T>
+class GkLockFreeQueue {
+
+public:
+    explicit GkLockFreeQueue(const size_t &capacity) : m_buffer(new Cell[capacity]), m_mask(capacity - 1)
+    {
+        if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+            throw std::invalid_argument("The capacity of a GkLockFreeQueue must be a power of two!");
+        }
+
+        for (size_t i = 0; i < capacity; ++i) {
+            m_buffer[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        m_enqueuePos.store(0, std::memory_order_relaxed);
+        m_dequeuePos.store(0, std::memory_order_relaxed);
+    }
+
+    ~GkLockFreeQueue() = default;
+
+    GkLockFreeQueue(const GkLockFreeQueue &) = delete;
+    GkLockFreeQueue &operator=(const GkLockFreeQueue &) = delete;
+
+    /**
+     * @brief push attempts to add an element towards the back of the queue.
+     * @return False if the queue is full, in which case `data` is left untouched.
+     */
+    bool push(T &&data)
+    {
+        Cell *cell;
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &m_buffer[pos & m_mask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = std::move(data);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    bool push(const T &data)
+    {
+        T copy = data;
+        return push(std::move(copy));
+    }
+
+    /**
+     * @brief pop attempts to remove the element at the front of the queue.
+     * @return False if the queue is empty.
+     */
+    bool pop(T &data)
+    {
+        Cell *cell;
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &m_buffer[pos & m_mask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        data = std::move(cell->data);
+        cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * @brief sizeApprox is only an estimate whenever other threads are pushing or popping at the same time.
+     */
+    [[nodiscard]] size_t sizeApprox() const
+    {
+        const size_t enq = m_enqueuePos.load(std::memory_order_relaxed);
+        const size_t deq = m_dequeuePos.load(std::memory_order_relaxed);
+        return (enq >= deq) ? (enq - deq) : 0;
+    }
+
+    [[nodiscard]] size_t capacity() const { return m_mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    //
+    // Keep the producer and consumer positions on separate cache-lines, so as to avoid false sharing!
+    static constexpr size_t cacheLineSize = 64;
+
+    std::unique_ptr<Cell[]> m_buffer;
+    const size_t m_mask;
+    alignas(cacheLineSize) std::atomic<size_t> m_enqueuePos;
+    alignas(cacheLineSize) std::atomic<size_t> m_dequeuePos;
+
+};
+};
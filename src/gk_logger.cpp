@@ -46,6 +46,7 @@
 #include <utility>
 #include <chrono>
 #include <thread>
+#include <QThread>
 #include <QDateTime>
 #include <QStandardPaths>
 
@@ -247,13 +248,23 @@ GkEventLogger::~GkEventLogger()
  * @param displayMsgBox
  * @param flashTaskbar Whether to flash the taskbar and/or active window. This is dependent upon host operating system
  * functionality, of course!
+ * @note May be called from any thread, as the event is handed over towards the thread of the logger itself should it
+ * be called from elsewhere.
  */
 void GkEventLogger::publishEvent(const QString &event, const GkSeverity &severity, const QVariant &arguments, const bool &sys_notification,
                                  const bool &publishToConsole, const bool &publishToStatusBar, const bool &displayMsgBox,
                                  const bool &flashTaskbar)
 {
-    //
-    // TODO: Introduce proper mutex'ing for multithreading!
+    if (QThread::currentThread() != thread()) {
+        //
+        // The event log, its file and any message boxes are only ever to be touched from the logger's own thread
+        QMetaObject::invokeMethod(this, [=]() {
+            publishEvent(event, severity, arguments, sys_notification, publishToConsole, publishToStatusBar, displayMsgBox, flashTaskbar);
+        }, Qt::QueuedConnection);
+
+        return;
+    }
+
     GkEventLogging event_log;
     event_log.mesg.message = event;
     event_log.mesg.severity = severity;
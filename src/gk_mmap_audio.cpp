@@ -0,0 +1,642 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/gk_mmap_audio.hpp"
+#include <cmath>
+#include <limits>
+#include <cstring>
+#include <utility>
+#include <exception>
+#include <algorithm>
+#include <QtEndian>
+
+#if __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace GekkoFyre;
+using namespace GkAudioFramework;
+
+namespace {
+    /**
+     * @brief readLe reads a little-endian integer of the given type from a possibly unaligned location in memory, by way of
+     * copying its bytes out first rather than casting the pointer.
+     */
+    template <typename T>
+    T readLe(const uchar *src)
+    {
+        T val;
+        std::memcpy(&val, src, sizeof(val));
+        return qFromLittleEndian<T>(val);
+    }
+}
+
+/**
+ * @brief GkMmapAudioFile::GkMmapAudioFile maps a WAV or RF64 (i.e. 64-bit WAV as per EBU Tech 3306) file into memory
+ * and parses its header, without reading any of the PCM data itself.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param file_path The path to the WAV/RF64 file to be mapped.
+ * @param parent The parent object to this class.
+ */
+GkMmapAudioFile::GkMmapAudioFile(const QFileInfo &file_path, QObject *parent) : QObject(parent), m_mapped(nullptr),
+                                                                                 m_mappedSize(0), m_pcmData(nullptr),
+                                                                                 m_frameCount(0), m_adviseStart(0),
+                                                                                 m_adviseCount(0)
+{
+    try {
+        m_filePath = file_path;
+        m_format = { PcmUnknown, 0, 0, 0 };
+
+        mapFile();
+        parseWaveHeader();
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkMmapAudioFile::GkMmapAudioFile maps a headerless, raw PCM file into memory, whereby the format of the data
+ * must be known beforehand.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param file_path The path to the raw PCM file to be mapped.
+ * @param raw_format The layout of the PCM data within the given file.
+ * @param data_offset Where the PCM data begins within the given file, measured in bytes.
+ * @param parent The parent object to this class.
+ */
+GkMmapAudioFile::GkMmapAudioFile(const QFileInfo &file_path, const GkPcmFormat &raw_format, const qint64 &data_offset,
+                                 QObject *parent) : QObject(parent), m_mapped(nullptr), m_mappedSize(0),
+                                                    m_pcmData(nullptr), m_frameCount(0), m_adviseStart(0), m_adviseCount(0)
+{
+    try {
+        m_filePath = file_path;
+        m_format = raw_format;
+        m_format.bytes_per_sample = bytesPerSample(m_format.sample_fmt);
+        if (m_format.sample_fmt == PcmUnknown || m_format.channels == 0 || m_format.sample_rate == 0) {
+            throw std::invalid_argument(tr("An invalid PCM format has been given for raw audio file, \"%1\"!")
+                                                .arg(file_path.fileName()).toStdString());
+        }
+
+        mapFile();
+        if (data_offset < 0 || data_offset > m_mappedSize) {
+            throw std::invalid_argument(tr("The given data offset lies beyond the end of raw audio file, \"%1\"!")
+                                                .arg(file_path.fileName()).toStdString());
+        }
+
+        m_pcmData = m_mapped + data_offset;
+        m_frameCount = (m_mappedSize - data_offset) / frameSize();
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return;
+}
+
+GkMmapAudioFile::~GkMmapAudioFile()
+{
+    if (m_file && m_mapped) {
+        m_file->unmap(m_mapped);
+        m_mapped = nullptr;
+    }
+
+    if (m_file && m_file->isOpen()) {
+        m_file->close();
+    }
+
+    return;
+}
+
+/**
+ * @brief GkMmapAudioFile::isMappable determines, from the file extension alone, whether a given file is one that we can
+ * map directly into memory without any decoding.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param file_path The file to be checked.
+ * @return Whether the file is a WAV, RF64 or BWF file.
+ */
+bool GkMmapAudioFile::isMappable(const QFileInfo &file_path)
+{
+    const QString suffix = file_path.suffix().toLower();
+    return (suffix == "wav" || suffix == "wave" || suffix == "rf64" || suffix == "bwf");
+}
+
+/**
+ * @brief GkMmapAudioFile::isOpen
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return Whether the file is mapped and has PCM data ready to be read.
+ */
+bool GkMmapAudioFile::isOpen() const
+{
+    return (m_mapped != nullptr && m_pcmData != nullptr);
+}
+
+/**
+ * @brief GkMmapAudioFile::getFilePath
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The path to the mapped file.
+ */
+QFileInfo GkMmapAudioFile::getFilePath() const
+{
+    return m_filePath;
+}
+
+/**
+ * @brief GkMmapAudioFile::getFormat
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The layout of the PCM data within the mapped file.
+ */
+GkPcmFormat GkMmapAudioFile::getFormat() const
+{
+    return m_format;
+}
+
+/**
+ * @brief GkMmapAudioFile::frameCount
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The total number of whole frames within the mapped file.
+ */
+qint64 GkMmapAudioFile::frameCount() const
+{
+    return m_frameCount;
+}
+
+/**
+ * @brief GkMmapAudioFile::frameSize
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The size of a single frame (i.e. one sample across all channels), in bytes.
+ */
+qint64 GkMmapAudioFile::frameSize() const
+{
+    return static_cast<qint64>(m_format.bytes_per_sample) * m_format.channels;
+}
+
+/**
+ * @brief GkMmapAudioFile::durationSecs
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The duration of the mapped file, in seconds.
+ */
+double GkMmapAudioFile::durationSecs() const
+{
+    if (m_format.sample_rate == 0) {
+        return 0.0;
+    }
+
+    return static_cast<double>(m_frameCount) / m_format.sample_rate;
+}
+
+/**
+ * @brief GkMmapAudioFile::secsToFrame converts a point in time to its nearest frame, which is useful for seeking.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param secs The point in time to seek towards, measured in seconds from the start of the file.
+ * @return The equivalent frame, clamped to the frames actually present.
+ */
+qint64 GkMmapAudioFile::secsToFrame(const double &secs) const
+{
+    const auto frame = static_cast<qint64>(std::llround(std::max(secs, 0.0) * m_format.sample_rate));
+    return std::min(frame, m_frameCount);
+}
+
+/**
+ * @brief GkMmapAudioFile::rawFrames returns a zero-copy view over the raw, undecoded bytes of the requested frames. This
+ * is mostly of use for sample formats which have no native C++ equivalent, such as 24-bit PCM.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param start The first frame to be viewed.
+ * @param count The number of frames to be viewed.
+ * @return The view over the given frames, where each 'channel' is then one byte.
+ */
+GkFrameSpan<uchar> GkMmapAudioFile::rawFrames(const qint64 &start, const qint64 &count) const
+{
+    qint64 first = start;
+    qint64 num = count;
+    clampFrameRange(first, num);
+
+    GkFrameSpan<uchar> span;
+    span.data = m_pcmData + (first * frameSize());
+    span.frames = num;
+    span.channels = static_cast<quint16>(frameSize());
+
+    return span;
+}
+
+/**
+ * @brief GkMmapAudioFile::readFloat decodes the requested frames into normalized, interleaved floating-point samples
+ * within the range of [-1.0, 1.0].
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param start The first frame to be read.
+ * @param count The number of frames to be read.
+ * @param out The pre-allocated destination, which must hold at least `count * channels` samples.
+ * @return The number of frames actually read.
+ */
+qint64 GkMmapAudioFile::readFloat(const qint64 &start, const qint64 &count, float *out) const
+{
+    qint64 first = start;
+    qint64 num = count;
+    clampFrameRange(first, num);
+
+    const size_t num_samples = static_cast<size_t>(num) * m_format.channels;
+    const uchar *src = m_pcmData + (first * frameSize());
+    if (m_format.sample_fmt == PcmFloat32 && Q_BYTE_ORDER == Q_LITTLE_ENDIAN) {
+        std::memcpy(out, src, num_samples * sizeof(float));
+        return num;
+    }
+
+    if (m_format.sample_fmt == PcmInt16) {
+        constexpr float scale = 1.0f / 32768.0f;
+        for (size_t i = 0; i < num_samples; ++i) {
+            out[i] = static_cast<float>(readLe<qint16>(src + (i * 2))) * scale;
+        }
+
+        return num;
+    }
+
+    for (size_t i = 0; i < num_samples; ++i) {
+        out[i] = sampleToFloat(src + (i * m_format.bytes_per_sample), m_format.sample_fmt);
+    }
+
+    return num;
+}
+
+/**
+ * @brief GkMmapAudioFile::readMonoFloat decodes the requested frames into normalized floating-point samples, whilst
+ * also mixing all the channels down to a single one. This is what the spectrograph / waterfall expects.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param start The first frame to be read.
+ * @param count The number of frames to be read.
+ * @param out The pre-allocated destination, which must hold at least `count` samples.
+ * @return The number of frames actually read.
+ */
+qint64 GkMmapAudioFile::readMonoFloat(const qint64 &start, const qint64 &count, float *out) const
+{
+    qint64 first = start;
+    qint64 num = count;
+    clampFrameRange(first, num);
+
+    const quint16 channels = m_format.channels;
+    const float scale = 1.0f / channels;
+    const uchar *src = m_pcmData + (first * frameSize());
+    for (qint64 i = 0; i < num; ++i) {
+        float sum = 0.0f;
+        for (quint16 j = 0; j < channels; ++j) {
+            sum += sampleToFloat(src + (((i * channels) + j) * m_format.bytes_per_sample), m_format.sample_fmt);
+        }
+
+        out[i] = sum * scale;
+    }
+
+    return num;
+}
+
+/**
+ * @brief GkMmapAudioFile::adviseWindow informs the kernel of the range of frames that are about to be viewed, so that
+ * those pages may be read ahead of time, while the pages of the previously advised window are then released. This keeps
+ * the resident memory proportional to the window being viewed rather than to the size of the file.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param start The first frame within the new window.
+ * @param count The number of frames within the new window.
+ * @note This is only a hint, and does nothing on platforms other than Linux.
+ */
+void GkMmapAudioFile::adviseWindow(const qint64 &start, const qint64 &count)
+{
+    qint64 first = start;
+    qint64 num = count;
+    clampFrameRange(first, num);
+
+    if (m_adviseCount > 0) {
+        const qint64 old_end = m_adviseStart + m_adviseCount;
+        const qint64 new_end = first + num;
+        if (old_end <= first || m_adviseStart >= new_end) {
+            adviseRange(m_adviseStart, m_adviseCount, false);
+        } else if (m_adviseStart < first) {
+            adviseRange(m_adviseStart, first - m_adviseStart, false);
+        } else if (old_end > new_end) {
+            adviseRange(new_end, old_end - new_end, false);
+        }
+    }
+
+    adviseRange(first, num, true);
+    m_adviseStart = first;
+    m_adviseCount = num;
+
+    return;
+}
+
+/**
+ * @brief GkMmapAudioFile::adviseSequential informs the kernel that the whole file is about to be read from start to
+ * finish, such as when generating a waterfall from a recording, so that aggressive read-ahead may take place.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkMmapAudioFile::adviseSequential()
+{
+    #if __linux__
+    if (m_mapped) {
+        ::madvise(m_mapped, static_cast<size_t>(m_mappedSize), MADV_SEQUENTIAL);
+    }
+    #endif
+
+    return;
+}
+
+/**
+ * @brief GkMmapAudioFile::mapFile opens the given file and maps the entirety of it into our address space. Nothing is
+ * actually read from storage until the pages in question are touched.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkMmapAudioFile::mapFile()
+{
+    m_file = std::make_unique<QFile>(m_filePath.absoluteFilePath());
+    if (!m_file->open(QIODevice::ReadOnly)) {
+        throw std::runtime_error(tr("Unable to open audio file, \"%1\", for reading: %2")
+                                         .arg(m_filePath.fileName(), m_file->errorString()).toStdString());
+    }
+
+    m_mappedSize = m_file->size();
+    if (m_mappedSize <= 0) {
+        throw std::runtime_error(tr("Audio file, \"%1\", is empty!").arg(m_filePath.fileName()).toStdString());
+    }
+
+    m_mapped = m_file->map(0, m_mappedSize);
+    if (!m_mapped) {
+        throw std::runtime_error(tr("Unable to map audio file, \"%1\", into memory: %2")
+                                         .arg(m_filePath.fileName(), m_file->errorString()).toStdString());
+    }
+
+    return;
+}
+
+/**
+ * @brief GkMmapAudioFile::parseWaveHeader walks the chunks of a RIFF/RF64 WAVE file, in order to find the format of the
+ * PCM data and where said data lies within the file.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @note EBU Tech 3306 - RF64 <https://tech.ebu.ch/docs/tech/tech3306v1_1.pdf>,
+ * Multimedia Programming Interface and Data Specifications 1.0 <http://www-mmsp.ece.mcgill.ca/Documents/AudioFormats/WAVE/WAVE.html>.
+ */
+void GkMmapAudioFile::parseWaveHeader()
+{
+    if (m_mappedSize < GK_AUDIO_MMAP_RIFF_HEADER_SIZE) {
+        throw std::invalid_argument(tr("Audio file, \"%1\", is too small to be a WAV file!").arg(m_filePath.fileName()).toStdString());
+    }
+
+    const bool is_rf64 = (std::memcmp(m_mapped, "RF64", 4) == 0 || std::memcmp(m_mapped, "BW64", 4) == 0);
+    if ((std::memcmp(m_mapped, "RIFF", 4) != 0 && !is_rf64) || std::memcmp(m_mapped + 8, "WAVE", 4) != 0) {
+        throw std::invalid_argument(tr("Audio file, \"%1\", is not a RIFF/RF64 WAVE file!").arg(m_filePath.fileName()).toStdString());
+    }
+
+    bool found_fmt = false;
+    quint64 ds64_data_size = 0;
+    qint64 pos = GK_AUDIO_MMAP_RIFF_HEADER_SIZE;
+    while (pos + GK_AUDIO_MMAP_CHUNK_HEADER_SIZE <= m_mappedSize) {
+        const uchar *chunk = m_mapped + pos;
+        const uchar *body = chunk + GK_AUDIO_MMAP_CHUNK_HEADER_SIZE;
+        const qint64 body_pos = pos + GK_AUDIO_MMAP_CHUNK_HEADER_SIZE;
+        quint64 chunk_size = readLe<quint32>(chunk + 4);
+
+        if (std::memcmp(chunk, "ds64", 4) == 0) {
+            if (body_pos + 16 > m_mappedSize) {
+                break;
+            }
+
+            //
+            // The 'ds64' chunk holds the 64-bit RIFF size, followed by the 64-bit data size!
+            ds64_data_size = readLe<quint64>(body + 8);
+        } else if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            //
+            // The format chunk must be large enough to hold at least a PCMWAVEFORMAT, and must lie wholly within the file!
+            if (chunk_size < 16 || chunk_size > static_cast<quint64>(m_mappedSize - body_pos)) {
+                throw std::invalid_argument(tr("Audio file, \"%1\", has a malformed format chunk!").arg(m_filePath.fileName()).toStdString());
+            }
+
+            quint16 format_tag = readLe<quint16>(body);
+            const quint16 channels = readLe<quint16>(body + 2);
+            const quint32 sample_rate = readLe<quint32>(body + 4);
+            const quint16 bits_per_sample = readLe<quint16>(body + 14);
+            if (format_tag == GK_AUDIO_MMAP_WAVE_FORMAT_EXTENSIBLE && chunk_size >= 40) {
+                //
+                // The real format tag is the first two bytes of the sub-format GUID!
+                format_tag = readLe<quint16>(body + 24);
+            }
+
+            m_format.sample_fmt = sampleFormatFromTag(format_tag, bits_per_sample);
+            m_format.channels = channels;
+            m_format.sample_rate = sample_rate;
+            m_format.bytes_per_sample = bytesPerSample(m_format.sample_fmt);
+            found_fmt = true;
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (!found_fmt) {
+                throw std::invalid_argument(tr("Audio file, \"%1\", has no format chunk before its data!").arg(m_filePath.fileName()).toStdString());
+            }
+
+            if (is_rf64 && chunk_size == GK_AUDIO_MMAP_RF64_SIZE_PLACEHOLDER) {
+                chunk_size = ds64_data_size;
+            }
+
+            //
+            // Recordings that were cut short (or are still being written) may claim more data than is present!
+            const auto avail = static_cast<quint64>(m_mappedSize - body_pos);
+            if (chunk_size == 0 || chunk_size > avail) {
+                chunk_size = avail;
+            }
+
+            if (m_format.sample_fmt == PcmUnknown || m_format.channels == 0 || m_format.sample_rate == 0) {
+                throw std::invalid_argument(tr("Audio file, \"%1\", is of an unsupported PCM encoding!").arg(m_filePath.fileName()).toStdString());
+            }
+
+            m_pcmData = body;
+            m_frameCount = static_cast<qint64>(chunk_size) / frameSize();
+
+            return;
+        }
+
+        //
+        // Chunks are always padded out towards an even number of bytes!
+        pos = body_pos + static_cast<qint64>(chunk_size + (chunk_size & 1));
+    }
+
+    throw std::invalid_argument(tr("Unable to find any PCM data within audio file, \"%1\"!").arg(m_filePath.fileName()).toStdString());
+}
+
+/**
+ * @brief GkMmapAudioFile::clampFrameRange restricts a given range of frames to those that are actually present.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param start The first frame within the range, which is modified in place.
+ * @param count The number of frames within the range, which is modified in place.
+ */
+void GkMmapAudioFile::clampFrameRange(qint64 &start, qint64 &count) const
+{
+    start = std::clamp(start, static_cast<qint64>(0), m_frameCount);
+    count = std::clamp(count, static_cast<qint64>(0), m_frameCount - start);
+
+    return;
+}
+
+/**
+ * @brief GkMmapAudioFile::adviseRange passes along a page-aligned hint to the kernel regarding the given frames.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param start The first frame within the range.
+ * @param count The number of frames within the range.
+ * @param will_need Whether the pages are soon to be needed, or otherwise, whether they may now be released.
+ */
+void GkMmapAudioFile::adviseRange(const qint64 &start, const qint64 &count, const bool &will_need)
+{
+    #if __linux__
+    if (!m_mapped || count <= 0) {
+        return;
+    }
+
+    const auto page_size = static_cast<qint64>(::sysconf(_SC_PAGESIZE));
+    const qint64 begin_byte = (m_pcmData - m_mapped) + (start * frameSize());
+    const qint64 end_byte = begin_byte + (count * frameSize());
+    const qint64 aligned_begin = (begin_byte / page_size) * page_size;
+    if (end_byte <= aligned_begin) {
+        return;
+    }
+
+    ::madvise(m_mapped + aligned_begin, static_cast<size_t>(end_byte - aligned_begin), will_need ? MADV_WILLNEED : MADV_DONTNEED);
+    #else
+    Q_UNUSED(start);
+    Q_UNUSED(count);
+    Q_UNUSED(will_need);
+    #endif
+
+    return;
+}
+
+/**
+ * @brief GkMmapAudioFile::sampleFormatFromTag converts a WAVE format tag and its bit depth towards our own enumerator.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param format_tag The WAVE format tag, such as WAVE_FORMAT_PCM.
+ * @param bits_per_sample The bit depth of each sample.
+ * @return The equivalent sample format, or `PcmUnknown` if it is not one that we support.
+ */
+GkPcmSampleFormat GkMmapAudioFile::sampleFormatFromTag(const quint16 &format_tag, const quint16 &bits_per_sample)
+{
+    if (format_tag == GK_AUDIO_MMAP_WAVE_FORMAT_PCM) {
+        switch (bits_per_sample) {
+            case 16:
+                return PcmInt16;
+            case 24:
+                return PcmInt24;
+            case 32:
+                return PcmInt32;
+            default:
+                return PcmUnknown;
+        }
+    } else if (format_tag == GK_AUDIO_MMAP_WAVE_FORMAT_IEEE_FLOAT) {
+        switch (bits_per_sample) {
+            case 32:
+                return PcmFloat32;
+            case 64:
+                return PcmFloat64;
+            default:
+                return PcmUnknown;
+        }
+    }
+
+    return PcmUnknown;
+}
+
+/**
+ * @brief GkMmapAudioFile::bytesPerSample
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sample_fmt The sample format in question.
+ * @return The storage size of a single sample of the given format, in bytes.
+ */
+quint16 GkMmapAudioFile::bytesPerSample(const GkPcmSampleFormat &sample_fmt)
+{
+    switch (sample_fmt) {
+        case PcmInt16:
+            return 2;
+        case PcmInt24:
+            return 3;
+        case PcmInt32:
+        case PcmFloat32:
+            return 4;
+        case PcmFloat64:
+            return 8;
+        default:
+            return 0;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief GkMmapAudioFile::sampleToFloat decodes a single, little-endian sample into a normalized float.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param src Where the sample lies in memory.
+ * @param sample_fmt The encoding of said sample.
+ * @return The normalized sample.
+ */
+float GkMmapAudioFile::sampleToFloat(const uchar *src, const GkPcmSampleFormat &sample_fmt)
+{
+    switch (sample_fmt) {
+        case PcmInt16:
+            return static_cast<float>(readLe<qint16>(src)) / 32768.0f;
+        case PcmInt24:
+        {
+            //
+            // Sign-extend the 24-bit sample by shifting it into the upper bytes of a 32-bit integer!
+            const auto raw = static_cast<qint32>((static_cast<quint32>(src[0]) << 8) | (static_cast<quint32>(src[1]) << 16) |
+                                                 (static_cast<quint32>(src[2]) << 24));
+            return static_cast<float>(raw >> 8) / 8388608.0f;
+        }
+        case PcmInt32:
+            return static_cast<float>(static_cast<double>(readLe<qint32>(src)) / 2147483648.0);
+        case PcmFloat32:
+        {
+            const quint32 bits = readLe<quint32>(src);
+            float val;
+            std::memcpy(&val, &bits, sizeof(val));
+            return val;
+        }
+        case PcmFloat64:
+        {
+            const quint64 bits = readLe<quint64>(src);
+            double val;
+            std::memcpy(&val, &bits, sizeof(val));
+            return static_cast<float>(val);
+        }
+        default:
+            return 0.0f;
+    }
+
+    return 0.0f;
+}
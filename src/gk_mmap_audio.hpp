@@ -0,0 +1,188 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <QFile>
+#include <QObject>
+#include <QString>
+#include <QtGlobal>
+#include <QFileInfo>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkFrameSpan is a non-owning, read-only view over a range of interleaved PCM frames. It is only ever valid for
+ * as long as the `GkMmapAudioFile` (or other buffer) that it was taken from remains alive.
+ */
+template <typename T>
+struct GkFrameSpan {
+    const T *data = nullptr;                                                    // Pointer towards the very first sample of the very first frame.
+    qint64 frames = 0;                                                          // The number of frames in view.
+    quint16 channels = 0;                                                       // The number of interleaved channels per each frame.
+
+    [[nodiscard]] size_t size() const { return static_cast<size_t>(frames) * channels; }
+    [[nodiscard]] bool empty() const { return data == nullptr || frames <= 0; }
+    [[nodiscard]] const T *begin() const { return data; }
+    [[nodiscard]] const T *end() const { return data + size(); }
+    [[nodiscard]] const T &at(const qint64 &frame, const quint16 &channel) const { return data[(frame * channels) + channel]; }
+};
+
+class GkMmapAudioFile : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GkMmapAudioFile(const QFileInfo &file_path, QObject *parent = nullptr);
+    explicit GkMmapAudioFile(const QFileInfo &file_path, const GekkoFyre::GkAudioFramework::GkPcmFormat &raw_format,
+                             const qint64 &data_offset = 0, QObject *parent = nullptr);
+    ~GkMmapAudioFile() override;
+
+    [[nodiscard]] static bool isMappable(const QFileInfo &file_path);
+
+    [[nodiscard]] bool isOpen() const;
+    [[nodiscard]] QFileInfo getFilePath() const;
+    [[nodiscard]] GekkoFyre::GkAudioFramework::GkPcmFormat getFormat() const;
+    [[nodiscard]] qint64 frameCount() const;
+    [[nodiscard]] qint64 frameSize() const;
+    [[nodiscard]] double durationSecs() const;
+    [[nodiscard]] qint64 secsToFrame(const double &secs) const;
+
+    template <typename T>
+    [[nodiscard]] GkFrameSpan<T> frames(const qint64 &start, const qint64 &count) const;
+    [[nodiscard]] GkFrameSpan<uchar> rawFrames(const qint64 &start, const qint64 &count) const;
+
+    qint64 readFloat(const qint64 &start, const qint64 &count, float *out) const;
+    qint64 readMonoFloat(const qint64 &start, const qint64 &count, float *out) const;
+
+    void adviseWindow(const qint64 &start, const qint64 &count);
+    void adviseSequential();
+
+private:
+    QFileInfo m_filePath;
+    std::unique_ptr<QFile> m_file;
+    uchar *m_mapped;                                                            // The entire file, as mapped into our address space.
+    qint64 m_mappedSize;
+    const uchar *m_pcmData;                                                     // Pointer towards the very start of the PCM data itself.
+    qint64 m_frameCount;
+    GekkoFyre::GkAudioFramework::GkPcmFormat m_format;
+
+    //
+    // The window that was last advised to the kernel as being needed, measured in frames
+    qint64 m_adviseStart;
+    qint64 m_adviseCount;
+
+    void mapFile();
+    void parseWaveHeader();
+    void clampFrameRange(qint64 &start, qint64 &count) const;
+    void adviseRange(const qint64 &start, const qint64 &count, const bool &will_need);
+
+    [[nodiscard]] static GekkoFyre::GkAudioFramework::GkPcmSampleFormat sampleFormatFromTag(const quint16 &format_tag,
+                                                                                            const quint16 &bits_per_sample);
+    [[nodiscard]] static quint16 bytesPerSample(const GekkoFyre::GkAudioFramework::GkPcmSampleFormat &sample_fmt);
+    [[nodiscard]] static float sampleToFloat(const uchar *src, const GekkoFyre::GkAudioFramework::GkPcmSampleFormat &sample_fmt);
+
+    template <typename T>
+    [[nodiscard]] static constexpr GekkoFyre::GkAudioFramework::GkPcmSampleFormat nativeSampleFormat();
+
+};
+
+/**
+ * @brief GkMmapAudioFile::nativeSampleFormat returns the PCM sample format which maps, byte for byte, onto the given
+ * C++ type. Anything without an exact mapping (i.e. 24-bit PCM) yields `PcmUnknown`.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+template<typename T>
+constexpr GekkoFyre::GkAudioFramework::GkPcmSampleFormat GkMmapAudioFile::nativeSampleFormat()
+{
+    if (std::is_same<T, qint16>::value) {
+        return GekkoFyre::GkAudioFramework::PcmInt16;
+    } else if (std::is_same<T, qint32>::value) {
+        return GekkoFyre::GkAudioFramework::PcmInt32;
+    } else if (std::is_same<T, float>::value) {
+        return GekkoFyre::GkAudioFramework::PcmFloat32;
+    } else if (std::is_same<T, double>::value) {
+        return GekkoFyre::GkAudioFramework::PcmFloat64;
+    }
+
+    return GekkoFyre::GkAudioFramework::PcmUnknown;
+}
+
+/**
+ * @brief GkMmapAudioFile::frames returns a zero-copy view over the requested range of frames, straight from the mapped
+ * file itself. No pages are touched until the samples are actually read, so this is safe to call upon multi-gigabyte
+ * recordings. The range is clamped to the frames actually present within the file.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param start The first frame to be viewed.
+ * @param count The number of frames to be viewed.
+ * @return The view over the given frames, which may be shorter than requested if the end of the file was reached.
+ * @note Use GkMmapAudioFile::readFloat() instead for sample formats that have no native C++ type (i.e. 24-bit PCM).
+ */
+template<typename T>
+GkFrameSpan<T> GkMmapAudioFile::frames(const qint64 &start, const qint64 &count) const
+{
+    #if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    throw std::runtime_error(tr("Zero-copy views of little-endian PCM data are not supported on big-endian systems!").toStdString());
+    #endif
+
+    if (nativeSampleFormat<T>() != m_format.sample_fmt) {
+        throw std::invalid_argument(tr("The requested sample type does not match the PCM encoding of, \"%1\"!")
+                                            .arg(m_filePath.fileName()).toStdString());
+    }
+
+    qint64 first = start;
+    qint64 num = count;
+    clampFrameRange(first, num);
+
+    GkFrameSpan<T> span;
+    span.data = reinterpret_cast<const T *>(m_pcmData + (first * frameSize()));
+    span.frames = num;
+    span.channels = m_format.channels;
+
+    return span;
+}
+};
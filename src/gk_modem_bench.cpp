@@ -0,0 +1,334 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/gk_modem_bench.hpp"
+#include "src/gk_channel_sim.hpp"
+#include "src/gk_ftx_decoder.hpp"
+#include <ctime>
+#include <cmath>
+#include <bitset>
+#include <algorithm>
+#include <QFile>
+#include <QObject>
+#include <QDateTime>
+#include <QTextStream>
+
+#ifdef CODEC2_LIBS_ENBLD
+#include "src/gk_codec2.hpp"
+#endif
+
+using namespace GekkoFyre;
+using namespace Database;
+using namespace Settings;
+using namespace AmateurRadio;
+
+/**
+ * @brief GkModemBenchmark::run measures FT8, FT4 and (should Codec2 be present) FreeDV 700D upon every channel of
+ * GkChannelSimulator::profiles(), at each of a range of SNRs. Everything is seeded, so that any two runs upon the same
+ * build give the same figures for all but the CPU time.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param freq_offset_hz How far the receiver is mistuned from the transmitter.
+ * @param clock_drift_ppm How far the receiving sound-card's clock is off from that of the transmitting one.
+ * @return A result for each modem, channel and SNR, in that order.
+ */
+std::vector<GkModemBenchResult> GkModemBenchmark::run(const double &freq_offset_hz, const double &clock_drift_ppm)
+{
+    try {
+        std::vector<GkModemBenchResult> results;
+        runFtx(FT8, freq_offset_hz, clock_drift_ppm, results);
+        runFtx(FT4, freq_offset_hz, clock_drift_ppm, results);
+
+        #ifdef CODEC2_LIBS_ENBLD
+        runFreeDv(Codec2Mode::freeDvMode700D, QStringLiteral("FreeDV 700D"), freq_offset_hz, clock_drift_ppm, results);
+        #endif
+
+        return results;
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return std::vector<GkModemBenchResult>();
+}
+
+/**
+ * @brief GkModemBenchmark::writeCsv
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param file_path Where the CSV is to be written, with any existing file being replaced.
+ * @param results As given by GkModemBenchmark::run().
+ */
+void GkModemBenchmark::writeCsv(const QString &file_path, const std::vector<GkModemBenchResult> &results)
+{
+    QFile file(file_path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        throw std::runtime_error(QObject::tr("Unable to write the results of the benchmark towards, \"%1\"!").arg(file_path).toStdString());
+    }
+
+    QTextStream stream(&file);
+    stream << "mode,channel,snr_db,freq_offset_hz,clock_drift_ppm,frames_sent,frames_ok,frames_lost,ber,per,goodput_bps,cpu_ms_per_frame\n";
+    for (const auto &result: results) {
+        //
+        // A BER that does not apply (i.e. for FT8 & FT4, where only the decoded messages are known) is left empty
+        stream << result.mode << "," << result.channel << "," << QString::number(result.snr_db, 'f', 1) << ","
+               << QString::number(result.freq_offset_hz, 'f', 1) << "," << QString::number(result.clock_drift_ppm, 'f', 1) << ","
+               << result.frames_sent << "," << result.frames_ok << "," << result.frames_lost << "," << ((result.ber < 0.0) ? QString() : QString::number(result.ber, 'e', 3)) << ","
+               << QString::number(result.per, 'f', 3) << "," << QString::number(result.goodput_bps, 'f', 1) << ","
+               << QString::number(result.cpu_ms_per_frame, 'f', 3) << "\n";
+    }
+
+    file.close();
+
+    return;
+}
+
+/**
+ * @brief GkModemBenchmark::runFtx sends a single random message within each of a number of slots, at a random audio
+ * frequency, and counts those slots where it is decoded. The LDPC code is the very same as is used on the air, as
+ * bundled within the application's resources.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param mode Either FT8 or FT4.
+ * @param freq_offset_hz How far the receiver is mistuned from the transmitter.
+ * @param clock_drift_ppm How far the receiving sound-card's clock is off from that of the transmitting one.
+ * @param results Where a result for each channel and SNR is added.
+ */
+void GkModemBenchmark::runFtx(const DigitalModes &mode, const double &freq_offset_hz, const double &clock_drift_ppm,
+                              std::vector<GkModemBenchResult> &results)
+{
+    const auto &protocol = GkFtxProtocol::get(mode);
+    const auto ldpc = GkFtxLdpc::bundled();
+    GkFtxDecoder decoder(mode, ldpc, QPointer<GkEventLogger>(), 1);
+
+    const auto count = static_cast<size_t>(std::ceil(protocol.decode_secs * GK_FTX_SAMPLE_RATE));
+    const double bandwidth = protocol.num_tones * protocol.toneSpacing();
+    const double signal_rms = GK_MODEM_BENCH_FTX_AMPLITUDE / std::sqrt(2.0);
+    std::vector<qint16> sent_audio(count);
+    std::vector<qint16> received_audio;
+    std::vector<float> audio(count);
+    std::vector<quint8> tones;
+
+    quint32 seed = 0;
+    for (const auto &profile: GkChannelSimulator::profiles()) {
+        for (qint32 snr_db = GK_MODEM_BENCH_FTX_MIN_SNR_DB; snr_db <= GK_MODEM_BENCH_FTX_MAX_SNR_DB; snr_db += GK_MODEM_BENCH_STEP_SNR_DB) {
+            std::mt19937 rng(++seed);
+            std::uniform_real_distribution<double> freq_dist(GK_FTX_MIN_FREQ_HZ + 300.0, GK_FTX_MAX_FREQ_HZ - 300.0 - bandwidth);
+            GkChannelSimulator channel(GK_FTX_SAMPLE_RATE, seed);
+            channel.setFrequencyOffset(freq_offset_hz);
+            channel.setProfile(profile);
+            channel.setClockDrift(clock_drift_ppm);
+            channel.setNoise(snr_db, signal_rms, GK_FTX_SNR_BANDWIDTH_HZ);
+            received_audio.resize(channel.maxOutput(count));
+
+            GkModemBenchResult result;
+            result.mode = (mode == FT8) ? QStringLiteral("FT8") : QStringLiteral("FT4");
+            result.channel = profile.name;
+            result.snr_db = snr_db;
+            result.freq_offset_hz = freq_offset_hz;
+            result.clock_drift_ppm = clock_drift_ppm;
+
+            std::clock_t cpu_ticks = 0;
+            for (quint32 slot = 0; slot < GK_MODEM_BENCH_FTX_SLOTS; ++slot) {
+                const QString message = QString("%1 %2 RR73").arg(GkFtxBenchmark::randomCall(rng), GkFtxBenchmark::randomCall(rng));
+                if (!GkFtxMessage::toTones(protocol, *ldpc, message, tones)) {
+                    continue;
+                }
+
+                std::fill(sent_audio.begin(), sent_audio.end(), 0);
+                const double freq = freq_dist(rng);
+                const auto offset = static_cast<size_t>(std::llround(protocol.start_secs * GK_FTX_SAMPLE_RATE));
+                double phase = 0.0;
+                for (size_t sym = 0; sym < tones.size(); ++sym) {
+                    const double step = (2.0 * M_PI * (freq + tones[sym] * protocol.toneSpacing())) / GK_FTX_SAMPLE_RATE;
+                    for (quint32 j = 0; j < protocol.symbol_samples; ++j) {
+                        const size_t pos = offset + (sym * protocol.symbol_samples) + j;
+                        if (pos < count) {
+                            sent_audio[pos] = static_cast<qint16>(std::lrint(GK_MODEM_BENCH_FTX_AMPLITUDE * std::sin(phase)));
+                        }
+
+                        phase += step;
+                    }
+                }
+
+                //
+                // Clock drift stretches or shrinks the slot slightly, so it is cut short or padded with silence as need be
+                const size_t received = channel.process(sent_audio.data(), count, received_audio.data());
+                for (size_t i = 0; i < count; ++i) {
+                    audio[i] = (i < received) ? (received_audio[i] / 32768.0f) : 0.0f;
+                }
+
+                const std::clock_t start = std::clock();
+                const auto decodes = decoder.decodeSlot(audio.data(), audio.size(), QDateTime::currentDateTimeUtc());
+                cpu_ticks += std::clock() - start;
+
+                ++result.frames_sent;
+                if (std::any_of(decodes.begin(), decodes.end(), [&message](const GkFtxDecode &decode) { return decode.message == message; })) {
+                    ++result.frames_ok;
+                }
+            }
+
+            if (result.frames_sent > 0) {
+                result.frames_lost = result.frames_sent - result.frames_ok;
+                result.per = 1.0 - (static_cast<double>(result.frames_ok) / result.frames_sent);
+                result.goodput_bps = (result.frames_ok * 77.0) / (result.frames_sent * protocol.slot_secs);
+                result.cpu_ms_per_frame = ((1000.0 * cpu_ticks) / CLOCKS_PER_SEC) / result.frames_sent;
+            }
+
+            results.push_back(result);
+        }
+    }
+
+    return;
+}
+
+#ifdef CODEC2_LIBS_ENBLD
+/**
+ * @brief GkModemBenchmark::runFreeDv sends a run of modem frames filled with random data, and matches each frame that
+ * comes out of the receiver against those that were sent. Frames are matched by the least Hamming distance to those
+ * shortly after the last match, so that a frame lost outright does not throw off the rest.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param mode A mode of FreeDV that supports raw data.
+ * @param mode_name How the mode is to be named within the results.
+ * @param freq_offset_hz How far the receiver is mistuned from the transmitter.
+ * @param clock_drift_ppm How far the receiving sound-card's clock is off from that of the transmitting one.
+ * @param results Where a result for each channel and SNR is added.
+ */
+void GkModemBenchmark::runFreeDv(const Codec2Mode &mode, const QString &mode_name, const double &freq_offset_hz,
+                                 const double &clock_drift_ppm, std::vector<GkModemBenchResult> &results)
+{
+    GkCodec2 sender(mode, Codec2ModeCustom::Disabled, 0, 0, nullptr, nullptr, nullptr);
+    const size_t frame_bytes = sender.getBytesPerFrame();
+    const size_t frame_samples = sender.getSamplesPerFrame();
+    const quint32 sample_rate = sender.getModemSampleRate();
+    const size_t frame_bits = frame_bytes * 8;
+
+    //
+    // The frames of data are padded either side with empty frames, as GkCodec2::transmitBurst() does
+    const size_t padding_bytes = GK_CODEC2_TX_PADDING_FRAMES * frame_bytes;
+    const size_t data_bytes = GK_MODEM_BENCH_FREEDV_FRAMES * frame_bytes;
+    std::vector<quint8> burst(padding_bytes + data_bytes + padding_bytes, 0);
+    std::mt19937 rng(0x5eed);
+    for (size_t i = 0; i < data_bytes; ++i) {
+        burst[padding_bytes + i] = static_cast<quint8>(rng() & 0xFF);
+    }
+
+    std::vector<qint16> sent_audio(sender.getSamplesForBytes(burst.size()));
+    sent_audio.resize(sender.modulate(burst.data(), burst.size(), sent_audio.data(), sent_audio.size()));
+    const size_t data_offset = GK_CODEC2_TX_PADDING_FRAMES * frame_samples;
+    const double signal_rms = GkChannelSimulator::measureRms(sent_audio.data() + data_offset, GK_MODEM_BENCH_FREEDV_FRAMES * frame_samples);
+    const double airtime_secs = static_cast<double>(sent_audio.size()) / sample_rate;
+    std::vector<qint16> received_audio;
+
+    quint32 seed = 0;
+    for (const auto &profile: GkChannelSimulator::profiles()) {
+        for (qint32 snr_db = GK_MODEM_BENCH_FREEDV_MIN_SNR_DB; snr_db <= GK_MODEM_BENCH_FREEDV_MAX_SNR_DB; snr_db += GK_MODEM_BENCH_STEP_SNR_DB) {
+            GkChannelSimulator channel(sample_rate, ++seed);
+            channel.setFrequencyOffset(freq_offset_hz);
+            channel.setProfile(profile);
+            channel.setClockDrift(clock_drift_ppm);
+            channel.setNoise(snr_db, signal_rms);
+            received_audio.resize(channel.maxOutput(sent_audio.size()));
+            const size_t received = channel.process(sent_audio.data(), sent_audio.size(), received_audio.data());
+
+            std::vector<std::vector<quint8>> frames;
+            GkCodec2 receiver(mode, Codec2ModeCustom::Disabled, 0, 0, nullptr, nullptr, nullptr);
+            receiver.setRxCallback([&frames](const quint8 *payload, const size_t &bytes) {
+                frames.emplace_back(payload, payload + bytes);
+            });
+
+            const std::clock_t start = std::clock();
+            receiver.demodulate(received_audio.data(), received);
+            const std::clock_t cpu_ticks = std::clock() - start;
+
+            GkModemBenchResult result;
+            result.mode = mode_name;
+            result.channel = profile.name;
+            result.snr_db = snr_db;
+            result.freq_offset_hz = freq_offset_hz;
+            result.clock_drift_ppm = clock_drift_ppm;
+            result.frames_sent = GK_MODEM_BENCH_FREEDV_FRAMES;
+
+            //
+            // Anything further than a quarter of its bits from every frame that was sent is taken to be the padding, or
+            // a false sync, rather than a frame of data
+            size_t cursor = 0;
+            quint64 bit_errors = 0;
+            quint32 frames_matched = 0;
+            for (const auto &frame: frames) {
+                size_t best_frame = 0;
+                size_t best_distance = frame_bits + 1;
+                const size_t last = std::min<size_t>(cursor + GK_CODEC2_TX_PADDING_FRAMES + 2, GK_MODEM_BENCH_FREEDV_FRAMES);
+                for (size_t i = cursor; i < last; ++i) {
+                    const quint8 *sent = burst.data() + padding_bytes + (i * frame_bytes);
+                    size_t distance = 0;
+                    for (size_t j = 0; j < std::min(frame_bytes, frame.size()); ++j) {
+                        distance += std::bitset<8>(static_cast<quint8>(sent[j] ^ frame[j])).count();
+                    }
+
+                    if (distance < best_distance) {
+                        best_distance = distance;
+                        best_frame = i;
+                    }
+                }
+
+                if (best_distance > (frame_bits / 4)) {
+                    continue;
+                }
+
+                cursor = best_frame + 1;
+                bit_errors += best_distance;
+                ++frames_matched;
+                if (best_distance == 0) {
+                    ++result.frames_ok;
+                }
+            }
+
+            //
+            // Frames that were never received at all have no bits to count, so are reported alongside the BER instead
+            result.frames_lost = GK_MODEM_BENCH_FREEDV_FRAMES - frames_matched;
+            result.ber = (frames_matched > 0) ? (static_cast<double>(bit_errors) / (static_cast<double>(frames_matched) * frame_bits)) : -1.0;
+            result.per = 1.0 - (static_cast<double>(result.frames_ok) / result.frames_sent);
+            result.goodput_bps = (result.frames_ok * static_cast<double>(frame_bits)) / airtime_secs;
+            result.cpu_ms_per_frame = ((1000.0 * cpu_ticks) / CLOCKS_PER_SEC) / (GK_MODEM_BENCH_FREEDV_FRAMES + (2 * GK_CODEC2_TX_PADDING_FRAMES));
+            results.push_back(result);
+        }
+    }
+
+    return;
+}
+#endif
@@ -0,0 +1,71 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include <vector>
+#include <QString>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkModemBenchmark measures each modem against the HF channels of GkChannelSimulator, across a range of SNRs,
+ * so that a change towards any modem may be compared with how it fared beforehand. The results may be written out as
+ * CSV, one row for each modem, channel and SNR.
+ */
+class GkModemBenchmark {
+
+public:
+    [[nodiscard]] static std::vector<GekkoFyre::AmateurRadio::GkModemBenchResult> run(const double &freq_offset_hz = 0.0,
+                                                                                      const double &clock_drift_ppm = 0.0);
+    static void writeCsv(const QString &file_path, const std::vector<GekkoFyre::AmateurRadio::GkModemBenchResult> &results);
+
+private:
+    static void runFtx(const GekkoFyre::AmateurRadio::DigitalModes &mode, const double &freq_offset_hz, const double &clock_drift_ppm,
+                       std::vector<GekkoFyre::AmateurRadio::GkModemBenchResult> &results);
+    #ifdef CODEC2_LIBS_ENBLD
+    static void runFreeDv(const Database::Settings::Codec2Mode &mode, const QString &mode_name, const double &freq_offset_hz,
+                          const double &clock_drift_ppm, std::vector<GekkoFyre::AmateurRadio::GkModemBenchResult> &results);
+    #endif
+
+};
+};
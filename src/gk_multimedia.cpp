@@ -73,21 +73,23 @@ using namespace GkXmpp;
  */
 GkMultimedia::GkMultimedia(QPointer<GekkoFyre::GkAudioDevices> audio_devs, std::vector<GkDevice> sysOutputAudioDevs,
                            std::vector<GkDevice> sysInputAudioDevs, QPointer<GekkoFyre::GkLevelDb> database,
-                           QPointer<GekkoFyre::StringFuncs> stringFuncs, QPointer<GekkoFyre::GkEventLogger> eventLogger,
-                           QObject *parent) : gkAudioState(GkAudioState::Stopped), m_frameSize(0), m_recordBuffer(0),
+                           QPointer<GekkoFyre::StringFuncs> stringFuncs, QPointer<GekkoFyre::GkAudioMixer> audioMixer,
+                           QPointer<GekkoFyre::GkEventLogger> eventLogger, QObject *parent)
+                           : gkAudioState(GkAudioState::Stopped), m_playbackVoice(0), m_frameSize(0), m_recordBuffer(0),
                            QObject(parent)
 {
     gkAudioDevices = std::move(audio_devs);
     gkDb = std::move(database);
     gkStringFuncs = std::move(stringFuncs);
+    gkAudioMixer = std::move(audioMixer);
     gkEventLogger = std::move(eventLogger);
 
     gkSysOutputAudioDevs = std::move(sysOutputAudioDevs);
     gkSysInputAudioDevs = std::move(sysInputAudioDevs);
 
-    //
-    // Initialize variables
-    audioPlaybackSource = 0;
+    if (gkAudioMixer) {
+        QObject::connect(gkAudioMixer, SIGNAL(voiceFinished(const quint64 &)), this, SLOT(playbackVoiceFinished(const quint64 &)));
+    }
 
     //
     // Initialize variables within audio devices
@@ -102,6 +104,10 @@ GkMultimedia::GkMultimedia(QPointer<GekkoFyre::GkAudioDevices> audio_devs, std::
 
 GkMultimedia::~GkMultimedia()
 {
+    if (m_playbackVoice != 0 && gkAudioMixer) {
+        gkAudioMixer->stopVoice(m_playbackVoice);
+    }
+
     if (playAudioFileThread.joinable() || recordAudioFileThread.joinable()) {
         emit updateAudioState(GkAudioState::Stopped); // Stop the playing and/or recording of all audio files!
     }
@@ -143,88 +149,6 @@ CodecSupport GkMultimedia::convAudioCodecIdxToEnum(const qint32 &codec_id_str)
     return CodecSupport::Unknown;
 }
 
-/**
- * @brief GkMultimedia::loadAudioFile loads an audio file along with its properties into memory and creates an OpenAL
- * audio buffer along the way, ready for audio playback.
- * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param file_path The canonical path to the given audio file to be analyzed and then loaded into memory.
- * @return The thusly created OpenAL audio buffer.
- * @note OpenAL Source Play Example <https://github.com/kcat/openal-soft/blob/master/examples/alplay.c>.
- */
-ALuint GkMultimedia::loadAudioFile(const QFileInfo &file_path)
-{
-    try {
-        ALenum format;
-        ALuint buffer;
-        SNDFILE *sndfile;
-        SF_INFO sfinfo;
-        short *membuf;
-        sf_count_t num_frames;
-        ALsizei num_bytes;
-
-        //
-        // Initialize libsndfile!
-        sndfile = sf_open(file_path.canonicalFilePath().toStdString().c_str(), SFM_READ, &sfinfo);
-        if (!sndfile) {
-            throw std::runtime_error(tr("Unable to open audio file and thusly initialize libsndfile, \"%1\"!")
-                                             .arg(file_path.canonicalFilePath()).toStdString());
-        }
-
-        if (sfinfo.frames < 1 || sfinfo.frames > (sf_count_t)(INT_MAX / sizeof(short)) / sfinfo.channels) {
-            throw std::runtime_error(tr("Bad sample count in, \"%1\" (%2 frames)!")
-                                             .arg(file_path.canonicalFilePath(), sfinfo.frames).toStdString());
-        }
-
-        //
-        // Obtain the sound format, and then determine the OpenAL format!
-        format = AL_NONE;
-        if (sfinfo.channels == 1) {
-            format = AL_FORMAT_MONO16;
-        } else if (sfinfo.channels == 2) {
-            format = AL_FORMAT_STEREO16;
-        } else if (sfinfo.channels == 3) {
-            if (sf_command(sndfile, SFC_WAVEX_GET_AMBISONIC, nullptr, 0) == SF_AMBISONIC_B_FORMAT) {
-                format = AL_FORMAT_BFORMAT2D_16;
-            }
-        } else if (sfinfo.channels == 4) {
-            if (sf_command(sndfile, SFC_WAVEX_GET_AMBISONIC, nullptr, 0) == SF_AMBISONIC_B_FORMAT) {
-                format = AL_FORMAT_BFORMAT3D_16;
-            }
-        } else {
-            sf_close(sndfile);
-            throw std::invalid_argument(tr("Unsupported number of audio channels given: \"%1 channels\"!")
-                                                .arg(QString::number(sfinfo.channels)).toStdString());
-        }
-
-        //
-        // Decode the entire audio file to a given buffer!
-        membuf = static_cast<short *>(malloc((size_t) (sfinfo.frames * sfinfo.channels) * sizeof(short)));
-        num_frames = sf_readf_short(sndfile, membuf, sfinfo.frames);
-        if (num_frames < 1) {
-            std::free(membuf);
-            sf_close(sndfile);
-            throw std::runtime_error(tr("Failed to read samples in %1 (%2 frames)!")
-                                             .arg(file_path.canonicalFilePath(), QString::number(num_frames)).toStdString());
-        }
-
-        num_bytes = (ALsizei)(num_frames * sfinfo.channels) * (ALsizei)sizeof(short);
-
-        //
-        // Buffer the audio data into a new buffer object, then free the data and close the given file!
-        alCall(alGenBuffers, GK_AUDIO_STREAM_NUM_BUFS, &buffer);
-        alBufferData(buffer, format, membuf, num_bytes, sfinfo.samplerate);
-
-        std::free(membuf);
-        sf_close(sndfile);
-
-        return buffer;
-    } catch (const std::exception &e) {
-        std::throw_with_nested(std::runtime_error(e.what()));;
-    }
-
-    return ALuint();
-}
-
 /**
  * @brief GkMultimedia::checkForFileToBeginRecording initiates the first process/function in beginning a sequence to
  * record towards a given file, in that it asks the end-user what to do in the event of an already existing file,
@@ -765,10 +689,10 @@ void GkMultimedia::checkOpenAlExtensions()
 
 /**
  * @brief GkMultimedia::playAudioFile will attempt to play an audio file of any, given, supported audio format provided
- * it's either supported by FFmpeg or it's simply a WAV file.
+ * it's either supported by libsndfile or it's simply a WAV file, by handing it over to the audio mixer.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
  * @param file_path The canonical, or in this use case, the absolute path to the given audio file to be played.
- * @note OpenAL Source Play Example <https://github.com/kcat/openal-soft/blob/master/examples/alplay.c>.
+ * @see GkAudioMixer::playFile().
  */
 void GkMultimedia::playAudioFile(const QFileInfo &file_path)
 {
@@ -779,46 +703,22 @@ void GkMultimedia::playAudioFile(const QFileInfo &file_path)
                 //
                 // We are working with a file
                 if (file_path.isReadable()) {
-                    const auto outputAudioDev = getOutputAudioDevice();
-                    if (outputAudioDev.isEnabled && outputAudioDev.alDevice && outputAudioDev.alDeviceCtx &&
-                        !outputAudioDev.isStreaming) {
-                        ALfloat offset;
-                        ALenum state;
-
-                        auto buffer = loadAudioFile(file_path);
-                        if (!buffer) {
-                            throw std::invalid_argument(tr("Error encountered with creating OpenAL buffer!").toStdString());
-                        }
-
+                    if (gkAudioMixer && gkAudioMixer->isRunning()) {
                         //
-                        // Create the source to play the sound with!
-                        alCall(alGenSources, 1, &audioPlaybackSource);
-                        alCall(alSourcef, audioPlaybackSource, AL_PITCH, 1);
-                        alCall(alSourcef, audioPlaybackSource, AL_GAIN, 1.0f);
-                        alCall(alSource3f, audioPlaybackSource, AL_POSITION, 0, 0, 0);
-                        alCall(alSource3f, audioPlaybackSource, AL_VELOCITY, 0, 0, 0);
-                        alCall(alSourcei, audioPlaybackSource, AL_BUFFER, (ALint)buffer);
-
-                        //
-                        // NOTE: If the audio is played faster, then the sampling rate might be incorrect. Check if
-                        // the input sample rate for the re-sampler is the same as in the decoder. AND the output
-                        // sample rate is the same you use in the encoder.
+                        // The mixer thread takes care of the actual playback, so all that is left to do here is to
+                        // decode (or memory-map) the file and hand it over!
                         //
-                        alCall(alSourcePlay, audioPlaybackSource);
-                        do {
-                            std::this_thread::sleep_for(std::chrono::milliseconds(GK_AUDIO_VOL_PLAYBACK_REFRESH_INTERVAL));
-                            alGetSourcei(audioPlaybackSource, AL_SOURCE_STATE, &state);
-
-                            alGetSourcef(audioPlaybackSource, AL_SEC_OFFSET, &offset);
-                            printf("\rOffset: %f  ", offset);
-                            fflush(stdout);
-                        } while (alGetError() == AL_NO_ERROR && state == AL_PLAYING && gkAudioState == GkAudioState::Playing);
+                        const quint64 voice_id = gkAudioMixer->playFile(file_path, m_playbackGain);
+                        if (voice_id == 0) {
+                            throw std::invalid_argument(tr("Unable to begin playback of audio file, \"%1\"!").arg(file_path.fileName()).toStdString());
+                        }
 
-                        //
-                        // Cleanup now as we're done!
-                        alCall(alDeleteSources, GK_AUDIO_STREAM_NUM_BUFS, &audioPlaybackSource);
-                        alCall(alDeleteBuffers, GK_AUDIO_STREAM_NUM_BUFS, &buffer);
-                        emit playingFinished();
+                        m_playbackVoice = voice_id;
+                        if (gkAudioState != GkAudioState::Playing) {
+                            //
+                            // Playback was stopped while the file was still being decoded!
+                            gkAudioMixer->stopVoice(voice_id);
+                        }
 
                         return;
                     } else {
@@ -1026,6 +926,9 @@ void GkMultimedia::mediaAction(const GkAudioState &media_state, const QFileInfo
 void GkMultimedia::setAudioState(const GkAudioState &audioState)
 {
     gkAudioState = audioState;
+    if (audioState != GkAudioState::Playing && m_playbackVoice != 0 && gkAudioMixer) {
+        gkAudioMixer->stopVoice(m_playbackVoice);
+    }
 
     return;
 }
@@ -1038,9 +941,25 @@ void GkMultimedia::setAudioState(const GkAudioState &audioState)
  */
 void GkMultimedia::changeVolume(const qint32 &value)
 {
-    if (gkAudioState == GkAudioState::Playing) {
-        const qreal calc_val = static_cast<qreal>(value / 100);
-        alCall(alSourcef, audioPlaybackSource, AL_GAIN, calc_val);
+    m_playbackGain = static_cast<float>(value) / 100.0f;
+    if (gkAudioState == GkAudioState::Playing && m_playbackVoice != 0 && gkAudioMixer) {
+        gkAudioMixer->setVoiceGain(m_playbackVoice, m_playbackGain);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkMultimedia::playbackVoiceFinished is notified by the audio mixer whenever one of its voices has finished
+ * playing, so that we may know when the audio file that we were playing has come to an end.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param voice_id The identifier of the voice that has finished.
+ */
+void GkMultimedia::playbackVoiceFinished(const quint64 &voice_id)
+{
+    quint64 expected = voice_id;
+    if (voice_id != 0 && m_playbackVoice.compare_exchange_strong(expected, 0)) {
+        emit playingFinished();
     }
 
     return;
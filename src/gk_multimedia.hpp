@@ -46,10 +46,12 @@
 #include "src/gk_string_funcs.hpp"
 #include "src/dek_db.hpp"
 #include "src/audio_devices.hpp"
+#include "src/gk_audio_mixer.hpp"
 #include <AL/al.h>
 #include <AL/alc.h>
 #include <AL/alext.h>
 #include <mutex>
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <string>
@@ -84,7 +86,8 @@ public:
                           std::vector<GekkoFyre::Database::Settings::Audio::GkDevice> sysOutputAudioDevs,
                           std::vector<GekkoFyre::Database::Settings::Audio::GkDevice> sysInputAudioDevs,
                           QPointer<GekkoFyre::GkLevelDb> database, QPointer<GekkoFyre::StringFuncs> stringFuncs,
-                          QPointer<GekkoFyre::GkEventLogger> eventLogger, QObject *parent = nullptr);
+                          QPointer<GekkoFyre::GkAudioMixer> audioMixer, QPointer<GekkoFyre::GkEventLogger> eventLogger,
+                          QObject *parent = nullptr);
     ~GkMultimedia() override;
 
     [[nodiscard]] GekkoFyre::Database::Settings::Audio::GkDevice getOutputAudioDevice();
@@ -100,6 +103,9 @@ public slots:
     void setAudioState(const GekkoFyre::GkAudioFramework::GkAudioState &audioState);
     void changeVolume(const qint32 &value);
 
+private slots:
+    void playbackVoiceFinished(const quint64 &voice_id);
+
 signals:
     void playingFinished();
     void recordingFinished();
@@ -109,6 +115,7 @@ private:
     QPointer<GekkoFyre::GkAudioDevices> gkAudioDevices;
     QPointer<GekkoFyre::GkLevelDb> gkDb;
     QPointer<GekkoFyre::StringFuncs> gkStringFuncs;
+    QPointer<GekkoFyre::GkAudioMixer> gkAudioMixer;
     QPointer<GekkoFyre::GkEventLogger> gkEventLogger;
 
     //
@@ -122,11 +129,11 @@ private:
     std::vector<GekkoFyre::Database::Settings::Audio::GkDevice> gkSysInputAudioDevs;
     GekkoFyre::GkAudioFramework::GkAudioState gkAudioState;
 
-    ALuint audioPlaybackSource;
+    std::atomic<quint64> m_playbackVoice;                                       // The audio mixer's voice for the file being played, if any.
+    float m_playbackGain = 1.0f;
     ALuint m_frameSize;
     std::shared_ptr<std::vector<ALshort>> m_recordBuffer;
 
-    [[nodiscard]] ALuint loadAudioFile(const QFileInfo &file_path);
     void checkForFileToBeginRecording(const QFileInfo &file_path);
     [[nodiscard]] QString convAudioCodecToFileExtStr(GkAudioFramework::CodecSupport codec_id);
 
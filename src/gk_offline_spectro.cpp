@@ -0,0 +1,433 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/gk_offline_spectro.hpp"
+#include <cmath>
+#include <chrono>
+#include <future>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <exception>
+#include <QFile>
+#include <QDateTime>
+#include <QDataStream>
+
+using namespace GekkoFyre;
+using namespace GkAudioFramework;
+using namespace Spectrograph;
+using namespace System;
+using namespace Events;
+using namespace Logging;
+
+/**
+ * @brief GkOfflineSpectro::GkOfflineSpectro generates spectrograph / waterfall products from recorded audio files, rather
+ * than from the live audio stream as does `GkFFTAudio`.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param eventLogger The event logging class.
+ * @param parent The parent object to this class.
+ */
+GkOfflineSpectro::GkOfflineSpectro(QPointer<GkEventLogger> eventLogger, QObject *parent) : m_cancelled(false),
+                                                                                          m_rowsDone(0), QObject(parent)
+{
+    gkEventLogger = std::move(eventLogger);
+    qRegisterMetaType<std::shared_ptr<GekkoFyre::Spectrograph::GkSpectroProduct>>("std::shared_ptr<GekkoFyre::Spectrograph::GkSpectroProduct>");
+
+    return;
+}
+
+GkOfflineSpectro::~GkOfflineSpectro()
+{
+    cancel();
+    joinGenerateThread();
+}
+
+/**
+ * @brief GkOfflineSpectro::generate runs the given audio file through the FFT, with the rows being split into chunks that
+ * are then processed in parallel across all of the available processor cores. Each worker has its own FFT plan and
+ * scratch buffers, and writes directly into its own region of the pre-allocated product, so no locking is required.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param audioFile The memory-mapped audio file to be analysed.
+ * @param quant Whether to store the rows as floats or to quantise them down towards 8-bits.
+ * @param fft_size The size of the FFT used for each row, which must be an even number.
+ * @param hop_size The number of frames to advance by between each row.
+ * @param start_epoch_ms The time of the very first frame within the audio file, as a UNIX epoch in milliseconds.
+ * @return The spectrograph / waterfall product, or nullptr if the generation was cancelled.
+ */
+std::shared_ptr<GkSpectroProduct> GkOfflineSpectro::generate(const GkMmapAudioFile &audioFile, const GkSpectroQuant &quant,
+                                                             const quint32 &fft_size, const quint32 &hop_size,
+                                                             const qint64 &start_epoch_ms)
+{
+    try {
+        if (fft_size < 2 || (fft_size % 2) != 0 || hop_size == 0) {
+            throw std::invalid_argument(tr("An invalid FFT size and/or hop size has been given!").toStdString());
+        }
+
+        const auto pcm_fmt = audioFile.getFormat();
+        if (audioFile.frameCount() < static_cast<qint64>(fft_size)) {
+            throw std::invalid_argument(tr("Audio file, \"%1\", is too short to be analysed!")
+                                                .arg(audioFile.getFilePath().fileName()).toStdString());
+        }
+
+        auto product = std::make_shared<GkSpectroProduct>();
+        product->quant = quant;
+        product->sample_rate = pcm_fmt.sample_rate;
+        product->fft_size = fft_size;
+        product->hop_size = hop_size;
+        product->num_bins = (fft_size / 2) + 1;
+        product->num_rows = static_cast<quint64>((audioFile.frameCount() - fft_size) / hop_size) + 1;
+        product->freq_min = 0.0;
+        product->freq_max = static_cast<double>(pcm_fmt.sample_rate) / 2.0;
+        product->db_floor = static_cast<float>(SPECTRO_OFFLINE_DB_FLOOR);
+        product->db_ceiling = static_cast<float>(SPECTRO_OFFLINE_DB_CEILING);
+
+        const size_t num_cells = product->num_rows * product->num_bins;
+        if (quant == SpectroUint8) {
+            product->rows_u8.resize(num_cells);
+        } else {
+            product->rows_f32.resize(num_cells);
+        }
+
+        product->timestamps.resize(product->num_rows);
+        for (quint64 i = 0; i < product->num_rows; ++i) {
+            product->timestamps[i] = start_epoch_ms + static_cast<qint64>((static_cast<double>(i) * hop_size * 1000.0) / pcm_fmt.sample_rate);
+        }
+
+        //
+        // Hann window, along with the factor needed to normalize the output towards dBFS!
+        std::vector<float> window(fft_size);
+        double window_sum = 0.0;
+        for (quint32 i = 0; i < fft_size; ++i) {
+            window[i] = static_cast<float>(0.5 * (1.0 - std::cos((2.0 * M_PI * i) / (fft_size - 1))));
+            window_sum += window[i];
+        }
+
+        const auto norm = static_cast<float>(2.0 / window_sum);
+
+        m_rowsDone = 0;
+
+        const quint64 num_threads = std::max<quint64>(1, std::thread::hardware_concurrency());
+        const quint64 rows_per_chunk = (product->num_rows + num_threads - 1) / num_threads;
+        std::vector<std::future<void>> workers;
+        for (quint64 first_row = 0; first_row < product->num_rows; first_row += rows_per_chunk) {
+            const quint64 last_row = std::min(first_row + rows_per_chunk, product->num_rows);
+            workers.emplace_back(std::async(std::launch::async, &GkOfflineSpectro::generateRows, this, std::cref(audioFile),
+                                            std::ref(*product), first_row, last_row, std::cref(window), norm));
+        }
+
+        for (auto &worker: workers) {
+            worker.get();
+        }
+
+        if (m_cancelled) {
+            return nullptr;
+        }
+
+        return product;
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief GkOfflineSpectro::saveProduct writes a spectrograph / waterfall product out towards storage, so that it may be
+ * viewed again without having to re-analyse the original audio file.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param product The product to be saved.
+ * @param file_path Where the product is to be saved towards.
+ */
+void GkOfflineSpectro::saveProduct(const GkSpectroProduct &product, const QFileInfo &file_path)
+{
+    QFile file(file_path.absoluteFilePath());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        throw std::runtime_error(tr("Unable to open file, \"%1\", for writing: %2").arg(file_path.fileName(), file.errorString()).toStdString());
+    }
+
+    QDataStream out(&file);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    out << static_cast<quint32>(SPECTRO_OFFLINE_PRODUCT_MAGIC) << static_cast<quint32>(SPECTRO_OFFLINE_PRODUCT_VERS);
+    out << static_cast<quint32>(product.quant) << product.sample_rate << product.fft_size << product.hop_size;
+    out << product.num_bins << static_cast<quint64>(product.num_rows) << product.db_floor << product.db_ceiling;
+
+    for (const auto &timestamp: product.timestamps) {
+        out << timestamp;
+    }
+
+    if (product.quant == SpectroUint8) {
+        out.writeRawData(reinterpret_cast<const char *>(product.rows_u8.data()), static_cast<int>(product.rows_u8.size()));
+    } else {
+        for (const auto &cell: product.rows_f32) {
+            out << cell;
+        }
+    }
+
+    if (out.status() != QDataStream::Ok) {
+        throw std::runtime_error(tr("Unable to write out spectrograph data towards, \"%1\"!").arg(file_path.fileName()).toStdString());
+    }
+
+    return;
+}
+
+/**
+ * @brief GkOfflineSpectro::loadProduct reads back a spectrograph / waterfall product that was previously saved.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param file_path The file to be read.
+ * @return The spectrograph / waterfall product.
+ * @see GkOfflineSpectro::saveProduct().
+ */
+std::shared_ptr<GkSpectroProduct> GkOfflineSpectro::loadProduct(const QFileInfo &file_path)
+{
+    QFile file(file_path.absoluteFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw std::runtime_error(tr("Unable to open file, \"%1\", for reading: %2").arg(file_path.fileName(), file.errorString()).toStdString());
+    }
+
+    QDataStream in(&file);
+    in.setByteOrder(QDataStream::LittleEndian);
+    in.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != SPECTRO_OFFLINE_PRODUCT_MAGIC || version != SPECTRO_OFFLINE_PRODUCT_VERS) {
+        throw std::invalid_argument(tr("File, \"%1\", is not a spectrograph product of a supported version!").arg(file_path.fileName()).toStdString());
+    }
+
+    auto product = std::make_shared<GkSpectroProduct>();
+    quint32 quant = 0;
+    quint64 num_rows = 0;
+    in >> quant >> product->sample_rate >> product->fft_size >> product->hop_size;
+    in >> product->num_bins >> num_rows >> product->db_floor >> product->db_ceiling;
+    product->quant = static_cast<GkSpectroQuant>(quant);
+    product->num_rows = num_rows;
+    product->freq_min = 0.0;
+    product->freq_max = static_cast<double>(product->sample_rate) / 2.0;
+
+    //
+    // Guard against corrupt headers before allocating anything!
+    const quint64 cell_size = (product->quant == SpectroUint8) ? sizeof(quint8) : sizeof(float);
+    if ((num_rows * (sizeof(qint64) + (product->num_bins * cell_size))) > static_cast<quint64>(file.size())) {
+        throw std::invalid_argument(tr("Spectrograph product, \"%1\", is truncated!").arg(file_path.fileName()).toStdString());
+    }
+
+    product->timestamps.resize(num_rows);
+    for (auto &timestamp: product->timestamps) {
+        in >> timestamp;
+    }
+
+    const size_t num_cells = num_rows * product->num_bins;
+    if (product->quant == SpectroUint8) {
+        product->rows_u8.resize(num_cells);
+        in.readRawData(reinterpret_cast<char *>(product->rows_u8.data()), static_cast<int>(num_cells));
+    } else {
+        product->rows_f32.resize(num_cells);
+        for (auto &cell: product->rows_f32) {
+            in >> cell;
+        }
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        throw std::runtime_error(tr("Unable to read in spectrograph data from, \"%1\"!").arg(file_path.fileName()).toStdString());
+    }
+
+    return product;
+}
+
+/**
+ * @brief GkOfflineSpectro::generateFromFile maps the given audio file and generates its spectrograph / waterfall product
+ * upon a background thread, emitting `spectroProductReady()` once finished.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param file_path The WAV/RF64 file to be analysed.
+ * @param quant Whether to store the rows as floats or to quantise them down towards 8-bits.
+ */
+void GkOfflineSpectro::generateFromFile(const QFileInfo &file_path, const GkSpectroQuant &quant)
+{
+    cancel();
+    joinGenerateThread();
+    m_cancelled = false;
+
+    generateThread = std::thread([this, file_path, quant]() {
+        try {
+            GkMmapAudioFile audioFile(file_path);
+            audioFile.adviseSequential();
+
+            //
+            // Estimate when the recording began, from when the file was last written to!
+            const qint64 end_epoch_ms = file_path.lastModified().toMSecsSinceEpoch();
+            const qint64 start_epoch_ms = end_epoch_ms - static_cast<qint64>(audioFile.durationSecs() * 1000.0);
+
+            const auto start = std::chrono::steady_clock::now();
+            auto product = generate(audioFile, quant, SPECTRO_OFFLINE_FFT_SIZE, SPECTRO_OFFLINE_HOP_SIZE, start_epoch_ms);
+            if (!product) {
+                return;
+            }
+
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+            gkEventLogger->publishEvent(tr("Generated a waterfall of %1 rows from, \"%2\", in %3 milliseconds.")
+                                                .arg(QString::number(product->num_rows), file_path.fileName(), QString::number(elapsed.count())),
+                                        GkSeverity::Info, "", false, true, false, false, false);
+            emit progressChanged(100);
+            emit spectroProductReady(product);
+        } catch (const std::exception &e) {
+            gkEventLogger->publishEvent(QString::fromStdString(e.what()), GkSeverity::Error, "", false, true, false, true, false);
+        }
+    });
+
+    return;
+}
+
+/**
+ * @brief GkOfflineSpectro::loadFromFile reads back a previously saved spectrograph / waterfall product upon a background
+ * thread, emitting `spectroProductReady()` once finished.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param file_path The saved product to be read.
+ * @see GkOfflineSpectro::loadProduct().
+ */
+void GkOfflineSpectro::loadFromFile(const QFileInfo &file_path)
+{
+    cancel();
+    joinGenerateThread();
+    m_cancelled = false;
+
+    generateThread = std::thread([this, file_path]() {
+        try {
+            auto product = loadProduct(file_path);
+            gkEventLogger->publishEvent(tr("Opened a waterfall of %1 rows from, \"%2\".").arg(QString::number(product->num_rows), file_path.fileName()),
+                                        GkSeverity::Info, "", false, true, false, false, false);
+            emit progressChanged(100);
+            emit spectroProductReady(product);
+        } catch (const std::exception &e) {
+            gkEventLogger->publishEvent(QString::fromStdString(e.what()), GkSeverity::Error, "", false, true, false, true, false);
+        }
+    });
+
+    return;
+}
+
+/**
+ * @brief GkOfflineSpectro::cancel stops any generation that is currently in progress.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkOfflineSpectro::cancel()
+{
+    m_cancelled = true;
+
+    return;
+}
+
+/**
+ * @brief GkOfflineSpectro::generateRows is the worker for a single chunk of rows.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param audioFile The memory-mapped audio file being analysed.
+ * @param product The pre-allocated product to write the rows towards.
+ * @param first_row The first row of this chunk.
+ * @param last_row One past the last row of this chunk.
+ * @param window The windowing function to apply before the FFT.
+ * @param norm The factor needed to normalize the output towards dBFS.
+ */
+void GkOfflineSpectro::generateRows(const GkMmapAudioFile &audioFile, GkSpectroProduct &product, const quint64 &first_row,
+                                    const quint64 &last_row, const std::vector<float> &window, const float &norm)
+{
+    const quint32 fft_size = product.fft_size;
+    const quint32 num_bins = product.num_bins;
+    std::unique_ptr<std::remove_pointer<kiss_fftr_cfg>::type, void (*)(void *)> fft_cfg(kiss_fftr_alloc(static_cast<int>(fft_size), 0, nullptr, nullptr),
+                                                                                        [](void *cfg) { kiss_fftr_free(cfg); });
+    if (!fft_cfg) {
+        //
+        // Stop the other workers too, as the product would be left with a gap in it regardless
+        m_cancelled = true;
+        throw std::runtime_error(tr("Unable to allocate an FFT of size, %1, for generating the waterfall!")
+                                         .arg(QString::number(fft_size)).toStdString());
+    }
+
+    std::vector<float> samples(fft_size);
+    std::vector<kiss_fft_scalar> time_data(fft_size);
+    std::vector<kiss_fft_cpx> freq_data(num_bins);
+
+    const float db_floor = product.db_floor;
+    const float quant_scale = 255.0f / (product.db_ceiling - product.db_floor);
+    const float tiny = std::numeric_limits<float>::min();
+    const quint64 report_every = std::max<quint64>(1, product.num_rows / 100);
+
+    for (quint64 row = first_row; row < last_row && !m_cancelled; ++row) {
+        audioFile.readMonoFloat(static_cast<qint64>(row * product.hop_size), fft_size, samples.data());
+        for (quint32 i = 0; i < fft_size; ++i) {
+            time_data[i] = static_cast<kiss_fft_scalar>(samples[i] * window[i]);
+        }
+
+        kiss_fftr(fft_cfg.get(), time_data.data(), freq_data.data());
+
+        const size_t offset = row * num_bins;
+        for (quint32 i = 0; i < num_bins; ++i) {
+            const float re = static_cast<float>(freq_data[i].r) * norm;
+            const float im = static_cast<float>(freq_data[i].i) * norm;
+            const float db = 10.0f * std::log10((re * re) + (im * im) + tiny);
+            if (product.quant == SpectroUint8) {
+                product.rows_u8[offset + i] = static_cast<quint8>(std::clamp((db - db_floor) * quant_scale, 0.0f, 255.0f));
+            } else {
+                product.rows_f32[offset + i] = db;
+            }
+        }
+
+        const quint64 done = ++m_rowsDone;
+        if ((done % report_every) == 0) {
+            emit progressChanged(static_cast<qint32>((done * 100) / product.num_rows));
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief GkOfflineSpectro::joinGenerateThread waits for any previous generation to wind down.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkOfflineSpectro::joinGenerateThread()
+{
+    if (generateThread.joinable()) {
+        generateThread.join();
+    }
+
+    return;
+}
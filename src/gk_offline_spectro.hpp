@@ -0,0 +1,103 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include "src/gk_logger.hpp"
+#include "src/gk_mmap_audio.hpp"
+#include <kiss_fftr.h>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <QObject>
+#include <QString>
+#include <QPointer>
+#include <QFileInfo>
+#include <QMetaType>
+
+namespace GekkoFyre {
+
+class GkOfflineSpectro : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GkOfflineSpectro(QPointer<GekkoFyre::GkEventLogger> eventLogger, QObject *parent = nullptr);
+    ~GkOfflineSpectro() override;
+
+    [[nodiscard]] std::shared_ptr<GekkoFyre::Spectrograph::GkSpectroProduct> generate(const GekkoFyre::GkMmapAudioFile &audioFile,
+                                                                                      const GekkoFyre::Spectrograph::GkSpectroQuant &quant = GekkoFyre::Spectrograph::SpectroUint8,
+                                                                                      const quint32 &fft_size = SPECTRO_OFFLINE_FFT_SIZE,
+                                                                                      const quint32 &hop_size = SPECTRO_OFFLINE_HOP_SIZE,
+                                                                                      const qint64 &start_epoch_ms = 0);
+
+    static void saveProduct(const GekkoFyre::Spectrograph::GkSpectroProduct &product, const QFileInfo &file_path);
+    [[nodiscard]] static std::shared_ptr<GekkoFyre::Spectrograph::GkSpectroProduct> loadProduct(const QFileInfo &file_path);
+
+public slots:
+    void generateFromFile(const QFileInfo &file_path, const GekkoFyre::Spectrograph::GkSpectroQuant &quant = GekkoFyre::Spectrograph::SpectroUint8);
+    void loadFromFile(const QFileInfo &file_path);
+    void cancel();
+
+signals:
+    void progressChanged(const qint32 &percentage);
+    void spectroProductReady(std::shared_ptr<GekkoFyre::Spectrograph::GkSpectroProduct> product);
+
+private:
+    QPointer<GekkoFyre::GkEventLogger> gkEventLogger;
+
+    //
+    // Multithreading
+    std::thread generateThread;
+    std::atomic<bool> m_cancelled;
+    std::atomic<quint64> m_rowsDone;
+
+    void generateRows(const GekkoFyre::GkMmapAudioFile &audioFile, GekkoFyre::Spectrograph::GkSpectroProduct &product,
+                      const quint64 &first_row, const quint64 &last_row, const std::vector<float> &window,
+                      const float &norm);
+    void joinGenerateThread();
+
+};
+};
+
+Q_DECLARE_METATYPE(std::shared_ptr<GekkoFyre::Spectrograph::GkSpectroProduct>);
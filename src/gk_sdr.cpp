@@ -63,7 +63,7 @@ using namespace Events;
 using namespace Logging;
 using namespace GkSdr;
 
-GkSdrDev::GkSdrDev(QObject *parent) : QObject(parent)
+GkSdrDev::GkSdrDev(QObject *parent) : QObject(parent), m_modulation(SdrModNfm)
 {
     setParent(parent);
 
@@ -326,3 +326,28 @@ SoapySDR::Kwargs GkSdrDev::findSoapySdrHwInfo(std::shared_ptr<SoapySDR::Device>
 
     return SoapySDR::Kwargs();
 }
+
+/**
+ * @brief GkSdrDev::getModulation
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The modulation that has been chosen for the SDR device.
+ */
+GkSdrModulation GkSdrDev::getModulation() const
+{
+    return m_modulation;
+}
+
+/**
+ * @brief GkSdrDev::setModulation
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param modulation The modulation that has been chosen for the SDR device.
+ */
+void GkSdrDev::setModulation(const GkSdrModulation &modulation)
+{
+    if (modulation != m_modulation) {
+        m_modulation = modulation;
+        emit modulationChanged(modulation);
+    }
+
+    return;
+}
@@ -79,5 +79,16 @@ public:
     [[nodiscard]] SoapySDR::Kwargs findSoapySdrHwInfo(const SoapySDR::Kwargs &input_args) const;
     [[nodiscard]] SoapySDR::Kwargs findSoapySdrHwInfo(std::shared_ptr<SoapySDR::Device> dev_ptr) const;
 
+    [[nodiscard]] GekkoFyre::System::GkSdr::GkSdrModulation getModulation() const;
+
+public slots:
+    void setModulation(const GekkoFyre::System::GkSdr::GkSdrModulation &modulation);
+
+signals:
+    void modulationChanged(const GekkoFyre::System::GkSdr::GkSdrModulation &modulation);
+
+private:
+    GekkoFyre::System::GkSdr::GkSdrModulation m_modulation;
+
 };
 };
@@ -0,0 +1,936 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/gk_sdr_ddc.hpp"
+#include <cmath>
+#include <chrono>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <exception>
+
+using namespace GekkoFyre;
+using namespace System;
+using namespace Events;
+using namespace Logging;
+using namespace GkSdr;
+
+/**
+ * @brief GkDecimatingFir::GkDecimatingFir
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+GkDecimatingFir::GkDecimatingFir() : m_pos(0), m_decimation(1), m_phase(0)
+{
+    configure({ 1.0f }, 1);
+
+    return;
+}
+
+/**
+ * @brief GkDecimatingFir::configure
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param taps The coefficients of the filter.
+ * @param decimation Only every n'th output is kept (and calculated).
+ */
+void GkDecimatingFir::configure(const std::vector<float> &taps, const quint32 &decimation)
+{
+    if (taps.empty() || decimation < 1) {
+        throw std::invalid_argument(QObject::tr("Invalid parameters have been given for a decimating filter!").toStdString());
+    }
+
+    m_taps.assign(taps.rbegin(), taps.rend());
+    m_decimation = decimation;
+    reset();
+
+    return;
+}
+
+/**
+ * @brief GkDecimatingFir::reset clears the history of the filter.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkDecimatingFir::reset()
+{
+    m_histI.assign(m_taps.size() * 2, 0.0f);
+    m_histQ.assign(m_taps.size() * 2, 0.0f);
+    m_pos = 0;
+    m_phase = 0;
+
+    return;
+}
+
+/**
+ * @brief GkDecimatingFir::process
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param in The samples to be filtered.
+ * @param count The number of samples within `in`.
+ * @param out Where the filtered samples are to be written, which must hold at least `count / decimation + 1` of them.
+ * @return The number of samples written towards `out`.
+ */
+size_t GkDecimatingFir::process(const std::complex<float> *in, const size_t &count, std::complex<float> *out)
+{
+    const size_t num_taps = m_taps.size();
+    size_t num_out = 0;
+    for (size_t i = 0; i < count; ++i) {
+        m_histI[m_pos] = m_histI[m_pos + num_taps] = in[i].real();
+        m_histQ[m_pos] = m_histQ[m_pos + num_taps] = in[i].imag();
+        m_pos = (m_pos + 1 == num_taps) ? 0 : (m_pos + 1);
+
+        if (++m_phase >= m_decimation) {
+            //
+            // The history, from the oldest sample through to the newest, now begins at `m_pos`!
+            m_phase = 0;
+            out[num_out++] = { dotProduct(m_taps.data(), &m_histI[m_pos], num_taps),
+                               dotProduct(m_taps.data(), &m_histQ[m_pos], num_taps) };
+        }
+    }
+
+    return num_out;
+}
+
+/**
+ * @brief GkDecimatingFir::getDecimation
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The decimation factor of the filter.
+ */
+quint32 GkDecimatingFir::getDecimation() const
+{
+    return m_decimation;
+}
+
+/**
+ * @brief GkDecimatingFir::designLowpass designs a low-pass filter via the windowed-sinc method, with a Blackman window,
+ * normalized for unity gain at DC.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param num_taps The length of the filter.
+ * @param cutoff The -6 dB point of the filter, as a fraction of the sample rate (i.e. between 0 and 0.5).
+ * @return The coefficients of the filter.
+ */
+std::vector<float> GkDecimatingFir::designLowpass(const size_t &num_taps, const double &cutoff)
+{
+    std::vector<float> taps(num_taps);
+    const double mid = (static_cast<double>(num_taps) - 1.0) / 2.0;
+    double sum = 0.0;
+    for (size_t i = 0; i < num_taps; ++i) {
+        const double t = static_cast<double>(i) - mid;
+        const double sinc = (std::abs(t) < 1e-9) ? (2.0 * cutoff) : (std::sin(2.0 * M_PI * cutoff * t) / (M_PI * t));
+        const double x = (num_taps > 1) ? ((2.0 * M_PI * i) / (static_cast<double>(num_taps) - 1.0)) : 0.0;
+        const double window = 0.42 - (0.5 * std::cos(x)) + (0.08 * std::cos(2.0 * x));
+        taps[i] = static_cast<float>(sinc * window);
+        sum += taps[i];
+    }
+
+    for (auto &tap: taps) {
+        tap = static_cast<float>(tap / sum);
+    }
+
+    return taps;
+}
+
+/**
+ * @brief GkDecimatingFir::dotProduct sums across several independent lanes, so that the compiler may vectorize the loop
+ * without having to reorder any floating-point additions itself.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param a The first vector.
+ * @param b The second vector.
+ * @param len The length of both vectors.
+ * @return The dot product of both vectors.
+ */
+float GkDecimatingFir::dotProduct(const float *a, const float *b, const size_t &len)
+{
+    std::array<float, GK_SIGNAL_GEN_SIMD_LANES * 2> acc = {};
+    constexpr size_t lanes = acc.size();
+
+    size_t i = 0;
+    for (; i + lanes <= len; i += lanes) {
+        for (size_t j = 0; j < lanes; ++j) {
+            acc[j] += a[i + j] * b[i + j];
+        }
+    }
+
+    float sum = 0.0f;
+    for (; i < len; ++i) {
+        sum += a[i] * b[i];
+    }
+
+    for (const auto &lane: acc) {
+        sum += lane;
+    }
+
+    return sum;
+}
+
+/**
+ * @brief GkAudioResampler::GkAudioResampler
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+GkAudioResampler::GkAudioResampler() : m_step(1.0), m_frac(0.0), m_last(0.0f), m_pos(0)
+{
+    return;
+}
+
+/**
+ * @brief GkAudioResampler::configure
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param in_rate The sample rate of the demodulated audio.
+ * @param out_rate The sample rate of the audio that is to be produced.
+ */
+void GkAudioResampler::configure(const double &in_rate, const double &out_rate)
+{
+    m_step = in_rate / out_rate;
+    if (in_rate > (out_rate * 1.2)) {
+        m_taps = GkDecimatingFir::designLowpass(63, (0.45 * out_rate) / in_rate);
+    } else {
+        m_taps.clear();
+    }
+
+    reset();
+    return;
+}
+
+/**
+ * @brief GkAudioResampler::reset
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkAudioResampler::reset()
+{
+    m_hist.assign(m_taps.size() * 2, 0.0f);
+    m_pos = 0;
+    m_frac = 0.0;
+    m_last = 0.0f;
+
+    return;
+}
+
+/**
+ * @brief GkAudioResampler::process
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param in The audio to be resampled.
+ * @param count The number of samples within `in`.
+ * @param out Where the resampled audio is to be written, which must hold at least GkAudioResampler::maxOutput() samples.
+ * @return The number of samples written towards `out`.
+ */
+size_t GkAudioResampler::process(const float *in, const size_t &count, float *out)
+{
+    const size_t num_taps = m_taps.size();
+    size_t num_out = 0;
+    for (size_t i = 0; i < count; ++i) {
+        float curr = in[i];
+        if (num_taps > 0) {
+            m_hist[m_pos] = m_hist[m_pos + num_taps] = curr;
+            m_pos = (m_pos + 1 == num_taps) ? 0 : (m_pos + 1);
+            curr = GkDecimatingFir::dotProduct(m_taps.data(), &m_hist[m_pos], num_taps);
+        }
+
+        while (m_frac < 1.0) {
+            out[num_out++] = m_last + ((curr - m_last) * static_cast<float>(m_frac));
+            m_frac += m_step;
+        }
+
+        m_frac -= 1.0;
+        m_last = curr;
+    }
+
+    return num_out;
+}
+
+/**
+ * @brief GkAudioResampler::maxOutput
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param count The number of samples that are to be resampled.
+ * @return The most samples that could be produced from them.
+ */
+size_t GkAudioResampler::maxOutput(const size_t &count) const
+{
+    return static_cast<size_t>(std::ceil(static_cast<double>(count) / m_step)) + 2;
+}
+
+/**
+ * @brief GkPolyphaseChannelizer::GkPolyphaseChannelizer
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+GkPolyphaseChannelizer::GkPolyphaseChannelizer() : m_numBins(0), m_tapsPerPhase(0), m_hop(0), m_pos(0), m_fill(0), m_hopCount(0),
+                                                   m_fftCfg(nullptr, [](void *cfg) { kiss_fft_free(cfg); })
+{
+    return;
+}
+
+/**
+ * @brief GkPolyphaseChannelizer::configure
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param num_bins The number of bins to split the stream into, which must be an even number (and preferably a power of
+ * two, for the sake of the FFT).
+ * @param taps_per_phase The length of the prototype filter, as a multiple of the number of bins.
+ */
+void GkPolyphaseChannelizer::configure(const quint32 &num_bins, const quint32 &taps_per_phase)
+{
+    if (num_bins < 2 || (num_bins % 2) != 0 || taps_per_phase < 1) {
+        throw std::invalid_argument(QObject::tr("Invalid parameters have been given for a polyphase filter bank!").toStdString());
+    }
+
+    m_numBins = num_bins;
+    m_tapsPerPhase = taps_per_phase;
+    m_hop = num_bins / 2;
+
+    //
+    // The prototype is flat across the whole of a bin and then rolls off before the Nyquist limit of each bin's output,
+    // which is twice the spacing between bins due to the oversampling.
+    const auto proto = GkDecimatingFir::designLowpass(static_cast<size_t>(num_bins) * taps_per_phase, 0.75 / num_bins);
+    m_protoRev.assign(proto.rbegin(), proto.rend());
+
+    m_fftCfg.reset(kiss_fft_alloc(static_cast<int>(num_bins), 1, nullptr, nullptr));
+    m_accI.assign(num_bins, 0.0f);
+    m_accQ.assign(num_bins, 0.0f);
+    m_fftIn.assign(num_bins, kiss_fft_cpx{});
+    m_fftOut.assign(num_bins, kiss_fft_cpx{});
+    m_outputs.assign(num_bins, std::vector<std::complex<float>>());
+    m_activeBins.clear();
+    reset();
+
+    return;
+}
+
+/**
+ * @brief GkPolyphaseChannelizer::reset clears the history of the filter bank.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkPolyphaseChannelizer::reset()
+{
+    m_histI.assign(m_protoRev.size() * 2, 0.0f);
+    m_histQ.assign(m_protoRev.size() * 2, 0.0f);
+    m_pos = 0;
+    m_fill = 0;
+    m_hopCount = 0;
+
+    return;
+}
+
+/**
+ * @brief GkPolyphaseChannelizer::setActiveBins
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bins The only bins whose outputs are kept, as there is no sense in keeping those that no channel lies within.
+ */
+void GkPolyphaseChannelizer::setActiveBins(const std::vector<quint32> &bins)
+{
+    m_activeBins.clear();
+    for (const auto &bin: bins) {
+        if (bin < m_numBins && std::find(m_activeBins.begin(), m_activeBins.end(), bin) == m_activeBins.end()) {
+            m_activeBins.push_back(bin);
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief GkPolyphaseChannelizer::process runs the given samples through the filter bank. The outputs of each active bin,
+ * at twice the spacing between bins, are then to be found via GkPolyphaseChannelizer::getOutput() until the next call.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param in The samples to be processed.
+ * @param count The number of samples within `in`.
+ */
+void GkPolyphaseChannelizer::process(const std::complex<float> *in, const size_t &count)
+{
+    const size_t expected = (count / m_hop) + 1;
+    for (const auto &bin: m_activeBins) {
+        m_outputs[bin].clear();
+        m_outputs[bin].reserve(expected);
+    }
+
+    const size_t len = m_protoRev.size();
+    for (size_t i = 0; i < count; ++i) {
+        m_histI[m_pos] = m_histI[m_pos + len] = in[i].real();
+        m_histQ[m_pos] = m_histQ[m_pos + len] = in[i].imag();
+        m_pos = (m_pos + 1 == len) ? 0 : (m_pos + 1);
+
+        if (++m_fill == m_hop) {
+            m_fill = 0;
+            computeHop();
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief GkPolyphaseChannelizer::getOutput
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bin The bin in question, where bin zero is centred upon DC and those in the upper half are negative frequencies.
+ * @return The outputs of the bin from the last call to GkPolyphaseChannelizer::process().
+ */
+const std::vector<std::complex<float>> &GkPolyphaseChannelizer::getOutput(const quint32 &bin) const
+{
+    return m_outputs.at(bin);
+}
+
+/**
+ * @brief GkPolyphaseChannelizer::getNumBins
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The number of bins that the stream is split into.
+ */
+quint32 GkPolyphaseChannelizer::getNumBins() const
+{
+    return m_numBins;
+}
+
+/**
+ * @brief GkPolyphaseChannelizer::computeHop calculates one output for every active bin. The history is weighted by the
+ * prototype filter and folded down towards the number of bins, then transformed by an inverse FFT, which tunes every bin
+ * down towards DC at once. Hopping by half the number of bins leaves each odd bin with its sign flipping on every odd
+ * hop, which is then undone.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkPolyphaseChannelizer::computeHop()
+{
+    const float *hist_i = &m_histI[m_pos];
+    const float *hist_q = &m_histQ[m_pos];
+    const float *proto = m_protoRev.data();
+
+    std::fill(m_accI.begin(), m_accI.end(), 0.0f);
+    std::fill(m_accQ.begin(), m_accQ.end(), 0.0f);
+    for (quint32 q = 0; q < m_tapsPerPhase; ++q) {
+        const size_t offset = static_cast<size_t>(q) * m_numBins;
+        float *acc_i = m_accI.data();
+        float *acc_q = m_accQ.data();
+        for (quint32 r = 0; r < m_numBins; ++r) {
+            acc_i[r] += proto[offset + r] * hist_i[offset + r];
+            acc_q[r] += proto[offset + r] * hist_q[offset + r];
+        }
+    }
+
+    for (quint32 m = 0; m < m_numBins; ++m) {
+        m_fftIn[m].r = static_cast<kiss_fft_scalar>(m_accI[m_numBins - 1 - m]);
+        m_fftIn[m].i = static_cast<kiss_fft_scalar>(m_accQ[m_numBins - 1 - m]);
+    }
+
+    kiss_fft(m_fftCfg.get(), m_fftIn.data(), m_fftOut.data());
+
+    const bool odd_hop = (m_hopCount++ & 1) != 0;
+    for (const auto &bin: m_activeBins) {
+        const float sign = (odd_hop && (bin & 1)) ? -1.0f : 1.0f;
+        m_outputs[bin].emplace_back(static_cast<float>(m_fftOut[bin].r) * sign, static_cast<float>(m_fftOut[bin].i) * sign);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkDdcChannel::GkDdcChannel
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param channel_id The identifier of the channel.
+ * @param config The settings of the channel.
+ * @param callback Where the audio of the channel is to be sent, upon the channel's own thread.
+ */
+GkDdcChannel::GkDdcChannel(const qint32 &channel_id, const GkDdcChannelConfig &config, GkDdcAudioCallback callback)
+    : m_id(channel_id), m_callback(std::move(callback)), m_inputRate(0.0), m_residual(0.0), m_config(config),
+      m_reconfigure(true), m_freeChunks(GK_SDR_DDC_CHUNK_POOL), m_filledChunks(GK_SDR_DDC_CHUNK_POOL), m_current(nullptr),
+      m_dropped(0), m_running(false)
+{
+    for (qint32 i = 0; i < GK_SDR_DDC_CHUNK_POOL; ++i) {
+        auto chunk = std::make_unique<GkDdcChunk>();
+        chunk->samples.resize(GK_SDR_DDC_CHUNK_SAMPLES);
+        m_pool.push_back(std::move(chunk));
+    }
+
+    return;
+}
+
+GkDdcChannel::~GkDdcChannel()
+{
+    stop();
+}
+
+/**
+ * @brief GkDdcChannel::start begins the channel's own thread.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param input_rate The sample rate of what the channel is to be fed with.
+ * @param residual_hz Where the channel's carrier lies within what it is to be fed with.
+ */
+void GkDdcChannel::start(const double &input_rate, const double &residual_hz)
+{
+    stop();
+
+    m_inputRate = input_rate;
+    m_residual = residual_hz;
+
+    //
+    // Every chunk is returned towards the free list, as nothing else can be holding one whilst stopped
+    GkDdcChunk *chunk;
+    while (m_freeChunks.pop(chunk)) {}
+    while (m_filledChunks.pop(chunk)) {}
+    for (const auto &pooled: m_pool) {
+        m_freeChunks.push(pooled.get());
+    }
+
+    m_current = nullptr;
+    m_reconfigure = true;
+    m_running = true;
+    channelThread = std::thread(&GkDdcChannel::run, this);
+
+    return;
+}
+
+/**
+ * @brief GkDdcChannel::stop
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkDdcChannel::stop()
+{
+    m_running = false;
+    if (channelThread.joinable()) {
+        channelThread.join();
+    }
+
+    return;
+}
+
+/**
+ * @brief GkDdcChannel::submit hands samples towards the channel's own thread, which is called from the filter bank's
+ * thread. Should the channel have fallen behind then the samples are dropped, rather than holding up the other channels.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param in The samples to be handed over.
+ * @param count The number of samples within `in`.
+ * @return Whether all of the samples were accepted.
+ */
+bool GkDdcChannel::submit(const std::complex<float> *in, const size_t &count)
+{
+    size_t pos = 0;
+    while (pos < count) {
+        if (!m_current) {
+            if (!m_freeChunks.pop(m_current)) {
+                m_current = nullptr;
+                m_dropped += (count - pos);
+                return false;
+            }
+
+            m_current->count = 0;
+        }
+
+        const size_t to_copy = std::min(m_current->samples.size() - m_current->count, count - pos);
+        std::copy(in + pos, in + pos + to_copy, m_current->samples.begin() + static_cast<qint64>(m_current->count));
+        m_current->count += to_copy;
+        pos += to_copy;
+
+        if (m_current->count == m_current->samples.size()) {
+            m_filledChunks.push(std::move(m_current));
+            m_current = nullptr;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief GkDdcChannel::setModulation may be called at any time, and is picked up by the channel's own thread before it
+ * processes its next chunk.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param modulation The new modulation for the channel.
+ */
+void GkDdcChannel::setModulation(const GkSdrModulation &modulation)
+{
+    std::lock_guard<std::mutex> lock_guard(mtx_config);
+    m_config.modulation = modulation;
+    m_reconfigure = true;
+
+    return;
+}
+
+/**
+ * @brief GkDdcChannel::getId
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The identifier of the channel.
+ */
+qint32 GkDdcChannel::getId() const
+{
+    return m_id;
+}
+
+/**
+ * @brief GkDdcChannel::getConfig
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The settings of the channel.
+ */
+GkDdcChannelConfig GkDdcChannel::getConfig() const
+{
+    std::lock_guard<std::mutex> lock_guard(mtx_config);
+    return m_config;
+}
+
+/**
+ * @brief GkDdcChannel::getDroppedCount
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The number of samples dropped due to the channel falling behind.
+ */
+quint64 GkDdcChannel::getDroppedCount() const
+{
+    return m_dropped;
+}
+
+/**
+ * @brief GkDdcChannel::run is the channel's own thread.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkDdcChannel::run()
+{
+    while (m_running) {
+        if (m_reconfigure) {
+            rebuild();
+        }
+
+        GkDdcChunk *chunk = nullptr;
+        if (!m_filledChunks.pop(chunk)) {
+            std::this_thread::sleep_for(std::chrono::microseconds(GK_SDR_STREAM_CONSUMER_IDLE_MICROSECS));
+            continue;
+        }
+
+        processChunk(chunk);
+        m_freeChunks.push(std::move(chunk));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkDdcChannel::rebuild designs the filters for the channel's modulation. The channel is first decimated towards
+ * the lowest rate that still holds both the channel and the audio, and only then filtered down towards the width of the
+ * channel itself, where the far sharper filter this needs is far cheaper to run.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkDdcChannel::rebuild()
+{
+    GkDdcChannelConfig config;
+    {
+        std::lock_guard<std::mutex> lock_guard(mtx_config);
+        m_reconfigure = false;
+        config = m_config;
+    }
+
+    const double bandwidth = (config.bandwidth_hz > 0.0) ? config.bandwidth_hz : GkSdrDemod::defaultBandwidth(config.modulation);
+    const double shift = GkSdrDemod::passbandShift(config.modulation, bandwidth);
+    m_nco.setFrequency(-(m_residual + shift), m_inputRate);
+
+    const double audio_rate = (config.audio_rate > 0.0) ? config.audio_rate : GK_SDR_DDC_AUDIO_RATE;
+    const double min_rate = std::max<double>(audio_rate, bandwidth * 1.25);
+    const auto decimation = static_cast<quint32>(std::max(1.0, std::floor(m_inputRate / min_rate)));
+    const double channel_rate = m_inputRate / decimation;
+    if (decimation > 1) {
+        m_decimator.configure(GkDecimatingFir::designLowpass(static_cast<size_t>(decimation) * GK_SDR_DDC_FIR_TAPS_PER_PHASE,
+                                                             0.5 / decimation), decimation);
+    } else {
+        m_decimator.configure({ 1.0f }, 1);
+    }
+
+    const double transition = std::max(bandwidth * 0.25, 300.0);
+    const double cutoff = ((bandwidth + transition) / 2.0) / channel_rate;
+    if (cutoff < 0.5) {
+        auto num_taps = static_cast<size_t>(std::ceil((5.5 * channel_rate) / transition));
+        num_taps = std::clamp<size_t>(num_taps | 1, 31, 511);
+        m_channelFilter.configure(GkDecimatingFir::designLowpass(num_taps, cutoff), 1);
+    } else {
+        m_channelFilter.configure({ 1.0f }, 1);
+    }
+
+    m_demod = GkSdrDemod::create(config.modulation, channel_rate, bandwidth);
+    m_resampler.configure(channel_rate, audio_rate);
+
+    const size_t max_decim = (GK_SDR_DDC_CHUNK_SAMPLES / decimation) + 1;
+    m_decimBuf.resize(max_decim);
+    m_filterBuf.resize(max_decim);
+    m_demodBuf.resize(max_decim);
+    m_audioBuf.resize(m_resampler.maxOutput(max_decim));
+
+    return;
+}
+
+/**
+ * @brief GkDdcChannel::processChunk
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param chunk The samples to be turned into audio, which are tuned in-place.
+ */
+void GkDdcChannel::processChunk(GkDdcChunk *chunk)
+{
+    m_nco.mix(chunk->samples.data(), chunk->count);
+    const size_t num_decim = m_decimator.process(chunk->samples.data(), chunk->count, m_decimBuf.data());
+    const size_t num_filtered = m_channelFilter.process(m_decimBuf.data(), num_decim, m_filterBuf.data());
+    m_demod->process(m_filterBuf.data(), num_filtered, m_demodBuf.data());
+    const size_t num_audio = m_resampler.process(m_demodBuf.data(), num_filtered, m_audioBuf.data());
+
+    if (m_callback && num_audio > 0) {
+        m_callback(m_id, m_audioBuf.data(), num_audio);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSdrDdc::GkSdrDdc
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sdrStream The stream of IQ samples, which must not yet be running as a consumer is registered upon it here.
+ * @param eventLogger The event logging class.
+ * @param parent The parent object to this class.
+ */
+GkSdrDdc::GkSdrDdc(QPointer<GkSdrStream> sdrStream, QPointer<GkEventLogger> eventLogger, QObject *parent)
+    : QObject(parent), m_sink(-1), m_nextChannelId(0), m_bypass(true), m_running(false)
+{
+    gkSdrStream = std::move(sdrStream);
+    gkEventLogger = std::move(eventLogger);
+
+    m_sink = gkSdrStream->addSink();
+
+    return;
+}
+
+GkSdrDdc::~GkSdrDdc()
+{
+    stop();
+}
+
+/**
+ * @brief GkSdrDdc::addChannel adds a new channel, which must be done whilst stopped.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param config The settings of the channel.
+ * @param callback Where the audio of the channel is to be sent, upon the channel's own thread.
+ * @return The identifier of the channel.
+ */
+qint32 GkSdrDdc::addChannel(const GkDdcChannelConfig &config, GkDdcAudioCallback callback)
+{
+    if (m_running) {
+        throw std::runtime_error(tr("Channels may not be added whilst the down-converter is running!").toStdString());
+    }
+
+    if (m_channels.size() >= GK_SDR_DDC_MAX_CHANNELS) {
+        throw std::runtime_error(tr("No more than %1 channels may be extracted from a single SDR stream!").arg(QString::number(GK_SDR_DDC_MAX_CHANNELS)).toStdString());
+    }
+
+    const qint32 channel_id = m_nextChannelId++;
+    m_channels.push_back(std::make_unique<GkDdcChannel>(channel_id, config, std::move(callback)));
+
+    return channel_id;
+}
+
+/**
+ * @brief GkSdrDdc::removeChannel removes a channel, which must be done whilst stopped.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param channel_id The identifier of the channel.
+ */
+void GkSdrDdc::removeChannel(const qint32 &channel_id)
+{
+    if (m_running) {
+        throw std::runtime_error(tr("Channels may not be removed whilst the down-converter is running!").toStdString());
+    }
+
+    m_channels.erase(std::remove_if(m_channels.begin(), m_channels.end(), [channel_id](const std::unique_ptr<GkDdcChannel> &channel) {
+        return channel->getId() == channel_id;
+    }), m_channels.end());
+
+    return;
+}
+
+/**
+ * @brief GkSdrDdc::setModulation changes the modulation of a channel, which may be done at any time.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param channel_id The identifier of the channel.
+ * @param modulation The new modulation for the channel.
+ */
+void GkSdrDdc::setModulation(const qint32 &channel_id, const GkSdrModulation &modulation)
+{
+    for (const auto &channel: m_channels) {
+        if (channel->getId() == channel_id) {
+            channel->setModulation(modulation);
+            break;
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSdrDdc::isRunning
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return Whether the down-converter is running.
+ */
+bool GkSdrDdc::isRunning() const
+{
+    return m_running;
+}
+
+/**
+ * @brief GkSdrDdc::getNumBins
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The number of bins that the stream is being split into, or one if the channels are being fed directly.
+ */
+quint32 GkSdrDdc::getNumBins() const
+{
+    return m_bypass ? 1 : m_channelizer.getNumBins();
+}
+
+/**
+ * @brief GkSdrDdc::start begins extracting channels from the stream, which should have just been started itself. Wide
+ * streams are split by the polyphase filter bank into bins no narrower than GK_SDR_DDC_PFB_MIN_RATE, and wide enough that
+ * each channel fits within the passband of whichever bin it lies within; narrow streams (or channels too wide for any
+ * split) are fed towards the channels directly.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sample_rate The sample rate of the stream.
+ */
+void GkSdrDdc::start(const double &sample_rate)
+{
+    try {
+        stop();
+
+        quint32 num_bins = 1;
+        while ((num_bins * 2) <= GK_SDR_DDC_PFB_MAX_BINS && ((2.0 * sample_rate) / (num_bins * 2)) >= GK_SDR_DDC_PFB_MIN_RATE) {
+            num_bins *= 2;
+        }
+
+        //
+        // Each channel, however far it lies from the centre of its bin, must fit within the flat part of the prototype's
+        // passband or else it would be truncated (and aliased), so wide channels are given fewer but wider bins instead
+        while (num_bins >= 4 && !fitsBins(sample_rate, num_bins)) {
+            num_bins /= 2;
+        }
+
+        m_bypass = (num_bins < 4);
+        m_channelBins.clear();
+        if (m_bypass) {
+            for (const auto &channel: m_channels) {
+                m_channelBins.push_back(0);
+                channel->start(sample_rate, channel->getConfig().offset_hz);
+            }
+        } else {
+            m_channelizer.configure(num_bins, GK_SDR_DDC_PFB_TAPS_PER_PHASE);
+            const double bin_spacing = sample_rate / num_bins;
+            for (const auto &channel: m_channels) {
+                const double offset = channel->getConfig().offset_hz;
+                const auto nearest = static_cast<qint64>(std::llround(offset / bin_spacing));
+                const auto bin = static_cast<quint32>(((nearest % num_bins) + num_bins) % num_bins);
+                m_channelBins.push_back(bin);
+                channel->start(2.0 * bin_spacing, offset - (static_cast<double>(nearest) * bin_spacing));
+            }
+
+            m_channelizer.setActiveBins(m_channelBins);
+        }
+
+        //
+        // The reader runs even without any channels, so that this consumer of the stream never holds it up
+        m_running = true;
+        readerThread = std::thread(&GkSdrDdc::run, this);
+
+        gkEventLogger->publishEvent(tr("Down-converting %1 channel(s) from the SDR stream, across %2 bin(s).")
+                                            .arg(QString::number(m_channels.size()), QString::number(getNumBins())),
+                                    GkSeverity::Info, "", false, true, false, false, false);
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSdrDdc::fitsBins
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sample_rate The sample rate of the stream.
+ * @param num_bins The number of bins that the stream would be split into.
+ * @return Whether every channel lies wholly within the flat passband of the bin it would be fed from.
+ */
+bool GkSdrDdc::fitsBins(const double &sample_rate, const quint32 &num_bins) const
+{
+    const double bin_spacing = sample_rate / num_bins;
+    for (const auto &channel: m_channels) {
+        const auto config = channel->getConfig();
+        const double bandwidth = (config.bandwidth_hz > 0.0) ? config.bandwidth_hz : GkSdrDemod::defaultBandwidth(config.modulation);
+        const double residual = config.offset_hz - (static_cast<double>(std::llround(config.offset_hz / bin_spacing)) * bin_spacing);
+        if ((std::abs(residual) + (bandwidth / 2.0)) > (GK_SDR_DDC_PFB_PASSBAND * bin_spacing)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief GkSdrDdc::stop halts the filter bank and every channel, which must be done before the stream itself is stopped.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkSdrDdc::stop()
+{
+    m_running = false;
+    if (readerThread.joinable()) {
+        readerThread.join();
+    }
+
+    for (const auto &channel: m_channels) {
+        channel->stop();
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSdrDdc::run is the filter bank's thread, which splits each block of the stream and hands the bins out towards
+ * the channels.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkSdrDdc::run()
+{
+    while (m_running) {
+        GkIqBlock *block = gkSdrStream->popBlock(m_sink);
+        if (!block) {
+            std::this_thread::sleep_for(std::chrono::microseconds(GK_SDR_STREAM_CONSUMER_IDLE_MICROSECS));
+            continue;
+        }
+
+        if (m_bypass) {
+            for (const auto &channel: m_channels) {
+                channel->submit(block->samples.data(), block->count);
+            }
+        } else {
+            m_channelizer.process(block->samples.data(), block->count);
+            for (size_t i = 0; i < m_channels.size(); ++i) {
+                const auto &output = m_channelizer.getOutput(m_channelBins[i]);
+                m_channels[i]->submit(output.data(), output.size());
+            }
+        }
+
+        gkSdrStream->releaseBlock(block);
+    }
+
+    return;
+}
@@ -0,0 +1,274 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include "src/gk_logger.hpp"
+#include "src/gk_sdr_stream.hpp"
+#include "src/gk_demodulators.hpp"
+#include "src/gk_signal_gen.hpp"
+#include "src/gk_lockfree_queue.hpp"
+#include <kiss_fft.h>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <complex>
+#include <functional>
+#include <QObject>
+#include <QPointer>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkDecimatingFir is a polyphase decimating FIR filter for complex samples, whereby only those outputs that are
+ * kept are ever calculated. The I and Q histories are held apart from one another, and twice over, so that each output
+ * is two contiguous dot products which the compiler may vectorize.
+ */
+class GkDecimatingFir {
+
+public:
+    GkDecimatingFir();
+
+    void configure(const std::vector<float> &taps, const quint32 &decimation);
+    void reset();
+    size_t process(const std::complex<float> *in, const size_t &count, std::complex<float> *out);
+
+    [[nodiscard]] quint32 getDecimation() const;
+    [[nodiscard]] static std::vector<float> designLowpass(const size_t &num_taps, const double &cutoff);
+    [[nodiscard]] static float dotProduct(const float *a, const float *b, const size_t &len);
+
+private:
+    std::vector<float> m_taps;                                                  // Stored in reverse, so as to line up with the history.
+    std::vector<float> m_histI;
+    std::vector<float> m_histQ;
+    size_t m_pos;
+    quint32 m_decimation;
+    quint32 m_phase;
+
+};
+
+/**
+ * @brief GkAudioResampler converts demodulated audio towards the output sample rate, via linear interpolation. Should the
+ * input be much faster than the output then it is low-pass filtered first, so as to keep anything the output cannot hold
+ * (such as the stereo subcarrier of WFM) from aliasing back down into the audio.
+ */
+class GkAudioResampler {
+
+public:
+    GkAudioResampler();
+
+    void configure(const double &in_rate, const double &out_rate);
+    void reset();
+    size_t process(const float *in, const size_t &count, float *out);
+    [[nodiscard]] size_t maxOutput(const size_t &count) const;
+
+private:
+    double m_step;                                                              // Input samples per output sample.
+    double m_frac;
+    float m_last;
+    std::vector<float> m_taps;
+    std::vector<float> m_hist;
+    size_t m_pos;
+
+};
+
+/**
+ * @brief GkPolyphaseChannelizer splits a wideband stream of IQ samples into evenly spaced bins with one FFT per hop,
+ * which is shared between every channel, however many there are. The bins are oversampled by two, so that a channel
+ * lying anywhere within a bin (right up to its edges) comes through free of aliasing.
+ */
+class GkPolyphaseChannelizer {
+
+public:
+    GkPolyphaseChannelizer();
+
+    void configure(const quint32 &num_bins, const quint32 &taps_per_phase);
+    void reset();
+    void setActiveBins(const std::vector<quint32> &bins);
+    void process(const std::complex<float> *in, const size_t &count);
+
+    [[nodiscard]] const std::vector<std::complex<float>> &getOutput(const quint32 &bin) const;
+    [[nodiscard]] quint32 getNumBins() const;
+
+private:
+    quint32 m_numBins;
+    quint32 m_tapsPerPhase;
+    quint32 m_hop;
+    std::vector<float> m_protoRev;                                              // The prototype filter, reversed.
+    std::vector<float> m_histI;
+    std::vector<float> m_histQ;
+    size_t m_pos;
+    quint32 m_fill;
+    quint64 m_hopCount;
+
+    std::unique_ptr<std::remove_pointer<kiss_fft_cfg>::type, void (*)(void *)> m_fftCfg;
+    std::vector<float> m_accI;
+    std::vector<float> m_accQ;
+    std::vector<kiss_fft_cpx> m_fftIn;
+    std::vector<kiss_fft_cpx> m_fftOut;
+
+    std::vector<quint32> m_activeBins;
+    std::vector<std::vector<std::complex<float>>> m_outputs;
+
+    void computeHop();
+
+};
+
+/**
+ * @brief GkDdcAudioCallback receives the audio of a channel, upon that channel's own thread.
+ */
+using GkDdcAudioCallback = std::function<void(const qint32 &channel_id, const float *samples, const size_t &count)>;
+
+/**
+ * @brief GkDdcChannel is a single narrowband channel, which runs upon its own thread so that every channel may make use of
+ * its own core. It is fed with chunks of a filter bank bin (or of the stream itself), and then tunes, filters, decimates,
+ * demodulates and resamples these into audio.
+ */
+class GkDdcChannel {
+
+public:
+    explicit GkDdcChannel(const qint32 &channel_id, const GekkoFyre::System::GkSdr::GkDdcChannelConfig &config,
+                          GkDdcAudioCallback callback);
+    ~GkDdcChannel();
+
+    GkDdcChannel(const GkDdcChannel &) = delete;
+    GkDdcChannel &operator=(const GkDdcChannel &) = delete;
+
+    void start(const double &input_rate, const double &residual_hz);
+    void stop();
+    bool submit(const std::complex<float> *in, const size_t &count);
+
+    void setModulation(const GekkoFyre::System::GkSdr::GkSdrModulation &modulation);
+
+    [[nodiscard]] qint32 getId() const;
+    [[nodiscard]] GekkoFyre::System::GkSdr::GkDdcChannelConfig getConfig() const;
+    [[nodiscard]] quint64 getDroppedCount() const;
+
+private:
+    struct GkDdcChunk {
+        std::vector<std::complex<float>> samples;
+        size_t count = 0;
+    };
+
+    qint32 m_id;
+    GkDdcAudioCallback m_callback;
+    double m_inputRate;
+    double m_residual;
+
+    mutable std::mutex mtx_config;
+    GekkoFyre::System::GkSdr::GkDdcChannelConfig m_config;
+    std::atomic<bool> m_reconfigure;
+
+    //
+    // Chunks handed from the filter bank's thread towards this channel's own
+    std::vector<std::unique_ptr<GkDdcChunk>> m_pool;
+    GkLockFreeQueue<GkDdcChunk *> m_freeChunks;
+    GkLockFreeQueue<GkDdcChunk *> m_filledChunks;
+    GkDdcChunk *m_current;                                                      // Only ever touched by the filter bank's thread.
+    std::atomic<quint64> m_dropped;
+
+    std::thread channelThread;
+    std::atomic<bool> m_running;
+
+    //
+    // The following are only ever touched by the channel's own thread
+    GkNco m_nco;
+    GkDecimatingFir m_decimator;
+    GkDecimatingFir m_channelFilter;
+    std::unique_ptr<GkSdrDemod> m_demod;
+    GkAudioResampler m_resampler;
+    std::vector<std::complex<float>> m_decimBuf;
+    std::vector<std::complex<float>> m_filterBuf;
+    std::vector<float> m_demodBuf;
+    std::vector<float> m_audioBuf;
+
+    void run();
+    void rebuild();
+    void processChunk(GkDdcChunk *chunk);
+
+};
+
+/**
+ * @brief GkSdrDdc is the digital down-converter, which extracts any number of narrowband channels (up to
+ * GK_SDR_DDC_MAX_CHANNELS) from the one SDR stream, such as an entire FT8 sub-band alongside several voice channels.
+ */
+class GkSdrDdc : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GkSdrDdc(QPointer<GekkoFyre::GkSdrStream> sdrStream, QPointer<GekkoFyre::GkEventLogger> eventLogger,
+                      QObject *parent = nullptr);
+    ~GkSdrDdc() override;
+
+    qint32 addChannel(const GekkoFyre::System::GkSdr::GkDdcChannelConfig &config, GkDdcAudioCallback callback = nullptr);
+    void removeChannel(const qint32 &channel_id);
+    void setModulation(const qint32 &channel_id, const GekkoFyre::System::GkSdr::GkSdrModulation &modulation);
+
+    [[nodiscard]] bool isRunning() const;
+    [[nodiscard]] quint32 getNumBins() const;
+
+public slots:
+    void start(const double &sample_rate);
+    void stop();
+
+private:
+    QPointer<GekkoFyre::GkSdrStream> gkSdrStream;
+    QPointer<GekkoFyre::GkEventLogger> gkEventLogger;
+    qint32 m_sink;
+    qint32 m_nextChannelId;
+
+    std::vector<std::unique_ptr<GkDdcChannel>> m_channels;
+    std::vector<quint32> m_channelBins;                                         // The filter bank bin that each channel is fed from.
+    GkPolyphaseChannelizer m_channelizer;
+    bool m_bypass;                                                              // Whether the stream is narrow enough to feed the channels directly.
+
+    std::thread readerThread;
+    std::atomic<bool> m_running;
+
+    [[nodiscard]] bool fitsBins(const double &sample_rate, const quint32 &num_bins) const;
+    void run();
+
+};
+};
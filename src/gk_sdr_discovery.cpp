@@ -0,0 +1,342 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/gk_sdr_discovery.hpp"
+#include <chrono>
+#include <string>
+#include <utility>
+#include <exception>
+
+#if defined(__linux__)
+#include "src/contrib/udev/monitor.hpp"
+#endif
+
+using namespace GekkoFyre;
+using namespace System;
+using namespace Events;
+using namespace Logging;
+using namespace GkSdr;
+
+/**
+ * @brief GkSdrDiscovery::GkSdrDiscovery
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sdrDev The SoapySDR helper functions, of which the filtering of device names and hardware keys are made use of.
+ * @param eventLogger The event logging class.
+ * @param parent The parent object to this class.
+ */
+GkSdrDiscovery::GkSdrDiscovery(QPointer<GkSdrDev> sdrDev, QPointer<GkEventLogger> eventLogger, QObject *parent)
+    : QObject(parent), m_scanned(false), m_running(false), m_rescan(false)
+{
+    gkSdrDev = std::move(sdrDev);
+    gkEventLogger = std::move(eventLogger);
+
+    return;
+}
+
+GkSdrDiscovery::~GkSdrDiscovery()
+{
+    stop();
+}
+
+/**
+ * @brief GkSdrDiscovery::getDevices
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return Every device within the cache, as of the last scan, without the hardware being touched at all.
+ */
+QList<GkSoapySdrTableView> GkSdrDiscovery::getDevices() const
+{
+    std::lock_guard<std::mutex> lock_guard(mtx_cache);
+    QList<GkSoapySdrTableView> sdr_devs;
+    for (const auto &dev: m_cache) {
+        sdr_devs.push_back(dev.second);
+    }
+
+    return sdr_devs;
+}
+
+/**
+ * @brief GkSdrDiscovery::deviceKey works out what uniquely identifies a device across rescans, which is its serial
+ * where the driver gives one.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param dev_args The arguments of the device, as given by SoapySDR's enumeration.
+ * @return The key of the device, for use within the cache.
+ */
+QString GkSdrDiscovery::deviceKey(const SoapySDR::Kwargs &dev_args)
+{
+    const auto driver = dev_args.find("driver");
+    const auto serial = dev_args.find("serial");
+    if (driver != dev_args.end() && serial != dev_args.end() && !serial->second.empty()) {
+        return QString::fromStdString(driver->second + ":" + serial->second);
+    }
+
+    return QString::fromStdString(SoapySDR::KwargsToString(dev_args));
+}
+
+/**
+ * @brief GkSdrDiscovery::deviceName
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param dev_args The arguments of the device, as given by SoapySDR's enumeration.
+ * @return The name of the device as shown to the user, being its label or otherwise its device string.
+ */
+QString GkSdrDiscovery::deviceName(const SoapySDR::Kwargs &dev_args)
+{
+    for (const auto &key: { "label", "device" }) {
+        const auto it = dev_args.find(key);
+        if (it != dev_args.end() && !it->second.empty()) {
+            return QString::fromStdString(it->second);
+        }
+    }
+
+    return QString();
+}
+
+/**
+ * @brief GkSdrDiscovery::refresh asks for the SoapySDR devices to be scanned for once more, and returns straight away. The
+ * discovery thread is started upon the first call. Only those devices that were not already within the cache are opened
+ * and probed, whilst GkSdrDiscovery::devicesChanged() is only emitted should any have come or gone.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkSdrDiscovery::refresh()
+{
+    m_rescan = true;
+    if (!m_running) {
+        m_running = true;
+        discoveryThread = std::thread(&GkSdrDiscovery::run, this);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSdrDiscovery::stop
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkSdrDiscovery::stop()
+{
+    m_running = false;
+    if (discoveryThread.joinable()) {
+        discoveryThread.join();
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSdrDiscovery::run is the discovery thread, which waits upon udev for USB devices to come and go (or simply
+ * sleeps, where udev is unavailable) in between rescans.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkSdrDiscovery::run()
+{
+    #if defined(__linux__)
+    std::unique_ptr<udev::monitor> hotplug;
+    try {
+        hotplug = std::make_unique<udev::monitor>();
+        hotplug->match_device("usb", "usb_device");
+    } catch (const std::exception &e) {
+        hotplug.reset();
+        gkEventLogger->publishEvent(tr("Unable to monitor for SDR devices being plugged in or removed, so a rescan must be asked for by hand. Error: %1")
+                                    .arg(QString::fromStdString(e.what())), GkSeverity::Warning, "", false, true, false, false, false);
+    }
+    #endif
+
+    bool settling = false;
+    auto settled_at = std::chrono::steady_clock::now();
+    while (m_running) {
+        if (m_rescan.exchange(false)) {
+            scan();
+        }
+
+        bool hotplugged = false;
+        #if defined(__linux__)
+        if (hotplug) {
+            try {
+                const auto event = hotplug->try_get_for(std::chrono::milliseconds(GK_SDR_DISCOVERY_POLL_MILLISECS));
+                hotplugged = event && (event.action() == udev::added || event.action() == udev::removed);
+            } catch (const std::exception &e) {
+                hotplug.reset();
+                gkEventLogger->publishEvent(tr("Monitoring for SDR devices being plugged in or removed has ceased. Error: %1")
+                                            .arg(QString::fromStdString(e.what())), GkSeverity::Warning, "", false, true, false, false, false);
+            }
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(GK_SDR_DISCOVERY_POLL_MILLISECS));
+        }
+        #else
+        std::this_thread::sleep_for(std::chrono::milliseconds(GK_SDR_DISCOVERY_POLL_MILLISECS));
+        #endif
+
+        //
+        // A device that has only just been plugged in is given a moment for its driver to settle, and any further events
+        // in the meantime (as a hub full of devices would give) push the rescan back rather than causing several...
+        if (hotplugged) {
+            settling = true;
+            settled_at = std::chrono::steady_clock::now() + std::chrono::milliseconds(GK_SDR_DISCOVERY_SETTLE_MILLISECS);
+        }
+
+        if (settling && std::chrono::steady_clock::now() >= settled_at) {
+            settling = false;
+            m_rescan = true;
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSdrDiscovery::scan enumerates the SoapySDR devices, probing any that are new and dropping any that have gone.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkSdrDiscovery::scan()
+{
+    try {
+        const SoapySDR::KwargsList dev_list = SoapySDR::Device::enumerate();
+
+        std::map<QString, GkSoapySdrTableView> found;
+        std::map<QString, GkSoapySdrTableView> cached;
+        {
+            std::lock_guard<std::mutex> lock_guard(mtx_cache);
+            cached = m_cache;
+        }
+
+        bool changed = !m_scanned;
+        for (const auto &dev_args: dev_list) {
+            const QString dev_name = deviceName(dev_args);
+            if (dev_name.isEmpty() || !gkSdrDev->filterSoapySdrDevs(dev_name)) {
+                continue;
+            }
+
+            const QString dev_key = deviceKey(dev_args);
+            if (found.count(dev_key)) {
+                continue;
+            }
+
+            const auto it = cached.find(dev_key);
+            if (it != cached.end()) {
+                found.emplace(dev_key, it->second);
+                continue;
+            }
+
+            GkSoapySdrTableView sdr_dev;
+            sdr_dev.dev_key = dev_key;
+            sdr_dev.dev_name = dev_name;
+            if (probe(dev_args, sdr_dev)) {
+                found.emplace(dev_key, std::move(sdr_dev));
+                changed = true;
+            }
+        }
+
+        for (const auto &dev: cached) {
+            if (!found.count(dev.first)) {
+                gkEventLogger->publishEvent(tr("SDR device, \"%1\", is no longer present.").arg(dev.second.dev_name),
+                                            GkSeverity::Info, "", false, true, false, false, false);
+                changed = true;
+            }
+        }
+
+        qint32 idx = 0;
+        for (auto &dev: found) {
+            dev.second.event_no = idx++;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock_guard(mtx_cache);
+            m_cache = std::move(found);
+        }
+
+        m_scanned = true;
+        if (changed) {
+            emit devicesChanged(getDevices());
+        }
+    } catch (const std::exception &e) {
+        gkEventLogger->publishEvent(tr("Error encountered whilst enumerating SDR devices via SoapySDR! %1").arg(QString::fromStdString(e.what())),
+                                    GkSeverity::Error, "", false, true, false, true, false);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSdrDiscovery::probe opens a newly found device, which it then keeps open, and finds out what each of its RX
+ * channels is capable of.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param dev_args The arguments of the device, as given by SoapySDR's enumeration.
+ * @param sdr_dev Where the device and its capabilities are to be kept.
+ * @return Whether the device is one that may be made use of.
+ */
+bool GkSdrDiscovery::probe(const SoapySDR::Kwargs &dev_args, GkSoapySdrTableView &sdr_dev)
+{
+    try {
+        void (*unmake)(SoapySDR::Device *) = &SoapySDR::Device::unmake; // Ensure to select the right overload!
+        sdr_dev.dev_ptr = { SoapySDR::Device::make(dev_args), unmake };
+        sdr_dev.dev_hw_key = gkSdrDev->findSoapySdrHwKey(sdr_dev.dev_ptr);
+        if (sdr_dev.dev_hw_key.isEmpty() || sdr_dev.dev_hw_key == "Audio") {
+            return false;
+        }
+
+        sdr_dev.running = false;
+        sdr_dev.initialized = false;
+        sdr_dev.curr_rx_channel = -1;
+
+        const size_t num_chan = sdr_dev.dev_ptr->getNumChannels(SOAPY_SDR_RX);
+        sdr_dev.rx_channels.reserve(num_chan);
+        for (size_t i = 0; i < num_chan; ++i) {
+            GkSoapySdrChannelCaps caps;
+            caps.sample_rates = sdr_dev.dev_ptr->listSampleRates(SOAPY_SDR_RX, i);
+            caps.bandwidths = sdr_dev.dev_ptr->listBandwidths(SOAPY_SDR_RX, i);
+            for (const auto &gain: sdr_dev.dev_ptr->listGains(SOAPY_SDR_RX, i)) {
+                caps.gains.push_back(QString::fromStdString(gain));
+            }
+
+            sdr_dev.rx_channels.push_back(std::move(caps));
+        }
+
+        gkEventLogger->publishEvent(tr("Found SDR device, \"%1\" (%2), with %3 RX channel(s).").arg(sdr_dev.dev_name, sdr_dev.dev_hw_key, QString::number(num_chan)),
+                                    GkSeverity::Info, "", false, true, false, false, false);
+        return true;
+    } catch (const std::exception &e) {
+        //
+        // The device may well be in use by another application, in which case it is tried again upon the next rescan
+        gkEventLogger->publishEvent(tr("Unable to open SDR device, \"%1\". Error: %2").arg(sdr_dev.dev_name, QString::fromStdString(e.what())),
+                                    GkSeverity::Warning, "", false, true, false, false, false);
+    }
+
+    return false;
+}
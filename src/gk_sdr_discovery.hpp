@@ -0,0 +1,104 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include "src/gk_sdr.hpp"
+#include "src/gk_logger.hpp"
+#include <SoapySDR/Device.hpp>
+#include <SoapySDR/Types.hpp>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QPointer>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkSdrDiscovery finds any SoapySDR devices upon a thread of its own, so that the user interface never has to
+ * wait upon the hardware. Each device is opened and probed for what it is capable of only once, upon being found, after
+ * which it is kept within a cache until it goes away again. Rescans happen whenever asked for and, upon Linux, whenever
+ * udev reports that a USB device has come or gone.
+ */
+class GkSdrDiscovery : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GkSdrDiscovery(QPointer<GekkoFyre::GkSdrDev> sdrDev, QPointer<GekkoFyre::GkEventLogger> eventLogger,
+                            QObject *parent = nullptr);
+    ~GkSdrDiscovery() override;
+
+    [[nodiscard]] QList<GekkoFyre::System::GkSdr::GkSoapySdrTableView> getDevices() const;
+
+    [[nodiscard]] static QString deviceKey(const SoapySDR::Kwargs &dev_args);
+    [[nodiscard]] static QString deviceName(const SoapySDR::Kwargs &dev_args);
+
+public slots:
+    void refresh();
+    void stop();
+
+signals:
+    void devicesChanged(const QList<GekkoFyre::System::GkSdr::GkSoapySdrTableView> &sdr_devs);
+
+private:
+    QPointer<GekkoFyre::GkSdrDev> gkSdrDev;
+    QPointer<GekkoFyre::GkEventLogger> gkEventLogger;
+
+    mutable std::mutex mtx_cache;
+    std::map<QString, GekkoFyre::System::GkSdr::GkSoapySdrTableView> m_cache;  // Keyed by GkSdrDiscovery::deviceKey().
+    bool m_scanned;                                                             // Whether a scan has ever completed, so that the first is always published.
+
+    std::thread discoveryThread;
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_rescan;
+
+    void run();
+    void scan();
+    bool probe(const SoapySDR::Kwargs &dev_args, GekkoFyre::System::GkSdr::GkSoapySdrTableView &sdr_dev);
+
+};
+};
@@ -0,0 +1,783 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/gk_sdr_stream.hpp"
+#include <cmath>
+#include <limits>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <exception>
+
+#if __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+using namespace GekkoFyre;
+using namespace Database;
+using namespace Settings;
+using namespace Audio;
+using namespace System;
+using namespace Events;
+using namespace Logging;
+using namespace GkSdr;
+
+/**
+ * @brief GkSoapyIqSource::GkSoapyIqSource
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param device The SoapySDR device to stream from, which should already be tuned and otherwise configured.
+ * @param channel The RX channel to stream from.
+ */
+GkSoapyIqSource::GkSoapyIqSource(std::shared_ptr<SoapySDR::Device> device, const size_t &channel)
+    : m_device(std::move(device)), m_stream(nullptr), m_channel(channel), m_mtu(0), m_directAccess(false),
+      m_nativeCs16(false), m_cs16Scale(1.0f), m_droppedSamples(0)
+{
+    return;
+}
+
+GkSoapyIqSource::~GkSoapyIqSource()
+{
+    deactivate();
+}
+
+/**
+ * @brief GkSoapyIqSource::activate sets up and activates the RX stream, preferring CS16 wherever that is the native
+ * format of the device so that SoapySDR need not convert anything itself.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The maximum transmission unit of the stream, in samples.
+ * @note SoapySDR <https://github.com/pothosware/SoapySDR/wiki/Cpp_API_Example>.
+ */
+size_t GkSoapyIqSource::activate()
+{
+    try {
+        if (!m_device) {
+            throw std::invalid_argument(QObject::tr("Unable to begin streaming, as no SDR device has been given!").toStdString());
+        }
+
+        double full_scale = 0.0;
+        const std::string native_fmt = m_device->getNativeStreamFormat(SOAPY_SDR_RX, m_channel, full_scale);
+        m_nativeCs16 = (native_fmt == SOAPY_SDR_CS16);
+        m_cs16Scale = (m_nativeCs16 && full_scale > 0.0) ? static_cast<float>(1.0 / full_scale) : (1.0f / 32768.0f);
+
+        m_stream = m_device->setupStream(SOAPY_SDR_RX, m_nativeCs16 ? SOAPY_SDR_CS16 : SOAPY_SDR_CF32, { m_channel });
+        if (!m_stream) {
+            throw std::runtime_error(QObject::tr("Unable to setup RX stream for SDR device!").toStdString());
+        }
+
+        m_mtu = std::max<size_t>(m_device->getStreamMTU(m_stream), 1);
+        m_droppedSamples = 0;
+
+        //
+        // Direct access buffers are always in the native format of the device, which is only the same as the format of
+        // the stream when that is either CS16 or CF32! Anything else (i.e. CS8 or CU8) is left to `readStream()`.
+        m_directAccess = (native_fmt == SOAPY_SDR_CS16 || native_fmt == SOAPY_SDR_CF32) &&
+                         (m_device->getNumDirectAccessBuffers(m_stream) > 0);
+        if (m_nativeCs16 && !m_directAccess) {
+            m_cs16Buf.resize(std::max<size_t>(m_mtu, GK_SDR_STREAM_BLOCK_SAMPLES));
+        }
+
+        const qint32 ret = m_device->activateStream(m_stream);
+        if (ret != 0) {
+            throw std::runtime_error(QObject::tr("Unable to activate RX stream for SDR device: %1")
+                                             .arg(QString::fromUtf8(SoapySDR::errToStr(ret))).toStdString());
+        }
+
+        return m_mtu;
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return 0;
+}
+
+/**
+ * @brief GkSoapyIqSource::deactivate
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkSoapyIqSource::deactivate()
+{
+    if (m_device && m_stream) {
+        m_device->deactivateStream(m_stream);
+        m_device->closeStream(m_stream);
+        m_stream = nullptr;
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSoapyIqSource::read waits upon the next samples from the device. With direct access, the samples are taken
+ * straight from the driver's own DMA buffer and converted into `out`, which is then handed back to the driver at once,
+ * thereby skipping the intermediary copy made by `readStream()`.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param out Where the converted samples are to be written.
+ * @param capacity The maximum number of samples that may be written towards `out`.
+ * @param flags The flags as returned by the device.
+ * @param time_ns The hardware timestamp of the first sample, if there is one.
+ * @return The number of samples written, or a (negative) SoapySDR error code.
+ */
+qint32 GkSoapyIqSource::read(std::complex<float> *out, const size_t &capacity, qint32 &flags, qint64 &time_ns)
+{
+    long long hw_time = 0;
+    int hw_flags = 0;
+    if (m_directAccess) {
+        size_t handle = 0;
+        const void *buffs[1] = { nullptr };
+        const int ret = m_device->acquireReadBuffer(m_stream, handle, buffs, hw_flags, hw_time, GK_SDR_STREAM_READ_TIMEOUT_MICROSECS);
+        if (ret == SOAPY_SDR_NOT_SUPPORTED) {
+            //
+            // The driver says that it has direct access buffers, but then won't let us use them!
+            m_directAccess = false;
+            if (m_nativeCs16) {
+                m_cs16Buf.resize(std::max<size_t>(m_mtu, capacity));
+            }
+
+            return SOAPY_SDR_TIMEOUT;
+        }
+
+        if (ret < 0) {
+            return ret;
+        }
+
+        const size_t count = std::min<size_t>(static_cast<size_t>(ret), capacity);
+        if (static_cast<size_t>(ret) > count) {
+            m_droppedSamples += static_cast<size_t>(ret) - count;
+        }
+
+        if (m_nativeCs16) {
+            const auto *src = static_cast<const qint16 *>(buffs[0]);
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = { src[(i * 2)] * m_cs16Scale, src[(i * 2) + 1] * m_cs16Scale };
+            }
+        } else {
+            std::memcpy(out, buffs[0], count * sizeof(std::complex<float>));
+        }
+
+        m_device->releaseReadBuffer(m_stream, handle);
+        flags = hw_flags;
+        time_ns = hw_time;
+
+        return static_cast<qint32>(count);
+    }
+
+    if (m_nativeCs16) {
+        void *buffs[1] = { m_cs16Buf.data() };
+        const size_t num_elems = std::min(capacity, m_cs16Buf.size());
+        const int ret = m_device->readStream(m_stream, buffs, num_elems, hw_flags, hw_time, GK_SDR_STREAM_READ_TIMEOUT_MICROSECS);
+        if (ret < 0) {
+            return ret;
+        }
+
+        for (qint32 i = 0; i < ret; ++i) {
+            out[i] = { m_cs16Buf[i].real() * m_cs16Scale, m_cs16Buf[i].imag() * m_cs16Scale };
+        }
+
+        flags = hw_flags;
+        time_ns = hw_time;
+        return ret;
+    }
+
+    void *buffs[1] = { out };
+    const int ret = m_device->readStream(m_stream, buffs, capacity, hw_flags, hw_time, GK_SDR_STREAM_READ_TIMEOUT_MICROSECS);
+    flags = hw_flags;
+    time_ns = hw_time;
+
+    return ret;
+}
+
+/**
+ * @brief GkSoapyIqSource::getSampleRate
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The sample rate that the device is currently set to.
+ */
+double GkSoapyIqSource::getSampleRate() const
+{
+    return m_device ? m_device->getSampleRate(SOAPY_SDR_RX, m_channel) : 0.0;
+}
+
+/**
+ * @brief GkSoapyIqSource::getName
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return A name for the source that is suitable for display towards the end-user.
+ */
+QString GkSoapyIqSource::getName() const
+{
+    return m_device ? QString::fromStdString(m_device->getHardwareKey()) : QString();
+}
+
+/**
+ * @brief GkSoapyIqSource::getDroppedSamples
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The number of samples discarded from direct access buffers that were larger than the block being filled.
+ */
+quint64 GkSoapyIqSource::getDroppedSamples() const
+{
+    return m_droppedSamples;
+}
+
+/**
+ * @brief GkSoapyIqSource::isDirectAccess
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return Whether samples are being read straight from the driver's own DMA buffers.
+ */
+bool GkSoapyIqSource::isDirectAccess() const
+{
+    return m_directAccess;
+}
+
+/**
+ * @brief GkFileIqSource::GkFileIqSource
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param file_path The raw IQ recording to be replayed.
+ * @param format The sample format of the recording.
+ * @param sample_rate The sample rate of the recording, measured in hertz.
+ * @param loop Whether to start over again from the beginning once the end of the recording is reached.
+ * @param real_time Whether to pace the replay so that it runs no faster than the recording itself did.
+ * @param data_offset Where the samples begin within the file, measured in bytes.
+ */
+GkFileIqSource::GkFileIqSource(const QFileInfo &file_path, const GkIqFormat &format, const double &sample_rate,
+                               const bool &loop, const bool &real_time, const qint64 &data_offset)
+    : m_file(file_path.absoluteFilePath()), m_name(file_path.fileName()), m_format(format), m_sampleRate(sample_rate),
+      m_loop(loop), m_realTime(real_time), m_dataOffset(data_offset), m_data(nullptr), m_numSamples(0), m_pos(0),
+      m_samplesEmitted(0)
+{
+    return;
+}
+
+GkFileIqSource::~GkFileIqSource()
+{
+    deactivate();
+}
+
+/**
+ * @brief GkFileIqSource::activate maps the recording into memory and begins the replay from the very start.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The largest number of samples that may be returned by a single read.
+ */
+size_t GkFileIqSource::activate()
+{
+    try {
+        if (!m_file.isOpen() && !m_file.open(QIODevice::ReadOnly)) {
+            throw std::runtime_error(QObject::tr("Unable to open IQ recording, \"%1\": %2").arg(m_name, m_file.errorString()).toStdString());
+        }
+
+        if (m_sampleRate <= 0.0) {
+            throw std::invalid_argument(QObject::tr("An invalid sample rate has been given for IQ recording, \"%1\"!").arg(m_name).toStdString());
+        }
+
+        const qint64 data_size = m_file.size() - m_dataOffset;
+        m_numSamples = (data_size > 0) ? (data_size / static_cast<qint64>(bytesPerSample())) : 0;
+        if (m_numSamples < 1) {
+            throw std::invalid_argument(QObject::tr("The IQ recording, \"%1\", holds no samples!").arg(m_name).toStdString());
+        }
+
+        m_data = m_file.map(m_dataOffset, m_numSamples * static_cast<qint64>(bytesPerSample()));
+        if (!m_data) {
+            throw std::runtime_error(QObject::tr("Unable to memory-map IQ recording, \"%1\": %2").arg(m_name, m_file.errorString()).toStdString());
+        }
+
+        #if __linux__
+        madvise(const_cast<uchar *>(m_data), static_cast<size_t>(m_numSamples) * bytesPerSample(), MADV_SEQUENTIAL);
+        #endif
+
+        m_pos = 0;
+        m_samplesEmitted = 0;
+        m_startTime = std::chrono::steady_clock::now();
+
+        return GK_SDR_STREAM_BLOCK_SAMPLES;
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return 0;
+}
+
+/**
+ * @brief GkFileIqSource::deactivate
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkFileIqSource::deactivate()
+{
+    if (m_data) {
+        m_file.unmap(const_cast<uchar *>(m_data));
+        m_data = nullptr;
+    }
+
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+
+    return;
+}
+
+/**
+ * @brief GkFileIqSource::read converts the next samples of the recording, after first waiting until they would have
+ * arrived from real hardware if replaying in real-time.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param out Where the converted samples are to be written.
+ * @param capacity The maximum number of samples that may be written towards `out`.
+ * @param flags Always zero.
+ * @param time_ns The time of the first sample, relative to the start of the recording.
+ * @return The number of samples written, or zero once the end of the recording has been reached.
+ */
+qint32 GkFileIqSource::read(std::complex<float> *out, const size_t &capacity, qint32 &flags, qint64 &time_ns)
+{
+    flags = 0;
+    if (!m_data) {
+        return SOAPY_SDR_STREAM_ERROR;
+    }
+
+    if (m_pos >= m_numSamples) {
+        if (!m_loop) {
+            return 0;
+        }
+
+        m_pos = 0;
+    }
+
+    const auto count = static_cast<size_t>(std::min<qint64>(static_cast<qint64>(capacity), m_numSamples - m_pos));
+    time_ns = static_cast<qint64>((static_cast<double>(m_pos) / m_sampleRate) * 1e9);
+
+    if (m_realTime) {
+        const auto due = m_startTime + std::chrono::nanoseconds(static_cast<qint64>(((m_samplesEmitted + count) / m_sampleRate) * 1e9));
+        std::this_thread::sleep_until(due);
+    }
+
+    const uchar *src = m_data + (m_pos * static_cast<qint64>(bytesPerSample()));
+    switch (m_format) {
+        case IqCf32:
+            std::memcpy(out, src, count * sizeof(std::complex<float>));
+            break;
+        case IqCs16:
+        {
+            constexpr float scale = 1.0f / 32768.0f;
+            for (size_t i = 0; i < count; ++i) {
+                qint16 iq[2];
+                std::memcpy(iq, src + (i * sizeof(iq)), sizeof(iq));
+                out[i] = { iq[0] * scale, iq[1] * scale };
+            }
+
+            break;
+        }
+        case IqCu8:
+        {
+            constexpr float scale = 1.0f / 127.5f;
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = { (src[(i * 2)] - 127.5f) * scale, (src[(i * 2) + 1] - 127.5f) * scale };
+            }
+
+            break;
+        }
+        default:
+            return SOAPY_SDR_NOT_SUPPORTED;
+    }
+
+    m_pos += static_cast<qint64>(count);
+    m_samplesEmitted += count;
+
+    return static_cast<qint32>(count);
+}
+
+/**
+ * @brief GkFileIqSource::getSampleRate
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The sample rate of the recording.
+ */
+double GkFileIqSource::getSampleRate() const
+{
+    return m_sampleRate;
+}
+
+/**
+ * @brief GkFileIqSource::getName
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The file name of the recording.
+ */
+QString GkFileIqSource::getName() const
+{
+    return m_name;
+}
+
+/**
+ * @brief GkFileIqSource::getSampleCount
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The number of complex samples within the recording, once activated.
+ */
+qint64 GkFileIqSource::getSampleCount() const
+{
+    return m_numSamples;
+}
+
+/**
+ * @brief GkFileIqSource::bytesPerSample
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The size of a single complex sample within the recording, in bytes.
+ */
+size_t GkFileIqSource::bytesPerSample() const
+{
+    switch (m_format) {
+        case IqCf32:
+            return sizeof(float) * 2;
+        case IqCs16:
+            return sizeof(qint16) * 2;
+        case IqCu8:
+            return sizeof(quint8) * 2;
+        default:
+            break;
+    }
+
+    return sizeof(float) * 2;
+}
+
+/**
+ * @brief GkSdrStream::GkSdrStream runs a dedicated reader thread upon an IQ source, whether that be an SDR device or a
+ * recording, and hands the samples downstream through lock-free queues, one for each consumer. All memory is allocated
+ * before the stream begins.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param eventLogger The event logging class.
+ * @param parent The parent object to this class.
+ */
+GkSdrStream::GkSdrStream(QPointer<GkEventLogger> eventLogger, QObject *parent)
+    : QObject(parent), m_running(false), m_sampleRate(0.0), m_freeBlocks(GK_SDR_STREAM_POOL_BLOCKS), m_numSinks(0),
+      m_statBlocks(0), m_statSamples(0), m_statOverflows(0), m_statDropped(0), m_statSourceDropped(0), m_statTimeouts(0), m_statErrors(0)
+{
+    gkEventLogger = std::move(eventLogger);
+
+    return;
+}
+
+GkSdrStream::~GkSdrStream()
+{
+    stop();
+}
+
+/**
+ * @brief GkSdrStream::addSink registers a new consumer of the stream, which must be done before the stream is started.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The identifier of the consumer, for use with GkSdrStream::popBlock().
+ */
+qint32 GkSdrStream::addSink()
+{
+    if (m_running) {
+        throw std::runtime_error(tr("Consumers may not be added towards an SDR stream that is already running!").toStdString());
+    }
+
+    if (m_numSinks >= GK_SDR_STREAM_MAX_SINKS) {
+        throw std::runtime_error(tr("No more than %1 consumers may share a single SDR stream!").arg(QString::number(GK_SDR_STREAM_MAX_SINKS)).toStdString());
+    }
+
+    m_sinks[m_numSinks] = std::make_unique<GkLockFreeQueue<GkIqBlock *>>(GK_SDR_STREAM_POOL_BLOCKS);
+    return m_numSinks++;
+}
+
+/**
+ * @brief GkSdrStream::start activates the given source and begins streaming from it.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param source The source of the IQ samples.
+ */
+void GkSdrStream::start(std::unique_ptr<GkIqSource> source)
+{
+    try {
+        stop();
+        if (!source) {
+            throw std::invalid_argument(tr("Unable to begin streaming, as no source of IQ samples has been given!").toStdString());
+        }
+
+        m_source = std::move(source);
+        const size_t block_capacity = std::max<size_t>(m_source->activate(), GK_SDR_STREAM_BLOCK_SAMPLES);
+        m_sampleRate = m_source->getSampleRate();
+
+        //
+        // Allocate the entire pool now, so that the reader thread never has to!
+        GkIqBlock *block;
+        while (m_freeBlocks.pop(block)) {}
+        m_pool.clear();
+        for (size_t i = 0; i < GK_SDR_STREAM_POOL_BLOCKS; ++i) {
+            auto new_block = std::make_unique<GkIqBlock>();
+            new_block->samples.resize(block_capacity);
+            new_block->refs = 0;
+            m_freeBlocks.push(new_block.get());
+            m_pool.push_back(std::move(new_block));
+        }
+
+        m_spillBuf.resize(block_capacity);
+        m_statBlocks = 0;
+        m_statSamples = 0;
+        m_statOverflows = 0;
+        m_statDropped = 0;
+        m_statSourceDropped = 0;
+        m_statTimeouts = 0;
+        m_statErrors = 0;
+
+        m_running = true;
+        readerThread = std::thread(&GkSdrStream::run, this);
+        emit streamStarted(m_sampleRate);
+
+        gkEventLogger->publishEvent(tr("Streaming of IQ samples from, \"%1\", has begun at %2 samples/sec.")
+                                            .arg(m_source->getName(), QString::number(m_sampleRate.load(), 'f', 0)),
+                                    GkSeverity::Info, "", false, true, false, false, false);
+    } catch (const std::exception &e) {
+        m_running = false;
+        if (m_source) {
+            m_source->deactivate();
+            m_source.reset();
+        }
+
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSdrStream::stop halts the reader thread and deactivates the source. Every consumer must have stopped popping
+ * blocks beforehand, as the pool is freed once the stream is next started.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkSdrStream::stop()
+{
+    m_running = false;
+    if (readerThread.joinable()) {
+        readerThread.join();
+    }
+
+    if (m_source) {
+        m_source->deactivate();
+        m_source.reset();
+    }
+
+    //
+    // Return anything left unconsumed towards the pool!
+    GkIqBlock *block;
+    for (qint32 i = 0; i < m_numSinks; ++i) {
+        while (m_sinks[i]->pop(block)) {
+            releaseBlock(block);
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSdrStream::isRunning
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return Whether the reader thread is running.
+ */
+bool GkSdrStream::isRunning() const
+{
+    return m_running;
+}
+
+/**
+ * @brief GkSdrStream::getSampleRate
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The sample rate of the stream, measured in hertz.
+ */
+double GkSdrStream::getSampleRate() const
+{
+    return m_sampleRate;
+}
+
+/**
+ * @brief GkSdrStream::getStats
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The statistics of the stream, since it was last started.
+ */
+GkSdrStreamStats GkSdrStream::getStats() const
+{
+    GkSdrStreamStats stats;
+    stats.blocks = m_statBlocks;
+    stats.samples = m_statSamples;
+    stats.overflows = m_statOverflows;
+    stats.dropped = m_statDropped;
+    stats.source_dropped = m_statSourceDropped;
+    stats.timeouts = m_statTimeouts;
+    stats.errors = m_statErrors;
+
+    return stats;
+}
+
+/**
+ * @brief GkSdrStream::popBlock takes the next block of samples for the given consumer, if there is one. This never
+ * blocks, and so the consumer should sleep for GK_SDR_STREAM_CONSUMER_IDLE_MICROSECS or so whenever it returns nothing.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sink The identifier of the consumer, as returned by GkSdrStream::addSink().
+ * @return The next block, which must be handed back via GkSdrStream::releaseBlock() once finished with, or nullptr.
+ */
+GkIqBlock *GkSdrStream::popBlock(const qint32 &sink)
+{
+    GkIqBlock *block = nullptr;
+    if (sink >= 0 && sink < m_numSinks) {
+        if (m_sinks[sink]->pop(block)) {
+            return block;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief GkSdrStream::releaseBlock hands a block back, and returns it towards the pool once every consumer has done so.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param block The block that the consumer has finished with.
+ */
+void GkSdrStream::releaseBlock(GkIqBlock *block)
+{
+    if (block && block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        m_freeBlocks.push(std::move(block));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSdrStream::run is the reader thread itself, which does nothing other than read from the source and dispatch
+ * the samples, so that the device is drained as promptly as possible.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkSdrStream::run()
+{
+    raiseThreadPriority();
+
+    quint64 sequence = 0;
+    bool overflowed = false;
+    qint32 consec_errors = 0;
+    while (m_running) {
+        GkIqBlock *block = nullptr;
+        const bool have_block = m_freeBlocks.pop(block);
+
+        std::complex<float> *dest = have_block ? block->samples.data() : m_spillBuf.data();
+        const size_t capacity = have_block ? block->samples.size() : m_spillBuf.size();
+
+        qint32 flags = 0;
+        qint64 time_ns = 0;
+        const qint32 ret = m_source->read(dest, capacity, flags, time_ns);
+        m_statSourceDropped = m_source->getDroppedSamples();
+        if (ret > 0) {
+            consec_errors = 0;
+            if (!have_block) {
+                //
+                // Every block is still held by the consumers, so these samples have to go!
+                ++m_statDropped;
+                ++sequence;
+                continue;
+            }
+
+            block->count = static_cast<size_t>(ret);
+            block->time_ns = (flags & SOAPY_SDR_HAS_TIME) ? time_ns : 0;
+            block->sequence = sequence++;
+            block->overflow = overflowed;
+            overflowed = false;
+
+            dispatch(block);
+            continue;
+        }
+
+        if (have_block) {
+            m_freeBlocks.push(std::move(block));
+        }
+
+        if (ret == 0) {
+            //
+            // We have reached the end of a recording!
+            m_running = false;
+            emit streamFinished();
+            break;
+        } else if (ret == SOAPY_SDR_TIMEOUT) {
+            ++m_statTimeouts;
+        } else if (ret == SOAPY_SDR_OVERFLOW) {
+            ++m_statOverflows;
+            overflowed = true;
+        } else {
+            ++m_statErrors;
+            if (++consec_errors >= GK_SDR_STREAM_MAX_CONSEC_ERRORS) {
+                m_running = false;
+                emit streamError(tr("Streaming from the SDR device has ceased due to repeated errors: %1")
+                                         .arg(QString::fromUtf8(SoapySDR::errToStr(ret))));
+                break;
+            }
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSdrStream::dispatch hands a freshly filled block towards every consumer. Any consumer whose queue is full has
+ * simply fallen behind, and so misses out on the block rather than holding up the others.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param block The block to be dispatched.
+ */
+void GkSdrStream::dispatch(GkIqBlock *block)
+{
+    block->refs.store(m_numSinks + 1, std::memory_order_relaxed); // Hold an extra reference until all are dispatched!
+    for (qint32 i = 0; i < m_numSinks; ++i) {
+        GkIqBlock *queued = block;
+        if (!m_sinks[i]->push(std::move(queued))) {
+            ++m_statDropped;
+            block->refs.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    ++m_statBlocks;
+    m_statSamples += block->count;
+    releaseBlock(block);
+
+    return;
+}
+
+/**
+ * @brief GkSdrStream::raiseThreadPriority attempts to give the reader thread a real-time priority. This will quite often
+ * fail without the right privileges, in which case the thread simply carries on at its normal priority.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkSdrStream::raiseThreadPriority()
+{
+    #if __linux__
+    sched_param param = {};
+    param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+    pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    #endif
+
+    return;
+}
@@ -0,0 +1,241 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include "src/gk_logger.hpp"
+#include "src/gk_lockfree_queue.hpp"
+#include <SoapySDR/Device.hpp>
+#include <SoapySDR/Formats.hpp>
+#include <SoapySDR/Errors.hpp>
+#include <SoapySDR/Types.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <complex>
+#include <QFile>
+#include <QObject>
+#include <QString>
+#include <QPointer>
+#include <QFileInfo>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkIqBlock is a block of complex baseband samples, which is drawn from a pool allocated when the stream begins
+ * and is shared between every consumer of that stream. It is returned towards the pool once each consumer has released
+ * it via GkSdrStream::releaseBlock().
+ */
+struct GkIqBlock {
+    std::vector<std::complex<float>> samples;                                   // Sized up-front to the block capacity; only the first `count` are valid.
+    size_t count = 0;
+    qint64 time_ns = 0;                                                         // The hardware timestamp of the first sample, if the device provides one.
+    quint64 sequence = 0;                                                       // Gaps in the sequence mean that blocks were dropped.
+    bool overflow = false;                                                      // Whether samples were lost by the device immediately beforehand.
+    std::atomic<qint32> refs;
+};
+
+/**
+ * @brief GkIqSource is anything that can supply a stream of complex baseband samples, whether that be an SDR device or
+ * a recording thereof.
+ */
+class GkIqSource {
+
+public:
+    virtual ~GkIqSource() = default;
+
+    /**
+     * @brief activate begins streaming.
+     * @return The largest number of samples that a single call to GkIqSource::read() may return.
+     */
+    virtual size_t activate() = 0;
+    virtual void deactivate() = 0;
+
+    /**
+     * @brief read waits for, and then converts, the next samples from the source.
+     * @return The number of samples written towards `out`, zero at the end of a finite source, or a (negative) SoapySDR
+     * error code.
+     */
+    virtual qint32 read(std::complex<float> *out, const size_t &capacity, qint32 &flags, qint64 &time_ns) = 0;
+
+    [[nodiscard]] virtual double getSampleRate() const = 0;
+    [[nodiscard]] virtual QString getName() const = 0;
+
+    /**
+     * @brief getDroppedSamples
+     * @return The number of samples that the source itself has had to discard, since it was last activated.
+     */
+    [[nodiscard]] virtual quint64 getDroppedSamples() const { return 0; }
+
+};
+
+/**
+ * @brief GkSoapyIqSource streams from a SoapySDR device, in its native format of either CS16 or CF32. The device's own
+ * DMA buffers are read from directly wherever the driver supports it, but only when they are in one of those two formats.
+ */
+class GkSoapyIqSource : public GkIqSource {
+
+public:
+    explicit GkSoapyIqSource(std::shared_ptr<SoapySDR::Device> device, const size_t &channel);
+    ~GkSoapyIqSource() override;
+
+    size_t activate() override;
+    void deactivate() override;
+    qint32 read(std::complex<float> *out, const size_t &capacity, qint32 &flags, qint64 &time_ns) override;
+
+    [[nodiscard]] double getSampleRate() const override;
+    [[nodiscard]] QString getName() const override;
+    [[nodiscard]] quint64 getDroppedSamples() const override;
+    [[nodiscard]] bool isDirectAccess() const;
+
+private:
+    std::shared_ptr<SoapySDR::Device> m_device;
+    SoapySDR::Stream *m_stream;
+    size_t m_channel;
+    size_t m_mtu;
+    bool m_directAccess;
+    bool m_nativeCs16;
+    float m_cs16Scale;
+    std::vector<std::complex<qint16>> m_cs16Buf;                                // Only needed when reading CS16 without direct access.
+    std::atomic<quint64> m_droppedSamples;                                      // Samples within a direct access buffer that did not fit within `out`.
+
+};
+
+/**
+ * @brief GkFileIqSource replays a raw IQ recording from disk, via a memory-map, so that everything downstream of the SDR
+ * may be exercised without any hardware attached. It may be paced in real-time, or run as fast as the consumers allow.
+ */
+class GkFileIqSource : public GkIqSource {
+
+public:
+    explicit GkFileIqSource(const QFileInfo &file_path, const GekkoFyre::System::GkSdr::GkIqFormat &format,
+                            const double &sample_rate = GK_SDR_FILE_REPLAY_DEFAULT_RATE, const bool &loop = false,
+                            const bool &real_time = true, const qint64 &data_offset = 0);
+    ~GkFileIqSource() override;
+
+    size_t activate() override;
+    void deactivate() override;
+    qint32 read(std::complex<float> *out, const size_t &capacity, qint32 &flags, qint64 &time_ns) override;
+
+    [[nodiscard]] double getSampleRate() const override;
+    [[nodiscard]] QString getName() const override;
+    [[nodiscard]] qint64 getSampleCount() const;
+
+private:
+    QFile m_file;
+    QString m_name;
+    GekkoFyre::System::GkSdr::GkIqFormat m_format;
+    double m_sampleRate;
+    bool m_loop;
+    bool m_realTime;
+    qint64 m_dataOffset;
+
+    const uchar *m_data;
+    qint64 m_numSamples;
+    qint64 m_pos;
+    quint64 m_samplesEmitted;
+    std::chrono::steady_clock::time_point m_startTime;
+
+    [[nodiscard]] size_t bytesPerSample() const;
+
+};
+
+class GkSdrStream : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GkSdrStream(QPointer<GekkoFyre::GkEventLogger> eventLogger, QObject *parent = nullptr);
+    ~GkSdrStream() override;
+
+    [[nodiscard]] qint32 addSink();
+    void start(std::unique_ptr<GekkoFyre::GkIqSource> source);
+    void stop();
+
+    [[nodiscard]] bool isRunning() const;
+    [[nodiscard]] double getSampleRate() const;
+    [[nodiscard]] GekkoFyre::System::GkSdr::GkSdrStreamStats getStats() const;
+
+    [[nodiscard]] GekkoFyre::GkIqBlock *popBlock(const qint32 &sink);
+    void releaseBlock(GekkoFyre::GkIqBlock *block);
+
+signals:
+    void streamStarted(const double &sample_rate);
+    void streamFinished();
+    void streamError(const QString &error_msg);
+
+private:
+    QPointer<GekkoFyre::GkEventLogger> gkEventLogger;
+    std::unique_ptr<GekkoFyre::GkIqSource> m_source;
+
+    //
+    // Multithreading
+    std::thread readerThread;
+    std::atomic<bool> m_running;
+    std::atomic<double> m_sampleRate;
+
+    //
+    // The pool of IQ blocks, along with a queue of pointers into the pool for each consumer
+    std::vector<std::unique_ptr<GekkoFyre::GkIqBlock>> m_pool;
+    GkLockFreeQueue<GekkoFyre::GkIqBlock *> m_freeBlocks;
+    std::array<std::unique_ptr<GkLockFreeQueue<GekkoFyre::GkIqBlock *>>, GK_SDR_STREAM_MAX_SINKS> m_sinks;
+    qint32 m_numSinks;
+    std::vector<std::complex<float>> m_spillBuf;                                // Drained into whenever the pool runs dry, so the device never overflows.
+
+    //
+    // Statistics
+    std::atomic<quint64> m_statBlocks;
+    std::atomic<quint64> m_statSamples;
+    std::atomic<quint64> m_statOverflows;
+    std::atomic<quint64> m_statDropped;
+    std::atomic<quint64> m_statSourceDropped;
+    std::atomic<quint64> m_statTimeouts;
+    std::atomic<quint64> m_statErrors;
+
+    void run();
+    void dispatch(GekkoFyre::GkIqBlock *block);
+    static void raiseThreadPriority();
+
+};
+};
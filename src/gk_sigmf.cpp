@@ -0,0 +1,711 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/gk_sigmf.hpp"
+#include "src/gk_app_vers.hpp"
+#include <cmath>
+#include <chrono>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <exception>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+
+using namespace GekkoFyre;
+using namespace System;
+using namespace Events;
+using namespace Logging;
+using namespace GkSdr;
+
+/**
+ * @brief GkSigmfIqSource::GkSigmfIqSource
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param file_path Either the data or the metadata of a SigMF recording, or the path they share bar the extension.
+ * @param loop Whether to start over again from the beginning once the end of the recording is reached.
+ * @param real_time Whether to pace the replay so that it runs no faster than the recording itself did, or otherwise as
+ * fast as the consumers of the stream allow.
+ */
+GkSigmfIqSource::GkSigmfIqSource(const QFileInfo &file_path, const bool &loop, const bool &real_time)
+    : GkSigmfIqSource(file_path, GkSigmfRecorder::readMeta(file_path), loop, real_time)
+{
+    return;
+}
+
+GkSigmfIqSource::GkSigmfIqSource(const QFileInfo &file_path, const GkSigmfMeta &meta, const bool &loop, const bool &real_time)
+    : GkFileIqSource(QFileInfo(GkSigmfRecorder::dataPath(file_path)), meta.format, meta.sample_rate, loop, real_time, 0),
+      m_meta(meta)
+{
+    return;
+}
+
+/**
+ * @brief GkSigmfIqSource::getName
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The description of the recording, if it has one, or otherwise its file name.
+ */
+QString GkSigmfIqSource::getName() const
+{
+    if (!m_meta.description.isEmpty()) {
+        return m_meta.description;
+    }
+
+    return GkFileIqSource::getName();
+}
+
+/**
+ * @brief GkSigmfIqSource::getMeta
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The metadata of the recording, such as the frequency it was tuned towards.
+ */
+const GkSigmfMeta &GkSigmfIqSource::getMeta() const
+{
+    return m_meta;
+}
+
+/**
+ * @brief GkSigmfRecorder::GkSigmfRecorder
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sdrStream The stream of IQ samples, which must not yet be running as a consumer is registered upon it here.
+ * @param eventLogger The event logging class.
+ * @param parent The parent object to this class.
+ */
+GkSigmfRecorder::GkSigmfRecorder(QPointer<GkSdrStream> sdrStream, QPointer<GkEventLogger> eventLogger, QObject *parent)
+    : QObject(parent), m_sink(-1), m_active(nullptr), m_inUse(false), m_sampleRate(0.0), m_centerFreq(0.0),
+      m_freqChanged(false), m_pending(false), m_pendingFormat(IqCf32), m_running(false)
+{
+    gkSdrStream = std::move(sdrStream);
+    gkEventLogger = std::move(eventLogger);
+
+    m_sink = gkSdrStream->addSink();
+
+    return;
+}
+
+GkSigmfRecorder::~GkSigmfRecorder()
+{
+    stop();
+}
+
+/**
+ * @brief GkSigmfRecorder::startRecording begins recording the stream towards disk. Should the stream not yet be running,
+ * then the recording instead begins along with it.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param file_path Where the recording is to be made, with the '.sigmf-data' and '.sigmf-meta' extensions being added
+ * if need be.
+ * @param format The format of the samples upon disk, being either 32-bit floats or 16-bit integers.
+ * @param description A description of the recording, which is kept within its metadata.
+ */
+void GkSigmfRecorder::startRecording(const QFileInfo &file_path, const GkIqFormat &format, const QString &description)
+{
+    try {
+        stopRecording();
+        if (format != IqCf32 && format != IqCs16) {
+            throw std::invalid_argument(tr("IQ may only be recorded as either 32-bit floats or 16-bit integers!").toStdString());
+        }
+
+        if (!m_running) {
+            m_pending = true;
+            m_pendingPath = file_path;
+            m_pendingFormat = format;
+            m_pendingDescription = description;
+
+            gkEventLogger->publishEvent(tr("Recording of IQ towards \"%1\" shall begin once the SDR stream has started.").arg(dataPath(file_path)),
+                                        GkSeverity::Info, "", false, true, false, false, false);
+            return;
+        }
+
+        m_pending = false;
+        auto session = std::make_unique<GkSigmfSession>();
+        session->dataPath = dataPath(file_path);
+        session->metaPath = metaPath(file_path);
+        session->bytesPerSample = (format == IqCs16) ? sizeof(std::complex<qint16>) : sizeof(std::complex<float>);
+
+        session->meta.datatype = formatToDatatype(format);
+        session->meta.format = format;
+        session->meta.sample_rate = m_sampleRate;
+        session->meta.description = description;
+        session->meta.hardware = m_hardware;
+        session->meta.recorder = QString("%1 v%2").arg(General::productName, General::appVersion);
+
+        GkSigmfCapture capture;
+        capture.sample_start = 0;
+        capture.frequency = m_centerFreq;
+        capture.datetime = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+        session->meta.captures.reserve(GK_SIGMF_MAX_ANNOTATIONS);
+        session->meta.captures.push_back(capture);
+        session->events.reserve(GK_SIGMF_MAX_ANNOTATIONS);
+        m_freqChanged = false;
+
+        //
+        // The metadata is written out straight away, so that the recording may still be made use of should we never get the
+        // chance to finish it off properly...
+        writeMeta(session->metaPath, session->meta);
+
+        session->file.setFileName(session->dataPath);
+        if (!session->file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered)) {
+            throw std::runtime_error(tr("Unable to open \"%1\" for recording: %2").arg(session->dataPath, session->file.errorString()).toStdString());
+        }
+
+        for (qint32 i = 0; i < GK_SIGMF_WRITE_BUFFERS; ++i) {
+            auto buffer = std::make_unique<GkSigmfBuffer>();
+            buffer->data.reset(new (std::align_val_t(GK_SIGMF_WRITE_ALIGN)) char[GK_SIGMF_WRITE_BUFFER_BYTES]);
+            session->freeBuffers.push(buffer.get());
+            session->pool.push_back(std::move(buffer));
+        }
+
+        GkSigmfSession *active = session.get();
+        active->writerThread = std::thread(&GkSigmfRecorder::writeBuffers, this, active);
+        m_session = std::move(session);
+        m_active.store(active);
+
+        gkEventLogger->publishEvent(tr("Recording IQ towards \"%1\" at %2 samples per second.").arg(active->dataPath, QString::number(m_sampleRate.load(), 'f', 0)),
+                                    GkSeverity::Info, "", false, true, false, false, false);
+        emit recordingStarted(active->dataPath);
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSigmfRecorder::stopRecording finishes off the recording, if there is one, by writing out whatever is left and
+ * then noting any overflows and dropped samples within its metadata.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkSigmfRecorder::stopRecording()
+{
+    m_pending = false;
+    if (!m_session) {
+        return;
+    }
+
+    //
+    // Wait for the consumer thread to let go of the recording, should it be in the midst of a block...
+    m_active.store(nullptr);
+    while (m_inUse.load()) {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    std::unique_ptr<GkSigmfSession> session = std::move(m_session);
+    if (session->current) {
+        if (session->current->used > 0) {
+            session->filledBuffers.push(session->current);
+        }
+
+        session->current = nullptr;
+    }
+
+    session->finishing = true;
+    if (session->writerThread.joinable()) {
+        session->writerThread.join();
+    }
+
+    session->file.close();
+
+    try {
+        session->meta.annotations = session->events;
+        writeMeta(session->metaPath, session->meta);
+    } catch (const std::exception &e) {
+        gkEventLogger->publishEvent(QString::fromStdString(e.what()), GkSeverity::Error, "", false, true, false, true, false);
+    }
+
+    if (session->dropped > 0) {
+        gkEventLogger->publishEvent(tr("%1 samples were lost whilst recording towards \"%2\", as the disk could not keep up!")
+                                    .arg(QString::number(session->dropped.load()), session->dataPath), GkSeverity::Warning,
+                                    "", false, true, false, false, false);
+    }
+
+    emit recordingFinished(session->dataPath, session->samples);
+    return;
+}
+
+/**
+ * @brief GkSigmfRecorder::setHardware
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param hardware The name of the SDR device, as noted within the metadata of any new recordings.
+ */
+void GkSigmfRecorder::setHardware(const QString &hardware)
+{
+    m_hardware = hardware;
+    return;
+}
+
+bool GkSigmfRecorder::isRecording() const
+{
+    return m_session != nullptr;
+}
+
+/**
+ * @brief GkSigmfRecorder::getStats
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return How much of the current recording has been written towards disk so far.
+ */
+GkSigmfRecordStats GkSigmfRecorder::getStats() const
+{
+    GkSigmfRecordStats stats;
+    if (m_session) {
+        stats.samples = m_session->samples;
+        stats.bytes = m_session->bytes;
+        stats.dropped = m_session->dropped;
+    }
+
+    return stats;
+}
+
+/**
+ * @brief GkSigmfRecorder::dataPath
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param file_path Any file of a SigMF recording, or the path they share bar the extension.
+ * @return The path towards the samples of the recording.
+ */
+QString GkSigmfRecorder::dataPath(const QFileInfo &file_path)
+{
+    QString base = file_path.absoluteFilePath();
+    if (base.endsWith(Filesystem::sigmfDataExtension) || base.endsWith(Filesystem::sigmfMetaExtension)) {
+        base.chop(static_cast<qint32>(std::strlen(Filesystem::sigmfDataExtension)));
+    }
+
+    return base + Filesystem::sigmfDataExtension;
+}
+
+/**
+ * @brief GkSigmfRecorder::metaPath
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param file_path Any file of a SigMF recording, or the path they share bar the extension.
+ * @return The path towards the metadata of the recording.
+ */
+QString GkSigmfRecorder::metaPath(const QFileInfo &file_path)
+{
+    QString base = dataPath(file_path);
+    base.chop(static_cast<qint32>(std::strlen(Filesystem::sigmfDataExtension)));
+
+    return base + Filesystem::sigmfMetaExtension;
+}
+
+/**
+ * @brief GkSigmfRecorder::readMeta reads in the metadata of a SigMF recording.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param file_path Any file of a SigMF recording, or the path they share bar the extension.
+ * @return The metadata, of which only the datatype and sample rate are required to be present.
+ */
+GkSigmfMeta GkSigmfRecorder::readMeta(const QFileInfo &file_path)
+{
+    try {
+        const QString meta_path = metaPath(file_path);
+        QFile meta_file(meta_path);
+        if (!meta_file.open(QIODevice::ReadOnly)) {
+            throw std::runtime_error(tr("Unable to open SigMF metadata, \"%1\": %2").arg(meta_path, meta_file.errorString()).toStdString());
+        }
+
+        QJsonParseError parse_error;
+        const QJsonDocument doc = QJsonDocument::fromJson(meta_file.readAll(), &parse_error);
+        if (doc.isNull() || !doc.isObject()) {
+            throw std::invalid_argument(tr("Unable to parse SigMF metadata, \"%1\": %2").arg(meta_path, parse_error.errorString()).toStdString());
+        }
+
+        const QJsonObject global = doc.object().value("global").toObject();
+        GkSigmfMeta meta;
+        meta.datatype = global.value("core:datatype").toString();
+        meta.format = datatypeToFormat(meta.datatype);
+        meta.sample_rate = global.value("core:sample_rate").toDouble(0.0);
+        meta.description = global.value("core:description").toString();
+        meta.hardware = global.value("core:hw").toString();
+        meta.recorder = global.value("core:recorder").toString();
+        if (meta.sample_rate <= 0.0) {
+            throw std::invalid_argument(tr("The SigMF metadata, \"%1\", gives no sample rate!").arg(meta_path).toStdString());
+        }
+
+        for (const auto &entry: doc.object().value("captures").toArray()) {
+            const QJsonObject obj = entry.toObject();
+            GkSigmfCapture capture;
+            capture.sample_start = static_cast<quint64>(obj.value("core:sample_start").toDouble(0.0));
+            capture.frequency = obj.value("core:frequency").toDouble(0.0);
+            capture.datetime = obj.value("core:datetime").toString();
+            meta.captures.push_back(capture);
+        }
+
+        for (const auto &entry: doc.object().value("annotations").toArray()) {
+            const QJsonObject obj = entry.toObject();
+            GkSigmfAnnotation annotation;
+            annotation.sample_start = static_cast<quint64>(obj.value("core:sample_start").toDouble(0.0));
+            annotation.sample_count = static_cast<quint64>(obj.value("core:sample_count").toDouble(0.0));
+            annotation.comment = obj.value("core:comment").toString();
+            meta.annotations.push_back(annotation);
+        }
+
+        return meta;
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return GkSigmfMeta();
+}
+
+/**
+ * @brief GkSigmfRecorder::writeMeta writes out the metadata of a SigMF recording.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param meta_path Where the metadata is to be written.
+ * @param meta The metadata itself.
+ */
+void GkSigmfRecorder::writeMeta(const QString &meta_path, const GkSigmfMeta &meta)
+{
+    try {
+        QJsonObject global;
+        global.insert("core:datatype", meta.datatype);
+        global.insert("core:sample_rate", meta.sample_rate);
+        global.insert("core:version", "1.0.0");
+        if (!meta.description.isEmpty()) {
+            global.insert("core:description", meta.description);
+        }
+
+        if (!meta.hardware.isEmpty()) {
+            global.insert("core:hw", meta.hardware);
+        }
+
+        if (!meta.recorder.isEmpty()) {
+            global.insert("core:recorder", meta.recorder);
+        }
+
+        QJsonArray captures;
+        for (const auto &capture: meta.captures) {
+            QJsonObject obj;
+            obj.insert("core:sample_start", static_cast<qint64>(capture.sample_start));
+            obj.insert("core:frequency", capture.frequency);
+            if (!capture.datetime.isEmpty()) {
+                obj.insert("core:datetime", capture.datetime);
+            }
+
+            captures.append(obj);
+        }
+
+        QJsonArray annotations;
+        for (const auto &annotation: meta.annotations) {
+            QJsonObject obj;
+            obj.insert("core:sample_start", static_cast<qint64>(annotation.sample_start));
+            obj.insert("core:sample_count", static_cast<qint64>(annotation.sample_count));
+            obj.insert("core:comment", annotation.comment);
+            annotations.append(obj);
+        }
+
+        QJsonObject root;
+        root.insert("global", global);
+        root.insert("captures", captures);
+        root.insert("annotations", annotations);
+
+        QFile meta_file(meta_path);
+        if (!meta_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            throw std::runtime_error(tr("Unable to write SigMF metadata, \"%1\": %2").arg(meta_path, meta_file.errorString()).toStdString());
+        }
+
+        meta_file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+        meta_file.close();
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSigmfRecorder::formatToDatatype
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param format The format of the samples.
+ * @return The SigMF datatype of the given format.
+ */
+QString GkSigmfRecorder::formatToDatatype(const GkIqFormat &format)
+{
+    switch (format) {
+        case IqCf32:
+            return "cf32_le";
+        case IqCs16:
+            return "ci16_le";
+        case IqCu8:
+            return "cu8";
+        default:
+            break;
+    }
+
+    return "cf32_le";
+}
+
+/**
+ * @brief GkSigmfRecorder::datatypeToFormat
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param datatype The SigMF datatype.
+ * @return The format of the samples, should it be one that can be replayed.
+ */
+GkIqFormat GkSigmfRecorder::datatypeToFormat(const QString &datatype)
+{
+    if (datatype == "cf32_le") {
+        return IqCf32;
+    } else if (datatype == "ci16_le") {
+        return IqCs16;
+    } else if (datatype == "cu8") {
+        return IqCu8;
+    }
+
+    throw std::invalid_argument(tr("SigMF recordings of type, \"%1\", are not supported!").arg(datatype).toStdString());
+}
+
+/**
+ * @brief GkSigmfRecorder::start begins taking blocks from the stream, which should have just been started itself, and
+ * begins any recording that was asked for beforehand.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sample_rate The sample rate of the stream.
+ */
+void GkSigmfRecorder::start(const double &sample_rate)
+{
+    try {
+        const bool pending = m_pending;
+        stop();
+
+        m_sampleRate = sample_rate;
+        m_running = true;
+        consumerThread = std::thread(&GkSigmfRecorder::run, this);
+
+        if (pending) {
+            startRecording(m_pendingPath, m_pendingFormat, m_pendingDescription);
+        }
+    } catch (const std::exception &e) {
+        gkEventLogger->publishEvent(tr("Unable to begin recording IQ: %1").arg(QString::fromStdString(e.what())), GkSeverity::Error,
+                                    "", false, true, false, true, false);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSigmfRecorder::stop finishes off any recording and stops taking blocks from the stream, which must be done
+ * before the stream itself is stopped.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkSigmfRecorder::stop()
+{
+    m_running = false;
+    if (consumerThread.joinable()) {
+        consumerThread.join();
+    }
+
+    stopRecording();
+    return;
+}
+
+/**
+ * @brief GkSigmfRecorder::setCenterFrequency begins a new capture segment within the recording, if there is one, as the
+ * SDR device has been tuned elsewhere.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param freq_hz The frequency the SDR device is now tuned towards, in hertz.
+ */
+void GkSigmfRecorder::setCenterFrequency(const double &freq_hz)
+{
+    m_centerFreq = freq_hz;
+    m_freqChanged = true;
+
+    return;
+}
+
+/**
+ * @brief GkSigmfRecorder::run takes blocks from the stream for as long as it runs, whether recording or not, so that the
+ * stream's pool is never starved.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkSigmfRecorder::run()
+{
+    while (m_running) {
+        GkIqBlock *block = gkSdrStream->popBlock(m_sink);
+        if (!block) {
+            std::this_thread::sleep_for(std::chrono::microseconds(GK_SDR_STREAM_CONSUMER_IDLE_MICROSECS));
+            continue;
+        }
+
+        m_inUse.store(true);
+        GkSigmfSession *session = m_active.load();
+        if (session) {
+            record(session, block);
+        }
+
+        m_inUse.store(false);
+        gkSdrStream->releaseBlock(block);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSigmfRecorder::record packs a block of samples into the write-behind buffers, converting them along the way if
+ * need be. Samples are dropped, and noted as such, only should every buffer be waiting upon the disk.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param session The recording in question.
+ * @param block The block of samples.
+ */
+void GkSigmfRecorder::record(GkSigmfSession *session, const GkIqBlock *block)
+{
+    if (m_freqChanged.exchange(false) && session->meta.captures.size() < GK_SIGMF_MAX_ANNOTATIONS) {
+        GkSigmfCapture capture;
+        capture.sample_start = session->position;
+        capture.frequency = m_centerFreq;
+        capture.datetime = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+        session->meta.captures.push_back(capture);
+    }
+
+    if (block->overflow) {
+        addEvent(session, 0, tr("The SDR device overflowed, so samples were lost beforehand."));
+    }
+
+    if (session->sequenced && block->sequence != (session->lastSequence + 1)) {
+        addEvent(session, 0, tr("%1 blocks were dropped by the stream beforehand.").arg(QString::number(block->sequence - session->lastSequence - 1)));
+    }
+
+    session->lastSequence = block->sequence;
+    session->sequenced = true;
+
+    const std::complex<float> *src = block->samples.data();
+    size_t remaining = block->count;
+    while (remaining > 0) {
+        if (!session->current) {
+            if (!session->freeBuffers.pop(session->current)) {
+                session->dropped += remaining;
+                addEvent(session, remaining, tr("Samples were dropped here, as the disk could not keep up."));
+                return;
+            }
+
+            session->current->used = 0;
+        }
+
+        GkSigmfBuffer *buffer = session->current;
+        const size_t count = std::min(remaining, (GK_SIGMF_WRITE_BUFFER_BYTES - buffer->used) / session->bytesPerSample);
+        char *dst = buffer->data.get() + buffer->used;
+        if (session->meta.format == IqCs16) {
+            for (size_t i = 0; i < count; ++i) {
+                const qint16 iq[2] = {
+                    static_cast<qint16>(std::lround(std::clamp(src[i].real(), -1.0f, 1.0f) * 32767.0f)),
+                    static_cast<qint16>(std::lround(std::clamp(src[i].imag(), -1.0f, 1.0f) * 32767.0f))
+                };
+
+                std::memcpy(dst + (i * sizeof(iq)), iq, sizeof(iq));
+            }
+        } else {
+            std::memcpy(dst, src, count * sizeof(std::complex<float>));
+        }
+
+        buffer->used += count * session->bytesPerSample;
+        session->position += count;
+        src += count;
+        remaining -= count;
+
+        if ((buffer->used + session->bytesPerSample) > GK_SIGMF_WRITE_BUFFER_BYTES) {
+            session->filledBuffers.push(buffer);
+            session->current = nullptr;
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSigmfRecorder::writeBuffers is the write-behind thread of a recording, which writes out each buffer as it
+ * fills and then hands it back to be filled once more.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param session The recording in question.
+ */
+void GkSigmfRecorder::writeBuffers(GkSigmfSession *session)
+{
+    while (true) {
+        GkSigmfBuffer *buffer = nullptr;
+        if (!session->filledBuffers.pop(buffer)) {
+            if (session->finishing) {
+                break;
+            }
+
+            std::this_thread::sleep_for(std::chrono::microseconds(GK_SIGMF_WRITER_IDLE_MICROSECS));
+            continue;
+        }
+
+        if (!session->failed) {
+            const qint64 written = session->file.write(buffer->data.get(), static_cast<qint64>(buffer->used));
+            if (written != static_cast<qint64>(buffer->used)) {
+                session->failed = true;
+                emit recordingError(tr("Unable to write towards IQ recording, \"%1\": %2").arg(session->dataPath, session->file.errorString()));
+            } else {
+                session->bytes += buffer->used;
+                session->samples += buffer->used / session->bytesPerSample;
+            }
+        }
+
+        buffer->used = 0;
+        session->freeBuffers.push(buffer);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSigmfRecorder::addEvent notes an overflow or a loss of samples, to be written out as an annotation once the
+ * recording is finished. Losses at the same point within the recording are merged together.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param session The recording in question.
+ * @param lost How many samples were lost, if known.
+ * @param comment The nature of the event.
+ */
+void GkSigmfRecorder::addEvent(GkSigmfSession *session, const quint64 &lost, const QString &comment)
+{
+    if (!session->events.empty() && session->events.back().sample_start == session->position && lost > 0 &&
+        session->events.back().sample_count > 0) {
+        session->events.back().sample_count += lost;
+        return;
+    }
+
+    if (session->events.size() >= GK_SIGMF_MAX_ANNOTATIONS) {
+        return;
+    }
+
+    GkSigmfAnnotation annotation;
+    annotation.sample_start = session->position;
+    annotation.sample_count = lost;
+    annotation.comment = comment;
+    session->events.push_back(annotation);
+
+    return;
+}
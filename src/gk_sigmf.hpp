@@ -0,0 +1,190 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include "src/gk_logger.hpp"
+#include "src/gk_sdr_stream.hpp"
+#include "src/gk_lockfree_queue.hpp"
+#include <new>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <complex>
+#include <QFile>
+#include <QObject>
+#include <QString>
+#include <QPointer>
+#include <QFileInfo>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkSigmfIqSource replays a SigMF recording, whose sample format and rate are taken from its metadata rather than
+ * having to be given by hand. The samples themselves are memory-mapped, just as with any other raw IQ recording.
+ * @see https://github.com/sigmf/SigMF/blob/main/sigmf-spec.md
+ */
+class GkSigmfIqSource : public GkFileIqSource {
+
+public:
+    explicit GkSigmfIqSource(const QFileInfo &file_path, const bool &loop = false, const bool &real_time = true);
+    ~GkSigmfIqSource() override = default;
+
+    [[nodiscard]] QString getName() const override;
+    [[nodiscard]] const GekkoFyre::System::GkSdr::GkSigmfMeta &getMeta() const;
+
+private:
+    GekkoFyre::System::GkSdr::GkSigmfMeta m_meta;
+
+    explicit GkSigmfIqSource(const QFileInfo &file_path, const GekkoFyre::System::GkSdr::GkSigmfMeta &meta, const bool &loop,
+                             const bool &real_time);
+
+};
+
+/**
+ * @brief GkSigmfRecorder records the raw IQ of an SDR stream towards disk, as a SigMF recording. Blocks are taken from the
+ * stream and packed into large, page-aligned buffers upon one thread, whilst the buffers are written out by another, so
+ * that a slow disk can never hold up the stream itself.
+ */
+class GkSigmfRecorder : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GkSigmfRecorder(QPointer<GekkoFyre::GkSdrStream> sdrStream, QPointer<GekkoFyre::GkEventLogger> eventLogger,
+                             QObject *parent = nullptr);
+    ~GkSigmfRecorder() override;
+
+    void startRecording(const QFileInfo &file_path, const GekkoFyre::System::GkSdr::GkIqFormat &format = GekkoFyre::System::GkSdr::IqCf32,
+                        const QString &description = "");
+    void stopRecording();
+    void setHardware(const QString &hardware);
+
+    [[nodiscard]] bool isRecording() const;
+    [[nodiscard]] GekkoFyre::System::GkSdr::GkSigmfRecordStats getStats() const;
+
+    [[nodiscard]] static QString dataPath(const QFileInfo &file_path);
+    [[nodiscard]] static QString metaPath(const QFileInfo &file_path);
+    [[nodiscard]] static GekkoFyre::System::GkSdr::GkSigmfMeta readMeta(const QFileInfo &file_path);
+    static void writeMeta(const QString &meta_path, const GekkoFyre::System::GkSdr::GkSigmfMeta &meta);
+    [[nodiscard]] static QString formatToDatatype(const GekkoFyre::System::GkSdr::GkIqFormat &format);
+    [[nodiscard]] static GekkoFyre::System::GkSdr::GkIqFormat datatypeToFormat(const QString &datatype);
+
+public slots:
+    void start(const double &sample_rate);
+    void stop();
+    void setCenterFrequency(const double &freq_hz);
+
+signals:
+    void recordingStarted(const QString &data_path);
+    void recordingFinished(const QString &data_path, const quint64 &samples);
+    void recordingError(const QString &error_msg);
+
+private:
+    struct GkAlignedDeleter {
+        void operator()(char *ptr) const { ::operator delete[](ptr, std::align_val_t(GK_SIGMF_WRITE_ALIGN)); }
+    };
+
+    struct GkSigmfBuffer {
+        std::unique_ptr<char[], GkAlignedDeleter> data;
+        size_t used = 0;
+    };
+
+    struct GkSigmfSession {
+        explicit GkSigmfSession() : freeBuffers(GK_SIGMF_WRITE_BUFFERS), filledBuffers(GK_SIGMF_WRITE_BUFFERS) {}
+
+        QFile file;
+        QString dataPath;
+        QString metaPath;
+        GekkoFyre::System::GkSdr::GkSigmfMeta meta;
+        size_t bytesPerSample = 0;
+
+        std::vector<std::unique_ptr<GkSigmfBuffer>> pool;
+        GkLockFreeQueue<GkSigmfBuffer *> freeBuffers;
+        GkLockFreeQueue<GkSigmfBuffer *> filledBuffers;
+        GkSigmfBuffer *current = nullptr;                                       // Only ever touched by the stream's consumer thread.
+
+        //
+        // Only ever touched by the stream's consumer thread, until the recording is stopped
+        quint64 position = 0;                                                   // The next sample to be written, within the recording.
+        quint64 lastSequence = 0;
+        bool sequenced = false;
+        std::vector<GekkoFyre::System::GkSdr::GkSigmfAnnotation> events;        // Overflows and dropped samples, with `sample_count` being how many were lost.
+
+        std::thread writerThread;
+        std::atomic<bool> finishing{false};
+        std::atomic<bool> failed{false};
+        std::atomic<quint64> samples{0};
+        std::atomic<quint64> bytes{0};
+        std::atomic<quint64> dropped{0};
+    };
+
+    QPointer<GekkoFyre::GkSdrStream> gkSdrStream;
+    QPointer<GekkoFyre::GkEventLogger> gkEventLogger;
+    qint32 m_sink;
+
+    std::unique_ptr<GkSigmfSession> m_session;                                  // Owned by the thread that starts and stops recordings.
+    std::atomic<GkSigmfSession *> m_active;                                     // What the consumer thread records into, if anything.
+    std::atomic<bool> m_inUse;                                                  // Whether the consumer thread is in the midst of using `m_active`.
+
+    std::atomic<double> m_sampleRate;
+    std::atomic<double> m_centerFreq;
+    std::atomic<bool> m_freqChanged;
+    QString m_hardware;
+
+    //
+    // A recording that was asked for before the stream had started, and which begins along with it
+    bool m_pending;
+    QFileInfo m_pendingPath;
+    GekkoFyre::System::GkSdr::GkIqFormat m_pendingFormat;
+    QString m_pendingDescription;
+
+    std::thread consumerThread;
+    std::atomic<bool> m_running;
+
+    void run();
+    void record(GkSigmfSession *session, const GekkoFyre::GkIqBlock *block);
+    void writeBuffers(GkSigmfSession *session);
+    void addEvent(GkSigmfSession *session, const quint64 &lost, const QString &comment);
+
+};
+};
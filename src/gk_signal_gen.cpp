@@ -0,0 +1,641 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/gk_signal_gen.hpp"
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+using namespace GekkoFyre;
+using namespace GkAudioFramework;
+
+/**
+ * @brief GkNco::GkNco
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+GkNco::GkNco() : m_phase(0), m_phaseInc(0)
+{
+    return;
+}
+
+/**
+ * @brief GkNco::setFrequency sets the frequency of the oscillator, without disturbing its phase.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param freq_hz The frequency, measured in hertz, which must be below the Nyquist frequency.
+ * @param sample_rate The sample rate, measured in hertz.
+ */
+void GkNco::setFrequency(const double &freq_hz, const double &sample_rate)
+{
+    const double cycles = std::fmod(freq_hz / sample_rate, 1.0);
+    m_phaseInc = static_cast<quint32>(std::llround((cycles < 0.0 ? cycles + 1.0 : cycles) * 4294967296.0));
+
+    return;
+}
+
+/**
+ * @brief GkNco::setPhaseIncrement sets the frequency of the oscillator directly, as a fraction of the sample rate
+ * multiplied by 2^32.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param phase_inc The amount to advance the phase accumulator by, per sample.
+ */
+void GkNco::setPhaseIncrement(const quint32 &phase_inc)
+{
+    m_phaseInc = phase_inc;
+
+    return;
+}
+
+/**
+ * @brief GkNco::setPhase
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param radians The new phase of the oscillator.
+ */
+void GkNco::setPhase(const double &radians)
+{
+    const double cycles = std::fmod(radians / (2.0 * M_PI), 1.0);
+    m_phase = static_cast<quint32>(std::llround((cycles < 0.0 ? cycles + 1.0 : cycles) * 4294967296.0));
+
+    return;
+}
+
+/**
+ * @brief GkNco::getPhaseIncrement
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The amount that the phase accumulator advances by, per sample.
+ */
+quint32 GkNco::getPhaseIncrement() const
+{
+    return m_phaseInc;
+}
+
+/**
+ * @brief GkNco::fill overwrites the given buffer with the next samples from the oscillator.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param out The buffer to be written towards, which must hold at least `frames` samples.
+ * @param frames The number of samples to be written.
+ * @param amplitude The peak amplitude.
+ */
+void GkNco::fill(float *out, const size_t &frames, const float &amplitude)
+{
+    quint32 phase = m_phase;
+    for (size_t i = 0; i < frames; ++i) {
+        out[i] = lookup(phase) * amplitude;
+        phase += m_phaseInc;
+    }
+
+    m_phase = phase;
+    return;
+}
+
+/**
+ * @brief GkNco::accumulate adds the next samples from the oscillator towards what is already within the given buffer.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param out The buffer to be added towards, which must hold at least `frames` samples.
+ * @param frames The number of samples to be added.
+ * @param amplitude The peak amplitude.
+ */
+void GkNco::accumulate(float *out, const size_t &frames, const float &amplitude)
+{
+    quint32 phase = m_phase;
+    for (size_t i = 0; i < frames; ++i) {
+        out[i] += lookup(phase) * amplitude;
+        phase += m_phaseInc;
+    }
+
+    m_phase = phase;
+    return;
+}
+
+/**
+ * @brief GkNco::mix shifts the given complex samples in frequency by that of the oscillator, such as for tuning within a
+ * stream of IQ samples. A negative frequency shifts downwards.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param samples The samples to be shifted, in-place.
+ * @param frames The number of samples to be shifted.
+ */
+void GkNco::mix(std::complex<float> *samples, const size_t &frames)
+{
+    quint32 phase = m_phase;
+    for (size_t i = 0; i < frames; ++i) {
+        const float lo_cos = lookup(phase + 0x40000000U);
+        const float lo_sin = lookup(phase);
+        const float re = samples[i].real();
+        const float im = samples[i].imag();
+        samples[i] = { (re * lo_cos) - (im * lo_sin), (re * lo_sin) + (im * lo_cos) };
+        phase += m_phaseInc;
+    }
+
+    m_phase = phase;
+    return;
+}
+
+/**
+ * @brief GkNco::sineTable is shared between all of the oscillators, and is only ever calculated the once. It holds one
+ * extra entry at the end, so that interpolating from the very last entry needs no wrapping around.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The sine lookup table.
+ */
+const std::array<float, (1 << GK_SIGNAL_GEN_TABLE_BITS) + 1> &GkNco::sineTable()
+{
+    static const auto table = []() {
+        std::array<float, (1 << GK_SIGNAL_GEN_TABLE_BITS) + 1> sine;
+        for (size_t i = 0; i < sine.size(); ++i) {
+            sine[i] = static_cast<float>(std::sin((2.0 * M_PI * static_cast<double>(i)) / (1 << GK_SIGNAL_GEN_TABLE_BITS)));
+        }
+
+        return sine;
+    }();
+
+    return table;
+}
+
+/**
+ * @brief GkQuadOscillator::GkQuadOscillator
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+GkQuadOscillator::GkQuadOscillator()
+{
+    m_re.fill(1.0);
+    m_im.fill(0.0);
+    m_stepCos.fill(1.0);
+    m_stepSin.fill(0.0);
+
+    return;
+}
+
+/**
+ * @brief GkQuadOscillator::setFrequency sets the frequency along with the starting phase of the oscillator. This is the
+ * only place where std::sin() and std::cos() are called.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param freq_hz The frequency, measured in hertz.
+ * @param sample_rate The sample rate, measured in hertz.
+ * @param phase The starting phase, in radians.
+ */
+void GkQuadOscillator::setFrequency(const double &freq_hz, const double &sample_rate, const double &phase)
+{
+    const double omega = (2.0 * M_PI * freq_hz) / sample_rate;
+    for (size_t i = 0; i < m_stepCos.size(); ++i) {
+        m_stepCos[i] = std::cos(omega * i);
+        m_stepSin[i] = std::sin(omega * i);
+    }
+
+    for (size_t i = 0; i < GK_SIGNAL_GEN_SIMD_LANES; ++i) {
+        m_re[i] = std::cos(phase + (omega * i));
+        m_im[i] = std::sin(phase + (omega * i));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkQuadOscillator::fill overwrites the given buffer with the next samples from the oscillator.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param out The buffer to be written towards, which must hold at least `frames` samples.
+ * @param frames The number of samples to be written.
+ * @param amplitude The peak amplitude.
+ */
+void GkQuadOscillator::fill(float *out, const size_t &frames, const float &amplitude)
+{
+    const double step_cos = m_stepCos[GK_SIGNAL_GEN_SIMD_LANES];
+    const double step_sin = m_stepSin[GK_SIGNAL_GEN_SIMD_LANES];
+
+    size_t i = 0;
+    for (; (i + GK_SIGNAL_GEN_SIMD_LANES) <= frames; i += GK_SIGNAL_GEN_SIMD_LANES) {
+        for (size_t j = 0; j < GK_SIGNAL_GEN_SIMD_LANES; ++j) {
+            out[i + j] = static_cast<float>(m_im[j]) * amplitude;
+        }
+
+        for (size_t j = 0; j < GK_SIGNAL_GEN_SIMD_LANES; ++j) {
+            const double re = (m_re[j] * step_cos) - (m_im[j] * step_sin);
+            const double im = (m_re[j] * step_sin) + (m_im[j] * step_cos);
+            m_re[j] = re;
+            m_im[j] = im;
+        }
+    }
+
+    const size_t remaining = frames - i;
+    if (remaining > 0) {
+        for (size_t j = 0; j < remaining; ++j) {
+            out[i + j] = static_cast<float>(m_im[j]) * amplitude;
+        }
+
+        rotate(remaining);
+    }
+
+    renormalize();
+    return;
+}
+
+/**
+ * @brief GkQuadOscillator::rotate advances every lane by less than a whole block of samples.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param steps The number of samples to advance by.
+ */
+void GkQuadOscillator::rotate(const size_t &steps)
+{
+    const double step_cos = m_stepCos[steps];
+    const double step_sin = m_stepSin[steps];
+    for (size_t j = 0; j < GK_SIGNAL_GEN_SIMD_LANES; ++j) {
+        const double re = (m_re[j] * step_cos) - (m_im[j] * step_sin);
+        const double im = (m_re[j] * step_sin) + (m_im[j] * step_cos);
+        m_re[j] = re;
+        m_im[j] = im;
+    }
+
+    return;
+}
+
+/**
+ * @brief GkQuadOscillator::renormalize pulls each lane back onto the unit circle.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkQuadOscillator::renormalize()
+{
+    for (size_t j = 0; j < GK_SIGNAL_GEN_SIMD_LANES; ++j) {
+        const double mag = std::sqrt((m_re[j] * m_re[j]) + (m_im[j] * m_im[j]));
+        if (mag > 0.0) {
+            m_re[j] /= mag;
+            m_im[j] /= mag;
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSignalGenerator::GkSignalGenerator creates test-tones, noise and sweeps of a known nature, for the calibration
+ * of audio devices and for the testing of decoders. All buffers are provided by the caller, and nothing is allocated
+ * beyond GkSignalGenerator::configure(), so it is safe to use from within real-time threads.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param parent The parent object to this class.
+ */
+GkSignalGenerator::GkSignalGenerator(QObject *parent) : QObject(parent), m_sampleRate(0), m_sweepInc(0.0),
+                                                        m_sweepIncStart(0.0), m_sweepIncStep(0.0), m_sweepIncMult(1.0),
+                                                        m_sweepPos(0), m_sweepLength(0), m_rngState(0)
+{
+    m_pinkState.fill(0.0f);
+
+    return;
+}
+
+GkSignalGenerator::~GkSignalGenerator()
+{
+    return;
+}
+
+/**
+ * @brief GkSignalGenerator::configure sets up the oscillators, and other such, for the given signal.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param config The signal to be generated.
+ * @param sample_rate The sample rate to generate at, measured in hertz.
+ */
+void GkSignalGenerator::configure(const GkSignalGenConfig &config, const quint32 &sample_rate)
+{
+    try {
+        if (sample_rate == 0) {
+            throw std::invalid_argument(tr("Unable to generate a signal at a sample rate of zero!").toStdString());
+        }
+
+        const double nyquist = sample_rate / 2.0;
+        const auto check_freq = [&](const double &freq_hz) {
+            if (freq_hz < 0.0 || freq_hz >= nyquist) {
+                throw std::invalid_argument(tr("Frequency of %1 Hz is out of range for a sample rate of %2 Hz!")
+                                                    .arg(QString::number(freq_hz), QString::number(sample_rate)).toStdString());
+            }
+        };
+
+        m_config = config;
+        m_sampleRate = sample_rate;
+        m_ncos.clear();
+        m_ncoGains.clear();
+
+        switch (m_config.mode) {
+            case SigGenSingleTone:
+            {
+                const double freq_hz = m_config.tones.empty() ? GK_AUDIO_SINEWAVE_TEST_FREQ_HZ : m_config.tones.front().frequency;
+                check_freq(freq_hz);
+                m_quadOsc.setFrequency(freq_hz, sample_rate);
+                break;
+            }
+            case SigGenTwoToneImd:
+            {
+                //
+                // Two equal tones, each at half of the peak amplitude, so that the PEP is full-scale!
+                std::vector<GkSignalTone> tones = { { GK_SIGNAL_GEN_IMD_DEFAULT_F1_HZ, 1.0f }, { GK_SIGNAL_GEN_IMD_DEFAULT_F2_HZ, 1.0f } };
+                for (size_t i = 0; i < std::min(m_config.tones.size(), tones.size()); ++i) {
+                    tones[i].frequency = m_config.tones[i].frequency;
+                }
+
+                m_config.tones = tones;
+                [[fallthrough]];
+            }
+            case SigGenMultiTone:
+            {
+                if (m_config.tones.empty()) {
+                    throw std::invalid_argument(tr("At least one tone must be given for a multi-tone signal!").toStdString());
+                }
+
+                float total = 0.0f;
+                for (const auto &tone: m_config.tones) {
+                    check_freq(tone.frequency);
+                    total += std::fabs(tone.amplitude);
+                }
+
+                m_ncos.resize(m_config.tones.size());
+                m_ncoGains.resize(m_config.tones.size());
+                for (size_t i = 0; i < m_config.tones.size(); ++i) {
+                    m_ncos[i].setFrequency(m_config.tones[i].frequency, sample_rate);
+                    m_ncoGains[i] = (total > 0.0f) ? (m_config.tones[i].amplitude / total) : 0.0f;
+                }
+
+                break;
+            }
+            case SigGenLinearSweep:
+            case SigGenLogSweep:
+            {
+                check_freq(m_config.sweep_start_hz);
+                check_freq(m_config.sweep_stop_hz);
+                if (m_config.mode == SigGenLogSweep && (m_config.sweep_start_hz <= 0.0 || m_config.sweep_stop_hz <= 0.0)) {
+                    throw std::invalid_argument(tr("A logarithmic sweep cannot start nor stop at 0 Hz!").toStdString());
+                }
+
+                m_sweepLength = std::max<quint64>((static_cast<quint64>(m_config.sweep_duration_ms) * sample_rate) / 1000, 2);
+                m_sweepIncStart = (m_config.sweep_start_hz / sample_rate) * 4294967296.0;
+                const double inc_stop = (m_config.sweep_stop_hz / sample_rate) * 4294967296.0;
+                m_sweepIncStep = (inc_stop - m_sweepIncStart) / static_cast<double>(m_sweepLength - 1);
+                m_sweepIncMult = (m_config.mode == SigGenLogSweep) ? std::pow(inc_stop / m_sweepIncStart, 1.0 / static_cast<double>(m_sweepLength - 1)) : 1.0;
+                break;
+            }
+            case SigGenWhiteNoise:
+            case SigGenPinkNoise:
+                break;
+            default:
+                throw std::invalid_argument(tr("An invalid signal has been requested of the signal generator!").toStdString());
+        }
+
+        reset();
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSignalGenerator::reset starts the configured signal over again from the very beginning.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkSignalGenerator::reset()
+{
+    if (m_config.mode == SigGenSingleTone && m_sampleRate > 0) {
+        m_quadOsc.setFrequency(m_config.tones.empty() ? GK_AUDIO_SINEWAVE_TEST_FREQ_HZ : m_config.tones.front().frequency, m_sampleRate);
+    }
+
+    for (size_t i = 0; i < m_ncos.size(); ++i) {
+        m_ncos[i].setPhase(0.0);
+    }
+
+    m_sweepNco.setPhase(0.0);
+    m_sweepInc = m_sweepIncStart;
+    m_sweepPos = 0;
+
+    m_rngState = m_config.noise_seed ? m_config.noise_seed : 1;
+    m_pinkState.fill(0.0f);
+
+    return;
+}
+
+/**
+ * @brief GkSignalGenerator::generate writes the next samples of the configured signal towards the given buffer.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param out The buffer to be written towards, which must hold at least `frames` samples.
+ * @param frames The number of samples to be written.
+ */
+void GkSignalGenerator::generate(float *out, const size_t &frames)
+{
+    switch (m_config.mode) {
+        case SigGenSingleTone:
+            m_quadOsc.fill(out, frames, m_config.amplitude);
+            break;
+        case SigGenMultiTone:
+        case SigGenTwoToneImd:
+            std::fill(out, out + frames, 0.0f);
+            for (size_t i = 0; i < m_ncos.size(); ++i) {
+                m_ncos[i].accumulate(out, frames, m_ncoGains[i] * m_config.amplitude);
+            }
+
+            break;
+        case SigGenWhiteNoise:
+            fillNoise(out, frames, false);
+            break;
+        case SigGenPinkNoise:
+            fillNoise(out, frames, true);
+            break;
+        case SigGenLinearSweep:
+        case SigGenLogSweep:
+            fillSweep(out, frames);
+            break;
+        default:
+            std::fill(out, out + frames, 0.0f);
+            break;
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSignalGenerator::generateInterleaved writes the next samples of the configured signal towards each channel of
+ * the given, interleaved buffer.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param out The buffer to be written towards, which must hold at least `frames * channels` samples.
+ * @param frames The number of frames to be written.
+ * @param channels The number of interleaved channels.
+ * @param antiphase Whether every second channel should be inverted.
+ */
+void GkSignalGenerator::generateInterleaved(float *out, const size_t &frames, const quint16 &channels, const bool &antiphase)
+{
+    generate(out, frames);
+    if (channels < 2) {
+        return;
+    }
+
+    //
+    // Spread the samples out from the back of the buffer towards the front, so that nothing is overwritten before it has
+    // been read!
+    //
+    for (size_t i = frames; i-- > 0;) {
+        const float sample = out[i];
+        for (quint16 j = 0; j < channels; ++j) {
+            out[(i * channels) + j] = (antiphase && (j % 2)) ? -sample : sample;
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSignalGenerator::createClip generates the configured signal as a clip, ready for playback via the audio mixer.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param duration_ms The length of the clip, measured in milliseconds.
+ * @param channels The number of channels within the clip.
+ * @param antiphase Whether every second channel should be inverted.
+ * @return The generated clip.
+ * @see GkAudioMixer::playClip().
+ */
+std::shared_ptr<GkAudioClip> GkSignalGenerator::createClip(const quint32 &duration_ms, const quint16 &channels,
+                                                           const bool &antiphase)
+{
+    auto clip = std::make_shared<GkAudioClip>();
+    clip->channels = std::max<quint16>(channels, 1);
+    clip->sample_rate = m_sampleRate;
+    clip->frames = (static_cast<qint64>(duration_ms) * m_sampleRate) / 1000;
+    clip->samples.resize(static_cast<size_t>(clip->frames) * clip->channels);
+    generateInterleaved(clip->samples.data(), static_cast<size_t>(clip->frames), clip->channels, antiphase);
+
+    return clip;
+}
+
+/**
+ * @brief GkSignalGenerator::toPcm16 converts normalized samples towards signed 16-bit PCM, with clipping.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param in The normalized samples.
+ * @param out The buffer to be written towards, which must hold at least `samples` samples.
+ * @param samples The number of samples to be converted.
+ */
+void GkSignalGenerator::toPcm16(const float *in, qint16 *out, const size_t &samples)
+{
+    for (size_t i = 0; i < samples; ++i) {
+        out[i] = static_cast<qint16>(std::lrint(std::clamp(in[i], -1.0f, 1.0f) * std::numeric_limits<qint16>::max()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSignalGenerator::nextRandom
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The next number from the xorshift64* generator.
+ * @note Sebastiano Vigna <https://arxiv.org/abs/1402.6246>.
+ */
+quint64 GkSignalGenerator::nextRandom()
+{
+    m_rngState ^= m_rngState >> 12;
+    m_rngState ^= m_rngState << 25;
+    m_rngState ^= m_rngState >> 27;
+    return m_rngState * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief GkSignalGenerator::nextWhite
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return A uniformly distributed sample, between -1.0 and 1.0.
+ */
+float GkSignalGenerator::nextWhite()
+{
+    return (static_cast<float>(nextRandom() >> 40) * (2.0f / static_cast<float>(1ULL << 24))) - 1.0f;
+}
+
+/**
+ * @brief GkSignalGenerator::fillNoise generates white or pink noise.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param out The buffer to be written towards, which must hold at least `frames` samples.
+ * @param frames The number of samples to be written.
+ * @param pink Whether to filter the white noise towards pink (i.e. -3 dB per octave) noise.
+ * @note Paul Kellet's refined pink noise filter <https://www.firstpr.com.au/dsp/pink-noise/>.
+ */
+void GkSignalGenerator::fillNoise(float *out, const size_t &frames, const bool &pink)
+{
+    const float amplitude = m_config.amplitude;
+    if (!pink) {
+        for (size_t i = 0; i < frames; ++i) {
+            out[i] = nextWhite() * amplitude;
+        }
+
+        return;
+    }
+
+    auto &b = m_pinkState;
+    for (size_t i = 0; i < frames; ++i) {
+        const float white = nextWhite();
+        b[0] = (0.99886f * b[0]) + (white * 0.0555179f);
+        b[1] = (0.99332f * b[1]) + (white * 0.0750759f);
+        b[2] = (0.96900f * b[2]) + (white * 0.1538520f);
+        b[3] = (0.86650f * b[3]) + (white * 0.3104856f);
+        b[4] = (0.55000f * b[4]) + (white * 0.5329522f);
+        b[5] = (-0.7616f * b[5]) - (white * 0.0168980f);
+        const float sample = b[0] + b[1] + b[2] + b[3] + b[4] + b[5] + b[6] + (white * 0.5362f);
+        b[6] = white * 0.115926f;
+
+        out[i] = std::clamp(sample * 0.11f, -1.0f, 1.0f) * amplitude;
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSignalGenerator::fillSweep generates a linear or logarithmic frequency sweep, which starts over again once it
+ * reaches the stop frequency. The phase remains continuous throughout.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param out The buffer to be written towards, which must hold at least `frames` samples.
+ * @param frames The number of samples to be written.
+ */
+void GkSignalGenerator::fillSweep(float *out, const size_t &frames)
+{
+    const bool log_sweep = (m_config.mode == SigGenLogSweep);
+    for (size_t i = 0; i < frames; ++i) {
+        m_sweepNco.setPhaseIncrement(static_cast<quint32>(std::llround(m_sweepInc)));
+        out[i] = m_sweepNco.next() * m_config.amplitude;
+
+        if (++m_sweepPos >= m_sweepLength) {
+            m_sweepPos = 0;
+            m_sweepInc = m_sweepIncStart;
+        } else if (log_sweep) {
+            m_sweepInc *= m_sweepIncMult;
+        } else {
+            m_sweepInc += m_sweepIncStep;
+        }
+    }
+
+    return;
+}
@@ -0,0 +1,176 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include "src/gk_audio_mixer.hpp"
+#include <array>
+#include <complex>
+#include <memory>
+#include <vector>
+#include <QObject>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkNco is a numerically controlled oscillator, whereby a 32-bit phase accumulator indexes into a shared sine
+ * table with linear interpolation. The frequency resolution is that of the sample rate divided by 2^32, and the
+ * phase never drifts, no matter how long it runs for.
+ */
+class GkNco {
+
+public:
+    GkNco();
+
+    void setFrequency(const double &freq_hz, const double &sample_rate);
+    void setPhaseIncrement(const quint32 &phase_inc);
+    void setPhase(const double &radians);
+    [[nodiscard]] quint32 getPhaseIncrement() const;
+
+    /**
+     * @brief next returns the next sample and advances the phase accordingly.
+     */
+    inline float next()
+    {
+        const float sample = lookup(m_phase);
+        m_phase += m_phaseInc;
+        return sample;
+    }
+
+    void fill(float *out, const size_t &frames, const float &amplitude);
+    void accumulate(float *out, const size_t &frames, const float &amplitude);
+    void mix(std::complex<float> *samples, const size_t &frames);
+
+private:
+    quint32 m_phase;
+    quint32 m_phaseInc;
+
+    static const std::array<float, (1 << GK_SIGNAL_GEN_TABLE_BITS) + 1> &sineTable();
+
+    static inline float lookup(const quint32 &phase)
+    {
+        static constexpr quint32 frac_bits = 32 - GK_SIGNAL_GEN_TABLE_BITS;
+        static constexpr float frac_scale = 1.0f / static_cast<float>(1U << frac_bits);
+        const auto &table = sineTable();
+        const quint32 idx = phase >> frac_bits;
+        const float frac = static_cast<float>(phase & ((1U << frac_bits) - 1)) * frac_scale;
+        return table[idx] + ((table[idx + 1] - table[idx]) * frac);
+    }
+
+};
+
+/**
+ * @brief GkQuadOscillator is a recursive (i.e. complex rotation) oscillator, which needs neither a table nor any calls to
+ * std::sin() once set up. Several lanes are run side-by-side, each a fixed number of samples ahead of the last, so that
+ * the inner loop has no dependencies between lanes and may thusly be vectorized by the compiler. The amplitude is
+ * renormalized after each fill, so as to stop any rounding errors from building up over time.
+ */
+class GkQuadOscillator {
+
+public:
+    GkQuadOscillator();
+
+    void setFrequency(const double &freq_hz, const double &sample_rate, const double &phase = 0.0);
+    void fill(float *out, const size_t &frames, const float &amplitude);
+
+private:
+    std::array<double, GK_SIGNAL_GEN_SIMD_LANES> m_re;
+    std::array<double, GK_SIGNAL_GEN_SIMD_LANES> m_im;
+    std::array<double, GK_SIGNAL_GEN_SIMD_LANES + 1> m_stepCos;                 // Rotation by 0 ... GK_SIGNAL_GEN_SIMD_LANES samples.
+    std::array<double, GK_SIGNAL_GEN_SIMD_LANES + 1> m_stepSin;
+
+    void rotate(const size_t &steps);
+    void renormalize();
+
+};
+
+class GkSignalGenerator : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GkSignalGenerator(QObject *parent = nullptr);
+    ~GkSignalGenerator() override;
+
+    void configure(const GekkoFyre::GkAudioFramework::GkSignalGenConfig &config, const quint32 &sample_rate);
+    void reset();
+
+    void generate(float *out, const size_t &frames);
+    void generateInterleaved(float *out, const size_t &frames, const quint16 &channels, const bool &antiphase = false);
+
+    [[nodiscard]] std::shared_ptr<GekkoFyre::GkAudioClip> createClip(const quint32 &duration_ms, const quint16 &channels,
+                                                                     const bool &antiphase = false);
+
+    static void toPcm16(const float *in, qint16 *out, const size_t &samples);
+
+private:
+    GekkoFyre::GkAudioFramework::GkSignalGenConfig m_config;
+    quint32 m_sampleRate;
+
+    //
+    // Oscillators, which are all allocated beforehand by GkSignalGenerator::configure()
+    GkQuadOscillator m_quadOsc;
+    std::vector<GkNco> m_ncos;
+    std::vector<float> m_ncoGains;
+
+    //
+    // Frequency sweeps
+    GkNco m_sweepNco;
+    double m_sweepInc;
+    double m_sweepIncStart;
+    double m_sweepIncStep;                                                      // Added per sample, for linear sweeps.
+    double m_sweepIncMult;                                                      // Multiplied per sample, for logarithmic sweeps.
+    quint64 m_sweepPos;
+    quint64 m_sweepLength;
+
+    //
+    // Noise
+    quint64 m_rngState;
+    std::array<float, 7> m_pinkState;
+
+    [[nodiscard]] quint64 nextRandom();
+    [[nodiscard]] float nextWhite();
+
+    void fillNoise(float *out, const size_t &frames, const bool &pink);
+    void fillSweep(float *out, const size_t &frames);
+
+};
+};
@@ -41,6 +41,9 @@
 
 #include "src/gk_sinewave.hpp"
 #include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <thread>
 #include <cstdlib>
 #include <utility>
 #include <exception>
@@ -55,6 +58,7 @@ using namespace Spectrograph;
 using namespace System;
 using namespace Events;
 using namespace Logging;
+using namespace GkAudioFramework;
 
 /**
  * @brief GkSinewaveOutput::GkSinewaveOutput
@@ -159,7 +163,7 @@ void GkSinewaveOutput::play()
 
         alCall(alGenBuffers, 1, &buffer);
         const auto sinewave_data = generateSineWaveData();
-        alCall(alBufferData, buffer, AL_FORMAT_STEREO16, sinewave_data.data(), sinewave_data.size(), sampleRate);
+        alCall(alBufferData, buffer, AL_FORMAT_STEREO16, sinewave_data.data(), static_cast<ALsizei>(sinewave_data.size() * sizeof(ALshort)), sampleRate);
         alCall(alGenSources, 1, &source);
         alCall(alSourcei, source, AL_LOOPING, AL_FALSE);
         alCall(alSourcei, source, AL_BUFFER, buffer);
@@ -167,6 +171,7 @@ void GkSinewaveOutput::play()
         alCall(alSourcePlay, source);
         ALint state = AL_PLAYING;
         while (state == AL_PLAYING) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(GK_AUDIO_VOL_PLAYBACK_REFRESH_INTERVAL));
             alCall(alGetSourcei, source, AL_SOURCE_STATE, &state);
         }
 
@@ -181,34 +186,40 @@ void GkSinewaveOutput::play()
 }
 
 /**
- * @brief GkSinewaveOutput::calcBufferLength calculates the length and size of the needed audio buffer.
+ * @brief GkSinewaveOutput::calcBufferLength calculates how many frames are needed to play the sinewave test for the whole
+ * of `playLength`, at the sample rate of the audio device under test. Each frame holds one sample per channel, so the
+ * buffer itself is twice this length once interleaved as stereo.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @return Required audio buffer length/size.
+ * @return The number of frames required.
+ * @see GkSinewaveOutput::generateSineWaveData().
  */
 quint32 GkSinewaveOutput::calcBufferLength()
 {
-    const quint32 play_length_secs = playLength / 1000; // Convert from milliseconds to seconds!
-    if (play_length_secs > 0) {
-        quint32 buf_length = play_length_secs * sampleRate;
-        return buf_length;
-    }
-
-    return 0;
+    const quint64 buf_length = (static_cast<quint64>(playLength) * sampleRate) / 1000; // The play length is given in milliseconds!
+    return static_cast<quint32>(buf_length);
 }
 
 /**
- * @brief GkSinewaveOutput::generateSineWaveData creates the actual sinewave data, via mathematical functions.
+ * @brief GkSinewaveOutput::generateSineWaveData creates the actual sinewave data, via the signal generator, with the
+ * right-hand channel being in anti-phase to the left.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
  * @return The generated sinewave data, as a standard library vector.
- * @note Hide Takei <https://github.com/hideyuki/openal-sine-wave/blob/master/sine_wave/sine_wave.c>
+ * @see GkSignalGenerator::generateInterleaved().
  */
 std::vector<ALshort> GkSinewaveOutput::generateSineWaveData()
 {
-    std::vector<ALshort> out_data;
-    for (qint32 i = 0; i < bufferLength; ++i) {
-        out_data.insert(out_data.begin() + (i * 2), std::sin(2 * M_PI * GK_AUDIO_SINEWAVE_TEST_FREQ_HZ * i / bufferLength) * SHRT_MAX);
-        out_data.insert(out_data.begin() + (i * 2 + 1), -1 * std::sin(2 * M_PI * GK_AUDIO_SINEWAVE_TEST_FREQ_HZ * i / bufferLength) * SHRT_MAX); // Anti-phase component...
-    }
+    GkSignalGenConfig config;
+    config.mode = SigGenSingleTone;
+    config.tones = { { std::min<double>(GK_AUDIO_SINEWAVE_TEST_FREQ_HZ, sampleRate * 0.45), 1.0f } }; // Stay below the Nyquist frequency!
+
+    GkSignalGenerator sigGen;
+    sigGen.configure(config, sampleRate);
+
+    std::vector<float> samples(static_cast<size_t>(bufferLength) * 2);
+    sigGen.generateInterleaved(samples.data(), bufferLength, 2, true); // Anti-phase component...
+
+    std::vector<ALshort> out_data(samples.size());
+    GkSignalGenerator::toPcm16(samples.data(), out_data.data(), samples.size());
 
     return out_data;
 }
@@ -44,6 +44,7 @@
 #include "src/defines.hpp"
 #include "src/gk_logger.hpp"
 #include "src/audio_devices.hpp"
+#include "src/gk_signal_gen.hpp"
 #include <AL/al.h>
 #include <AL/alc.h>
 #include <AL/alext.h>
@@ -83,7 +84,7 @@ private:
     ALCcontext *mTestCtx;       // Context; regards OpenAL.
     ALCboolean mTestCtxCurr;    // Current context; regards OpenAL.
     quint32 playLength;         // The amount of time for which to play the artificially created sinewave audio sample.
-    quint32 bufferLength;       // The buffer size/length to use for storing the sinewave audio data.
+    quint32 bufferLength;       // The number of (stereo) frames of sinewave audio data to be played.
     ALuint sampleRate;          // The preferred sample rate by the given audio device.
 
     quint32 calcBufferLength();
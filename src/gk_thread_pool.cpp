@@ -0,0 +1,217 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/gk_thread_pool.hpp"
+#include <utility>
+#include <exception>
+#include <algorithm>
+
+using namespace GekkoFyre;
+
+namespace {
+//
+// Which worker (if any) the current thread is, so that tasks submitted from within a task go upon that worker's own queue
+thread_local const GkWorkStealingPool *t_pool = nullptr;
+thread_local quint32 t_index = 0;
+}
+
+/**
+ * @brief GkWorkStealingPool::GkWorkStealingPool
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param num_threads The number of worker threads, or zero for as many as there are cores.
+ */
+GkWorkStealingPool::GkWorkStealingPool(const quint32 &num_threads) : m_queued(0), m_pending(0), m_nextQueue(0), m_running(true)
+{
+    const quint32 count = (num_threads > 0) ? num_threads : std::max(1U, std::thread::hardware_concurrency());
+    for (quint32 i = 0; i < count; ++i) {
+        m_queues.push_back(std::make_unique<GkWorkQueue>());
+    }
+
+    for (quint32 i = 0; i < count; ++i) {
+        m_workers.emplace_back(&GkWorkStealingPool::run, this, i);
+    }
+
+    return;
+}
+
+GkWorkStealingPool::~GkWorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock_guard(mtx_idle);
+        m_running = false;
+    }
+
+    cv_idle.notify_all();
+    for (auto &worker: m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+/**
+ * @brief GkWorkStealingPool::submit
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param task The task to be run upon any of the workers.
+ */
+void GkWorkStealingPool::submit(std::function<void()> task)
+{
+    const quint32 index = (t_pool == this) ? t_index : (m_nextQueue++ % static_cast<quint32>(m_queues.size()));
+    ++m_pending;
+
+    //
+    // Counted before the task is published, as a worker may otherwise take it and decrement `m_queued` first, causing
+    // the unsigned counter to wrap around...
+    {
+        std::lock_guard<std::mutex> lock_guard(mtx_idle);
+        ++m_queued;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock_guard(m_queues[index]->mtx);
+        m_queues[index]->tasks.push_back(std::move(task));
+    }
+
+    cv_idle.notify_one();
+    return;
+}
+
+/**
+ * @brief GkWorkStealingPool::wait blocks until every task submitted so far has finished, with the calling thread lending
+ * a hand in the meantime rather than merely sleeping. Should any of those tasks have thrown, the first such exception is
+ * then rethrown towards the caller.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkWorkStealingPool::wait()
+{
+    const quint32 index = (t_pool == this) ? t_index : 0;
+    while (m_pending > 0) {
+        if (!runOne(index)) {
+            std::this_thread::yield();
+        }
+    }
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock_guard(mtx_error);
+        std::swap(error, m_error);
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    return;
+}
+
+quint32 GkWorkStealingPool::getNumThreads() const
+{
+    return static_cast<quint32>(m_workers.size());
+}
+
+/**
+ * @brief GkWorkStealingPool::run is the loop of each worker thread.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param index Which of the queues belongs to this worker.
+ */
+void GkWorkStealingPool::run(const quint32 &index)
+{
+    t_pool = this;
+    t_index = index;
+    while (m_running) {
+        if (runOne(index)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mtx_idle);
+        cv_idle.wait(lock, [this]() { return m_queued > 0 || !m_running; });
+    }
+
+    return;
+}
+
+/**
+ * @brief GkWorkStealingPool::runOne runs a single task, taken from the back of the given queue or, should that be empty,
+ * stolen from the front of another.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param index The queue to look within first.
+ * @return Whether a task was found and run.
+ */
+bool GkWorkStealingPool::runOne(const quint32 &index)
+{
+    std::function<void()> task;
+    const auto num_queues = static_cast<quint32>(m_queues.size());
+    for (quint32 i = 0; i < num_queues && !task; ++i) {
+        const quint32 victim = (index + i) % num_queues;
+        std::lock_guard<std::mutex> lock_guard(m_queues[victim]->mtx);
+        auto &tasks = m_queues[victim]->tasks;
+        if (!tasks.empty()) {
+            if (i == 0) {
+                task = std::move(tasks.back());
+                tasks.pop_back();
+            } else {
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+        }
+    }
+
+    if (!task) {
+        return false;
+    }
+
+    --m_queued;
+    try {
+        task();
+    } catch (...) {
+        //
+        // The task is still counted as finished, so that GkWorkStealingPool::wait() does not hang, with the exception
+        // being kept so that it may be rethrown from there instead...
+        std::lock_guard<std::mutex> lock_guard(mtx_error);
+        if (!m_error) {
+            m_error = std::current_exception();
+        }
+    }
+
+    --m_pending;
+
+    return true;
+}
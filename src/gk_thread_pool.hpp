@@ -0,0 +1,100 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+#include <QtGlobal>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkWorkStealingPool runs tasks upon a fixed set of worker threads, each of which has a queue of its own. Tasks
+ * submitted by a worker go upon its own queue and are taken from the back (so that related work stays upon the same
+ * core), whilst an idle worker steals from the front of the others' queues. This keeps every core busy even when the
+ * tasks differ greatly in cost, as the decoding of candidates does.
+ */
+class GkWorkStealingPool {
+
+public:
+    explicit GkWorkStealingPool(const quint32 &num_threads = 0);
+    ~GkWorkStealingPool();
+
+    GkWorkStealingPool(const GkWorkStealingPool &) = delete;
+    GkWorkStealingPool &operator=(const GkWorkStealingPool &) = delete;
+
+    void submit(std::function<void()> task);
+    void wait();
+
+    [[nodiscard]] quint32 getNumThreads() const;
+
+private:
+    struct GkWorkQueue {
+        std::mutex mtx;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<GkWorkQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::atomic<quint64> m_queued;                                              // Tasks waiting within any of the queues.
+    std::atomic<quint64> m_pending;                                             // Tasks that have yet to finish, whether waiting or running.
+    std::atomic<quint32> m_nextQueue;
+    std::atomic<bool> m_running;
+
+    std::mutex mtx_idle;
+    std::condition_variable cv_idle;
+
+    std::mutex mtx_error;
+    std::exception_ptr m_error;                                                 // The first exception thrown by a task, since the last wait.
+
+    void run(const quint32 &index);
+    bool runOne(const quint32 &index);
+
+};
+};
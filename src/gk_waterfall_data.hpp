@@ -157,6 +157,25 @@ public:
         return true;
     }
 
+    // replaces the entire history in one go, such as with rows that have been decimated from a recorded file,
+    // which is far cheaper than shifting every layer along for each call to addData()
+    bool setHistory(const T* const layers, const time_t* const timestamps, const size_t numLayers)
+    {
+        if (numLayers == 0 || numLayers > m_maxHistoryLength)
+        {
+            return false;
+        }
+
+        clear();
+
+        const size_t firstLayer = m_maxHistoryLength - numLayers;
+        std::copy(layers, layers + numLayers * m_layerPoints, m_data + firstLayer * m_layerPoints);
+        std::copy(timestamps, timestamps + numLayers, m_layersTimestamps + firstLayer);
+        m_currentHistoryLength = numLayers;
+
+        return true;
+    }
+
     void clear()
     {
         std::fill(m_data, m_data + m_layerPoints * m_maxHistoryLength, 0.);
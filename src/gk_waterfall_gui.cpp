@@ -45,6 +45,7 @@
 #include <exception>
 #include <utility>
 #include <memory>
+#include <cmath>
 #include <QPen>
 #include <QColormap>
 #include <QGridLayout>
@@ -266,6 +267,14 @@ GkSpectroWaterfall::GkSpectroWaterfall(QPointer<GkEventLogger> eventLogger, QWid
 
         m_panner->setMouseButton(Qt::MiddleButton);
 
+        //
+        // Each step of the mouse wheel only moves the pending view of a recorded spectrograph product, with the rows
+        // themselves being rescanned once the wheel has come to rest
+        m_spectroViewTimer = new QTimer(this);
+        m_spectroViewTimer->setSingleShot(true);
+        m_spectroViewTimer->setInterval(SPECTRO_OFFLINE_VIEW_DEBOUNCE_MILLISECS);
+        QObject::connect(m_spectroViewTimer, SIGNAL(timeout()), this, SLOT(applySpectroWindow()));
+
         QObject::connect(m_plotHorCurve->axisWidget(QwtPlot::xBottom), &QwtScaleWidget::scaleDivChanged, this, &GkSpectroWaterfall::scaleDivChanged, Qt::QueuedConnection);
         QObject::connect(m_plotSpectrogram->axisWidget(QwtPlot::xBottom), &QwtScaleWidget::scaleDivChanged, this, &GkSpectroWaterfall::scaleDivChanged, Qt::QueuedConnection);
         QObject::connect(m_plotSpectrogram->axisWidget(QwtPlot::yLeft), &QwtScaleWidget::scaleDivChanged, this, &GkSpectroWaterfall::scaleDivChanged, Qt::QueuedConnection);
@@ -688,6 +697,222 @@ time_t GkSpectroWaterfall::getLayerDate(const double y) const
     return gkWaterfallData ? gkWaterfallData->getLayerDate(y) : 0;
 }
 
+/**
+ * @brief GkSpectroWaterfall::loadSpectroProduct displays a spectrograph / waterfall product that was generated from a
+ * recorded audio file, starting off with the entirety of the recording in view.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param product The product to be displayed.
+ * @see GkOfflineSpectro::generate().
+ */
+void GkSpectroWaterfall::loadSpectroProduct(std::shared_ptr<GkSpectroProduct> product)
+{
+    try {
+        if (!product || product->num_rows == 0 || product->num_bins == 0) {
+            throw std::invalid_argument(tr("An empty spectrograph product has been given!").toStdString());
+        }
+
+        m_spectroViewTimer->stop();
+        m_spectroProduct = std::move(product);
+        showSpectroWindow(0, m_spectroProduct->num_rows);
+        emit spectroProductChanged(true);
+    } catch (const std::exception &e) {
+        gkEventLogger->publishEvent(tr("An error occurred during the handling of waterfall / spectrograph data!"), GkSeverity::Error, e.what(), true);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkSpectroWaterfall::showSpectroWindow displays the given range of rows from the loaded spectrograph product.
+ * Should there be more rows and/or frequency bins than can be usefully displayed, then they are decimated by taking the
+ * maximum of each group, so that brief and/or narrow signals are not lost when viewing hours of data at once.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param first_row The first row to be displayed.
+ * @param num_rows The number of rows to be displayed.
+ */
+void GkSpectroWaterfall::showSpectroWindow(const quint64 &first_row, const quint64 &num_rows)
+{
+    if (!m_spectroProduct) {
+        return;
+    }
+
+    const auto &product = *m_spectroProduct;
+    const quint64 rows = std::clamp<quint64>(num_rows, std::min<quint64>(SPECTRO_OFFLINE_VIEW_MIN_ROWS, product.num_rows), product.num_rows);
+    const quint64 first = std::min(first_row, product.num_rows - rows);
+    const size_t rows_out = std::min<quint64>(rows, SPECTRO_OFFLINE_VIEW_MAX_ROWS);
+    const size_t bins_out = std::min<quint32>(product.num_bins, SPECTRO_OFFLINE_VIEW_MAX_BINS);
+
+    m_spectroFirstRow = first;
+    m_spectroNumRows = rows;
+    m_spectroViewData.resize(rows_out * bins_out);
+    m_spectroViewTimes.resize(rows_out);
+
+    for (size_t r = 0; r < rows_out; ++r) {
+        const quint64 row_begin = first + ((r * rows) / rows_out);
+        const quint64 row_end = std::max(row_begin + 1, first + (((r + 1) * rows) / rows_out));
+        m_spectroViewTimes[r] = static_cast<time_t>(product.timestamps[row_begin] / 1000);
+
+        for (size_t b = 0; b < bins_out; ++b) {
+            const auto bin_begin = static_cast<quint32>((b * product.num_bins) / bins_out);
+            const auto bin_end = std::max(bin_begin + 1, static_cast<quint32>(((b + 1) * product.num_bins) / bins_out));
+            double peak = product.db_floor;
+            for (quint64 row = row_begin; row < row_end; ++row) {
+                for (quint32 bin = bin_begin; bin < bin_end; ++bin) {
+                    peak = std::max(peak, spectroCell(row, bin));
+                }
+            }
+
+            m_spectroViewData[(r * bins_out) + b] = peak;
+        }
+    }
+
+    setDataDimensions(product.freq_min, product.freq_max, rows_out, bins_out);
+    gkWaterfallData->setHistory(m_spectroViewData.data(), m_spectroViewTimes.data(), rows_out);
+    updateCurvesData();
+
+    m_plotSpectrogram->setAxisScale(QwtPlot::yLeft, 0, rows_out);
+    m_plotVertCurve->setAxisScale(QwtPlot::yLeft, 0, rows_out);
+
+    double dataRng[2];
+    getDataRange(dataRng[0], dataRng[1]);
+    setRange(dataRng[0], dataRng[1]);
+    replot(true);
+
+    return;
+}
+
+/**
+ * @brief GkSpectroWaterfall::panSpectroWindow moves the rows in view of the loaded spectrograph product.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param fraction How far to move, as a fraction of the rows currently in view. Negative values move back in time.
+ */
+void GkSpectroWaterfall::panSpectroWindow(const double &fraction)
+{
+    if (!m_spectroProduct) {
+        return;
+    }
+
+    if (!m_spectroViewTimer->isActive()) {
+        m_spectroPendingFirst = m_spectroFirstRow;
+        m_spectroPendingRows = m_spectroNumRows;
+    }
+
+    const auto delta = static_cast<qint64>(fraction * static_cast<double>(m_spectroPendingRows));
+    const qint64 first = std::max<qint64>(0, static_cast<qint64>(m_spectroPendingFirst) + delta);
+    m_spectroPendingFirst = std::min(static_cast<quint64>(first), m_spectroProduct->num_rows - std::min(m_spectroPendingRows, m_spectroProduct->num_rows));
+    m_spectroViewTimer->start();
+
+    return;
+}
+
+/**
+ * @brief GkSpectroWaterfall::zoomSpectroWindow changes how many rows of the loaded spectrograph product are in view,
+ * while keeping the centre of the view in place.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param factor Values less than one will zoom in, while values greater than one will zoom out.
+ */
+void GkSpectroWaterfall::zoomSpectroWindow(const double &factor)
+{
+    if (!m_spectroProduct || factor <= 0.0) {
+        return;
+    }
+
+    if (!m_spectroViewTimer->isActive()) {
+        m_spectroPendingFirst = m_spectroFirstRow;
+        m_spectroPendingRows = m_spectroNumRows;
+    }
+
+    const auto &product = *m_spectroProduct;
+    const auto rows = std::clamp<quint64>(static_cast<quint64>(std::max(1.0, static_cast<double>(m_spectroPendingRows) * factor)),
+                                          std::min<quint64>(SPECTRO_OFFLINE_VIEW_MIN_ROWS, product.num_rows), product.num_rows);
+    const quint64 centre = m_spectroPendingFirst + (m_spectroPendingRows / 2);
+    const quint64 first = (centre > (rows / 2)) ? centre - (rows / 2) : 0;
+    m_spectroPendingFirst = std::min(first, product.num_rows - rows);
+    m_spectroPendingRows = rows;
+    m_spectroViewTimer->start();
+
+    return;
+}
+
+/**
+ * @brief GkSpectroWaterfall::applySpectroWindow rescans the loaded spectrograph product for the view that zooming and/or
+ * panning has settled upon.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkSpectroWaterfall::applySpectroWindow()
+{
+    showSpectroWindow(m_spectroPendingFirst, m_spectroPendingRows);
+
+    return;
+}
+
+/**
+ * @brief GkSpectroWaterfall::closeSpectroProduct stops displaying the loaded spectrograph product, so that the live
+ * waterfall may resume.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkSpectroWaterfall::closeSpectroProduct()
+{
+    if (!m_spectroProduct) {
+        return;
+    }
+
+    m_spectroViewTimer->stop();
+    m_spectroProduct.reset();
+    m_spectroFirstRow = 0;
+    m_spectroNumRows = 0;
+    m_spectroViewData.clear();
+    m_spectroViewData.shrink_to_fit();
+    m_spectroViewTimes.clear();
+    m_spectroViewTimes.shrink_to_fit();
+    clear();
+
+    emit spectroProductChanged(false);
+    return;
+}
+
+/**
+ * @brief GkSpectroWaterfall::wheelEvent zooms (with the Control key held) or otherwise pans through time whenever a
+ * recorded spectrograph product is being displayed.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param event The mouse wheel event.
+ */
+void GkSpectroWaterfall::wheelEvent(QWheelEvent *event)
+{
+    if (!m_spectroProduct) {
+        QWidget::wheelEvent(event);
+        return;
+    }
+
+    const double steps = event->angleDelta().y() / 120.0;
+    if (event->modifiers() & Qt::ControlModifier) {
+        zoomSpectroWindow(std::pow(0.8, steps));
+    } else {
+        panSpectroWindow(-0.25 * steps);
+    }
+
+    event->accept();
+    return;
+}
+
+/**
+ * @brief GkSpectroWaterfall::spectroCell
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param row The row within the loaded spectrograph product.
+ * @param bin The frequency bin within said row.
+ * @return The value of the given cell, in dBFS.
+ */
+double GkSpectroWaterfall::spectroCell(const quint64 &row, const quint32 &bin) const
+{
+    const auto &product = *m_spectroProduct;
+    const size_t idx = (row * product.num_bins) + bin;
+    if (product.quant == SpectroUint8) {
+        return product.db_floor + ((product.rows_u8[idx] / 255.0) * (product.db_ceiling - product.db_floor));
+    }
+
+    return product.rows_f32[idx];
+}
+
 /**
  * @brief GkSpectroWaterfall::updateLayout
  * @author Copyright © 2019 Amine Mzoughi <https://github.com/embeddedmz/QwtWaterfallplot>.
@@ -47,6 +47,7 @@
 #include "src/gk_waterfall_data.hpp"
 #include <mutex>
 #include <cmath>
+#include <memory>
 #include <vector>
 #include <thread>
 #include <future>
@@ -59,6 +60,7 @@
 #include <QPointer>
 #include <QDateTime>
 #include <QMouseEvent>
+#include <QWheelEvent>
 #include <QSharedPointer>
 #include <QScopedPointer>
 
@@ -158,6 +160,13 @@ public:
 
     double getOffset() const { return (gkWaterfallData) ? gkWaterfallData->getOffset() : 0; }
 
+    //
+    // Recorded (i.e. offline) spectrograph products
+    //
+    void showSpectroWindow(const quint64 &first_row, const quint64 &num_rows);
+    [[nodiscard]] bool hasSpectroProduct() const { return m_spectroProduct != nullptr; }
+    [[nodiscard]] std::shared_ptr<const GekkoFyre::Spectrograph::GkSpectroProduct> getSpectroProduct() const { return m_spectroProduct; }
+
     QString m_xUnit;
     QString m_zUnit;
 
@@ -189,6 +198,7 @@ protected:
     double m_markerY = 0;
 
     void updateLayout();
+    void wheelEvent(QWheelEvent *event) override;
 
     void allocateCurvesData();
     void freeCurvesData();
@@ -201,16 +211,24 @@ protected:
 
 public slots:
     void setPickerEnabled(const bool enabled);
+    void loadSpectroProduct(std::shared_ptr<GekkoFyre::Spectrograph::GkSpectroProduct> product);
+    void panSpectroWindow(const double &fraction);
+    void zoomSpectroWindow(const double &factor);
+    void closeSpectroProduct();
 
     //
     // View
     //
     void replot(bool forceRepaint = false);
 
+signals:
+    void spectroProductChanged(const bool &loaded);
+
 protected slots:
     void autoRescale(const QRectF &rect);
     void selectedPoint(const QPointF &pt);
     void scaleDivChanged();
+    void applySpectroWindow();
 
 private:
     QPointer<QwtPlotCanvas> canvas;
@@ -222,6 +240,21 @@ private:
     QPointer<GekkoFyre::GkEventLogger> gkEventLogger;
     int gkAlpha;                                                // Controls the alpha value of the waterfall chart.
 
+    //
+    // Recorded (i.e. offline) spectrograph products
+    //
+    std::shared_ptr<const GekkoFyre::Spectrograph::GkSpectroProduct> m_spectroProduct;
+    quint64 m_spectroFirstRow = 0;                              // The first row of the product currently in view.
+    quint64 m_spectroNumRows = 0;                               // The number of rows of the product currently in view.
+    std::vector<double> m_spectroViewData;
+    std::vector<time_t> m_spectroViewTimes;
+
+    QPointer<QTimer> m_spectroViewTimer;                        // Coalesces a burst of zooming and/or panning into a single rescan.
+    quint64 m_spectroPendingFirst = 0;                          // The first row that is to be brought into view, once the timer fires.
+    quint64 m_spectroPendingRows = 0;                           // The number of rows that are to be brought into view, once the timer fires.
+
+    [[nodiscard]] double spectroCell(const quint64 &row, const quint32 &bin) const;
+
     //
     // Threads
     //
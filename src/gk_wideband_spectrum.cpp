@@ -0,0 +1,513 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/gk_wideband_spectrum.hpp"
+#include <cmath>
+#include <chrono>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <exception>
+
+using namespace GekkoFyre;
+using namespace Spectrograph;
+using namespace System;
+using namespace Events;
+using namespace Logging;
+
+/**
+ * @brief GkWidebandSpectrum::GkWidebandSpectrum
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sdrStream The stream of IQ samples, which must not yet be running as a consumer is registered upon it here.
+ * @param spectroWaterfall The spectrograph / waterfall that rows are to be handed towards.
+ * @param eventLogger The event logging class.
+ * @param parent The parent object to this class.
+ */
+GkWidebandSpectrum::GkWidebandSpectrum(QPointer<GkSdrStream> sdrStream, QPointer<GkSpectroWaterfall> spectroWaterfall,
+                                       QPointer<GkEventLogger> eventLogger, QObject *parent)
+    : QObject(parent), m_sink(-1), m_fftSize(SPECTRO_WIDEBAND_FFT_DEFAULT_SIZE), m_displayWidth(SPECTRO_WIDEBAND_DEFAULT_WIDTH),
+      m_avgMode(WidebandAvgLogPower), m_decimateMode(WidebandDecimateMax), m_avgAlpha(SPECTRO_WIDEBAND_DEFAULT_AVG_ALPHA),
+      m_reconfigure(true), m_resetAvg(false), m_sampleRate(0.0), m_centerFreq(0.0), m_running(false),
+      m_fftCfg(nullptr, [](void *cfg) { kiss_fft_free(cfg); }), m_norm(1.0f), m_fill(0), m_skip(0), m_avgPrimed(false),
+      m_rowReady(false)
+{
+    gkSdrStream = std::move(sdrStream);
+    gkSpectroWaterfall = std::move(spectroWaterfall);
+    gkEventLogger = std::move(eventLogger);
+
+    m_sink = gkSdrStream->addSink();
+
+    rowTimer = new QTimer(this);
+    rowTimer->setInterval(std::chrono::milliseconds(SPECTRO_WIDEBAND_ROW_MILLISECS));
+    QObject::connect(rowTimer, SIGNAL(timeout()), this, SLOT(pushRow()));
+    QObject::connect(this, SIGNAL(refreshGraph(bool)), gkSpectroWaterfall, SLOT(replot(bool)));
+
+    return;
+}
+
+GkWidebandSpectrum::~GkWidebandSpectrum()
+{
+    stop();
+}
+
+/**
+ * @brief GkWidebandSpectrum::setFftSize
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param fft_size The size of the complex FFT, which must be a power of two between SPECTRO_WIDEBAND_FFT_MIN_SIZE and
+ * SPECTRO_WIDEBAND_FFT_MAX_SIZE.
+ */
+void GkWidebandSpectrum::setFftSize(const quint32 &fft_size)
+{
+    if (fft_size < SPECTRO_WIDEBAND_FFT_MIN_SIZE || fft_size > SPECTRO_WIDEBAND_FFT_MAX_SIZE || (fft_size & (fft_size - 1)) != 0) {
+        throw std::invalid_argument(tr("The FFT size for the wideband spectrograph must be a power of two, between %1 and %2!")
+                                            .arg(QString::number(SPECTRO_WIDEBAND_FFT_MIN_SIZE), QString::number(SPECTRO_WIDEBAND_FFT_MAX_SIZE)).toStdString());
+    }
+
+    std::lock_guard<std::mutex> lock_guard(mtx_settings);
+    m_fftSize = fft_size;
+    m_reconfigure = true;
+
+    return;
+}
+
+/**
+ * @brief GkWidebandSpectrum::setDisplayWidth
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param width The width of the spectrograph / waterfall, in pixels, which rows are to be decimated down towards.
+ */
+void GkWidebandSpectrum::setDisplayWidth(const quint32 &width)
+{
+    std::lock_guard<std::mutex> lock_guard(mtx_settings);
+    m_displayWidth = std::max<quint32>(width, 1);
+    m_reconfigure = true;
+
+    return;
+}
+
+/**
+ * @brief GkWidebandSpectrum::setAveraging
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param mode How successive frames are to be combined.
+ * @param alpha The weight given to each new frame, between zero and one, when averaging in log-power.
+ */
+void GkWidebandSpectrum::setAveraging(const GkWidebandAverage &mode, const float &alpha)
+{
+    std::lock_guard<std::mutex> lock_guard(mtx_settings);
+    m_avgMode = mode;
+    m_avgAlpha = std::clamp(alpha, 0.001f, 1.0f);
+    m_resetAvg = true;
+
+    return;
+}
+
+/**
+ * @brief GkWidebandSpectrum::setDecimation
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param mode How the bins covered by each pixel are to be combined.
+ */
+void GkWidebandSpectrum::setDecimation(const GkWidebandDecimate &mode)
+{
+    std::lock_guard<std::mutex> lock_guard(mtx_settings);
+    m_decimateMode = mode;
+    m_resetAvg = true;
+
+    return;
+}
+
+/**
+ * @brief GkWidebandSpectrum::getFftSize
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The size of the complex FFT.
+ */
+quint32 GkWidebandSpectrum::getFftSize() const
+{
+    return m_fftSize;
+}
+
+/**
+ * @brief GkWidebandSpectrum::getRowWidth
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The number of points within each row handed towards the spectrograph / waterfall, which is the display width
+ * unless the FFT happens to be even narrower than that.
+ */
+quint32 GkWidebandSpectrum::getRowWidth() const
+{
+    return std::min(m_fftSize, m_displayWidth);
+}
+
+/**
+ * @brief GkWidebandSpectrum::isRunning
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return Whether the worker thread is running.
+ */
+bool GkWidebandSpectrum::isRunning() const
+{
+    return m_running;
+}
+
+/**
+ * @brief GkWidebandSpectrum::calcPixelEdges works out which FFT bins are covered by each pixel.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param num_bins The number of FFT bins.
+ * @param width The number of pixels, which should be no more than the number of bins.
+ * @return The first bin of each pixel, followed by one past the last bin of the final pixel.
+ */
+std::vector<quint32> GkWidebandSpectrum::calcPixelEdges(const quint32 &num_bins, const quint32 &width)
+{
+    const quint32 num_pixels = std::max<quint32>(std::min(num_bins, width), 1);
+    std::vector<quint32> edges(num_pixels + 1);
+    for (quint32 i = 0; i <= num_pixels; ++i) {
+        edges[i] = static_cast<quint32>((static_cast<quint64>(i) * num_bins) / num_pixels);
+    }
+
+    return edges;
+}
+
+/**
+ * @brief GkWidebandSpectrum::decimateRow reduces a frame of FFT bins down towards one value per pixel.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param power The linear power of each FFT bin.
+ * @param edges The bins covered by each pixel, as given by GkWidebandSpectrum::calcPixelEdges().
+ * @param mode Whether to take the maximum or the mean of the bins covered by each pixel.
+ * @param out The linear power of each pixel, which must hold `edges.size() - 1` values.
+ */
+void GkWidebandSpectrum::decimateRow(const float *power, const std::vector<quint32> &edges, const GkWidebandDecimate &mode,
+                                     float *out)
+{
+    const size_t num_pixels = edges.size() - 1;
+    if (mode == WidebandDecimateMax) {
+        for (size_t i = 0; i < num_pixels; ++i) {
+            float max_val = power[edges[i]];
+            for (quint32 j = edges[i] + 1; j < edges[i + 1]; ++j) {
+                max_val = std::max(max_val, power[j]);
+            }
+
+            out[i] = max_val;
+        }
+    } else {
+        for (size_t i = 0; i < num_pixels; ++i) {
+            float sum = 0.0f;
+            for (quint32 j = edges[i]; j < edges[i + 1]; ++j) {
+                sum += power[j];
+            }
+
+            out[i] = sum / static_cast<float>(edges[i + 1] - edges[i]);
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief GkWidebandSpectrum::start begins taking FFTs of the stream, which should have just been started itself.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sample_rate The sample rate of the stream, which is also the bandwidth that is displayed.
+ */
+void GkWidebandSpectrum::start(const double &sample_rate)
+{
+    stop();
+
+    m_sampleRate = sample_rate;
+    m_reconfigure = true;
+    {
+        std::lock_guard<std::mutex> lock_guard(mtx_row);
+        m_rowReady = false;
+    }
+
+    m_running = true;
+    workerThread = std::thread(&GkWidebandSpectrum::run, this);
+    rowTimer->start();
+
+    return;
+}
+
+/**
+ * @brief GkWidebandSpectrum::stop halts the worker thread, which must be done before the stream itself is stopped.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkWidebandSpectrum::stop()
+{
+    m_running = false;
+    if (workerThread.joinable()) {
+        workerThread.join();
+    }
+
+    if (rowTimer) {
+        rowTimer->stop();
+    }
+
+    return;
+}
+
+/**
+ * @brief GkWidebandSpectrum::setCenterFrequency
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param freq_hz The frequency that the SDR device is tuned towards, which is shown in the middle of the display.
+ */
+void GkWidebandSpectrum::setCenterFrequency(const double &freq_hz)
+{
+    m_centerFreq = freq_hz;
+    return;
+}
+
+/**
+ * @brief GkWidebandSpectrum::resetAveraging clears the averaging (or peak-hold) so that it starts afresh.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkWidebandSpectrum::resetAveraging()
+{
+    m_resetAvg = true;
+    return;
+}
+
+/**
+ * @brief GkWidebandSpectrum::pushRow hands the latest row, if there is one, towards the spectrograph / waterfall. This is
+ * done upon the GUI thread, at a fixed rate, no matter how quickly frames are being taken.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkWidebandSpectrum::pushRow()
+{
+    try {
+        if (!gkSpectroWaterfall || gkSpectroWaterfall->hasSpectroProduct()) {
+            //
+            // A recorded audio file is currently being viewed, so do not overwrite it with the live stream!
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock_guard(mtx_row);
+            if (!m_rowReady) {
+                return;
+            }
+
+            m_rowOut.assign(m_row.begin(), m_row.end());
+            m_rowReady = false;
+        }
+
+        //
+        // The x-axis is measured in kHz, with the tuned frequency in the very middle
+        const double half_bw_khz = (m_sampleRate / 2.0) / 1000.0;
+        const double center_khz = m_centerFreq / 1000.0;
+        double xMin, xMax;
+        size_t historyLength, layerPoints;
+        gkSpectroWaterfall->getDataDimensions(xMin, xMax, historyLength, layerPoints);
+        if (xMin != (center_khz - half_bw_khz) || xMax != (center_khz + half_bw_khz) || layerPoints != m_rowOut.size() ||
+            historyLength != SPECTRO_WIDEBAND_HISTORY_ROWS) {
+            gkSpectroWaterfall->setDataDimensions(center_khz - half_bw_khz, center_khz + half_bw_khz, SPECTRO_WIDEBAND_HISTORY_ROWS,
+                                                  m_rowOut.size());
+            gkSpectroWaterfall->setRange(SPECTRO_WIDEBAND_DB_MIN, 0.0);
+        }
+
+        if (!gkSpectroWaterfall->addData(m_rowOut.data(), m_rowOut.size(), std::time(nullptr))) {
+            throw std::runtime_error(tr("There has been an error with the spectrograph / waterfall.").toStdString());
+        }
+
+        emit refreshGraph(false);
+    } catch (const std::exception &e) {
+        rowTimer->stop();
+        gkEventLogger->publishEvent(tr("Unable to update the wideband spectrograph. Error: %1").arg(QString::fromStdString(e.what())),
+                                    GkSeverity::Error, "", false, true, false, true, false);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkWidebandSpectrum::run is the worker thread, which gathers IQ samples into frames and processes them. Should
+ * the sample rate be high enough that more than SPECTRO_WIDEBAND_MAX_FRAMES_PER_SEC frames would be taken, then the
+ * samples in-between frames are skipped over, as a waterfall cannot show them anyway.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkWidebandSpectrum::run()
+{
+    quint64 to_skip = 0;
+    while (m_running) {
+        if (m_reconfigure) {
+            rebuild();
+            to_skip = 0;
+        }
+
+        GkIqBlock *block = gkSdrStream->popBlock(m_sink);
+        if (!block) {
+            std::this_thread::sleep_for(std::chrono::microseconds(GK_SDR_STREAM_CONSUMER_IDLE_MICROSECS));
+            continue;
+        }
+
+        size_t pos = 0;
+        while (pos < block->count) {
+            if (to_skip > 0) {
+                const auto skipped = std::min<quint64>(to_skip, block->count - pos);
+                pos += skipped;
+                to_skip -= skipped;
+                continue;
+            }
+
+            const auto to_copy = std::min<size_t>(m_timeData.size() - m_fill, block->count - pos);
+            for (size_t i = 0; i < to_copy; ++i) {
+                const auto &sample = block->samples[pos + i];
+                const float w = m_window[m_fill + i];
+                m_timeData[m_fill + i].r = static_cast<kiss_fft_scalar>(sample.real() * w);
+                m_timeData[m_fill + i].i = static_cast<kiss_fft_scalar>(sample.imag() * w);
+            }
+
+            pos += to_copy;
+            m_fill += static_cast<quint32>(to_copy);
+            if (m_fill == m_timeData.size()) {
+                processFrame();
+                m_fill = 0;
+                to_skip = m_skip;
+            }
+        }
+
+        gkSdrStream->releaseBlock(block);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkWidebandSpectrum::rebuild (re)allocates everything needed by the worker thread, whenever the settings change.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkWidebandSpectrum::rebuild()
+{
+    quint32 fft_size, width;
+    {
+        std::lock_guard<std::mutex> lock_guard(mtx_settings);
+        fft_size = m_fftSize;
+        width = m_displayWidth;
+        m_reconfigure = false;
+    }
+
+    m_fftCfg.reset(kiss_fft_alloc(static_cast<int>(fft_size), 0, nullptr, nullptr));
+    m_timeData.assign(fft_size, kiss_fft_cpx{});
+    m_freqData.assign(fft_size, kiss_fft_cpx{});
+    m_power.assign(fft_size, 0.0f);
+
+    //
+    // Blackman-Harris window, as its low sidelobes keep strong signals from smearing across such a wide display, along
+    // with the factor needed to normalize the output towards dBFS!
+    m_window.resize(fft_size);
+    double window_sum = 0.0;
+    for (quint32 i = 0; i < fft_size; ++i) {
+        const double x = (2.0 * M_PI * i) / fft_size;
+        m_window[i] = static_cast<float>(0.35875 - 0.48829 * std::cos(x) + 0.14128 * std::cos(2.0 * x) - 0.01168 * std::cos(3.0 * x));
+        window_sum += m_window[i];
+    }
+
+    m_norm = static_cast<float>(1.0 / (window_sum * window_sum));
+
+    m_edges = calcPixelEdges(fft_size, width);
+    m_pixels.assign(m_edges.size() - 1, 0.0f);
+    m_avg.assign(m_edges.size() - 1, SPECTRO_WIDEBAND_DB_MIN);
+    m_avgPrimed = false;
+    m_fill = 0;
+
+    const double frame_interval = m_sampleRate / SPECTRO_WIDEBAND_MAX_FRAMES_PER_SEC;
+    m_skip = (frame_interval > fft_size) ? static_cast<quint64>(frame_interval - fft_size) : 0;
+
+    return;
+}
+
+/**
+ * @brief GkWidebandSpectrum::processFrame transforms a full frame, decimates it down towards the display width, and then
+ * averages it in log-power. Only the decimated row is ever converted towards dB or averaged.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkWidebandSpectrum::processFrame()
+{
+    kiss_fft(m_fftCfg.get(), m_timeData.data(), m_freqData.data());
+
+    //
+    // Swap the halves around so that negative frequencies are on the left, with DC in the middle
+    const size_t fft_size = m_freqData.size();
+    const size_t half = fft_size / 2;
+    for (size_t i = 0; i < fft_size; ++i) {
+        const auto &bin = m_freqData[i];
+        m_power[(i + half) & (fft_size - 1)] = static_cast<float>((bin.r * bin.r) + (bin.i * bin.i)) * m_norm;
+    }
+
+    GkWidebandDecimate decimate_mode;
+    GkWidebandAverage avg_mode;
+    float alpha;
+    {
+        std::lock_guard<std::mutex> lock_guard(mtx_settings);
+        decimate_mode = m_decimateMode;
+        avg_mode = m_avgMode;
+        alpha = m_avgAlpha;
+    }
+
+    decimateRow(m_power.data(), m_edges, decimate_mode, m_pixels.data());
+
+    if (m_resetAvg.exchange(false)) {
+        m_avgPrimed = false;
+    }
+
+    for (size_t i = 0; i < m_pixels.size(); ++i) {
+        const float db = std::max(10.0f * std::log10(m_pixels[i] + std::numeric_limits<float>::min()), SPECTRO_WIDEBAND_DB_MIN);
+        if (!m_avgPrimed || avg_mode == WidebandAvgNone) {
+            m_avg[i] = db;
+        } else if (avg_mode == WidebandAvgLogPower) {
+            m_avg[i] += alpha * (db - m_avg[i]);
+        } else {
+            m_avg[i] = std::max(m_avg[i], db);
+        }
+    }
+
+    m_avgPrimed = true;
+    publishRow();
+
+    return;
+}
+
+/**
+ * @brief GkWidebandSpectrum::publishRow makes the averaged row available towards the GUI thread, replacing any row that
+ * has not yet been picked up.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkWidebandSpectrum::publishRow()
+{
+    std::lock_guard<std::mutex> lock_guard(mtx_row);
+    m_row.assign(m_avg.begin(), m_avg.end());
+    m_rowReady = true;
+
+    return;
+}
@@ -0,0 +1,153 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include "src/gk_logger.hpp"
+#include "src/gk_sdr_stream.hpp"
+#include "src/gk_waterfall_gui.hpp"
+#include <kiss_fft.h>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <complex>
+#include <QTimer>
+#include <QObject>
+#include <QPointer>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkWidebandSpectrum turns a stream of IQ samples, which may well be several MHz wide, into rows for the
+ * spectrograph / waterfall. Large complex FFTs are taken upon a worker thread, and each frame is decimated down towards
+ * the width of the display before anything else is done with it, so that memory use and render cost are both set by the
+ * width of the screen rather than by the FFT size.
+ */
+class GkWidebandSpectrum : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GkWidebandSpectrum(QPointer<GekkoFyre::GkSdrStream> sdrStream, QPointer<GekkoFyre::GkSpectroWaterfall> spectroWaterfall,
+                                QPointer<GekkoFyre::GkEventLogger> eventLogger, QObject *parent = nullptr);
+    ~GkWidebandSpectrum() override;
+
+    void setFftSize(const quint32 &fft_size);
+    void setDisplayWidth(const quint32 &width);
+    void setAveraging(const GekkoFyre::Spectrograph::GkWidebandAverage &mode, const float &alpha = SPECTRO_WIDEBAND_DEFAULT_AVG_ALPHA);
+    void setDecimation(const GekkoFyre::Spectrograph::GkWidebandDecimate &mode);
+
+    [[nodiscard]] quint32 getFftSize() const;
+    [[nodiscard]] quint32 getRowWidth() const;
+    [[nodiscard]] bool isRunning() const;
+
+    static void decimateRow(const float *power, const std::vector<quint32> &edges, const GekkoFyre::Spectrograph::GkWidebandDecimate &mode,
+                            float *out);
+    [[nodiscard]] static std::vector<quint32> calcPixelEdges(const quint32 &num_bins, const quint32 &width);
+
+public slots:
+    void start(const double &sample_rate);
+    void stop();
+    void setCenterFrequency(const double &freq_hz);
+    void resetAveraging();
+
+private slots:
+    void pushRow();
+
+signals:
+    void refreshGraph(bool forceRepaint = false);
+
+private:
+    QPointer<GekkoFyre::GkSdrStream> gkSdrStream;
+    QPointer<GekkoFyre::GkSpectroWaterfall> gkSpectroWaterfall;
+    QPointer<GekkoFyre::GkEventLogger> gkEventLogger;
+    QPointer<QTimer> rowTimer;
+    qint32 m_sink;
+
+    //
+    // Settings, which are only ever picked up by the worker thread between frames
+    std::mutex mtx_settings;
+    quint32 m_fftSize;
+    quint32 m_displayWidth;
+    GekkoFyre::Spectrograph::GkWidebandAverage m_avgMode;
+    GekkoFyre::Spectrograph::GkWidebandDecimate m_decimateMode;
+    float m_avgAlpha;
+    std::atomic<bool> m_reconfigure;
+    std::atomic<bool> m_resetAvg;
+    std::atomic<double> m_sampleRate;
+    std::atomic<double> m_centerFreq;
+
+    //
+    // Multithreading
+    std::thread workerThread;
+    std::atomic<bool> m_running;
+
+    //
+    // The following are only ever touched by the worker thread
+    std::unique_ptr<std::remove_pointer<kiss_fft_cfg>::type, void (*)(void *)> m_fftCfg;
+    std::vector<float> m_window;
+    std::vector<kiss_fft_cpx> m_timeData;
+    std::vector<kiss_fft_cpx> m_freqData;
+    std::vector<float> m_power;                                                 // Linear power of each bin, with DC in the middle.
+    std::vector<float> m_pixels;                                                // Linear power of each pixel.
+    std::vector<float> m_avg;                                                   // The averaged row, in dBFS.
+    std::vector<quint32> m_edges;
+    float m_norm;
+    quint32 m_fill;
+    quint64 m_skip;
+    bool m_avgPrimed;
+
+    //
+    // The latest row, as handed from the worker thread towards the GUI thread
+    std::mutex mtx_row;
+    std::vector<float> m_row;
+    std::vector<double> m_rowOut;
+    bool m_rowReady;
+
+    void run();
+    void rebuild();
+    void processFrame();
+    void publishRow();
+
+};
+};
@@ -93,7 +93,6 @@ GkXmppClient::GkXmppClient(const GkUserConn &connection_details, QPointer<GekkoF
                                               m_xmppCarbonMgr(findExtension<QXmppCarbonManager>()),
                                               m_xmppLogger(QXmppLogger::getLogger()),
                                               m_discoMgr(findExtension<QXmppDiscoveryManager>()),
-                                              m_rosterList(std::make_shared<QList<GekkoFyre::Network::GkXmpp::GkXmppCallsign>>()),
                                               m_mucList(std::make_shared<QList<GekkoFyre::Network::GkXmpp::GkXmppMuc>>()),
                                               QXmppClient(parent)
 {
@@ -106,6 +105,7 @@ GkXmppClient::GkXmppClient(const GkUserConn &connection_details, QPointer<GekkoF
         gkSystem = std::move(system);
         gkEventLogger = std::move(eventLogger);
         m_sslSocket = new QSslSocket(this);
+        m_rosterStore = new GkXmppRosterStore(this);
 
         m_registerManager = std::make_shared<QXmppRegistrationManager>();
         m_mucManager = std::make_unique<QXmppMucManager>();
@@ -113,6 +113,11 @@ GkXmppClient::GkXmppClient(const GkUserConn &connection_details, QPointer<GekkoF
         m_xmppArchiveMgr = std::make_unique<QXmppArchiveManager>();
         m_xmppMamMgr = std::make_unique<QXmppMamManager>();
         m_xmppCarbonMgr = std::make_unique<QXmppCarbonManager>();
+        m_receiptMgr = std::make_unique<QXmppMessageReceiptManager>();
+        m_mamSync = new GkXmppMamSync(m_xmppMamMgr.get(), this);
+        m_vCardScheduler = new GkXmppVCardScheduler(m_vCardManager.get(), this);
+        m_stanzaWorker = std::make_unique<GkXmppStanzaWorker>(gkDb.data(), m_rosterStore.data(), m_connDetails.jid);
+        m_outbox = new GkXmppOutbox(this, gkDb, m_connDetails.jid, this);
 
         addExtension(m_rosterManager.get());
         addExtension(m_versionMgr.get());
@@ -146,9 +151,17 @@ GkXmppClient::GkXmppClient(const GkUserConn &connection_details, QPointer<GekkoF
             addExtension(m_xmppCarbonMgr.get());
         }
 
+        if (m_receiptMgr) {
+            addExtension(m_receiptMgr.get());
+        }
+
         //
         // Booleans and other variables
         m_askToReconnectAuto = false;
+        m_resumePending = false;
+        m_reconnectBytes = 0;
+        m_stanzaGuiNsecs = 0;
+        m_stanzaGuiCount = 0;
         m_sslIsEnabled = false;
         m_isMuc = false;
 
@@ -186,6 +199,10 @@ GkXmppClient::GkXmppClient(const GkUserConn &connection_details, QPointer<GekkoF
 
         QObject::connect(m_vCardManager.get(), SIGNAL(vCardReceived(const QXmppVCardIq &)), this, SLOT(vCardReceived(const QXmppVCardIq &)));
         QObject::connect(m_vCardManager.get(), SIGNAL(clientVCardReceived()), this, SLOT(clientVCardReceived()));
+        QObject::connect(m_vCardScheduler, &GkXmppVCardScheduler::fetchesFinished, this, [=](const quint64 &sent, const quint64 &skipped) {
+            gkEventLogger->publishEvent(tr("vCards are up to date; %1 requested and %2 skipped thus far.").arg(QString::number(sent)).arg(QString::number(skipped)),
+                                        GkSeverity::Debug, "", false, true, false, false);
+        });
         QObject::connect(this, SIGNAL(sendClientVCard(const QXmppVCardIq &)), this, SLOT(updateClientVCard(const QXmppVCardIq &)));
         QObject::connect(this, SIGNAL(refreshDisplayedClientAvatar(const QByteArray &)),
                          parent, SLOT(updateDisplayedClientAvatar(const QByteArray &)));
@@ -215,6 +232,13 @@ GkXmppClient::GkXmppClient(const GkUserConn &connection_details, QPointer<GekkoF
         m_xmppLogger->setLoggingType(QXmppLogger::SignalLogging);
         QObject::connect(m_xmppLogger.get(), SIGNAL(message(QXmppLogger::MessageType, const QString &)),
                          gkEventLogger, SLOT(recvXmppLog(QXmppLogger::MessageType, const QString &)));
+        QObject::connect(m_xmppLogger.get(), &QXmppLogger::message, this, [=](QXmppLogger::MessageType type, const QString &text) {
+            //
+            // Tally up whatever is exchanged whilst reconnecting, so that the cost of each reconnection may be logged
+            if (m_reconnectTimer.isValid() && (type == QXmppLogger::SentMessage || type == QXmppLogger::ReceivedMessage)) {
+                m_reconnectBytes += text.toUtf8().size();
+            }
+        });
 
         //
         // Initialize all the SIGNALS and SLOTS for QXmppRosterManager...
@@ -229,22 +253,36 @@ GkXmppClient::GkXmppClient(const GkUserConn &connection_details, QPointer<GekkoF
 
         //
         // QXmppArchiveManager and QXmppMamManager handling...
-        QObject::connect(this, SIGNAL(procXmppMsg(const QXmppMessage &, const bool &)),
-                         this, SLOT(updateQueues(const QXmppMessage &, const bool &)));
-        QObject::connect(this, SIGNAL(sendXmppMsgToArchive(const QXmppMessage &, const bool &)),
-                         this, SLOT(insertArchiveMessage(const QXmppMessage &, const bool &)));
-        QObject::connect(this, SIGNAL(sendIncomingResults(QXmppMessage )),
-                         this, SLOT(filterIncomingResults(QXmppMessage )));
-        QObject::connect(this, SIGNAL(procFirstPartyMsg(const QXmppMessage &, const bool &)),
-                         this, SLOT(handleFirstPartyMsg(const QXmppMessage &, const bool &)));
-        QObject::connect(this, SIGNAL(procThirdPartyMsg(const QXmppMessage &, const bool &)),
-                         this, SLOT(handleThirdPartyMsg(const QXmppMessage &, const bool &)));
+        QObject::connect(m_stanzaWorker.get(), SIGNAL(archivedPageProcessed(const GekkoFyre::Network::GkXmpp::GkXmppMamBatch &)),
+                         this, SLOT(applyArchivedBatch(const GekkoFyre::Network::GkXmpp::GkXmppMamBatch &)));
+        QObject::connect(m_stanzaWorker.get(), SIGNAL(vCardSaved(const QString &, const QByteArray &)),
+                         this, SLOT(handleSavedVCard(const QString &, const QByteArray &)));
+        QObject::connect(m_stanzaWorker.get(), SIGNAL(processingError(const QString &)),
+                         this, SLOT(handleStanzaWorkerError(const QString &)));
+
+        //
+        // Outgoing messages and their delivery receipts (XEP-0184)...
+        QObject::connect(m_receiptMgr.get(), SIGNAL(messageDelivered(const QString &, const QString &)),
+                         m_outbox, SLOT(receiptReceived(const QString &, const QString &)));
+        QObject::connect(m_outbox, SIGNAL(messageSent(const QString &, const QString &)),
+                         this, SLOT(handleSentMsg(const QString &, const QString &)));
+        QObject::connect(m_outbox, SIGNAL(messageFailed(const QString &, const QString &)),
+                         this, SLOT(handleFailedMsg(const QString &, const QString &)));
+        QObject::connect(m_outbox, SIGNAL(spoolError(const QString &)), this, SLOT(handleStanzaWorkerError(const QString &)));
+        m_outbox->restore();
         QObject::connect(m_xmppArchiveMgr.get(), SIGNAL(archiveChatReceived(const QXmppArchiveChat &, const QXmppResultSetReply &)),
                          this, SLOT(archiveChatReceived(const QXmppArchiveChat &, const QXmppResultSetReply &)));
         QObject::connect(m_xmppArchiveMgr.get(), SIGNAL(archiveListReceived(const QList<QXmppArchiveChat> &, const QXmppResultSetReply &)),
                          this, SLOT(archiveListReceived(const QList<QXmppArchiveChat> &, const QXmppResultSetReply &)));
         QObject::connect(m_xmppMamMgr.get(), SIGNAL(archivedMessageReceived(const QString &, const QXmppMessage &)),
                          this, SLOT(archivedMessageReceived(const QString &, const QXmppMessage &)));
+        QObject::connect(m_xmppMamMgr.get(), SIGNAL(archivedMessageReceived(const QString &, const QXmppMessage &)),
+                         m_mamSync, SLOT(archivedMessageReceived(const QString &, const QXmppMessage &)));
+        QObject::connect(m_mamSync, SIGNAL(lastArchiveIdChanged(const QString &, const QString &)),
+                         this, SLOT(saveMamLastId(const QString &, const QString &)));
+        QObject::connect(m_rosterStore, SIGNAL(entryAdded(const QString &)), this, SLOT(indexRosterEntry(const QString &)));
+        QObject::connect(m_rosterStore, SIGNAL(vCardUpdated(const QString &)), this, SLOT(indexRosterEntry(const QString &)));
+        QObject::connect(m_rosterStore, SIGNAL(entryRemoved(const QString &)), this, SLOT(unindexRosterEntry(const QString &)));
         QObject::connect(this, SIGNAL(createXmppMuc(const QString &, const QString &, const QString &)),
                          this, SLOT(createMuc(const QString &, const QString &, const QString &)));
         QObject::connect(this, SIGNAL(joinXmppMuc(const QString &)), this, SLOT(joinMuc(const QString &)));
@@ -259,6 +297,8 @@ GkXmppClient::GkXmppClient(const GkUserConn &connection_details, QPointer<GekkoF
         //
         QObject::connect(m_xmppMamMgr.get(), SIGNAL(resultsRecieved(const QString &, const QXmppResultSetReply &, bool)),
                          this, SLOT(resultsReceived(const QString &, const QXmppResultSetReply &, bool)));
+        QObject::connect(m_xmppMamMgr.get(), SIGNAL(resultsRecieved(const QString &, const QXmppResultSetReply &, bool)),
+                         m_mamSync, SLOT(resultsReceived(const QString &, const QXmppResultSetReply &, bool)));
 
         //
         // Find the XMPP servers as defined by either the user themselves or GekkoFyre Networks...
@@ -362,6 +402,20 @@ GkXmppClient::GkXmppClient(const GkUserConn &connection_details, QPointer<GekkoF
                 default:
                     break;
             }
+
+            //
+            // The vCard is only requested again should the hash of the avatar advertised (XEP-0153) differ from that of
+            // the vCard already held...
+            const QString bareJid = QXmppUtils::jidToBareJid(presence.from());
+            if (presence.vCardUpdateType() == QXmppPresence::VCardUpdateValidPhoto || presence.vCardUpdateType() == QXmppPresence::VCardUpdateNoPhoto) {
+                if (m_rosterStore->contains(bareJid)) {
+                    m_vCardScheduler->requestIfChanged(bareJid, presence.photoHash());
+                }
+            } else if (presence.type() == QXmppPresence::Available) {
+                //
+                // Those who are online are shown within the roster, so their vCards are wanted before the rest
+                m_vCardScheduler->prioritize(bareJid);
+            }
         });
 
         //
@@ -373,6 +427,16 @@ GkXmppClient::GkXmppClient(const GkUserConn &connection_details, QPointer<GekkoF
         // connect as below...
         //
         QObject::connect(this, &QXmppClient::connected, this, [=]() {
+            if (streamManagementState() == QXmppClient::ResumedStream) {
+                //
+                // The server has kept hold of the session (XEP-0198), along with the roster, presences, carbons and any
+                // stanzas that had gone unacknowledged, so there is nothing that needs requesting again!
+                finishReconnect(true);
+                m_outbox->flush();
+
+                return;
+            }
+
             //
             // The service discovery manager is added to the client by default...
             if (m_discoMgr) {
@@ -400,12 +464,24 @@ GkXmppClient::GkXmppClient(const GkUserConn &connection_details, QPointer<GekkoF
             //
             // Enable carbon copies for this client!
             m_xmppCarbonMgr->setCarbonsEnabled(true);
-            QObject::connect(m_xmppCarbonMgr.get(), &QXmppCarbonManager::messageSent, this, &QXmppClient::messageReceived);
-            QObject::connect(m_xmppCarbonMgr.get(), &QXmppCarbonManager::messageReceived, this, &QXmppClient::messageReceived);
+            QObject::connect(m_xmppCarbonMgr.get(), &QXmppCarbonManager::messageSent, this, &QXmppClient::messageReceived, Qt::UniqueConnection);
+            QObject::connect(m_xmppCarbonMgr.get(), &QXmppCarbonManager::messageReceived, this, &QXmppClient::messageReceived, Qt::UniqueConnection);
+
+            //
+            // Send whatever messages were held back whilst disconnected, along with any that the server had yet to
+            // acknowledge, as they may well have been lost along with the old stream...
+            m_outbox->resend();
         });
 
         QObject::connect(this, &QXmppClient::disconnected, this, [=]() {
-            m_rosterList->clear(); // Clear the roster-list upon disconnection from given XMPP server!
+            m_mamSync->cancelAll();
+            m_pendingPages.clear();
+            if (!m_resumePending) {
+                //
+                // Clear the roster-list upon disconnection from given XMPP server, unless the stream is to be resumed!
+                m_rosterStore->clear();
+                m_vCardScheduler->clear();
+            }
         });
     } catch (const std::exception &e) {
         std::throw_with_nested(std::runtime_error(tr("An issue has occurred within the XMPP subsystem. Error: %1").arg(QString::fromStdString(e.what())).toStdString()));
@@ -416,10 +492,6 @@ GkXmppClient::GkXmppClient(const GkUserConn &connection_details, QPointer<GekkoF
 
 GkXmppClient::~GkXmppClient()
 {
-    if (m_archivedMsgsFineThread.joinable()) {
-        m_archivedMsgsFineThread.join();
-    }
-
     if (isConnected() || m_netState == GkNetworkState::Connecting) {
         killConnectionFromServer(false);
     }
@@ -666,13 +738,7 @@ GekkoFyre::Network::GkXmpp::GkNetworkState GkXmppClient::getNetworkState() const
  */
 bool GkXmppClient::isJidExist(const QString &bareJid)
 {
-    for (const auto &entry: *m_rosterList) {
-        if (entry.bareJid == bareJid) {
-            return true;
-        }
-    }
-
-    return false;
+    return m_rosterStore->contains(bareJid);
 }
 
 /**
@@ -683,26 +749,23 @@ bool GkXmppClient::isJidExist(const QString &bareJid)
  */
 bool GkXmppClient::isJidOnline(const QString &bareJid)
 {
-    for (const auto &entry: *m_rosterList) {
-        if (entry.bareJid == bareJid) {
-            switch (entry.presence->availableStatusType()) {
-                case QXmppPresence::Online:
-                    return true;
-                case QXmppPresence::Away:
-                    return true;
-                case QXmppPresence::XA:
-                    return true;
-                case QXmppPresence::DND:
-                    return true;
-                case QXmppPresence::Chat:
-                    return true;
-                case QXmppPresence::Invisible:
-                    return false;
-                default:
-                    return false;
-            }
-
-            break;
+    const auto entry = m_rosterStore->get(bareJid);
+    if (entry && entry->presence) {
+        switch (entry->presence->availableStatusType()) {
+            case QXmppPresence::Online:
+                return true;
+            case QXmppPresence::Away:
+                return true;
+            case QXmppPresence::XA:
+                return true;
+            case QXmppPresence::DND:
+                return true;
+            case QXmppPresence::Chat:
+                return true;
+            case QXmppPresence::Invisible:
+                return false;
+            default:
+                return false;
         }
     }
 
@@ -841,13 +904,24 @@ std::shared_ptr<QXmppRegistrationManager> GkXmppClient::getRegistrationMgr()
 }
 
 /**
- * @brief GkXmppClient::getRosterMap
+ * @brief GkXmppClient::getRosterStore
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @return
+ * @return The roster, as indexed by bareJid, including the client themselves.
  */
-std::shared_ptr<QList<GkXmppCallsign>> GkXmppClient::getRosterMap()
+QPointer<GkXmppRosterStore> GkXmppClient::getRosterStore()
 {
-    return m_rosterList;
+    return m_rosterStore;
+}
+
+/**
+ * @brief GkXmppClient::getVCardScheduler
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return Whatever schedules the vCard requests made towards the XMPP server, along with how many have been sent and
+ * skipped thus far.
+ */
+QPointer<GkXmppVCardScheduler> GkXmppClient::getVCardScheduler()
+{
+    return m_vCardScheduler;
 }
 
 /**
@@ -1019,26 +1093,17 @@ QString GkXmppClient::obtainAvatarFilePath(const QString &set_dir_path)
 }
 
 /**
- * @brief GkXmppClient::getArchivedMessagesBulk retrieves archived messages. For each received message, the
- * `m_xmppMamMgr->archivedMessageReceived()` signal is emitted. Once all messages are received, the `m_xmppMamMgr->resultsRecieved()`
- * signal is emitted. It returns a result set that can be used to page through the results. The number of results may
- * be limited by the server. This function in particular tries to receive all of the archived messages in question via
- * a bulk manner, grabbing what it can and as much of it as possible, quite unlike its cousin function which is much
- * more fine-tuned, GkXmppClient::getArchivedMessagesFine().
+ * @brief GkXmppClient::syncArchivedMessages synchronizes the message archive (XEP-0313) of the given bareJid, resuming
+ * from wherever it was last left at. For each received message, the `m_xmppMamMgr->archivedMessageReceived()` signal is
+ * emitted, and once each page of them has been received, the `m_xmppMamMgr->resultsRecieved()` signal is emitted.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param from
- * @see GkXmppClient::getArchivedMessagesFine().
+ * @param from The bareJid whose messages are to be synchronized.
+ * @see GkXmppMamSync::requestSync().
  */
-void GkXmppClient::getArchivedMessagesBulk(const QString &from)
+void GkXmppClient::syncArchivedMessages(const QString &from)
 {
     try {
-        QXmppResultSetQuery queryLimit;
-        queryLimit.setBefore("");
-        queryLimit.setMax(GK_XMPP_MAM_BACKLOG_BULK_FETCH_COUNT);
-
-        //
-        // Retrieve any archived messages from the given XMPP server as according to the specification, XEP-0313!
-        m_xmppMamMgr->retrieveArchivedMessages({}, {}, from, {}, QDateTime::currentDateTimeUtc(), queryLimit);
+        m_mamSync->requestSync(from, gkDb->read_xmpp_mam_last_id(from));
     } catch (const std::exception &e) {
         std::throw_with_nested(std::runtime_error(e.what()));
     }
@@ -1046,86 +1111,6 @@ void GkXmppClient::getArchivedMessagesBulk(const QString &from)
     return;
 }
 
-/**
- * @brief GkXmppClient::getArchivedMessagesFine retrieves archived messages. For each received message, the
- * `m_xmppMamMgr->archivedMessageReceived()` signal is emitted. Once all messages are received, the `m_xmppMamMgr->resultsRecieved()`
- * signal is emitted. It returns a result set that can be used to page through the results. The number of results may
- * be limited by the server. This function in particular tries to receive a particular set of the archived messages in
- * question via a filtered manner, grabbing what it via calculated QDateTime's, quite unlike its cousin function which is
- * more for grabbing a bulk amount of messages, GkXmppClient::getArchivedMessagesBulk().
- * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param recursion The amount of times this function has been recurisvely executed.
- * @param from The bareJid we are receiving from.
- * @see GkXmppClient::getArchivedMessagesBulk(), GkXmppMessageHandler::addToQueue()
- */
-void GkXmppClient::getArchivedMessagesFine(qint32 recursion, const QString &from)
-{
-    try {
-        QXmppResultSetQuery queryLimit;
-        queryLimit.setBefore("");
-        queryLimit.setMax(GK_XMPP_MAM_BACKLOG_FINE_FETCH_COUNT);
-        while (!m_msgRetrievalTimestamps.empty()) { // While more than '0' in GkXmppMessageHandler::addToQueue()!
-            //
-            // Retrieve any archived messages from the given XMPP server as according to the specification, XEP-0313!
-            m_xmppMamMgr->retrieveArchivedMessages({}, {}, from, m_msgRetrievalTimestamps.front(), QDateTime::currentDateTimeUtc(), queryLimit);
-            std::this_thread::sleep_for(std::chrono::milliseconds(GK_XMPP_MAM_THREAD_SLEEP_MILLISECS));
-        }
-
-        return;
-    } catch (const std:: exception &e) {
-        std::throw_with_nested(std::runtime_error(e.what()));
-    }
-
-    return;
-}
-
-/**
- * @brief GkXmppClient::filterIncomingResults filters incoming messages that are being processed as part of handling by
- * function, `GkXmppClient::resultsReceived()`, and assigning said messages to the proper roster with regard to the
- * class-wide variable, `m_rosterList`, from the QQueue-based message queue within the associated struct.
- * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param mam_msg_list
- */
-void GkXmppClient::filterIncomingResults(QXmppMessage message)
-{
-    try {
-        //
-        // This object does not currently exist in memory!
-        emit procXmppMsg(message, false);
-        emit sendXmppMsgToArchive(message, false);
-    } catch (const std::exception &e) {
-        gkEventLogger->publishEvent(QString::fromStdString(e.what()), GkSeverity::Fatal, "", false, true, false, true, false);
-    }
-
-    return;
-}
-
-/**
- * @brief GkXmppClient::insertArchiveMessage inserts a QXmppMessage stanza according to XMPP standard, XEP-0313, into the
- * class-wide variable, `m_rosterList`, but only after it has passed all the tests, including filters.
- * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param message The message stanza itself that is to be inserted into memory.
- * @param enqueue Whether the incoming message(s) should be added to a queue for further processing or not, or otherwise
- * be made ready as quickly as possible for displaying to the end-user. Please be aware of the context you are using this
- * parameter within.
- * @see GkXmppClient::archivedMessageReceived().
- */
-void GkXmppClient::insertArchiveMessage(const QXmppMessage &message, const bool &enqueue)
-{
-    try {
-        if (message.isXmppStanza() && !message.body().isEmpty()) {
-            emit procFirstPartyMsg(message, enqueue);
-            emit procThirdPartyMsg(message, enqueue);
-
-            return;
-        }
-    } catch (const std::exception &e) {
-        gkEventLogger->publishEvent(e.what(), GkSeverity::Fatal, "", false, true, false, true);
-    }
-
-    return;
-}
-
 /**
  * @brief GkXmppClient::processImgToByteArray processes a given image, or avatar in this case, into a QByteArray so that
  * it is readily usable by QXmppVCardManager().
@@ -1197,15 +1182,40 @@ void GkXmppClient::clientConnected()
     gkEventLogger->publishEvent(tr("A connection has been successfully made towards XMPP server: %1").arg(m_connDetails.server.url),
                                 GkSeverity::Info, "", true, true, true, false);
 
-    m_vCardManager->requestVCard(m_connDetails.jid);
-    GkXmpp::GkXmppCallsign client_callsign;
-    client_callsign.presence = std::make_shared<QXmppPresence>(statusToPresence(m_connDetails.status));
-    client_callsign.vCard.nickName() = m_connDetails.nickname;
-    client_callsign.server = m_connDetails.server;
-    client_callsign.bareJid = m_connDetails.jid;
-    client_callsign.msg_window_idx = GK_XMPP_MSG_WINDOW_CLIENT_SELF_TAB_IDX;
-    client_callsign.party = GkXmppParty::FirstParty;
-    m_rosterList->push_back(client_callsign);
+    if (streamManagementState() == QXmppClient::ResumedStream) {
+        return;
+    }
+
+    //
+    // Any vCards requested upon the previous stream are never going to arrive now
+    m_vCardScheduler->cancelAll();
+    if (m_resumePending) {
+        //
+        // The session could not be resumed, so the presences held from before the stream was lost can no longer be
+        // relied upon, whereas the roster itself is brought up to date once it has been received again
+        for (const auto &entry: m_rosterStore->snapshot()) {
+            if (entry->party == GkXmppParty::ThirdParty) {
+                m_rosterStore->update(entry->bareJid, GkXmppRosterStore::Presence, [](GkXmppCallsign &callsign) {
+                    callsign.presence = std::make_shared<QXmppPresence>(QXmppPresence::Type::Unavailable);
+                });
+            }
+        }
+    }
+
+    if (!m_rosterStore->contains(m_connDetails.jid)) {
+        GkXmpp::GkXmppCallsign client_callsign;
+        client_callsign.presence = std::make_shared<QXmppPresence>(statusToPresence(m_connDetails.status));
+        client_callsign.vCard.nickName() = m_connDetails.nickname;
+        client_callsign.server = m_connDetails.server;
+        client_callsign.bareJid = m_connDetails.jid;
+        client_callsign.msg_window_idx = GK_XMPP_MSG_WINDOW_CLIENT_SELF_TAB_IDX;
+        client_callsign.party = GkXmppParty::FirstParty;
+        m_rosterStore->insert(client_callsign);
+    }
+
+    if (!m_vCardScheduler->isHeld(m_connDetails.jid) && !loadCachedVCard(m_connDetails.jid)) {
+        m_vCardScheduler->request(m_connDetails.jid, GkXmppVCardScheduler::Visible);
+    }
 
     return;
 }
@@ -1219,6 +1229,23 @@ void GkXmppClient::clientConnected()
 void GkXmppClient::handleRosterReceived()
 {
     auto rosterBareJids = m_rosterManager->getRosterBareJids();
+
+    //
+    // Should the roster have been kept from before the stream was lost, then only the differences are applied towards
+    // it, with the bareJids no longer present being removed...
+    QSet<QString> received;
+    for (const auto &rawBareJid: rosterBareJids) {
+        received.insert(rawBareJid);
+    }
+
+    for (const auto &entry: m_rosterStore->snapshot()) {
+        if (entry->party == GkXmppParty::ThirdParty && !received.contains(entry->bareJid)) {
+            emit delJidFromRoster(entry->bareJid);
+            m_rosterStore->remove(entry->bareJid);
+            m_vCardScheduler->forget(entry->bareJid);
+        }
+    }
+
     if (!rosterBareJids.isEmpty()) {
         for (const auto &rawBareJid: rosterBareJids) {
             const auto jidItem = m_rosterManager->getRosterEntry(rawBareJid);
@@ -1236,16 +1263,33 @@ void GkXmppClient::handleRosterReceived()
                 case QXmppRosterIq::Item::Both:
                 case QXmppRosterIq::Item::To:
                 case QXmppRosterIq::Item::From:
-                    m_rosterList->push_back(callsign);
-                    m_vCardManager->requestVCard(callsign.bareJid);
+                    if (m_rosterStore->contains(callsign.bareJid)) {
+                        m_rosterStore->update(callsign.bareJid, GkXmppRosterStore::Subscription, [&callsign](GkXmppCallsign &entry) {
+                            entry.subStatus = callsign.subStatus;
+                        });
+                    } else {
+                        m_rosterStore->insert(callsign);
+                        emit addJidToRoster(callsign.bareJid);
+                    }
+
+                    //
+                    // The vCard saved from beforehand is used where there is one, and otherwise waits its turn to be
+                    // requested; either way, a newer one is only requested once a presence advertises a different
+                    // avatar (XEP-0153)
+                    if (!m_vCardScheduler->isHeld(callsign.bareJid) && !loadCachedVCard(callsign.bareJid)) {
+                        m_vCardScheduler->request(callsign.bareJid);
+                    }
+
                     emit retractSubscriptionRequest(callsign.bareJid);
-                    emit addJidToRoster(callsign.bareJid);
                     break;
                 case QXmppRosterIq::Item::Remove:
                     emit retractSubscriptionRequest(callsign.bareJid);
                     break;
                 case QXmppRosterIq::Item::NotSet:
-                    m_rosterList->push_back(callsign);
+                    if (!m_rosterStore->contains(callsign.bareJid)) {
+                        m_rosterStore->insert(callsign);
+                    }
+
                     notifyNewSubscription(callsign.bareJid);
                     break;
                 default:
@@ -1254,9 +1298,69 @@ void GkXmppClient::handleRosterReceived()
         }
     }
 
+    finishReconnect(false);
     return;
 }
 
+/**
+ * @brief GkXmppClient::loadCachedVCard reads in the vCard saved towards the filesystem for the given bareJid by
+ * GkXmppClient::vCardReceived(), so that it need not be requested again from the XMPP server upon each connection.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user whose vCard is to be read in.
+ * @return Whether a saved vCard was present, and is now held within the roster.
+ */
+bool GkXmppClient::loadCachedVCard(const QString &bareJid)
+{
+    try {
+        QFile xmlFile(QDir::toNativeSeparators(vcard_save_path.absolutePath() + "/" + gkStringFuncs->getXmppHostname(bareJid) + "/" +
+                                               gkStringFuncs->getXmppUsername(bareJid) + ".xml"));
+        if (!xmlFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            return false;
+        }
+
+        QDomDocument doc;
+        if (!doc.setContent(&xmlFile)) {
+            return false;
+        }
+
+        QXmppVCardIq vCard;
+        vCard.parse(doc.documentElement());
+        if (!m_rosterStore->update(bareJid, GkXmppRosterStore::VCard, [&vCard](GkXmppCallsign &entry) { entry.vCard = vCard; })) {
+            return false;
+        }
+
+        m_vCardScheduler->cached(bareJid, vCard.photo());
+        return true;
+    } catch (const std::exception &e) {
+        gkEventLogger->publishEvent(QString::fromStdString(e.what()), GkSeverity::Warning, "", false, true, false, true, false);
+    }
+
+    return false;
+}
+
+/**
+ * @brief GkXmppClient::isMucOccupantJid
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param jid The JID in question.
+ * @return Whether the given JID is that of an occupant within one of the MUCs that have been joined, being the bareJid
+ * of the MUC with the occupant's nickname as its resource.
+ */
+bool GkXmppClient::isMucOccupantJid(const QString &jid)
+{
+    if (!m_mucManager || QXmppUtils::jidToResource(jid).isEmpty()) {
+        return false;
+    }
+
+    const QString roomJid = QXmppUtils::jidToBareJid(jid);
+    for (const auto &room: m_mucManager->rooms()) {
+        if (room && room->jid() == roomJid) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /**
  * @brief GkXmppClient::vCardReceived processes and saves vCards for users saved/added within the user's roster for the
  * given XMPP server in question. Avatars are also saved in conjunction with the vCard, being part of the vCard itself.
@@ -1270,62 +1374,31 @@ void GkXmppClient::vCardReceived(const QXmppVCardIq &vCard)
         gkEventLogger->publishEvent(tr("vCard received for user, \"%1\"").arg(bareJid), GkSeverity::Debug,
                                     "", false, true, false, false);
 
-        QFileInfo imgFileName = QDir::toNativeSeparators(vcard_save_path.absolutePath() + "/" +
-                                                                 gkStringFuncs->getXmppHostname(bareJid) + "/" +
-                                                         gkStringFuncs->getXmppUsername(bareJid) + ".png");
-        QFileInfo xmlFileName = QDir::toNativeSeparators(vcard_save_path.absolutePath() + "/" +
-                                                                 gkStringFuncs->getXmppHostname(bareJid) + "/" +
-                                                         gkStringFuncs->getXmppUsername(bareJid) + ".xml");
-
-        if (!QDir(xmlFileName.absolutePath()).exists()) {
+        if (isMucOccupantJid(bareJid)) {
             //
-            // The host sub-folder does not exist!
-            if (!QDir().mkdir(xmlFileName.absolutePath())) {
-                throw std::runtime_error(tr("An error was encountered with creating directory, \"%1\"!")
-                .arg(xmlFileName.absolutePath()).toStdString());
-            }
-        }
-
-        QFile xmlFile(xmlFileName.filePath());
-        if (!xmlFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            // Only ever requested for the avatars shown within the occupant list of a MUC, and not kept any further
+            m_vCardScheduler->received(bareJid, vCard.photo());
+            emit sendMucOccupantVCard(bareJid, vCard.photo());
             return;
         }
 
-        QXmlStreamWriter stream(&xmlFile);
-        vCard.toXml(&stream);
-        xmlFile.commitTransaction();
-        emit sendUserVCard(vCard);
-        xmlFile.close();
-
-        gkEventLogger->publishEvent(tr("vCard XML data saved to filesystem for user, \"%1\"").arg(bareJid),
-                                    GkSeverity::Debug, "", false, true, false, false);
-
-        const QString img_file_path = imgFileName.absoluteFilePath();
-        QByteArray photo = vCard.photo();
-        for (auto iter = m_rosterList->begin(); iter != m_rosterList->end(); ++iter) {
-            if (iter->bareJid == bareJid) {
-                iter->vCard = vCard;
-                break;
-            }
-        }
+        m_vCardScheduler->received(bareJid.isEmpty() ? m_connDetails.jid : QXmppUtils::jidToBareJid(bareJid), vCard.photo());
+        m_rosterStore->update(bareJid, GkXmppRosterStore::VCard, [&vCard](GkXmppCallsign &entry) {
+            entry.vCard = vCard;
+        });
 
-        if (!photo.isNull() && !photo.isEmpty()) {
-            QImage image;
-            image.loadFromData(photo, vCard.photoType().toStdString().c_str());
-            QImageWriter image_save(img_file_path);
-            if (image_save.write(image)) {
-                gkEventLogger->publishEvent(tr("vCard avatar saved to filesystem for user, \"%1\"").arg(bareJid),
-                                            GkSeverity::Debug, "", false, true, false, false);
-                if (imgFileName.baseName() == gkStringFuncs->getXmppUsername(m_connDetails.jid)) {
-                    emit refreshDisplayedClientAvatar(photo);
-                }
+        emit sendUserVCard(vCard);
 
-                return;
-            } else {
-                throw std::runtime_error(tr("Error encountered with saving image data for file, \"%1\"!")
-                .arg(img_file_path).toStdString());
-            }
-        }
+        //
+        // Saving the vCard and decoding its avatar are left towards GkXmppStanzaWorker, away from the GUI thread
+        const QString savePath = QDir::toNativeSeparators(vcard_save_path.absolutePath() + "/" + gkStringFuncs->getXmppHostname(bareJid) + "/" +
+                                                          gkStringFuncs->getXmppUsername(bareJid));
+        const QString xmlFilePath = savePath + ".xml";
+        const QString imgFilePath = savePath + ".png";
+        const auto stanzaWorker = m_stanzaWorker.get();
+        QMetaObject::invokeMethod(stanzaWorker, [stanzaWorker, vCard, bareJid, xmlFilePath, imgFilePath]() {
+            stanzaWorker->processVCard(vCard, bareJid, xmlFilePath, imgFilePath);
+        }, Qt::QueuedConnection);
     } catch (const std::exception &e) {
         gkEventLogger->publishEvent(QString::fromStdString(e.what()), GkSeverity::Fatal, "", false, true, false, true, false);
     }
@@ -1370,12 +1443,9 @@ void GkXmppClient::clientVCardReceived()
         // Read/write out avatar information!
         if (imgFileLoc.absoluteDir().exists() && imgFileLoc.absoluteDir().isReadable()) {
             QByteArray photo = m_clientVCard.photo();
-            for (auto iter = m_rosterList->begin(); iter != m_rosterList->end(); ++iter) {
-                if (iter->bareJid == m_connDetails.jid) {
-                    iter->vCard = m_clientVCard;
-                    break;
-                }
-            }
+            m_rosterStore->update(m_connDetails.jid, GkXmppRosterStore::VCard, [this](GkXmppCallsign &entry) {
+                entry.vCard = m_clientVCard;
+            });
 
             if (!photo.isNull()) {
                 if (!photo.isEmpty()) {
@@ -1430,14 +1500,11 @@ void GkXmppClient::updateClientVCard(const QXmppVCardIq &vCard)
 void GkXmppClient::presenceChanged(const QString &bareJid, const QString &resource)
 {
     try {
-        for (auto iter = m_rosterList->begin(); iter != m_rosterList->end(); ++iter) {
-            if (iter->bareJid == bareJid) {
-                iter->presence = std::make_shared<QXmppPresence>(m_rosterManager->getPresence(bareJid, resource));
-                emit updateProgressBar((4 / GK_XMPP_CREATE_CONN_PROG_BAR_TOT_PERCT) * 100);
-                gkEventLogger->publishEvent(tr("Presence changed for user, \"%1\", towards: %2")
-                                                    .arg(bareJid).arg(resource));
-                break;
-            }
+        auto presence = std::make_shared<QXmppPresence>(m_rosterManager->getPresence(bareJid, resource));
+        if (m_rosterStore->update(bareJid, GkXmppRosterStore::Presence, [&presence](GkXmppCallsign &entry) { entry.presence = std::move(presence); })) {
+            emit updateProgressBar((4 / GK_XMPP_CREATE_CONN_PROG_BAR_TOT_PERCT) * 100);
+            gkEventLogger->publishEvent(tr("Presence changed for user, \"%1\", towards: %2")
+                                                .arg(bareJid).arg(resource));
         }
     } catch (const std::exception &e) {
         std::throw_with_nested(std::runtime_error(e.what()));
@@ -1454,15 +1521,15 @@ void GkXmppClient::presenceChanged(const QString &bareJid, const QString &resour
 void GkXmppClient::modifyPresence(const QXmppPresence::Type &pres)
 {
     try {
-        for (auto iter = m_rosterList->begin(); iter != m_rosterList->end(); ++iter) {
-            if (iter->bareJid == m_connDetails.jid && iter->party == GkXmppParty::FirstParty) {
-                m_presence->setType(pres);
-                iter->presence.reset();
-                iter->presence = std::make_shared<QXmppPresence>(pres);
-
-                gkEventLogger->publishEvent(tr("You have successfully changed your presence status towards: %1"), GkSeverity::Info, "",
-                                            true, true, false, false);
-            }
+        const auto entry = m_rosterStore->get(m_connDetails.jid);
+        if (entry && entry->party == GkXmppParty::FirstParty) {
+            m_presence->setType(pres);
+            m_rosterStore->update(m_connDetails.jid, GkXmppRosterStore::Presence, [&pres](GkXmppCallsign &callsign) {
+                callsign.presence = std::make_shared<QXmppPresence>(pres);
+            });
+
+            gkEventLogger->publishEvent(tr("You have successfully changed your presence status towards: %1"), GkSeverity::Info, "",
+                                        true, true, false, false);
         }
     } catch (const std::exception &e) {
         std::throw_with_nested(std::runtime_error(e.what()));
@@ -1479,11 +1546,10 @@ void GkXmppClient::modifyPresence(const QXmppPresence::Type &pres)
  */
 std::shared_ptr<QXmppPresence> GkXmppClient::getPresence(const QString &bareJid)
 {
-    if (!bareJid.isEmpty() && !m_rosterList->isEmpty()) {
-        for (const auto &entry: *m_rosterList) {
-            if (bareJid == entry.bareJid && entry.party == GkXmppParty::ThirdParty) {
-                return entry.presence;
-            }
+    if (!bareJid.isEmpty()) {
+        const auto entry = m_rosterStore->get(bareJid);
+        if (entry && entry->party == GkXmppParty::ThirdParty) {
+            return entry->presence;
         }
     }
 
@@ -1518,7 +1584,7 @@ void GkXmppClient::modifyAvailableStatusType(const QXmppPresence::AvailableStatu
 void GkXmppClient::acceptSubscriptionRequest(const QString &bareJid)
 {
     m_rosterManager->acceptSubscription(bareJid);
-    m_vCardManager->requestVCard(bareJid);
+    m_vCardScheduler->request(bareJid, GkXmppVCardScheduler::Visible);
     gkEventLogger->publishEvent(tr("Invite request has successfully been processed for user, \"%1\"").arg(bareJid),
                                 GkSeverity::Info, "", true, true, false, false);
 
@@ -1684,24 +1750,26 @@ void GkXmppClient::updateClientVCardForm(const QString &first_name, const QStrin
 
 /**
  * @brief GkXmppClient::sendXmppMsg is a utility function to send messages to all the resources associated with the specified
- * bareJid(s) within the contained QXmppMessage stanza.
+ * bareJid(s) within the contained QXmppMessage stanza. The message is queued within the outbox, which sends it along
+ * with any others queued at the same time, or otherwise once connected again should there be no connection right now.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
  * @param msg The QXmppMessage to process and ultimately, transmit.
+ * @return Whether the message was queued within the outbox.
+ * @see GkXmppOutbox::enqueue().
  */
-void GkXmppClient::sendXmppMsg(const QXmppMessage &msg)
+bool GkXmppClient::sendXmppMsg(const QXmppMessage &msg)
 {
     if (msg.isXmppStanza()) {
-        std::lock_guard<std::mutex> lck_guard(m_archivedMsgsFineMtx);
-        const bool msg_sent_succ = sendPacket(msg);
-        if (msg_sent_succ) {
-            const auto curr_timestamp = QDateTime::currentDateTimeUtc();
-            m_msgRetrievalTimestamps.emplace(curr_timestamp);
-            m_archivedMsgsFineThread = std::thread(&GkXmppClient::getArchivedMessagesFine, this, 0, msg.to());
-            m_archivedMsgsFineThread.detach();
+        if (!m_outbox->enqueue(msg)) {
+            gkEventLogger->publishEvent(tr("Unable to send message towards, \"%1\"; too many messages are already waiting!").arg(msg.to()),
+                                        GkSeverity::Warning, "", false, true, false, true, false);
+            return false;
         }
+
+        return true;
     }
 
-    return;
+    return false;
 }
 
 /**
@@ -1789,6 +1857,22 @@ void GkXmppClient::handleSuccess()
  */
 void GkXmppClient::handleError(QXmppClient::Error errorMsg)
 {
+    //
+    // Should an established stream be lost to the network, then it is left for QXmppClient to reconnect and resume the
+    // stream (XEP-0198), rather than tearing everything down only to log in and request everything again from scratch!
+    const bool resumable = configuration().autoReconnectionEnabled() && (m_netState != GkNetworkState::Connecting || m_resumePending);
+    if (resumable && (errorMsg == QXmppClient::Error::SocketError || errorMsg == QXmppClient::Error::KeepAliveError)) {
+        if (!m_resumePending) {
+            m_resumePending = true;
+            m_reconnectBytes = 0;
+            m_reconnectTimer.start();
+        }
+
+        gkEventLogger->publishEvent(tr("The connection towards XMPP server, \"%1\", has been lost; attempting to resume it...")
+                                    .arg(m_connDetails.server.url), GkSeverity::Warning, "", true, true, false, true, false);
+        return;
+    }
+
     switch (errorMsg) {
         case QXmppClient::Error::NoError:
             break;
@@ -2072,6 +2156,44 @@ void GkXmppClient::killConnectionFromServer(const bool &askReconnectPolicy)
     disconnectFromServer();
     m_netState = GkNetworkState::Disconnected;
 
+    if (m_resumePending) {
+        //
+        // The stream is no longer going to be resumed, so whatever was kept for it goes too
+        m_resumePending = false;
+        m_reconnectTimer.invalidate();
+        m_rosterStore->clear();
+        m_vCardScheduler->clear();
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppClient::finishReconnect logs how long it took to reconnect towards the XMPP server, and how much was
+ * exchanged with it in doing so, once the stream has either been resumed or the roster received upon a new one.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param resumed Whether the stream was resumed (XEP-0198), rather than a new one having been made.
+ */
+void GkXmppClient::finishReconnect(const bool &resumed)
+{
+    if (!m_resumePending) {
+        return;
+    }
+
+    if (resumed) {
+        gkEventLogger->publishEvent(tr("Stream towards XMPP server, \"%1\", resumed within %2 ms, with %3 bytes exchanged.")
+                                    .arg(m_connDetails.server.url).arg(QString::number(m_reconnectTimer.elapsed())).arg(QString::number(m_reconnectBytes)),
+                                    GkSeverity::Info, "", false, true, false, false);
+    } else {
+        gkEventLogger->publishEvent(tr("Reconnected towards XMPP server, \"%1\", upon a new stream within %2 ms, with %3 bytes exchanged.")
+                                    .arg(m_connDetails.server.url).arg(QString::number(m_reconnectTimer.elapsed())).arg(QString::number(m_reconnectBytes)),
+                                    GkSeverity::Info, "", false, true, false, false);
+    }
+
+    m_resumePending = false;
+    m_reconnectTimer.invalidate();
+    m_reconnectBytes = 0;
+
     return;
 }
 
@@ -2135,7 +2257,13 @@ void GkXmppClient::notifyNewSubscription(const QString &bareJid, const QXmppPres
             callsign.subStatus = QXmppRosterIq::Item::SubscriptionType::NotSet; // TODO: Change this so it is set dynamically, and therefore can handle more possible situations!
             callsign.msg_window_idx = GK_XMPP_MSG_WINDOW_UNSET_TAB_IDX;
             callsign.party = GkXmppParty::ThirdParty;
-            m_rosterList->push_back(callsign);
+            if (!m_rosterStore->update(bareJid, GkXmppRosterStore::Presence | GkXmppRosterStore::Subscription, [&callsign](GkXmppCallsign &entry) {
+                entry.presence = callsign.presence;
+                entry.subStatus = callsign.subStatus;
+            })) {
+                m_rosterStore->insert(callsign);
+            }
+
             if (!presence.statusText().isEmpty()) {
                 emit sendSubscriptionRequest(bareJid, presence.statusText());
             } else {
@@ -2304,22 +2432,18 @@ void GkXmppClient::recvXmppMsgUpdate(const QXmppMessage &message)
 void GkXmppClient::archiveListReceived(const QList<QXmppArchiveChat> &chats, const QXmppResultSetReply &rsmReply)
 {
     for (const auto &chat: chats) {
-        for (auto iter = m_rosterList->begin(); iter != m_rosterList->end(); ++iter) {
-            if (iter->bareJid == chat.with()) {
-                QList<GkXmppArchiveMsg> msg_struct_list;
-                for (const auto &message: chat.messages()) {
-                    GkXmppArchiveMsg arch_msg;
-                    arch_msg.message = message;
-                    arch_msg.presented = false;
-                    msg_struct_list.push_back(arch_msg);
-                }
-
-                if (!msg_struct_list.isEmpty()) {
-                    std::copy(msg_struct_list.begin(), msg_struct_list.end(), std::back_inserter(iter->archive_messages));
-                }
+        QList<GkXmppArchiveMsg> msg_struct_list;
+        for (const auto &message: chat.messages()) {
+            GkXmppArchiveMsg arch_msg;
+            arch_msg.message = message;
+            arch_msg.presented = false;
+            msg_struct_list.push_back(arch_msg);
+        }
 
-                break;
-            }
+        if (!msg_struct_list.isEmpty()) {
+            m_rosterStore->update(chat.with(), GkXmppRosterStore::Messages, [&msg_struct_list](GkXmppCallsign &entry) {
+                std::copy(msg_struct_list.begin(), msg_struct_list.end(), std::back_inserter(entry.archive_messages));
+            });
         }
     }
 
@@ -2336,22 +2460,18 @@ void GkXmppClient::archiveListReceived(const QList<QXmppArchiveChat> &chats, con
  */
 void GkXmppClient::archiveChatReceived(const QXmppArchiveChat &chat, const QXmppResultSetReply &rsmReply)
 {
-    for (auto iter = m_rosterList->begin(); iter != m_rosterList->end(); ++iter) {
-        if (iter->bareJid == chat.with()) {
-            QList<GkXmppArchiveMsg> arch_msg_list;
-            for (const auto &message: chat.messages()) {
-                GkXmppArchiveMsg arch_msg;
-                arch_msg.message = message;
-                arch_msg.presented = false;
-                arch_msg_list.push_back(arch_msg);
-            }
-
-            if (!arch_msg_list.isEmpty()) {
-                std::copy(arch_msg_list.begin(), arch_msg_list.end(), std::back_inserter(iter->archive_messages));
-            }
+    QList<GkXmppArchiveMsg> arch_msg_list;
+    for (const auto &message: chat.messages()) {
+        GkXmppArchiveMsg arch_msg;
+        arch_msg.message = message;
+        arch_msg.presented = false;
+        arch_msg_list.push_back(arch_msg);
+    }
 
-            break;
-        }
+    if (!arch_msg_list.isEmpty()) {
+        m_rosterStore->update(chat.with(), GkXmppRosterStore::Messages, [&arch_msg_list](GkXmppCallsign &entry) {
+            std::copy(arch_msg_list.begin(), arch_msg_list.end(), std::back_inserter(entry.archive_messages));
+        });
     }
 
     emit updateMsgHistory();
@@ -2359,73 +2479,93 @@ void GkXmppClient::archiveChatReceived(const QXmppArchiveChat &chat, const QXmpp
 }
 
 /**
- * @brief GkXmppClient::handleFirstPartyMsg processes the handling of first-party messages.
+ * @brief GkXmppClient::archivedMessageReceived is a signal that's emitted when an archived message is received. The
+ * message is merely held onto until the rest of its page has arrived, whereupon the page is processed in full by
+ * GkXmppStanzaWorker rather than upon the GUI thread.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param message The message stanza to handle/process.
- * @param enqueue Whether the incoming message(s) should be added to a queue for further processing or not, or otherwise
- * be made ready as quickly as possible for displaying to the end-user. Please be aware of the context you are using this
- * parameter within.
+ * @param queryId The query that the message has been received for.
+ * @param message The message stanza itself.
+ * @see GkXmppClient::syncArchivedMessages(), GkXmppClient::resultsReceived().
  */
-void GkXmppClient::handleFirstPartyMsg(const QXmppMessage &message, const bool &enqueue)
+void GkXmppClient::archivedMessageReceived(const QString &queryId, const QXmppMessage &message)
 {
-    try {
-        if (message.isXmppStanza() && !message.body().isEmpty()) {
-            //
-            // Messages that have been received towards/from the first-party!
-            for (auto iter = m_rosterList->begin(); iter != m_rosterList->end(); ++iter) {
-                if (iter->bareJid == m_connDetails.jid && iter->party == GkXmppParty::FirstParty) {
-                    if (m_connDetails.jid == message.to() || m_connDetails.jid == getJidNickname(message.from())) {
-                        GkXmppMamMsg mam_msg;
-                        mam_msg.message = message;
-                        mam_msg.presented = false;
-                        mam_msg.party = GkXmppParty::FirstParty;
-                        if (enqueue) {
-                            iter->msg_queue.enqueue(mam_msg);
-                            break;
-                        }
+    QElapsedTimer timer;
+    timer.start();
 
-                        iter->messages.push_back(mam_msg);
-                        break;
-                    }
-                }
-            }
-        }
-    } catch (const std::exception &e) {
-        gkEventLogger->publishEvent(e.what(), GkSeverity::Fatal, "", false, true, false, true);
+    m_pendingPages[queryId].push_back(message);
+    ++m_stanzaGuiCount;
+
+    m_stanzaGuiNsecs += timer.nsecsElapsed();
+    return;
+}
+
+/**
+ * @brief GkXmppClient::resultsReceived is a signal that's emitted when all results for a request have been received.
+ * The page is then handed towards GkXmppStanzaWorker as a whole.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param queryId The query that the page has been received for.
+ * @param resultSetReply
+ * @param complete
+ * @see GkXmppClient::applyArchivedBatch().
+ */
+void GkXmppClient::resultsReceived(const QString &queryId, const QXmppResultSetReply &resultSetReply, bool complete)
+{
+    Q_UNUSED(resultSetReply);
+    Q_UNUSED(complete);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const auto page = m_pendingPages.take(queryId);
+    if (!page.isEmpty()) {
+        const auto stanzaWorker = m_stanzaWorker.get();
+        QMetaObject::invokeMethod(stanzaWorker, [stanzaWorker, queryId, page]() {
+            stanzaWorker->processArchivedPage(queryId, page);
+        }, Qt::QueuedConnection);
     }
 
+    m_stanzaGuiNsecs += timer.nsecsElapsed();
     return;
 }
 
 /**
- * @brief GkXmppClient::handleThirdPartyMsg processes the handling of third-party messages.
+ * @brief GkXmppClient::applyArchivedBatch takes a page of archived messages that has been processed by
+ * GkXmppStanzaWorker, and already written towards the chat transcripts, and hands it towards the roster and the chat
+ * windows, with but the one update for each bareJid and chat.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param message The message stanza to handle/process.
- * @param enqueue Whether the incoming message(s) should be added to a queue for further processing or not, or otherwise
- * be made ready as quickly as possible for displaying to the end-user. Please be aware of the context you are using this
- * parameter within.
+ * @param batch The processed page of archived messages.
+ * @see GkXmppStanzaWorker::processArchivedPage().
  */
-void GkXmppClient::handleThirdPartyMsg(const QXmppMessage &message, const bool &enqueue)
+void GkXmppClient::applyArchivedBatch(const GkXmppMamBatch &batch)
 {
     try {
-        if (message.isXmppStanza() && !message.body().isEmpty()) {
-            //
-            // Messages that have been sent towards/from the third-party!
-            for (auto iter = m_rosterList->begin(); iter != m_rosterList->end(); ++iter) {
-                if ((iter->bareJid == message.to() || iter->bareJid == getJidNickname(message.from())) && iter->party == GkXmppParty::ThirdParty) {
-                    GkXmppMamMsg mam_msg;
-                    mam_msg.message = message;
-                    mam_msg.presented = false;
-                    mam_msg.party = GkXmppParty::ThirdParty;
-                    if (enqueue) {
-                        iter->msg_queue.enqueue(mam_msg);
-                        break;
-                    }
+        QElapsedTimer timer;
+        timer.start();
 
-                    iter->messages.push_back(mam_msg);
-                    break;
-                }
-            }
+        for (auto iter = batch.messages.constBegin(); iter != batch.messages.constEnd(); ++iter) {
+            const auto &mam_msgs = iter.value();
+            m_rosterStore->update(iter.key(), GkXmppRosterStore::Messages, [&mam_msgs](GkXmppCallsign &callsign) {
+                callsign.messages.append(mam_msgs);
+            });
+        }
+
+        for (auto iter = batch.transcripts.constBegin(); iter != batch.transcripts.constEnd(); ++iter) {
+            emit procXmppMsgBatch(iter.key(), iter.value());
+        }
+
+        //
+        // Tell the program that receiving of all (applicable) messages from the archives of the given XMPP server has been
+        // accomplished and is (hopefully) successful!
+        emit msgArchiveSuccReceived();
+
+        m_stanzaGuiNsecs += timer.nsecsElapsed();
+        if (m_stanzaGuiCount >= GK_XMPP_STANZA_TIMING_INTERVAL) {
+            const double msecs = (static_cast<double>(m_stanzaGuiNsecs) / 1000000.0) * GK_XMPP_STANZA_TIMING_INTERVAL / m_stanzaGuiCount;
+            gkEventLogger->publishEvent(tr("The GUI thread spent %1 ms upon every %2 archived messages received.")
+                                                .arg(QString::number(msecs, 'f', 2)).arg(QString::number(GK_XMPP_STANZA_TIMING_INTERVAL)),
+                                        GkSeverity::Debug, "", false, true, false, false);
+            m_stanzaGuiNsecs = 0;
+            m_stanzaGuiCount = 0;
         }
     } catch (const std::exception &e) {
         gkEventLogger->publishEvent(e.what(), GkSeverity::Fatal, "", false, true, false, true);
@@ -2435,80 +2575,124 @@ void GkXmppClient::handleThirdPartyMsg(const QXmppMessage &message, const bool &
 }
 
 /**
- * @brief GkXmppClient::archivedMessageReceived is a signal that's emitted when an archived message is received. Inserts
- * QXmppMessage stanzas into the class-wide variable, `m_rosterList`, if applicable.
+ * @brief GkXmppClient::handleSavedVCard is executed once GkXmppStanzaWorker has saved a vCard towards the filesystem.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param queryId Unknown.
- * @param message The message stanza itself that the comparison is either to be made against and/or to be inserted into
- * memory via the class-wide variable, `m_rosterList`.
- * @see GkXmppClient::getArchivedMessagesBulk(), GkXmppClient::getArchivedMessagesFine(), GkXmppClient::filterArchivedMessage()
+ * @param bareJid Whom the vCard belongs towards.
+ * @param photo The avatar within the vCard, if any.
+ * @see GkXmppStanzaWorker::processVCard().
  */
-void GkXmppClient::archivedMessageReceived(const QString &queryId, const QXmppMessage &message)
+void GkXmppClient::handleSavedVCard(const QString &bareJid, const QByteArray &photo)
 {
-    Q_UNUSED(queryId);
-    emit sendXmppMsgToArchive(message, true);
+    gkEventLogger->publishEvent(tr("vCard saved to filesystem for user, \"%1\"").arg(bareJid),
+                                GkSeverity::Debug, "", false, true, false, false);
+    if ((bareJid.isEmpty() || QXmppUtils::jidToBareJid(bareJid) == m_connDetails.jid) && !photo.isEmpty()) {
+        emit refreshDisplayedClientAvatar(photo);
+    }
 
     return;
 }
 
 /**
- * @brief GkXmppClient::resultsReceived is a signal that's emitted when all results for a request have been received.
+ * @brief GkXmppClient::handleStanzaWorkerError logs whatever errors GkXmppStanzaWorker has come across, as it may not
+ * do so itself from outside of the GUI thread.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param queryId
- * @param resultSetReply
- * @param complete
+ * @param error The error in question.
  */
-void GkXmppClient::resultsReceived(const QString &queryId, const QXmppResultSetReply &resultSetReply, bool complete)
+void GkXmppClient::handleStanzaWorkerError(const QString &error)
 {
-    Q_UNUSED(queryId);
-    Q_UNUSED(resultSetReply);
-    Q_UNUSED(complete);
+    gkEventLogger->publishEvent(error, GkSeverity::Fatal, "", false, true, false, true, false);
+    return;
+}
 
-    try {
-        if (!m_rosterList->isEmpty()) {
-            for (auto roster = m_rosterList->begin(); roster != m_rosterList->end();) {
-                const auto queue = roster->msg_queue;
-                if (!queue.isEmpty()) {
-                    const qint32 target = queue.size();
-                    for (qint32 i = 0; i < queue.size(); ++i) {
-                        if (queue[i].message.isXmppStanza() && !queue[i].message.id().isEmpty() && !queue[i].message.body().isEmpty()) {
-                            emit sendIncomingResults(queue[i].message); // This object does not exist in memory yet!
-                            if (i + 1 == queue.size()) {
-                                roster->msg_queue.clear();
-                                ++roster;
-                                break;
-                            }
-                        }
-                    }
+/**
+ * @brief GkXmppClient::handleSentMsg synchronizes the message archive of the recipient once a message has first been
+ * sent towards them, so that it shows up within the chat window along with the rest of the conversation.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The recipient of the message.
+ * @param id The stanza ID of the message.
+ */
+void GkXmppClient::handleSentMsg(const QString &bareJid, const QString &id)
+{
+    Q_UNUSED(id);
 
-                    //
-                    // Tell the program that receiving of all (applicable) messages from the archives of the given XMPP server has been
-                    // accomplished and is (hopefully) successful!
-                    emit msgArchiveSuccReceived();
-                    return;
-                } else {
-                    break;
-                }
-            }
+    syncArchivedMessages(bareJid);
+    return;
+}
+
+/**
+ * @brief GkXmppClient::handleFailedMsg
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The recipient of the message.
+ * @param id The stanza ID of the message.
+ */
+void GkXmppClient::handleFailedMsg(const QString &bareJid, const QString &id)
+{
+    Q_UNUSED(id);
+
+    gkEventLogger->publishEvent(tr("A message towards, \"%1\", could not be confirmed as delivered and has been given up on!").arg(bareJid),
+                                GkSeverity::Warning, "", false, true, false, true, false);
+    return;
+}
+
+/**
+ * @brief GkXmppClient::saveMamLastId records where the synchronization of the given bareJid's message archive has got
+ * up to, so that it may be resumed from there.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user in question.
+ * @param archiveId The archive ID of the newest message synchronized thus far.
+ */
+void GkXmppClient::saveMamLastId(const QString &bareJid, const QString &archiveId)
+{
+    gkDb->write_xmpp_mam_last_id(bareJid, archiveId);
+    return;
+}
+
+/**
+ * @brief GkXmppClient::indexRosterEntry (re-)indexes the given bareJid within the search index, by its username, server
+ * and nickname(s), so that the roster may be searched by any of them.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user in question.
+ */
+void GkXmppClient::indexRosterEntry(const QString &bareJid)
+{
+    try {
+        const auto entry = m_rosterStore->get(bareJid);
+        const auto searchIndex = gkDb->getSearchIndex();
+        if (!entry || !searchIndex) {
+            return;
         }
+
+        //
+        // The bareJid is given in parts as well, as the Unicode word-breaking rules would otherwise keep it as a single word
+        const QString text = QStringList({ bareJid, QXmppUtils::jidToUser(bareJid), QXmppUtils::jidToDomain(bareJid),
+                                           entry->vCard.nickName(), entry->vCard.fullName() }).join(QChar(' '));
+
+        leveldb::WriteBatch batch;
+        searchIndex->removeDocument(batch, General::Xmpp::GoogleLevelDb::searchCollectionRoster, bareJid);
+        searchIndex->indexDocument(batch, General::Xmpp::GoogleLevelDb::searchCollectionRoster, bareJid,
+                                   QDateTime::currentDateTimeUtc(), text);
+        searchIndex->write(batch);
     } catch (const std::exception &e) {
-        gkEventLogger->publishEvent(e.what(), GkSeverity::Fatal, "", false, true, false, true);
+        gkEventLogger->publishEvent(QString::fromStdString(e.what()), GkSeverity::Warning, "", false, true, false, true, false);
     }
 
     return;
 }
 
 /**
- * @brief GkXmppClient::updateQueues
+ * @brief GkXmppClient::unindexRosterEntry
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param msg The QXmppMessage stanza itself to be inserted into the QTableView model, GekkoFyre::GkXmppRecvMsgsTableViewModel().
- * @param wipeExistingHistory Whether to wipe the pre-existing chat history or not, specifically from the given QTableView
- * object, GekkoFyre::GkXmppRecvMsgsTableViewModel().
+ * @param bareJid The user who has been removed from the roster.
  */
-void GkXmppClient::updateQueues(const QXmppMessage &msg, const bool &wipeExistingHistory)
+void GkXmppClient::unindexRosterEntry(const QString &bareJid)
 {
-    if (!m_msgRetrievalTimestamps.empty()) {
-        m_msgRetrievalTimestamps.pop();
+    try {
+        const auto searchIndex = gkDb->getSearchIndex();
+        if (searchIndex) {
+            searchIndex->removeDocument(General::Xmpp::GoogleLevelDb::searchCollectionRoster, bareJid);
+        }
+    } catch (const std::exception &e) {
+        gkEventLogger->publishEvent(QString::fromStdString(e.what()), GkSeverity::Warning, "", false, true, false, true, false);
     }
 
     return;
@@ -48,6 +48,11 @@
 #include "src/gk_system.hpp"
 #include "src/gk_string_funcs.hpp"
 #include "src/models/system/gk_network_ping_model.hpp"
+#include "src/models/xmpp/gk_xmpp_mam_sync.hpp"
+#include "src/models/xmpp/gk_xmpp_roster_store.hpp"
+#include "src/models/xmpp/gk_xmpp_stanza_worker.hpp"
+#include "src/models/xmpp/gk_xmpp_outbox.hpp"
+#include "src/models/xmpp/gk_xmpp_vcard_scheduler.hpp"
 #include <qxmpp/QXmppIq.h>
 #include <qxmpp/QXmppStanza.h>
 #include <qxmpp/QXmppGlobal.h>
@@ -68,6 +73,7 @@
 #include <qxmpp/QXmppRosterManager.h>
 #include <qxmpp/QXmppArchiveManager.h>
 #include <qxmpp/QXmppVersionManager.h>
+#include <qxmpp/QXmppMessageReceiptManager.h>
 #include <qxmpp/QXmppTransferManager.h>
 #include <qxmpp/QXmppClientExtension.h>
 #include <qxmpp/QXmppDiscoveryManager.h>
@@ -137,7 +143,8 @@ public:
     //
     // User, roster and presence details
     [[nodiscard]] std::shared_ptr<QXmppRegistrationManager> getRegistrationMgr();
-    [[nodiscard]] std::shared_ptr<QList<GekkoFyre::Network::GkXmpp::GkXmppCallsign>> getRosterMap();
+    [[nodiscard]] QPointer<GekkoFyre::GkXmppRosterStore> getRosterStore();
+    [[nodiscard]] QPointer<GekkoFyre::GkXmppVCardScheduler> getVCardScheduler();
     [[nodiscard]] QXmppPresence statusToPresence(const Network::GkXmpp::GkOnlineStatus &status);
     [[nodiscard]] Network::GkXmpp::GkOnlineStatus presenceToStatus(const QXmppPresence::AvailableStatusType &xmppPresence);
     [[nodiscard]] QString presenceToString(const QXmppPresence::AvailableStatusType &xmppPresence);
@@ -179,7 +186,7 @@ public slots:
 
     //
     // QXmppMamManager handling
-    void getArchivedMessagesBulk(const QString &from = QString());
+    void syncArchivedMessages(const QString &from);
 
     //
     // QXmppMucManager
@@ -189,7 +196,7 @@ public slots:
 
     //
     // Message handling
-    void sendXmppMsg(const QXmppMessage &msg);
+    bool sendXmppMsg(const QXmppMessage &msg);
 
 private slots:
     //
@@ -228,16 +235,28 @@ private slots:
     void recvXmppMsgUpdate(const QXmppMessage &message);
     void archiveListReceived(const QList<QXmppArchiveChat> &chats, const QXmppResultSetReply &rsmReply);
     void archiveChatReceived(const QXmppArchiveChat &chat, const QXmppResultSetReply &rsmReply);
-    void handleFirstPartyMsg(const QXmppMessage &message, const bool &enqueue = true);
-    void handleThirdPartyMsg(const QXmppMessage &message, const bool &enqueue = true);
-    void filterIncomingResults(QXmppMessage message);
-    void insertArchiveMessage(const QXmppMessage &message, const bool &enqueue = true);
 
     //
     // QXmppMamManager handling
     void archivedMessageReceived(const QString &queryId, const QXmppMessage &message);
     void resultsReceived(const QString &queryId, const QXmppResultSetReply &resultSetReply, bool complete);
-    void updateQueues(const QXmppMessage &msg, const bool &wipeExistingHistory = false);
+    void saveMamLastId(const QString &bareJid, const QString &archiveId);
+
+    //
+    // Results from GkXmppStanzaWorker
+    void applyArchivedBatch(const GekkoFyre::Network::GkXmpp::GkXmppMamBatch &batch);
+    void handleSavedVCard(const QString &bareJid, const QByteArray &photo);
+    void handleStanzaWorkerError(const QString &error);
+
+    //
+    // Results from GkXmppOutbox
+    void handleSentMsg(const QString &bareJid, const QString &id);
+    void handleFailedMsg(const QString &bareJid, const QString &id);
+
+    //
+    // Full-text search
+    void indexRosterEntry(const QString &bareJid);
+    void unindexRosterEntry(const QString &bareJid);
 
 signals:
     //
@@ -260,6 +279,7 @@ signals:
     void sendClientVCard(const QXmppVCardIq &vCard);
     void savedClientVCard(const QByteArray &avatar_pic, const QString &img_type);
     void sendUserVCard(const QXmppVCardIq &vCard);
+    void sendMucOccupantVCard(const QString &jid, const QByteArray &photo);
     void refreshDisplayedClientAvatar(const QByteArray &ba_img);
 
     //
@@ -272,16 +292,12 @@ signals:
     // Message handling and QXmppArchiveManager-related
     void xmppMsgUpdate(const QXmppMessage &message);
     void updateMsgHistory();
-    void sendIncomingResults(QXmppMessage message);
 
     //
     // Message handling and QXmppMamManager handling
     void msgArchiveSuccReceived();
-    void procXmppMsg(const QXmppMessage &msg, const bool &wipeExistingHistory = false);
+    void procXmppMsgBatch(const QString &chatJid, const QList<GekkoFyre::Network::GkXmpp::GkRecvMsgsTableViewModel> &messages);
     void msgRecved(const QDateTime &timestamp);
-    void procFirstPartyMsg(const QXmppMessage &message, const bool &enqueue = true);
-    void procThirdPartyMsg(const QXmppMessage &message, const bool &enqueue = true);
-    void sendXmppMsgToArchive(const QXmppMessage &message, const bool &enqueue = true);
 
     //
     // MUCs
@@ -310,6 +326,8 @@ private:
     // Timers and Event Loops
     //
     std::unique_ptr<QElapsedTimer> m_dnsKeepAlive;
+    QElapsedTimer m_reconnectTimer;                                                 // How long it has taken to reconnect, since the stream was lost.
+    qint64 m_reconnectBytes;                                                        // The bytes exchanged with the XMPP server whilst reconnecting.
 
     //
     // User, roster and presence details
@@ -318,7 +336,7 @@ private:
     std::shared_ptr<QXmppPresence> m_presence;
     std::shared_ptr<QXmppRosterManager> m_rosterManager;
     QVector<QString> m_blockList;
-    std::shared_ptr<QList<GekkoFyre::Network::GkXmpp::GkXmppCallsign>> m_rosterList;   // A list of all the bareJids, including the client themselves!
+    QPointer<GekkoFyre::GkXmppRosterStore> m_rosterStore;                            // All the bareJids, including the client themselves, indexed by bareJid!
     std::shared_ptr<QList<GekkoFyre::Network::GkXmpp::GkXmppMuc>> m_mucList;
 
     //
@@ -335,36 +353,37 @@ private:
     // Queue's relating to XMPP
     //
     std::queue<QXmppPresence::AvailableStatusType> m_availStatusTypeQueue;
-    std::queue<QDateTime> m_msgRetrievalTimestamps;
-
-    //
-    // Message handling
-    void getArchivedMessagesFine(qint32 recursion, const QString &from = QString());
-
-    //
-    // Multithreading, mutexes, etc.
-    //
-    std::mutex m_archivedMsgsFineMtx;
-    std::mutex m_archivedMsgsBulkMtx;
-    std::thread m_archivedMsgsFineThread;
+    QPointer<GekkoFyre::GkXmppOutbox> m_outbox;                                      // Outgoing messages, spooled until delivered.
 
     //
     // QXmpp and XMPP related
     //
     QXmppConfiguration config;
     bool m_askToReconnectAuto;
+    bool m_resumePending;                                                           // Whether the stream was lost to a network error, and is to be resumed (XEP-0198).
     bool m_sslIsEnabled;
     bool m_isMuc;
     std::shared_ptr<QXmppRegistrationManager> m_registerManager;
     std::unique_ptr<QXmppMucManager> m_mucManager;
     std::unique_ptr<QXmppArchiveManager> m_xmppArchiveMgr;
     std::unique_ptr<QXmppMamManager> m_xmppMamMgr;
+    QPointer<GekkoFyre::GkXmppMamSync> m_mamSync;
+    QHash<QString, QList<QXmppMessage>> m_pendingPages;                              // Archived messages yet to be handed towards GkXmppStanzaWorker, keyed by query ID.
+    std::unique_ptr<GekkoFyre::GkXmppStanzaWorker> m_stanzaWorker;                   // Processes archived messages and vCards away from the GUI thread.
+    qint64 m_stanzaGuiNsecs;                                                         // The time spent upon archived stanzas by the GUI thread, since last logged.
+    qint32 m_stanzaGuiCount;                                                         // The archived stanzas received, since the above was last logged.
     std::unique_ptr<QXmppTransferManager> m_transferManager;
     std::unique_ptr<QXmppVCardManager> m_vCardManager;
+    QPointer<GekkoFyre::GkXmppVCardScheduler> m_vCardScheduler;
     std::unique_ptr<QXmppCarbonManager> m_xmppCarbonMgr;
+    std::unique_ptr<QXmppMessageReceiptManager> m_receiptMgr;
     QScopedPointer<QXmppLogger> m_xmppLogger;
 
     GekkoFyre::Network::GkXmpp::GkNetworkState m_netState;
 
+    bool loadCachedVCard(const QString &bareJid);
+    bool isMucOccupantJid(const QString &jid);
+    void finishReconnect(const bool &resumed);
+
 };
 };
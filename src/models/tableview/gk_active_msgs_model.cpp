@@ -73,6 +73,7 @@ GkActiveMsgsTableViewModel::GkActiveMsgsTableViewModel(QPointer<GkLevelDb> datab
     proxyModel = new QSortFilterProxyModel(parent);
 
     table->setModel(proxyModel);
+    table->horizontalHeader()->setSectionResizeMode(GK_ACTIVE_MSGS_TABLEVIEW_MODEL_MSG_IDX, QHeaderView::Stretch);
     layout->addWidget(table);
     proxyModel->setSourceModel(this);
 
@@ -91,54 +92,60 @@ GkActiveMsgsTableViewModel::~GkActiveMsgsTableViewModel()
 /**
  * @brief GkActiveMsgsTableViewModel::populateData
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param event_logs
+ * @param decodes The decoded messages to be shown, replacing any that are already.
  */
-void GkActiveMsgsTableViewModel::populateData(const QList<GkEventLogging> &event_logs)
+void GkActiveMsgsTableViewModel::populateData(const QList<GkFtxDecode> &decodes)
 {
+    dataBatchMutex.lock();
+
+    beginResetModel();
+    m_data = decodes;
+    endResetModel();
+
+    dataBatchMutex.unlock();
     return;
 }
 
 /**
- * @brief GkActiveMsgsTableViewModel::insertData
+ * @brief GkActiveMsgsTableViewModel::insertData appends every message decoded from a slot at once, removing the oldest
+ * should there then be more than GK_ACTIVE_MSGS_TABLEVIEW_MODEL_MAX_ROWS.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param event
+ * @param decodes The messages decoded from a single slot.
  */
-void GkActiveMsgsTableViewModel::insertData(const GkEventLogging &event)
+void GkActiveMsgsTableViewModel::insertData(const QList<GkFtxDecode> &decodes)
 {
+    if (decodes.isEmpty()) {
+        return;
+    }
+
     dataBatchMutex.lock();
 
-    beginInsertRows(QModelIndex(), m_data.count(), m_data.count());
-    m_data.append(event);
+    beginInsertRows(QModelIndex(), m_data.count(), m_data.count() + decodes.count() - 1);
+    m_data.append(decodes);
     endInsertRows();
 
-    auto top = this->createIndex((m_data.count() - 1), 0, nullptr);
-    auto bottom = this->createIndex((m_data.count() - 1), GK_ACTIVE_MSGS_TABLEVIEW_MODEL_TOTAL_IDX, nullptr);
-    emit dataChanged(top, bottom);
+    const int excess = m_data.count() - GK_ACTIVE_MSGS_TABLEVIEW_MODEL_MAX_ROWS;
+    if (excess > 0) {
+        beginRemoveRows(QModelIndex(), 0, excess - 1);
+        m_data.erase(m_data.begin(), m_data.begin() + excess);
+        endRemoveRows();
+    }
 
     dataBatchMutex.unlock();
     return;
 }
 
 /**
- * @brief GkActiveMsgsTableViewModel::removeData
+ * @brief GkActiveMsgsTableViewModel::clearData
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param event
  */
-void GkActiveMsgsTableViewModel::removeData(const GkEventLogging &event)
+void GkActiveMsgsTableViewModel::clearData()
 {
     dataBatchMutex.lock();
 
-    for (int i = 0; i < m_data.size(); ++i) {
-        if (m_data[i].event_no == event.event_no) {
-            beginRemoveRows(QModelIndex(), (m_data.count() - 1), (m_data.count() - 1));
-            m_data.removeAt(i); // Remove any occurrence of this value, one at a time!
-            endRemoveRows();
-        }
-    }
-
-    auto top = this->createIndex((m_data.count() - 1), 0, nullptr);
-    auto bottom = this->createIndex((m_data.count() - 1), GK_ACTIVE_MSGS_TABLEVIEW_MODEL_TOTAL_IDX, nullptr);
-    emit dataChanged(top, bottom);
+    beginResetModel();
+    m_data.clear();
+    endResetModel();
 
     dataBatchMutex.unlock();
     return;
@@ -183,6 +190,20 @@ QVariant GkActiveMsgsTableViewModel::data(const QModelIndex &index, int role) co
         return QVariant();
     }
 
+    const GkFtxDecode &decode = m_data[index.row()];
+    switch (index.column()) {
+        case GK_ACTIVE_MSGS_TABLEVIEW_MODEL_OFFSET_IDX:
+            return QString::number(decode.freq_hz, 'f', 0);
+        case GK_ACTIVE_MSGS_TABLEVIEW_MODEL_DATETIME_IDX:
+            return decode.slot_start.toString("yyyy-MM-dd hh:mm:ss");
+        case GK_ACTIVE_MSGS_TABLEVIEW_MODEL_AGE_IDX:
+            return tr("%1 s").arg(QString::number(decode.slot_start.secsTo(QDateTime::currentDateTimeUtc())));
+        case GK_ACTIVE_MSGS_TABLEVIEW_MODEL_SNR_IDX:
+            return decode.snr_db;
+        case GK_ACTIVE_MSGS_TABLEVIEW_MODEL_MSG_IDX:
+            return decode.message;
+    }
+
     return QVariant();
 }
 
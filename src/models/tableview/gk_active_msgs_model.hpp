@@ -74,7 +74,7 @@ public:
     explicit GkActiveMsgsTableViewModel(QPointer<GekkoFyre::GkLevelDb> database, QWidget *parent = nullptr);
     ~GkActiveMsgsTableViewModel() override;
 
-    void populateData(const QList<GekkoFyre::System::Events::Logging::GkEventLogging> &event_logs);
+    void populateData(const QList<GekkoFyre::AmateurRadio::GkFtxDecode> &decodes);
     [[nodiscard]] int rowCount(const QModelIndex &parent = QModelIndex()) const Q_DECL_OVERRIDE;
     [[nodiscard]] int columnCount(const QModelIndex &parent = QModelIndex()) const Q_DECL_OVERRIDE;
 
@@ -82,12 +82,12 @@ public:
     [[nodiscard]] QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const Q_DECL_OVERRIDE;
 
 public slots:
-    void insertData(const GekkoFyre::System::Events::Logging::GkEventLogging &event);
-    void removeData(const GekkoFyre::System::Events::Logging::GkEventLogging &event);
+    void insertData(const QList<GekkoFyre::AmateurRadio::GkFtxDecode> &decodes);
+    void clearData();
 
 private:
     QPointer<GekkoFyre::GkLevelDb> gkDb;
-    QList<GekkoFyre::System::Events::Logging::GkEventLogging> m_data;
+    QList<GekkoFyre::AmateurRadio::GkFtxDecode> m_data;
 
     QPointer<QSortFilterProxyModel> proxyModel;
     QPointer<QTableView> table;
@@ -41,8 +41,10 @@
 
 #include "src/models/tableview/gk_xmpp_recv_msgs_model.hpp"
 #include <utility>
+#include <algorithm>
 #include <QVBoxLayout>
 #include <QHeaderView>
+#include <QScrollBar>
 
 using namespace GekkoFyre;
 using namespace GkAudioFramework;
@@ -58,19 +60,46 @@ using namespace Logging;
 using namespace Network;
 using namespace GkXmpp;
 
+namespace {
+//
+// Orders the messages by their timestamps, and then those of the same timestamp by where they are kept within the
+// chat transcript, so as to match the order that they are read back in
+bool isOlderMsg(const GkRecvMsgsTableViewModel &a, const GkRecvMsgsTableViewModel &b)
+{
+    if (a.timestamp != b.timestamp) {
+        return a.timestamp < b.timestamp;
+    }
+
+    return a.transcriptKey < b.transcriptKey;
+}
+}
+
 /**
  * @brief GkXmppRecvMsgsTableViewModel::GkXmppRecvMsgsTableViewModel
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param database
+ * @param tableView The QTableView that this model is shown within, and which older messages are fetched for upon being
+ * scrolled towards the top.
+ * @param xmppClient The XMPP client, from which the nicknames of each bareJid are looked up.
  * @param parent
  */
 GkXmppRecvMsgsTableViewModel::GkXmppRecvMsgsTableViewModel(QPointer<QTableView> tableView,
                                                            QPointer<GekkoFyre::GkXmppClient> xmppClient,
-                                                           QWidget *parent) : QAbstractTableModel(parent)
+                                                           QWidget *parent) : QAbstractTableModel(parent), m_atNewest(true), m_atOldest(true), m_searching(false)
 {
     setParent(parent);
+    table = std::move(tableView);
     m_xmppClient = std::move(xmppClient);
 
+    if (table) {
+        //
+        // Each step of the scrollbar is then a single row, so that the same messages may be kept within view whilst
+        // older ones are inserted above them. The connection is queued as the scrollbar may move whilst rows are
+        // being inserted or removed.
+        table->setVerticalScrollMode(QAbstractItemView::ScrollPerItem);
+        QObject::connect(table->verticalScrollBar(), SIGNAL(valueChanged(int)),
+                         this, SLOT(prefetchOlder(int)), Qt::QueuedConnection);
+    }
+
     return;
 }
 
@@ -98,50 +127,313 @@ void GkXmppRecvMsgsTableViewModel::populateData(const QList<GkRecvMsgsTableViewM
 }
 
 /**
- * @brief GkXmppRecvMsgsTableViewModel::insertData
+ * @brief GkXmppRecvMsgsTableViewModel::setTranscript keeps every message of this chat within the given chat transcript
+ * from here on, of which only a window of no more than GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_MAX_ROWS messages is held in
+ * memory, starting with the newest GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_PAGE_SIZE of them. Older messages are then read in
+ * as the QTableView is scrolled towards the top, and newer ones as it is scrolled back down again.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param database The Google LevelDB database that the chat transcript is kept within.
+ * @param chatJid The bareJid of the chat.
+ */
+void GkXmppRecvMsgsTableViewModel::setTranscript(QPointer<GkLevelDb> database, const QString &chatJid)
+{
+    try {
+        removeData();
+
+        std::lock_guard<std::mutex> lock_guard(m_dataBatchMutex);
+        gkDb = std::move(database);
+        m_transcriptJid = chatJid;
+        m_atNewest = true;
+        m_atOldest = true;
+        m_searching = false;
+
+        if (gkDb && !m_transcriptJid.isEmpty()) {
+            auto messages = gkDb->read_xmpp_transcript(m_transcriptJid, QString(), true, GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_PAGE_SIZE);
+            m_atOldest = messages.count() < GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_PAGE_SIZE;
+            if (!messages.isEmpty()) {
+                for (auto &recvMsg: messages) {
+                    recvMsg.nickName = getNickname(recvMsg.bareJid);
+                }
+
+                beginInsertRows(QModelIndex(), 0, messages.count() - 1);
+                m_data = messages;
+                endInsertRows();
+            }
+        }
+
+        if (table) {
+            table->scrollToBottom();
+        }
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppRecvMsgsTableViewModel::showSearchResults shows the given messages, such as those found by
+ * GkLevelDb::search_xmpp_transcript(), in place of the window onto the chat transcript until
+ * GkXmppRecvMsgsTableViewModel::setTranscript() is called again. Any new messages are still written towards the chat
+ * transcript in the meantime.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param messages The messages to be shown, in any order.
+ */
+void GkXmppRecvMsgsTableViewModel::showSearchResults(const QList<GkRecvMsgsTableViewModel> &messages)
+{
+    try {
+        removeData();
+
+        QList<GkRecvMsgsTableViewModel> sorted = messages;
+        std::stable_sort(sorted.begin(), sorted.end(), isOlderMsg);
+        for (auto &recvMsg: sorted) {
+            recvMsg.nickName = getNickname(recvMsg.bareJid);
+        }
+
+        std::lock_guard<std::mutex> lock_guard(m_dataBatchMutex);
+        m_searching = true;
+        m_atNewest = false;
+        m_atOldest = false;
+        if (!sorted.isEmpty()) {
+            beginInsertRows(QModelIndex(), 0, sorted.count() - 1);
+            m_data = sorted;
+            endInsertRows();
+        }
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppRecvMsgsTableViewModel::fetchOlder reads the next page of older messages from the chat transcript, and
+ * inserts them above those already present with a single beginInsertRows(). Should there then be too many messages held,
+ * the newest are evicted.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The amount of rows inserted at the top.
+ * @see GkXmppRecvMsgsTableViewModel::setTranscript().
+ */
+qint32 GkXmppRecvMsgsTableViewModel::fetchOlder()
+{
+    try {
+        std::lock_guard<std::mutex> lock_guard(m_dataBatchMutex);
+        if (!gkDb || m_transcriptJid.isEmpty() || m_searching) {
+            return 0;
+        }
+
+        const QString cursor = m_data.isEmpty() ? QString() : m_data.first().transcriptKey;
+        auto messages = gkDb->read_xmpp_transcript(m_transcriptJid, cursor, true, GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_PAGE_SIZE);
+        const qint32 counter = messages.count();
+        if (counter < GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_PAGE_SIZE) {
+            m_atOldest = true;
+        }
+
+        if (counter == 0) {
+            return 0;
+        }
+
+        for (auto &recvMsg: messages) {
+            recvMsg.nickName = getNickname(recvMsg.bareJid);
+        }
+
+        beginInsertRows(QModelIndex(), 0, counter - 1);
+        messages.append(m_data);
+        m_data.swap(messages);
+        endInsertRows();
+
+        evictRows(false);
+        return counter;
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return 0;
+}
+
+/**
+ * @brief GkXmppRecvMsgsTableViewModel::fetchNewer reads the next page of newer messages from the chat transcript, such
+ * as once older messages have been scrolled through and the newest since evicted, and appends them with a single
+ * beginInsertRows(). Should there then be too many messages held, the oldest are evicted.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The amount of rows appended at the bottom.
+ * @see GkXmppRecvMsgsTableViewModel::setTranscript().
+ */
+qint32 GkXmppRecvMsgsTableViewModel::fetchNewer()
+{
+    try {
+        std::lock_guard<std::mutex> lock_guard(m_dataBatchMutex);
+        if (!gkDb || m_transcriptJid.isEmpty() || m_atNewest || m_searching || m_data.isEmpty()) {
+            return 0;
+        }
+
+        auto messages = gkDb->read_xmpp_transcript(m_transcriptJid, m_data.last().transcriptKey, false, GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_PAGE_SIZE);
+        const qint32 counter = messages.count();
+        if (counter < GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_PAGE_SIZE) {
+            m_atNewest = true;
+        }
+
+        if (counter == 0) {
+            return 0;
+        }
+
+        for (auto &recvMsg: messages) {
+            recvMsg.nickName = getNickname(recvMsg.bareJid);
+        }
+
+        beginInsertRows(QModelIndex(), m_data.count(), m_data.count() + counter - 1);
+        m_data.append(messages);
+        endInsertRows();
+
+        evictRows(true);
+        return counter;
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return 0;
+}
+
+/**
+ * @brief GkXmppRecvMsgsTableViewModel::canFetchMore is asked by the QTableView once it has been scrolled to the bottom.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param parent
+ * @return Whether there are newer messages within the chat transcript than those held.
+ */
+bool GkXmppRecvMsgsTableViewModel::canFetchMore(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+
+    return !gkDb.isNull() && !m_transcriptJid.isEmpty() && !m_atNewest && !m_searching;
+}
+
+/**
+ * @brief GkXmppRecvMsgsTableViewModel::fetchMore
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param parent
+ * @see GkXmppRecvMsgsTableViewModel::fetchNewer().
+ */
+void GkXmppRecvMsgsTableViewModel::fetchMore(const QModelIndex &parent)
+{
+    Q_UNUSED(parent);
+    fetchNewer();
+
+    return;
+}
+
+/**
+ * @brief GkXmppRecvMsgsTableViewModel::insertData inserts the given message where it belongs by its timestamp, found via
+ * a binary search. Should there be a chat transcript, the message is written towards it as well, but only inserted into
+ * the QTableView should it fall within the window of messages currently held, or be older than all of them whilst the
+ * window holds the whole of the transcript.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
  * @param bareJid The identity of the user, as it should appear on the XMPP server.
  * @param msg The message data to be inserted.
  * @param timestamp The date/time to be inserted.
- * @param doNotAddToTable As the variable name suggests, do not make any modifications to the QTableView itself. Only
- * modify `m_data` instead.
  */
 void GkXmppRecvMsgsTableViewModel::insertData(const QString &bareJid, const QString &msg, const QDateTime &timestamp)
 {
     try {
+        GkRecvMsgsTableViewModel recvMsg;
+        recvMsg.timestamp = timestamp;
+        recvMsg.bareJid = bareJid;
+        recvMsg.message = msg;
+        recvMsg.nickName = getNickname(recvMsg.bareJid);
+
         std::lock_guard<std::mutex> lock_guard(m_dataBatchMutex);
-        qint32 idx = -1;
-        if (!m_data.isEmpty()) {
+        if (gkDb && !m_transcriptJid.isEmpty()) {
+            recvMsg.transcriptKey = gkDb->convXmppTranscriptKey(m_transcriptJid, recvMsg);
+            gkDb->write_xmpp_transcript(m_transcriptJid, { recvMsg });
+
             //
-            // Find the nearest timestamp to the one provided!
-            const auto comp_timestamp = m_xmppClient->compareTimestamps(std::vector<GkRecvMsgsTableViewModel>(m_data.begin(), m_data.end()),
-                                                                        timestamp.toMSecsSinceEpoch());
-            for (qint32 i = 0; i < m_data.size(); ++i) {
-                if (m_data.at(i).timestamp.toMSecsSinceEpoch() == comp_timestamp) {
-                    idx = i;
+            // Messages outside of the window are read from the chat transcript once scrolled towards instead, which a
+            // chat too short to even have a scrollbar never will be
+            if (!m_atNewest || (!m_data.isEmpty() && isOlderMsg(recvMsg, m_data.first()) && !holdsOldest())) {
+                return;
+            }
+        }
+
+        insertMsg(recvMsg);
+        evictRows(true);
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppRecvMsgsTableViewModel::insertData inserts many messages at once, such as those retrieved from the
+ * archives of the given XMPP server. Should they all be newer than what is already present, which is the usual case, they
+ * are appended with a single beginInsertRows() rather than one for each message. Should there be a chat transcript, they
+ * are all written towards it in one batch, but only the newest window of them is inserted into the QTableView, along with
+ * any older than those held whilst the window holds the whole of the transcript.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param messages The messages to be inserted, in any order.
+ * @param transcribed Whether the messages have already been written towards the chat transcript, such as by
+ * GkXmppStanzaWorker, and so need not be written again.
+ */
+void GkXmppRecvMsgsTableViewModel::insertData(const QList<GkRecvMsgsTableViewModel> &messages, const bool &transcribed)
+{
+    try {
+        if (messages.isEmpty()) {
+            return;
+        }
+
+        QList<GkRecvMsgsTableViewModel> sorted = messages;
+        std::lock_guard<std::mutex> lock_guard(m_dataBatchMutex);
+        if (gkDb && !m_transcriptJid.isEmpty()) {
+            if (!transcribed) {
+                for (auto &recvMsg: sorted) {
+                    recvMsg.transcriptKey = gkDb->convXmppTranscriptKey(m_transcriptJid, recvMsg);
                 }
+
+                gkDb->write_xmpp_transcript(m_transcriptJid, sorted);
+            }
+
+            if (!m_atNewest) {
+                return;
+            }
+
+            if (m_data.isEmpty()) {
+                //
+                // Just the newest page, as the remainder are read from the chat transcript once scrolled towards
+                sorted = gkDb->read_xmpp_transcript(m_transcriptJid, QString(), true, GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_PAGE_SIZE);
+                m_atOldest = sorted.count() < GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_PAGE_SIZE;
+            } else if (!holdsOldest()) {
+                const auto oldest = m_data.first();
+                sorted.erase(std::remove_if(sorted.begin(), sorted.end(), [&oldest](const GkRecvMsgsTableViewModel &recvMsg) {
+                    return isOlderMsg(recvMsg, oldest);
+                }), sorted.end());
             }
         }
 
-        GkRecvMsgsTableViewModel recvMsg;
-        recvMsg.timestamp = timestamp;
-        recvMsg.bareJid = bareJid;
-        recvMsg.message = msg;
-        recvMsg.nickName = m_xmppClient->getJidNickname(recvMsg.bareJid);
+        std::stable_sort(sorted.begin(), sorted.end(), isOlderMsg);
+        if (sorted.count() > GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_MAX_ROWS) {
+            sorted.erase(sorted.begin(), sorted.end() - GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_MAX_ROWS);
+        }
 
-        //
-        // Insert the data into the QTableView itself!
-        beginInsertRows(QModelIndex(), m_data.count(), m_data.count());
-        if (!m_data.isEmpty() && idx >= 0) {
-            m_data.insert(m_data.begin() + idx, recvMsg);
+        if (sorted.isEmpty()) {
+            return;
+        }
+
+        for (auto &recvMsg: sorted) {
+            recvMsg.nickName = getNickname(recvMsg.bareJid);
+        }
+
+        if (m_data.isEmpty() || isOlderMsg(m_data.last(), sorted.first())) {
+            beginInsertRows(QModelIndex(), m_data.count(), m_data.count() + sorted.count() - 1);
+            m_data.append(sorted);
+            endInsertRows();
         } else {
-            m_data.push_back(recvMsg);
+            //
+            // Some of the messages are older than those already present, so each must find its own place amongst them
+            for (const auto &recvMsg: sorted) {
+                insertMsg(recvMsg);
+            }
         }
 
-        endInsertRows();
-        auto top = this->createIndex((m_data.count() + 1), 0, nullptr);
-        auto bottom = this->createIndex((m_data.count() + 1), GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_TOTAL_IDX, nullptr);
-        emit dataChanged(top, bottom);
+        evictRows(true);
     } catch (const std::exception &e) {
         std::throw_with_nested(std::runtime_error(e.what()));
     }
@@ -158,23 +450,14 @@ qint32 GkXmppRecvMsgsTableViewModel::removeData()
 {
     try {
         std::lock_guard<std::mutex> lock_guard(m_dataBatchMutex);
+        m_atNewest = true;
+        m_atOldest = true;
+        m_searching = false;
         if (!m_data.isEmpty()) {
-            qint32 counter = 0;
-            qint32 data_size = m_data.count();
-            for (auto iter = m_data.begin(); iter != m_data.end(); ++iter) {
-                ++counter;
-                beginRemoveRows(QModelIndex(), (m_data.count() - 1), (m_data.count() - 1));
-                iter = m_data.erase(iter);
-                endRemoveRows();
-
-                if (data_size == counter) {
-                    break;
-                }
-            }
-
-            auto top = this->createIndex((m_data.count() - counter), 0, nullptr);
-            auto bottom = this->createIndex((m_data.count() - counter), GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_TOTAL_IDX, nullptr);
-            emit dataChanged(top, bottom);
+            const qint32 counter = m_data.count();
+            beginRemoveRows(QModelIndex(), 0, counter - 1);
+            m_data.clear();
+            endRemoveRows();
 
             return counter;
         }
@@ -198,20 +481,16 @@ qint32 GkXmppRecvMsgsTableViewModel::removeData(const QDateTime &timestamp, cons
         std::lock_guard<std::mutex> lock_guard(m_dataBatchMutex);
         if (!m_data.isEmpty()) {
             qint32 counter = 0;
-            for (auto iter = m_data.begin(); iter != m_data.end(); ++iter) {
+            for (qint32 row = 0; row < m_data.count(); ++row) {
                 ++counter;
-                if (iter->timestamp == timestamp && iter->bareJid == bareJid) {
-                    beginRemoveRows(QModelIndex(), (m_data.count() - 1), (m_data.count() - 1));
-                    iter = m_data.erase(iter);
+                if (m_data.at(row).timestamp == timestamp && m_data.at(row).bareJid == bareJid) {
+                    beginRemoveRows(QModelIndex(), row, row);
+                    m_data.removeAt(row);
                     endRemoveRows();
                     break;
                 }
             }
 
-            auto top = this->createIndex((m_data.count() - 1), 0, nullptr);
-            auto bottom = this->createIndex((m_data.count() - 1), GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_TOTAL_IDX, nullptr);
-            emit dataChanged(top, bottom);
-
             return counter;
         }
     } catch (const std::exception &e) {
@@ -221,6 +500,115 @@ qint32 GkXmppRecvMsgsTableViewModel::removeData(const QDateTime &timestamp, cons
     return 0;
 }
 
+/**
+ * @brief GkXmppRecvMsgsTableViewModel::prefetchOlder reads in older messages from the chat transcript once the QTableView
+ * has been scrolled to within GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_PREFETCH_ROWS of the top, so that they are there before
+ * the top is reached, and then scrolls down past them so that the same messages remain within view.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param value The position of the vertical scrollbar at the time it was moved.
+ */
+void GkXmppRecvMsgsTableViewModel::prefetchOlder(int value)
+{
+    Q_UNUSED(value);
+
+    if (!table || m_data.isEmpty()) {
+        return;
+    }
+
+    //
+    // The scrollbar may well have moved again since, as the connection is a queued one
+    QPointer<QScrollBar> scrollBar = table->verticalScrollBar();
+    const qint32 position = scrollBar->value();
+    if (position > GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_PREFETCH_ROWS) {
+        return;
+    }
+
+    const qint32 inserted = fetchOlder();
+    if (inserted > 0) {
+        scrollBar->setValue(position + inserted);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppRecvMsgsTableViewModel::getNickname
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user in question.
+ * @return The nickname of the given bareJid, or the bareJid itself should there be no XMPP client to look it up with.
+ */
+QString GkXmppRecvMsgsTableViewModel::getNickname(const QString &bareJid) const
+{
+    if (!m_xmppClient) {
+        return bareJid;
+    }
+
+    return m_xmppClient->getJidNickname(bareJid);
+}
+
+/**
+ * @brief GkXmppRecvMsgsTableViewModel::insertMsg inserts the given message after any others of the same or an older
+ * timestamp, by way of a binary search, unless it is already present. The data must already be locked.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param recvMsg The message to be inserted.
+ */
+void GkXmppRecvMsgsTableViewModel::insertMsg(const GkRecvMsgsTableViewModel &recvMsg)
+{
+    const auto iter = std::upper_bound(m_data.begin(), m_data.end(), recvMsg, isOlderMsg);
+    const qint32 row = static_cast<qint32>(std::distance(m_data.begin(), iter));
+    if (row > 0 && !recvMsg.transcriptKey.isEmpty() && m_data.at(row - 1).transcriptKey == recvMsg.transcriptKey) {
+        return; // Already present, such as upon being re-synchronized from the XMPP server!
+    }
+
+    beginInsertRows(QModelIndex(), row, row);
+    m_data.insert(row, recvMsg);
+    endInsertRows();
+
+    return;
+}
+
+/**
+ * @brief GkXmppRecvMsgsTableViewModel::evictRows keeps no more than GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_MAX_ROWS messages
+ * held at once, removing the excess with a single beginRemoveRows(). Those evicted may be read back from the chat
+ * transcript should there be one; otherwise, they are gone from the QTableView for good. The data must already be locked.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param oldest Whether to evict from the top (i.e. the oldest messages) rather than the bottom (i.e. the newest).
+ */
+void GkXmppRecvMsgsTableViewModel::evictRows(const bool &oldest)
+{
+    const qint32 excess = m_data.count() - GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_MAX_ROWS;
+    if (excess <= 0) {
+        return;
+    }
+
+    if (oldest) {
+        beginRemoveRows(QModelIndex(), 0, excess - 1);
+        m_data.erase(m_data.begin(), m_data.begin() + excess);
+        endRemoveRows();
+
+        m_atOldest = false;
+    } else {
+        beginRemoveRows(QModelIndex(), m_data.count() - excess, m_data.count() - 1);
+        m_data.erase(m_data.end() - excess, m_data.end());
+        endRemoveRows();
+
+        m_atNewest = false;
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppRecvMsgsTableViewModel::holdsOldest
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return Whether nothing older than the window is left to be read in from the chat transcript by scrolling, either as
+ * the window reaches the oldest message or as there are too few rows held for there to be any scrollbar at all.
+ */
+bool GkXmppRecvMsgsTableViewModel::holdsOldest() const
+{
+    return m_atOldest || m_data.count() < GK_XMPP_RECV_MSGS_TABLEVIEW_MODEL_PAGE_SIZE;
+}
+
 /**
  * @brief GkXmppRecvMsgsTableViewModel::rowCount
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
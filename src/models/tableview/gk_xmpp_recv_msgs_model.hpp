@@ -42,6 +42,7 @@
 #pragma once
 
 #include "src/defines.hpp"
+#include "src/dek_db.hpp"
 #include "src/gk_xmpp_client.hpp"
 #include <mutex>
 #include <thread>
@@ -65,6 +66,13 @@ public:
     ~GkXmppRecvMsgsTableViewModel() override;
 
     void populateData(const QList<GekkoFyre::Network::GkXmpp::GkRecvMsgsTableViewModel> &data_list);
+    void setTranscript(QPointer<GekkoFyre::GkLevelDb> database, const QString &chatJid);
+    void showSearchResults(const QList<GekkoFyre::Network::GkXmpp::GkRecvMsgsTableViewModel> &messages);
+    qint32 fetchOlder();
+    qint32 fetchNewer();
+
+    [[nodiscard]] bool canFetchMore(const QModelIndex &parent) const Q_DECL_OVERRIDE;
+    void fetchMore(const QModelIndex &parent) Q_DECL_OVERRIDE;
     [[nodiscard]] int rowCount(const QModelIndex &parent = QModelIndex()) const Q_DECL_OVERRIDE;
     [[nodiscard]] int columnCount(const QModelIndex &parent = QModelIndex()) const Q_DECL_OVERRIDE;
 
@@ -75,17 +83,34 @@ public:
 
 public slots:
     void insertData(const QString &bareJid, const QString &msg, const QDateTime &timestamp = QDateTime::currentDateTimeUtc());
+    void insertData(const QList<GekkoFyre::Network::GkXmpp::GkRecvMsgsTableViewModel> &messages, const bool &transcribed = false);
     qint32 removeData();
     qint32 removeData(const QDateTime &timestamp, const QString &bareJid);
 
+private slots:
+    void prefetchOlder(int value);
+
 private:
     QList<GekkoFyre::Network::GkXmpp::GkRecvMsgsTableViewModel> m_data;
 
+    //
+    // Chat transcript, of which only a window is kept within `m_data` at any one time
+    QPointer<GekkoFyre::GkLevelDb> gkDb;
+    QString m_transcriptJid;
+    bool m_atNewest;                    // Whether the window reaches the newest message of the transcript, and so new messages are to be shown.
+    bool m_atOldest;                    // Whether the window reaches the oldest message of the transcript, and so older messages are to be shown too.
+    bool m_searching;                   // Whether search results are being shown in place of the window.
+
     //
     // Miscellaneous
     QPointer<QTableView> table;
     QPointer<GekkoFyre::GkXmppClient> m_xmppClient;
 
+    [[nodiscard]] QString getNickname(const QString &bareJid) const;
+    void insertMsg(const GekkoFyre::Network::GkXmpp::GkRecvMsgsTableViewModel &recvMsg);
+    void evictRows(const bool &oldest);
+    [[nodiscard]] bool holdsOldest() const;
+
     //
     // Multithreading, mutexes, etc.
     //
@@ -0,0 +1,348 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small world is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QTimer>
+#include <QPointer>
+#include <QModelIndex>
+#include <QAbstractTableModel>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkXmppRosterBatchModel is the base of those roster QTableView models whose rows are each keyed by a bareJid. Any
+ * changes made towards the rows are gathered for GK_XMPP_ROSTER_TABLEVIEW_MODEL_BATCH_MS and then applied all at once, so
+ * that a flood of them (such as presence upon connecting) repaints the QTableView once per batch rather than once per
+ * change.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @tparam T The contents of each row, which must have a `bareJid`.
+ */
+template<typename T>
+class GkXmppRosterBatchModel : public QAbstractTableModel {
+
+public:
+    explicit GkXmppRosterBatchModel(QObject *parent = nullptr);
+    ~GkXmppRosterBatchModel() override = default;
+
+    void populateData(const QList<T> &data_list);
+    void insertData(const T &data);
+    void updateData(const T &data);
+    qint32 removeData(const QString &bareJid);
+
+    [[nodiscard]] int rowCount(const QModelIndex &parent = QModelIndex()) const Q_DECL_OVERRIDE;
+
+protected:
+    QList<T> m_data;
+    QMutex dataBatchMutex;
+
+private:
+    QHash<QString, qint32> m_rows;                                              // The row of each bareJid within `m_data`.
+
+    //
+    // Changes that are yet to be applied towards `m_data`
+    QList<T> m_pendingInserts;
+    QHash<QString, qint32> m_pendingInsertRows;                                 // Where each bareJid lies within `m_pendingInserts`.
+    QHash<QString, T> m_pendingUpdates;
+    QSet<QString> m_pendingRemovals;
+    QPointer<QTimer> m_batchTimer;
+
+    void applyPending();
+    void scheduleBatch();
+    void reindexRows();
+};
+
+/**
+ * @brief GkXmppRosterBatchModel::GkXmppRosterBatchModel
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param parent
+ */
+template<typename T>
+GkXmppRosterBatchModel<T>::GkXmppRosterBatchModel(QObject *parent) : QAbstractTableModel(parent)
+{
+    m_batchTimer = new QTimer(this);
+    m_batchTimer->setSingleShot(true);
+    m_batchTimer->setInterval(GK_XMPP_ROSTER_TABLEVIEW_MODEL_BATCH_MS);
+    QObject::connect(m_batchTimer, &QTimer::timeout, this, [this]() { applyPending(); });
+
+    return;
+}
+
+/**
+ * @brief GkXmppRosterBatchModel::populateData replaces every row at once.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param data_list The rows to be shown.
+ */
+template<typename T>
+void GkXmppRosterBatchModel<T>::populateData(const QList<T> &data_list)
+{
+    dataBatchMutex.lock();
+
+    //
+    // Any changes still waiting upon a batch were made against the rows being replaced, so they are dropped too
+    beginResetModel();
+    m_data.clear();
+    m_data = data_list;
+    m_pendingInserts.clear();
+    m_pendingInsertRows.clear();
+    m_pendingUpdates.clear();
+    m_pendingRemovals.clear();
+    reindexRows();
+    endResetModel();
+
+    dataBatchMutex.unlock();
+    return;
+}
+
+/**
+ * @brief GkXmppRosterBatchModel::insertData adds the given bareJid towards the table, or updates its row should it already
+ * be present. The change is applied together with any others made within the next GK_XMPP_ROSTER_TABLEVIEW_MODEL_BATCH_MS.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param data The row to be inserted.
+ */
+template<typename T>
+void GkXmppRosterBatchModel<T>::insertData(const T &data)
+{
+    dataBatchMutex.lock();
+
+    if (m_pendingRemovals.remove(data.bareJid) || m_rows.contains(data.bareJid)) {
+        m_pendingUpdates.insert(data.bareJid, data);
+    } else {
+        const qint32 pending_row = m_pendingInsertRows.value(data.bareJid, -1);
+        if (pending_row >= 0) {
+            m_pendingInserts[pending_row] = data;
+        } else {
+            m_pendingInsertRows.insert(data.bareJid, m_pendingInserts.count());
+            m_pendingInserts.append(data);
+        }
+    }
+
+    dataBatchMutex.unlock();
+    scheduleBatch();
+    return;
+}
+
+/**
+ * @brief GkXmppRosterBatchModel::updateData changes the row of the given bareJid in place, rather than removing and then
+ * re-inserting it. Should the bareJid not be present, it is inserted instead.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param data The new contents of the row.
+ */
+template<typename T>
+void GkXmppRosterBatchModel<T>::updateData(const T &data)
+{
+    insertData(data);
+    return;
+}
+
+/**
+ * @brief GkXmppRosterBatchModel::removeData
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The username for which the roster item is to be removed from.
+ * @return The row at which the data is to be removed from, or -1 should it not be present within the table.
+ */
+template<typename T>
+qint32 GkXmppRosterBatchModel<T>::removeData(const QString &bareJid)
+{
+    dataBatchMutex.lock();
+
+    const qint32 pending_row = m_pendingInsertRows.value(bareJid, -1);
+    if (pending_row >= 0) {
+        //
+        // The order in which new rows are inserted is of no importance, so the last takes the place of this one
+        const qint32 last = m_pendingInserts.count() - 1;
+        m_pendingInsertRows.remove(bareJid);
+        if (pending_row != last) {
+            m_pendingInserts[pending_row] = m_pendingInserts.at(last);
+            m_pendingInsertRows.insert(m_pendingInserts.at(pending_row).bareJid, pending_row);
+        }
+
+        m_pendingInserts.removeLast();
+    }
+
+    m_pendingUpdates.remove(bareJid);
+    const qint32 row = m_rows.value(bareJid, -1);
+    if (row >= 0) {
+        m_pendingRemovals.insert(bareJid);
+    }
+
+    dataBatchMutex.unlock();
+    scheduleBatch();
+    return row;
+}
+
+/**
+ * @brief GkXmppRosterBatchModel::rowCount
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param parent
+ * @return
+ */
+template<typename T>
+int GkXmppRosterBatchModel<T>::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+
+    return m_data.length();
+}
+
+/**
+ * @brief GkXmppRosterBatchModel::applyPending applies every change gathered since the last batch, with one
+ * beginRemoveRows() for each contiguous run of removed rows, one dataChanged() for each contiguous run of updated rows,
+ * and a single beginInsertRows() for all the new rows.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+template<typename T>
+void GkXmppRosterBatchModel<T>::applyPending()
+{
+    dataBatchMutex.lock();
+
+    if (!m_pendingRemovals.isEmpty()) {
+        std::vector<qint32> rows;
+        rows.reserve(m_pendingRemovals.size());
+        for (const auto &bareJid: m_pendingRemovals) {
+            const qint32 row = m_rows.value(bareJid, -1);
+            if (row >= 0) {
+                rows.push_back(row);
+            }
+        }
+
+        //
+        // Work from the bottom up, so that the rows of each run are still valid once those beneath it are removed
+        std::sort(rows.begin(), rows.end(), std::greater<qint32>());
+        for (size_t i = 0; i < rows.size();) {
+            size_t j = i;
+            while (j + 1 < rows.size() && rows[j + 1] == rows[j] - 1) {
+                ++j;
+            }
+
+            beginRemoveRows(QModelIndex(), rows[j], rows[i]);
+            m_data.erase(m_data.begin() + rows[j], m_data.begin() + rows[i] + 1);
+            endRemoveRows();
+            i = j + 1;
+        }
+
+        m_pendingRemovals.clear();
+        reindexRows();
+    }
+
+    if (!m_pendingUpdates.isEmpty()) {
+        std::vector<qint32> rows;
+        rows.reserve(m_pendingUpdates.size());
+        for (auto iter = m_pendingUpdates.constBegin(); iter != m_pendingUpdates.constEnd(); ++iter) {
+            const qint32 row = m_rows.value(iter.key(), -1);
+            if (row < 0) {
+                continue;
+            }
+
+            m_data[row] = iter.value();
+            rows.push_back(row);
+        }
+
+        std::sort(rows.begin(), rows.end());
+        for (size_t i = 0; i < rows.size();) {
+            size_t j = i;
+            while (j + 1 < rows.size() && rows[j + 1] == rows[j] + 1) {
+                ++j;
+            }
+
+            emit this->dataChanged(this->index(rows[i], 0), this->index(rows[j], columnCount() - 1));
+            i = j + 1;
+        }
+
+        m_pendingUpdates.clear();
+    }
+
+    if (!m_pendingInserts.isEmpty()) {
+        beginInsertRows(QModelIndex(), m_data.count(), m_data.count() + m_pendingInserts.count() - 1);
+        for (const auto &data: m_pendingInserts) {
+            m_rows.insert(data.bareJid, m_data.count());
+            m_data.append(data);
+        }
+
+        endInsertRows();
+        m_pendingInserts.clear();
+        m_pendingInsertRows.clear();
+    }
+
+    dataBatchMutex.unlock();
+    return;
+}
+
+/**
+ * @brief GkXmppRosterBatchModel::scheduleBatch starts the countdown towards applying the changes gathered so far, unless
+ * it is already underway.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+template<typename T>
+void GkXmppRosterBatchModel<T>::scheduleBatch()
+{
+    if (!m_batchTimer->isActive()) {
+        m_batchTimer->start();
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppRosterBatchModel::reindexRows
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+template<typename T>
+void GkXmppRosterBatchModel<T>::reindexRows()
+{
+    m_rows.clear();
+    m_rows.reserve(m_data.count());
+    for (qint32 i = 0; i < m_data.count(); ++i) {
+        m_rows.insert(m_data.at(i).bareJid, i);
+    }
+
+    return;
+}
+};
@@ -67,7 +67,7 @@ using namespace GkXmpp;
 GkXmppRosterPendingTableViewModel::GkXmppRosterPendingTableViewModel(QPointer<QTableView> tableView,
                                                                      QPointer<GekkoFyre::GkXmppClient> xmppClient,
                                                                      QPointer<GekkoFyre::StringFuncs> stringFuncs,
-                                                                     QWidget *parent) : QAbstractTableModel(parent)
+                                                                     QWidget *parent) : GkXmppRosterBatchModel<GkPendingTableViewModel>(parent)
 {
     setParent(parent);
 
@@ -89,84 +89,6 @@ GkXmppRosterPendingTableViewModel::~GkXmppRosterPendingTableViewModel()
     return;
 }
 
-/**
- * @brief GkXmppRosterPendingTableViewModel::populateData
- * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param event_logs
- */
-void GkXmppRosterPendingTableViewModel::populateData(const QList<GkPendingTableViewModel> &data_list)
-{
-    dataBatchMutex.lock();
-
-    m_data.clear();
-    m_data = data_list;
-
-    dataBatchMutex.unlock();
-    return;
-}
-
-/**
- * @brief GkXmppRosterPendingTableViewModel::insertData
- * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param event
- */
-void GkXmppRosterPendingTableViewModel::insertData(const GkPendingTableViewModel &data)
-{
-    dataBatchMutex.lock();
-
-    beginInsertRows(QModelIndex(), m_data.count(), m_data.count());
-    m_data.append(data);
-    endInsertRows();
-
-    auto top = this->createIndex((m_data.count() - 1), 0, nullptr);
-    auto bottom = this->createIndex((m_data.count() - 1), GK_XMPP_ROSTER_PENDING_TABLEVIEW_MODEL_TOTAL_IDX, nullptr);
-    emit dataChanged(top, bottom);
-
-    dataBatchMutex.unlock();
-    return;
-}
-
-/**
- * @brief GkXmppRosterPendingTableViewModel::removeData
- * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param bareJid The username for which the roster item is to be removed from.
- * @return The row at which the data was removed from.
- */
-qint32 GkXmppRosterPendingTableViewModel::removeData(const QString &bareJid)
-{
-    dataBatchMutex.lock();
-    qint32 counter = 0;
-    for (auto iter = m_data.begin(); iter != m_data.end(); ++iter) {
-        ++counter;
-        if (iter->bareJid == bareJid) {
-            beginRemoveRows(QModelIndex(), (m_data.count() - 1), (m_data.count() - 1));
-            iter = m_data.erase(iter);
-            endRemoveRows();
-            break;
-        }
-    }
-
-    auto top = this->createIndex((m_data.count() - 1), 0, nullptr);
-    auto bottom = this->createIndex((m_data.count() - 1), GK_XMPP_ROSTER_PENDING_TABLEVIEW_MODEL_TOTAL_IDX, nullptr);
-    emit dataChanged(top, bottom);
-
-    dataBatchMutex.unlock();
-    return counter;
-}
-
-/**
- * @brief GkXmppRosterPendingTableViewModel::rowCount
- * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param parent
- * @return
- */
-int GkXmppRosterPendingTableViewModel::rowCount(const QModelIndex &parent) const
-{
-    Q_UNUSED(parent);
-
-    return m_data.length();
-}
-
 /**
  * @brief GkXmppRosterPendingTableViewModel::columnCount
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
@@ -44,9 +44,8 @@
 #include "src/defines.hpp"
 #include "src/gk_xmpp_client.hpp"
 #include "src/gk_string_funcs.hpp"
+#include "src/models/tableview/gk_xmpp_roster_batch_model.hpp"
 #include <memory>
-#include <QList>
-#include <QMutex>
 #include <QObject>
 #include <QString>
 #include <QVariant>
@@ -57,7 +56,7 @@
 
 namespace GekkoFyre {
 
-class GkXmppRosterPendingTableViewModel : public QAbstractTableModel {
+class GkXmppRosterPendingTableViewModel : public GkXmppRosterBatchModel<GekkoFyre::Network::GkXmpp::GkPendingTableViewModel> {
     Q_OBJECT
 
 public:
@@ -65,8 +64,6 @@ public:
                                                QPointer<GekkoFyre::StringFuncs> stringFuncs, QWidget *parent = nullptr);
     ~GkXmppRosterPendingTableViewModel() override;
 
-    void populateData(const QList<GekkoFyre::Network::GkXmpp::GkPendingTableViewModel> &data_list);
-    [[nodiscard]] int rowCount(const QModelIndex &parent = QModelIndex()) const Q_DECL_OVERRIDE;
     [[nodiscard]] int columnCount(const QModelIndex &parent = QModelIndex()) const Q_DECL_OVERRIDE;
 
     [[nodiscard]] QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const Q_DECL_OVERRIDE;
@@ -74,18 +71,10 @@ public:
     [[nodiscard]] Qt::ItemFlags flags(const QModelIndex &index) const Q_DECL_OVERRIDE;
     [[nodiscard]] QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const Q_DECL_OVERRIDE;
 
-public slots:
-    void insertData(const GekkoFyre::Network::GkXmpp::GkPendingTableViewModel &data);
-    qint32 removeData(const QString &bareJid);
-
 private:
     QPointer<GekkoFyre::StringFuncs> gkStringFuncs;
-    QList<GekkoFyre::Network::GkXmpp::GkPendingTableViewModel> m_data;
-
     QPointer<QSortFilterProxyModel> proxyModel;
     QPointer<QTableView> table;
     QPointer<GekkoFyre::GkXmppClient> m_xmppClient;
-
-    QMutex dataBatchMutex;
 };
 };
@@ -67,7 +67,7 @@ using namespace GkXmpp;
 GkXmppRosterPresenceTableViewModel::GkXmppRosterPresenceTableViewModel(QPointer<QTableView> tableView,
                                                                        QPointer<GekkoFyre::GkXmppClient> xmppClient,
                                                                        QPointer<GekkoFyre::StringFuncs> stringFuncs,
-                                                                       QWidget *parent) : QAbstractTableModel(parent)
+                                                                       QWidget *parent) : GkXmppRosterBatchModel<GkPresenceTableViewModel>(parent)
 {
     setParent(parent);
 
@@ -89,84 +89,6 @@ GkXmppRosterPresenceTableViewModel::~GkXmppRosterPresenceTableViewModel()
     return;
 }
 
-/**
- * @brief GkXmppRosterPresenceTableViewModel::populateData
- * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param event_logs
- */
-void GkXmppRosterPresenceTableViewModel::populateData(const QList<GkPresenceTableViewModel> &data_list)
-{
-    dataBatchMutex.lock();
-
-    m_data.clear();
-    m_data = data_list;
-
-    dataBatchMutex.unlock();
-    return;
-}
-
-/**
- * @brief GkXmppRosterPresenceTableViewModel::insertData
- * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param event
- */
-void GkXmppRosterPresenceTableViewModel::insertData(const GkPresenceTableViewModel &data)
-{
-    dataBatchMutex.lock();
-
-    beginInsertRows(QModelIndex(), m_data.count(), m_data.count());
-    m_data.append(data);
-    endInsertRows();
-
-    auto top = this->createIndex((m_data.count() - 1), 0, nullptr);
-    auto bottom = this->createIndex((m_data.count() - 1), GK_XMPP_ROSTER_PRESENCE_TABLEVIEW_MODEL_TOTAL_IDX, nullptr);
-    emit dataChanged(top, bottom);
-
-    dataBatchMutex.unlock();
-    return;
-}
-
-/**
- * @brief GkXmppRosterPresenceTableViewModel::removeData
- * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param bareJid The username for which the roster item is to be removed from.
- * @return The row at which the data was removed from.
- */
-qint32 GkXmppRosterPresenceTableViewModel::removeData(const QString &bareJid)
-{
-    dataBatchMutex.lock();
-    qint32 counter = 0;
-    for (auto iter = m_data.begin(); iter != m_data.end(); ++iter) {
-        ++counter;
-        if (iter->bareJid == bareJid) {
-            beginRemoveRows(QModelIndex(), (m_data.count() - 1), (m_data.count() - 1));
-            iter = m_data.erase(iter);
-            endRemoveRows();
-            break;
-        }
-    }
-
-    auto top = this->createIndex((m_data.count() - 1), 0, nullptr);
-    auto bottom = this->createIndex((m_data.count() - 1), GK_XMPP_ROSTER_PRESENCE_TABLEVIEW_MODEL_TOTAL_IDX, nullptr);
-    emit dataChanged(top, bottom);
-
-    dataBatchMutex.unlock();
-    return counter;
-}
-
-/**
- * @brief GkXmppRosterPresenceTableViewModel::rowCount
- * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param parent
- * @return
- */
-int GkXmppRosterPresenceTableViewModel::rowCount(const QModelIndex &parent) const
-{
-    Q_UNUSED(parent);
-
-    return m_data.length();
-}
-
 /**
  * @brief GkXmppRosterPresenceTableViewModel::columnCount
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
@@ -40,7 +40,11 @@
  ****************************************************************************************************/
 
 #include "src/models/treeview/xmpp/gk_xmpp_muc_roster_model.hpp"
+#include <algorithm>
+#include <utility>
+#include <QImage>
 #include <QApplication>
+#include <QCryptographicHash>
 
 using namespace GekkoFyre;
 using namespace GkAudioFramework;
@@ -57,341 +61,368 @@ using namespace Network;
 using namespace GkXmpp;
 
 /**
- * @brief GkXmppMucRosterTreeViewItem::GkXmppMucRosterTreeViewItem
+ * @brief GkXmppMucRosterTreeViewModel::GkXmppMucRosterTreeViewModel
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param data
- * @param parent
+ * @param occupantStore The occupants of the MUC, whose batches are shown as they arrive.
+ * @param headers The title of each column.
+ * @param parent The parent object.
  */
-GkXmppMucRosterTreeViewItem::GkXmppMucRosterTreeViewItem(const QVector<QVariant> &data, GkXmppMucRosterTreeViewItem *parent) : itemData(data), parentItem(parent)
-{
-    return;
-}
-
-GkXmppMucRosterTreeViewItem::~GkXmppMucRosterTreeViewItem()
-{
-    qDeleteAll(childItems);
-    return;
-}
-
-GkXmppMucRosterTreeViewItem *GkXmppMucRosterTreeViewItem::child(qint32 number)
+GkXmppMucRosterTreeViewModel::GkXmppMucRosterTreeViewModel(QPointer<GkXmppMucOccupantStore> occupantStore, const QStringList &headers,
+                                                           QObject *parent) : QAbstractItemModel(parent)
 {
-    if (number < 0 || number >= childItems.size()) {
-        return nullptr;
-    }
+    m_occupantStore = std::move(occupantStore);
+    m_headers = headers;
 
-    return childItems.at(number);
-}
+    QObject::connect(m_occupantStore, SIGNAL(occupantsChanged(const QList<GekkoFyre::Network::GkXmpp::GkXmppMucOccupant> &, const QStringList &)),
+                     this, SLOT(applyOccupants(const QList<GekkoFyre::Network::GkXmpp::GkXmppMucOccupant> &, const QStringList &)));
+    QObject::connect(m_occupantStore, SIGNAL(occupantsCleared()), this, SLOT(resetOccupants()));
 
-qint32 GkXmppMucRosterTreeViewItem::childCount() const
-{
-    return childItems.count();
+    resetOccupants();
+    return;
 }
 
-qint32 GkXmppMucRosterTreeViewItem::columnCount() const
-{
-    return itemData.count();
-}
+GkXmppMucRosterTreeViewModel::~GkXmppMucRosterTreeViewModel()
+{}
 
-QVariant GkXmppMucRosterTreeViewItem::data(qint32 column) const
+QVariant GkXmppMucRosterTreeViewModel::data(const QModelIndex &index, qint32 role) const
 {
-    if (column < 0 || column >= itemData.size()) {
+    if (!index.isValid() || index.row() >= m_rows.count()) {
         return QVariant();
     }
 
-    return itemData.at(column);
-}
+    const auto &occupant = m_rows.at(index.row()).occupant;
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+            case GK_XMPP_MUC_ROSTER_TREEVIEW_MODEL_NICKNAME_IDX:
+                return occupant.nickName;
+            case GK_XMPP_MUC_ROSTER_TREEVIEW_MODEL_ROLE_IDX:
+                return roleToString(occupant.role);
+            default:
+                return QVariant();
+        }
+    }
 
-bool GkXmppMucRosterTreeViewItem::insertChildren(qint32 position, qint32 count, qint32 columns)
-{
-    if (position < 0 || position > childItems.size()) {
-        return false;
+    if (role == Qt::DecorationRole && index.column() == GK_XMPP_MUC_ROSTER_TREEVIEW_MODEL_NICKNAME_IDX) {
+        //
+        // Only ever what has been decoded already, as the decoding is left towards GkXmppMucRosterTreeViewModel::wantAvatars()
+        const auto iter = m_avatars.constFind(occupant.photoHash);
+        if (iter != m_avatars.constEnd()) {
+            return iter.value();
+        }
     }
 
-    for (qint32 row = 0; row < count; ++row) {
-        QVector<QVariant> data(columns);
-        GkXmppMucRosterTreeViewItem *item = new GkXmppMucRosterTreeViewItem(data, this);
-        childItems.insert(position, item);
+    if (role == Qt::ToolTipRole && !occupant.realJid.isEmpty()) {
+        return occupant.realJid;
     }
 
-    return true;
+    return QVariant();
 }
 
-bool GkXmppMucRosterTreeViewItem::insertColumns(qint32 position, qint32 columns)
+QVariant GkXmppMucRosterTreeViewModel::headerData(qint32 section, Qt::Orientation orientation, qint32 role) const
 {
-    if (position < 0 || position > itemData.size()) {
-        return false;
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole && section >= 0 && section < m_headers.count()) {
+        return m_headers.at(section);
     }
 
-    for (qint32 column = 0; column < columns; ++column) {
-        itemData.insert(position, QVariant());
-    }
+    return QVariant();
+}
 
-    for (GkXmppMucRosterTreeViewItem *child : qAsConst(childItems)) {
-        child->insertColumns(position, columns);
+QModelIndex GkXmppMucRosterTreeViewModel::index(qint32 row, qint32 column, const QModelIndex &parent) const
+{
+    if (parent.isValid() || row < 0 || row >= m_rows.count() || column < 0 || column >= GK_XMPP_MUC_ROSTER_TREEVIEW_MODEL_TOTAL_IDX) {
+        return QModelIndex();
     }
 
-    return true;
+    return createIndex(row, column);
 }
 
-GkXmppMucRosterTreeViewItem *GkXmppMucRosterTreeViewItem::parent()
+QModelIndex GkXmppMucRosterTreeViewModel::parent(const QModelIndex &index) const
 {
-    return parentItem;
+    Q_UNUSED(index);
+    return QModelIndex(); // The occupants are a flat list, without any children of their own.
 }
 
-bool GkXmppMucRosterTreeViewItem::removeChildren(qint32 position, qint32 count)
+qint32 GkXmppMucRosterTreeViewModel::rowCount(const QModelIndex &parent) const
 {
-    if (position < 0 || position + count > childItems.size()) {
-        return false;
-    }
-
-    for (qint32 row = 0; row < count; ++row) {
-        delete childItems.takeAt(position);
+    if (parent.isValid()) {
+        return 0;
     }
 
-    return true;
+    return m_rows.count();
 }
 
-bool GkXmppMucRosterTreeViewItem::removeColumns(qint32 position, qint32 columns)
+qint32 GkXmppMucRosterTreeViewModel::columnCount(const QModelIndex &parent) const
 {
-    if (position < 0 || position + columns > itemData.size()) {
-        return false;
-    }
-
-    for (qint32 column = 0; column < columns; ++column) {
-        itemData.remove(position);
-    }
-
-    for (GkXmppMucRosterTreeViewItem *child : qAsConst(childItems)) {
-        child->removeColumns(position, columns);
-    }
-
-    return true;
+    Q_UNUSED(parent);
+    return GK_XMPP_MUC_ROSTER_TREEVIEW_MODEL_TOTAL_IDX;
 }
 
-qint32 GkXmppMucRosterTreeViewItem::childNumber() const
+/**
+ * @brief GkXmppMucRosterTreeViewModel::rowOf
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param jid The occupant JID.
+ * @return The row that the occupant is shown upon, or -1 should they not be present.
+ */
+qint32 GkXmppMucRosterTreeViewModel::rowOf(const QString &jid) const
 {
-    if (parentItem) {
-        return parentItem->childItems.indexOf(const_cast<GkXmppMucRosterTreeViewItem *>(this));
+    const auto iter = m_keys.constFind(jid);
+    if (iter == m_keys.constEnd()) {
+        return -1;
     }
 
-    return 0;
-}
-
-bool GkXmppMucRosterTreeViewItem::setData(qint32 column, const QVariant &value)
-{
-    if (column < 0 || column >= itemData.size()) {
-        return false;
+    const qint32 row = lowerBound(iter.value());
+    if (row < m_rows.count() && m_rows.at(row).key == iter.value()) {
+        return row;
     }
 
-    itemData[column] = value;
-    return true;
+    return -1;
 }
 
 /**
- * @brief GkXmppMucRosterTreeViewModel::GkXmppMucRosterTreeViewModel
+ * @brief GkXmppMucRosterTreeViewModel::occupantAt
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param headers
- * @param data
- * @param parent
+ * @param row The row in question.
+ * @return The occupant shown upon the given row.
  */
-GkXmppMucRosterTreeViewModel::GkXmppMucRosterTreeViewModel(const QStringList &headers, QObject *parent) : QAbstractItemModel(parent)
+GkXmppMucOccupant GkXmppMucRosterTreeViewModel::occupantAt(const qint32 &row) const
 {
-    QVector<QVariant> rootData;
-    for (const QString &header: headers) {
-        rootData << header;
+    if (row < 0 || row >= m_rows.count()) {
+        return GkXmppMucOccupant();
     }
 
-    m_rootItem = new GkXmppMucRosterTreeViewItem(rootData);
-    return;
+    return m_rows.at(row).occupant;
 }
 
-GkXmppMucRosterTreeViewModel::~GkXmppMucRosterTreeViewModel()
-{
-    delete m_rootItem;
-    return;
-}
-
-QVariant GkXmppMucRosterTreeViewModel::data(const QModelIndex &index, qint32 role) const
+/**
+ * @brief GkXmppMucRosterTreeViewModel::applyOccupants applies a batch of occupants that have joined, changed or left.
+ * Each is moved towards where it now sorts, unless the batch is large enough that the view is better off being reset.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param upserted The occupants that have either joined or changed.
+ * @param removed The occupant JIDs of those that have left.
+ */
+void GkXmppMucRosterTreeViewModel::applyOccupants(const QList<GkXmppMucOccupant> &upserted, const QStringList &removed)
 {
-    if (!index.isValid()) {
-        return QVariant();
+    if (upserted.count() + removed.count() > GK_XMPP_MUC_ROSTER_TREEVIEW_MODEL_RESET_ROWS) {
+        resetOccupants();
+        return;
     }
 
-    if (role != Qt::DisplayRole && role != Qt::EditRole) {
-        return QVariant();
+    for (const auto &jid: removed) {
+        removeOccupant(jid);
     }
 
-    GkXmppMucRosterTreeViewItem *item = getItem(index);
-    return item->data(index.column());
-}
+    for (const auto &occupant: upserted) {
+        const auto iter = m_keys.constFind(occupant.jid);
+        if (iter != m_keys.constEnd()) {
+            const qint32 row = lowerBound(iter.value());
+            if (iter.value() == toKey(occupant) && row < m_rows.count()) {
+                //
+                // Still sorted towards the very same row, so there's nothing to move
+                if (m_rows.at(row).occupant.photoHash != occupant.photoHash) {
+                    m_avatarsWanted.remove(occupant.jid);
+                }
 
-QVariant GkXmppMucRosterTreeViewModel::headerData(qint32 section, Qt::Orientation orientation, qint32 role) const
-{
-    if (orientation == Qt::Horizontal && role == Qt::DisplayRole) {
-        return m_rootItem->data(section);
-    }
-
-    return QVariant();
-}
+                m_rows[row].occupant = occupant;
+                emit dataChanged(index(row, 0), index(row, GK_XMPP_MUC_ROSTER_TREEVIEW_MODEL_TOTAL_IDX - 1));
+                continue;
+            }
 
-QModelIndex GkXmppMucRosterTreeViewModel::index(qint32 row, qint32 column, const QModelIndex &parent) const
-{
-    if (parent.isValid() && parent.column() != 0) {
-        return QModelIndex();
-    }
-
-    GkXmppMucRosterTreeViewItem *parentItem = getItem(parent);
-    if (!parentItem) {
-        return QModelIndex();
-    }
+            removeOccupant(occupant.jid);
+        }
 
-    GkXmppMucRosterTreeViewItem *childItem = parentItem->child(row);
-    if (childItem) {
-        return createIndex(row, column, childItem);
+        insertOccupant(occupant);
     }
 
-    return QModelIndex();
+    return;
 }
 
-QModelIndex GkXmppMucRosterTreeViewModel::parent(const QModelIndex &index) const
+/**
+ * @brief GkXmppMucRosterTreeViewModel::resetOccupants reads in every occupant from the store afresh, and sorts them all
+ * at once.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppMucRosterTreeViewModel::resetOccupants()
 {
-    if (!index.isValid()) {
-        return QModelIndex();
-    }
-
-    GkXmppMucRosterTreeViewItem *childItem = getItem(index);
-    GkXmppMucRosterTreeViewItem *parentItem = childItem ? childItem->parent() : nullptr;
+    beginResetModel();
+    m_rows.clear();
+    m_keys.clear();
+    if (m_occupantStore) {
+        const auto occupants = m_occupantStore->occupants();
+        m_rows.reserve(occupants.count());
+        for (const auto &occupant: occupants) {
+            GkOccupantRow occupantRow;
+            occupantRow.key = toKey(occupant);
+            occupantRow.occupant = occupant;
+            m_keys.insert(occupant.jid, occupantRow.key);
+            m_rows.push_back(std::move(occupantRow));
+        }
 
-    if (parentItem == m_rootItem || !parentItem) {
-        return QModelIndex();
+        std::sort(m_rows.begin(), m_rows.end(), [](const GkOccupantRow &lhs, const GkOccupantRow &rhs) {
+            return lhs.key < rhs.key;
+        });
     }
 
-    return createIndex(parentItem->childNumber(), 0, parentItem);
+    endResetModel();
+    return;
 }
 
 /**
- * @brief GkXmppMucRosterTreeViewModel::indexForTreeItem calculates a QModelIndex, ready for use in creating a child, by
- * external QTableView functions.
+ * @brief GkXmppMucRosterTreeViewModel::wantAvatars asks for the avatar of each occupant within the given rows, such as
+ * those currently scrolled into view, that has one but has not yet been decoded nor asked for.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param item
- * @return The calculated QModelIndex in question.
+ * @param first The first row in question.
+ * @param last The last row in question.
  */
-QModelIndex GkXmppMucRosterTreeViewModel::indexForTreeItem(GkXmppMucRosterTreeViewItem *item)
+void GkXmppMucRosterTreeViewModel::wantAvatars(const qint32 &first, const qint32 &last)
 {
-    return createIndex(item->childNumber(), 0, item);
-}
+    for (qint32 row = std::max(0, first); row <= last && row < m_rows.count(); ++row) {
+        const auto &occupant = m_rows.at(row).occupant;
+        if (occupant.photoHash.isEmpty() || m_avatars.contains(occupant.photoHash) || m_avatarsWanted.contains(occupant.jid)) {
+            continue;
+        }
 
-qint32 GkXmppMucRosterTreeViewModel::rowCount(const QModelIndex &parent) const
-{
-    const GkXmppMucRosterTreeViewItem *parentItem = getItem(parent);
-    return parentItem ? parentItem->childCount() : 0;
-}
+        m_avatarsWanted.insert(occupant.jid);
+        emit avatarWanted(occupant.jid, occupant.realJid);
+    }
 
-qint32 GkXmppMucRosterTreeViewModel::columnCount(const QModelIndex &parent) const
-{
-    Q_UNUSED(parent);
-    return m_rootItem->columnCount();
+    return;
 }
 
-Qt::ItemFlags GkXmppMucRosterTreeViewModel::flags(const QModelIndex &index) const
+/**
+ * @brief GkXmppMucRosterTreeViewModel::setAvatar decodes the given avatar, scaled down towards the size shown, and
+ * keeps it for every occupant advertising the very same one.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param jid The occupant JID that the avatar was asked for.
+ * @param photo The avatar itself, as found within their vCard.
+ */
+void GkXmppMucRosterTreeViewModel::setAvatar(const QString &jid, const QByteArray &photo)
 {
-    if (!index.isValid()) {
-        return Qt::NoItemFlags;
+    if (photo.isEmpty()) {
+        return;
     }
 
-    return Qt::ItemIsEditable | QAbstractItemModel::flags(index);
-}
+    const QByteArray photoHash = QCryptographicHash::hash(photo, QCryptographicHash::Sha1);
+    if (!m_avatars.contains(photoHash)) {
+        QImage image;
+        if (!image.loadFromData(photo)) {
+            return;
+        }
 
-bool GkXmppMucRosterTreeViewModel::setData(const QModelIndex &index, const QVariant &value, qint32 role)
-{
-    if (role != Qt::EditRole) {
-        return false;
+        m_avatars.insert(photoHash, QPixmap::fromImage(image.scaled(GK_XMPP_MUC_ROSTER_TREEVIEW_MODEL_AVATAR_SIZE, GK_XMPP_MUC_ROSTER_TREEVIEW_MODEL_AVATAR_SIZE,
+                                                                    Qt::KeepAspectRatio, Qt::SmoothTransformation)));
     }
 
-    GkXmppMucRosterTreeViewItem *item = getItem(index);
-    bool result = item->setData(index.column(), value);
-
-    if (result) {
-        emit dataChanged(index, index, {Qt::DisplayRole, Qt::EditRole});
+    const qint32 row = rowOf(jid);
+    if (row >= 0) {
+        const QModelIndex avatarIdx = index(row, GK_XMPP_MUC_ROSTER_TREEVIEW_MODEL_NICKNAME_IDX);
+        emit dataChanged(avatarIdx, avatarIdx, { Qt::DecorationRole });
     }
 
-    return result;
+    return;
 }
 
-bool
-GkXmppMucRosterTreeViewModel::setHeaderData(qint32 section, Qt::Orientation orientation, const QVariant &value, qint32 role)
+/**
+ * @brief GkXmppMucRosterTreeViewModel::toKey
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param occupant The occupant in question.
+ * @return Where the occupant sorts towards.
+ */
+GkXmppMucRosterTreeViewModel::GkOccupantKey GkXmppMucRosterTreeViewModel::toKey(const GkXmppMucOccupant &occupant)
 {
-    if (role != Qt::EditRole || orientation != Qt::Horizontal) {
-        return false;
-    }
-
-    const bool result = m_rootItem->setData(section, value);
-
-    if (result) {
-        emit headerDataChanged(orientation, section, section);
-    }
-
-    return result;
+    GkOccupantKey key;
+    switch (occupant.role) {
+        case QXmppMucItem::ModeratorRole:
+            key.roleRank = 0;
+            break;
+        case QXmppMucItem::ParticipantRole:
+            key.roleRank = 1;
+            break;
+        case QXmppMucItem::VisitorRole:
+            key.roleRank = 2;
+            break;
+        default:
+            key.roleRank = 3;
+            break;
+    }
+
+    key.foldedNick = occupant.nickName.toCaseFolded();
+    key.jid = occupant.jid;
+
+    return key;
 }
 
-bool GkXmppMucRosterTreeViewModel::insertColumns(qint32 position, qint32 columns, const QModelIndex &parent)
+/**
+ * @brief GkXmppMucRosterTreeViewModel::roleToString
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param role The role of an occupant within the MUC.
+ * @return The role, as shown towards the end-user.
+ */
+QString GkXmppMucRosterTreeViewModel::roleToString(const QXmppMucItem::Role &role) const
 {
-    beginInsertColumns(parent, position, position + columns - 1);
-    const bool success = m_rootItem->insertColumns(position, columns);
-    endInsertColumns();
-
-    return success;
+    switch (role) {
+        case QXmppMucItem::ModeratorRole:
+            return tr("Moderator");
+        case QXmppMucItem::ParticipantRole:
+            return tr("Participant");
+        case QXmppMucItem::VisitorRole:
+            return tr("Visitor");
+        default:
+            return QString();
+    }
 }
 
-bool GkXmppMucRosterTreeViewModel::removeColumns(qint32 position, qint32 columns, const QModelIndex &parent)
+/**
+ * @brief GkXmppMucRosterTreeViewModel::lowerBound
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param key Where an occupant sorts towards.
+ * @return The first row that does not sort before the given key, found via a binary search.
+ */
+qint32 GkXmppMucRosterTreeViewModel::lowerBound(const GkOccupantKey &key) const
 {
-    beginRemoveColumns(parent, position, position + columns - 1);
-    const bool success = m_rootItem->removeColumns(position, columns);
-    endRemoveColumns();
-
-    if (m_rootItem->columnCount() == 0) {
-        removeRows(0, rowCount());
-    }
+    const auto iter = std::lower_bound(m_rows.constBegin(), m_rows.constEnd(), key, [](const GkOccupantRow &occupantRow, const GkOccupantKey &value) {
+        return occupantRow.key < value;
+    });
 
-    return success;
+    return static_cast<qint32>(iter - m_rows.constBegin());
 }
 
-bool GkXmppMucRosterTreeViewModel::insertRows(qint32 position, qint32 rows, const QModelIndex &parent)
+/**
+ * @brief GkXmppMucRosterTreeViewModel::insertOccupant inserts the given occupant where they sort towards.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param occupant The occupant in question, who must not already be present.
+ */
+void GkXmppMucRosterTreeViewModel::insertOccupant(const GkXmppMucOccupant &occupant)
 {
-    GkXmppMucRosterTreeViewItem *parentItem = getItem(parent);
-    if (!parentItem) {
-        return false;
-    }
-
-    beginInsertRows(parent, position, position + rows - 1);
-    const bool success = parentItem->insertChildren(position, rows, m_rootItem->columnCount());
+    GkOccupantRow occupantRow;
+    occupantRow.key = toKey(occupant);
+    occupantRow.occupant = occupant;
+
+    const qint32 row = lowerBound(occupantRow.key);
+    beginInsertRows(QModelIndex(), row, row);
+    m_keys.insert(occupant.jid, occupantRow.key);
+    m_rows.insert(row, occupantRow);
     endInsertRows();
 
-    return success;
+    return;
 }
 
-bool GkXmppMucRosterTreeViewModel::removeRows(qint32 position, qint32 rows, const QModelIndex &parent)
+/**
+ * @brief GkXmppMucRosterTreeViewModel::removeOccupant
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param jid The occupant JID of whoever is to be removed.
+ */
+void GkXmppMucRosterTreeViewModel::removeOccupant(const QString &jid)
 {
-    GkXmppMucRosterTreeViewItem *parentItem = getItem(parent);
-    if (!parentItem) {
-        return false;
+    const qint32 row = rowOf(jid);
+    m_keys.remove(jid);
+    m_avatarsWanted.remove(jid);
+    if (row < 0) {
+        return;
     }
 
-    beginRemoveRows(parent, position, position + rows - 1);
-    const bool success = parentItem->removeChildren(position, rows);
+    beginRemoveRows(QModelIndex(), row, row);
+    m_rows.remove(row);
     endRemoveRows();
 
-    return success;
-}
-
-GkXmppMucRosterTreeViewItem *GkXmppMucRosterTreeViewModel::getItem(const QModelIndex &index) const
-{
-    if (index.isValid()) {
-        GkXmppMucRosterTreeViewItem *item = static_cast<GkXmppMucRosterTreeViewItem *>(index.internalPointer());
-        if (item) {
-            return item;
-        }
-    }
-
-    return m_rootItem;
+    return;
 }
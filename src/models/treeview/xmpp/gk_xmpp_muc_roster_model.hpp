@@ -42,51 +42,34 @@
 #pragma once
 
 #include "src/defines.hpp"
-#include "src/dek_db.hpp"
-#include <memory>
-#include <QMutex>
+#include "src/models/xmpp/gk_xmpp_muc_occupant_store.hpp"
+#include <QSet>
+#include <QHash>
 #include <QObject>
 #include <QString>
 #include <QVector>
+#include <QPixmap>
 #include <QVariant>
 #include <QPointer>
-#include <QTreeView>
+#include <QByteArray>
 #include <QStringList>
 #include <QModelIndex>
-#include <QScopedPointer>
 #include <QAbstractItemModel>
 
 namespace GekkoFyre {
 
-class GkXmppMucRosterTreeViewItem {
-
-public:
-    explicit GkXmppMucRosterTreeViewItem(const QVector<QVariant> &data, GkXmppMucRosterTreeViewItem *parent = nullptr);
-    ~GkXmppMucRosterTreeViewItem();
-
-    GkXmppMucRosterTreeViewItem *child(qint32 number);
-    qint32 childCount() const;
-    qint32 columnCount() const;
-    QVariant data(qint32 column) const;
-    bool insertChildren(qint32 position, qint32 count, qint32 columns);
-    bool insertColumns(qint32 position, qint32 columns);
-    GkXmppMucRosterTreeViewItem *parent();
-    bool removeChildren(qint32 position, qint32 count);
-    bool removeColumns(qint32 position, qint32 columns);
-    qint32 childNumber() const;
-    bool setData(qint32 column, const QVariant &value);
-
-private:
-    QVector<GkXmppMucRosterTreeViewItem *> childItems;
-    QVector<QVariant> itemData;
-    GkXmppMucRosterTreeViewItem *parentItem;
-};
-
+/**
+ * @brief GkXmppMucRosterTreeViewModel shows the occupants of a MUC, sorted by role and then by nickname. The sorting is
+ * kept up as each batch arrives from GkXmppMucOccupantStore, with each occupant found via a binary search rather than a
+ * walk of every row, whilst a batch too large to be worth updating row by row (such as upon first joining) resets the
+ * view instead. Avatars are only ever decoded for those rows that have been scrolled into view.
+ */
 class GkXmppMucRosterTreeViewModel : public QAbstractItemModel {
     Q_OBJECT
 
 public:
-    explicit GkXmppMucRosterTreeViewModel(const QStringList &headers, QObject *parent = nullptr);
+    explicit GkXmppMucRosterTreeViewModel(QPointer<GekkoFyre::GkXmppMucOccupantStore> occupantStore, const QStringList &headers,
+                                          QObject *parent = nullptr);
     ~GkXmppMucRosterTreeViewModel() override;
 
     QVariant data(const QModelIndex &index, qint32 role) const override;
@@ -94,23 +77,62 @@ public:
 
     QModelIndex index(qint32 row, qint32 column, const QModelIndex &parent = QModelIndex()) const override;
     QModelIndex parent(const QModelIndex &index) const override;
-    QModelIndex indexForTreeItem(GkXmppMucRosterTreeViewItem *item);
 
     qint32 rowCount(const QModelIndex &parent = QModelIndex()) const override;
     qint32 columnCount(const QModelIndex &parent = QModelIndex()) const override;
 
-    Qt::ItemFlags flags(const QModelIndex &index) const override;
-    bool setData(const QModelIndex &index, const QVariant &value, qint32 role = Qt::EditRole) override;
-    bool setHeaderData(qint32 section, Qt::Orientation orientation, const QVariant &value, qint32 role = Qt::EditRole) override;
+    [[nodiscard]] qint32 rowOf(const QString &jid) const;
+    [[nodiscard]] Network::GkXmpp::GkXmppMucOccupant occupantAt(const qint32 &row) const;
+
+public slots:
+    void applyOccupants(const QList<GekkoFyre::Network::GkXmpp::GkXmppMucOccupant> &upserted, const QStringList &removed);
+    void resetOccupants();
+    void wantAvatars(const qint32 &first, const qint32 &last);
+    void setAvatar(const QString &jid, const QByteArray &photo);
 
-    bool insertColumns(qint32 position, qint32 columns, const QModelIndex &parent = QModelIndex()) override;
-    bool removeColumns(qint32 position, qint32 columns, const QModelIndex &parent = QModelIndex()) override;
-    bool insertRows(qint32 position, qint32 rows, const QModelIndex &parent = QModelIndex()) override;
-    bool removeRows(qint32 position, qint32 rows, const QModelIndex &parent = QModelIndex()) override;
+signals:
+    void avatarWanted(const QString &jid, const QString &realJid);
 
 private:
-    GkXmppMucRosterTreeViewItem *getItem(const QModelIndex &index) const;
+    struct GkOccupantKey {
+        qint32 roleRank;                // Moderators foremost, then participants, then visitors.
+        QString foldedNick;             // The nickname, case-folded so that the sorting ignores case.
+        QString jid;                    // Keeps the ordering total, should two nicknames only differ by case.
+
+        bool operator<(const GkOccupantKey &other) const {
+            if (roleRank != other.roleRank) {
+                return roleRank < other.roleRank;
+            }
+
+            if (foldedNick != other.foldedNick) {
+                return foldedNick < other.foldedNick;
+            }
+
+            return jid < other.jid;
+        }
+
+        bool operator==(const GkOccupantKey &other) const {
+            return roleRank == other.roleRank && foldedNick == other.foldedNick && jid == other.jid;
+        }
+    };
+
+    struct GkOccupantRow {
+        GkOccupantKey key;
+        Network::GkXmpp::GkXmppMucOccupant occupant;
+    };
+
+    QPointer<GekkoFyre::GkXmppMucOccupantStore> m_occupantStore;
+    QStringList m_headers;
+    QVector<GkOccupantRow> m_rows;                      // The occupants, in the order that they are shown.
+    QHash<QString, GkOccupantKey> m_keys;               // Where each occupant is sorted towards, keyed by occupant JID.
+    QHash<QByteArray, QPixmap> m_avatars;               // The avatars decoded thus far, keyed by the SHA-1 of the image.
+    QSet<QString> m_avatarsWanted;                      // The occupants whose avatars have been asked for already.
+
+    [[nodiscard]] static GkOccupantKey toKey(const Network::GkXmpp::GkXmppMucOccupant &occupant);
+    [[nodiscard]] QString roleToString(const QXmppMucItem::Role &role) const;
+    [[nodiscard]] qint32 lowerBound(const GkOccupantKey &key) const;
+    void insertOccupant(const Network::GkXmpp::GkXmppMucOccupant &occupant);
+    void removeOccupant(const QString &jid);
 
-    GkXmppMucRosterTreeViewItem *m_rootItem;
 };
 };
@@ -0,0 +1,311 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/models/xmpp/gk_xmpp_mam_sync.hpp"
+#include <utility>
+#include <QList>
+
+using namespace GekkoFyre;
+
+/**
+ * @brief GkXmppMamSync::GkXmppMamSync
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param mamMgr The XEP-0313 manager that has been added towards the XMPP client, which sends each of the queries.
+ * @param parent The parent object.
+ */
+GkXmppMamSync::GkXmppMamSync(QXmppMamManager *mamMgr, QObject *parent) : QObject(parent), m_xmppMamMgr(mamMgr)
+{
+    m_clock.start();
+    m_expiryTimer = new QTimer(this);
+    m_expiryTimer->setInterval(GK_XMPP_MAM_SYNC_TIMEOUT_MS / 4);
+    QObject::connect(m_expiryTimer, SIGNAL(timeout()), this, SLOT(expireQueries()));
+
+    return;
+}
+
+GkXmppMamSync::~GkXmppMamSync()
+{}
+
+/**
+ * @brief GkXmppMamSync::requestSync synchronizes the message archive of the given bareJid, as soon as there is room
+ * amongst the queries already underway. Does nothing should the bareJid already be synchronizing or waiting to.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user whose messages are to be synchronized.
+ * @param lastArchiveId The archive ID of the newest message synchronized beforehand, if any, as given out via
+ * GkXmppMamSync::lastArchiveIdChanged().
+ */
+void GkXmppMamSync::requestSync(const QString &bareJid, const QString &lastArchiveId)
+{
+    if (bareJid.isEmpty() || isSyncing(bareJid)) {
+        return;
+    }
+
+    m_waiting.emplace_back(bareJid, lastArchiveId);
+    startWaiting();
+
+    return;
+}
+
+/**
+ * @brief GkXmppMamSync::cancelAll abandons every query, such as upon disconnecting from the XMPP server. Any results
+ * that still arrive for them afterwards are ignored.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppMamSync::cancelAll()
+{
+    if (m_active.isEmpty() && m_waiting.empty()) {
+        return;
+    }
+
+    m_active.clear();
+    m_waiting.clear();
+    m_expiryTimer->stop();
+    emit syncCancelled();
+
+    return;
+}
+
+/**
+ * @brief GkXmppMamSync::isSyncing
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user in question.
+ * @return Whether the given bareJid is either being synchronized or waiting to be.
+ */
+bool GkXmppMamSync::isSyncing(const QString &bareJid) const
+{
+    for (const auto &query: m_active) {
+        if (query.bareJid == bareJid) {
+            return true;
+        }
+    }
+
+    for (const auto &waiting: m_waiting) {
+        if (waiting.first == bareJid) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief GkXmppMamSync::activeQueries
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The amount of bareJids currently being synchronized.
+ */
+qint32 GkXmppMamSync::activeQueries() const
+{
+    return m_active.size();
+}
+
+/**
+ * @brief GkXmppMamSync::waitingQueries
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The amount of bareJids waiting for their turn to be synchronized.
+ */
+qint32 GkXmppMamSync::waitingQueries() const
+{
+    return static_cast<qint32>(m_waiting.size());
+}
+
+/**
+ * @brief GkXmppMamSync::archivedMessageReceived counts each message towards the query that it belongs to.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param queryId The query that the message has been received for.
+ * @param message The message itself.
+ */
+void GkXmppMamSync::archivedMessageReceived(const QString &queryId, const QXmppMessage &message)
+{
+    Q_UNUSED(message);
+
+    const auto iter = m_active.find(queryId);
+    if (iter != m_active.end()) {
+        ++iter->messages;
+        iter->updated = m_clock.elapsed();
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppMamSync::resultsReceived is executed once a page has been received in full, and then either requests
+ * the next page from the cursor that has been returned, or finishes with the bareJid in question.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param queryId The query that the page has been received for.
+ * @param resultSetReply The RSM cursors of the page.
+ * @param complete Whether the page was the last one available.
+ */
+void GkXmppMamSync::resultsReceived(const QString &queryId, const QXmppResultSetReply &resultSetReply, bool complete)
+{
+    const auto iter = m_active.find(queryId);
+    if (iter == m_active.end()) {
+        return; // Either not one of ours, or it has since been cancelled!
+    }
+
+    GkMamQuery query = iter.value();
+    m_active.erase(iter);
+    ++query.pages;
+
+    if (query.backwards) {
+        //
+        // The very first page holds the newest messages, and therefore where to resume from next time around
+        if (query.pages == 1 && !resultSetReply.last().isEmpty()) {
+            emit lastArchiveIdChanged(query.bareJid, resultSetReply.last());
+        }
+
+        if (complete || resultSetReply.first().isEmpty() || query.pages >= GK_XMPP_MAM_SYNC_INITIAL_MAX_PAGES) {
+            finish(query);
+            return;
+        }
+
+        query.cursor = resultSetReply.first();
+    } else {
+        if (!resultSetReply.last().isEmpty()) {
+            emit lastArchiveIdChanged(query.bareJid, resultSetReply.last());
+        }
+
+        if (complete || resultSetReply.last().isEmpty()) {
+            finish(query);
+            return;
+        }
+
+        query.cursor = resultSetReply.last();
+    }
+
+    requestPage(std::move(query));
+    return;
+}
+
+/**
+ * @brief GkXmppMamSync::expireQueries gives up on those queries that have gone unanswered for too long, such as those
+ * that the XMPP server has answered with an error, so that their places go towards the bareJids waiting. Whatever pages
+ * were received beforehand have already been accounted for, so the next sync resumes from there.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppMamSync::expireQueries()
+{
+    const qint64 now = m_clock.elapsed();
+    QList<GkMamQuery> expired;
+    for (auto iter = m_active.begin(); iter != m_active.end();) {
+        if (now - iter->updated >= GK_XMPP_MAM_SYNC_TIMEOUT_MS) {
+            expired.push_back(iter.value());
+            iter = m_active.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+
+    for (const auto &query: expired) {
+        finish(query);
+    }
+
+    if (m_active.isEmpty()) {
+        m_expiryTimer->stop();
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppMamSync::startWaiting starts on as many of the waiting bareJids as there is room for.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppMamSync::startWaiting()
+{
+    while (m_active.size() < GK_XMPP_MAM_SYNC_MAX_CONCURRENT && !m_waiting.empty()) {
+        const auto waiting = m_waiting.front();
+        m_waiting.pop_front();
+
+        GkMamQuery query;
+        query.bareJid = waiting.first;
+        query.cursor = waiting.second;
+        query.backwards = waiting.second.isEmpty();
+        query.pages = 0;
+        query.messages = 0;
+        query.updated = 0;
+        requestPage(std::move(query));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppMamSync::requestPage
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param query The bareJid and cursor that the page is to be requested for.
+ */
+void GkXmppMamSync::requestPage(GkMamQuery query)
+{
+    QXmppResultSetQuery resultSetQuery;
+    resultSetQuery.setMax(GK_XMPP_MAM_SYNC_PAGE_SIZE);
+    if (query.backwards) {
+        resultSetQuery.setBefore(query.cursor); // An empty cursor requests the newest page of all.
+    } else {
+        resultSetQuery.setAfter(query.cursor);
+    }
+
+    const QString queryId = m_xmppMamMgr ? m_xmppMamMgr->retrieveArchivedMessages({}, {}, query.bareJid, {}, {}, resultSetQuery) : QString();
+    if (queryId.isEmpty()) {
+        finish(query);
+        return;
+    }
+
+    query.updated = m_clock.elapsed();
+    m_active.insert(queryId, query);
+    if (!m_expiryTimer->isActive()) {
+        m_expiryTimer->start();
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppMamSync::finish
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param query The bareJid that has finished being synchronized.
+ */
+void GkXmppMamSync::finish(const GkMamQuery &query)
+{
+    emit syncFinished(query.bareJid, query.messages);
+    startWaiting();
+
+    return;
+}
@@ -0,0 +1,113 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include <deque>
+#include <QHash>
+#include <QTimer>
+#include <QString>
+#include <QObject>
+#include <QPointer>
+#include <QElapsedTimer>
+#include <qxmpp/QXmppMessage.h>
+#include <qxmpp/QXmppMamManager.h>
+#include <qxmpp/QXmppResultSet.h>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkXmppMamSync synchronizes the message archives (XEP-0313) of each bareJid, a page of
+ * GK_XMPP_MAM_SYNC_PAGE_SIZE messages at a time, by way of the RSM (XEP-0059) cursors that each page is returned with.
+ * A bareJid that has been synchronized before is resumed from the archive ID it was last left at, paging forwards; one
+ * that has not is paged backwards from the newest message, up to GK_XMPP_MAM_SYNC_INITIAL_MAX_PAGES. No more than
+ * GK_XMPP_MAM_SYNC_MAX_CONCURRENT bareJids are queried at once, with the remainder waiting their turn. A query that goes
+ * unanswered for GK_XMPP_MAM_SYNC_TIMEOUT_MS gives up its place to the next.
+ */
+class GkXmppMamSync : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GkXmppMamSync(QXmppMamManager *mamMgr, QObject *parent = nullptr);
+    ~GkXmppMamSync() override;
+
+    void requestSync(const QString &bareJid, const QString &lastArchiveId = QString());
+    void cancelAll();
+
+    [[nodiscard]] bool isSyncing(const QString &bareJid) const;
+    [[nodiscard]] qint32 activeQueries() const;
+    [[nodiscard]] qint32 waitingQueries() const;
+
+public slots:
+    void archivedMessageReceived(const QString &queryId, const QXmppMessage &message);
+    void resultsReceived(const QString &queryId, const QXmppResultSetReply &resultSetReply, bool complete);
+
+private slots:
+    void expireQueries();
+
+signals:
+    void lastArchiveIdChanged(const QString &bareJid, const QString &archiveId);
+    void syncFinished(const QString &bareJid, const qint32 &messages);
+    void syncCancelled();
+
+private:
+    struct GkMamQuery {
+        QString bareJid;
+        QString cursor;                 // The RSM cursor that the next page is to be requested from.
+        bool backwards;                 // Whether paging from the newest message towards the oldest, for a bareJid never synchronized before.
+        qint32 pages;                   // The amount of pages received so far.
+        qint32 messages;                // The amount of messages received so far.
+        qint64 updated;                 // When the page was last requested, or a message last received for it.
+    };
+
+    QPointer<QXmppMamManager> m_xmppMamMgr;
+    QHash<QString, GkMamQuery> m_active;                // The queries awaiting their results, keyed by query ID.
+    std::deque<std::pair<QString, QString>> m_waiting;  // The bareJids awaiting their turn, with their last archive ID.
+    QPointer<QTimer> m_expiryTimer;
+    QElapsedTimer m_clock;
+
+    void startWaiting();
+    void requestPage(GkMamQuery query);
+    void finish(const GkMamQuery &query);
+
+};
+};
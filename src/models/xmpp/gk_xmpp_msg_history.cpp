@@ -66,14 +66,14 @@ using namespace Logging;
  * @param err_msg
  * @param err
  */
-GkXmppMsgHistory::GkXmppMsgHistory(std::shared_ptr<QList<GekkoFyre::Network::GkXmpp::GkXmppCallsign>> rosterList,
+GkXmppMsgHistory::GkXmppMsgHistory(QPointer<GekkoFyre::GkXmppRosterStore> rosterStore,
                                    QPointer<GekkoFyre::StringFuncs> stringFuncs,
                                    QPointer<GekkoFyre::GkEventLogger> eventLogger, QObject *parent) : QObject(parent)
 {
     gkStringFuncs = std::move(stringFuncs);
     gkEventLogger = std::move(eventLogger);
-    if (rosterList) {
-        m_rosterList = std::move(rosterList);
+    if (rosterStore) {
+        m_rosterStore = std::move(rosterStore);
     }
 
     return;
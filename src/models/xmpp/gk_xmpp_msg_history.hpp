@@ -44,6 +44,7 @@
 #include "src/defines.hpp"
 #include "src/gk_logger.hpp"
 #include "src/gk_string_funcs.hpp"
+#include "src/models/xmpp/gk_xmpp_roster_store.hpp"
 #include <string>
 #include <memory>
 #include <QList>
@@ -57,7 +58,7 @@ class GkXmppMsgHistory : public QObject {
     Q_OBJECT
 
 public:
-    explicit GkXmppMsgHistory(std::shared_ptr<QList<GekkoFyre::Network::GkXmpp::GkXmppCallsign>> rosterList,
+    explicit GkXmppMsgHistory(QPointer<GekkoFyre::GkXmppRosterStore> rosterStore,
                               QPointer<GekkoFyre::StringFuncs> stringFuncs, QPointer<GekkoFyre::GkEventLogger> eventLogger,
                               QObject *parent = nullptr);
     virtual ~GkXmppMsgHistory();
@@ -71,7 +72,7 @@ private:
     //
     // User, roster and presence details
     //
-    std::shared_ptr<QList<GekkoFyre::Network::GkXmpp::GkXmppCallsign>> m_rosterList;   // A list of all the bareJids, including the client themselves!
+    QPointer<GekkoFyre::GkXmppRosterStore> m_rosterStore;                            // All the bareJids, including the client themselves, indexed by bareJid!
     QDir currPath;
 
     void recordMsgHistory(const QString &bareJid, const QList<Network::GkXmpp::GkXmppMamMsg> &mam_msg);
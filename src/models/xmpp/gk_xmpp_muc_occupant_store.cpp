@@ -0,0 +1,216 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/models/xmpp/gk_xmpp_muc_occupant_store.hpp"
+#include <qxmpp/QXmppUtils.h>
+
+using namespace GekkoFyre;
+using namespace Network;
+using namespace GkXmpp;
+
+/**
+ * @brief GkXmppMucOccupantStore::GkXmppMucOccupantStore
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param parent The parent object.
+ */
+GkXmppMucOccupantStore::GkXmppMucOccupantStore(QObject *parent) : QObject(parent)
+{
+    m_flushTimer = new QTimer(this);
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(GK_XMPP_MUC_OCCUPANT_FLUSH_MS);
+    QObject::connect(m_flushTimer, SIGNAL(timeout()), this, SLOT(flush()));
+
+    return;
+}
+
+GkXmppMucOccupantStore::~GkXmppMucOccupantStore()
+{}
+
+/**
+ * @brief GkXmppMucOccupantStore::enqueuePresence gathers up the given presence towards the next batch, replacing any
+ * presence of the same occupant that is already waiting.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param jid The occupant JID.
+ * @param presence The presence of the occupant, which is QXmppPresence::Unavailable should they have left the MUC.
+ */
+void GkXmppMucOccupantStore::enqueuePresence(const QString &jid, const QXmppPresence &presence)
+{
+    if (jid.isEmpty()) {
+        return;
+    }
+
+    m_pending.insert(jid, presence);
+    if (m_pending.size() >= GK_XMPP_MUC_OCCUPANT_FLUSH_MAX) {
+        flush();
+        return;
+    }
+
+    if (!m_flushTimer->isActive()) {
+        m_flushTimer->start();
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppMucOccupantStore::clear removes every occupant, including those yet to be applied, such as upon leaving
+ * the MUC or disconnecting from the XMPP server.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppMucOccupantStore::clear()
+{
+    m_flushTimer->stop();
+    m_pending.clear();
+    m_occupants.clear();
+    emit occupantsCleared();
+
+    return;
+}
+
+/**
+ * @brief GkXmppMucOccupantStore::contains
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param jid The occupant JID.
+ * @return Whether the occupant is present within the MUC, as of the last batch.
+ */
+bool GkXmppMucOccupantStore::contains(const QString &jid) const
+{
+    return m_occupants.contains(jid);
+}
+
+/**
+ * @brief GkXmppMucOccupantStore::get
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param jid The occupant JID.
+ * @return The occupant in question, or one with an empty JID should they not be present.
+ */
+GkXmppMucOccupant GkXmppMucOccupantStore::get(const QString &jid) const
+{
+    return m_occupants.value(jid);
+}
+
+/**
+ * @brief GkXmppMucOccupantStore::occupants
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return Every occupant, in no particular order.
+ */
+QList<GkXmppMucOccupant> GkXmppMucOccupantStore::occupants() const
+{
+    return m_occupants.values();
+}
+
+/**
+ * @brief GkXmppMucOccupantStore::size
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The amount of occupants, as of the last batch.
+ */
+qint32 GkXmppMucOccupantStore::size() const
+{
+    return m_occupants.size();
+}
+
+/**
+ * @brief GkXmppMucOccupantStore::pendingPresences
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The amount of occupants whose presences are yet to be applied.
+ */
+qint32 GkXmppMucOccupantStore::pendingPresences() const
+{
+    return m_pending.size();
+}
+
+/**
+ * @brief GkXmppMucOccupantStore::toOccupant
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param jid The occupant JID.
+ * @param presence The presence of the occupant, as received from the MUC.
+ * @return The details of the occupant, as derived from their presence.
+ */
+GkXmppMucOccupant GkXmppMucOccupantStore::toOccupant(const QString &jid, const QXmppPresence &presence)
+{
+    GkXmppMucOccupant occupant;
+    occupant.jid = jid;
+    occupant.nickName = QXmppUtils::jidToResource(jid);
+    occupant.realJid = QXmppUtils::jidToBareJid(presence.mucItem().jid());
+    occupant.role = presence.mucItem().role();
+    occupant.affiliation = presence.mucItem().affiliation();
+    occupant.status = presence.availableStatusType();
+    occupant.photoHash = presence.photoHash();
+
+    return occupant;
+}
+
+/**
+ * @brief GkXmppMucOccupantStore::flush applies every presence gathered up since the last batch, and then hands the
+ * batch onwards as a whole.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppMucOccupantStore::flush()
+{
+    m_flushTimer->stop();
+    if (m_pending.isEmpty()) {
+        return;
+    }
+
+    QList<GkXmppMucOccupant> upserted;
+    QStringList removed;
+    upserted.reserve(m_pending.size());
+    for (auto iter = m_pending.constBegin(); iter != m_pending.constEnd(); ++iter) {
+        if (iter.value().type() == QXmppPresence::Unavailable) {
+            if (m_occupants.remove(iter.key())) {
+                removed.push_back(iter.key());
+            }
+
+            continue;
+        }
+
+        const auto occupant = toOccupant(iter.key(), iter.value());
+        m_occupants.insert(occupant.jid, occupant);
+        upserted.push_back(occupant);
+    }
+
+    m_pending.clear();
+    if (!upserted.isEmpty() || !removed.isEmpty()) {
+        emit occupantsChanged(upserted, removed);
+    }
+
+    return;
+}
@@ -0,0 +1,93 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include <QHash>
+#include <QList>
+#include <QTimer>
+#include <QString>
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+#include <qxmpp/QXmppPresence.h>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkXmppMucOccupantStore holds the occupants of a single MUC, indexed by occupant JID. Upon joining a busy MUC,
+ * the XMPP server sends the presence of every occupant all at once, so the presences are gathered up for
+ * GK_XMPP_MUC_OCCUPANT_FLUSH_MS (or until GK_XMPP_MUC_OCCUPANT_FLUSH_MAX have been) and then applied as one batch, with
+ * only the latest presence of each occupant being kept, rather than each being handed onwards as it arrives.
+ */
+class GkXmppMucOccupantStore : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GkXmppMucOccupantStore(QObject *parent = nullptr);
+    ~GkXmppMucOccupantStore() override;
+
+    void enqueuePresence(const QString &jid, const QXmppPresence &presence);
+    void clear();
+
+    [[nodiscard]] bool contains(const QString &jid) const;
+    [[nodiscard]] Network::GkXmpp::GkXmppMucOccupant get(const QString &jid) const;
+    [[nodiscard]] QList<Network::GkXmpp::GkXmppMucOccupant> occupants() const;
+    [[nodiscard]] qint32 size() const;
+    [[nodiscard]] qint32 pendingPresences() const;
+
+    [[nodiscard]] static Network::GkXmpp::GkXmppMucOccupant toOccupant(const QString &jid, const QXmppPresence &presence);
+
+public slots:
+    void flush();
+
+signals:
+    void occupantsChanged(const QList<GekkoFyre::Network::GkXmpp::GkXmppMucOccupant> &upserted, const QStringList &removed);
+    void occupantsCleared();
+
+private:
+    QHash<QString, Network::GkXmpp::GkXmppMucOccupant> m_occupants;    // Keyed by occupant JID.
+    QHash<QString, QXmppPresence> m_pending;                            // The latest presence of each occupant yet to be applied, keyed by occupant JID.
+    QPointer<QTimer> m_flushTimer;
+
+};
+};
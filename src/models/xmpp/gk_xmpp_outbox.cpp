@@ -0,0 +1,463 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/models/xmpp/gk_xmpp_outbox.hpp"
+#include <variant>
+#include <algorithm>
+#include <utility>
+#include <QUuid>
+#include <QBuffer>
+#include <QDateTime>
+#include <QDomDocument>
+#include <QFutureWatcher>
+#include <QXmlStreamWriter>
+#include <qxmpp/QXmppUtils.h>
+
+using namespace GekkoFyre;
+
+/**
+ * @brief GkXmppOutbox::GkXmppOutbox
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param client The XMPP client that the messages are to be sent via.
+ * @param database The Google LevelDB database that the messages are spooled towards.
+ * @param clientJid The bareJid of the client themselves, under which the messages are spooled.
+ * @param parent The parent object.
+ */
+GkXmppOutbox::GkXmppOutbox(QXmppClient *client, QPointer<GkLevelDb> database, const QString &clientJid,
+                           QObject *parent) : QObject(parent), m_client(client)
+{
+    gkDb = std::move(database);
+    m_clientJid = QXmppUtils::jidToBareJid(clientJid);
+
+    m_flushTimer = new QTimer(this);
+    m_flushTimer->setSingleShot(true);
+    QObject::connect(m_flushTimer, SIGNAL(timeout()), this, SLOT(flush()));
+
+    m_retryTimer = new QTimer(this);
+    m_retryTimer->setSingleShot(true);
+    QObject::connect(m_retryTimer, SIGNAL(timeout()), this, SLOT(flush()));
+
+    return;
+}
+
+GkXmppOutbox::~GkXmppOutbox()
+{}
+
+/**
+ * @brief GkXmppOutbox::enqueue queues the given message and spools it towards Google LevelDB, to be sent along with any
+ * others that are queued within the next GK_XMPP_OUTBOX_FLUSH_MS, or otherwise once there is a connection again.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param message The message to be sent. A stanza ID is given should it not have one already, as it is needed to match
+ * up the delivery receipt.
+ * @return Whether the message was queued, which it will not be should GK_XMPP_OUTBOX_MAX_QUEUE already be waiting upon
+ * the XMPP server to acknowledge them.
+ */
+bool GkXmppOutbox::enqueue(const QXmppMessage &message)
+{
+    const auto waiting = std::count_if(m_entries.cbegin(), m_entries.cend(), [](const GkOutboxEntry &entry) {
+        return !entry.acked;
+    });
+
+    if (waiting >= GK_XMPP_OUTBOX_MAX_QUEUE) {
+        return false;
+    }
+
+    GkOutboxEntry entry;
+    entry.message = message;
+    entry.queuedAt = QDateTime::currentMSecsSinceEpoch();
+    entry.attempts = 0;
+    entry.nextAttempt = 0;
+    entry.acked = false;
+    if (entry.message.id().isEmpty()) {
+        entry.message.setId(QUuid::createUuid().toString(QUuid::WithoutBraces));
+    }
+
+    //
+    // Receipts are only ever for one-to-one messages (XEP-0184 §5.3), never those sent towards a groupchat
+    entry.message.setReceiptRequested(entry.message.type() != QXmppMessage::GroupChat);
+
+    try {
+        entry.key = gkDb->write_xmpp_outbox(m_clientJid, entry.message.id(), entry.queuedAt, toXml(entry.message));
+    } catch (const std::exception &e) {
+        //
+        // The message is still sent, it just will not survive a restart
+        emit spoolError(QString::fromStdString(e.what()));
+    }
+
+    m_entries.push_back(entry);
+    if (!m_flushTimer->isActive()) {
+        m_flushTimer->start(GK_XMPP_OUTBOX_FLUSH_MS);
+    }
+
+    return true;
+}
+
+/**
+ * @brief GkXmppOutbox::restore queues once more whatever messages were still spooled when Small World Deluxe was last
+ * closed, ahead of any queued since, along with which recipients are known to send receipts.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppOutbox::restore()
+{
+    try {
+        m_receiptCapable.unite(gkDb->read_xmpp_receipt_capable(m_clientJid));
+
+        //
+        // The spooled keys begin with when the message was queued, as per GkLevelDb::write_xmpp_outbox()
+        const qint32 prefix = QString("%1_%2!").arg(m_clientJid).arg(General::Xmpp::GoogleLevelDb::keyToConvOutbox).size();
+
+        QList<GkOutboxEntry> restored;
+        const QSet<QString> acked = gkDb->read_xmpp_outbox_acked(m_clientJid);
+        for (const auto &stanza: gkDb->read_xmpp_outbox(m_clientJid)) {
+            GkOutboxEntry entry;
+            entry.key = stanza.first;
+            entry.message = fromXml(stanza.second);
+            entry.queuedAt = entry.key.mid(prefix, 20).toLongLong();
+            entry.acked = acked.contains(entry.message.id());
+            entry.attempts = entry.acked ? 1 : 0;
+            entry.nextAttempt = 0;
+            if (entry.message.id().isEmpty() || entry.message.to().isEmpty()) {
+                unspool(entry); // Not something that can ever be sent!
+                continue;
+            }
+
+            const bool queued = std::any_of(m_entries.cbegin(), m_entries.cend(), [&entry](const GkOutboxEntry &existing) {
+                return existing.key == entry.key;
+            });
+
+            if (!queued) {
+                restored.push_back(entry);
+            }
+        }
+
+        if (!restored.isEmpty()) {
+            m_entries = restored + m_entries;
+            if (!m_flushTimer->isActive()) {
+                m_flushTimer->start(GK_XMPP_OUTBOX_FLUSH_MS);
+            }
+        }
+    } catch (const std::exception &e) {
+        emit spoolError(QString::fromStdString(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppOutbox::resend makes every message that the XMPP server has yet to acknowledge due at once, which is only
+ * to be done upon a new stream being made towards the server, as anything unacknowledged upon the old one may well have
+ * been lost along with it. A resumed stream (XEP-0198) has the server resend whatever went unacknowledged by itself, and
+ * a message that the server has acknowledged is left alone, as the server will have stored it for an offline recipient.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppOutbox::resend()
+{
+    for (auto &entry: m_entries) {
+        if (!entry.acked) {
+            entry.nextAttempt = 0;
+        }
+    }
+
+    flush();
+    return;
+}
+
+/**
+ * @brief GkXmppOutbox::size
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The amount of messages either waiting to be sent or awaiting their receipt.
+ */
+qint32 GkXmppOutbox::size() const
+{
+    return m_entries.size();
+}
+
+/**
+ * @brief GkXmppOutbox::isEmpty
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return Whether there are no messages waiting at all.
+ */
+bool GkXmppOutbox::isEmpty() const
+{
+    return m_entries.isEmpty();
+}
+
+/**
+ * @brief GkXmppOutbox::flush sends every message that is due, all within the one pass, so that they are written out
+ * towards the socket together once control returns to the event loop. Does nothing whilst there is no connection, as
+ * the messages remain spooled until there is. Those still awaiting their receipt are then flushed once more as soon as
+ * the next of them is due.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppOutbox::flush()
+{
+    m_flushTimer->stop();
+    m_retryTimer->stop();
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    expireAwaiting(now);
+    if (m_entries.isEmpty() || !m_client || !m_client->isConnected()) {
+        return;
+    }
+
+    qint64 nextDue = 0;
+    for (auto iter = m_entries.begin(); iter != m_entries.end();) {
+        const QString bareJid = QXmppUtils::jidToBareJid(iter->message.to());
+        if (iter->acked) {
+            ++iter; // The server has stored the message, so all that remains is to await its receipt
+            continue;
+        }
+
+        if (iter->nextAttempt > now) {
+            nextDue = (nextDue == 0) ? iter->nextAttempt : std::min(nextDue, iter->nextAttempt);
+            ++iter;
+            continue;
+        }
+
+        if (iter->attempts >= GK_XMPP_OUTBOX_MAX_ATTEMPTS) {
+            emit messageFailed(bareJid, iter->message.id());
+            unspool(*iter);
+            iter = m_entries.erase(iter);
+            continue;
+        }
+
+        const auto future = m_client->send(QXmppMessage(iter->message));
+        if (future.isFinished() && std::holds_alternative<QXmpp::SendError>(future.result())) {
+            break; // The stream has since gone, so whatever remains waits for the next one!
+        }
+
+        ++iter->attempts;
+        if (iter->attempts == 1) {
+            emit messageSent(bareJid, iter->message.id());
+        }
+
+        if (!iter->message.isReceiptRequested() || !m_receiptCapable.contains(bareJid)) {
+            //
+            // There is no telling whether a receipt will ever arrive, and sending the message again towards a recipient
+            // that never sends them would only ever show up as duplicates
+            unspool(*iter);
+            iter = m_entries.erase(iter);
+            continue;
+        }
+
+        iter->nextAttempt = now + backoff(iter->attempts);
+        nextDue = (nextDue == 0) ? iter->nextAttempt : std::min(nextDue, iter->nextAttempt);
+        watchAck(iter->message.id(), future);
+        ++iter;
+    }
+
+    if (nextDue > 0) {
+        m_retryTimer->start(static_cast<qint32>(std::max<qint64>(nextDue - now, 0)));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppOutbox::receiptReceived is executed once a delivery receipt (XEP-0184) has been received, and is done
+ * with the message in question.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param jid The recipient that has sent the receipt.
+ * @param id The stanza ID of the message that has been delivered.
+ */
+void GkXmppOutbox::receiptReceived(const QString &jid, const QString &id)
+{
+    const QString bareJid = QXmppUtils::jidToBareJid(jid);
+    if (!m_receiptCapable.contains(bareJid)) {
+        m_receiptCapable.insert(bareJid);
+        try {
+            gkDb->write_xmpp_receipt_capable(m_clientJid, bareJid);
+        } catch (const std::exception &e) {
+            emit spoolError(QString::fromStdString(e.what()));
+        }
+    }
+
+    for (auto iter = m_entries.begin(); iter != m_entries.end(); ++iter) {
+        if (iter->message.id() == id && QXmppUtils::jidToBareJid(iter->message.to()) == bareJid) {
+            unspool(*iter);
+            m_entries.erase(iter);
+            emit messageDelivered(bareJid, id);
+            break;
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppOutbox::watchAck marks the given message as acknowledged once the XMPP server has done so (XEP-0198),
+ * after which it is never sent again. Without stream management the server acknowledges nothing, and the message is
+ * instead sent again as per GkXmppOutbox::backoff() until its receipt arrives.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param id The stanza ID of the message that was sent.
+ * @param future The result of sending the message.
+ */
+void GkXmppOutbox::watchAck(const QString &id, const QFuture<QXmpp::SendResult> &future)
+{
+    auto watcher = new QFutureWatcher<QXmpp::SendResult>(this);
+    QObject::connect(watcher, &QFutureWatcher<QXmpp::SendResult>::finished, this, [this, watcher, id]() {
+        const auto result = watcher->result();
+        watcher->deleteLater();
+
+        const auto success = std::get_if<QXmpp::SendSuccess>(&result);
+        if (!success || !success->acknowledged) {
+            return;
+        }
+
+        for (auto &entry: m_entries) {
+            if (entry.message.id() == id) {
+                entry.acked = true;
+                try {
+                    gkDb->write_xmpp_outbox_acked(m_clientJid, id, true);
+                } catch (const std::exception &e) {
+                    emit spoolError(QString::fromStdString(e.what()));
+                }
+
+                expireAwaiting(QDateTime::currentMSecsSinceEpoch());
+                break;
+            }
+        }
+    });
+
+    watcher->setFuture(future);
+    return;
+}
+
+/**
+ * @brief GkXmppOutbox::expireAwaiting lets go of those messages that the XMPP server has acknowledged but whose receipt
+ * has yet to arrive after GK_XMPP_OUTBOX_AWAITING_EXPIRY_MS, along with the oldest of them should there be more than
+ * GK_XMPP_OUTBOX_MAX_AWAITING. The server has already stored them for the recipient, so nothing is lost besides knowing
+ * when they were delivered.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param now The current time, in milliseconds since the epoch.
+ */
+void GkXmppOutbox::expireAwaiting(const qint64 &now)
+{
+    auto awaiting = std::count_if(m_entries.cbegin(), m_entries.cend(), [](const GkOutboxEntry &entry) {
+        return entry.acked;
+    });
+
+    //
+    // The entries are in the order that they were queued, so the oldest are always reached first
+    for (auto iter = m_entries.begin(); iter != m_entries.end() && awaiting > 0;) {
+        if (!iter->acked) {
+            ++iter;
+            continue;
+        }
+
+        if (awaiting <= GK_XMPP_OUTBOX_MAX_AWAITING && iter->queuedAt + GK_XMPP_OUTBOX_AWAITING_EXPIRY_MS > now) {
+            ++iter;
+            continue;
+        }
+
+        unspool(*iter);
+        iter = m_entries.erase(iter);
+        --awaiting;
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppOutbox::unspool removes the given message from Google LevelDB.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param entry The message in question.
+ */
+void GkXmppOutbox::unspool(const GkOutboxEntry &entry)
+{
+    try {
+        gkDb->remove_xmpp_outbox(entry.key);
+        if (entry.acked) {
+            gkDb->write_xmpp_outbox_acked(m_clientJid, entry.message.id(), false);
+        }
+    } catch (const std::exception &e) {
+        emit spoolError(QString::fromStdString(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppOutbox::backoff
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param attempts How many times the message has been sent thus far.
+ * @return How long to await the receipt before sending the message again, in milliseconds, which doubles with each
+ * attempt from GK_XMPP_OUTBOX_RECEIPT_TIMEOUT_MS up until GK_XMPP_OUTBOX_RETRY_MAX_MS.
+ */
+qint64 GkXmppOutbox::backoff(const qint32 &attempts)
+{
+    const qint32 shift = std::min(std::max(attempts - 1, 0), 16);
+    return std::min<qint64>(static_cast<qint64>(GK_XMPP_OUTBOX_RECEIPT_TIMEOUT_MS) << shift, GK_XMPP_OUTBOX_RETRY_MAX_MS);
+}
+
+/**
+ * @brief GkXmppOutbox::toXml
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param message The message to be spooled.
+ * @return The message, as serialized XML.
+ */
+QByteArray GkXmppOutbox::toXml(const QXmppMessage &message)
+{
+    QByteArray stanza;
+    QBuffer buffer(&stanza);
+    buffer.open(QIODevice::WriteOnly);
+    QXmlStreamWriter stream(&buffer);
+    message.toXml(&stream);
+
+    return stanza;
+}
+
+/**
+ * @brief GkXmppOutbox::fromXml
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param stanza The message, as serialized XML.
+ * @return The message itself, or an empty one should the XML not be parsed.
+ */
+QXmppMessage GkXmppOutbox::fromXml(const QByteArray &stanza)
+{
+    QXmppMessage message;
+    QDomDocument doc;
+    if (doc.setContent(stanza, true)) {
+        message.parse(doc.documentElement());
+    }
+
+    return message;
+}
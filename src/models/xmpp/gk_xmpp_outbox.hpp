@@ -0,0 +1,122 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include "src/dek_db.hpp"
+#include <QSet>
+#include <QList>
+#include <QTimer>
+#include <QString>
+#include <QObject>
+#include <QPointer>
+#include <QByteArray>
+#include <QFuture>
+#include <qxmpp/QXmppClient.h>
+#include <qxmpp/QXmppGlobal.h>
+#include <qxmpp/QXmppMessage.h>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkXmppOutbox queues each outgoing message, spooling it towards Google LevelDB until it has been delivered so
+ * that nothing is lost whilst the connection is down, nor upon Small World Deluxe being restarted. Messages are gathered
+ * up for GK_XMPP_OUTBOX_FLUSH_MS and then sent all at once, in the order they were queued. A delivery receipt (XEP-0184)
+ * is requested for each one-to-one message, and for those recipients known to send receipts, the message is sent again
+ * with an exponential backoff until either the receipt arrives or GK_XMPP_OUTBOX_MAX_ATTEMPTS have been made. Once the
+ * XMPP server has acknowledged a message (XEP-0198) it is never sent again, as the server has stored it for the recipient
+ * and all that remains is to await the receipt, which it does apart from GK_XMPP_OUTBOX_MAX_QUEUE so as to never hold
+ * up the sending of anything else. Messages towards any other recipient, or towards a groupchat, are done with once
+ * they have been sent.
+ */
+class GkXmppOutbox : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GkXmppOutbox(QXmppClient *client, QPointer<GekkoFyre::GkLevelDb> database, const QString &clientJid,
+                          QObject *parent = nullptr);
+    ~GkXmppOutbox() override;
+
+    bool enqueue(const QXmppMessage &message);
+    void restore();
+    void resend();
+
+    [[nodiscard]] qint32 size() const;
+    [[nodiscard]] bool isEmpty() const;
+
+public slots:
+    void flush();
+    void receiptReceived(const QString &jid, const QString &id);
+
+signals:
+    void messageSent(const QString &bareJid, const QString &id);
+    void messageDelivered(const QString &bareJid, const QString &id);
+    void messageFailed(const QString &bareJid, const QString &id);
+    void spoolError(const QString &error);
+
+private:
+    struct GkOutboxEntry {
+        QString key;                    // Where the message is spooled within Google LevelDB, if at all.
+        QXmppMessage message;
+        qint64 queuedAt;                // When the message was queued, in milliseconds since the epoch.
+        qint32 attempts;                // How many times the message has been sent thus far.
+        qint64 nextAttempt;             // When the message is next due to be sent, in milliseconds since the epoch.
+        bool acked;                     // Whether the XMPP server has acknowledged the message (XEP-0198).
+    };
+
+    QPointer<QXmppClient> m_client;
+    QPointer<GekkoFyre::GkLevelDb> gkDb;
+    QString m_clientJid;
+    QList<GkOutboxEntry> m_entries;                     // In the order that they were queued.
+    QSet<QString> m_receiptCapable;                     // The bareJids that have sent a delivery receipt before, as spooled.
+    QPointer<QTimer> m_flushTimer;                      // Gathers up a burst of messages, so that they are sent together.
+    QPointer<QTimer> m_retryTimer;                      // Until the next message awaiting its receipt is due once more.
+
+    void watchAck(const QString &id, const QFuture<QXmpp::SendResult> &future);
+    void expireAwaiting(const qint64 &now);
+    void unspool(const GkOutboxEntry &entry);
+    [[nodiscard]] static qint64 backoff(const qint32 &attempts);
+    [[nodiscard]] static QByteArray toXml(const QXmppMessage &message);
+    [[nodiscard]] static QXmppMessage fromXml(const QByteArray &stanza);
+
+};
+};
@@ -0,0 +1,313 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/models/xmpp/gk_xmpp_roster_store.hpp"
+#include <utility>
+
+using namespace GekkoFyre;
+using namespace Network;
+using namespace GkXmpp;
+
+/**
+ * @brief GkXmppRosterStore::GkXmppRosterStore
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param parent The parent object.
+ */
+GkXmppRosterStore::GkXmppRosterStore(QObject *parent) : QObject(parent), m_nextHandle(1)
+{
+    return;
+}
+
+GkXmppRosterStore::~GkXmppRosterStore()
+{}
+
+/**
+ * @brief GkXmppRosterStore::insert adds the given bareJid towards the roster or, should it already be present, replaces
+ * its details whilst keeping the same handle.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param callsign The details of the bareJid in question.
+ * @return The handle of the entry.
+ */
+GkXmppRosterHandle GkXmppRosterStore::insert(const GkXmppCallsign &callsign)
+{
+    GkXmppRosterHandle handle = 0;
+    bool added = false;
+    {
+        std::lock_guard<std::mutex> lock_guard(mtx_roster);
+        auto entry = std::make_shared<const GkXmppCallsign>(callsign);
+        const auto iter = m_index.constFind(callsign.bareJid);
+        if (iter != m_index.constEnd()) {
+            handle = iter.value();
+            m_entries[handle] = std::move(entry);
+        } else {
+            handle = m_nextHandle++;
+            m_entries.emplace(handle, std::move(entry));
+            m_index.insert(callsign.bareJid, handle);
+            added = true;
+        }
+    }
+
+    if (added) {
+        emit entryAdded(callsign.bareJid);
+    } else {
+        notifyFields(callsign.bareJid, Presence | VCard | Subscription | Messages | MsgWindow);
+    }
+
+    return handle;
+}
+
+/**
+ * @brief GkXmppRosterStore::remove
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user in question.
+ * @return Whether the bareJid was present, and has now been removed.
+ */
+bool GkXmppRosterStore::remove(const QString &bareJid)
+{
+    {
+        std::lock_guard<std::mutex> lock_guard(mtx_roster);
+        const auto iter = m_index.find(bareJid);
+        if (iter == m_index.end()) {
+            return false;
+        }
+
+        m_entries.erase(iter.value());
+        m_index.erase(iter);
+    }
+
+    emit entryRemoved(bareJid);
+    return true;
+}
+
+/**
+ * @brief GkXmppRosterStore::clear removes every entry, such as upon disconnecting from the XMPP server. The handles of
+ * the removed entries are never handed out again.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppRosterStore::clear()
+{
+    QList<QString> removed;
+    {
+        std::lock_guard<std::mutex> lock_guard(mtx_roster);
+        removed = m_index.keys();
+        m_entries.clear();
+        m_index.clear();
+    }
+
+    for (const auto &bareJid: removed) {
+        emit entryRemoved(bareJid);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppRosterStore::update modifies a copy of the given entry, which then takes the place of the original. Any
+ * snapshots already held by readers are left untouched.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user in question.
+ * @param fields Which of GkXmppRosterStore::GkRosterField are modified, so that only they are notified of.
+ * @param modifier Makes the modification, whilst the roster is locked. It must not call back into the roster!
+ * @return Whether the bareJid was present.
+ */
+bool GkXmppRosterStore::update(const QString &bareJid, const quint32 &fields, const std::function<void(GkXmppCallsign &)> &modifier)
+{
+    return update(find(bareJid), fields, modifier);
+}
+
+/**
+ * @brief GkXmppRosterStore::update modifies a copy of the given entry, which then takes the place of the original. Any
+ * snapshots already held by readers are left untouched.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param handle The entry in question.
+ * @param fields Which of GkXmppRosterStore::GkRosterField are modified, so that only they are notified of.
+ * @param modifier Makes the modification, whilst the roster is locked. It must not call back into the roster!
+ * @return Whether the entry was present.
+ */
+bool GkXmppRosterStore::update(const GkXmppRosterHandle &handle, const quint32 &fields, const std::function<void(GkXmppCallsign &)> &modifier)
+{
+    QString bareJid;
+    {
+        std::lock_guard<std::mutex> lock_guard(mtx_roster);
+        const auto iter = m_entries.find(handle);
+        if (iter == m_entries.end()) {
+            return false;
+        }
+
+        //
+        // The lists of messages within each entry are implicitly shared, so the copy is cheap until they are modified
+        auto entry = std::make_shared<GkXmppCallsign>(*iter->second);
+        modifier(*entry);
+        bareJid = entry->bareJid;
+        iter->second = std::move(entry);
+    }
+
+    notifyFields(bareJid, fields);
+    return true;
+}
+
+/**
+ * @brief GkXmppRosterStore::find
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user in question.
+ * @return The handle of the given bareJid, or zero should it not be present.
+ */
+GkXmppRosterHandle GkXmppRosterStore::find(const QString &bareJid) const
+{
+    std::lock_guard<std::mutex> lock_guard(mtx_roster);
+    return m_index.value(bareJid, 0);
+}
+
+/**
+ * @brief GkXmppRosterStore::contains
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user in question.
+ * @return Whether the given bareJid is present within the roster.
+ */
+bool GkXmppRosterStore::contains(const QString &bareJid) const
+{
+    std::lock_guard<std::mutex> lock_guard(mtx_roster);
+    return m_index.contains(bareJid);
+}
+
+/**
+ * @brief GkXmppRosterStore::get
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user in question.
+ * @return A snapshot of the given bareJid, or nullptr should it not be present.
+ */
+std::shared_ptr<const GkXmppCallsign> GkXmppRosterStore::get(const QString &bareJid) const
+{
+    std::lock_guard<std::mutex> lock_guard(mtx_roster);
+    const auto iter = m_index.constFind(bareJid);
+    if (iter == m_index.constEnd()) {
+        return nullptr;
+    }
+
+    return m_entries.at(iter.value());
+}
+
+/**
+ * @brief GkXmppRosterStore::get
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param handle The entry in question.
+ * @return A snapshot of the given entry, or nullptr should it not be present.
+ */
+std::shared_ptr<const GkXmppCallsign> GkXmppRosterStore::get(const GkXmppRosterHandle &handle) const
+{
+    std::lock_guard<std::mutex> lock_guard(mtx_roster);
+    const auto iter = m_entries.find(handle);
+    if (iter == m_entries.end()) {
+        return nullptr;
+    }
+
+    return iter->second;
+}
+
+/**
+ * @brief GkXmppRosterStore::snapshot
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return Every entry as it currently stands, in the order that they were first inserted.
+ */
+QList<std::shared_ptr<const GkXmppCallsign>> GkXmppRosterStore::snapshot() const
+{
+    QList<std::shared_ptr<const GkXmppCallsign>> entries;
+    std::lock_guard<std::mutex> lock_guard(mtx_roster);
+    entries.reserve(static_cast<qint32>(m_entries.size()));
+    for (const auto &entry: m_entries) {
+        entries.push_back(entry.second);
+    }
+
+    return entries;
+}
+
+/**
+ * @brief GkXmppRosterStore::size
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The number of bareJids within the roster.
+ */
+qint32 GkXmppRosterStore::size() const
+{
+    std::lock_guard<std::mutex> lock_guard(mtx_roster);
+    return m_index.size();
+}
+
+/**
+ * @brief GkXmppRosterStore::isEmpty
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return Whether the roster has no bareJids at all.
+ */
+bool GkXmppRosterStore::isEmpty() const
+{
+    std::lock_guard<std::mutex> lock_guard(mtx_roster);
+    return m_index.isEmpty();
+}
+
+/**
+ * @brief GkXmppRosterStore::notifyFields emits a signal for each of the given fields, once the roster is unlocked.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user in question.
+ * @param fields Which of GkXmppRosterStore::GkRosterField have been modified.
+ */
+void GkXmppRosterStore::notifyFields(const QString &bareJid, const quint32 &fields)
+{
+    if (fields & Presence) {
+        emit presenceUpdated(bareJid);
+    }
+
+    if (fields & VCard) {
+        emit vCardUpdated(bareJid);
+    }
+
+    if (fields & Subscription) {
+        emit subscriptionUpdated(bareJid);
+    }
+
+    if (fields & Messages) {
+        emit messagesUpdated(bareJid);
+    }
+
+    if (fields & MsgWindow) {
+        emit msgWindowUpdated(bareJid);
+    }
+
+    return;
+}
@@ -0,0 +1,113 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include <map>
+#include <mutex>
+#include <memory>
+#include <functional>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QObject>
+
+namespace GekkoFyre {
+
+using GkXmppRosterHandle = quint64;                                             // Zero is never handed out, and so means 'not found'.
+
+/**
+ * @brief GkXmppRosterStore holds every bareJid known to the XMPP client (including the client themselves), indexed by
+ * bareJid so that lookups made upon each presence change, message and repaint no longer walk the whole roster. Each
+ * entry is given a handle that stays the same for as long as the entry remains, and is kept as an immutable snapshot
+ * that is swapped out whole upon being updated, so that readers upon any thread may hold onto an entry without locking.
+ */
+class GkXmppRosterStore : public QObject {
+    Q_OBJECT
+
+public:
+    enum GkRosterField {
+        Presence = 0x01,
+        VCard = 0x02,
+        Subscription = 0x04,
+        Messages = 0x08,
+        MsgWindow = 0x10
+    };
+
+    explicit GkXmppRosterStore(QObject *parent = nullptr);
+    ~GkXmppRosterStore() override;
+
+    GkXmppRosterHandle insert(const Network::GkXmpp::GkXmppCallsign &callsign);
+    bool remove(const QString &bareJid);
+    void clear();
+    bool update(const QString &bareJid, const quint32 &fields, const std::function<void(Network::GkXmpp::GkXmppCallsign &)> &modifier);
+    bool update(const GkXmppRosterHandle &handle, const quint32 &fields, const std::function<void(Network::GkXmpp::GkXmppCallsign &)> &modifier);
+
+    [[nodiscard]] GkXmppRosterHandle find(const QString &bareJid) const;
+    [[nodiscard]] bool contains(const QString &bareJid) const;
+    [[nodiscard]] std::shared_ptr<const Network::GkXmpp::GkXmppCallsign> get(const QString &bareJid) const;
+    [[nodiscard]] std::shared_ptr<const Network::GkXmpp::GkXmppCallsign> get(const GkXmppRosterHandle &handle) const;
+    [[nodiscard]] QList<std::shared_ptr<const Network::GkXmpp::GkXmppCallsign>> snapshot() const;
+    [[nodiscard]] qint32 size() const;
+    [[nodiscard]] bool isEmpty() const;
+
+signals:
+    void entryAdded(const QString &bareJid);
+    void entryRemoved(const QString &bareJid);
+    void presenceUpdated(const QString &bareJid);
+    void vCardUpdated(const QString &bareJid);
+    void subscriptionUpdated(const QString &bareJid);
+    void messagesUpdated(const QString &bareJid);
+    void msgWindowUpdated(const QString &bareJid);
+
+private:
+    //
+    // The entries are ordered by their handles, and therefore by when they were first inserted
+    std::map<GkXmppRosterHandle, std::shared_ptr<const Network::GkXmpp::GkXmppCallsign>> m_entries;
+    QHash<QString, GkXmppRosterHandle> m_index;
+    GkXmppRosterHandle m_nextHandle;
+    mutable std::mutex mtx_roster;
+
+    void notifyFields(const QString &bareJid, const quint32 &fields);
+
+};
+};
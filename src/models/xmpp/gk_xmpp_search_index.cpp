@@ -0,0 +1,510 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/models/xmpp/gk_xmpp_search_index.hpp"
+#include <limits>
+#include <algorithm>
+#include <vector>
+#include <utility>
+#include <exception>
+#include <stdexcept>
+#include <unicode/locid.h>
+#include <unicode/unistr.h>
+#include <QByteArray>
+#include <QDataStream>
+
+using namespace GekkoFyre;
+using namespace Network;
+using namespace GkXmpp;
+
+namespace {
+constexpr char termSeparator = '\x01';                                          // Sorts before any character that a word may contain.
+constexpr qint32 invertedTimestampWidth = std::numeric_limits<qint64>::digits10 + 1;
+
+/**
+ * @brief GkPostingCursor walks the documents of either a single word or every word beginning with a prefix, from the
+ * newest to the oldest, merging the postings of each word together should there be more than one.
+ */
+class GkPostingCursor {
+
+public:
+    GkPostingCursor(leveldb::DB *db, const std::string &termKey, const bool &prefix)
+    {
+        if (!prefix) {
+            open(db, termKey + termSeparator);
+            return;
+        }
+
+        //
+        // Step from one word to the next beginning with the prefix, skipping over the postings of each as we go
+        leveldb::ReadOptions read_options;
+        std::unique_ptr<leveldb::Iterator> terms(db->NewIterator(read_options));
+        for (terms->Seek(termKey); terms->Valid() && m_iters.size() < GK_XMPP_SEARCH_MAX_PREFIX_TERMS;) {
+            const std::string key = terms->key().ToString();
+            const auto separator = key.find(termSeparator, termKey.size());
+            if (key.compare(0, termKey.size(), termKey) != 0 || separator == std::string::npos) {
+                break;
+            }
+
+            const std::string term = key.substr(0, separator);
+            open(db, term + termSeparator);
+            terms->Seek(term + static_cast<char>(termSeparator + 1));
+        }
+    }
+
+    bool next(std::string &suffix)
+    {
+        qint32 newest = -1;
+        for (qint32 i = 0; i < static_cast<qint32>(m_iters.size()); ++i) {
+            if (isValid(i) && (newest < 0 || current(i) < current(newest))) {
+                newest = i;
+            }
+        }
+
+        if (newest < 0) {
+            return false;
+        }
+
+        //
+        // A document containing more than one of the words is only to be returned the once
+        suffix = current(newest);
+        for (qint32 i = 0; i < static_cast<qint32>(m_iters.size()); ++i) {
+            if (isValid(i) && current(i) == suffix) {
+                m_iters[i]->Next();
+            }
+        }
+
+        return true;
+    }
+
+private:
+    std::vector<std::unique_ptr<leveldb::Iterator>> m_iters;
+    std::vector<std::string> m_prefixes;
+
+    void open(leveldb::DB *db, const std::string &prefix)
+    {
+        leveldb::ReadOptions read_options;
+        m_iters.emplace_back(db->NewIterator(read_options));
+        m_iters.back()->Seek(prefix);
+        m_prefixes.push_back(prefix);
+    }
+
+    [[nodiscard]] bool isValid(const qint32 &idx) const
+    {
+        return m_iters[idx]->Valid() && m_iters[idx]->key().starts_with(m_prefixes[idx]);
+    }
+
+    [[nodiscard]] std::string current(const qint32 &idx) const
+    {
+        return m_iters[idx]->key().ToString().substr(m_prefixes[idx].size());
+    }
+
+};
+
+//
+// Whether the given words appear one after the other, anywhere within the given document
+bool containsPhrase(const QStringList &tokens, const QStringList &phrase)
+{
+    for (qint32 i = 0; i + phrase.count() <= tokens.count(); ++i) {
+        bool matched = true;
+        for (qint32 j = 0; j < phrase.count() && matched; ++j) {
+            matched = tokens.at(i + j) == phrase.at(j);
+        }
+
+        if (matched) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//
+// Whether any of the words within the given document begin with the given prefix
+bool containsPrefix(const QStringList &tokens, const QString &prefix)
+{
+    for (const auto &token: tokens) {
+        if (token.startsWith(prefix)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+}
+
+/**
+ * @brief GkXmppSearchIndex::GkXmppSearchIndex
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param db_ptr The Google LevelDB database that the index is to be kept within.
+ * @param parent The parent object.
+ */
+GkXmppSearchIndex::GkXmppSearchIndex(leveldb::DB *db_ptr, QObject *parent) : QObject(parent), db(db_ptr)
+{
+    UErrorCode status = U_ZERO_ERROR;
+    m_wordIter.reset(icu::BreakIterator::createWordInstance(icu::Locale::getRoot(), status));
+    if (U_FAILURE(status)) {
+        throw std::runtime_error(tr("Unable to initialize the word-breaking rules needed for searching! Error: %1")
+                                         .arg(QString::fromLatin1(u_errorName(status))).toStdString());
+    }
+
+    return;
+}
+
+GkXmppSearchIndex::~GkXmppSearchIndex()
+{}
+
+/**
+ * @brief GkXmppSearchIndex::indexDocument adds the given document towards the index or, should it already be present
+ * with the very same text and timestamp, leaves it as-is.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param collection The collection that the document belongs towards, such as the chat transcripts.
+ * @param docId The document in question, which must be unique within its collection.
+ * @param timestamp When the document is from, by which any hits are ranked.
+ * @param text The text of the document that is to be searchable.
+ */
+void GkXmppSearchIndex::indexDocument(const QString &collection, const QString &docId, const QDateTime &timestamp, const QString &text)
+{
+    leveldb::WriteBatch batch;
+    indexDocument(batch, collection, docId, timestamp, text);
+    write(batch);
+
+    return;
+}
+
+/**
+ * @brief GkXmppSearchIndex::indexDocument adds the given document towards the given batch, so that it may be written
+ * alongside whatever else the batch holds, such as the very message being indexed.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param batch The batch that the document is to be written as part of.
+ * @param collection The collection that the document belongs towards, such as the chat transcripts.
+ * @param docId The document in question, which must be unique within its collection.
+ * @param timestamp When the document is from, by which any hits are ranked.
+ * @param text The text of the document that is to be searchable.
+ */
+void GkXmppSearchIndex::indexDocument(leveldb::WriteBatch &batch, const QString &collection, const QString &docId,
+                                      const QDateTime &timestamp, const QString &text) const
+{
+    try {
+        if (collection.isEmpty() || docId.isEmpty()) {
+            return;
+        }
+
+        const qint64 msecs = std::max<qint64>(0, timestamp.toMSecsSinceEpoch());
+        QByteArray value;
+        QDataStream stream(&value, QIODevice::WriteOnly);
+        stream << msecs << text;
+        batch.Put(docKey(collection, docId), value.toStdString());
+
+        QStringList tokens = tokenize(text);
+        tokens.removeDuplicates();
+        const std::string suffix = postingSuffix(docId, msecs);
+        for (const auto &token: tokens) {
+            batch.Put(termKey(collection, token) + termSeparator + suffix, std::string());
+        }
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppSearchIndex::removeDocument
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param collection The collection that the document belongs towards.
+ * @param docId The document in question.
+ */
+void GkXmppSearchIndex::removeDocument(const QString &collection, const QString &docId)
+{
+    leveldb::WriteBatch batch;
+    removeDocument(batch, collection, docId);
+    write(batch);
+
+    return;
+}
+
+/**
+ * @brief GkXmppSearchIndex::removeDocument removes the given document, as it was last written, by way of the given
+ * batch. Should the document then be indexed anew within the same batch, such as upon its text having changed, the
+ * removal is made first.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param batch The batch that the removal is to be written as part of.
+ * @param collection The collection that the document belongs towards.
+ * @param docId The document in question.
+ */
+void GkXmppSearchIndex::removeDocument(leveldb::WriteBatch &batch, const QString &collection, const QString &docId) const
+{
+    try {
+        qint64 msecs = 0;
+        QString text;
+        const std::string key = docKey(collection, docId);
+        if (!readDocument(key, msecs, text)) {
+            return;
+        }
+
+        const std::string suffix = postingSuffix(docId, msecs);
+        for (const auto &token: tokenize(text)) {
+            batch.Delete(termKey(collection, token) + termSeparator + suffix);
+        }
+
+        batch.Delete(key);
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppSearchIndex::search finds the most recent documents that match the given query. The rarest-looking
+ * word of the query (i.e. the longest, preferring those within phrases as they must match whole) is looked up within the
+ * index, with each document found for it then checked against the remainder of the query. No more than
+ * GK_XMPP_SEARCH_MAX_CANDIDATES documents are checked, so that a query whose words are each common but seldom found
+ * together still returns in good time.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param collection The collection to be searched.
+ * @param query Words, each matched as the prefix of a word, and/or "quoted phrases", matched word-for-word.
+ * @param limit The most hits to be returned.
+ * @param scope Should it be given, only the documents whose IDs begin with it are matched, such as those of a single chat.
+ * @return The documents that were matched, from the newest to the oldest.
+ */
+QList<GkXmppSearchHit> GkXmppSearchIndex::search(const QString &collection, const QString &query, const qint32 &limit,
+                                                 const QString &scope) const
+{
+    QList<GkXmppSearchHit> hits;
+    try {
+        if (collection.isEmpty() || limit <= 0) {
+            return hits;
+        }
+
+        //
+        // Every other segment between the quotation marks is a phrase
+        QStringList prefixes;
+        QList<QStringList> phrases;
+        const QStringList segments = query.split(QChar('"'));
+        for (qint32 i = 0; i < segments.count(); ++i) {
+            const QStringList tokens = tokenize(segments.at(i));
+            if (tokens.isEmpty()) {
+                continue;
+            }
+
+            if (i % 2) {
+                phrases.push_back(tokens);
+            } else {
+                prefixes.append(tokens);
+            }
+        }
+
+        QString driver;
+        bool driverIsPrefix = true;
+        for (const auto &phrase: phrases) {
+            for (const auto &token: phrase) {
+                if (driverIsPrefix || token.length() > driver.length()) {
+                    driver = token;
+                    driverIsPrefix = false;
+                }
+            }
+        }
+
+        if (driverIsPrefix) {
+            for (const auto &prefix: prefixes) {
+                if (prefix.length() > driver.length()) {
+                    driver = prefix;
+                }
+            }
+        }
+
+        if (driver.isEmpty()) {
+            return hits;
+        }
+
+        GkPostingCursor cursor(db, termKey(collection, driver), driverIsPrefix);
+        const qint32 maxCandidates = std::max(limit, GK_XMPP_SEARCH_MAX_CANDIDATES);
+        qint32 candidates = 0;
+        std::string suffix;
+        while (hits.count() < limit && candidates < maxCandidates && cursor.next(suffix)) {
+            ++candidates;
+            const QString docId = QString::fromStdString(suffix.substr(invertedTimestampWidth + 1));
+            if (!scope.isEmpty() && !docId.startsWith(scope)) {
+                continue;
+            }
+
+            GkXmppSearchHit hit;
+            qint64 msecs = 0;
+            if (!readDocument(docKey(collection, docId), msecs, hit.text)) {
+                continue;
+            }
+
+            bool matched = true;
+            const QStringList tokens = tokenize(hit.text);
+            for (qint32 i = 0; i < prefixes.count() && matched; ++i) {
+                matched = containsPrefix(tokens, prefixes.at(i));
+            }
+
+            for (qint32 i = 0; i < phrases.count() && matched; ++i) {
+                matched = containsPhrase(tokens, phrases.at(i));
+            }
+
+            if (matched) {
+                hit.docId = docId;
+                hit.timestamp = QDateTime::fromMSecsSinceEpoch(msecs, Qt::UTC);
+                hits.push_back(hit);
+            }
+        }
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return hits;
+}
+
+/**
+ * @brief GkXmppSearchIndex::tokenize splits the given text into words as per the Unicode word-breaking rules, dropping
+ * any whitespace and punctuation, and case-folds each so that searching is case-insensitive in any language.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param text The text to be split.
+ * @return The words of the text, in the order that they appear.
+ */
+QStringList GkXmppSearchIndex::tokenize(const QString &text) const
+{
+    QStringList tokens;
+    if (text.isEmpty()) {
+        return tokens;
+    }
+
+    const icu::UnicodeString uni_text(reinterpret_cast<const UChar *>(text.utf16()), text.length());
+    std::lock_guard<std::mutex> lock_guard(m_wordIterMtx);
+    m_wordIter->setText(uni_text);
+
+    qint32 start = m_wordIter->first();
+    for (qint32 end = m_wordIter->next(); end != icu::BreakIterator::DONE; start = end, end = m_wordIter->next()) {
+        if (m_wordIter->getRuleStatus() == UBRK_WORD_NONE) {
+            continue; // Whitespace and/or punctuation!
+        }
+
+        icu::UnicodeString word(uni_text, start, std::min(end - start, GK_XMPP_SEARCH_MAX_TERM_LENGTH));
+        word.foldCase();
+        tokens.push_back(QString(reinterpret_cast<const QChar *>(word.getBuffer()), word.length()));
+    }
+
+    return tokens;
+}
+
+/**
+ * @brief GkXmppSearchIndex::docKey
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param collection The collection that the document belongs towards.
+ * @param docId The document in question.
+ * @return The key under which the text of the document is kept.
+ */
+std::string GkXmppSearchIndex::docKey(const QString &collection, const QString &docId) const
+{
+    return QString("%1!%2!d!%3").arg(General::Xmpp::GoogleLevelDb::keyToConvSearchIndex).arg(collection).arg(docId).toStdString();
+}
+
+/**
+ * @brief GkXmppSearchIndex::termKey
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param collection The collection that the word belongs towards.
+ * @param term The word, or the prefix of one.
+ * @return The key that the postings of the word, or of every word beginning with the prefix, begin with.
+ */
+std::string GkXmppSearchIndex::termKey(const QString &collection, const QString &term) const
+{
+    return QString("%1!%2!p!%3").arg(General::Xmpp::GoogleLevelDb::keyToConvSearchIndex).arg(collection).arg(term).toStdString();
+}
+
+/**
+ * @brief GkXmppSearchIndex::postingSuffix
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param docId The document in question.
+ * @param timestamp When the document is from, as milliseconds since the epoch.
+ * @return What follows the word within the key of each posting, with the timestamp inverted and zero-padded so that the
+ * newest documents sort first.
+ */
+std::string GkXmppSearchIndex::postingSuffix(const QString &docId, const qint64 &timestamp) const
+{
+    return QString("%1!%2").arg(std::numeric_limits<qint64>::max() - timestamp, invertedTimestampWidth, 10, QChar('0'))
+            .arg(docId).toStdString();
+}
+
+/**
+ * @brief GkXmppSearchIndex::readDocument
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param key The key of the document in question.
+ * @param timestamp When the document is from, as milliseconds since the epoch.
+ * @param text The text of the document.
+ * @return Whether the document is present.
+ */
+bool GkXmppSearchIndex::readDocument(const std::string &key, qint64 &timestamp, QString &text) const
+{
+    leveldb::ReadOptions read_options;
+    std::string value;
+    const leveldb::Status status = db->Get(read_options, key, &value);
+    if (!status.ok()) {
+        return false;
+    }
+
+    QDataStream stream(QByteArray::fromStdString(value));
+    stream >> timestamp >> text;
+
+    return true;
+}
+
+/**
+ * @brief GkXmppSearchIndex::write writes the given batch of (re-)indexed and/or removed documents all at once.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param batch The documents to be written.
+ */
+void GkXmppSearchIndex::write(leveldb::WriteBatch &batch)
+{
+    leveldb::WriteOptions write_options;
+    write_options.sync = true;
+
+    const leveldb::Status status = db->Write(write_options, &batch);
+    if (!status.ok()) {
+        throw std::runtime_error(tr("Issues have been encountered while trying to write towards the search index! Error:\n\n%1")
+                                         .arg(QString::fromStdString(status.ToString())).toStdString());
+    }
+
+    return;
+}
@@ -0,0 +1,95 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include <mutex>
+#include <memory>
+#include <string>
+#include <leveldb/db.h>
+#include <leveldb/write_batch.h>
+#include <unicode/brkiter.h>
+#include <QList>
+#include <QString>
+#include <QObject>
+#include <QDateTime>
+#include <QStringList>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkXmppSearchIndex is an inverted index over the documents of any number of collections, such as the chat
+ * transcripts and the roster, kept within its own key space of the Google LevelDB database. Each document is split into
+ * words by way of ICU and case-folded, with each word then pointing back towards the document under a key that sorts the
+ * newest documents first, so that the most recent hits are found without having to rank every match. A search is made
+ * up of words, each matched as a prefix, and "quoted phrases", whose words must appear one after the other.
+ */
+class GkXmppSearchIndex : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GkXmppSearchIndex(leveldb::DB *db_ptr, QObject *parent = nullptr);
+    ~GkXmppSearchIndex() override;
+
+    void indexDocument(const QString &collection, const QString &docId, const QDateTime &timestamp, const QString &text);
+    void indexDocument(leveldb::WriteBatch &batch, const QString &collection, const QString &docId, const QDateTime &timestamp,
+                       const QString &text) const;
+    void removeDocument(const QString &collection, const QString &docId);
+    void removeDocument(leveldb::WriteBatch &batch, const QString &collection, const QString &docId) const;
+    void write(leveldb::WriteBatch &batch);
+
+    [[nodiscard]] QList<Network::GkXmpp::GkXmppSearchHit> search(const QString &collection, const QString &query, const qint32 &limit,
+                                                                 const QString &scope = QString()) const;
+    [[nodiscard]] QStringList tokenize(const QString &text) const;
+
+private:
+    leveldb::DB *db;
+    std::unique_ptr<icu::BreakIterator> m_wordIter;
+    mutable std::mutex m_wordIterMtx;
+
+    [[nodiscard]] std::string docKey(const QString &collection, const QString &docId) const;
+    [[nodiscard]] std::string termKey(const QString &collection, const QString &term) const;
+    [[nodiscard]] std::string postingSuffix(const QString &docId, const qint64 &timestamp) const;
+    [[nodiscard]] bool readDocument(const std::string &key, qint64 &timestamp, QString &text) const;
+
+};
+};
@@ -0,0 +1,217 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/models/xmpp/gk_xmpp_stanza_worker.hpp"
+#include <utility>
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QFileInfo>
+#include <QImageWriter>
+#include <QXmlStreamWriter>
+#include <qxmpp/QXmppUtils.h>
+
+using namespace GekkoFyre;
+using namespace Network;
+using namespace GkXmpp;
+
+/**
+ * @brief GkXmppStanzaWorker::GkXmppStanzaWorker starts the thread, and moves the processing of this object's own slots
+ * towards it. There is no parent, as an object with one may not be moved towards another thread.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param database The Google LevelDB database that the chat transcripts are kept within, which must outlive this worker.
+ * @param rosterStore The roster, which is safe to read from upon any thread and must likewise outlive this worker.
+ * @param clientJid The bareJid of the client themselves.
+ */
+GkXmppStanzaWorker::GkXmppStanzaWorker(GkLevelDb *database, GkXmppRosterStore *rosterStore,
+                                       const QString &clientJid) : QThread(nullptr)
+{
+    gkDb = database;
+    m_rosterStore = rosterStore;
+    m_clientJid = clientJid;
+
+    start();
+
+    // Move event processing of GkXmppStanzaWorker to this thread
+    QObject::moveToThread(this);
+    return;
+}
+
+GkXmppStanzaWorker::~GkXmppStanzaWorker()
+{
+    quit();
+    wait();
+
+    return;
+}
+
+/**
+ * @brief GkXmppStanzaWorker::run
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppStanzaWorker::run()
+{
+    exec();
+    return;
+}
+
+/**
+ * @brief GkXmppStanzaWorker::processArchivedPage sorts a page of archived messages amongst the roster, whether they be
+ * towards/from the client themselves or a third-party, and writes them towards the chat transcript of whomever the
+ * client was talking with, each transcript in a single batch.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param queryId The query that the page was received for.
+ * @param messages The messages of the page, in the order that they were received.
+ * @see GkXmppClient::resultsReceived(), GkXmppClient::applyArchivedBatch().
+ */
+void GkXmppStanzaWorker::processArchivedPage(const QString &queryId, const QList<QXmppMessage> &messages)
+{
+    try {
+        GkXmppMamBatch batch;
+        batch.queryId = queryId;
+        batch.stanzas = messages.count();
+
+        for (const auto &message: messages) {
+            if (!message.isXmppStanza() || message.body().isEmpty()) {
+                continue;
+            }
+
+            const QString sender = QXmppUtils::jidToBareJid(message.from());
+            GkXmppMamMsg mam_msg;
+            mam_msg.message = message;
+            mam_msg.presented = false;
+
+            //
+            // Messages that have been received towards/from the first-party!
+            if (m_clientJid == message.to() || m_clientJid == sender) {
+                const auto entry = m_rosterStore->get(m_clientJid);
+                if (entry && entry->party == GkXmppParty::FirstParty) {
+                    mam_msg.party = GkXmppParty::FirstParty;
+                    batch.messages[m_clientJid].push_back(mam_msg);
+                }
+            }
+
+            //
+            // Messages that have been sent towards/from the third-party!
+            for (const auto &bareJid: { message.to(), sender }) {
+                const auto entry = m_rosterStore->get(bareJid);
+                if (entry && entry->party == GkXmppParty::ThirdParty) {
+                    mam_msg.party = GkXmppParty::ThirdParty;
+                    batch.messages[bareJid].push_back(mam_msg);
+                    break;
+                }
+            }
+
+            //
+            // Kept towards the chat transcript of whomever the client was talking with
+            const QString chatJid = (sender == m_clientJid) ? QXmppUtils::jidToBareJid(message.to()) : sender;
+            GkRecvMsgsTableViewModel recvMsg;
+            recvMsg.timestamp = message.stamp();
+            recvMsg.bareJid = sender;
+            recvMsg.message = message.body();
+            recvMsg.transcriptKey = gkDb->convXmppTranscriptKey(chatJid, recvMsg);
+            batch.transcripts[chatJid].push_back(recvMsg);
+        }
+
+        for (auto iter = batch.transcripts.constBegin(); iter != batch.transcripts.constEnd(); ++iter) {
+            gkDb->write_xmpp_transcript(iter.key(), iter.value());
+        }
+
+        emit archivedPageProcessed(batch);
+    } catch (const std::exception &e) {
+        emit processingError(QString::fromStdString(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppStanzaWorker::processVCard saves the given vCard towards the filesystem as XML, alongside its avatar (if
+ * any) as an image, so that neither need be requested again from the XMPP server upon each connection.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param vCard The vCard in question.
+ * @param bareJid Whom the vCard belongs towards.
+ * @param xmlFilePath Where the vCard is to be saved towards.
+ * @param imgFilePath Where the avatar is to be saved towards.
+ * @see GkXmppClient::vCardReceived(), GkXmppClient::loadCachedVCard().
+ */
+void GkXmppStanzaWorker::processVCard(const QXmppVCardIq &vCard, const QString &bareJid, const QString &xmlFilePath,
+                                      const QString &imgFilePath)
+{
+    try {
+        const QFileInfo xmlFileName(xmlFilePath);
+        if (!QDir(xmlFileName.absolutePath()).exists()) {
+            //
+            // The host sub-folder does not exist!
+            if (!QDir().mkpath(xmlFileName.absolutePath())) {
+                throw std::runtime_error(tr("An error was encountered with creating directory, \"%1\"!")
+                .arg(xmlFileName.absolutePath()).toStdString());
+            }
+        }
+
+        QFile xmlFile(xmlFileName.filePath());
+        if (!xmlFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            throw std::runtime_error(tr("Unable to save the vCard XML data for user, \"%1\", towards file: %2")
+            .arg(bareJid, xmlFileName.filePath()).toStdString());
+        }
+
+        QXmlStreamWriter stream(&xmlFile);
+        vCard.toXml(&stream);
+        xmlFile.close();
+
+        const QByteArray photo = vCard.photo();
+        if (!photo.isNull() && !photo.isEmpty()) {
+            QImage image;
+            image.loadFromData(photo, vCard.photoType().toStdString().c_str());
+            QImageWriter image_save(imgFilePath);
+            if (!image_save.write(image)) {
+                throw std::runtime_error(tr("Error encountered with saving image data for file, \"%1\"!")
+                .arg(imgFilePath).toStdString());
+            }
+        }
+
+        emit vCardSaved(bareJid, photo);
+    } catch (const std::exception &e) {
+        emit processingError(QString::fromStdString(e.what()));
+    }
+
+    return;
+}
@@ -0,0 +1,93 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include "src/dek_db.hpp"
+#include "src/models/xmpp/gk_xmpp_roster_store.hpp"
+#include <QList>
+#include <QString>
+#include <QThread>
+#include <QObject>
+#include <QPointer>
+#include <QByteArray>
+#include <qxmpp/QXmppMessage.h>
+#include <qxmpp/QXmppVCardIq.h>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkXmppStanzaWorker takes the processing of received stanzas off the GUI thread, which would otherwise stutter
+ * whilst the message archives are being synchronized. Each page of archived messages (XEP-0313) is sorted amongst the
+ * roster and written towards the chat transcripts upon this thread, with the GUI thread being handed the result as a
+ * single GkXmppMamBatch; likewise, each vCard is saved towards the filesystem, avatar and all, upon this thread.
+ * Nothing here may touch the GUI, so any errors are handed back via GkXmppStanzaWorker::processingError() instead.
+ */
+class GkXmppStanzaWorker : public QThread {
+    Q_OBJECT
+
+public:
+    explicit GkXmppStanzaWorker(GekkoFyre::GkLevelDb *database, GekkoFyre::GkXmppRosterStore *rosterStore,
+                                const QString &clientJid);
+    ~GkXmppStanzaWorker() override;
+
+    void run() Q_DECL_OVERRIDE;
+
+public slots:
+    void processArchivedPage(const QString &queryId, const QList<QXmppMessage> &messages);
+    void processVCard(const QXmppVCardIq &vCard, const QString &bareJid, const QString &xmlFilePath, const QString &imgFilePath);
+
+signals:
+    void archivedPageProcessed(const GekkoFyre::Network::GkXmpp::GkXmppMamBatch &batch);
+    void vCardSaved(const QString &bareJid, const QByteArray &photo);
+    void processingError(const QString &error);
+
+private:
+    //
+    // Plain pointers, as a QPointer may not be dereferenced away from the thread of the object it guards; both are
+    // owned by GkXmppClient, which destroys this worker before either of them.
+    GekkoFyre::GkLevelDb *gkDb;
+    GekkoFyre::GkXmppRosterStore *m_rosterStore;
+    QString m_clientJid;
+
+};
+};
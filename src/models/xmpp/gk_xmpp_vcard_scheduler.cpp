@@ -0,0 +1,359 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#include "src/models/xmpp/gk_xmpp_vcard_scheduler.hpp"
+#include <QCryptographicHash>
+
+using namespace GekkoFyre;
+
+/**
+ * @brief GkXmppVCardScheduler::GkXmppVCardScheduler
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param vCardMgr The vCard manager that has been added towards the XMPP client, which sends each of the requests.
+ * @param parent The parent object.
+ */
+GkXmppVCardScheduler::GkXmppVCardScheduler(QXmppVCardManager *vCardMgr, QObject *parent) : QObject(parent), m_vCardMgr(vCardMgr),
+                                                                                           m_nextSequence(0), m_sent(0), m_skipped(0),
+                                                                                           m_busy(false)
+{
+    m_clock.start();
+    m_expiryTimer = new QTimer(this);
+    m_expiryTimer->setInterval(GK_XMPP_VCARD_FETCH_TIMEOUT_MS / 4);
+    QObject::connect(m_expiryTimer, SIGNAL(timeout()), this, SLOT(expireRequests()));
+
+    return;
+}
+
+GkXmppVCardScheduler::~GkXmppVCardScheduler()
+{}
+
+/**
+ * @brief GkXmppVCardScheduler::request requests the vCard of the given bareJid, as soon as there is room amongst the
+ * requests already underway. Should the bareJid already be waiting, then it is only raised towards the given priority,
+ * and should it already be underway, then nothing more is done.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user whose vCard is to be requested.
+ * @param priority How soon the vCard is wanted, relative to the others waiting.
+ */
+void GkXmppVCardScheduler::request(const QString &bareJid, const GkVCardPriority &priority)
+{
+    if (bareJid.isEmpty()) {
+        return;
+    }
+
+    if (m_active.contains(bareJid)) {
+        ++m_skipped;
+        return;
+    }
+
+    const auto iter = m_waitingIndex.find(bareJid);
+    if (iter != m_waitingIndex.end()) {
+        ++m_skipped;
+        if (priority > iter->priority) {
+            m_waiting.erase(iter.value());
+            iter->priority = priority;
+            m_waiting.insert(iter.value());
+        }
+
+        return;
+    }
+
+    GkVCardFetch fetch;
+    fetch.priority = priority;
+    fetch.sequence = m_nextSequence++;
+    fetch.bareJid = bareJid;
+    m_waiting.insert(fetch);
+    m_waitingIndex.insert(bareJid, fetch);
+    m_busy = true;
+
+    startWaiting();
+    return;
+}
+
+/**
+ * @brief GkXmppVCardScheduler::requestIfChanged requests the vCard of the given bareJid, but only should the hash of the
+ * avatar advertised within their presence (XEP-0153) differ from that of the vCard already held.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user whose vCard is to be requested.
+ * @param photoHash The SHA-1 of the avatar advertised, which is empty should they have no avatar at all.
+ * @param priority How soon the vCard is wanted, relative to the others waiting.
+ */
+void GkXmppVCardScheduler::requestIfChanged(const QString &bareJid, const QByteArray &photoHash, const GkVCardPriority &priority)
+{
+    const auto iter = m_photoHashes.constFind(bareJid);
+    if (iter != m_photoHashes.constEnd() && iter.value() == photoHash) {
+        ++m_skipped;
+        return;
+    }
+
+    request(bareJid, priority);
+    return;
+}
+
+/**
+ * @brief GkXmppVCardScheduler::prioritize raises the given bareJid towards the front of those waiting, such as once it
+ * has been shown within the roster. Does nothing should the bareJid not be waiting.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user in question.
+ */
+void GkXmppVCardScheduler::prioritize(const QString &bareJid)
+{
+    const auto iter = m_waitingIndex.find(bareJid);
+    if (iter == m_waitingIndex.end() || iter->priority >= Visible) {
+        return;
+    }
+
+    m_waiting.erase(iter.value());
+    iter->priority = Visible;
+    m_waiting.insert(iter.value());
+
+    return;
+}
+
+/**
+ * @brief GkXmppVCardScheduler::received is to be executed for each vCard received from the XMPP server, whether it was
+ * requested through here or not, so that its place may be given up to the next bareJid waiting.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user whose vCard has been received.
+ * @param photo The avatar within the vCard, if any.
+ */
+void GkXmppVCardScheduler::received(const QString &bareJid, const QByteArray &photo)
+{
+    hold(bareJid, photo);
+    m_active.remove(bareJid);
+    startWaiting();
+
+    return;
+}
+
+/**
+ * @brief GkXmppVCardScheduler::cached is to be executed for each vCard read in from the filesystem instead of being
+ * requested, so that it is not requested again unless the avatar advertised for it changes.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user whose vCard has been read in.
+ * @param photo The avatar within the vCard, if any.
+ */
+void GkXmppVCardScheduler::cached(const QString &bareJid, const QByteArray &photo)
+{
+    ++m_skipped;
+    hold(bareJid, photo);
+
+    return;
+}
+
+/**
+ * @brief GkXmppVCardScheduler::forget no longer holds the vCard of the given bareJid, such as once it has been removed
+ * from the roster, nor requests it should it still be waiting.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user in question.
+ */
+void GkXmppVCardScheduler::forget(const QString &bareJid)
+{
+    m_photoHashes.remove(bareJid);
+    const auto iter = m_waitingIndex.find(bareJid);
+    if (iter != m_waitingIndex.end()) {
+        m_waiting.erase(iter.value());
+        m_waitingIndex.erase(iter);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppVCardScheduler::cancelAll abandons every request, such as upon a new stream being made towards the XMPP
+ * server, whereupon whatever was requested beforehand is never going to arrive. The vCards already held are kept.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppVCardScheduler::cancelAll()
+{
+    m_waiting.clear();
+    m_waitingIndex.clear();
+    m_active.clear();
+    m_expiryTimer->stop();
+    m_busy = false;
+
+    return;
+}
+
+/**
+ * @brief GkXmppVCardScheduler::clear abandons every request and forgets every vCard held, such as upon disconnecting
+ * from the XMPP server.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppVCardScheduler::clear()
+{
+    cancelAll();
+    m_photoHashes.clear();
+
+    return;
+}
+
+/**
+ * @brief GkXmppVCardScheduler::isHeld
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user in question.
+ * @return Whether the vCard of the given bareJid has either been received or read in from the filesystem.
+ */
+bool GkXmppVCardScheduler::isHeld(const QString &bareJid) const
+{
+    return m_photoHashes.contains(bareJid);
+}
+
+/**
+ * @brief GkXmppVCardScheduler::isPending
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user in question.
+ * @return Whether the vCard of the given bareJid is either being requested or waiting to be.
+ */
+bool GkXmppVCardScheduler::isPending(const QString &bareJid) const
+{
+    return m_active.contains(bareJid) || m_waitingIndex.contains(bareJid);
+}
+
+/**
+ * @brief GkXmppVCardScheduler::activeRequests
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The amount of vCards requested, but not yet received.
+ */
+qint32 GkXmppVCardScheduler::activeRequests() const
+{
+    return m_active.size();
+}
+
+/**
+ * @brief GkXmppVCardScheduler::waitingRequests
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The amount of vCards waiting for their turn to be requested.
+ */
+qint32 GkXmppVCardScheduler::waitingRequests() const
+{
+    return m_waitingIndex.size();
+}
+
+/**
+ * @brief GkXmppVCardScheduler::requestsSent
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The amount of vCard requests sent towards the XMPP server, since this object was created.
+ */
+quint64 GkXmppVCardScheduler::requestsSent() const
+{
+    return m_sent;
+}
+
+/**
+ * @brief GkXmppVCardScheduler::requestsSkipped
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @return The amount of vCard requests that were not sent, since this object was created, due to the vCard already
+ * being requested, being unchanged or having been read in from the filesystem instead.
+ */
+quint64 GkXmppVCardScheduler::requestsSkipped() const
+{
+    return m_skipped;
+}
+
+/**
+ * @brief GkXmppVCardScheduler::expireRequests gives up on those requests that have gone unanswered for too long, such
+ * as those that the XMPP server has answered with an error, so that their places go towards the bareJids waiting.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppVCardScheduler::expireRequests()
+{
+    const qint64 now = m_clock.elapsed();
+    for (auto iter = m_active.begin(); iter != m_active.end();) {
+        if (now - iter.value() >= GK_XMPP_VCARD_FETCH_TIMEOUT_MS) {
+            iter = m_active.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+
+    startWaiting();
+    return;
+}
+
+/**
+ * @brief GkXmppVCardScheduler::startWaiting requests as many of the waiting vCards as there is room for, the highest
+ * priority first.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppVCardScheduler::startWaiting()
+{
+    while (m_active.size() < GK_XMPP_VCARD_FETCH_MAX_CONCURRENT && !m_waiting.empty()) {
+        const GkVCardFetch fetch = *m_waiting.begin();
+        m_waiting.erase(m_waiting.begin());
+        m_waitingIndex.remove(fetch.bareJid);
+
+        if (m_vCardMgr && !m_vCardMgr->requestVCard(fetch.bareJid).isEmpty()) {
+            m_active.insert(fetch.bareJid, m_clock.elapsed());
+            ++m_sent;
+        }
+    }
+
+    if (m_active.isEmpty()) {
+        m_expiryTimer->stop();
+        if (m_busy && m_waiting.empty()) {
+            m_busy = false;
+            emit fetchesFinished(m_sent, m_skipped);
+        }
+    } else if (!m_expiryTimer->isActive()) {
+        m_expiryTimer->start();
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppVCardScheduler::hold
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param bareJid The user whose vCard is now held.
+ * @param photo The avatar within the vCard, if any.
+ */
+void GkXmppVCardScheduler::hold(const QString &bareJid, const QByteArray &photo)
+{
+    m_photoHashes.insert(bareJid, photo.isEmpty() ? QByteArray() : QCryptographicHash::hash(photo, QCryptographicHash::Sha1));
+    const auto iter = m_waitingIndex.find(bareJid);
+    if (iter != m_waitingIndex.end()) {
+        m_waiting.erase(iter.value());
+        m_waitingIndex.erase(iter);
+    }
+
+    return;
+}
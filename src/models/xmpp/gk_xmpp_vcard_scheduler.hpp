@@ -0,0 +1,129 @@
+/**
+ **     __                 _ _   __    __           _     _ 
+ **    / _\_ __ ___   __ _| | | / / /\ \ \___  _ __| | __| |
+ **    \ \| '_ ` _ \ / _` | | | \ \/  \/ / _ \| '__| |/ _` |
+ **    _\ \ | | | | | (_| | | |  \  /\  / (_) | |  | | (_| |
+ **    \__/_| |_| |_|\__,_|_|_|   \/  \/ \___/|_|  |_|\__,_|
+ **                                                         
+ **                  ___     _                              
+ **                 /   \___| |_   ___  _____               
+ **                / /\ / _ \ | | | \ \/ / _ \              
+ **               / /_//  __/ | |_| |>  <  __/              
+ **              /___,' \___|_|\__,_/_/\_\___|              
+ **
+ **
+ **   If you have downloaded the source code for "Small World Deluxe" and are reading this,
+ **   then thank you from the bottom of our hearts for making use of our hard work, sweat
+ **   and tears in whatever you are implementing this into!
+ **
+ **   Copyright (C) 2020 - 2022. GekkoFyre.
+ **
+ **   Small World Deluxe is free software: you can redistribute it and/or modify
+ **   it under the terms of the GNU General Public License as published by
+ **   the Free Software Foundation, either version 3 of the License, or
+ **   (at your option) any later version.
+ **
+ **   Small World is distributed in the hope that it will be useful,
+ **   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **   GNU General Public License for more details.
+ **
+ **   You should have received a copy of the GNU General Public License
+ **   along with Small World Deluxe.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **
+ **   The latest source code updates can be obtained from [ 1 ] below at your
+ **   discretion. A web-browser or the 'git' application may be required.
+ **
+ **   [ 1 ] - https://code.gekkofyre.io/amateur-radio/small-world-deluxe
+ **
+ ****************************************************************************************************/
+
+#pragma once
+
+#include "src/defines.hpp"
+#include <set>
+#include <QHash>
+#include <QTimer>
+#include <QString>
+#include <QObject>
+#include <QPointer>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <qxmpp/QXmppVCardManager.h>
+
+namespace GekkoFyre {
+
+/**
+ * @brief GkXmppVCardScheduler requests the vCards of each bareJid, no more than GK_XMPP_VCARD_FETCH_MAX_CONCURRENT at
+ * once, with the remainder waiting their turn in order of priority and then of when they were requested. A bareJid is
+ * never waiting or being requested more than once over, and the SHA-1 of the avatar within each vCard held is kept, so
+ * that a vCard is only requested again should a presence advertise a different one (XEP-0153). A request that goes
+ * unanswered for GK_XMPP_VCARD_FETCH_TIMEOUT_MS gives up its place to the next.
+ */
+class GkXmppVCardScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    enum GkVCardPriority {
+        Background = 0,                 // Such as the roster as a whole, upon connecting.
+        Visible = 1                     // Those bareJids that are online, and therefore shown within the roster.
+    };
+
+    explicit GkXmppVCardScheduler(QXmppVCardManager *vCardMgr, QObject *parent = nullptr);
+    ~GkXmppVCardScheduler() override;
+
+    void request(const QString &bareJid, const GkVCardPriority &priority = Background);
+    void requestIfChanged(const QString &bareJid, const QByteArray &photoHash, const GkVCardPriority &priority = Visible);
+    void prioritize(const QString &bareJid);
+    void received(const QString &bareJid, const QByteArray &photo);
+    void cached(const QString &bareJid, const QByteArray &photo);
+    void forget(const QString &bareJid);
+    void cancelAll();
+    void clear();
+
+    [[nodiscard]] bool isHeld(const QString &bareJid) const;
+    [[nodiscard]] bool isPending(const QString &bareJid) const;
+    [[nodiscard]] qint32 activeRequests() const;
+    [[nodiscard]] qint32 waitingRequests() const;
+    [[nodiscard]] quint64 requestsSent() const;
+    [[nodiscard]] quint64 requestsSkipped() const;
+
+signals:
+    void fetchesFinished(const quint64 &sent, const quint64 &skipped);
+
+private slots:
+    void expireRequests();
+
+private:
+    struct GkVCardFetch {
+        GkVCardPriority priority;
+        quint64 sequence;               // The order in which the bareJids were requested, amongst those of the same priority.
+        QString bareJid;
+
+        bool operator<(const GkVCardFetch &other) const {
+            if (priority != other.priority) {
+                return priority > other.priority;
+            }
+
+            return sequence < other.sequence;
+        }
+    };
+
+    QPointer<QXmppVCardManager> m_vCardMgr;
+    std::set<GkVCardFetch> m_waiting;                   // The bareJids awaiting their turn, the highest priority foremost.
+    QHash<QString, GkVCardFetch> m_waitingIndex;        // The same bareJids as above, keyed by bareJid.
+    QHash<QString, qint64> m_active;                    // The bareJids awaiting their vCards, with when they were requested.
+    QHash<QString, QByteArray> m_photoHashes;           // The SHA-1 of the avatar within each vCard held, keyed by bareJid.
+    QPointer<QTimer> m_expiryTimer;
+    QElapsedTimer m_clock;
+    quint64 m_nextSequence;
+    quint64 m_sent;
+    quint64 m_skipped;
+    bool m_busy;                                        // Whether anything has been requested since the last time that there was nothing left to do.
+
+    void startWaiting();
+    void hold(const QString &bareJid, const QByteArray &photo);
+
+};
+};
@@ -47,7 +47,6 @@
 #include "src/models/tableview/gk_logger_model.hpp"
 #include "src/models/tableview/gk_active_msgs_model.hpp"
 #include "src/models/tableview/gk_callsign_msgs_model.hpp"
-#include "src/gk_codec2.hpp"
 #include <marble/AbstractFloatItem.h>
 #include <marble/MarbleDirs.h>
 #include <marble/GeoDataCoordinates.h>
@@ -69,6 +68,7 @@
 #include <QFileDialog>
 #include <QIODevice>
 #include <QMultiMap>
+#include <QSignalBlocker>
 #include <QtGlobal>
 #include <QVariant>
 #include <QProcess>
@@ -139,10 +139,16 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
     qRegisterMetaType<GekkoFyre::GkAudioFramework::GkAudioState>("GekkoFyre::GkAudioFramework::GkAudioState");
     qRegisterMetaType<GekkoFyre::Network::GkDataState>("GekkoFyre::Network::GkDataState");
     qRegisterMetaType<GekkoFyre::Network::GkXmpp::GkXmppMsgTabRoster>("GekkoFyre::Network::GkXmpp::GkXmppMsgTabRoster");
+    qRegisterMetaType<GekkoFyre::Network::GkXmpp::GkXmppMamBatch>("GekkoFyre::Network::GkXmpp::GkXmppMamBatch");
+    qRegisterMetaType<GekkoFyre::Network::GkXmpp::GkXmppMucOccupant>("GekkoFyre::Network::GkXmpp::GkXmppMucOccupant");
     qRegisterMetaType<boost::filesystem::path>("boost::filesystem::path");
     qRegisterMetaType<std::shared_ptr<aria2::DownloadHandle>>("std::shared_ptr<aria2::DownloadHandle>");
     qRegisterMetaType<SoapySDR::Kwargs>("SoapySDR::Kwargs");
     qRegisterMetaType<GekkoFyre::System::GkSdr::GkSoapySdrTableView>("GekkoFyre::System::GkSdr::GkSoapySdrTableView");
+    qRegisterMetaType<QList<GekkoFyre::System::GkSdr::GkSoapySdrTableView>>("QList<GekkoFyre::System::GkSdr::GkSoapySdrTableView>");
+    qRegisterMetaType<GekkoFyre::System::GkSdr::GkSdrModulation>("GekkoFyre::System::GkSdr::GkSdrModulation");
+    qRegisterMetaType<GekkoFyre::AmateurRadio::GkFtxDecode>("GekkoFyre::AmateurRadio::GkFtxDecode");
+    qRegisterMetaType<QList<GekkoFyre::AmateurRadio::GkFtxDecode>>("QList<GekkoFyre::AmateurRadio::GkFtxDecode>");
     qRegisterMetaType<RIG>("RIG");
     qRegisterMetaType<size_t>("size_t");
     qRegisterMetaType<uint8_t>("uint8_t");
@@ -214,8 +220,8 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
         //
         // Configure the volume meter!
         //
-        // gkVuMeter = new GkVuMeter(ui->frame_spect_vu_meter);
-        // ui->verticalLayout_8->addWidget(gkVuMeter);
+        gkVuMeter = new GkVuMeter(ui->frame_vol_control);
+        ui->horizontalLayout_13->addWidget(gkVuMeter);
 
         //
         // Initialize the default logic state on all applicable QPushButtons within QMainWindow.
@@ -425,6 +431,54 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
                                  gkEventLoggerModel, SLOT(removeData(const GekkoFyre::System::Events::Logging::GkEventLogging &)));
 
                 gkEventLogger->publishEvent(tr("Events log initiated."), GkSeverity::Info, false, true, true, false);
+
+                //
+                // SoapySDR devices are found (and probed) upon a thread of their own, with the results being cached
+                gkSdrDiscovery = new GkSdrDiscovery(gkSdrDev, gkEventLogger, this);
+                QObject::connect(gkSdrDiscovery, SIGNAL(devicesChanged(const QList<GekkoFyre::System::GkSdr::GkSoapySdrTableView> &)),
+                                 this, SIGNAL(foundSoapySdrDevs(const QList<GekkoFyre::System::GkSdr::GkSoapySdrTableView> &)));
+
+                //
+                // The SDR streaming engine, which is fed from whichever SoapySDR device is selected
+                gkSdrStream = new GkSdrStream(gkEventLogger, this);
+                QObject::connect(gkSdrStream, SIGNAL(streamError(const QString &)), this, SLOT(sdrStreamError(const QString &)));
+
+                //
+                // The digital down-converter, whose primary channel follows the modulation chosen for the SDR device
+                gkSdrDdc = new GkSdrDdc(gkSdrStream, gkEventLogger, this);
+                QObject::connect(gkSdrStream, SIGNAL(streamStarted(const double &)), gkSdrDdc, SLOT(start(const double &)));
+
+                //
+                // The recorder of raw IQ, which only ever writes towards disk once a recording has been asked for
+                gkSigmfRecorder = new GkSigmfRecorder(gkSdrStream, gkEventLogger, this);
+                QObject::connect(gkSdrStream, SIGNAL(streamStarted(const double &)), gkSigmfRecorder, SLOT(start(const double &)));
+                QObject::connect(gkSigmfRecorder, SIGNAL(recordingError(const QString &)), this, SLOT(sdrStreamError(const QString &)));
+
+                #ifdef CODEC2_LIBS_ENBLD
+                //
+                // The FreeDV modem is opened but once, and then fed from the capture thread just as the decoder of FT8 is
+                try {
+                    gkCodec2 = new GkCodec2(Codec2Mode::freeDvMode2020, Codec2ModeCustom::GekkoFyreV1, 0, 0, gkDb, gkEventLogger,
+                                            gkStringFuncs, this);
+                    QObject::connect(gkCodec2, &GkCodec2::dataReceived, this, [this](const QByteArray &data) {
+                        gkEventLogger->publishEvent(tr("%1 bytes of data were received via FreeDV.").arg(QString::number(data.size())),
+                                                    GkSeverity::Info, "", false, true, false, false, false);
+                    });
+
+                    //
+                    // The data link takes turns with the far end, sending whatever is yet to be acknowledged (or merely an
+                    // acknowledgement of what has been received) once the far end has had its own turn
+                    m_codec2TxTimer = new QTimer(this);
+                    m_codec2TxTimer->setSingleShot(true);
+                    QObject::connect(m_codec2TxTimer, SIGNAL(timeout()), this, SLOT(codec2TxTurn()));
+                    m_codec2TxTimer->start(GK_CODEC2_ARQ_TURN_MILLISECS);
+                } catch (const std::exception &e) {
+                    gkEventLogger->publishEvent(tr("FreeDV shall not be available, as the modem could not be opened: %1").arg(QString::fromStdString(e.what())),
+                                                GkSeverity::Warning, "", false, true, false, false, false);
+                }
+                #endif
+                QObject::connect(gkSdrDev, SIGNAL(modulationChanged(const GekkoFyre::System::GkSdr::GkSdrModulation &)),
+                                 this, SLOT(sdrModulationChanged(const GekkoFyre::System::GkSdr::GkSdrModulation &)));
                 if (enableSentry) {
                     sentry_start_session();
                     sentry_reinstall_backend();
@@ -480,7 +534,28 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
         gkCli = std::make_shared<GekkoFyre::GkCli>(gkCliParser, gkFileIo, gkDb, gkRadioLibs, this);
 
         std::unique_ptr<QString> error_msg = std::make_unique<QString>("");
-        gkCli->parseCommandLine(error_msg.get());
+        if (gkCli->parseCommandLine(error_msg.get()) == System::Cli::CommandLineBenchmarkRequested) {
+            //
+            // The results have already been printed towards the terminal, so there is nothing else left to do!
+            QTimer::singleShot(0, qApp, &QCoreApplication::quit);
+        }
+
+        //
+        // The decoder of FT8, which is fed from the capture thread once an input audio device has been initialized. This must
+        // follow the parsing of the command line, as the LDPC code may be given from there!
+        QPointer<QWidget> tab_maingui_decodes = new QWidget(ui->tabWidget_maingui);
+        ui->tabWidget_maingui->insertTab(ui->tabWidget_maingui->indexOf(ui->tab_maingui_logs), tab_maingui_decodes, tr("Decodes"));
+        QPointer<GkActiveMsgsTableViewModel> gkActiveMsgsModel = new GkActiveMsgsTableViewModel(gkDb, tab_maingui_decodes);
+        try {
+            const auto ldpc = gkCliParser->isSet("ftx-ldpc-table") ? GkFtxLdpc::fromFile(QFileInfo(gkCliParser->value("ftx-ldpc-table"))) :
+                              GkFtxLdpc::bundled();
+            gkFtxDecoder = new GkFtxDecoder(DigitalModes::FT8, ldpc, gkEventLogger, 0, this);
+            QObject::connect(gkFtxDecoder, SIGNAL(slotDecoded(const QList<GekkoFyre::AmateurRadio::GkFtxDecode> &)),
+                             gkActiveMsgsModel, SLOT(insertData(const QList<GekkoFyre::AmateurRadio::GkFtxDecode> &)));
+        } catch (const std::exception &e) {
+            gkEventLogger->publishEvent(tr("FT8 shall not be decoded, as the LDPC code could not be loaded: %1").arg(QString::fromStdString(e.what())),
+                                        GkSeverity::Warning, "", false, true, false, false, false);
+        }
 
         #ifndef GK_ENBL_VALGRIND_SUPPORT
         emit setStartupProgress(30);
@@ -644,6 +719,13 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
                                     //
                                     // Initiate the while-loop for the capture of actual audio samples!
                                     gkSysInputDevStatus = GkAudioRecordStatus::Active;
+                                    gkAudioMeter = std::make_shared<GkAudioMeter>(it->pref_sample_rate, input_audio_dev_chosen_number_channels);
+                                    m_captureRate = it->pref_sample_rate;
+                                    m_captureChannels = static_cast<quint16>(input_audio_dev_chosen_number_channels);
+                                    if (m_sdrStreamRate <= 0.0) {
+                                        configureDecoders(m_captureRate, m_captureChannels, static_cast<size_t>(audioFrameSampleCountPerChannel), false);
+                                    }
+
                                     capture_input_audio_samples = std::thread(&MainWindow::captureAlcSamples, this, it->alDevice, it->alDeviceRecBuf, audioFrameSampleCountPerChannel);
                                     capture_input_audio_samples.detach();
 
@@ -671,6 +753,12 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
         output_audio_init.get();
         input_audio_init.get();
 
+        if (gkAudioMeter) {
+            //
+            // The volume meter pulls the latest levels from the capture thread upon its own timer!
+            gkVuMeter->setLevelSource(gkAudioMeter);
+        }
+
         #ifndef GK_ENBL_VALGRIND_SUPPORT
         emit setStartupProgress(50);
         #endif
@@ -753,6 +841,21 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
         gkSpectroWaterfall->setZLabel(tr("Signal (dB)"));
         gkSpectroWaterfall->setColorMap(ColorMaps::BlackBodyRadiation());
 
+        //
+        // Waterfalls may also be generated from recorded audio files, rather than just the live audio stream!
+        gkOfflineSpectro = new GekkoFyre::GkOfflineSpectro(gkEventLogger, this);
+        QObject::connect(gkOfflineSpectro, SIGNAL(spectroProductReady(std::shared_ptr<GekkoFyre::Spectrograph::GkSpectroProduct>)),
+                         gkSpectroWaterfall, SLOT(loadSpectroProduct(std::shared_ptr<GekkoFyre::Spectrograph::GkSpectroProduct>)));
+        QObject::connect(gkOfflineSpectro, SIGNAL(progressChanged(const qint32 &)), this, SLOT(offlineSpectroProgress(const qint32 &)), Qt::QueuedConnection);
+        QObject::connect(gkSpectroWaterfall, SIGNAL(spectroProductChanged(const bool &)), ui->actionSave_Waterfall, SLOT(setEnabled(bool)));
+        QObject::connect(gkSpectroWaterfall, SIGNAL(spectroProductChanged(const bool &)), ui->actionReturn_to_Live_Waterfall, SLOT(setEnabled(bool)));
+
+        //
+        // The waterfall is handed over towards the IQ stream whenever an SDR device is streaming!
+        gkWidebandSpectrum = new GekkoFyre::GkWidebandSpectrum(gkSdrStream, gkSpectroWaterfall, gkEventLogger, this);
+        QObject::connect(gkSdrStream, SIGNAL(streamStarted(const double &)), this, SLOT(sdrStreamStarted(const double &)), Qt::QueuedConnection);
+        QObject::connect(gkSdrStream, SIGNAL(streamFinished()), this, SLOT(sdrStreamFinished()), Qt::QueuedConnection);
+
         //
         // Add the spectrograph / waterfall to the QMainWindow!
         ui->horizontalLayout_12->addWidget(gkSpectroWaterfall);
@@ -765,10 +868,65 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
         //
         // Sound & Audio Devices
         //
+        for (const auto &output_dev: gkSysOutputAudioDevs) {
+            if (output_dev.isEnabled && output_dev.alDevice && output_dev.alDeviceCtx) {
+                //
+                // All audio playback is mixed together upon the one real-time thread, for the chosen output audio device!
+                gkAudioMixer = new GkAudioMixer(output_dev, gkEventLogger, this);
+                gkAudioMixer->start();
+                break;
+            }
+        }
+
+        if (gkSdrDdc) {
+            //
+            // The primary channel of the digital down-converter is heard through the mixer, at the mixer's own sample rate,
+            // and is decoded (and drawn upon the waterfall) in place of the input audio device whilst the SDR is streaming
+            GkDdcChannelConfig primary_channel;
+            primary_channel.modulation = gkSdrDev->getModulation();
+            if (gkAudioMixer && gkAudioMixer->isRunning()) {
+                primary_channel.audio_rate = gkAudioMixer->getSampleRate();
+                m_sdrAudioStream = std::make_shared<GkAudioStream>(gkAudioMixer->getSampleRate());
+                gkAudioMixer->playStream(m_sdrAudioStream);
+            }
+
+            m_sdrAudioRate = primary_channel.audio_rate;
+            auto audio_stream = m_sdrAudioStream;
+            m_sdrPrimaryChannel = gkSdrDdc->addChannel(primary_channel, [this, audio_stream](const qint32 &channel_id, const float *samples, const size_t &count) {
+                if (audio_stream) {
+                    audio_stream->write(samples, count);
+                }
+
+                feedSdrChannelAudio(samples, count);
+            });
+        }
+
+        if (gkSigmfRecorder && gkCliParser->isSet("sigmf-record")) {
+            gkSigmfRecorder->startRecording(QFileInfo(gkCliParser->value("sigmf-record")));
+        }
+
+        if (gkSdrStream && gkCliParser->isSet("sigmf-replay")) {
+            //
+            // A SigMF recording stands in for an SDR device, so that everything downstream may be exercised (and measured,
+            // when replayed as fast as possible) without any hardware at all...
+            auto sigmf_source = std::make_unique<GkSigmfIqSource>(QFileInfo(gkCliParser->value("sigmf-replay")), false,
+                                                                  !gkCliParser->isSet("sigmf-replay-fast"));
+            const auto &sigmf_meta = sigmf_source->getMeta();
+            if (!sigmf_meta.captures.empty()) {
+                if (gkWidebandSpectrum) {
+                    gkWidebandSpectrum->setCenterFrequency(sigmf_meta.captures.front().frequency);
+                }
+
+                if (gkSigmfRecorder) {
+                    gkSigmfRecorder->setCenterFrequency(sigmf_meta.captures.front().frequency);
+                }
+            }
+
+            gkSdrStream->start(std::move(sigmf_source));
+        }
+
         gkMultimedia = new GkMultimedia(gkAudioDevices, gkSysOutputAudioDevs, gkSysInputAudioDevs, gkDb, gkStringFuncs,
-                                        gkEventLogger, this);
-        // QObject::connect(this, SIGNAL(refreshVuDisplay(const qreal &, const qreal &, const int &)),
-        //                  gkVuMeter, SLOT(levelChanged(const qreal &, const qreal &, const int &)));
+                                        gkAudioMixer, gkEventLogger, this);
         QObject::connect(this, SIGNAL(changeInputAudioInterface(const GekkoFyre::Database::Settings::Audio::GkDevice &)),
                          this, SLOT(restartInputAudioInterface(const GekkoFyre::Database::Settings::Audio::GkDevice &)));
 
@@ -901,6 +1059,44 @@ MainWindow::~MainWindow()
         gkAudioOutputThread.wait();
     }
 
+    if (gkAudioMixer) {
+        gkAudioMixer->stop();
+    }
+
+    if (gkWidebandSpectrum) {
+        gkWidebandSpectrum->stop();
+    }
+
+    if (gkSdrDdc) {
+        gkSdrDdc->stop();
+    }
+
+    if (gkSigmfRecorder) {
+        gkSigmfRecorder->stop();
+    }
+
+    if (gkFtxDecoder) {
+        gkFtxDecoder->stop();
+    }
+
+    #ifdef CODEC2_LIBS_ENBLD
+    if (gkCodec2) {
+        gkCodec2->stop();
+    }
+    #endif
+
+    if (m_sdrAudioStream) {
+        m_sdrAudioStream->close();
+    }
+
+    if (gkSdrStream) {
+        gkSdrStream->stop();
+    }
+
+    if (gkSdrDiscovery) {
+        gkSdrDiscovery->stop();
+    }
+
     if (vu_meter_thread.joinable()) {
         vu_meter_thread.join();
     }
@@ -993,7 +1189,108 @@ void MainWindow::on_actionE_xit_triggered()
  */
 void MainWindow::on_action_Open_triggered()
 {
-    QMessageBox::information(this, tr("Information..."), tr("Apologies, but this function does not work yet."), QMessageBox::Ok);
+    try {
+        if (!gkOfflineSpectro || !gkSpectroWaterfall) {
+            return;
+        }
+
+        const QString defPath = QStandardPaths::writableLocation(QStandardPaths::MusicLocation);
+        const QString filePath = QFileDialog::getOpenFileName(this, tr("Generate Waterfall from Recording"), defPath,
+                                                              tr("WAV/RF64 Audio Files (*.wav *.wave *.rf64 *.bwf);;Saved Waterfalls (*.%1);;All Files (*.*)")
+                                                                      .arg(QString(SPECTRO_OFFLINE_PRODUCT_EXT)));
+        if (filePath.isEmpty()) {
+            return;
+        }
+
+        //
+        // Generating (or reading back) the waterfall happens upon a background thread, which then displays the results
+        // once finished!
+        const QFileInfo fileInfo(filePath);
+        if (fileInfo.suffix().compare(SPECTRO_OFFLINE_PRODUCT_EXT, Qt::CaseInsensitive) == 0) {
+            gkOfflineSpectro->loadFromFile(fileInfo);
+            return;
+        }
+
+        gkOfflineSpectro->generateFromFile(fileInfo);
+        gkEventLogger->publishEvent(tr("Generating a waterfall from recorded audio file, \"%1\"...").arg(fileInfo.fileName()),
+                                    GkSeverity::Info, "", false, true, false, false, false);
+    } catch (const std::exception &e) {
+        QMessageBox::warning(this, tr("Error!"), e.what(), QMessageBox::Ok);
+    }
+
+    return;
+}
+
+/**
+ * @brief MainWindow::on_actionSave_Waterfall_triggered saves the waterfall that was generated from a recording, so that it
+ * may be opened again via File > Open without having to re-analyse the recording.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void MainWindow::on_actionSave_Waterfall_triggered()
+{
+    try {
+        if (!gkSpectroWaterfall) {
+            return;
+        }
+
+        const auto product = gkSpectroWaterfall->getSpectroProduct();
+        if (!product) {
+            return;
+        }
+
+        const QString defPath = QStandardPaths::writableLocation(QStandardPaths::MusicLocation);
+        QString filePath = QFileDialog::getSaveFileName(this, tr("Save Waterfall"), defPath,
+                                                        tr("Saved Waterfalls (*.%1)").arg(QString(SPECTRO_OFFLINE_PRODUCT_EXT)));
+        if (filePath.isEmpty()) {
+            return;
+        }
+
+        if (QFileInfo(filePath).suffix().isEmpty()) {
+            filePath.append(QString(".%1").arg(QString(SPECTRO_OFFLINE_PRODUCT_EXT)));
+        }
+
+        GkOfflineSpectro::saveProduct(*product, QFileInfo(filePath));
+        gkEventLogger->publishEvent(tr("Saved the waterfall towards, \"%1\".").arg(QFileInfo(filePath).fileName()),
+                                    GkSeverity::Info, "", false, true, false, false, false);
+    } catch (const std::exception &e) {
+        QMessageBox::warning(this, tr("Error!"), e.what(), QMessageBox::Ok);
+    }
+
+    return;
+}
+
+/**
+ * @brief MainWindow::on_actionReturn_to_Live_Waterfall_triggered closes the waterfall that was generated from a recording,
+ * so that the live waterfall may resume.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void MainWindow::on_actionReturn_to_Live_Waterfall_triggered()
+{
+    if (gkOfflineSpectro) {
+        gkOfflineSpectro->cancel();
+    }
+
+    if (gkSpectroWaterfall) {
+        gkSpectroWaterfall->closeSpectroProduct();
+    }
+
+    return;
+}
+
+/**
+ * @brief MainWindow::offlineSpectroProgress shows how far along the generation of a waterfall from a recording is.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param percentage How much of the recording has been analysed so far.
+ */
+void MainWindow::offlineSpectroProgress(const qint32 &percentage)
+{
+    if (percentage >= 100) {
+        statusBar()->showMessage(tr("Waterfall ready."), 5000);
+    } else {
+        statusBar()->showMessage(tr("Generating waterfall... %1%").arg(QString::number(percentage)));
+    }
+
+    return;
 }
 
 /**
@@ -1610,16 +1907,46 @@ QMultiMap<rig_model_t, std::tuple<const rig_caps *, QString, rig_type>> MainWind
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
  * @param device
  * @param deviceRecBuf The buffer for recording/capturing audio samples towards.
- * @param samples
+ * @param samples The capacity of `deviceRecBuf`, measured in frames (i.e. samples per channel).
  * @note Radosław Cybulski <https://stackoverflow.com/a/56651424>.
  */
 void MainWindow::captureAlcSamples(ALCdevice *device, std::shared_ptr<std::vector<ALshort>> deviceRecBuf, ALCsizei samples)
 {
     try {
+        const ALCsizei buf_frames = samples;
         while (gkSysInputDevStatus == GkAudioRecordStatus::Active) {
-            std::lock_guard<std::mutex> lck_guard(gkCaptureAudioSamplesMtx);
-            alcGetIntegerv(device, ALC_CAPTURE_SAMPLES, (ALCsizei)sizeof(ALint), &samples);
-            alcCaptureSamples(device, reinterpret_cast<ALCvoid *>(deviceRecBuf->data()), samples);
+            ALCint avail_frames = 0;
+            {
+                std::lock_guard<std::mutex> lck_guard(gkCaptureAudioSamplesMtx);
+                alcGetIntegerv(device, ALC_CAPTURE_SAMPLES, 1, &avail_frames);
+                avail_frames = std::min(avail_frames, buf_frames); // Never capture more than the buffer can hold!
+                if (avail_frames > 0) {
+                    alcCaptureSamples(device, reinterpret_cast<ALCvoid *>(deviceRecBuf->data()), avail_frames);
+                }
+            }
+
+            if (avail_frames > 0) {
+                if (gkAudioMeter) {
+                    gkAudioMeter->process(deviceRecBuf->data(), static_cast<size_t>(avail_frames));
+                }
+
+                std::lock_guard<std::mutex> lck_guard(gkDecodeFeedMtx);
+                if (!m_sdrDecodeActive) {
+                    //
+                    // Whilst the SDR is streaming, the decoders are instead fed from the digital down-converter!
+                    if (gkFtxDecoder) {
+                        gkFtxDecoder->process(deviceRecBuf->data(), static_cast<size_t>(avail_frames));
+                    }
+
+                    #ifdef CODEC2_LIBS_ENBLD
+                    if (gkCodec2) {
+                        gkCodec2->process(deviceRecBuf->data(), static_cast<size_t>(avail_frames));
+                    }
+                    #endif
+                }
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(AUDIO_METER_CAPTURE_IDLE_MILLISECS));
+            }
         }
     } catch (const std::exception &e) {
         for (auto it = gkSysInputAudioDevs.begin(), end = gkSysInputAudioDevs.end(); it != end; ++it) {
@@ -1634,6 +1961,130 @@ void MainWindow::captureAlcSamples(ALCdevice *device, std::shared_ptr<std::vecto
     return;
 }
 
+/**
+ * @brief MainWindow::configureDecoders readies the decoders of FT8 and Codec2 for whichever audio is to feed them, being
+ * either the input audio device or the primary channel of the digital down-converter, but never both at once.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param input_rate The sample rate of the audio that is to feed the decoders.
+ * @param channels The number of interleaved channels within that audio.
+ * @param max_frames The most frames that will ever be given at once.
+ * @param from_sdr Whether the audio is from the digital down-converter (i.e. true) or the input audio device (i.e. false).
+ */
+void MainWindow::configureDecoders(const quint32 &input_rate, const quint16 &channels, const size_t &max_frames, const bool &from_sdr)
+{
+    if (gkFtxDecoder) {
+        gkFtxDecoder->stop();
+    }
+
+    #ifdef CODEC2_LIBS_ENBLD
+    if (gkCodec2) {
+        gkCodec2->stop();
+    }
+    #endif
+
+    {
+        std::lock_guard<std::mutex> lck_guard(gkDecodeFeedMtx);
+        m_sdrDecodeActive = from_sdr;
+        m_sdrDecodeBuf.assign(from_sdr ? max_frames : 0, 0);
+        if (gkFtxDecoder) {
+            gkFtxDecoder->configure(input_rate, channels, max_frames);
+        }
+
+        #ifdef CODEC2_LIBS_ENBLD
+        if (gkCodec2) {
+            gkCodec2->configureRx(input_rate, channels, max_frames);
+        }
+        #endif
+    }
+
+    if (gkFtxDecoder) {
+        gkFtxDecoder->start();
+    }
+
+    #ifdef CODEC2_LIBS_ENBLD
+    if (gkCodec2) {
+        gkCodec2->start();
+    }
+    #endif
+
+    return;
+}
+
+/**
+ * @brief MainWindow::feedSdrChannelAudio is fed with the audio of the primary channel of the digital down-converter,
+ * upon that channel's own thread, and hands it towards the decoders and the waterfall whilst the SDR is streaming.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param samples The channel's audio, as mono floating-point samples.
+ * @param count The number of samples.
+ */
+void MainWindow::feedSdrChannelAudio(const float *samples, const size_t &count)
+{
+    {
+        std::lock_guard<std::mutex> lck_guard(gkDecodeFeedMtx);
+        if (!m_sdrDecodeActive || m_sdrDecodeBuf.empty()) {
+            return;
+        }
+
+        size_t offset = 0;
+        while (offset < count) {
+            const size_t chunk = std::min(count - offset, m_sdrDecodeBuf.size());
+            for (size_t i = 0; i < chunk; ++i) {
+                m_sdrDecodeBuf[i] = static_cast<qint16>(std::clamp(samples[offset + i], -1.0f, 1.0f) * 32767.0f);
+            }
+
+            if (gkFtxDecoder) {
+                gkFtxDecoder->process(m_sdrDecodeBuf.data(), chunk);
+            }
+
+            #ifdef CODEC2_LIBS_ENBLD
+            if (gkCodec2) {
+                gkCodec2->process(m_sdrDecodeBuf.data(), chunk);
+            }
+            #endif
+
+            offset += chunk;
+        }
+    }
+
+    if (gkFftAudio) {
+        gkFftAudio->pushChannelAudio(samples, count);
+    }
+
+    return;
+}
+
+/**
+ * @brief MainWindow::routeSdrWaterfall decides what the waterfall is drawn from whilst the SDR is streaming. A demodulated
+ * primary channel is drawn from its audio, as with the input audio device, whereas raw IQ is drawn across the whole
+ * width of the stream instead.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param modulation The modulation of the primary channel.
+ */
+void MainWindow::routeSdrWaterfall(const GkSdrModulation &modulation)
+{
+    if (m_sdrStreamRate <= 0.0) {
+        return;
+    }
+
+    if (gkFftAudio && modulation != SdrModRaw) {
+        if (gkWidebandSpectrum) {
+            gkWidebandSpectrum->stop();
+        }
+
+        gkFftAudio->recordChannelStream(static_cast<qint32>(m_sdrAudioRate));
+    } else {
+        if (gkFftAudio) {
+            gkFftAudio->stopRecordStream();
+        }
+
+        if (gkWidebandSpectrum) {
+            gkWidebandSpectrum->start(m_sdrStreamRate);
+        }
+    }
+
+    return;
+}
+
 /**
  * @brief MainWindow::fileOverloadWarning will warn the user about loading too many files (i.e. usually images in this case) into
  * memory and ask via QMessageBox if they really wish to proceed, despite being given all warnings about the dangers.
@@ -2098,9 +2549,9 @@ void MainWindow::launchXmppRosterDlg()
     try {
         if (!gkConnDetails.server.url.isEmpty() && !gkConnDetails.jid.isEmpty()) {
             if (!gkXmppRosterDlg) {
-                m_rosterList = m_xmppClient->getRosterMap();
+                m_rosterStore = m_xmppClient->getRosterStore();
                 gkXmppRosterDlg = new GkXmppRosterDialog(gkStringFuncs, gkConnDetails, m_xmppClient, gkDb,
-                                                         gkSystem, gkEventLogger, m_rosterList, true, this);
+                                                         gkSystem, gkEventLogger, m_rosterStore, true, this);
             }
 
             if (gkXmppRosterDlg) { // Verify that we have successfully created the Roster dialog within memory!
@@ -2669,50 +3120,109 @@ void MainWindow::procRigPort(const QString &conn_port, const GekkoFyre::AmateurR
 }
 
 /**
- * @brief MainWindow::findSoapySdrDevs enumerates any discovered SDR devices found through the end-user's local machine
- * via SoapySDR and any provided, applicable drivers.
+ * @brief MainWindow::findSoapySdrDevs asks for any SDR devices found through the end-user's local machine via SoapySDR
+ * and any provided, applicable drivers to be enumerated. This returns straight away, with the results arriving via
+ * MainWindow::foundSoapySdrDevs() should anything have changed since the last enumeration.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param kwargs Arguments to be provided to SoapySDR itself in the enumeration of any SDR devices, if applicable.
+ * @see GkSdrDiscovery::refresh().
  */
 void MainWindow::findSoapySdrDevs()
 {
-    try {
-        //
-        // Enumerate any discovered SDR devices (and applicable information)!
-        m_sdrDevs.clear();
-        const auto devsFound = gkSdrDev->enumSoapySdrDevs();
-        m_sdrDevs = devsFound;
-        emit foundSoapySdrDevs(m_sdrDevs);
-    } catch (const std::exception &e) {
-        print_exception(e);
+    if (gkSdrDiscovery) {
+        gkSdrDiscovery->refresh();
     }
 
     return;
 }
 
 /**
- * @brief MainWindow::discSoapySdrDevs processes any SDR devices that have been enumerated via SoapySDR.
+ * @brief MainWindow::discSoapySdrDevs processes any SDR devices that have been enumerated via SoapySDR. Whatever has
+ * been chosen for those devices that were already known of is kept, as is the selection within the QComboBoxes, so that
+ * a device coming or going does not disturb one that is in use.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
  * @param sdr_devs A QList of SDR devices that have been enumerated via SoapySDR.
  * @see MainWindow::foundSoapySdrDevs().
  */
 void MainWindow::discSoapySdrDevs(const QList<GekkoFyre::System::GkSdr::GkSoapySdrTableView> &sdr_devs)
 {
-    //
-    // Setup any SDR QComboBoxes and/or QTableViews!
-    if (!sdr_devs.isEmpty()) {
-        for (const auto &dev: sdr_devs) {
-            ui->comboBox_main_soapysdr_source_hw_key->addItem(dev.dev_hw_key);
+    QList<GkSoapySdrTableView> merged_devs;
+    for (auto dev: sdr_devs) {
+        for (const auto &prev_dev: m_sdrDevs) {
+            if (prev_dev.dev_key == dev.dev_key && prev_dev.dev_ptr == dev.dev_ptr) {
+                dev.running = prev_dev.running;
+                dev.initialized = prev_dev.initialized;
+                dev.curr_rx_channel = prev_dev.curr_rx_channel;
+                dev.avail_sample_rates = prev_dev.avail_sample_rates;
+                dev.avail_bwidth_views = prev_dev.avail_bwidth_views;
+                break;
+            }
         }
 
-        return;
+        merged_devs.push_back(dev);
     }
 
     //
-    // No devices were detected through enumeration!
-    ui->comboBox_main_soapysdr_source_hw_key->addItem(Filesystem::soapySdrNoDevsFound);
-    ui->comboBox_main_soapysdr_source_hw_id_enum->addItem(Filesystem::soapySdrNoDevsFoundAlt);
+    // Streaming must cease should the device in use have been unplugged!
+    for (const auto &prev_dev: m_sdrDevs) {
+        if (prev_dev.initialized) {
+            const bool present = std::any_of(merged_devs.begin(), merged_devs.end(), [&prev_dev](const GkSoapySdrTableView &dev) {
+                return dev.dev_key == prev_dev.dev_key;
+            });
+
+            if (!present) {
+                stopSoapySdrStream();
+                gkEventLogger->publishEvent(tr("SDR device, \"%1\", has been removed whilst in use!").arg(prev_dev.dev_name),
+                                            GkSeverity::Warning, "", false, true, false, true, false);
+            }
+        }
+    }
 
+    m_sdrDevs = merged_devs;
+    const QString prev_hw_key = ui->comboBox_main_soapysdr_source_hw_key->currentText();
+    const QString prev_dev_name = ui->comboBox_main_soapysdr_source_hw_id_enum->currentText();
+
+    //
+    // Setup any SDR QComboBoxes and/or QTableViews!
+    {
+        const QSignalBlocker hw_key_blocker(ui->comboBox_main_soapysdr_source_hw_key);
+        const QSignalBlocker hw_id_blocker(ui->comboBox_main_soapysdr_source_hw_id_enum);
+        ui->comboBox_main_soapysdr_source_hw_key->clear();
+        ui->comboBox_main_soapysdr_source_hw_id_enum->clear();
+
+        if (m_sdrDevs.isEmpty()) {
+            //
+            // No devices were detected through enumeration!
+            ui->comboBox_main_soapysdr_source_hw_key->addItem(Filesystem::soapySdrNoDevsFound);
+            ui->comboBox_main_soapysdr_source_hw_id_enum->addItem(Filesystem::soapySdrNoDevsFoundAlt);
+            ui->comboBox_main_soapysdr_source_rx_channel->clear();
+
+            return;
+        }
+
+        QStringList hw_keys;
+        for (const auto &dev: m_sdrDevs) {
+            if (!hw_keys.contains(dev.dev_hw_key)) {
+                hw_keys.push_back(dev.dev_hw_key);
+            }
+        }
+
+        ui->comboBox_main_soapysdr_source_hw_key->addItems(hw_keys);
+        const qint32 hw_key_idx = ui->comboBox_main_soapysdr_source_hw_key->findText(prev_hw_key);
+        if (hw_key_idx >= 0) {
+            ui->comboBox_main_soapysdr_source_hw_key->setCurrentIndex(hw_key_idx);
+            on_comboBox_main_soapysdr_source_hw_key_currentIndexChanged(prev_hw_key);
+
+            const qint32 dev_idx = ui->comboBox_main_soapysdr_source_hw_id_enum->findText(prev_dev_name);
+            if (dev_idx >= 0) {
+                //
+                // The device chosen beforehand is still present, so everything is left just as it was
+                ui->comboBox_main_soapysdr_source_hw_id_enum->setCurrentIndex(dev_idx);
+                return;
+            }
+        }
+    }
+
+    on_comboBox_main_soapysdr_source_hw_key_currentIndexChanged(ui->comboBox_main_soapysdr_source_hw_key->currentText());
     return;
 }
 
@@ -3135,10 +3645,14 @@ void MainWindow::on_comboBox_main_soapysdr_source_hw_id_enum_currentIndexChanged
         return;
     }
 
+    ui->comboBox_main_soapysdr_source_rx_channel->clear();
     for (const auto &dev: m_sdrDevs) {
-        const auto num_chan = dev.dev_ptr->getNumChannels(SOAPY_SDR_RX);
-        for (size_t i = 0; i < num_chan; ++i) {
-            ui->comboBox_main_soapysdr_source_rx_channel->addItem(QString::number(i));
+        if (dev.dev_name == arg1) {
+            for (size_t i = 0; i < dev.rx_channels.size(); ++i) {
+                ui->comboBox_main_soapysdr_source_rx_channel->addItem(QString::number(i));
+            }
+
+            break;
         }
     }
 
@@ -3161,25 +3675,25 @@ void MainWindow::on_comboBox_main_soapysdr_source_rx_channel_currentIndexChanged
     emit refreshSoapySdrBandwidthComboBoxes();
     emit refreshSoapySdrGainComboBoxes();
 
-    for (auto it = m_sdrDevs.begin(), end = m_sdrDevs.end(); it != end; ++it) {
-        it->dev_ptr.reset();
-    }
-
     //
-    // Initiate SoapySDR device enumeration and thusly new pointer creation now we are attempting a new RX channel!
-    emit searchSoapySdrDevs();
+    // The stream is bound towards the RX channel in use, so it must cease before another may be chosen
+    stopSoapySdrStream();
 
     const qint32 idx = arg1.toInt();
-    for (auto it = m_sdrDevs.begin(), end = m_sdrDevs.end(); it != end; ++it) {
-        it->curr_rx_channel = idx;
-    }
-
+    const auto curr_sel_dev = ui->comboBox_main_soapysdr_source_hw_id_enum->currentText();
     try {
         for (auto it = m_sdrDevs.begin(), end = m_sdrDevs.end(); it != end; ++it) {
-            const auto avail_bw = it->dev_ptr->listBandwidths(SOAPY_SDR_RX, idx);
-            it->avail_bwidth_views = avail_bw;
+            if (it->dev_name != curr_sel_dev || idx < 0 || idx >= static_cast<qint32>(it->rx_channels.size())) {
+                continue;
+            }
+
+            //
+            // What each RX channel is capable of was found out upon discovery, so the hardware need not be asked again
+            const auto &caps = it->rx_channels[idx];
+            it->curr_rx_channel = idx;
+            it->avail_bwidth_views = caps.bandwidths;
             QList<qreal> added_bwidth_views;
-            for (const auto &bw: avail_bw) {
+            for (const auto &bw: caps.bandwidths) {
                 if (!added_bwidth_views.contains(bw)) {
                     //
                     // Enumerate available bandwidth options!
@@ -3190,10 +3704,9 @@ void MainWindow::on_comboBox_main_soapysdr_source_rx_channel_currentIndexChanged
                 }
             }
 
-            const auto avail_sr = it->dev_ptr->listSampleRates(SOAPY_SDR_RX, idx);
-            it->avail_sample_rates = avail_sr;
+            it->avail_sample_rates = caps.sample_rates;
             QList<qreal> added_sample_rates;
-            for (const auto &sr: avail_sr) {
+            for (const auto &sr: caps.sample_rates) {
                 if (!added_sample_rates.contains(sr)) {
                     //
                     // Enumerate available sample rate options!
@@ -3204,11 +3717,10 @@ void MainWindow::on_comboBox_main_soapysdr_source_rx_channel_currentIndexChanged
                 }
             }
 
-            const auto avail_gain_modes = it->dev_ptr->listGains(SOAPY_SDR_RX, idx);
-            for (const auto &gain_m: avail_gain_modes) {
+            for (const auto &gain_m: caps.gains) {
                 //
                 // Enumerate available signal gain options!
-                ui->comboBox_main_soapysdr_source_gain_control_mode->addItem(QString::fromStdString(gain_m));
+                ui->comboBox_main_soapysdr_source_gain_control_mode->addItem(gain_m);
                 ui->comboBox_main_soapysdr_source_gain_control_mode->setToolTip(tr("Signal gain (Channel #%1).").arg(QString::number(idx)));
             }
 
@@ -3273,8 +3785,36 @@ void MainWindow::on_comboBox_main_soapysdr_source_samplerate_activated(qint32 in
         for (auto it = m_sdrDevs.begin(), end = m_sdrDevs.end(); it != end; ++it) {
             if (it->initialized) {
                 if (it->dev_name == curr_sel_dev) {
+                    if (gkSdrDdc) {
+                        gkSdrDdc->stop();
+                    }
+
+                    if (gkSigmfRecorder) {
+                        //
+                        // Any recording that was underway is finished off, as its sample rate is about to change
+                        gkSigmfRecorder->stop();
+                        gkSigmfRecorder->setHardware(it->dev_name);
+                        gkSigmfRecorder->setCenterFrequency(it->dev_ptr->getFrequency(SOAPY_SDR_RX, it->curr_rx_channel));
+                    }
+
+                    if (gkWidebandSpectrum) {
+                        gkWidebandSpectrum->stop();
+                        gkWidebandSpectrum->setDisplayWidth(static_cast<quint32>(gkSpectroWaterfall->getSpectrogramPlot()->canvas()->width()));
+                        gkWidebandSpectrum->setCenterFrequency(it->dev_ptr->getFrequency(SOAPY_SDR_RX, it->curr_rx_channel));
+                    }
+
+                    if (gkSdrStream) {
+                        gkSdrStream->stop();
+                    }
+
                     it->dev_ptr->setSampleRate(SOAPY_SDR_RX, it->curr_rx_channel, ui->comboBox_main_soapysdr_source_samplerate->currentData().toInt());
 
+                    if (gkSdrStream) {
+                        //
+                        // (Re)start streaming from the device at its new sample rate!
+                        gkSdrStream->start(std::make_unique<GkSoapyIqSource>(it->dev_ptr, static_cast<size_t>(it->curr_rx_channel)));
+                    }
+
                     break;
                 }
             }
@@ -3287,6 +3827,84 @@ void MainWindow::on_comboBox_main_soapysdr_source_samplerate_activated(qint32 in
     return;
 }
 
+/**
+ * @brief MainWindow::sdrStreamError is called whenever streaming from the SDR device ceases due to an error.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param error_msg The reason as to why streaming has ceased.
+ */
+void MainWindow::sdrStreamError(const QString &error_msg)
+{
+    gkEventLogger->publishEvent(error_msg, GkSeverity::Error, "", false, true, false, true, false);
+    return;
+}
+
+/**
+ * @brief MainWindow::sdrModulationChanged hands the newly chosen modulation towards the primary channel of the digital
+ * down-converter.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param modulation The modulation that has been chosen for the SDR device.
+ */
+void MainWindow::sdrModulationChanged(const GkSdrModulation &modulation)
+{
+    if (gkSdrDdc) {
+        gkSdrDdc->setModulation(m_sdrPrimaryChannel, modulation);
+    }
+
+    routeSdrWaterfall(modulation);
+
+    return;
+}
+
+/**
+ * @brief MainWindow::sdrStreamStarted hands the decoders and the waterfall over towards the primary channel of the digital
+ * down-converter, for as long as the SDR is streaming.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param sample_rate The sample rate of the stream.
+ */
+void MainWindow::sdrStreamStarted(const double &sample_rate)
+{
+    m_sdrStreamRate = sample_rate;
+    if (gkSdrDdc && m_sdrPrimaryChannel >= 0) {
+        configureDecoders(static_cast<quint32>(m_sdrAudioRate), 1, GK_SDR_DDC_CHUNK_SAMPLES, true);
+        routeSdrWaterfall(gkSdrDev->getModulation());
+    } else if (gkWidebandSpectrum) {
+        if (gkFftAudio) {
+            gkFftAudio->stopRecordStream();
+        }
+
+        gkWidebandSpectrum->start(sample_rate);
+    }
+
+    return;
+}
+
+/**
+ * @brief MainWindow::sdrStreamFinished hands the decoders and the waterfall back towards the input audio device, once
+ * the SDR has ceased streaming.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void MainWindow::sdrStreamFinished()
+{
+    m_sdrStreamRate = 0.0;
+    if (gkWidebandSpectrum) {
+        gkWidebandSpectrum->stop();
+    }
+
+    if (m_captureRate > 0) {
+        configureDecoders(m_captureRate, m_captureChannels, static_cast<size_t>(audioFrameSampleCountPerChannel), false);
+    } else {
+        std::lock_guard<std::mutex> lck_guard(gkDecodeFeedMtx);
+        m_sdrDecodeActive = false;
+    }
+
+    if (gkFftAudio) {
+        gkFftAudio->stopRecordStream();
+        gkFftAudio->recordAudioStream();
+    }
+
+    return;
+}
+
 /**
  * @brief MainWindow::on_comboBox_main_soapysdr_source_gain_control_mode_currentIndexChanged manages the signal gain and
  * related for the SDR device in question.
@@ -3330,6 +3948,8 @@ void MainWindow::on_radioButton_soapysdr_source_modulation_nfm_clicked(bool chec
         ui->radioButton_soapysdr_source_modulation_dsb->setChecked(false);
         ui->radioButton_soapysdr_source_modulation_cw->setChecked(false);
         ui->radioButton_soapysdr_source_modulation_raw->setChecked(false);
+
+        gkSdrDev->setModulation(SdrModNfm);
     }
 
     emit repaintSoapySdrRadioButtons();
@@ -3353,6 +3973,8 @@ void MainWindow::on_radioButton_soapysdr_source_modulation_am_clicked(bool check
         ui->radioButton_soapysdr_source_modulation_dsb->setChecked(false);
         ui->radioButton_soapysdr_source_modulation_cw->setChecked(false);
         ui->radioButton_soapysdr_source_modulation_raw->setChecked(false);
+
+        gkSdrDev->setModulation(SdrModAm);
     }
 
     emit repaintSoapySdrRadioButtons();
@@ -3376,6 +3998,8 @@ void MainWindow::on_radioButton_soapysdr_source_modulation_usb_clicked(bool chec
         ui->radioButton_soapysdr_source_modulation_dsb->setChecked(false);
         ui->radioButton_soapysdr_source_modulation_cw->setChecked(false);
         ui->radioButton_soapysdr_source_modulation_raw->setChecked(false);
+
+        gkSdrDev->setModulation(SdrModUsb);
     }
 
     emit repaintSoapySdrRadioButtons();
@@ -3399,6 +4023,8 @@ void MainWindow::on_radioButton_soapysdr_source_modulation_lsb_clicked(bool chec
         ui->radioButton_soapysdr_source_modulation_dsb->setChecked(false);
         ui->radioButton_soapysdr_source_modulation_cw->setChecked(false);
         ui->radioButton_soapysdr_source_modulation_raw->setChecked(false);
+
+        gkSdrDev->setModulation(SdrModLsb);
     }
 
     emit repaintSoapySdrRadioButtons();
@@ -3422,6 +4048,8 @@ void MainWindow::on_radioButton_soapysdr_source_modulation_wfm_clicked(bool chec
         ui->radioButton_soapysdr_source_modulation_dsb->setChecked(false);
         ui->radioButton_soapysdr_source_modulation_cw->setChecked(false);
         ui->radioButton_soapysdr_source_modulation_raw->setChecked(false);
+
+        gkSdrDev->setModulation(SdrModWfm);
     }
 
     emit repaintSoapySdrRadioButtons();
@@ -3445,6 +4073,8 @@ void MainWindow::on_radioButton_soapysdr_source_modulation_dsb_clicked(bool chec
         ui->radioButton_soapysdr_source_modulation_wfm->setChecked(false);
         ui->radioButton_soapysdr_source_modulation_cw->setChecked(false);
         ui->radioButton_soapysdr_source_modulation_raw->setChecked(false);
+
+        gkSdrDev->setModulation(SdrModDsb);
     }
 
     emit repaintSoapySdrRadioButtons();
@@ -3468,6 +4098,8 @@ void MainWindow::on_radioButton_soapysdr_source_modulation_cw_clicked(bool check
         ui->radioButton_soapysdr_source_modulation_wfm->setChecked(false);
         ui->radioButton_soapysdr_source_modulation_dsb->setChecked(false);
         ui->radioButton_soapysdr_source_modulation_raw->setChecked(false);
+
+        gkSdrDev->setModulation(SdrModCw);
     }
 
     emit repaintSoapySdrRadioButtons();
@@ -3491,6 +4123,8 @@ void MainWindow::on_radioButton_soapysdr_source_modulation_raw_clicked(bool chec
         ui->radioButton_soapysdr_source_modulation_wfm->setChecked(false);
         ui->radioButton_soapysdr_source_modulation_dsb->setChecked(false);
         ui->radioButton_soapysdr_source_modulation_cw->setChecked(false);
+
+        gkSdrDev->setModulation(SdrModRaw);
     }
 
     emit repaintSoapySdrRadioButtons();
@@ -3805,9 +4439,24 @@ void MainWindow::on_pushButton_sstv_tx_send_image_clicked()
         // Initialize any amateur radio modems!
         //
         #ifdef CODEC2_LIBS_ENBLD
-        QPointer<GkCodec2> gkCodec2 = new GkCodec2(Codec2Mode::freeDvMode2020, Codec2ModeCustom::GekkoFyreV1, 0, 0, gkDb,
-                                                   gkEventLogger, gkStringFuncs, this);
-        gkCodec2->transmitData(byte_array, true);
+        if (gkCodec2) {
+            if (!gkAudioMixer || !gkAudioMixer->isRunning()) {
+                QMessageBox::information(this, tr("No output audio device!"), tr("Please ensure that an output audio device has been configured before attempting to make a transmission."),
+                                         QMessageBox::Ok);
+                return;
+            }
+
+            try {
+                const int num_samples = gkCodec2->transmitData(byte_array);
+                const qint32 burst_ms = playCodec2Burst(num_samples);
+                ui->pushButton_sstv_tx_send_image->setEnabled(!gkCodec2->isSending());
+                if (m_codec2TxTimer) {
+                    m_codec2TxTimer->start(burst_ms + GK_CODEC2_ARQ_TURN_MILLISECS);
+                }
+            } catch (const std::exception &e) {
+                gkEventLogger->publishEvent(QString::fromStdString(e.what()), GkSeverity::Warning, "", false, true, false, true, false);
+            }
+        }
         #endif
     } else {
         QMessageBox::information(this, tr("No image!"), tr("Please ensure to have an image loaded before attempting to make a transmission."), QMessageBox::Ok);
@@ -3816,6 +4465,76 @@ void MainWindow::on_pushButton_sstv_tx_send_image_clicked()
     return;
 }
 
+/**
+ * @brief MainWindow::codec2TxTurn is our turn upon the data link, once the far end has had its own. Whatever is yet to be
+ * acknowledged is sent again, along with an acknowledgement of whatever has been received, unless the far end is still
+ * being heard, in which case our turn is put off until it has finished.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void MainWindow::codec2TxTurn()
+{
+    #ifdef CODEC2_LIBS_ENBLD
+    if (!gkCodec2 || !m_codec2TxTimer) {
+        return;
+    }
+
+    qint32 next_ms = GK_CODEC2_ARQ_TURN_MILLISECS;
+    try {
+        if (gkCodec2->isSynced()) {
+            next_ms = GK_CODEC2_ARQ_BUSY_MILLISECS;
+        } else {
+            next_ms += playCodec2Burst(gkCodec2->transmitBurst());
+        }
+    } catch (const std::exception &e) {
+        gkEventLogger->publishEvent(tr("An issue has occurred with transmitting data via the Codec2 modem! Error: %1").arg(QString::fromStdString(e.what())),
+                                    GkSeverity::Warning, "", false, true, false, false, false);
+    }
+
+    ui->pushButton_sstv_tx_send_image->setEnabled(!gkCodec2->isSending());
+    m_codec2TxTimer->start(next_ms);
+    #endif
+
+    return;
+}
+
+#ifdef CODEC2_LIBS_ENBLD
+/**
+ * @brief MainWindow::playCodec2Burst plays the modem audio of the last burst of the data link through the mixer, having
+ * been brought up towards the mixer's own sample rate.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param num_samples The number of samples of modem audio, as returned by GkCodec2::transmitBurst().
+ * @return How long the burst takes to play out, in milliseconds.
+ */
+qint32 MainWindow::playCodec2Burst(const int &num_samples)
+{
+    if (num_samples <= 0 || !gkAudioMixer || !gkAudioMixer->isRunning()) {
+        return 0;
+    }
+
+    const auto &tx_audio = gkCodec2->getTxAudio();
+    const auto count = std::min(static_cast<size_t>(num_samples), tx_audio.size());
+    std::vector<float> modem_audio(count);
+    for (size_t i = 0; i < count; ++i) {
+        modem_audio[i] = static_cast<float>(tx_audio[i]) / 32768.0f;
+    }
+
+    GkAudioResampler resampler;
+    resampler.configure(gkCodec2->getModemSampleRate(), gkAudioMixer->getSampleRate());
+    std::vector<float> mixer_audio(resampler.maxOutput(count));
+    const size_t mixer_count = resampler.process(modem_audio.data(), count, mixer_audio.data());
+
+    //
+    // The whole burst is written before it is handed over, and the stream closed afterwards so that the mixer lets go of
+    // it once it has been played out
+    auto burst_stream = std::make_shared<GkAudioStream>(gkAudioMixer->getSampleRate(), mixer_count);
+    burst_stream->write(mixer_audio.data(), mixer_count);
+    gkAudioMixer->playStream(burst_stream);
+    burst_stream->close();
+
+    return static_cast<qint32>((mixer_count * 1000) / gkAudioMixer->getSampleRate());
+}
+#endif
+
 /**
  * @brief MainWindow::on_pushButton_sstv_rx_remove_clicked
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
@@ -3879,6 +4598,32 @@ void MainWindow::on_actionConnect_triggered()
     return;
 }
 
+/**
+ * @brief MainWindow::stopSoapySdrStream stops streaming from the SDR device, along with everything that consumes the
+ * stream, which must always cease beforehand.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void MainWindow::stopSoapySdrStream()
+{
+    if (gkWidebandSpectrum) {
+        gkWidebandSpectrum->stop();
+    }
+
+    if (gkSdrDdc) {
+        gkSdrDdc->stop();
+    }
+
+    if (gkSigmfRecorder) {
+        gkSigmfRecorder->stop();
+    }
+
+    if (gkSdrStream) {
+        gkSdrStream->stop();
+    }
+
+    return;
+}
+
 /**
  * @brief MainWindow::print_exception
  * @param e
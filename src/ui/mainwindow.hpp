@@ -47,6 +47,7 @@
 #include "src/ui/gkatlasdialog.hpp"
 #include "src/gk_waterfall_gui.hpp"
 #include "src/gk_fft_audio.hpp"
+#include "src/gk_offline_spectro.hpp"
 #include "src/gk_frequency_list.hpp"
 #include "src/gk_xmpp_client.hpp"
 #include "src/update/gk_network.hpp"
@@ -60,7 +61,16 @@
 #include "src/gk_system.hpp"
 #include "src/gk_string_funcs.hpp"
 #include "src/gk_multimedia.hpp"
+#include "src/gk_audio_mixer.hpp"
+#include "src/gk_audio_meter.hpp"
 #include "src/gk_sdr.hpp"
+#include "src/gk_sdr_stream.hpp"
+#include "src/gk_sdr_ddc.hpp"
+#include "src/gk_sdr_discovery.hpp"
+#include "src/gk_sigmf.hpp"
+#include "src/gk_ftx_decoder.hpp"
+#include "src/gk_codec2.hpp"
+#include "src/gk_wideband_spectrum.hpp"
 #include <marble/MarbleWidget.h>
 #include <SoapySDR/Modules.hpp>
 #include <SoapySDR/Formats.hpp>
@@ -132,6 +142,8 @@ private slots:
     void on_actionXMPP_triggered();
     void on_actionE_xit_triggered();
     void on_action_Open_triggered();
+    void on_actionSave_Waterfall_triggered();
+    void on_actionReturn_to_Live_Waterfall_triggered();
     void on_actionCheck_for_Updates_triggered();
     void on_action_About_Dekoder_triggered();
     void on_actionSet_Offset_triggered();
@@ -286,6 +298,7 @@ private slots:
     void on_pushButton_sstv_tx_navigate_right_clicked();
     void on_pushButton_sstv_tx_load_image_clicked();
     void on_pushButton_sstv_tx_send_image_clicked();
+    void codec2TxTurn();
     void on_pushButton_sstv_tx_remove_clicked();
 
     //
@@ -330,6 +343,11 @@ protected slots:
     void discSoapySdrDevs(const QList<GekkoFyre::System::GkSdr::GkSoapySdrTableView> &sdr_devs);
     void updateSoapySdrBandwidthComboBoxes();
     void updateSoapySdrGainComboBoxes();
+    void sdrStreamError(const QString &error_msg);
+    void sdrModulationChanged(const GekkoFyre::System::GkSdr::GkSdrModulation &modulation);
+    void sdrStreamStarted(const double &sample_rate);
+    void sdrStreamFinished();
+    void offlineSpectroProgress(const qint32 &percentage);
 
 public slots:
     void restartInputAudioInterface(const GekkoFyre::Database::Settings::Audio::GkDevice &input_device);
@@ -411,11 +429,23 @@ private:
     QPointer<GekkoFyre::FileIo> gkFileIo;
     QPointer<GekkoFyre::GkFrequencies> gkFreqList;
     QPointer<GekkoFyre::RadioLibs> gkRadioLibs;
-    // QPointer<GekkoFyre::GkVuMeter> gkVuMeter;
+    QPointer<GekkoFyre::GkVuMeter> gkVuMeter;
+    std::shared_ptr<GekkoFyre::GkAudioMeter> gkAudioMeter;             // Meters the captured audio, upon the capture thread itself.
     QPointer<GekkoFyre::GkModem> gkModem;
     QPointer<GekkoFyre::GkSystem> gkSystem;
     QPointer<GekkoFyre::GkMultimedia> gkMultimedia;
+    QPointer<GekkoFyre::GkAudioMixer> gkAudioMixer;
     QPointer<GekkoFyre::GkSdrDev> gkSdrDev;
+    QPointer<GekkoFyre::GkSdrDiscovery> gkSdrDiscovery;
+    QPointer<GekkoFyre::GkSdrStream> gkSdrStream;
+    QPointer<GekkoFyre::GkSdrDdc> gkSdrDdc;
+    QPointer<GekkoFyre::GkSigmfRecorder> gkSigmfRecorder;
+    QPointer<GekkoFyre::GkFtxDecoder> gkFtxDecoder;
+    #ifdef CODEC2_LIBS_ENBLD
+    QPointer<GekkoFyre::GkCodec2> gkCodec2;
+    QPointer<QTimer> m_codec2TxTimer;                                       // Our turn upon the data link, once the far end has had its own.
+    qint32 playCodec2Burst(const int &num_samples);
+    #endif
     QPointer<GkIntroSetupWizard> gkIntroSetupWizard;
     // QPointer<GekkoFyre::GkTextToSpeech> gkTextToSpeech;
 
@@ -449,6 +479,11 @@ private:
     // Audio sub-system
     //
     void captureAlcSamples(ALCdevice *device, std::shared_ptr<std::vector<ALshort>> deviceRecBuf, ALCsizei samples);
+    void configureDecoders(const quint32 &input_rate, const quint16 &channels, const size_t &max_frames, const bool &from_sdr);
+    void feedSdrChannelAudio(const float *samples, const size_t &count);
+    void routeSdrWaterfall(const GekkoFyre::System::GkSdr::GkSdrModulation &modulation);
+    quint32 m_captureRate = 0;                                                  // The sample rate of the input audio device, once capturing.
+    quint16 m_captureChannels = 0;
     double global_rx_audio_volume;
     double global_tx_audio_volume;
     quint32 m_maxAmplitude;
@@ -459,6 +494,9 @@ private:
     //
     std::timed_mutex btn_record_mtx;
     std::mutex gkCaptureAudioSamplesMtx;
+    std::mutex gkDecodeFeedMtx;                                                 // Guards the decoders against being fed from two places at once.
+    bool m_sdrDecodeActive = false;                                             // Whether the decoders are fed from the SDR rather than the input audio device.
+    std::vector<qint16> m_sdrDecodeBuf;
     std::future<std::shared_ptr<GekkoFyre::AmateurRadio::Control::GkRadio>> rig_future;
     std::thread rig_thread;
     std::thread vu_meter_thread;
@@ -476,6 +514,10 @@ private:
     static QMultiMap<rig_model_t, std::tuple<const rig_caps *, QString, GekkoFyre::AmateurRadio::rig_type>> gkRadioModels;
     std::shared_ptr<GekkoFyre::AmateurRadio::Control::GkRadio> gkRadioPtr;
     QList<GekkoFyre::System::GkSdr::GkSoapySdrTableView> m_sdrDevs;         // Any applicable SDR devices that have been enumerated via SoapySDR!
+    qint32 m_sdrPrimaryChannel = -1;                                              // The channel of the digital down-converter that follows the chosen modulation.
+    std::shared_ptr<GekkoFyre::GkAudioStream> m_sdrAudioStream;                    // The audio of the primary channel, on its way towards the mixer.
+    double m_sdrAudioRate = GK_SDR_DDC_AUDIO_RATE;                                // The sample rate of the primary channel's audio.
+    double m_sdrStreamRate = 0.0;                                                 // The sample rate of the SDR stream, or zero whenever it is not streaming.
     QList<GekkoFyre::AmateurRadio::GkFreqs> frequencyList;
 
     //
@@ -533,12 +575,14 @@ private:
     QPointer<GekkoFyre::GkXmppClient> m_xmppClient;
     QPointer<GkXmppRosterDialog> gkXmppRosterDlg;
     GekkoFyre::Network::GkXmpp::GkUserConn gkConnDetails;
-    std::shared_ptr<QList<GekkoFyre::Network::GkXmpp::GkXmppCallsign>> m_rosterList;   // A list of all the bareJids, including the client themselves!
+    QPointer<GekkoFyre::GkXmppRosterStore> m_rosterStore;                            // All the bareJids, including the client themselves, indexed by bareJid!
 
     //
     // Spectrograph related
     //
     QPointer<GekkoFyre::GkSpectroWaterfall> gkSpectroWaterfall;
+    QPointer<GekkoFyre::GkOfflineSpectro> gkOfflineSpectro;                // Generates waterfalls from recorded audio files!
+    QPointer<GekkoFyre::GkWidebandSpectrum> gkWidebandSpectrum;            // Generates waterfalls from the IQ stream of an SDR device!
     QVector<double> waterfall_samples_vec;
     GekkoFyre::Spectrograph::GkGraphType graph_in_use;
 
@@ -585,6 +629,11 @@ private:
     void createTrayActions();
     void createTrayIcon();
 
+    //
+    // SoapySDR and related
+    //
+    void stopSoapySdrStream();
+
     void print_exception(const std::exception &e, const bool &displayMsgBox = false, int level = 0);
 
 };
@@ -609,10 +658,16 @@ Q_DECLARE_METATYPE(GekkoFyre::AmateurRadio::GkFreqs);
 Q_DECLARE_METATYPE(GekkoFyre::GkAudioFramework::GkAudioState);
 Q_DECLARE_METATYPE(GekkoFyre::Network::GkDataState);
 Q_DECLARE_METATYPE(GekkoFyre::Network::GkXmpp::GkXmppMsgTabRoster);
+Q_DECLARE_METATYPE(GekkoFyre::Network::GkXmpp::GkXmppMamBatch);
+Q_DECLARE_METATYPE(GekkoFyre::Network::GkXmpp::GkXmppMucOccupant);
 Q_DECLARE_METATYPE(boost::filesystem::path);
 Q_DECLARE_METATYPE(std::shared_ptr<aria2::DownloadHandle>);
 Q_DECLARE_METATYPE(SoapySDR::Kwargs);
 Q_DECLARE_METATYPE(GekkoFyre::System::GkSdr::GkSoapySdrTableView);
+Q_DECLARE_METATYPE(QList<GekkoFyre::System::GkSdr::GkSoapySdrTableView>);
+Q_DECLARE_METATYPE(GekkoFyre::System::GkSdr::GkSdrModulation);
+Q_DECLARE_METATYPE(GekkoFyre::AmateurRadio::GkFtxDecode);
+Q_DECLARE_METATYPE(QList<GekkoFyre::AmateurRadio::GkFtxDecode>);
 Q_DECLARE_METATYPE(RIG);
 Q_DECLARE_METATYPE(size_t);
 Q_DECLARE_METATYPE(uint8_t);
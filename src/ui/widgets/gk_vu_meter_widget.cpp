@@ -41,6 +41,7 @@
 
 #include "gk_vu_meter_widget.hpp"
 #include <cmath>
+#include <algorithm>
 #include <QPainter>
 #include <QTimer>
 #include <QDebug>
@@ -64,8 +65,8 @@ namespace sys = boost::system;
  * CPP <https://doc.qt.io/qt-5.9/qtmultimedia-multimedia-spectrum-app-levelmeter-cpp.html>
  */
 GkVuMeter::GkVuMeter(QWidget *parent) : QWidget(parent), m_rmsLevel(0.0), m_peakLevel(0.0), m_decayedPeakLevel(0.0),
-    m_peakDecayRate(AUDIO_VU_METER_PEAK_DECAY_RATE), m_peakHoldLevel(0.0), m_redrawTimer(new QTimer(this)), m_rmsColor(Qt::red),
-    m_peakColor(255, 200, 200, 255)
+    m_peakDecayRate(AUDIO_VU_METER_PEAK_DECAY_RATE), m_peakHoldLevel(0.0), m_redrawTimer(new QTimer(this)), m_lastSequence(0),
+    m_lastClipCount(0), m_rmsColor(Qt::red), m_peakColor(255, 200, 200, 255), m_clipColor(Qt::yellow)
 {
     setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Preferred);
     setMinimumWidth(30);
@@ -90,9 +91,10 @@ void GkVuMeter::paintEvent(QPaintEvent *event)
 
     QRect bar = rect();
 
+    const bool clipping = m_clipChanged.isValid() && m_clipChanged.elapsed() <= AUDIO_VU_METER_PEAK_HOLD_LEVEL_DURATION;
     bar.setTop(rect().top() + (1.0 - m_peakHoldLevel) * rect().height());
     bar.setBottom(bar.top() + 5);
-    painter.fillRect(bar, m_rmsColor);
+    painter.fillRect(bar, clipping ? m_clipColor : m_rmsColor);
     bar.setBottom(rect().bottom());
 
     bar.setTop(rect().top() + (1.0 - m_decayedPeakLevel) * rect().height());
@@ -102,6 +104,21 @@ void GkVuMeter::paintEvent(QPaintEvent *event)
     painter.fillRect(bar, m_rmsColor);
 }
 
+/**
+ * @brief GkVuMeter::setLevelSource sets the audio meter that the levels are to be pulled from, upon each redraw. This
+ * replaces the need for a signal to be sent towards GkVuMeter::levelChanged() for every block of captured audio.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param audioMeter The audio meter, as run upon the capture thread.
+ */
+void GkVuMeter::setLevelSource(std::shared_ptr<GkAudioMeter> audioMeter)
+{
+    m_levelSource = std::move(audioMeter);
+    m_lastSequence = 0;
+    m_lastClipCount = 0;
+
+    return;
+}
+
 void GkVuMeter::reset()
 {
     m_rmsLevel = 0.0;
@@ -134,6 +151,21 @@ void GkVuMeter::levelChanged(const qreal &rmsLevel, const qreal &peakLevel, cons
 
 void GkVuMeter::redrawTimerExpired()
 {
+    if (m_levelSource) {
+        //
+        // Pull only the very latest levels, whatever may have happened in between!
+        GkAudioFramework::GkAudioLevels levels;
+        if (m_levelSource->readLevels(levels) && levels.sequence != m_lastSequence) {
+            m_lastSequence = levels.sequence;
+            if (levels.clip_count > m_lastClipCount) {
+                m_lastClipCount = levels.clip_count;
+                m_clipChanged.start();
+            }
+
+            levelChanged(levels.rms, std::min(levels.true_peak, 1.0f), levels.num_samples);
+        }
+    }
+
     // Decay the peak signal
     const int elapsedMs = m_peakLevelChanged.elapsed();
     const qreal decayAmount = m_peakDecayRate * elapsedMs;
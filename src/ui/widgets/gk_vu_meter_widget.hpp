@@ -42,6 +42,8 @@
 #pragma once
 
 #include "src/defines.hpp"
+#include "src/gk_audio_meter.hpp"
+#include <memory>
 #include <QObject>
 #include <QWidget>
 #include <QElapsedTimer>
@@ -55,6 +57,7 @@ public:
     ~GkVuMeter() override;
 
     void paintEvent(QPaintEvent *event) override;
+    void setLevelSource(std::shared_ptr<GekkoFyre::GkAudioMeter> audioMeter);
 
 public slots:
     void reset();
@@ -93,8 +96,17 @@ private:
 
     QTimer *m_redrawTimer;
 
+    // Where the levels are pulled from upon each redraw, if set.
+    std::shared_ptr<GekkoFyre::GkAudioMeter> m_levelSource;
+    quint64 m_lastSequence;
+    quint64 m_lastClipCount;
+
+    // Time at which clipping was last detected.
+    QElapsedTimer m_clipChanged;
+
     QColor m_rmsColor;
     QColor m_peakColor;
+    QColor m_clipColor;
 
 };
 };
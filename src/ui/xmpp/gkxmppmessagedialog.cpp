@@ -77,7 +77,7 @@ using namespace GkXmpp;
  */
 GkXmppMessageDialog::GkXmppMessageDialog(QPointer<GekkoFyre::StringFuncs> stringFuncs, QPointer<GekkoFyre::GkEventLogger> eventLogger,
                                          QPointer<GekkoFyre::GkLevelDb> database, const GekkoFyre::Network::GkXmpp::GkUserConn &connection_details,
-                                         QPointer<GekkoFyre::GkXmppClient> xmppClient, std::shared_ptr<QList<GkXmppCallsign>> rosterList,
+                                         QPointer<GekkoFyre::GkXmppClient> xmppClient, QPointer<GekkoFyre::GkXmppRosterStore> rosterStore,
                                          QWidget *parent) : QDialog(parent), ui(new Ui::GkXmppMessageDialog)
 {
     ui->setupUi(this);
@@ -88,7 +88,7 @@ GkXmppMessageDialog::GkXmppMessageDialog(QPointer<GekkoFyre::StringFuncs> string
         gkDb = std::move(database);
         gkConnDetails = connection_details;
         m_xmppClient = std::move(xmppClient);
-        m_rosterList = std::move(rosterList);
+        m_rosterStore = std::move(rosterStore);
 
         //
         // Initialize spelling and grammar checker, dictionaries, etc.
@@ -105,7 +105,6 @@ GkXmppMessageDialog::GkXmppMessageDialog(QPointer<GekkoFyre::StringFuncs> string
 
         //
         // Setup and initialize signals and slots...
-        QObject::connect(this, SIGNAL(sendXmppMsg(const QXmppMessage &)), m_xmppClient, SLOT(sendXmppMsg(const QXmppMessage &)));
         QObject::connect(m_xmppClient, SIGNAL(updateMsgHistory()), this, SLOT(updateMsgHistory()));
         QObject::connect(m_xmppClient, SIGNAL(msgArchiveSuccReceived()), this, SLOT(msgArchiveSuccReceived()));
 
@@ -120,12 +119,6 @@ GkXmppMessageDialog::GkXmppMessageDialog(QPointer<GekkoFyre::StringFuncs> string
 
 GkXmppMessageDialog::~GkXmppMessageDialog()
 {
-    for (auto &archivedMsgsThread: m_archivedMsgsBulkThreadVec) {
-        if (archivedMsgsThread.joinable()) {
-            archivedMsgsThread.join();
-        }
-    }
-
     delete ui;
 }
 
@@ -139,7 +132,7 @@ void GkXmppMessageDialog::openMsgTab(const GekkoFyre::Network::GkXmpp::GkXmppMsg
 {
     //
     // QTabWidget initialization!
-    QPointer<GkXmppMsgTab> gkXmppMsgTab = new GkXmppMsgTab(gkSpellCheckerHighlighter, gkConnDetails, gkEventLogger, gkStringFuncs, this);
+    QPointer<GkXmppMsgTab> gkXmppMsgTab = new GkXmppMsgTab(gkSpellCheckerHighlighter, gkDb, gkConnDetails, gkEventLogger, gkStringFuncs, this);
 
     QObject::connect(this, SIGNAL(closeMsgTab(const QString &, const qint32 &)),
                      gkXmppMsgTab, SLOT(closeMsgDlg(const QString &, const qint32 &)));
@@ -149,8 +142,8 @@ void GkXmppMessageDialog::openMsgTab(const GekkoFyre::Network::GkXmpp::GkXmppMsg
                      gkXmppMsgTab, SLOT(recvXmppMsg(const QXmppMessage &)));
     QObject::connect(this, SIGNAL(procMsgArchive(const QString &)),
                      gkXmppMsgTab, SLOT(recvMsgArchive(const QString &)));
-    QObject::connect(m_xmppClient, SIGNAL(procXmppMsg(const QXmppMessage &, const bool &)),
-                     gkXmppMsgTab, SLOT(getArchivedMessagesFromDb(const QXmppMessage &, const bool &)));
+    QObject::connect(m_xmppClient, SIGNAL(procXmppMsgBatch(const QString &, const QList<GekkoFyre::Network::GkXmpp::GkRecvMsgsTableViewModel> &)),
+                     gkXmppMsgTab, SLOT(getArchivedMessagesFromDb(const QString &, const QList<GekkoFyre::Network::GkXmpp::GkRecvMsgsTableViewModel> &)));
     QObject::connect(this, SIGNAL(addMsgTab(const GekkoFyre::Network::GkXmpp::GkXmppMsgTabRoster &)),
                      gkXmppMsgTab, SLOT(openMsgDlg(const GekkoFyre::Network::GkXmpp::GkXmppMsgTabRoster &)));
 
@@ -179,7 +172,7 @@ void GkXmppMessageDialog::openMucTab(const GekkoFyre::Network::GkXmpp::GkXmppMsg
 {
     //
     // QTabWidget initialization!
-    QPointer<GkXmppMucTab> gkXmppMucTab = new GkXmppMucTab(gkSpellCheckerHighlighter, gkConnDetails, gkEventLogger, gkStringFuncs, this);
+    QPointer<GkXmppMucTab> gkXmppMucTab = new GkXmppMucTab(gkSpellCheckerHighlighter, m_xmppClient, gkConnDetails, gkEventLogger, gkStringFuncs, this);
 
     QObject::connect(this, SIGNAL(closeMucTab(const QString &, const qint32 &)),
                      gkXmppMucTab, SLOT(closeMucDlg(const QString &, const qint32 &)));
@@ -189,10 +182,13 @@ void GkXmppMessageDialog::openMucTab(const GekkoFyre::Network::GkXmpp::GkXmppMsg
                      gkXmppMucTab, SLOT(recvXmppMsg(const QXmppMessage &)));
     QObject::connect(this, SIGNAL(procMsgArchive(const QStringList &)),
                      gkXmppMucTab, SLOT(recvMsgArchive(const QStringList &)));
-    QObject::connect(m_xmppClient, SIGNAL(procXmppMsg(const QXmppMessage &, const bool &)),
-                     gkXmppMucTab, SLOT(getArchivedMessagesFromDb(const QXmppMessage &, const bool &)));
-    QObject::connect(this, SIGNAL(addMucTab(const GekkoFyre::Network::GkXmpp::GkXmppMsgTabRoster &)),
-                     gkXmppMucTab, SLOT(openMucDlg(const GekkoFyre::Network::GkXmpp::GkXmppMsgTabRoster &)));
+    QObject::connect(m_xmppClient, SIGNAL(procXmppMsgBatch(const QString &, const QList<GekkoFyre::Network::GkXmpp::GkRecvMsgsTableViewModel> &)),
+                     gkXmppMucTab, SLOT(getArchivedMessagesFromDb(const QString &, const QList<GekkoFyre::Network::GkXmpp::GkRecvMsgsTableViewModel> &)));
+
+    //
+    // The tab is bound towards its MUC straight away, as it was created in response to GkXmppMessageDialog::addMucTab()
+    // and therefore too late for it to be connected towards that very signal!
+    gkXmppMucTab->openMucDlg(mucRoster);
 
     //
     // NOTE: If you call insertTab() after show(), the layout system will try to adjust to the changes in its
@@ -290,21 +286,28 @@ void GkXmppMessageDialog::submitMsgEnterKey()
         }
     }
 
-    if (m_xmppClient->isConnected()) {
-        const auto plaintext = gkSpellCheckerHighlighter->toPlainText();
-        if (!plaintext.isEmpty()) {
-            for (const auto &bareJid: m_bareJids) {
-                if (!bareJid.isEmpty()) {
-                    const auto toMsg = createXmppMessageIq(bareJid, gkConnDetails.jid, plaintext);
-                    if (toMsg.isXmppStanza()) {
-                        emit sendXmppMsg(toMsg);
-                    }
+    //
+    // The message is spooled by the outbox whether connected or not, and sent once there is a connection
+    const auto plaintext = gkSpellCheckerHighlighter->toPlainText();
+    bool enqueued = true;
+    if (!plaintext.isEmpty()) {
+        for (const auto &bareJid: m_bareJids) {
+            if (!bareJid.isEmpty()) {
+                const auto toMsg = createXmppMessageIq(bareJid, gkConnDetails.jid, plaintext);
+                if (toMsg.isXmppStanza()) {
+                    enqueued &= m_xmppClient->sendXmppMsg(toMsg);
                 }
             }
         }
+    }
 
+    if (enqueued) {
+        //
+        // Otherwise the message is kept, so that it may be sent again once the outbox has room for it
         gkSpellCheckerHighlighter->clear();
-    } else {
+    }
+
+    if (!m_xmppClient->isConnected()) {
         m_netState = m_xmppClient->getNetworkState();
         if (m_netState == GkNetworkState::Connecting) {
             emit updateToolbar(tr("Attempting to make a connection... please wait..."));
@@ -348,7 +351,7 @@ QXmppMessage GkXmppMessageDialog::createXmppMessageIq(const QString &to, const Q
     xmppMsg.setBody(message);
     xmppMsg.setState(QXmppMessage::Active); // User is actively participating in the chat session...
     xmppMsg.setPrivate(false);
-    xmppMsg.setReceiptRequested(false);
+    xmppMsg.setReceiptRequested(true); // Lets GkXmppOutbox know when the message has been delivered (XEP-0184).
     xmppMsg.setType(QXmppMessage::Chat);
 
     return xmppMsg;
@@ -365,13 +368,14 @@ void GkXmppMessageDialog::msgArchiveSuccReceived()
 }
 
 /**
- * @brief GkXmppMessageDialog::getArchivedMessagesBulk
+ * @brief GkXmppMessageDialog::dlArchivedMessages synchronizes the message archives of each bareJid within this chat.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @see GkXmppClient::syncArchivedMessages().
  */
 void GkXmppMessageDialog::dlArchivedMessages()
 {
     for (const auto &bareJid: m_bareJids) {
-        m_archivedMsgsBulkThreadVec.emplace_back(&GkXmppClient::getArchivedMessagesBulk, m_xmppClient, bareJid);
+        m_xmppClient->syncArchivedMessages(bareJid);
     }
 
     return;
@@ -395,11 +399,11 @@ void GkXmppMessageDialog::on_tabWidget_chat_window_tabCloseRequested(qint32 inde
                 ui->tabWidget_chat_window->removeTab(index);
                 emit closeMucTab(m_xmppClient->getJidNickname(tab_idx.second.mucCtx.jid), index);
             } else {
-                if (!tab_idx.second.roster.isEmpty()) {
+                if (!tab_idx.second.bareJids.isEmpty()) {
                     //
                     // We are dealing with a one-on-one style of chat session.
                     ui->tabWidget_chat_window->removeTab(index);
-                    emit closeMsgTab(tab_idx.second.roster.last().bareJid, index);
+                    emit closeMsgTab(tab_idx.second.bareJids.last(), index);
                 } else {
                     gkEventLogger->publishEvent(tr("XMPP roster is unexpectedly empty! Must contain at least one element."),
                                                 GkSeverity::Error, "", false, true, false, true, false);
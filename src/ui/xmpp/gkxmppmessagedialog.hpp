@@ -75,7 +75,7 @@ public:
     explicit GkXmppMessageDialog(QPointer<GekkoFyre::StringFuncs> stringFuncs, QPointer<GekkoFyre::GkEventLogger> eventLogger,
                                  QPointer<GekkoFyre::GkLevelDb> database, const GekkoFyre::Network::GkXmpp::GkUserConn &connection_details,
                                  QPointer<GekkoFyre::GkXmppClient> xmppClient,
-                                 std::shared_ptr<QList<GekkoFyre::Network::GkXmpp::GkXmppCallsign>> rosterList,
+                                 QPointer<GekkoFyre::GkXmppRosterStore> rosterStore,
                                  QWidget *parent = nullptr);
     ~GkXmppMessageDialog();
 
@@ -107,7 +107,6 @@ signals:
 
     //
     // Message handling and QXmppArchiveManager-related
-    void sendXmppMsg(const QXmppMessage &msg);
     void procMsgArchive(const QString &bareJid);
     void procMsgArchive(const QStringList &bareJids);
 
@@ -132,7 +131,6 @@ private:
     //
     // Multithreading, mutexes, etc.
     std::mutex m_archivedMsgsFromDbMtx;
-    std::vector<std::thread> m_archivedMsgsBulkThreadVec;
 
     //
     // Miscellaneous
@@ -145,7 +143,7 @@ private:
     GekkoFyre::Network::GkXmpp::GkUserConn gkConnDetails;
     QPointer<GekkoFyre::GkXmppClient> m_xmppClient;
     GekkoFyre::Network::GkXmpp::GkNetworkState m_netState;
-    std::shared_ptr<QList<GekkoFyre::Network::GkXmpp::GkXmppCallsign>> m_rosterList;
+    QPointer<GekkoFyre::GkXmppRosterStore> m_rosterStore;
     QStringList m_bareJids;
     QString m_clientNickname;
 
@@ -50,6 +50,7 @@
 #include <QMenu>
 #include <QBuffer>
 #include <QRegExp>
+#include <QScrollBar>
 #include <QFileInfo>
 #include <QMessageBox>
 #include <QStringList>
@@ -77,7 +78,7 @@ using namespace GkXmpp;
 GkXmppRosterDialog::GkXmppRosterDialog(QPointer<GekkoFyre::StringFuncs> stringFuncs, const GkUserConn &connection_details,
                                        QPointer<GekkoFyre::GkXmppClient> xmppClient, QPointer<GekkoFyre::GkLevelDb> database,
                                        QPointer<GekkoFyre::GkSystem> system, QPointer<GkEventLogger> eventLogger,
-                                       std::shared_ptr<QList<GkXmppCallsign>> rosterList, const bool &skipConnectionCheck,
+                                       QPointer<GekkoFyre::GkXmppRosterStore> rosterStore, const bool &skipConnectionCheck,
                                        QWidget *parent) : shownXmppPreviewNotice(false), QDialog(parent),
                                        ui(new Ui::GkXmppRosterDialog)
 {
@@ -90,12 +91,13 @@ GkXmppRosterDialog::GkXmppRosterDialog(QPointer<GekkoFyre::StringFuncs> stringFu
         gkDb = std::move(database);
         gkSystem = std::move(system);
         gkEventLogger = std::move(eventLogger);
-        m_rosterList = std::move(rosterList);
+        m_rosterStore = std::move(rosterStore);
 
         m_progressBar = new QProgressBar(nullptr);
         m_initAppLaunch = true;
         m_presenceManuallySet = false;
         m_rosterSearchEnabled = true;
+        m_rosterSearchActive = false;
         m_connectingInit = false;
 
         ui->comboBox_current_status->setCurrentIndex(GK_XMPP_AVAIL_COMBO_UNAVAILABLE_IDX);
@@ -128,7 +130,7 @@ GkXmppRosterDialog::GkXmppRosterDialog(QPointer<GekkoFyre::StringFuncs> stringFu
         //
         // Message dialog signals/slots and actions!
         gkXmppMsgDlg = new GkXmppMessageDialog(gkStringFuncs, gkEventLogger, gkDb, gkConnDetails, m_xmppClient,
-                                               m_rosterList, this);
+                                               m_rosterStore, this);
         QObject::connect(this, SIGNAL(launchMsgDlg(const GekkoFyre::Network::GkXmpp::GkXmppMsgTabRoster &)),
                          gkXmppMsgDlg, SIGNAL(addMsgTab(const GekkoFyre::Network::GkXmpp::GkXmppMsgTabRoster &)));
         QObject::connect(this, SIGNAL(launchMucDlg(const GekkoFyre::Network::GkXmpp::GkXmppMsgTabRoster &)),
@@ -233,12 +235,24 @@ GkXmppRosterDialog::GkXmppRosterDialog(QPointer<GekkoFyre::StringFuncs> stringFu
         //
         // Users and presence
         ui->tableView_callsigns_groups->setModel(gkXmppPresenceTableViewModel);
+        QObject::connect(gkXmppPresenceTableViewModel, SIGNAL(rowsInserted(const QModelIndex &, int, int)), this, SLOT(applyRosterSearch()));
+        QObject::connect(gkXmppPresenceTableViewModel, SIGNAL(rowsRemoved(const QModelIndex &, int, int)), this, SLOT(applyRosterSearch()));
+        QObject::connect(gkXmppPresenceTableViewModel, SIGNAL(rowsInserted(const QModelIndex &, int, int)), this, SLOT(prioritizeVisibleVCards()));
+        QObject::connect(ui->tableView_callsigns_groups->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(prioritizeVisibleVCards()));
         ui->tableView_callsigns_groups->horizontalHeader()->setSectionResizeMode(GK_XMPP_ROSTER_PRESENCE_TABLEVIEW_MODEL_PRESENCE_IDX, QHeaderView::ResizeToContents);
         ui->tableView_callsigns_groups->horizontalHeader()->setSectionResizeMode(GK_XMPP_ROSTER_PRESENCE_TABLEVIEW_MODEL_BAREJID_IDX, QHeaderView::ResizeToContents);
         ui->tableView_callsigns_groups->horizontalHeader()->setStretchLastSection(true);
         ui->tableView_callsigns_groups->setVisible(true);
         ui->tableView_callsigns_groups->show();
 
+        //
+        // Search the roster as-you-type, once there has been a pause in typing
+        m_rosterSearchTimer = new QTimer(this);
+        m_rosterSearchTimer->setSingleShot(true);
+        m_rosterSearchTimer->setInterval(GK_XMPP_SEARCH_DEBOUNCE_MS);
+        QObject::connect(m_rosterSearchTimer, SIGNAL(timeout()), this, SLOT(searchRosterTyped()));
+        QObject::connect(ui->lineEdit_search_roster, SIGNAL(textChanged(const QString &)), m_rosterSearchTimer, SLOT(start()));
+
         //
         // Contact requests
         ui->tableView_callsigns_pending->setModel(gkXmppPendingTableViewModel);
@@ -350,18 +364,16 @@ void GkXmppRosterDialog::subscriptionRequestRecv(const QString &bareJid)
  */
 void GkXmppRosterDialog::subscriptionRequestRecv(const QString &bareJid, const QString &reason)
 {
-    if (!bareJid.isEmpty() && !m_rosterList->isEmpty()) {
-        for (const auto &entry: *m_rosterList) {
-            if (entry.bareJid == bareJid) {
-                if (!reason.isEmpty()) {
-                    insertRosterPendingTable(m_xmppClient->presenceToIcon(entry.presence->availableStatusType()), bareJid, entry.vCard.nickName());
-                }
-
-                gkEventLogger->publishEvent(tr("A user of %1 with the nickname/callsign, \"%2\", is requesting to share presence details with you!")
-                                            .arg(General::productName).arg(bareJid), GkSeverity::Info, "",
-                                            true, true, false, false);
-                break;
+    if (!bareJid.isEmpty() && !m_rosterStore->isEmpty()) {
+        const auto entry = m_rosterStore->get(bareJid);
+        if (entry) {
+            if (!reason.isEmpty()) {
+                insertRosterPendingTable(m_xmppClient->presenceToIcon(entry->presence->availableStatusType()), bareJid, entry->vCard.nickName());
             }
+
+            gkEventLogger->publishEvent(tr("A user of %1 with the nickname/callsign, \"%2\", is requesting to share presence details with you!")
+                                        .arg(General::productName).arg(bareJid), GkSeverity::Info, "",
+                                        true, true, false, false);
         }
 
         updateActions();
@@ -394,16 +406,11 @@ void GkXmppRosterDialog::subscriptionRequestRetracted(const QString &bareJid)
  */
 void GkXmppRosterDialog::addJidToRoster(const QString &bareJid)
 {
-    if (!bareJid.isEmpty() && !m_rosterList->isEmpty()) {
-        for (const auto &entry: *m_rosterList) {
-            if (entry.bareJid == bareJid) {
-                if (m_xmppClient->isJidOnline(bareJid)) {
-                    insertRosterPresenceTable(m_xmppClient->presenceToIcon(entry.presence->availableStatusType()),
-                                              bareJid, entry.vCard.nickName());
-                }
-
-                break;
-            }
+    if (!bareJid.isEmpty()) {
+        const auto entry = m_rosterStore->get(bareJid);
+        if (entry && m_xmppClient->isJidOnline(bareJid)) {
+            insertRosterPresenceTable(m_xmppClient->presenceToIcon(entry->presence->availableStatusType()),
+                                      bareJid, entry->vCard.nickName());
         }
     }
 
@@ -418,13 +425,8 @@ void GkXmppRosterDialog::addJidToRoster(const QString &bareJid)
  */
 void GkXmppRosterDialog::delJidFromRoster(const QString &bareJid)
 {
-    if (!bareJid.isEmpty() && !m_rosterList->isEmpty()) {
-        for (const auto &entry: *m_rosterList) {
-            if (entry.bareJid == bareJid) {
-                removeRosterPresenceTable(bareJid);
-                break;
-            }
-        }
+    if (!bareJid.isEmpty() && m_rosterStore->contains(bareJid)) {
+        removeRosterPresenceTable(bareJid);
     }
 
     return;
@@ -479,12 +481,19 @@ void GkXmppRosterDialog::insertRosterPresenceTable(const QIcon &presence, const
                                                    const qint32 row)
 {
     if (!bareJid.isEmpty() || !nickname.isEmpty()) {
+        if (m_presenceRosterIndex.contains(bareJid)) {
+            updateRosterPresenceTable(presence, bareJid, nickname);
+            return;
+        }
+
         GkPresenceTableViewModel presence_model;
         presence_model.presence = presence;
         presence_model.bareJid = bareJid;
         presence_model.nickName = nickname;
         presence_model.added = false;
+        m_presenceRosterIndex.insert(bareJid, m_presenceRosterData.size());
         m_presenceRosterData.push_back(presence_model);
+        m_presenceRosterUnadded.push_back(bareJid);
         emit updatePresenceTableViewModel();
     }
 
@@ -500,21 +509,25 @@ void GkXmppRosterDialog::insertRosterPresenceTable(const QIcon &presence, const
 qint32 GkXmppRosterDialog::removeRosterPresenceTable(const QString &bareJid)
 {
     if (!bareJid.isEmpty()) {
-        qint32 ret = 0;
-        for (const auto &entry: m_presenceRosterData) {
-            if (entry.bareJid == bareJid) {
-                ret = gkXmppPresenceTableViewModel->removeData(bareJid);
-                break;
-            }
+        const auto index = m_presenceRosterIndex.constFind(bareJid);
+        if (index == m_presenceRosterIndex.constEnd()) {
+            return 0;
         }
 
-        for (auto iter = m_presenceRosterData.begin(); iter != m_presenceRosterData.end(); ++iter) {
-            if (iter->bareJid == bareJid) {
-                iter = m_presenceRosterData.erase(iter);
-                break;
-            }
+        const qint32 ret = gkXmppPresenceTableViewModel->removeData(bareJid);
+
+        //
+        // The order within `m_presenceRosterData` is of no importance (as the model keeps its own), so the last entry
+        // merely takes the place of the one being removed
+        const qint32 idx = index.value();
+        const qint32 last = m_presenceRosterData.size() - 1;
+        m_presenceRosterIndex.erase(index);
+        if (idx != last) {
+            m_presenceRosterData[idx] = m_presenceRosterData[last];
+            m_presenceRosterIndex.insert(m_presenceRosterData[idx].bareJid, idx);
         }
 
+        m_presenceRosterData.removeLast();
         return ret;
     }
 
@@ -531,8 +544,21 @@ qint32 GkXmppRosterDialog::removeRosterPresenceTable(const QString &bareJid)
 void GkXmppRosterDialog::updateRosterPresenceTable(const QIcon &presence, const QString &bareJid, const QString &nickname)
 {
     if (!bareJid.isEmpty()) {
-        qint32 ret = removeRosterPresenceTable(bareJid);
-        insertRosterPresenceTable(presence, bareJid, nickname, ret);
+        //
+        // Update the row in place, so that the QTableView only repaints what has actually changed
+        const auto index = m_presenceRosterIndex.constFind(bareJid);
+        if (index != m_presenceRosterIndex.constEnd()) {
+            auto &entry = m_presenceRosterData[index.value()];
+            entry.presence = presence;
+            entry.nickName = nickname;
+            if (entry.added) {
+                gkXmppPresenceTableViewModel->updateData(entry);
+            }
+
+            return;
+        }
+
+        insertRosterPresenceTable(presence, bareJid, nickname);
     }
 
     return;
@@ -628,13 +654,33 @@ qint32 GkXmppRosterDialog::removeRosterPendingTable(const QString &bareJid)
 void GkXmppRosterDialog::updateRosterPendingTable(const QIcon &online_status, const QString &bareJid, const QString &nickname, const QString &reason)
 {
     if (!bareJid.isEmpty()) {
-        qint32 ret = removeRosterPendingTable(bareJid);
+        //
+        // Update the row in place, so that the QTableView only repaints what has actually changed
+        for (auto iter = m_pendingRosterData.begin(); iter != m_pendingRosterData.end(); ++iter) {
+            if (iter->bareJid == bareJid) {
+                if (!online_status.isNull()) {
+                    iter->presence = online_status;
+                }
+
+                iter->nickName = nickname;
+                if (!reason.isEmpty()) {
+                    iter->reason = reason;
+                }
+
+                if (iter->added) {
+                    gkXmppPendingTableViewModel->updateData(*iter);
+                }
+
+                return;
+            }
+        }
+
         if (!reason.isEmpty()) {
-            insertRosterPendingTable(online_status, bareJid, nickname, reason, ret);
+            insertRosterPendingTable(online_status, bareJid, nickname, reason);
             return;
         }
 
-        insertRosterPendingTable(online_status, bareJid, nickname, ret);
+        insertRosterPendingTable(online_status, bareJid, nickname);
     }
 
     return;
@@ -1129,38 +1175,34 @@ void GkXmppRosterDialog::updateUserVCard(const QXmppVCardIq &vCard)
     presence_model.bareJid = vCard.from();
     presence_model.added = false;
 
-    if (!m_rosterList->isEmpty()) {
-        for (const auto &entry: *m_rosterList) {
-            if (!entry.bareJid.isEmpty()) {
-                if (entry.bareJid == presence_model.bareJid) {
-                    presence_model.presence = m_xmppClient->presenceToIcon(entry.presence->availableStatusType());
-                    if (!vCard.nickName().isEmpty()) {
-                        presence_model.nickName = vCard.nickName();
-                    }
+    const auto entry = m_rosterStore->get(presence_model.bareJid);
+    if (entry && !entry->bareJid.isEmpty()) {
+        if (entry->presence) {
+            presence_model.presence = m_xmppClient->presenceToIcon(entry->presence->availableStatusType());
+        }
 
-                    if (!vCard.fullName().isEmpty() && presence_model.nickName.isEmpty()) {
-                        presence_model.nickName = vCard.fullName();
-                    }
+        if (!vCard.nickName().isEmpty()) {
+            presence_model.nickName = vCard.nickName();
+        }
 
-                    if (!vCard.email().isEmpty() && presence_model.nickName.isEmpty()) {
-                        presence_model.nickName = vCard.email();
-                    }
-                }
+        if (!vCard.fullName().isEmpty() && presence_model.nickName.isEmpty()) {
+            presence_model.nickName = vCard.fullName();
+        }
 
-                if (!presence_model.nickName.isEmpty()) {
-                    for (auto iter = m_presenceRosterData.begin(); iter != m_presenceRosterData.end(); ++iter) {
-                        if (entry.bareJid == iter->bareJid) {
-                            iter->nickName = presence_model.nickName;
-                            updateRosterPresenceTable(m_xmppClient->presenceToIcon(m_xmppClient->getBareJidPresence(iter->bareJid).availableStatusType()), iter->bareJid, iter->nickName);
-                        }
-                    }
+        if (!vCard.email().isEmpty() && presence_model.nickName.isEmpty()) {
+            presence_model.nickName = vCard.email();
+        }
 
-                    for (auto iter = m_pendingRosterData.begin(); iter != m_pendingRosterData.end(); ++iter) {
-                        if (entry.bareJid == iter->bareJid) {
-                            iter->nickName = presence_model.nickName;
-                            updateRosterPendingTable(m_xmppClient->presenceToIcon(m_xmppClient->getBareJidPresence(iter->bareJid).availableStatusType()), iter->bareJid, iter->nickName);
-                        }
-                    }
+        if (!presence_model.nickName.isEmpty()) {
+            if (m_presenceRosterIndex.contains(entry->bareJid)) {
+                updateRosterPresenceTable(m_xmppClient->presenceToIcon(m_xmppClient->getBareJidPresence(entry->bareJid).availableStatusType()), entry->bareJid,
+                                          presence_model.nickName);
+            }
+
+            for (auto iter = m_pendingRosterData.begin(); iter != m_pendingRosterData.end(); ++iter) {
+                if (entry->bareJid == iter->bareJid) {
+                    iter->nickName = presence_model.nickName;
+                    updateRosterPendingTable(m_xmppClient->presenceToIcon(m_xmppClient->getBareJidPresence(iter->bareJid).availableStatusType()), iter->bareJid, iter->nickName);
                 }
             }
         }
@@ -1423,12 +1465,106 @@ void GkXmppRosterDialog::on_lineEdit_search_roster_returnPressed()
     } else {
         //
         // Roster-search mode...
+        if (m_rosterSearchTimer) {
+            m_rosterSearchTimer->stop();
+        }
+
+        searchRoster(ui->lineEdit_search_roster->text());
         return;
     }
 
     return;
 }
 
+/**
+ * @brief GkXmppRosterDialog::searchRoster narrows the roster down towards those users whose username, server and/or
+ * nickname begin with each of the words given, by way of the search index, or shows the whole roster again should there
+ * be no words given.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param query The words to search the roster with.
+ * @see GkXmppClient::indexRosterEntry().
+ */
+void GkXmppRosterDialog::searchRoster(const QString &query)
+{
+    try {
+        m_rosterSearchHits.clear();
+        m_rosterSearchActive = !query.trimmed().isEmpty();
+        if (m_rosterSearchActive) {
+            const auto hits = gkDb->getSearchIndex()->search(General::Xmpp::GoogleLevelDb::searchCollectionRoster, query,
+                                                             m_rosterStore->size());
+            for (const auto &hit: hits) {
+                m_rosterSearchHits.insert(hit.docId);
+            }
+        }
+
+        applyRosterSearch();
+    } catch (const std::exception &e) {
+        gkEventLogger->publishEvent(QString::fromStdString(e.what()), GkSeverity::Warning, "", false, true, false, true, false);
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppRosterDialog::searchRosterTyped searches the roster with whatever has been typed so far, but only when
+ * in roster-search mode rather than nickname edit.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppRosterDialog::searchRosterTyped()
+{
+    if (m_rosterSearchEnabled) {
+        searchRoster(ui->lineEdit_search_roster->text());
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppRosterDialog::applyRosterSearch hides those rows of the roster that do not match the current search,
+ * including any that are inserted afterwards.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppRosterDialog::applyRosterSearch()
+{
+    for (qint32 row = 0; row < gkXmppPresenceTableViewModel->rowCount(); ++row) {
+        const QModelIndex index = gkXmppPresenceTableViewModel->index(row, GK_XMPP_ROSTER_PRESENCE_TABLEVIEW_MODEL_BAREJID_IDX, QModelIndex());
+        const QString bareJid = m_xmppClient->addHostname(gkXmppPresenceTableViewModel->data(index).toString());
+        ui->tableView_callsigns_groups->setRowHidden(row, m_rosterSearchActive && !m_rosterSearchHits.contains(bareJid));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppRosterDialog::prioritizeVisibleVCards has the vCards of those bareJids currently scrolled into view within
+ * the roster requested before any others that are still waiting.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppRosterDialog::prioritizeVisibleVCards()
+{
+    const auto vCardScheduler = m_xmppClient->getVCardScheduler();
+    if (!vCardScheduler || vCardScheduler->waitingRequests() == 0) {
+        return;
+    }
+
+    const qint32 firstRow = ui->tableView_callsigns_groups->rowAt(0);
+    qint32 lastRow = ui->tableView_callsigns_groups->rowAt(ui->tableView_callsigns_groups->viewport()->height() - 1);
+    if (firstRow < 0) {
+        return;
+    }
+
+    if (lastRow < 0) {
+        lastRow = gkXmppPresenceTableViewModel->rowCount() - 1;
+    }
+
+    for (qint32 row = firstRow; row <= lastRow; ++row) {
+        const QModelIndex index = gkXmppPresenceTableViewModel->index(row, GK_XMPP_ROSTER_PRESENCE_TABLEVIEW_MODEL_BAREJID_IDX, QModelIndex());
+        vCardScheduler->prioritize(m_xmppClient->addHostname(gkXmppPresenceTableViewModel->data(index).toString()));
+    }
+
+    return;
+}
+
 /**
  * @brief GkXmppRosterDialog::on_lineEdit_search_roster_inputRejected
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
@@ -1551,9 +1687,7 @@ void GkXmppRosterDialog::on_tableView_callsigns_groups_doubleClicked(const QMode
         enablePresenceTableActions(true);
         QString bareJid = m_xmppClient->addHostname(username);
         if (m_xmppClient->isJidExist(bareJid)) {
-            GkXmppCallsign callsign;
-            callsign.bareJid = bareJid;
-            tab_roster.roster.push_back(callsign);
+            tab_roster.bareJids.push_back(bareJid);
             emit launchMsgDlg(tab_roster);
 
             gkXmppMsgDlg->setWindowFlags(Qt::Window);
@@ -1613,9 +1747,7 @@ void GkXmppRosterDialog::on_tableView_callsigns_blocked_doubleClicked(const QMod
         enableBlockedTableActions(true);
         QString bareJid = m_xmppClient->addHostname(username);
         if (m_xmppClient->isJidExist(bareJid)) {
-            GkXmppCallsign callsign;
-            callsign.bareJid = bareJid;
-            tab_roster.roster.push_back(callsign);
+            tab_roster.bareJids.push_back(bareJid);
             emit launchMsgDlg(tab_roster);
 
             gkXmppMsgDlg->setWindowFlags(Qt::Window);
@@ -1656,8 +1788,9 @@ void GkXmppRosterDialog::procAvailableStatusType(const QXmppPresence::AvailableS
 void GkXmppRosterDialog::cleanupTables()
 {
     if (!m_presenceRosterData.isEmpty()) {
-        for (const auto &entry: m_presenceRosterData) {
-            removeRosterPresenceTable(entry.bareJid);
+        const auto bareJids = m_presenceRosterIndex.keys();
+        for (const auto &bareJid: bareJids) {
+            removeRosterPresenceTable(bareJid);
         }
     }
 
@@ -1674,6 +1807,8 @@ void GkXmppRosterDialog::cleanupTables()
     }
 
     m_presenceRosterData.clear();
+    m_presenceRosterIndex.clear();
+    m_presenceRosterUnadded.clear();
     m_pendingRosterData.clear();
     m_blockedRosterData.clear();
 
@@ -1721,13 +1856,20 @@ bool GkXmppRosterDialog::eventFilter(QObject *obj, QEvent *event)
  */
 void GkXmppRosterDialog::recvUpdatePresenceTableViewModel()
 {
-    for (auto iter = m_presenceRosterData.begin(); iter != m_presenceRosterData.end(); ++iter) {
-        if (!iter->added) {
-            gkXmppPresenceTableViewModel->insertData(*iter);
-            iter->added = true;
+    //
+    // Only those entries that have been inserted since the last time are looked at, rather than the whole roster
+    for (const auto &bareJid: m_presenceRosterUnadded) {
+        const auto index = m_presenceRosterIndex.constFind(bareJid);
+        if (index != m_presenceRosterIndex.constEnd()) {
+            auto &entry = m_presenceRosterData[index.value()];
+            if (!entry.added) {
+                gkXmppPresenceTableViewModel->insertData(entry);
+                entry.added = true;
+            }
         }
     }
 
+    m_presenceRosterUnadded.clear();
     return;
 }
 
@@ -55,7 +55,9 @@
 #include <QList>
 #include <QImage>
 #include <QTimer>
+#include <QHash>
 #include <QVector>
+#include <QSet>
 #include <QAction>
 #include <QString>
 #include <QObject>
@@ -78,7 +80,7 @@ public:
     explicit GkXmppRosterDialog(QPointer<GekkoFyre::StringFuncs> stringFuncs, const GekkoFyre::Network::GkXmpp::GkUserConn &connection_details,
                                 QPointer<GekkoFyre::GkXmppClient> xmppClient, QPointer<GekkoFyre::GkLevelDb> database,
                                 QPointer<GekkoFyre::GkSystem> system, QPointer<GekkoFyre::GkEventLogger> eventLogger,
-                                std::shared_ptr<QList<GekkoFyre::Network::GkXmpp::GkXmppCallsign>> rosterList,
+                                QPointer<GekkoFyre::GkXmppRosterStore> rosterStore,
                                 const bool &skipConnectionCheck = false, QWidget *parent = nullptr);
     ~GkXmppRosterDialog();
 
@@ -145,6 +147,10 @@ private slots:
     void enablePendingTableActions(const bool &enable);
     void enableBlockedTableActions(const bool &enable);
 
+    void applyRosterSearch();
+    void searchRosterTyped();
+    void prioritizeVisibleVCards();
+
 public slots:
     //
     // VCard management
@@ -186,6 +192,8 @@ private:
     QPointer<GekkoFyre::GkXmppRosterPendingTableViewModel> gkXmppPendingTableViewModel;
     QPointer<GekkoFyre::GkXmppRosterBlockedTableViewModel> gkXmppBlockedTableViewModel;
     QVector<GekkoFyre::Network::GkXmpp::GkPresenceTableViewModel> m_presenceRosterData;
+    QHash<QString, qint32> m_presenceRosterIndex;       // Where each bareJid lies within `m_presenceRosterData`.
+    QVector<QString> m_presenceRosterUnadded;           // Those bareJids yet to be handed towards the QTableView's model.
     QVector<GekkoFyre::Network::GkXmpp::GkPendingTableViewModel> m_pendingRosterData;
     QVector<GekkoFyre::Network::GkXmpp::GkBlockedTableViewModel> m_blockedRosterData;
     QString m_bareJidPresenceSel;   // Currently selected item for already subscribed users
@@ -208,7 +216,7 @@ private:
     // QXmpp and XMPP related
     //
     GekkoFyre::Network::GkXmpp::GkUserConn gkConnDetails;
-    std::shared_ptr<QList<GekkoFyre::Network::GkXmpp::GkXmppCallsign>> m_rosterList;
+    QPointer<GekkoFyre::GkXmppRosterStore> m_rosterStore;
 
     //
     // Miscellaneous
@@ -224,6 +232,15 @@ private:
     bool m_presenceManuallySet;     // Has the presence status been manually chosen by the user?
     bool m_rosterSearchEnabled;     // Are we in roster-search mode or nickname edit?
 
+    //
+    // Roster searching
+    //
+    QSet<QString> m_rosterSearchHits;   // The bareJids matching the current search, if any.
+    bool m_rosterSearchActive;          // Whether the roster is being narrowed down towards `m_rosterSearchHits`.
+    QPointer<QTimer> m_rosterSearchTimer;   // Debounces the search as-you-type.
+
+    void searchRoster(const QString &query);
+
     //
     // VCard management
     //
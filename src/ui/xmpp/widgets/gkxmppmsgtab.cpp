@@ -62,6 +62,7 @@ using namespace Network;
 using namespace GkXmpp;
 
 GkXmppMsgTab::GkXmppMsgTab(QPointer<GekkoFyre::GkTextEditSpellHighlight> spellCheckWidget,
+                           QPointer<GekkoFyre::GkLevelDb> database,
                            GekkoFyre::Network::GkXmpp::GkUserConn connDetails,
                            QPointer<GekkoFyre::GkEventLogger> eventLogger,
                            QPointer<GekkoFyre::StringFuncs> stringFuncs, QWidget *parent) :
@@ -69,6 +70,7 @@ GkXmppMsgTab::GkXmppMsgTab(QPointer<GekkoFyre::GkTextEditSpellHighlight> spellCh
 {
     ui->setupUi(this);
 
+    gkDb = std::move(database);
     gkStringFuncs = std::move(stringFuncs);
     gkEventLogger = std::move(eventLogger);
 
@@ -95,6 +97,14 @@ GkXmppMsgTab::GkXmppMsgTab(QPointer<GekkoFyre::GkTextEditSpellHighlight> spellCh
     ui->tableView_recv_msg_dlg->show();
     ui->tableView_recv_msg_dlg->scrollToBottom();
 
+    //
+    // Search the chat transcript as-you-type, once there has been a pause in typing
+    m_searchTimer = new QTimer(this);
+    m_searchTimer->setSingleShot(true);
+    m_searchTimer->setInterval(GK_XMPP_SEARCH_DEBOUNCE_MS);
+    QObject::connect(m_searchTimer, SIGNAL(timeout()), this, SLOT(searchMessages()));
+    QObject::connect(ui->plainTextEdit_message_search, SIGNAL(textChanged()), m_searchTimer, SLOT(start()));
+
     ui->label_callsign_1_stats->setText(QString("1 %1").arg(tr("user in chat")));
     ui->label_msging_callsign_status->setText("");
 
@@ -177,17 +187,20 @@ void GkXmppMsgTab::recvXmppMsg(const QXmppMessage &msg)
  */
 void GkXmppMsgTab::recvMsgArchive(const QString &bareJid)
 {
-    // TODO: Refactor this code!
-    if (!gkTabRoster.roster.isEmpty()) {
-        gkXmppRecvMsgsTableViewModel.clear();
-        for (const auto &roster: gkTabRoster.roster) {
-            if (roster.bareJid == bareJid) {
-                if (!roster.archive_messages.isEmpty()) {
-                    for (const auto &message: roster.archive_messages) {
-                        gkXmppRecvMsgsTableViewModel->insertData(bareJid, message.message.body(), message.message.date());
-                    }
-                }
+    if (gkTabRoster.bareJids.contains(bareJid)) {
+        gkXmppRecvMsgsTableViewModel->removeData();
+        const auto entry = m_xmppClient->getRosterStore()->get(bareJid);
+        if (entry) {
+            QList<GkRecvMsgsTableViewModel> messages;
+            for (const auto &message: entry->archive_messages) {
+                GkRecvMsgsTableViewModel recvMsg;
+                recvMsg.timestamp = message.message.date();
+                recvMsg.bareJid = bareJid;
+                recvMsg.message = message.message.body();
+                messages.push_back(recvMsg);
             }
+
+            gkXmppRecvMsgsTableViewModel->insertData(messages);
         }
     }
 
@@ -195,31 +208,53 @@ void GkXmppMsgTab::recvMsgArchive(const QString &bareJid)
 }
 
 /**
- * @brief GkXmppMsgTab::getArchivedMessagesFromDb attempts to get previously archived messages from the Google
- * LevelDB database that is associated with this user's instance of Small World Deluxe, and insert them into the chat
- * window, thereby saving bandwidth from not having to unnecessarily re-download messages from the given XMPP server
- * again.
- * NOTE: The Google LevelDB functionality is currently disabled!
+ * @brief GkXmppMsgTab::getArchivedMessagesFromDb inserts a page of archived messages into the chat window, with a single
+ * insertion into the QTableView model, GekkoFyre::GkXmppRecvMsgsTableViewModel(), rather than one for each message.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param message The QXmppMessage stanza itself to be inserted into the QTableView model, GekkoFyre::GkXmppRecvMsgsTableViewModel().
- * @param wipeExistingHistory Whether to wipe the pre-existing chat history or not, specifically from the given QTableView
- * object, GekkoFyre::GkXmppRecvMsgsTableViewModel().
+ * @param chatJid The chat that the messages belong towards, which are only inserted should it be this very chat.
+ * @param messages The messages themselves, as already written towards the chat transcript by GkXmppStanzaWorker.
  */
-void GkXmppMsgTab::getArchivedMessagesFromDb(const QXmppMessage &message, const bool &wipeExistingHistory)
+void GkXmppMsgTab::getArchivedMessagesFromDb(const QString &chatJid, const QList<GekkoFyre::Network::GkXmpp::GkRecvMsgsTableViewModel> &messages)
 {
     try {
+        if (messages.isEmpty() || !gkTabRoster.bareJids.contains(chatJid)) {
+            return;
+        }
+
         std::lock_guard<std::mutex> lock_guard(m_archivedMsgsFromDbMtx);
-        if (wipeExistingHistory) {
-            gkXmppRecvMsgsTableViewModel->removeData();
+        gkXmppRecvMsgsTableViewModel->insertData(messages, true);
+        ui->tableView_recv_msg_dlg->scrollToBottom();
+    } catch (const std::exception &e) {
+        std::throw_with_nested(std::runtime_error(e.what()));
+    }
+
+    return;
+}
+
+/**
+ * @brief GkXmppMsgTab::searchMessages shows the most recent messages of this chat that match what has been typed into
+ * the search box, or returns towards the newest messages once the search box has been emptied.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @see GkLevelDb::search_xmpp_transcript().
+ */
+void GkXmppMsgTab::searchMessages()
+{
+    try {
+        if (gkTabRoster.isMuc || gkTabRoster.bareJids.count() != 1) {
+            return;
         }
 
-        if (message.isXmppStanza() && !message.body().isEmpty()) {
-            gkXmppRecvMsgsTableViewModel->insertData(message.from(), message.body(), message.stamp());
+        const QString chatJid = gkTabRoster.bareJids.first();
+        const QString query = ui->plainTextEdit_message_search->toPlainText().trimmed();
+        if (query.isEmpty()) {
+            gkXmppRecvMsgsTableViewModel->setTranscript(gkDb, chatJid);
+            return;
         }
 
+        gkXmppRecvMsgsTableViewModel->showSearchResults(gkDb->search_xmpp_transcript(chatJid, query));
         ui->tableView_recv_msg_dlg->scrollToBottom();
     } catch (const std::exception &e) {
-        std::throw_with_nested(std::runtime_error(e.what()));
+        gkEventLogger->publishEvent(QString::fromStdString(e.what()), GkSeverity::Warning, "", false, true, false, true, false);
     }
 
     return;
@@ -234,6 +269,12 @@ void GkXmppMsgTab::getArchivedMessagesFromDb(const QXmppMessage &message, const
 void GkXmppMsgTab::openMsgDlg(const GekkoFyre::Network::GkXmpp::GkXmppMsgTabRoster &msgRoster)
 {
     gkTabRoster = msgRoster;
+    if (!msgRoster.isMuc && msgRoster.bareJids.count() == 1) {
+        //
+        // Only the newest of the messages are read in from the chat transcript to begin with, no matter how long the
+        // chat, with the remainder read in as they are scrolled towards
+        gkXmppRecvMsgsTableViewModel->setTranscript(gkDb, msgRoster.bareJids.first());
+    }
 
     return;
 }
@@ -338,18 +379,17 @@ void GkXmppMsgTab::updateInterface(const QStringList &bareJids)
 {
     ui->label_callsign_1_stats->setText(tr("%1 users in chat").arg(QString::number(bareJids.count() + 1))); // Includes both the user in communique and the client themselves!
     for (const auto &bareJid: bareJids) {
-        for (const auto &rosterJid: gkTabRoster.roster) {
-            if (bareJid == rosterJid.bareJid) {
+        if (gkTabRoster.bareJids.contains(bareJid)) {
+            const auto rosterJid = m_xmppClient->getRosterStore()->get(bareJid);
+            if (rosterJid) {
                 if (bareJids.count() == 1) {
-                    emit updateTabHeader(gkStringFuncs->trimStrToCharLength(rosterJid.vCard.nickName(), 16, true));
+                    emit updateTabHeader(gkStringFuncs->trimStrToCharLength(rosterJid->vCard.nickName(), 16, true));
                     ui->label_callsign_2_name->setText(tr("Welcome, %1 and %2!").arg(gkStringFuncs->getXmppUsername(gkConnDetails.jid)).arg(gkStringFuncs->getXmppUsername(bareJid)));
-                    setWindowTitle(tr("%1 -- Small World Deluxe").arg(gkStringFuncs->trimStrToCharLength(rosterJid.vCard.nickName(), 32, true)));
-                    break;
+                    setWindowTitle(tr("%1 -- Small World Deluxe").arg(gkStringFuncs->trimStrToCharLength(rosterJid->vCard.nickName(), 32, true)));
                 } else {
-                    emit updateTabHeader(gkStringFuncs->trimStrToCharLength(rosterJid.vCard.nickName(), 16, false));
+                    emit updateTabHeader(gkStringFuncs->trimStrToCharLength(rosterJid->vCard.nickName(), 16, false));
                     ui->label_callsign_2_name->setText(tr("Welcome, %1, %2, etc.!").arg(gkStringFuncs->getXmppUsername(gkConnDetails.jid)).arg(gkStringFuncs->getXmppUsername(bareJid)));
-                    setWindowTitle(tr("%1, etc. -- Small World Deluxe").arg(gkStringFuncs->trimStrToCharLength(rosterJid.vCard.nickName(), 32, true)));
-                    break;
+                    setWindowTitle(tr("%1, etc. -- Small World Deluxe").arg(gkStringFuncs->trimStrToCharLength(rosterJid->vCard.nickName(), 32, true)));
                 }
             }
         }
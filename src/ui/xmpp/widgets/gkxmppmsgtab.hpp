@@ -42,6 +42,7 @@
 #pragma once
 
 #include "src/defines.hpp"
+#include "src/dek_db.hpp"
 #include "src/gk_xmpp_client.hpp"
 #include "src/gk_string_funcs.hpp"
 #include "src/models/xmpp/gk_xmpp_msg_handler.hpp"
@@ -51,6 +52,7 @@
 #include <QString>
 #include <QObject>
 #include <QPointer>
+#include <QTimer>
 #include <queue>
 #include <string>
 
@@ -64,6 +66,7 @@ class GkXmppMsgTab : public QWidget
 
 public:
     explicit GkXmppMsgTab(QPointer<GekkoFyre::GkTextEditSpellHighlight> spellCheckWidget,
+                          QPointer<GekkoFyre::GkLevelDb> database,
                           GekkoFyre::Network::GkXmpp::GkUserConn connDetails,
                           QPointer<GekkoFyre::GkEventLogger> eventLogger,
                           QPointer<GekkoFyre::StringFuncs> stringFuncs, QWidget *parent = nullptr);
@@ -78,7 +81,7 @@ public slots:
     // QXmpp message handling and related
     void recvXmppMsg(const QXmppMessage &msg);
     void recvMsgArchive(const QString &bareJid);
-    void getArchivedMessagesFromDb(const QXmppMessage &message, const bool &wipeExistingHistory = false);
+    void getArchivedMessagesFromDb(const QString &chatJid, const QList<GekkoFyre::Network::GkXmpp::GkRecvMsgsTableViewModel> &messages);
 
     //
     // Window management
@@ -96,6 +99,7 @@ private slots:
     void on_comboBox_tx_msg_shortcut_cmds_currentIndexChanged(int index);
 
     void updateInterface(const QStringList &bareJids);
+    void searchMessages();
 
 signals:
     void updateTabHeader(const QString &header_title);
@@ -105,9 +109,11 @@ private:
 
     //
     // Miscellaneous
+    QPointer<GekkoFyre::GkLevelDb> gkDb;
     QPointer<GekkoFyre::GkEventLogger> gkEventLogger;
     QPointer<GekkoFyre::StringFuncs> gkStringFuncs;
     std::queue<QString> m_toolBarTextQueue;
+    QPointer<QTimer> m_searchTimer;
 
     //
     // QTableView and related
@@ -43,9 +43,12 @@
 #include "ui_gkxmppmuctab.h"
 #include <chrono>
 #include <utility>
+#include <QHeaderView>
 #include <QMessageBox>
+#include <QScrollBar>
 #include <QFileDialog>
 #include <QStandardPaths>
+#include <qxmpp/QXmppUtils.h>
 
 using namespace GekkoFyre;
 using namespace GkAudioFramework;
@@ -62,6 +65,7 @@ using namespace Network;
 using namespace GkXmpp;
 
 GkXmppMucTab::GkXmppMucTab(QPointer<GekkoFyre::GkTextEditSpellHighlight> spellCheckWidget,
+                           QPointer<GekkoFyre::GkXmppClient> xmppClient,
                            GekkoFyre::Network::GkXmpp::GkUserConn connDetails,
                            QPointer<GekkoFyre::GkEventLogger> eventLogger,
                            QPointer<GekkoFyre::StringFuncs> stringFuncs, QWidget *parent) :
@@ -71,6 +75,7 @@ GkXmppMucTab::GkXmppMucTab(QPointer<GekkoFyre::GkTextEditSpellHighlight> spellCh
 
     gkStringFuncs = std::move(stringFuncs);
     gkEventLogger = std::move(eventLogger);
+    m_xmppClient = std::move(xmppClient);
 
     gkConnDetails = connDetails;
 
@@ -85,6 +90,32 @@ GkXmppMucTab::GkXmppMucTab(QPointer<GekkoFyre::GkTextEditSpellHighlight> spellCh
     gkXmppRecvMucChatTableViewModel = new GkXmppRecvMsgsTableViewModel(ui->tableView_muc_recv_conversation, m_xmppClient, this);
     // gkXmppMsgEngine = new GkXmppMsgEngine(this);
     ui->tableView_muc_recv_conversation->setModel(gkXmppRecvMucChatTableViewModel);
+    gkXmppRecvMsgsTableViewModel = gkXmppRecvMucChatTableViewModel;
+
+    //
+    // Setup and initialize the QTreeView of MUC occupants...
+    m_occupantStore = new GkXmppMucOccupantStore(this);
+    gkXmppMucRosterTreeViewModel = new GkXmppMucRosterTreeViewModel(m_occupantStore, QStringList() << tr("Nickname") << tr("Role"), this);
+    ui->treeView_muc_user_list->setModel(gkXmppMucRosterTreeViewModel);
+    ui->treeView_muc_user_list->setRootIsDecorated(false);
+    ui->treeView_muc_user_list->setUniformRowHeights(true); // Lets the QTreeView skip measuring each and every row of a busy MUC!
+    ui->treeView_muc_user_list->setIconSize(QSize(GK_XMPP_MUC_ROSTER_TREEVIEW_MODEL_AVATAR_SIZE, GK_XMPP_MUC_ROSTER_TREEVIEW_MODEL_AVATAR_SIZE));
+    ui->treeView_muc_user_list->header()->setSectionResizeMode(GK_XMPP_MUC_ROSTER_TREEVIEW_MODEL_NICKNAME_IDX, QHeaderView::Stretch);
+
+    QObject::connect(m_occupantStore, SIGNAL(occupantsChanged(const QList<GekkoFyre::Network::GkXmpp::GkXmppMucOccupant> &, const QStringList &)),
+                     this, SLOT(updateOccupantCount()));
+    QObject::connect(m_occupantStore, SIGNAL(occupantsCleared()), this, SLOT(updateOccupantCount()));
+    QObject::connect(gkXmppMucRosterTreeViewModel, SIGNAL(avatarWanted(const QString &, const QString &)),
+                     this, SLOT(fetchOccupantAvatar(const QString &, const QString &)));
+    QObject::connect(m_xmppClient, SIGNAL(sendMucOccupantVCard(const QString &, const QByteArray &)),
+                     gkXmppMucRosterTreeViewModel, SLOT(setAvatar(const QString &, const QByteArray &)));
+
+    //
+    // Avatars are only ever fetched for those occupants that have been scrolled into view
+    QObject::connect(ui->treeView_muc_user_list->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(loadVisibleAvatars()));
+    QObject::connect(gkXmppMucRosterTreeViewModel, SIGNAL(rowsInserted(const QModelIndex &, int, int)),
+                     this, SLOT(loadVisibleAvatars()), Qt::QueuedConnection);
+    QObject::connect(gkXmppMucRosterTreeViewModel, SIGNAL(modelReset()), this, SLOT(loadVisibleAvatars()), Qt::QueuedConnection);
 
     ui->label_muc_callsign_1_stats->setText(QString("1 %1").arg(tr("user in chat")));
     ui->label_muc_msging_callsign_status->setText("");
@@ -97,6 +128,7 @@ GkXmppMucTab::GkXmppMucTab(QPointer<GekkoFyre::GkTextEditSpellHighlight> spellCh
     gkSpellCheckerHighlighter->setEnabled(true);
     QObject::connect(m_xmppClient, &QXmppClient::disconnected, this, [=]() {
         gkSpellCheckerHighlighter->setEnabled(false);
+        m_occupantStore->clear();
     });
 
     updateInterface(m_bareJids);
@@ -164,48 +196,43 @@ void GkXmppMucTab::recvXmppMsg(const QXmppMessage &msg)
  */
 void GkXmppMucTab::recvMsgArchive(const QStringList &bareJids)
 {
-    // TODO: Refactor this code!
-    if (!gkTabRoster.roster.isEmpty()) {
-        gkXmppRecvMsgsTableViewModel.clear();
-        for (const auto &roster: gkTabRoster.roster) {
-            for (const auto &bareJid: bareJids) {
-                if (roster.bareJid == bareJid) {
-                    if (!roster.archive_messages.isEmpty()) {
-                        for (const auto &message: roster.archive_messages) {
-                            gkXmppRecvMsgsTableViewModel->insertData(bareJid, message.message.body(), message.message.date());
-                        }
-                    }
+    gkXmppRecvMsgsTableViewModel->removeData();
+    QList<GkRecvMsgsTableViewModel> messages;
+    for (const auto &bareJid: bareJids) {
+        if (gkTabRoster.bareJids.contains(bareJid)) {
+            const auto entry = m_xmppClient->getRosterStore()->get(bareJid);
+            if (entry) {
+                for (const auto &message: entry->archive_messages) {
+                    GkRecvMsgsTableViewModel recvMsg;
+                    recvMsg.timestamp = message.message.date();
+                    recvMsg.bareJid = bareJid;
+                    recvMsg.message = message.message.body();
+                    messages.push_back(recvMsg);
                 }
             }
         }
     }
 
+    gkXmppRecvMsgsTableViewModel->insertData(messages);
     return;
 }
 
 /**
- * @brief GkXmppMucTab::getArchivedMessagesFromDb attempts to get previously archived messages from the Google
- * LevelDB database that is associated with this user's instance of Small World Deluxe, and insert them into the chat
- * window, thereby saving bandwidth from not having to unnecessarily re-download messages from the given XMPP server
- * again.
- * NOTE: The Google LevelDB functionality is currently disabled!
+ * @brief GkXmppMucTab::getArchivedMessagesFromDb inserts a page of archived messages into the chat window, with a single
+ * insertion into the QTableView model, GekkoFyre::GkXmppRecvMsgsTableViewModel(), rather than one for each message.
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
- * @param message The QXmppMessage stanza itself to be inserted into the QTableView model, GekkoFyre::GkXmppRecvMsgsTableViewModel().
- * @param wipeExistingHistory Whether to wipe the pre-existing chat history or not, specifically from the given QTableView
- * object, GekkoFyre::GkXmppRecvMsgsTableViewModel().
+ * @param chatJid The chat that the messages belong towards, which are only inserted should it be this very chat.
+ * @param messages The messages themselves, as already written towards the chat transcript by GkXmppStanzaWorker.
  */
-void GkXmppMucTab::getArchivedMessagesFromDb(const QXmppMessage &message, const bool &wipeExistingHistory)
+void GkXmppMucTab::getArchivedMessagesFromDb(const QString &chatJid, const QList<GekkoFyre::Network::GkXmpp::GkRecvMsgsTableViewModel> &messages)
 {
     try {
-        std::lock_guard<std::mutex> lock_guard(m_archivedMsgsFromDbMtx);
-        if (wipeExistingHistory) {
-            gkXmppRecvMsgsTableViewModel->removeData();
-        }
-
-        if (message.isXmppStanza() && !message.body().isEmpty()) {
-            gkXmppRecvMsgsTableViewModel->insertData(message.from(), message.body(), message.stamp());
+        if (messages.isEmpty() || !gkTabRoster.bareJids.contains(chatJid)) {
+            return;
         }
 
+        std::lock_guard<std::mutex> lock_guard(m_archivedMsgsFromDbMtx);
+        gkXmppRecvMsgsTableViewModel->insertData(messages, true);
         ui->tableView_muc_recv_conversation->scrollToBottom();
     } catch (const std::exception &e) {
         std::throw_with_nested(std::runtime_error(e.what()));
@@ -225,6 +252,31 @@ void GkXmppMucTab::openMucDlg(const GekkoFyre::Network::GkXmpp::GkXmppMsgTabRost
 {
     gkTabRoster = mucRoster;
 
+    const auto room = gkTabRoster.mucCtx.room_ptr;
+    if (!room) {
+        return;
+    }
+
+    //
+    // Each presence is handed towards the occupant store, which applies them in batches rather than one at a time
+    QObject::connect(room.get(), &QXmppMucRoom::participantAdded, this, [=](const QString &jid) {
+        m_occupantStore->enqueuePresence(jid, room->participantPresence(jid));
+    });
+
+    QObject::connect(room.get(), &QXmppMucRoom::participantChanged, this, [=](const QString &jid) {
+        m_occupantStore->enqueuePresence(jid, room->participantPresence(jid));
+    });
+
+    QObject::connect(room.get(), &QXmppMucRoom::participantRemoved, this, [=](const QString &jid) {
+        m_occupantStore->enqueuePresence(jid, QXmppPresence(QXmppPresence::Unavailable));
+    });
+
+    //
+    // Those occupants already present, should the MUC have been joined beforehand
+    for (const auto &jid: room->participants()) {
+        m_occupantStore->enqueuePresence(jid, room->participantPresence(jid));
+    }
+
     return;
 }
 
@@ -318,6 +370,65 @@ void GkXmppMucTab::on_comboBox_muc_tx_msg_shortcut_cmds_currentIndexChanged(int
     return;
 }
 
+/**
+ * @brief GkXmppMucTab::updateOccupantCount
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppMucTab::updateOccupantCount()
+{
+    ui->label_muc_callsign_1_stats->setText(tr("%1 users in chat").arg(QString::number(m_occupantStore->size())));
+
+    return;
+}
+
+/**
+ * @brief GkXmppMucTab::loadVisibleAvatars asks for the avatars of those occupants currently scrolled into view, and no
+ * others, so that joining a busy MUC does not result in a vCard request for each and every occupant.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ */
+void GkXmppMucTab::loadVisibleAvatars()
+{
+    const qint32 rowCount = gkXmppMucRosterTreeViewModel->rowCount();
+    if (rowCount == 0) {
+        return;
+    }
+
+    const auto viewport = ui->treeView_muc_user_list->viewport();
+    const QModelIndex first = ui->treeView_muc_user_list->indexAt(QPoint(0, 0));
+    const QModelIndex last = ui->treeView_muc_user_list->indexAt(QPoint(0, viewport->height() - 1));
+
+    //
+    // Should the rows not fill the viewport, the last row is simply whichever one is at the very end
+    gkXmppMucRosterTreeViewModel->wantAvatars(first.isValid() ? first.row() : 0, last.isValid() ? last.row() : rowCount - 1);
+
+    return;
+}
+
+/**
+ * @brief GkXmppMucTab::fetchOccupantAvatar finds the avatar of the given occupant, either from the roster should their
+ * real JID be known (and already be within it), or otherwise by requesting the vCard of the occupant from the MUC.
+ * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
+ * @param jid The occupant JID, such as `room@conference.example.com/nickname`.
+ * @param realJid The real JID of the occupant, should the MUC not be anonymous.
+ */
+void GkXmppMucTab::fetchOccupantAvatar(const QString &jid, const QString &realJid)
+{
+    if (!m_xmppClient) {
+        return;
+    }
+
+    if (!realJid.isEmpty()) {
+        const auto entry = m_xmppClient->getRosterStore()->get(QXmppUtils::jidToBareJid(realJid));
+        if (entry && !entry->vCard.photo().isEmpty()) {
+            gkXmppMucRosterTreeViewModel->setAvatar(jid, entry->vCard.photo());
+            return;
+        }
+    }
+
+    m_xmppClient->getVCardScheduler()->request(jid, GkXmppVCardScheduler::Visible);
+    return;
+}
+
 /**
  * @brief GkXmppMucTab::updateInterface updates the tab's widget interface but this time around, for an MUC oriented one!
  * @author Phobos A. D'thorga <phobos.gekko@gekkofyre.io>
@@ -327,18 +438,17 @@ void GkXmppMucTab::updateInterface(const QStringList &bareJids)
 {
     ui->label_muc_callsign_1_stats->setText(tr("%1 users in chat").arg(QString::number(bareJids.count() + 1))); // Includes both the user in communique and the client themselves!
     for (const auto &bareJid: bareJids) {
-        for (const auto &rosterJid: gkTabRoster.roster) {
-            if (bareJid == rosterJid.bareJid) {
+        if (gkTabRoster.bareJids.contains(bareJid)) {
+            const auto rosterJid = m_xmppClient->getRosterStore()->get(bareJid);
+            if (rosterJid) {
                 if (bareJids.count() == 1) {
-                    emit updateTabHeader(gkStringFuncs->trimStrToCharLength(rosterJid.vCard.nickName(), 16, true));
+                    emit updateTabHeader(gkStringFuncs->trimStrToCharLength(rosterJid->vCard.nickName(), 16, true));
                     ui->label_muc_callsign_2_name->setText(tr("Welcome, %1 and %2!").arg(gkStringFuncs->getXmppUsername(gkConnDetails.jid)).arg(gkStringFuncs->getXmppUsername(bareJid)));
-                    setWindowTitle(tr("%1 -- Small World Deluxe").arg(gkStringFuncs->trimStrToCharLength(rosterJid.vCard.nickName(), 32, true)));
-                    break;
+                    setWindowTitle(tr("%1 -- Small World Deluxe").arg(gkStringFuncs->trimStrToCharLength(rosterJid->vCard.nickName(), 32, true)));
                 } else {
-                    emit updateTabHeader(gkStringFuncs->trimStrToCharLength(rosterJid.vCard.nickName(), 16, false));
+                    emit updateTabHeader(gkStringFuncs->trimStrToCharLength(rosterJid->vCard.nickName(), 16, false));
                     ui->label_muc_callsign_2_name->setText(tr("Welcome, %1, %2, etc.!").arg(gkStringFuncs->getXmppUsername(gkConnDetails.jid)).arg(gkStringFuncs->getXmppUsername(bareJid)));
-                    setWindowTitle(tr("%1, etc. -- Small World Deluxe").arg(gkStringFuncs->trimStrToCharLength(rosterJid.vCard.nickName(), 32, true)));
-                    break;
+                    setWindowTitle(tr("%1, etc. -- Small World Deluxe").arg(gkStringFuncs->trimStrToCharLength(rosterJid->vCard.nickName(), 32, true)));
                 }
             }
         }
@@ -45,6 +45,8 @@
 #include "src/gk_xmpp_client.hpp"
 #include "src/gk_string_funcs.hpp"
 #include "src/models/xmpp/gk_xmpp_msg_handler.hpp"
+#include "src/models/xmpp/gk_xmpp_muc_occupant_store.hpp"
+#include "src/models/treeview/xmpp/gk_xmpp_muc_roster_model.hpp"
 #include "src/models/tableview/gk_xmpp_recv_msgs_model.hpp"
 #include "src/models/spelling/gk_text_edit_spelling_highlight.hpp"
 #include <QWidget>
@@ -64,6 +66,7 @@ class GkXmppMucTab : public QWidget
 
 public:
     explicit GkXmppMucTab(QPointer<GekkoFyre::GkTextEditSpellHighlight> spellCheckWidget,
+                          QPointer<GekkoFyre::GkXmppClient> xmppClient,
                           GekkoFyre::Network::GkXmpp::GkUserConn connDetails,
                           QPointer<GekkoFyre::GkEventLogger> eventLogger,
                           QPointer<GekkoFyre::StringFuncs> stringFuncs, QWidget *parent = nullptr);
@@ -78,7 +81,7 @@ public slots:
     // QXmpp message handling and related
     void recvXmppMsg(const QXmppMessage &msg);
     void recvMsgArchive(const QStringList &bareJids);
-    void getArchivedMessagesFromDb(const QXmppMessage &message, const bool &wipeExistingHistory = false);
+    void getArchivedMessagesFromDb(const QString &chatJid, const QList<GekkoFyre::Network::GkXmpp::GkRecvMsgsTableViewModel> &messages);
 
     //
     // Window management
@@ -97,6 +100,12 @@ private slots:
 
     void updateInterface(const QStringList &bareJids);
 
+    //
+    // MUC occupants
+    void updateOccupantCount();
+    void loadVisibleAvatars();
+    void fetchOccupantAvatar(const QString &jid, const QString &realJid);
+
 signals:
     void updateTabHeader(const QString &header_title);
 
@@ -113,6 +122,7 @@ private:
     // QTableView and related
     QPointer<GekkoFyre::GkXmppRecvMsgsTableViewModel> gkXmppRecvMsgsTableViewModel;
     QPointer<GekkoFyre::GkXmppRecvMsgsTableViewModel> gkXmppRecvMucChatTableViewModel;
+    QPointer<GekkoFyre::GkXmppMucRosterTreeViewModel> gkXmppMucRosterTreeViewModel;
 
     //
     // QXmpp and XMPP related
@@ -120,6 +130,7 @@ private:
     QPointer<GekkoFyre::GkXmppClient> m_xmppClient;
     QStringList m_bareJids;
     GekkoFyre::Network::GkXmpp::GkXmppMsgTabRoster gkTabRoster;
+    QPointer<GekkoFyre::GkXmppMucOccupantStore> m_occupantStore;                // The occupants of the MUC, indexed by occupant JID.
 
     //
     // Multithreading, mutexes, etc.